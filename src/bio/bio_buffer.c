@@ -1,6 +1,6 @@
 /**
  * (C) Copyright 2018-2024 Intel Corporation.
- * (C) Copyright 2025 Hewlett Packard Enterprise Development LP
+ * (C) Copyright 2025-2026 Hewlett Packard Enterprise Development LP
  *
  * SPDX-License-Identifier: BSD-2-Clause-Patent
  */
@@ -18,6 +18,9 @@ dma_free_chunk(struct bio_dma_chunk *chunk)
 	D_ASSERT(chunk->bdc_ref == 0);
 	D_ASSERT(d_list_empty(&chunk->bdc_link));
 
+	/* Deregister the chunk before freeing it */
+	bulk_chunk_fini(chunk);
+
 	if (bio_spdk_inited)
 		spdk_dma_free(chunk->bdc_ptr);
 	else
@@ -70,6 +73,94 @@ dma_alloc_chunk(unsigned int cnt)
 	return chunk;
 }
 
+/*
+ * Freed huge chunks are cached for reuse instead of being returned to SPDK immediately, the
+ * cached pages are bounded by this many regular chunks. They are accounted in bio_chk_cnt_max
+ * as regular chunks, and freed when the DMA buffer needs to grow.
+ */
+#define DMA_HUGE_CACHE_CHKS	4
+
+static inline void
+dma_class_update(struct bio_dma_buffer *bdb, unsigned int class, int delta)
+{
+	D_ASSERT(class < BIO_DMA_CLASS_MAX);
+	D_ASSERT(delta > 0 || bdb->bdb_class_cnt[class] >= -delta);
+	bdb->bdb_class_cnt[class] += delta;
+	if (bdb->bdb_stats.bds_class_used[class])
+		d_tm_set_gauge(bdb->bdb_stats.bds_class_used[class], bdb->bdb_class_cnt[class]);
+}
+
+/* Number of regular chunks accounted for the cached huge chunks */
+static inline unsigned int
+dma_huge_chks(struct bio_dma_buffer *bdb)
+{
+	return (bdb->bdb_huge_pgs + bio_chk_sz - 1) / bio_chk_sz;
+}
+
+static inline void
+dma_huge_del(struct bio_dma_buffer *bdb, struct bio_dma_chunk *chunk)
+{
+	D_ASSERT(bdb->bdb_huge_pgs >= chunk->bdc_pg_cnt);
+	d_list_del_init(&chunk->bdc_link);
+	bdb->bdb_huge_pgs -= chunk->bdc_pg_cnt;
+	if (bdb->bdb_stats.bds_huge_cached)
+		d_tm_set_gauge(bdb->bdb_stats.bds_huge_cached, bdb->bdb_huge_pgs);
+}
+
+/* Put a released huge chunk into cache, evict the least recently used ones if necessary */
+static void
+dma_huge_put(struct bio_dma_buffer *bdb, struct bio_dma_chunk *chunk)
+{
+	struct bio_dma_chunk	*victim;
+	unsigned int		 max_pgs;
+
+	D_ASSERT(d_list_empty(&chunk->bdc_link));
+	D_ASSERT(chunk->bdc_pg_cnt > 0);
+
+	/* Don't cache more than the chunks not allocated to the DMA buffer yet */
+	D_ASSERT(bdb->bdb_tot_cnt <= bio_chk_cnt_max);
+	max_pgs = bio_chk_sz * min(bio_chk_cnt_max - bdb->bdb_tot_cnt, DMA_HUGE_CACHE_CHKS);
+
+	if (chunk->bdc_pg_cnt > max_pgs) {
+		dma_free_chunk(chunk);
+		return;
+	}
+
+	while (bdb->bdb_huge_pgs + chunk->bdc_pg_cnt > max_pgs) {
+		D_ASSERT(!d_list_empty(&bdb->bdb_huge_list));
+		victim = d_list_entry(bdb->bdb_huge_list.next, struct bio_dma_chunk, bdc_link);
+		dma_huge_del(bdb, victim);
+		dma_free_chunk(victim);
+	}
+
+	d_list_add_tail(&chunk->bdc_link, &bdb->bdb_huge_list);
+	bdb->bdb_huge_pgs += chunk->bdc_pg_cnt;
+	if (bdb->bdb_stats.bds_huge_cached)
+		d_tm_set_gauge(bdb->bdb_stats.bds_huge_cached, bdb->bdb_huge_pgs);
+}
+
+/*
+ * Get a huge chunk for @pg_cnt pages, cached huge chunk will be reused when it's large
+ * enough and won't waste more than half of the chunk.
+ */
+static struct bio_dma_chunk *
+dma_huge_get(struct bio_dma_buffer *bdb, unsigned int pg_cnt)
+{
+	struct bio_dma_chunk	*chunk;
+
+	d_list_for_each_entry_reverse(chunk, &bdb->bdb_huge_list, bdc_link) {
+		if (chunk->bdc_pg_cnt >= pg_cnt && chunk->bdc_pg_cnt <= pg_cnt * 2) {
+			dma_huge_del(bdb, chunk);
+			return chunk;
+		}
+	}
+
+	chunk = dma_alloc_chunk(pg_cnt);
+	if (chunk != NULL)
+		chunk->bdc_pg_cnt = pg_cnt;
+	return chunk;
+}
+
 static void
 dma_buffer_shrink(struct bio_dma_buffer *buf, unsigned int cnt)
 {
@@ -90,13 +181,34 @@ dma_buffer_shrink(struct bio_dma_buffer *buf, unsigned int cnt)
 	}
 }
 
+/*
+ * Whether the DMA buffer can grow by one chunk without exceeding bio_chk_cnt_max, the cached
+ * huge chunks are freed to make room if necessary.
+ */
+bool
+dma_buffer_growable(struct bio_dma_buffer *buf)
+{
+	struct bio_dma_chunk *victim;
+
+	while (buf->bdb_tot_cnt + dma_huge_chks(buf) >= bio_chk_cnt_max) {
+		if (d_list_empty(&buf->bdb_huge_list))
+			return false;
+
+		victim = d_list_entry(buf->bdb_huge_list.next, struct bio_dma_chunk, bdc_link);
+		dma_huge_del(buf, victim);
+		dma_free_chunk(victim);
+	}
+
+	return true;
+}
+
 int
 dma_buffer_grow(struct bio_dma_buffer *buf, unsigned int cnt)
 {
 	struct bio_dma_chunk *chunk;
 	int i, rc = 0;
 
-	D_ASSERT((buf->bdb_tot_cnt + cnt) <= bio_chk_cnt_max);
+	D_ASSERT((buf->bdb_tot_cnt + dma_huge_chks(buf) + cnt) <= bio_chk_cnt_max);
 
 	for (i = 0; i < cnt; i++) {
 		chunk = dma_alloc_chunk(bio_chk_sz);
@@ -114,13 +226,47 @@ dma_buffer_grow(struct bio_dma_buffer *buf, unsigned int cnt)
 	return rc;
 }
 
+/*
+ * Whether all the chunks left (idle or not allocated yet) are reserved for small IODs, if
+ * so, medium IODs need to wait for in-flight IODs releasing chunks.
+ */
+bool
+dma_small_rsv_reached(struct bio_dma_buffer *bdb)
+{
+	unsigned int	 rsv = bio_chk_cnt_max * bio_chk_small_pct / 100;
+	unsigned int	 avail;
+	d_list_t	*cur;
+
+	/* No in-flight IODs will release chunks, don't wait */
+	if (rsv == 0 || bdb->bdb_active_iods == 0)
+		return false;
+
+	D_ASSERT(bdb->bdb_tot_cnt <= bio_chk_cnt_max);
+	avail = bio_chk_cnt_max - bdb->bdb_tot_cnt;
+	d_list_for_each(cur, &bdb->bdb_idle_list) {
+		if (avail > rsv)
+			break;
+		avail++;
+	}
+
+	return avail <= rsv;
+}
+
 void
 dma_buffer_destroy(struct bio_dma_buffer *buf)
 {
+	struct bio_dma_chunk *chunk, *tmp;
+
 	D_ASSERT(d_list_empty(&buf->bdb_used_list));
 	D_ASSERT(buf->bdb_active_iods == 0);
 	D_ASSERT(buf->bdb_queued_iods == 0);
 
+	d_list_for_each_entry_safe(chunk, tmp, &buf->bdb_huge_list, bdc_link) {
+		dma_huge_del(buf, chunk);
+		dma_free_chunk(chunk);
+	}
+	D_ASSERT(buf->bdb_huge_pgs == 0);
+
 	bulk_cache_destroy(buf);
 	dma_buffer_shrink(buf, buf->bdb_tot_cnt);
 
@@ -147,6 +293,21 @@ chk_type2str(int chk_type)
 	}
 }
 
+static inline char *
+dma_class2str(int class)
+{
+	switch (class) {
+	case BIO_DMA_CLASS_SMALL:
+		return "small";
+	case BIO_DMA_CLASS_MEDIUM:
+		return "medium";
+	case BIO_DMA_CLASS_LARGE:
+		return "large";
+	default:
+		return "unknown";
+	}
+}
+
 static void
 dma_metrics_init(struct bio_dma_buffer *bdb, int tgt_id)
 {
@@ -168,6 +329,26 @@ dma_metrics_init(struct bio_dma_buffer *bdb, int tgt_id)
 			       chk_type2str(i), DP_RC(rc));
 	}
 
+	for (i = BIO_DMA_CLASS_SMALL; i < BIO_DMA_CLASS_MAX; i++) {
+		snprintf(desc, sizeof(desc), "Used chunks (%s IOD)", dma_class2str(i));
+		rc = d_tm_add_metric(&stats->bds_class_used[i], D_TM_GAUGE, desc, "chunk",
+				     "dmabuff/used_chunks_%s/tgt_%d", dma_class2str(i), tgt_id);
+		if (rc)
+			D_WARN("Failed to create used_chunks_%s telemetry: "DF_RC"\n",
+			       dma_class2str(i), DP_RC(rc));
+	}
+
+	rc = d_tm_add_metric(&stats->bds_huge_cached, D_TM_GAUGE, "Cached huge chunk pages",
+			     "page", "dmabuff/huge_cached/tgt_%d", tgt_id);
+	if (rc)
+		D_WARN("Failed to create huge_cached telemetry: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&stats->bds_rsv_waits, D_TM_COUNTER,
+			     "Waits on chunks reserved for small IOD", "wait",
+			     "dmabuff/rsv_waits/tgt_%d", tgt_id);
+	if (rc)
+		D_WARN("Failed to create rsv_waits telemetry: "DF_RC"\n", DP_RC(rc));
+
 	rc = d_tm_add_metric(&stats->bds_bulk_grps, D_TM_GAUGE, "Total bulk grps", "grp",
 			     "dmabuff/bulk_grps/tgt_%d", tgt_id);
 	if (rc)
@@ -207,6 +388,7 @@ dma_buffer_create(unsigned int init_cnt, int tgt_id)
 
 	D_INIT_LIST_HEAD(&buf->bdb_idle_list);
 	D_INIT_LIST_HEAD(&buf->bdb_used_list);
+	D_INIT_LIST_HEAD(&buf->bdb_huge_list);
 	buf->bdb_tot_cnt = 0;
 	buf->bdb_active_iods = 0;
 
@@ -325,7 +507,7 @@ bio_iod_free(struct bio_desc *biod)
 {
 	int i;
 
-	if (biod->bd_async_post && biod->bd_dma_done != ABT_EVENTUAL_NULL)
+	if ((biod->bd_async_post || biod->bd_prefetch) && biod->bd_dma_done != ABT_EVENTUAL_NULL)
 		iod_dma_wait(biod);
 
 	D_ASSERT(!biod->bd_buffer_prep);
@@ -402,7 +584,9 @@ iod_release_buffer(struct bio_desc *biod)
 			chunk->bdc_type);
 
 		if (dma_chunk_is_huge(chunk)) {
-			dma_free_chunk(chunk);
+			D_ASSERT(chunk->bdc_class == BIO_DMA_CLASS_LARGE);
+			dma_class_update(bdb, chunk->bdc_class, -1);
+			dma_huge_put(bdb, chunk);
 		} else if (chunk->bdc_ref == 0) {
 			chunk->bdc_pg_idx = 0;
 			D_ASSERT(bdb->bdb_used_cnt[chunk->bdc_type] > 0);
@@ -410,9 +594,10 @@ iod_release_buffer(struct bio_desc *biod)
 			if (bdb->bdb_stats.bds_chks_used[chunk->bdc_type])
 				d_tm_set_gauge(bdb->bdb_stats.bds_chks_used[chunk->bdc_type],
 					       bdb->bdb_used_cnt[chunk->bdc_type]);
+			dma_class_update(bdb, chunk->bdc_class, -1);
 
-			if (chunk == bdb->bdb_cur_chk[chunk->bdc_type])
-				bdb->bdb_cur_chk[chunk->bdc_type] = NULL;
+			if (chunk == bdb->bdb_cur_chk[chunk->bdc_type][chunk->bdc_class])
+				bdb->bdb_cur_chk[chunk->bdc_type][chunk->bdc_class] = NULL;
 			d_list_move_tail(&chunk->bdc_link, &bdb->bdb_idle_list);
 		}
 		rsrvd_dma->brd_dma_chks[i] = NULL;
@@ -628,15 +813,33 @@ iod_last_region(struct bio_desc *biod)
 	return (cnt != 0) ? &biod->bd_rsrvd.brd_regions[cnt - 1] : NULL;
 }
 
+/* Whether the IOD is allowed to use the chunks reserved for small IODs */
+static inline bool
+iod_use_rsv(struct bio_desc *biod)
+{
+	/* Copy target can't wait for the copy source releasing chunks, see iod_should_retry() */
+	return biod->bd_dma_class == BIO_DMA_CLASS_SMALL || biod->bd_copy_dst;
+}
+
 static int
-chunk_get_idle(struct bio_dma_buffer *bdb, struct bio_dma_chunk **chk_ptr)
+chunk_get_idle(struct bio_dma_buffer *bdb, bool use_rsv, struct bio_dma_chunk **chk_ptr)
 {
 	struct bio_dma_chunk *chk;
 	int rc;
 
+	/* Leave the reserved chunks to small IODs, reclaim unused bulk chunks if possible */
+	while (!use_rsv && dma_small_rsv_reached(bdb)) {
+		rc = bulk_reclaim_chunk(bdb, NULL);
+		if (rc) {
+			if (bdb->bdb_stats.bds_rsv_waits)
+				d_tm_inc_counter(bdb->bdb_stats.bds_rsv_waits, 1);
+			return rc;
+		}
+	}
+
 	if (d_list_empty(&bdb->bdb_idle_list)) {
 		/* Try grow buffer first */
-		if (bdb->bdb_tot_cnt < bio_chk_cnt_max) {
+		if (dma_buffer_growable(bdb)) {
 			rc = dma_buffer_grow(bdb, 1);
 			if (rc == 0)
 				goto done;
@@ -876,24 +1079,27 @@ dma_map_one(struct bio_desc *biod, struct bio_iov *biov, void *arg)
 	/*
 	 * For huge IOV, we'll bypass our per-xstream DMA buffer cache and
 	 * allocate chunk from the SPDK reserved huge pages directly, this
-	 * kind of huge chunk will be freed immediately on I/O completion.
+	 * kind of huge chunk will be put in a small per-xstream cache on
+	 * I/O completion, so that back to back huge IOVs can reuse it.
 	 *
 	 * We assume the contiguous huge IOV is quite rare, so there won't
 	 * be high contention over the SPDK huge page cache.
 	 */
 	if (pg_cnt > bio_chk_sz) {
-		chk = dma_alloc_chunk(pg_cnt);
+		chk = dma_huge_get(bdb, pg_cnt);
 		if (chk == NULL) {
 			D_ERROR("Failed to allocate %u pages DMA buffer\n", pg_cnt);
 			return -DER_NOMEM;
 		}
 
 		chk->bdc_type = biod->bd_chk_type;
+		chk->bdc_class = BIO_DMA_CLASS_LARGE;
 		rc = iod_add_chunk(biod, chk);
 		if (rc) {
-			dma_free_chunk(chk);
+			dma_huge_put(bdb, chk);
 			return rc;
 		}
+		dma_class_update(bdb, chk->bdc_class, 1);
 		bio_iov_set_raw_buf(biov, chk->bdc_ptr + pg_off);
 		chk_pg_idx = 0;
 
@@ -945,8 +1151,12 @@ dma_map_one(struct bio_desc *biod, struct bio_iov *biov, void *arg)
 	 * Try to reserve the DMA buffer from the 'current chunk' of the
 	 * per-xstream DMA buffer. It could be different with the last chunk
 	 * in io descriptor, because dma_map_one() may yield in the future.
+	 *
+	 * Small and medium IODs reserve from different 'current chunk', so
+	 * that long-lived large transfers won't pin the chunk being shared
+	 * by small IODs.
 	 */
-	cur_chk = bdb->bdb_cur_chk[biod->bd_chk_type];
+	cur_chk = bdb->bdb_cur_chk[biod->bd_chk_type][biod->bd_dma_class];
 	if (cur_chk != NULL && cur_chk != chk) {
 		chk = cur_chk;
 		chk_pg_idx = chk->bdc_pg_idx;
@@ -963,7 +1173,7 @@ dma_map_one(struct bio_desc *biod, struct bio_iov *biov, void *arg)
 	 * Switch to another idle chunk, if there isn't any idle chunk
 	 * available, grow buffer.
 	 */
-	rc = chunk_get_idle(bdb, &chk);
+	rc = chunk_get_idle(bdb, iod_use_rsv(biod), &chk);
 	if (rc) {
 		if (rc == -DER_AGAIN)
 			biod->bd_retry = 1;
@@ -975,11 +1185,13 @@ dma_map_one(struct bio_desc *biod, struct bio_iov *biov, void *arg)
 
 	D_ASSERT(chk != NULL);
 	chk->bdc_type = biod->bd_chk_type;
-	bdb->bdb_cur_chk[chk->bdc_type] = chk;
+	chk->bdc_class = biod->bd_dma_class;
+	bdb->bdb_cur_chk[chk->bdc_type][chk->bdc_class] = chk;
 	bdb->bdb_used_cnt[chk->bdc_type] += 1;
 	if (bdb->bdb_stats.bds_chks_used[chk->bdc_type])
 		d_tm_set_gauge(bdb->bdb_stats.bds_chks_used[chk->bdc_type],
 			       bdb->bdb_used_cnt[chk->bdc_type]);
+	dma_class_update(bdb, chk->bdc_class, 1);
 	chk_pg_idx = chk->bdc_pg_idx;
 
 	D_ASSERT(chk_pg_idx == 0);
@@ -1028,6 +1240,17 @@ dma_drop_iod(struct bio_dma_buffer *bdb)
 	ABT_mutex_unlock(bdb->bdb_mutex);
 }
 
+static inline void
+iod_dma_lat_record(struct bio_desc *biod)
+{
+	if (biod->bd_dma_start == 0)
+		return;
+
+	bio_sched_io_end(biod->bd_ctxt->bic_xs_ctxt, biod->bd_ctxt->bic_xs_blobstore,
+			 biod->bd_io_class, biod->bd_dma_start);
+	biod->bd_dma_start = 0;
+}
+
 static void
 rw_completion(void *cb_arg, int err)
 {
@@ -1044,6 +1267,7 @@ rw_completion(void *cb_arg, int err)
 	bxb = biod->bd_ctxt->bic_xs_blobstore;
 	D_ASSERT(bxb != NULL);
 	bio_io_lug_dequeue(bxb, &biod->bd_io_lug);
+	bio_sched_done(bxb, biod->bd_io_class);
 
 	io_ctxt = biod->bd_ctxt;
 	D_ASSERT(io_ctxt != NULL);
@@ -1072,6 +1296,7 @@ rw_completion(void *cb_arg, int err)
 
 done:
 	if (biod->bd_inflights == 0) {
+		iod_dma_lat_record(biod);
 		iod_dma_completion(biod, err);
 		if (biod->bd_async_post && biod->bd_buffer_prep) {
 			iod_release_buffer(biod);
@@ -1180,16 +1405,18 @@ nvme_rw(struct bio_desc *biod, struct bio_rsrvd_region *rg)
 	pg_cnt -= pg_idx;
 
 	while (pg_cnt > 0) {
+		rw_cnt = (pg_cnt > bio_chk_sz) ? bio_chk_sz : pg_cnt;
 
+		bio_sched_admit(xs_ctxt, bxb, biod->bd_io_class, rw_cnt << BIO_DMA_PAGE_SHIFT);
 		drain_inflight_ios(xs_ctxt, bxb);
 
+		if (biod->bd_dma_start == 0)
+			biod->bd_dma_start = daos_getutime();
 		biod->bd_dma_issued = 1;
 		biod->bd_inflights++;
 		bio_io_lug_enqueue(xs_ctxt, bxb, &biod->bd_io_lug);
 		biod->bd_ctxt->bic_inflight_dmas++;
 
-		rw_cnt = (pg_cnt > bio_chk_sz) ? bio_chk_sz : pg_cnt;
-
 		D_DEBUG(DB_IO, "%s blob:%p payload:%p, pg_idx:"DF_U64", pg_cnt:"DF_U64"/"DF_U64"\n",
 			biod->bd_type == BIO_IOD_TYPE_UPDATE ? "Write" : "Read",
 			blob, payload, pg_idx, pg_cnt, rw_cnt);
@@ -1241,8 +1468,11 @@ dma_rw(struct bio_desc *biod)
 
 	D_ASSERT(biod->bd_inflights > 0);
 	biod->bd_inflights -= 1;
+	/* All blob I/Os are completed before the submission returned */
+	if (biod->bd_inflights == 0)
+		iod_dma_lat_record(biod);
 
-	if (!biod->bd_async_post) {
+	if (!biod->bd_async_post && !biod->bd_prefetch) {
 		iod_dma_wait(biod);
 		D_DEBUG(DB_IO, "Wait DMA done, type:%d\n", biod->bd_type);
 	}
@@ -1281,6 +1511,21 @@ iod_fifo_wait(struct bio_desc *biod, struct bio_dma_buffer *bdb)
 	ABT_mutex_unlock(bdb->bdb_mutex);
 }
 
+static void
+iod_fifo_join(struct bio_desc *biod, struct bio_dma_buffer *bdb)
+{
+	D_ASSERT(!biod->bd_in_fifo);
+	biod->bd_in_fifo = 1;
+	bdb->bdb_queued_iods++;
+	if (bdb->bdb_stats.bds_queued_iods)
+		d_tm_set_gauge(bdb->bdb_stats.bds_queued_iods, bdb->bdb_queued_iods);
+
+	/* Except the first waiter, all other waiters in FIFO queue wait on 'bdb_fifo' */
+	ABT_mutex_lock(bdb->bdb_mutex);
+	ABT_cond_wait(bdb->bdb_fifo, bdb->bdb_mutex);
+	ABT_mutex_unlock(bdb->bdb_mutex);
+}
+
 static void
 iod_fifo_in(struct bio_desc *biod, struct bio_dma_buffer *bdb)
 {
@@ -1293,16 +1538,14 @@ iod_fifo_in(struct bio_desc *biod, struct bio_dma_buffer *bdb)
 	 */
 	if (biod->bd_non_blocking)
 		return;
+	/*
+	 * Small IOD could be satisfied by the chunks reserved for small IODs, don't queue
+	 * it behind the large IODs waiting for DMA buffer.
+	 */
+	if (biod->bd_dma_class == BIO_DMA_CLASS_SMALL)
+		return;
 
-	biod->bd_in_fifo = 1;
-	bdb->bdb_queued_iods++;
-	if (bdb->bdb_stats.bds_queued_iods)
-		d_tm_set_gauge(bdb->bdb_stats.bds_queued_iods, bdb->bdb_queued_iods);
-
-	/* Except the first waiter, all other waiters in FIFO queue wait on 'bdb_fifo' */
-	ABT_mutex_lock(bdb->bdb_mutex);
-	ABT_cond_wait(bdb->bdb_fifo, bdb->bdb_mutex);
-	ABT_mutex_unlock(bdb->bdb_mutex);
+	iod_fifo_join(biod, bdb);
 }
 
 static void
@@ -1362,6 +1605,9 @@ dump_dma_info(struct bio_dma_buffer *bdb)
 		       i, bbg->bbg_bulk_pgs, bbg->bbg_chk_cnt);
 	}
 	D_EMIT("bulk_grps:%d, bulk_chunks:%d\n", bulk_grps, bulk_chunks);
+	D_EMIT("class used:%u,%u,%u, huge_cached:%u pages, small_rsv:%u%%\n",
+	       bdb->bdb_class_cnt[BIO_DMA_CLASS_SMALL], bdb->bdb_class_cnt[BIO_DMA_CLASS_MEDIUM],
+	       bdb->bdb_class_cnt[BIO_DMA_CLASS_LARGE], bdb->bdb_huge_pgs, bio_chk_small_pct);
 }
 
 static int
@@ -1409,7 +1655,11 @@ retry:
 		retry_cnt++;
 		D_DEBUG(DB_IO, "IOD %p waits for active IODs. %d\n", biod, retry_cnt);
 
-		iod_fifo_wait(biod, bdb);
+		/* IOD jumped the queue has to wait in line on failure */
+		if (!biod->bd_in_fifo && bdb->bdb_queued_iods != 0)
+			iod_fifo_join(biod, bdb);
+		else
+			iod_fifo_wait(biod, bdb);
 
 		D_DEBUG(DB_IO, "IOD %p finished waiting. %d\n", biod, retry_cnt);
 
@@ -1424,6 +1674,34 @@ out:
 	return rc;
 }
 
+/* Classify IOD by the total pages of DMA buffer it requires */
+static unsigned int
+iod_dma_class(struct bio_desc *biod)
+{
+	uint64_t	off, end;
+	unsigned int	pg_cnt, pg_off, tot_pgs = 0;
+	int		i, j;
+
+	for (i = 0; i < biod->bd_sgl_cnt; i++) {
+		struct bio_sglist *bsgl = &biod->bd_sgls[i];
+
+		for (j = 0; j < bsgl->bs_nr_out; j++) {
+			struct bio_iov *biov = &bsgl->bs_iovs[j];
+
+			if (bio_iov2raw_len(biov) == 0 || bio_addr_is_hole(&biov->bi_addr) ||
+			    direct_scm_access(biod, biov))
+				continue;
+
+			dma_biov2pg(biov, &off, &end, &pg_cnt, &pg_off);
+			tot_pgs += pg_cnt;
+			if (tot_pgs > BIO_DMA_SMALL_PGS)
+				return BIO_DMA_CLASS_MEDIUM;
+		}
+	}
+
+	return BIO_DMA_CLASS_SMALL;
+}
+
 int
 iod_prep_internal(struct bio_desc *biod, unsigned int type, void *bulk_ctxt,
 		  unsigned int bulk_perm)
@@ -1439,6 +1717,8 @@ iod_prep_internal(struct bio_desc *biod, unsigned int type, void *bulk_ctxt,
 	biod->bd_chk_type = type;
 	/* For rebuild pull, the DMA buffer will be used as RDMA client */
 	biod->bd_rdma = (bulk_ctxt != NULL) || (type == BIO_CHK_TYPE_REBUILD);
+	biod->bd_dma_class = iod_dma_class(biod);
+	biod->bd_io_class = bio_sched_io_class(biod);
 
 	if (bulk_ctxt != NULL && !(daos_io_bypass & IOBP_SRV_BULK_CACHE)) {
 		bulk_arg.ba_bulk_ctxt = bulk_ctxt;
@@ -1473,8 +1753,12 @@ iod_prep_internal(struct bio_desc *biod, unsigned int type, void *bulk_ctxt,
 	biod->bd_result = 0;
 
 	/* Load data from media to buffer on read */
-	if (biod->bd_type == BIO_IOD_TYPE_FETCH)
+	if (biod->bd_type == BIO_IOD_TYPE_FETCH) {
 		dma_rw(biod);
+		/* Don't release the buffer with reads in flight */
+		if (biod->bd_result && biod->bd_prefetch)
+			iod_dma_wait(biod);
+	}
 
 	if (biod->bd_result) {
 		rc = biod->bd_result;
@@ -1506,6 +1790,27 @@ bio_iod_try_prep(struct bio_desc *biod, unsigned int type, void *bulk_ctxt,
 	return iod_prep_internal(biod, type, bulk_ctxt, bulk_perm);
 }
 
+/*
+ * Prepare a FETCH IOD and issue the reads without waiting for completion, so that the
+ * caller can overlap the reads with other work. bio_iod_prefetch_wait() must be called
+ * before accessing the DMA buffer or posting the IOD.
+ */
+int
+bio_iod_prefetch(struct bio_desc *biod)
+{
+	D_ASSERT(biod->bd_type == BIO_IOD_TYPE_FETCH);
+	biod->bd_prefetch = 1;
+	return iod_prep_internal(biod, BIO_CHK_TYPE_LOCAL, NULL, 0);
+}
+
+int
+bio_iod_prefetch_wait(struct bio_desc *biod)
+{
+	D_ASSERT(biod->bd_prefetch && biod->bd_buffer_prep);
+	iod_dma_wait(biod);
+	return biod->bd_result;
+}
+
 int
 bio_iod_post(struct bio_desc *biod, int err)
 {
@@ -1643,7 +1948,7 @@ iod_dup_sgl(struct bio_desc *biod, struct bio_sglist *bsgl_in)
 
 static int
 bio_rwv(struct bio_io_context *ioctxt, struct bio_sglist *bsgl_in,
-	d_sg_list_t *sgl, bool update)
+	d_sg_list_t *sgl, bool update, unsigned int ioc)
 {
 	struct bio_sglist	*bsgl;
 	struct bio_desc		*biod;
@@ -1667,6 +1972,7 @@ bio_rwv(struct bio_io_context *ioctxt, struct bio_sglist *bsgl_in,
 		rc = -DER_NOMEM;
 		goto out;
 	}
+	biod->bd_io_class = ioc;
 
 	/* map the biov to DMA safe buffer, fill DMA buffer if read operation */
 	rc = bio_iod_prep(biod, BIO_CHK_TYPE_LOCAL, NULL, 0);
@@ -1695,7 +2001,7 @@ bio_readv(struct bio_io_context *ioctxt, struct bio_sglist *bsgl,
 {
 	int	rc;
 
-	rc = bio_rwv(ioctxt, bsgl, sgl, false);
+	rc = bio_rwv(ioctxt, bsgl, sgl, false, BIO_IOC_FG);
 	if (rc)
 		D_ERROR("Readv to blob:%p failed for xs:%p, rc:%d\n",
 			ioctxt->bic_blob, ioctxt->bic_xs_ctxt, rc);
@@ -1712,7 +2018,7 @@ bio_writev(struct bio_io_context *ioctxt, struct bio_sglist *bsgl,
 {
 	int	rc;
 
-	rc = bio_rwv(ioctxt, bsgl, sgl, true);
+	rc = bio_rwv(ioctxt, bsgl, sgl, true, BIO_IOC_FG);
 	if (rc)
 		D_ERROR("Writev to blob:%p failed for xs:%p, rc:%d\n",
 			ioctxt->bic_blob, ioctxt->bic_xs_ctxt, rc);
@@ -1725,7 +2031,7 @@ bio_writev(struct bio_io_context *ioctxt, struct bio_sglist *bsgl,
 
 static int
 bio_rw(struct bio_io_context *ioctxt, bio_addr_t addr, d_iov_t *iov,
-	bool update)
+	bool update, unsigned int ioc)
 {
 	struct bio_sglist	bsgl;
 	struct bio_iov		biov;
@@ -1740,7 +2046,7 @@ bio_rw(struct bio_io_context *ioctxt, bio_addr_t addr, d_iov_t *iov,
 	sgl.sg_nr = 1;
 	sgl.sg_nr_out = 0;
 
-	rc = bio_rwv(ioctxt, &bsgl, &sgl, update);
+	rc = bio_rwv(ioctxt, &bsgl, &sgl, update, ioc);
 	if (rc)
 		D_ERROR("%s to blob:%p failed for xs:%p, rc:%d\n",
 			update ? "Write" : "Read", ioctxt->bic_blob,
@@ -1756,13 +2062,20 @@ bio_rw(struct bio_io_context *ioctxt, bio_addr_t addr, d_iov_t *iov,
 int
 bio_read(struct bio_io_context *ioctxt, bio_addr_t addr, d_iov_t *iov)
 {
-	return bio_rw(ioctxt, addr, iov, false);
+	return bio_rw(ioctxt, addr, iov, false, BIO_IOC_FG);
+}
+
+int
+bio_read_class(struct bio_io_context *ioctxt, bio_addr_t addr, d_iov_t *iov,
+	       enum bio_io_class ioc)
+{
+	return bio_rw(ioctxt, addr, iov, false, ioc);
 }
 
 int
 bio_write(struct bio_io_context *ioctxt, bio_addr_t addr, d_iov_t *iov)
 {
-	return bio_rw(ioctxt, addr, iov, true);
+	return bio_rw(ioctxt, addr, iov, true, BIO_IOC_FG);
 }
 
 struct bio_desc *
@@ -1892,6 +2205,9 @@ bio_copy_prep(struct bio_io_context *ioctxt, struct umem_instance *umem,
 		return -DER_NOMEM;
 	}
 
+	/* Local copy is used by aggregation */
+	copy_desc->bcd_iod_src->bd_io_class = BIO_IOC_AGG;
+	copy_desc->bcd_iod_dst->bd_io_class = BIO_IOC_AGG;
 	rc = bio_iod_prep(copy_desc->bcd_iod_src, BIO_CHK_TYPE_LOCAL, NULL, 0);
 	if (rc)
 		goto free;
@@ -1,5 +1,6 @@
 /**
  * (C) Copyright 2021-2024 Intel Corporation.
+ * (C) Copyright 2026 Hewlett Packard Enterprise Development LP
  *
  * SPDX-License-Identifier: BSD-2-Clause-Patent
  */
@@ -273,8 +274,23 @@ bulk_reclaim_chunk(struct bio_dma_buffer *bdb, struct bio_bulk_group *ex_grp)
 	return -DER_AGAIN;
 }
 
+/*
+ * Free the bulk handle registered over a DMA chunk, it's called on freeing the chunk, since
+ * the bulk handle is kept along with the chunk after it being evicted from bulk group.
+ */
+void
+bulk_chunk_fini(struct bio_dma_chunk *chk)
+{
+	if (chk->bdc_bulks == NULL) {
+		D_ASSERT(chk->bdc_bulk_hdl == NULL);
+		return;
+	}
+
+	bulk_chunk_depopulate(chk, true);
+}
+
 static int
-bulk_create_hdl(struct bio_dma_chunk *chk, struct bio_bulk_args *arg)
+bulk_create_hdl(struct bio_dma_chunk *chk, unsigned int pg_cnt, struct bio_bulk_args *arg)
 {
 	d_sg_list_t	sgl;
 	int		rc;
@@ -285,8 +301,8 @@ bulk_create_hdl(struct bio_dma_chunk *chk, struct bio_bulk_args *arg)
 
 	sgl.sg_nr_out = sgl.sg_nr;
 	sgl.sg_iovs[0].iov_buf = chk->bdc_ptr;
-	sgl.sg_iovs[0].iov_buf_len = (bio_chk_sz << BIO_DMA_PAGE_SHIFT);
-	sgl.sg_iovs[0].iov_len = (bio_chk_sz << BIO_DMA_PAGE_SHIFT);
+	sgl.sg_iovs[0].iov_buf_len = ((size_t)pg_cnt << BIO_DMA_PAGE_SHIFT);
+	sgl.sg_iovs[0].iov_len = ((size_t)pg_cnt << BIO_DMA_PAGE_SHIFT);
 
 	rc = bulk_create_fn(arg->ba_bulk_ctxt, &sgl, arg->ba_bulk_perm,
 			    &chk->bdc_bulk_hdl);
@@ -320,7 +336,7 @@ bulk_chunk_populate(struct bio_dma_chunk *chk, struct bio_bulk_group *bbg,
 		}
 
 		D_ASSERT(chk->bdc_bulk_hdl == NULL);
-		rc = bulk_create_hdl(chk, arg);
+		rc = bulk_create_hdl(chk, bio_chk_sz, arg);
 		if (rc)
 			goto error;
 	}
@@ -358,12 +374,23 @@ bulk_grp_grow(struct bio_dma_buffer *bdb, struct bio_bulk_group *bbg,
 	struct bio_dma_chunk	*chk;
 	int			 rc;
 
+	/* Leave the reserved chunks to small IODs, evict unused chunk from other bulk group */
+	if (bbg->bbg_bulk_pgs > BIO_DMA_SMALL_PGS && dma_small_rsv_reached(bdb)) {
+		rc = bulk_reclaim_chunk(bdb, bbg);
+		if (rc) {
+			if (bdb->bdb_stats.bds_rsv_waits)
+				d_tm_inc_counter(bdb->bdb_stats.bds_rsv_waits, 1);
+			return rc;
+		}
+		goto populate;
+	}
+
 	/* Try grab an idle chunk first */
 	if (!d_list_empty(&bdb->bdb_idle_list))
 		goto populate;
 
 	/* Grow DMA buffer when not reaching DMA upper bound */
-	if (bdb->bdb_tot_cnt < bio_chk_cnt_max) {
+	if (dma_buffer_growable(bdb)) {
 		rc = dma_buffer_grow(bdb, 1);
 		if (rc == 0)
 			goto populate;
@@ -407,11 +434,16 @@ bulk_hdl_unhold(struct bio_bulk_hdl *hdl)
 		hdl->bbh_remote_idx = 0;
 
 		D_ASSERT(chk != NULL);
+		/* Dedicated bulk handle of huge chunk isn't managed by bulk group */
+		if (chk->bdc_bulk_grp == NULL) {
+			D_ASSERT(chk->bdc_class == BIO_DMA_CLASS_LARGE);
+			return;
+		}
+
 		D_ASSERT(chk->bdc_bulk_idle < chk->bdc_bulk_cnt);
 		chk->bdc_bulk_idle++;
 
 		bbg = chk->bdc_bulk_grp;
-		D_ASSERT(bbg != NULL);
 		d_list_add_tail(&hdl->bbh_link, &bbg->bbg_idle_bulks);
 	}
 }
@@ -452,7 +484,11 @@ bulk_hdl2len(struct bio_bulk_hdl *hdl)
 
 	D_ASSERT(chk != NULL);
 	bbg = chk->bdc_bulk_grp;
-	D_ASSERT(bbg != NULL);
+	/* Huge chunk */
+	if (bbg == NULL) {
+		D_ASSERT(chk->bdc_pg_cnt > bio_chk_sz);
+		return chk->bdc_pg_cnt << BIO_DMA_PAGE_SHIFT;
+	}
 
 	return bbg->bbg_bulk_pgs << BIO_DMA_PAGE_SHIFT;
 }
@@ -529,6 +565,58 @@ done:
 	return hdl;
 }
 
+/*
+ * Huge IOV is mapped to a dedicated huge chunk by dma_map_one(), register the whole chunk for
+ * RDMA and keep the bulk handle along with the chunk, so that the payload can be transferred
+ * into the DMA buffer directly, and the chunk reused from the per-xstream huge chunk cache
+ * doesn't need to be registered again.
+ *
+ * Return NULL on registration failure, the caller will create bulk handle on-the-fly then.
+ */
+static struct bio_bulk_hdl *
+bulk_get_huge_hdl(struct bio_desc *biod, struct bio_iov *biov, unsigned int pg_off,
+		  struct bio_bulk_args *arg)
+{
+	struct bio_rsrvd_dma	*rsrvd_dma = &biod->bd_rsrvd;
+	struct bio_dma_chunk	*chk;
+	struct bio_bulk_hdl	*hdl;
+	int			 rc;
+
+	D_ASSERT(rsrvd_dma->brd_chk_cnt > 0);
+	chk = rsrvd_dma->brd_dma_chks[rsrvd_dma->brd_chk_cnt - 1];
+	D_ASSERT(chk->bdc_class == BIO_DMA_CLASS_LARGE);
+	D_ASSERT(chk->bdc_ref == 1 && chk->bdc_bulk_grp == NULL);
+
+	if (chk->bdc_bulks == NULL) {
+		D_ALLOC_ARRAY(chk->bdc_bulks, 1);
+		if (chk->bdc_bulks == NULL)
+			return NULL;
+
+		hdl = &chk->bdc_bulks[0];
+		D_INIT_LIST_HEAD(&hdl->bbh_link);
+		hdl->bbh_chunk = chk;
+
+		D_ASSERT(chk->bdc_bulk_hdl == NULL);
+		rc = bulk_create_hdl(chk, chk->bdc_pg_cnt, arg);
+		if (rc) {
+			D_FREE(chk->bdc_bulks);
+			return NULL;
+		}
+	}
+
+	hdl = &chk->bdc_bulks[0];
+	D_ASSERT(hdl->bbh_inuse == 0);
+	hdl->bbh_inuse = 1;
+	hdl->bbh_pg_idx = 0;
+	/* biov->bi_prefix_len is for csum, not included in bulk transfer */
+	hdl->bbh_bulk_off = pg_off + biov->bi_prefix_len;
+	hdl->bbh_remote_idx = arg->ba_sgl_idx;
+
+	D_DEBUG(DB_IO, "Huge chunk bulk:%p[%p], cnt:%u, off:%u\n", chk, chk->bdc_ptr,
+		chk->bdc_pg_cnt, pg_off);
+	return hdl;
+}
+
 static inline bool
 bypass_bulk_cache(struct bio_desc *biod, struct bio_iov *biov,
 		  unsigned int pg_cnt)
@@ -610,7 +698,7 @@ bulk_map_one(struct bio_desc *biod, struct bio_iov *biov, void *data)
 	struct bio_bulk_args	*arg = data;
 	struct bio_bulk_hdl	*hdl = NULL;
 	uint64_t		 off, end;
-	unsigned int		 pg_cnt, pg_off;
+	unsigned int		 pg_cnt, pg_off, chk_cnt;
 	int			 rc = 0;
 
 	D_ASSERT(bulk_create_fn != NULL && bulk_free_fn != NULL);
@@ -636,7 +724,11 @@ bulk_map_one(struct bio_desc *biod, struct bio_iov *biov, void *data)
 	dma_biov2pg(biov, &off, &end, &pg_cnt, &pg_off);
 
 	if (bypass_bulk_cache(biod, biov, pg_cnt)) {
+		chk_cnt = biod->bd_rsrvd.brd_chk_cnt;
 		rc = dma_map_one(biod, biov, NULL);
+		/* Huge IOV mapped to a dedicated huge chunk */
+		if (rc == 0 && pg_cnt > bio_chk_sz && biod->bd_rsrvd.brd_chk_cnt > chk_cnt)
+			hdl = bulk_get_huge_hdl(biod, biov, pg_off, arg);
 		goto done;
 	}
 	D_ASSERT(!BIO_ADDR_IS_DEDUP(&biov->bi_addr));
@@ -23,6 +23,8 @@
 #define BIO_BLOB_HDR_MAGIC	(0xb0b51ed5)
 #define BIO_DMA_PAGE_SHIFT	12	/* 4K */
 #define BIO_DMA_PAGE_SZ		(1UL << BIO_DMA_PAGE_SHIFT)
+/* IOD with no more than this many DMA pages (64k) is classified as small */
+#define BIO_DMA_SMALL_PGS	16
 #define BIO_XS_CNT_MAX		BIO_MAX_VOS_TGT_CNT /* Max VOS xstreams per blobstore */
 /*
  * Period to query raw device health stats, auto detect faulty and transition
@@ -86,6 +88,10 @@ struct bio_dma_chunk {
 	unsigned int	 bdc_ref;
 	/* Chunk type */
 	unsigned int	 bdc_type;
+	/* Size class, see bio_dma_class */
+	unsigned int	 bdc_class;
+	/* Chunk size in pages, only set for huge chunk */
+	unsigned int	 bdc_pg_cnt;
 	/* == Bulk handle caching related fields == */
 	struct bio_bulk_group	*bdc_bulk_grp;
 	struct bio_bulk_hdl	*bdc_bulks;
@@ -105,9 +111,24 @@ struct bio_bulk_cache {
 	d_list_t		  bbc_grp_lru;
 };
 
+/*
+ * DMA buffer size classes. Small and medium IODs are served from different
+ * 'current chunks', so that short-lived small IODs won't pin the chunks used
+ * by large IODs (and vice versa). Large class is for IOV exceeding chunk size.
+ */
+enum bio_dma_class {
+	BIO_DMA_CLASS_SMALL	= 0,
+	BIO_DMA_CLASS_MEDIUM,
+	BIO_DMA_CLASS_LARGE,
+	BIO_DMA_CLASS_MAX,
+};
+
 struct bio_dma_stats {
 	struct d_tm_node_t	*bds_chks_tot;
 	struct d_tm_node_t	*bds_chks_used[BIO_CHK_TYPE_MAX];
+	struct d_tm_node_t	*bds_class_used[BIO_DMA_CLASS_MAX];
+	struct d_tm_node_t	*bds_huge_cached;
+	struct d_tm_node_t	*bds_rsv_waits;
 	struct d_tm_node_t	*bds_bulk_grps;
 	struct d_tm_node_t	*bds_active_iods;
 	struct d_tm_node_t	*bds_queued_iods;
@@ -122,8 +143,12 @@ struct bio_dma_stats {
 struct bio_dma_buffer {
 	d_list_t		 bdb_idle_list;
 	d_list_t		 bdb_used_list;
-	struct bio_dma_chunk	*bdb_cur_chk[BIO_CHK_TYPE_MAX];
+	/* Freed huge chunks kept for reuse, in LRU order */
+	d_list_t		 bdb_huge_list;
+	struct bio_dma_chunk	*bdb_cur_chk[BIO_CHK_TYPE_MAX][BIO_DMA_CLASS_MAX];
 	unsigned int		 bdb_used_cnt[BIO_CHK_TYPE_MAX];
+	unsigned int		 bdb_class_cnt[BIO_DMA_CLASS_MAX];
+	unsigned int		 bdb_huge_pgs;
 	unsigned int		 bdb_tot_cnt;
 	unsigned int		 bdb_active_iods;
 	unsigned int		 bdb_queued_iods;
@@ -360,10 +385,36 @@ struct bio_io_lug {
 	uint32_t bil_ref;
 };
 
+/* Per-class state of blobstore I/O scheduler */
+struct bio_sched_class {
+	/* I/Os waiting for admission, in FIFO order */
+	d_list_t		 bsc_waiters;
+	unsigned int		 bsc_waiter_cnt;
+	/* In-flight blob I/Os */
+	unsigned int		 bsc_inflights;
+	/* Token bucket for bandwidth limit, in bytes, could be negative */
+	int64_t			 bsc_tokens;
+	/* Last token refill time in us */
+	uint64_t		 bsc_refill_ts;
+	struct d_tm_node_t	*bsc_queue_lat;
+	struct d_tm_node_t	*bsc_queued;
+	struct d_tm_node_t	*bsc_inflight;
+	/* Blob I/O latency percentiles, shared by all targets */
+	struct d_tm_node_t	*bsc_io_lat;
+};
+
+/* Per-xstream blobstore I/O scheduler */
+struct bio_io_sched {
+	struct bio_sched_class	 bis_classes[BIO_IOC_MAX];
+	unsigned int		 bis_waiter_cnt;
+};
+
 /* Per-xstream blobstore */
 struct bio_xs_blobstore {
 	/* In-flight blob read/write */
 	unsigned int		 bxb_blob_rw;
+	/* I/O scheduler for the blob read/write */
+	struct bio_io_sched	 bxb_sched;
 	/* Pending I/Os */
 	d_list_t                 bxb_pending_ios;
 	/* spdk io channel */
@@ -492,9 +543,14 @@ struct bio_desc {
 	unsigned int		 bd_inflights;
 	int			 bd_result;
 	unsigned int		 bd_chk_type;
+	unsigned int		 bd_dma_class;
+	/* I/O class for blobstore I/O scheduler */
+	unsigned int		 bd_io_class;
 	unsigned int		 bd_type;
 	/* Total bytes landed to data blob */
 	unsigned int		 bd_nvme_bytes;
+	/* When the first blob I/O is submitted, in us */
+	uint64_t		 bd_dma_start;
 	/* Flags */
 	unsigned int		 bd_buffer_prep:1,
 				 bd_dma_issued:1,
@@ -503,7 +559,8 @@ struct bio_desc {
 				 bd_copy_dst:1,
 				 bd_in_fifo:1,
 				 bd_async_post:1,
-				 bd_non_blocking:1;
+				 bd_non_blocking:1,
+				 bd_prefetch:1;
 	/* Cached bulk handles being used by this IOD */
 	struct bio_bulk_hdl    **bd_bulk_hdls;
 	unsigned int		 bd_bulk_max;
@@ -588,8 +645,12 @@ extern bool                             bio_spdk_inited;
 extern unsigned int	bio_chk_sz;
 extern unsigned int	bio_chk_cnt_max;
 extern unsigned int	bio_numa_node;
+extern unsigned int	bio_chk_small_pct;
 extern unsigned int	bio_spdk_max_unmap_cnt;
 extern unsigned int	bio_max_async_sz;
+extern bool                             bio_wal_group_commit;
+extern unsigned int                     bio_wal_batch_window;
+extern bool                             bio_wal_compress;
 extern unsigned int                     bio_io_timeout;
 extern unsigned int                     bio_spdk_power_mgmt_val;
 
@@ -617,6 +678,17 @@ void destroy_bio_bdev(struct bio_bdev *d_bdev);
 void replace_bio_bdev(struct bio_bdev *old_dev, struct bio_bdev *new_dev);
 bool bypass_health_collect(void);
 void drain_inflight_ios(struct bio_xs_context *ctxt, struct bio_xs_blobstore *bbs);
+
+/* bio_sched.c */
+void bio_sched_env_init(void);
+void bio_sched_init(struct bio_io_sched *sched);
+void bio_sched_metrics_init(struct bio_io_sched *sched, int tgt_id, int tgt_nr);
+unsigned int bio_sched_io_class(struct bio_desc *biod);
+void bio_sched_admit(struct bio_xs_context *xs_ctxt, struct bio_xs_blobstore *bxb,
+		     unsigned int ioc, uint64_t bytes);
+void bio_sched_done(struct bio_xs_blobstore *bxb, unsigned int ioc);
+void bio_sched_io_end(struct bio_xs_context *xs_ctxt, struct bio_xs_blobstore *bxb,
+		      unsigned int ioc, uint64_t start);
 uint32_t default_cluster_sz(void);
 int bdev_name2roles(const char *bdev_name);
 
@@ -629,8 +701,12 @@ int dma_map_one(struct bio_desc *biod, struct bio_iov *biov, void *arg);
 int iod_add_region(struct bio_desc *biod, struct bio_dma_chunk *chk,
 		   unsigned int chk_pg_idx, unsigned int chk_off, uint64_t off,
 		   uint64_t end, uint8_t media);
+bool dma_buffer_growable(struct bio_dma_buffer *buf);
 int dma_buffer_grow(struct bio_dma_buffer *buf, unsigned int cnt);
+bool dma_small_rsv_reached(struct bio_dma_buffer *bdb);
 void iod_dma_wait(struct bio_desc *biod);
+int bio_iod_prefetch(struct bio_desc *biod);
+int bio_iod_prefetch_wait(struct bio_desc *biod);
 void
 bio_io_monitor(struct bio_xs_context *xs_ctxt, uint64_t now);
 
@@ -674,6 +750,7 @@ ioc2d_bdev(struct bio_io_context *ioc)
 /* bio_bulk.c */
 int bulk_map_one(struct bio_desc *biod, struct bio_iov *biov, void *data);
 void bulk_iod_release(struct bio_desc *biod);
+void bulk_chunk_fini(struct bio_dma_chunk *chk);
 int bulk_cache_create(struct bio_dma_buffer *bdb);
 void bulk_cache_destroy(struct bio_dma_buffer *bdb);
 int bulk_reclaim_chunk(struct bio_dma_buffer *bdb,
@@ -0,0 +1,375 @@
+/**
+ * (C) Copyright 2026 Hewlett Packard Enterprise Development LP
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+/*
+ * Per-xstream blobstore I/O scheduler.
+ *
+ * Blob I/Os are classified into foreground, checkpointing, rebuild, aggregation and scrubbing
+ * classes. Foreground I/Os are always submitted immediately, I/Os of other classes have to be
+ * admitted by the scheduler before submitting to SPDK:
+ *
+ * - Each class has a cap of in-flight blob I/Os (queue depth) on the device;
+ * - Each class has a token bucket based bandwidth limit;
+ * - Waiters are admitted in deadline order (enqueue time + class deadline), a waiter passed
+ *   its deadline is allowed to exceed the queue depth cap, but not the bandwidth limit.
+ *
+ * The scheduler state is per-xstream, it's only accessed by the owner xstream, no locking
+ * is required.
+ */
+#define D_LOGFAC	DD_FAC(bio)
+
+#include <ctype.h>
+#include "bio_internal.h"
+
+struct bio_sched_attr {
+	/* Max in-flight blob I/Os, 0 means unlimited */
+	unsigned int	bsa_qd;
+	/* Bandwidth limit in MB/s, 0 means unlimited */
+	unsigned int	bsa_bw;
+	/* Max queuing time in ms before exceeding the queue depth cap */
+	unsigned int	bsa_deadline;
+};
+
+static struct bio_sched_attr bio_sched_attrs[BIO_IOC_MAX] = {
+	[BIO_IOC_FG]		= { .bsa_qd = 0,	.bsa_bw = 0,	.bsa_deadline = 0 },
+	[BIO_IOC_CHKPT]		= { .bsa_qd = 0,	.bsa_bw = 0,	.bsa_deadline = 1 },
+	[BIO_IOC_REBUILD]	= { .bsa_qd = 64,	.bsa_bw = 0,	.bsa_deadline = 10 },
+	[BIO_IOC_AGG]		= { .bsa_qd = 32,	.bsa_bw = 0,	.bsa_deadline = 50 },
+	[BIO_IOC_SCRUB]		= { .bsa_qd = 8,	.bsa_bw = 0,	.bsa_deadline = 100 },
+};
+
+/* Whether the blobstore I/O scheduler is enabled */
+static bool bio_sched_enabled = true;
+
+/* Token bucket burst, in milliseconds of the bandwidth limit */
+#define BIO_SCHED_BURST_MS	100
+
+struct bio_sched_waiter {
+	d_list_t	bsw_link;
+	uint64_t	bsw_bytes;
+	uint64_t	bsw_enq_ts;
+	bool		bsw_granted;
+};
+
+static inline char *
+ioc2str(unsigned int ioc)
+{
+	switch (ioc) {
+	case BIO_IOC_FG:
+		return "fg";
+	case BIO_IOC_CHKPT:
+		return "chkpt";
+	case BIO_IOC_REBUILD:
+		return "rebuild";
+	case BIO_IOC_AGG:
+		return "agg";
+	case BIO_IOC_SCRUB:
+		return "scrub";
+	default:
+		return "unknown";
+	}
+}
+
+static void
+sched_attr_getenv(const char *prefix, unsigned int ioc, unsigned int *val)
+{
+	char	name[64];
+	int	i;
+
+	snprintf(name, sizeof(name), "%s_%s", prefix, ioc2str(ioc));
+	for (i = 0; name[i] != '\0'; i++)
+		name[i] = toupper(name[i]);
+
+	d_getenv_uint(name, val);
+}
+
+void
+bio_sched_env_init(void)
+{
+	struct bio_sched_attr	*attr;
+	unsigned int		 ioc;
+
+	d_getenv_bool("DAOS_BIO_SCHED", &bio_sched_enabled);
+	D_INFO("Blobstore I/O scheduler is %s\n", bio_sched_enabled ? "enabled" : "disabled");
+	if (!bio_sched_enabled)
+		return;
+
+	/* Foreground I/O is never throttled */
+	for (ioc = BIO_IOC_FG + 1; ioc < BIO_IOC_MAX; ioc++) {
+		attr = &bio_sched_attrs[ioc];
+
+		sched_attr_getenv("DAOS_BIO_QD", ioc, &attr->bsa_qd);
+		sched_attr_getenv("DAOS_BIO_BW", ioc, &attr->bsa_bw);
+		sched_attr_getenv("DAOS_BIO_DEADLINE", ioc, &attr->bsa_deadline);
+
+		D_INFO("I/O class %s: qd:%u, bw:%uMB/s, deadline:%ums\n", ioc2str(ioc),
+		       attr->bsa_qd, attr->bsa_bw, attr->bsa_deadline);
+	}
+}
+
+void
+bio_sched_init(struct bio_io_sched *sched)
+{
+	struct bio_sched_class	*cls;
+	unsigned int		 ioc;
+
+	for (ioc = BIO_IOC_FG; ioc < BIO_IOC_MAX; ioc++) {
+		cls = &sched->bis_classes[ioc];
+
+		D_INIT_LIST_HEAD(&cls->bsc_waiters);
+		cls->bsc_waiter_cnt = 0;
+		cls->bsc_inflights = 0;
+		cls->bsc_tokens = 0;
+		cls->bsc_refill_ts = 0;
+	}
+	sched->bis_waiter_cnt = 0;
+}
+
+void
+bio_sched_metrics_init(struct bio_io_sched *sched, int tgt_id, int tgt_nr)
+{
+	struct bio_sched_class	*cls;
+	unsigned int		 ioc;
+	int			 rc;
+
+	for (ioc = BIO_IOC_FG; ioc < BIO_IOC_MAX; ioc++) {
+		cls = &sched->bis_classes[ioc];
+
+		rc = d_tm_add_metric(&cls->bsc_queue_lat, D_TM_STATS_GAUGE,
+				     "Time waiting for I/O scheduler admission", "us",
+				     "io_sched/%s/queue_lat/tgt_%d", ioc2str(ioc), tgt_id);
+		if (rc)
+			D_WARN("Failed to create %s queue_lat telemetry: "DF_RC"\n",
+			       ioc2str(ioc), DP_RC(rc));
+
+		rc = d_tm_add_metric(&cls->bsc_queued, D_TM_GAUGE,
+				     "I/Os waiting for I/O scheduler admission", "io",
+				     "io_sched/%s/queued/tgt_%d", ioc2str(ioc), tgt_id);
+		if (rc)
+			D_WARN("Failed to create %s queued telemetry: "DF_RC"\n",
+			       ioc2str(ioc), DP_RC(rc));
+
+		rc = d_tm_add_metric(&cls->bsc_inflight, D_TM_GAUGE, "In-flight blob I/Os", "io",
+				     "io_sched/%s/inflight/tgt_%d", ioc2str(ioc), tgt_id);
+		if (rc)
+			D_WARN("Failed to create %s inflight telemetry: "DF_RC"\n",
+			       ioc2str(ioc), DP_RC(rc));
+
+		rc = d_tm_add_loghist(&cls->bsc_io_lat, tgt_nr, D_TM_LOGHIST_SUB_BITS,
+				      D_TM_LOGHIST_MAX_BITS, "Blob I/O latency percentiles", "us",
+				      "io_sched/%s/io_lat_hist", ioc2str(ioc));
+		if (rc)
+			D_WARN("Failed to create %s io_lat_hist telemetry: "DF_RC"\n",
+			       ioc2str(ioc), DP_RC(rc));
+	}
+}
+
+/* Classify IOD for blobstore I/O scheduler, if it isn't specified by caller */
+unsigned int
+bio_sched_io_class(struct bio_desc *biod)
+{
+	if (biod->bd_io_class != BIO_IOC_FG)
+		return biod->bd_io_class;
+
+	if (biod->bd_chk_type == BIO_CHK_TYPE_REBUILD)
+		return BIO_IOC_REBUILD;
+	/* Non-blocking prep request is from checkpointing */
+	if (biod->bd_non_blocking)
+		return BIO_IOC_CHKPT;
+
+	return BIO_IOC_FG;
+}
+
+static void
+sched_refill(struct bio_sched_class *cls, struct bio_sched_attr *attr, uint64_t now)
+{
+	int64_t		burst = ((int64_t)attr->bsa_bw << 20) * BIO_SCHED_BURST_MS / 1000;
+	uint64_t	elapsed;
+
+	/* The first I/O of the class */
+	if (cls->bsc_refill_ts == 0) {
+		cls->bsc_refill_ts = now;
+		cls->bsc_tokens = burst;
+		return;
+	}
+
+	if (now <= cls->bsc_refill_ts)
+		return;
+
+	elapsed = now - cls->bsc_refill_ts;
+	cls->bsc_refill_ts = now;
+	cls->bsc_tokens += (int64_t)((elapsed * attr->bsa_bw << 20) / 1000000);
+	if (cls->bsc_tokens > burst)
+		cls->bsc_tokens = burst;
+}
+
+/*
+ * Whether the class can admit one more I/O. To not block an I/O larger than the bucket burst
+ * forever, admitted I/O is allowed to drive tokens negative (borrow from future).
+ */
+static bool
+sched_class_ready(struct bio_sched_class *cls, unsigned int ioc, uint64_t now, bool expired)
+{
+	struct bio_sched_attr	*attr = &bio_sched_attrs[ioc];
+
+	if (attr->bsa_qd != 0 && cls->bsc_inflights >= attr->bsa_qd && !expired)
+		return false;
+
+	if (attr->bsa_bw != 0) {
+		sched_refill(cls, attr, now);
+		if (cls->bsc_tokens <= 0)
+			return false;
+	}
+
+	return true;
+}
+
+static inline void
+sched_charge(struct bio_sched_class *cls, unsigned int ioc, uint64_t bytes)
+{
+	if (bio_sched_attrs[ioc].bsa_bw != 0)
+		cls->bsc_tokens -= bytes;
+
+	cls->bsc_inflights++;
+	if (cls->bsc_inflight)
+		d_tm_set_gauge(cls->bsc_inflight, cls->bsc_inflights);
+}
+
+static inline uint64_t
+waiter_deadline(struct bio_sched_waiter *waiter, unsigned int ioc)
+{
+	return waiter->bsw_enq_ts + (uint64_t)bio_sched_attrs[ioc].bsa_deadline * 1000;
+}
+
+/* Admit waiters in deadline order, as many as the class limits allow */
+static void
+sched_dispatch(struct bio_io_sched *sched)
+{
+	struct bio_sched_class	*cls;
+	struct bio_sched_waiter	*waiter, *best;
+	uint64_t		 now, deadline, best_deadline;
+	unsigned int		 ioc, best_ioc = 0;
+
+	now = daos_getutime();
+	while (sched->bis_waiter_cnt > 0) {
+		best = NULL;
+		best_deadline = UINT64_MAX;
+
+		for (ioc = BIO_IOC_FG; ioc < BIO_IOC_MAX; ioc++) {
+			cls = &sched->bis_classes[ioc];
+			if (d_list_empty(&cls->bsc_waiters))
+				continue;
+
+			waiter = d_list_entry(cls->bsc_waiters.next, struct bio_sched_waiter,
+					      bsw_link);
+			deadline = waiter_deadline(waiter, ioc);
+			if (deadline >= best_deadline ||
+			    !sched_class_ready(cls, ioc, now, now >= deadline))
+				continue;
+
+			best = waiter;
+			best_deadline = deadline;
+			best_ioc = ioc;
+		}
+
+		if (best == NULL)
+			break;
+
+		cls = &sched->bis_classes[best_ioc];
+		d_list_del_init(&best->bsw_link);
+		D_ASSERT(cls->bsc_waiter_cnt > 0 && sched->bis_waiter_cnt > 0);
+		cls->bsc_waiter_cnt--;
+		sched->bis_waiter_cnt--;
+		if (cls->bsc_queued)
+			d_tm_set_gauge(cls->bsc_queued, cls->bsc_waiter_cnt);
+
+		sched_charge(cls, best_ioc, best->bsw_bytes);
+		best->bsw_granted = true;
+	}
+}
+
+/*
+ * Called before submitting a blob I/O of @bytes, the caller could yield until the I/O
+ * is admitted by the scheduler.
+ */
+void
+bio_sched_admit(struct bio_xs_context *xs_ctxt, struct bio_xs_blobstore *bxb, unsigned int ioc,
+		uint64_t bytes)
+{
+	struct bio_io_sched	*sched = &bxb->bxb_sched;
+	struct bio_sched_class	*cls;
+	struct bio_sched_waiter	 waiter;
+	uint64_t		 now;
+
+	D_ASSERT(ioc < BIO_IOC_MAX);
+	cls = &sched->bis_classes[ioc];
+
+	if (!bio_sched_enabled || ioc == BIO_IOC_FG)
+		goto admit;
+
+	now = daos_getutime();
+	/* No prior waiters in the same class */
+	if (d_list_empty(&cls->bsc_waiters) && sched_class_ready(cls, ioc, now, false))
+		goto admit;
+
+	waiter.bsw_bytes = bytes;
+	waiter.bsw_enq_ts = now;
+	waiter.bsw_granted = false;
+	d_list_add_tail(&waiter.bsw_link, &cls->bsc_waiters);
+	cls->bsc_waiter_cnt++;
+	sched->bis_waiter_cnt++;
+	if (cls->bsc_queued)
+		d_tm_set_gauge(cls->bsc_queued, cls->bsc_waiter_cnt);
+
+	while (1) {
+		sched_dispatch(sched);
+		if (waiter.bsw_granted)
+			break;
+
+		if (xs_ctxt->bxc_self_polling)
+			spdk_thread_poll(xs_ctxt->bxc_thread, 0, 0);
+		else
+			bio_yield(NULL);
+	}
+
+	if (cls->bsc_queue_lat)
+		d_tm_set_gauge(cls->bsc_queue_lat, daos_getutime() - waiter.bsw_enq_ts);
+	return;
+admit:
+	sched_charge(cls, ioc, bytes);
+}
+
+/* Called on blob I/O completion */
+void
+bio_sched_done(struct bio_xs_blobstore *bxb, unsigned int ioc)
+{
+	struct bio_io_sched	*sched = &bxb->bxb_sched;
+	struct bio_sched_class	*cls;
+
+	D_ASSERT(ioc < BIO_IOC_MAX);
+	cls = &sched->bis_classes[ioc];
+
+	D_ASSERT(cls->bsc_inflights > 0);
+	cls->bsc_inflights--;
+	if (cls->bsc_inflight)
+		d_tm_set_gauge(cls->bsc_inflight, cls->bsc_inflights);
+
+	if (sched->bis_waiter_cnt > 0)
+		sched_dispatch(sched);
+}
+
+/* Called when all the blob I/Os of an IOD are completed */
+void
+bio_sched_io_end(struct bio_xs_context *xs_ctxt, struct bio_xs_blobstore *bxb, unsigned int ioc,
+		 uint64_t start)
+{
+	struct bio_sched_class	*cls;
+
+	D_ASSERT(ioc < BIO_IOC_MAX);
+	cls = &bxb->bxb_sched.bis_classes[ioc];
+
+	if (cls->bsc_io_lat)
+		d_tm_record_loghist(cls->bsc_io_lat, xs_ctxt->bxc_tgt_id, daos_getutime() - start);
+}
@@ -6,9 +6,11 @@
  */
 #define D_LOGFAC	DD_FAC(bio)
 
+#include <daos/compression.h>
 #include "bio_wal.h"
 
 #define WAL_HDR_MAGIC		(0xc01d2019)
+#define WAL_TX_MAGIC_ZIP	(0xc01d2026)		/* Transaction with compressed payload */
 
 #define WAL_ID_BITS		64			/* Never change this */
 #define WAL_ID_OFF_BITS		32
@@ -26,7 +28,11 @@ D_CASSERT(sizeof(struct wal_trans_tail) == WAL_CSUM_LEN);
 #define WAL_MIN_CAPACITY	(8192 * WAL_BLK_SZ)	/* Minimal WAL capacity, in bytes */
 #define WAL_MAX_TRANS_BLKS	4096			/* Maximal blocks used by a transaction */
 #define WAL_MAX_REPLAY_BLKS     (WAL_MAX_TRANS_BLKS * 2)
+#define WAL_REPLAY_PREFETCH_SZ	(8UL << 20)		/* WAL replay prefetch size */
+#define WAL_BATCH_MAX_TXS	64			/* Maximal transactions in a batch */
+#define WAL_BATCH_MAX_BLKS	256			/* Maximal blocks used by a batch */
 #define WAL_HDR_BLKS		1			/* Ensure atomic header write */
+#define WAL_ZIP_MIN_PAYLOAD	WAL_BLK_SZ		/* Minimal payload size to compress */
 
 #define META_BLK_SZ		WAL_BLK_SZ
 #define META_HDR_BLKS		1
@@ -522,9 +528,151 @@ struct data_csum_array {
 	struct umem_action	 dca_inline_acts[INLINE_DATA_CSUM_NR];
 };
 
+/* Compressed transaction payload */
+struct wal_tx_zip {
+	char		*tz_buf;	/* Uncompressed size followed by compressed payload */
+	unsigned int	 tz_len;	/* Total bytes in tz_buf */
+};
+
+static inline void
+wal_tx_zip_free(struct wal_tx_zip *zip)
+{
+	D_FREE(zip->tz_buf);
+	zip->tz_len = 0;
+}
+
+/* Concatenate payload of all actions in the order of fill_trans_blks() */
+static void
+gather_payload(struct umem_wal_tx *tx, char *buf, unsigned int buf_len)
+{
+	struct umem_action	*act;
+	unsigned int		 off = 0;
+
+	for (act = umem_tx_act_first(tx); act != NULL; act = umem_tx_act_next(tx)) {
+		switch (act->ac_opc) {
+		case UMEM_ACT_COPY:
+			D_ASSERT(off + act->ac_copy.size <= buf_len);
+			memcpy(buf + off, &act->ac_copy.payload, act->ac_copy.size);
+			off += act->ac_copy.size;
+			break;
+		case UMEM_ACT_COPY_PTR:
+			D_ASSERT(off + act->ac_copy.size <= buf_len);
+			memcpy(buf + off, (void *)act->ac_copy_ptr.ptr, act->ac_copy.size);
+			off += act->ac_copy.size;
+			break;
+		case UMEM_ACT_MOVE:
+			D_ASSERT(off + sizeof(uint64_t) <= buf_len);
+			memcpy(buf + off, &act->ac_move.src, sizeof(uint64_t));
+			off += sizeof(uint64_t);
+			break;
+		default:
+			break;
+		}
+	}
+	D_ASSERT(off == buf_len);
+}
+
+/* Grow the per-context compression scratch buffer to at least @size bytes */
+static char *
+wal_zip_scratch(struct bio_meta_context *mc, unsigned int size)
+{
+	char	*buf;
+
+	if (mc->mc_zip_buf_sz >= size)
+		return mc->mc_zip_buf;
+
+	D_ALLOC(buf, size);
+	if (buf == NULL)
+		return NULL;
+
+	D_FREE(mc->mc_zip_buf);
+	mc->mc_zip_buf = buf;
+	mc->mc_zip_buf_sz = size;
+	return buf;
+}
+
+/*
+ * Release the scratch buffer grown by an oversized transaction, only the size needed by
+ * a full batch (WAL_BATCH_MAX_BLKS blocks) is retained across transactions.
+ */
+static void
+wal_zip_scratch_put(struct bio_meta_context *mc)
+{
+	unsigned int	max_sz = WAL_BATCH_MAX_BLKS * mc->mc_wal_info.si_header.wh_blk_bytes;
+
+	if (mc->mc_zip_buf_sz <= max_sz)
+		return;
+
+	D_FREE(mc->mc_zip_buf);
+	mc->mc_zip_buf_sz = 0;
+}
+
+/*
+ * Compress the payload when it saves WAL blocks, @bd is updated to the compressed layout
+ * on success. Any failure simply leaves the payload uncompressed.
+ *
+ * The payload is gathered and compressed in the scratch buffer of @mc, which is safe since
+ * nothing yields in between. The compressed payload is only copied out to @zip when it's
+ * worthwhile, because it has to stay around until the WAL blocks are filled.
+ */
+static void
+wal_tx_compress(struct bio_meta_context *mc, struct umem_wal_tx *tx, unsigned int act_nr,
+		struct wal_blks_desc *bd, struct wal_tx_zip *zip)
+{
+	struct wal_super_info	*si = &mc->mc_wal_info;
+	unsigned int		 blk_bytes = si->si_header.wh_blk_bytes;
+	unsigned int		 payload_sz = umem_tx_act_payload_sz(tx);
+	unsigned int		 zip_max, zip_len;
+	struct wal_blks_desc	 zip_bd;
+	uint32_t		 raw_len = payload_sz;
+	size_t			 produced = 0;
+	char			*raw, *out;
+	int			 rc;
+
+	if (!bio_wal_compress || mc->mc_compressor == NULL || payload_sz < WAL_ZIP_MIN_PAYLOAD)
+		return;
+
+	/* Header wasn't marked at open, don't write anything older engines can't replay */
+	if (!(si->si_header.wh_compat & WAL_COMPAT_ZIP))
+		return;
+
+	/* Compressed payload has to save at least one block to be worthwhile */
+	zip_max = payload_sz - blk_bytes;
+	raw = wal_zip_scratch(mc, payload_sz + sizeof(raw_len) + zip_max);
+	if (raw == NULL)
+		return;
+	out = raw + payload_sz;
+
+	gather_payload(tx, raw, payload_sz);
+	rc = daos_compressor_compress(mc->mc_compressor, (uint8_t *)raw, payload_sz,
+				      (uint8_t *)out + sizeof(raw_len), zip_max, &produced);
+	if (rc != DC_STATUS_OK)
+		goto out;
+
+	zip_len = sizeof(raw_len) + produced;
+	calc_trans_blks(act_nr, zip_len, blk_bytes, &zip_bd);
+	if (zip_bd.bd_blks >= bd->bd_blks)
+		goto out;
+
+	D_ALLOC(zip->tz_buf, zip_len);
+	if (zip->tz_buf == NULL)
+		goto out;
+
+	memcpy(out, &raw_len, sizeof(raw_len));
+	memcpy(zip->tz_buf, out, zip_len);
+	zip->tz_len = zip_len;
+
+	D_DEBUG(DB_IO, "WAL tx ID:"DF_U64" payload compressed %u -> %u, blks %u -> %u\n",
+		tx->utx_id, payload_sz, zip->tz_len, bd->bd_blks, zip_bd.bd_blks);
+	*bd = zip_bd;
+out:
+	wal_zip_scratch_put(mc);
+}
+
 static void
 fill_trans_blks(struct bio_meta_context *mc, struct bio_sglist *bsgl, struct umem_wal_tx *tx,
-		struct data_csum_array *dc_arr, unsigned int blk_sz, struct wal_blks_desc *bd)
+		struct data_csum_array *dc_arr, struct wal_tx_zip *zip, unsigned int blk_sz,
+		struct wal_blks_desc *bd)
 {
 	struct wal_super_info	*si = &mc->mc_wal_info;
 	struct umem_action	*act;
@@ -533,6 +681,7 @@ fill_trans_blks(struct bio_meta_context *mc, struct bio_sglist *bsgl, struct ume
 	struct wal_trans_blk	 entry_blk, payload_blk;
 	unsigned int		 left, entry_sz = sizeof(struct wal_trans_entry), dc_idx = 0;
 	uint64_t		 src_addr;
+	bool			 zipped = (zip != NULL && zip->tz_buf != NULL);
 
 	/* Simulate a server crash before the in-flight WAL tx committed */
 	if (DAOS_FAIL_CHECK(DAOS_NVME_WAL_TX_LOST)) {
@@ -540,11 +689,11 @@ fill_trans_blks(struct bio_meta_context *mc, struct bio_sglist *bsgl, struct ume
 		return;
 	}
 
-	blk_hdr.th_magic = WAL_HDR_MAGIC;
+	blk_hdr.th_magic = zipped ? WAL_TX_MAGIC_ZIP : WAL_HDR_MAGIC;
 	blk_hdr.th_gen = si->si_header.wh_gen;
 	blk_hdr.th_id = tx->utx_id;
 	blk_hdr.th_tot_ents = umem_tx_act_nr(tx) + dc_arr->dca_nr;
-	blk_hdr.th_tot_payload = umem_tx_act_payload_sz(tx);
+	blk_hdr.th_tot_payload = zipped ? zip->tz_len : umem_tx_act_payload_sz(tx);
 
 	/* Initialize first entry block */
 	get_trans_blk(bsgl, 0, blk_sz, &entry_blk);
@@ -597,7 +746,8 @@ fill_trans_blks(struct bio_meta_context *mc, struct bio_sglist *bsgl, struct ume
 			else
 				src_addr = act->ac_copy_ptr.ptr;
 			place_entry(&entry_blk, &entry);
-			place_payload(bsgl, bd, &payload_blk, src_addr, entry.te_len);
+			if (!zipped)
+				place_payload(bsgl, bd, &payload_blk, src_addr, entry.te_len);
 			break;
 		case UMEM_ACT_ASSIGN:
 			entry.te_off = act->ac_assign.addr;
@@ -610,8 +760,9 @@ fill_trans_blks(struct bio_meta_context *mc, struct bio_sglist *bsgl, struct ume
 			entry.te_len = act->ac_move.size;
 			entry.te_data = 0;
 			place_entry(&entry_blk, &entry);
-			place_payload(bsgl, bd, &payload_blk, (uint64_t)&act->ac_move.src,
-				      sizeof(uint64_t));
+			if (!zipped)
+				place_payload(bsgl, bd, &payload_blk, (uint64_t)&act->ac_move.src,
+					      sizeof(uint64_t));
 			break;
 		case UMEM_ACT_SET:
 			entry.te_off = act->ac_set.addr;
@@ -651,6 +802,9 @@ fill_trans_blks(struct bio_meta_context *mc, struct bio_sglist *bsgl, struct ume
 		}
 	}
 
+	if (zipped)
+		place_payload(bsgl, bd, &payload_blk, (uint64_t)zip->tz_buf, zip->tz_len);
+
 	place_tail(mc, bsgl, bd, &payload_blk);
 }
 
@@ -669,6 +823,14 @@ struct wal_tx_desc {
 	uint32_t		 td_blks;		/* Blocks used by this tx */
 	int			 td_error;
 	unsigned int		 td_wal_complete:1;	/* Indicating WAL I/O completed */
+	/* Below fields are for group commit only */
+	d_list_t		 td_batch_link;		/* Link to wal_batch::wb_members */
+	ABT_eventual		 td_done;		/* Signaled on tx completion */
+	struct umem_wal_tx	*td_tx;
+	struct data_csum_array	*td_dc_arr;
+	struct wal_tx_zip	*td_zip;
+	struct wal_blks_desc	*td_blk_desc;
+	uint32_t		 td_batch_txs;		/* Transactions in the same WAL write */
 };
 
 static inline struct wal_tx_desc *
@@ -721,11 +883,12 @@ wal_tx_completion(struct wal_tx_desc *wal_tx, bool complete_next)
 	bool			 try_wakeup = false;
 
 	D_ASSERT(!d_list_empty(&wal_tx->td_link));
-	D_ASSERT(biod_tx != NULL);
+	D_ASSERT(biod_tx != NULL || wal_tx->td_done != ABT_EVENTUAL_NULL);
 	D_ASSERT(si != NULL);
 
 	next = wal_tx_next(wal_tx);
-	biod_tx->bd_result = wal_tx->td_error;
+	if (biod_tx != NULL)
+		biod_tx->bd_result = wal_tx->td_error;
 
 	if (wal_tx->td_error) {
 		if (next != NULL) {
@@ -750,8 +913,10 @@ wal_tx_completion(struct wal_tx_desc *wal_tx, bool complete_next)
 	D_ASSERT(si->si_pending_tx > 0);
 	si->si_pending_tx--;
 
+	if (wal_tx->td_done != ABT_EVENTUAL_NULL)
+		ABT_eventual_set(wal_tx->td_done, NULL, 0);
 	/* The ABT_eventual could be NULL if WAL I/O IOD failed on DMA mapping in bio_iod_prep() */
-	if (biod_tx->bd_dma_done != ABT_EVENTUAL_NULL)
+	else if (biod_tx->bd_dma_done != ABT_EVENTUAL_NULL)
 		ABT_eventual_set(biod_tx->bd_dma_done, NULL, 0);
 
 	/*
@@ -1003,6 +1168,305 @@ dump_tx_entries(struct umem_wal_tx *tx, struct data_csum_array *dc_arr)
 			payload_sz[i]);
 }
 
+/*
+ * WAL group commit batch. Transactions committed back to back are coalesced into one
+ * contiguous WAL write, each transaction still has its own header, entries and tail in
+ * the WAL, so the on-disk format and replay are not changed.
+ *
+ * The first transaction of a batch is the leader, it waits for a short window to collect
+ * followers, then submits the batch; the followers just wait for their own completion.
+ * Transactions are still completed in ID order by wal_completion().
+ */
+struct wal_batch {
+	d_list_t		 wb_members;	/* Member transactions, in ID order */
+	struct wal_super_info	*wb_si;
+	uint64_t		 wb_start_id;	/* ID of the first member */
+	uint64_t		 wb_next_id;	/* ID following the last member */
+	uint64_t		 wb_submit_ts;	/* Submit timestamp in usecs */
+	unsigned int		 wb_txs;	/* Number of members */
+	unsigned int		 wb_blks;	/* Total blocks used by members */
+	unsigned int		 wb_full:1;	/* No more member can join */
+};
+
+static inline bool
+wal_batch_enabled(struct bio_meta_context *mc, unsigned int blks)
+{
+	struct bio_xs_context	*xs_ctxt = mc->mc_wal->bic_xs_ctxt;
+
+	/* Self polling mode can only poll for the completion of its own IOD */
+	if (!bio_wal_group_commit || xs_ctxt == NULL || xs_ctxt->bxc_self_polling)
+		return false;
+
+	return blks <= WAL_BATCH_MAX_BLKS;
+}
+
+/* Don't allow more transactions to join the open batch */
+static inline void
+wal_batch_close(struct wal_super_info *si)
+{
+	if (si->si_batch != NULL) {
+		si->si_batch->wb_full = 1;
+		si->si_batch = NULL;
+	}
+}
+
+static inline bool
+wal_batch_joinable(struct wal_batch *batch, struct wal_tx_desc *wal_tx)
+{
+	return batch != NULL && !batch->wb_full && batch->wb_next_id == wal_tx->td_id &&
+	       (batch->wb_blks + wal_tx->td_blks) <= WAL_BATCH_MAX_BLKS;
+}
+
+/*
+ * The leader waits for followers only when there are other transactions in flight, the
+ * window is half of the observed batch WAL write latency (capped by DAOS_WAL_BATCH_WINDOW),
+ * so that an idle device never delays a commit.
+ */
+static void
+wal_batch_wait(struct wal_super_info *si, struct wal_batch *batch)
+{
+	uint64_t	window, start;
+
+	if (si->si_pending_tx <= 1)
+		return;
+
+	window = min(si->si_batch_lat / 2, (uint64_t)bio_wal_batch_window);
+	start = daos_getutime();
+	while (!batch->wb_full && (daos_getutime() - start) < window)
+		bio_yield(NULL);
+}
+
+/* Batch WAL I/O completion */
+static void
+wal_batch_completion(void *arg, int err)
+{
+	struct wal_batch	*batch = arg;
+	struct wal_super_info	*si = batch->wb_si;
+	struct wal_tx_desc	*wal_tx, *tmp;
+	uint64_t		 lat;
+
+	lat = daos_getutime() - batch->wb_submit_ts;
+	si->si_batch_lat = (si->si_batch_lat == 0) ? lat : (si->si_batch_lat * 7 + lat) / 8;
+
+	d_list_for_each_entry_safe(wal_tx, tmp, &batch->wb_members, td_batch_link) {
+		d_list_del_init(&wal_tx->td_batch_link);
+		wal_completion(wal_tx, err);
+	}
+}
+
+/* Locate the blocks of a batch member in the DMA buffer of the batch */
+static void
+wal_batch_member_sgl(struct bio_sglist *batch_sgl, unsigned int blk_off, unsigned int blks,
+		     unsigned int blk_bytes, struct bio_sglist *bsgl, struct bio_iov *iovs)
+{
+	struct bio_iov	*biov = &batch_sgl->bs_iovs[0];
+	unsigned int	 iov_blks = bio_iov2len(biov) / blk_bytes;
+	unsigned int	 nr = 0, cur;
+
+	while (blks > 0) {
+		if (blk_off >= iov_blks) {
+			D_ASSERT(biov == &batch_sgl->bs_iovs[0] && batch_sgl->bs_nr_out == 2);
+			blk_off -= iov_blks;
+			biov = &batch_sgl->bs_iovs[1];
+			iov_blks = bio_iov2len(biov) / blk_bytes;
+			continue;
+		}
+
+		D_ASSERT(nr < 2);
+		cur = min(blks, iov_blks - blk_off);
+		iovs[nr] = *biov;
+		iovs[nr].bi_buf = biov->bi_buf + (uint64_t)blk_off * blk_bytes;
+		iovs[nr].bi_data_len = (uint64_t)cur * blk_bytes;
+		iovs[nr].bi_addr.ba_off += (uint64_t)blk_off * blk_bytes;
+		nr++;
+
+		blk_off += cur;
+		blks -= cur;
+	}
+
+	bsgl->bs_iovs = iovs;
+	bsgl->bs_nr = nr;
+	bsgl->bs_nr_out = nr;
+}
+
+/* Submit the batch in one WAL write, return the IOD to be freed by leader */
+static struct bio_desc *
+wal_batch_submit(struct bio_meta_context *mc, struct wal_batch *batch)
+{
+	struct wal_super_info	*si = &mc->mc_wal_info;
+	struct wal_tx_desc	*wal_tx, *tmp;
+	struct bio_desc		*biod;
+	struct bio_sglist	*bsgl, tx_sgl;
+	struct bio_iov		 tx_iovs[2];
+	bio_addr_t		 addr = { 0 };
+	unsigned int		 tot_blks = si->si_header.wh_tot_blks;
+	unsigned int		 blk_bytes = si->si_header.wh_blk_bytes;
+	unsigned int		 start_off, blks, blk_off = 0;
+	int			 iov_nr, rc;
+
+	D_ASSERT(batch->wb_full || si->si_batch != batch);
+	d_list_for_each_entry(wal_tx, &batch->wb_members, td_batch_link)
+		wal_tx->td_batch_txs = batch->wb_txs;
+
+	biod = bio_iod_alloc(mc->mc_wal, NULL, 1, BIO_IOD_TYPE_UPDATE);
+	if (biod == NULL) {
+		rc = -DER_NOMEM;
+		goto failed;
+	}
+
+	start_off = id2off(batch->wb_start_id);
+	D_ASSERT(start_off < tot_blks);
+	if ((start_off + batch->wb_blks) <= tot_blks) {
+		iov_nr = 1;
+		blks = batch->wb_blks;
+	} else {
+		iov_nr = 2;
+		blks = (tot_blks - start_off);
+	}
+
+	bsgl = bio_iod_sgl(biod, 0);
+	rc = bio_sgl_init(bsgl, iov_nr);
+	if (rc)
+		goto failed;
+
+	bio_addr_set(&addr, DAOS_MEDIA_NVME, off2lba(si, start_off));
+	bio_iov_set(&bsgl->bs_iovs[0], addr, (uint64_t)blks * blk_bytes);
+	if (iov_nr == 2) {
+		bio_addr_set(&addr, DAOS_MEDIA_NVME, off2lba(si, 0));
+		blks = batch->wb_blks - blks;
+		bio_iov_set(&bsgl->bs_iovs[1], addr, (uint64_t)blks * blk_bytes);
+	}
+	bsgl->bs_nr_out = iov_nr;
+
+	rc = bio_iod_prep(biod, BIO_CHK_TYPE_LOCAL, NULL, 0);
+	if (rc) {
+		D_ERROR("WAL batch IOD prepare failed. "DF_RC"\n", DP_RC(rc));
+		goto failed;
+	}
+
+	/* Fill DMA buffer with the entries of each member transaction */
+	d_list_for_each_entry(wal_tx, &batch->wb_members, td_batch_link) {
+		wal_batch_member_sgl(bsgl, blk_off, wal_tx->td_blks, blk_bytes, &tx_sgl,
+				     &tx_iovs[0]);
+		fill_trans_blks(mc, &tx_sgl, wal_tx->td_tx, wal_tx->td_dc_arr, wal_tx->td_zip,
+				blk_bytes, wal_tx->td_blk_desc);
+		blk_off += wal_tx->td_blks;
+	}
+	D_ASSERT(blk_off == batch->wb_blks);
+
+	D_DEBUG(DB_IO, "WAL batch ID:"DF_U64" txs:%u blks:%u\n", batch->wb_start_id,
+		batch->wb_txs, batch->wb_blks);
+
+	biod->bd_completion = wal_batch_completion;
+	biod->bd_comp_arg = batch;
+	batch->wb_submit_ts = daos_getutime();
+
+	rc = bio_iod_post_async(biod, 0);
+	if (rc)
+		D_ERROR("WAL batch commit failed. "DF_RC"\n", DP_RC(rc));
+
+	return biod;
+failed:
+	d_list_for_each_entry_safe(wal_tx, tmp, &batch->wb_members, td_batch_link) {
+		d_list_del_init(&wal_tx->td_batch_link);
+		wal_completion(wal_tx, rc);
+	}
+	return biod;
+}
+
+static int
+wal_batch_commit(struct bio_meta_context *mc, struct umem_wal_tx *tx, struct bio_desc *biod_data,
+		 struct data_csum_array *dc_arr, struct wal_tx_zip *zip,
+		 struct wal_blks_desc *blk_desc, struct bio_wal_stats *stats)
+{
+	struct wal_super_info	*si = &mc->mc_wal_info;
+	struct wal_batch	*batch = si->si_batch;
+	struct wal_batch	 own_batch;
+	struct wal_tx_desc	 wal_tx = { 0 };
+	struct bio_desc		*biod = NULL;
+	int			 rc;
+
+	rc = ABT_eventual_create(0, &wal_tx.td_done);
+	if (rc != ABT_SUCCESS)
+		return -DER_NOMEM;
+
+	D_ASSERT(wal_id_cmp(si, tx->utx_id, si->si_unused_id) == 0);
+	wal_tx.td_id = si->si_unused_id;
+	wal_tx.td_si = si;
+	wal_tx.td_blks = blk_desc->bd_blks;
+	wal_tx.td_tx = tx;
+	wal_tx.td_dc_arr = dc_arr;
+	wal_tx.td_zip = zip;
+	wal_tx.td_blk_desc = blk_desc;
+	d_list_add_tail(&wal_tx.td_link, &si->si_pending_list);
+	si->si_pending_tx++;
+
+	if (stats) {
+		stats->ws_size = (blk_desc->bd_blks - 1) * si->si_header.wh_blk_bytes +
+				 blk_desc->bd_tail_off;
+		stats->ws_qd = si->si_pending_tx;
+	}
+
+	/* Update next unused ID */
+	si->si_unused_id = wal_next_id(si, si->si_unused_id, blk_desc->bd_blks);
+
+	if (biod_data != NULL) {
+		if (biod_data->bd_inflights == 0) {
+			wal_tx.td_error = biod_data->bd_result;
+		} else {
+			biod_data->bd_completion = data_completion;
+			biod_data->bd_comp_arg = &wal_tx;
+			wal_tx.td_biod_data = biod_data;
+		}
+	}
+
+	if (wal_batch_joinable(batch, &wal_tx)) {
+		/* Join the open batch, it will be submitted by the leader */
+		d_list_add_tail(&wal_tx.td_batch_link, &batch->wb_members);
+		batch->wb_txs++;
+		batch->wb_blks += wal_tx.td_blks;
+		batch->wb_next_id = si->si_unused_id;
+		if (batch->wb_txs == WAL_BATCH_MAX_TXS)
+			wal_batch_close(si);
+	} else {
+		/* Open a new batch and lead it */
+		wal_batch_close(si);
+		batch = &own_batch;
+		D_INIT_LIST_HEAD(&batch->wb_members);
+		batch->wb_si = si;
+		batch->wb_start_id = wal_tx.td_id;
+		batch->wb_next_id = si->si_unused_id;
+		batch->wb_txs = 1;
+		batch->wb_blks = wal_tx.td_blks;
+		batch->wb_full = 0;
+		d_list_add_tail(&wal_tx.td_batch_link, &batch->wb_members);
+		si->si_batch = batch;
+
+		wal_batch_wait(si, batch);
+		if (si->si_batch == batch)
+			wal_batch_close(si);
+		biod = wal_batch_submit(mc, batch);
+	}
+
+	/* Wait for WAL commit completion */
+	rc = ABT_eventual_wait(wal_tx.td_done, NULL);
+	if (rc != ABT_SUCCESS)
+		D_ERROR("ABT_eventual_wait failed. %d\n", rc);
+	/* The completion must have been called */
+	D_ASSERT(d_list_empty(&wal_tx.td_link));
+	D_ASSERT(d_list_empty(&wal_tx.td_batch_link));
+
+	if (stats)
+		stats->ws_batch_txs = wal_tx.td_batch_txs;
+
+	ABT_eventual_free(&wal_tx.td_done);
+	/* The leader tx is completed after the batch WAL I/O completion */
+	if (biod != NULL)
+		bio_iod_free(biod);
+
+	return wal_tx.td_error;
+}
+
 int
 bio_wal_commit(struct bio_meta_context *mc, struct umem_wal_tx *tx, struct bio_desc *biod_data,
 	       struct bio_wal_stats *stats)
@@ -1014,6 +1478,7 @@ bio_wal_commit(struct bio_meta_context *mc, struct umem_wal_tx *tx, struct bio_d
 	struct wal_tx_desc	 wal_tx = { 0 };
 	struct wal_blks_desc	 blk_desc = { 0 };
 	struct data_csum_array	 dc_arr;
+	struct wal_tx_zip	 zip = { 0 };
 	unsigned int		 blks, unused_off;
 	unsigned int		 tot_blks = si->si_header.wh_tot_blks;
 	unsigned int		 blk_bytes = si->si_header.wh_blk_bytes;
@@ -1039,6 +1504,7 @@ bio_wal_commit(struct bio_meta_context *mc, struct umem_wal_tx *tx, struct bio_d
 	/* Calculate the required log blocks for this transaction */
 	calc_trans_blks(umem_tx_act_nr(tx) + dc_arr.dca_nr, umem_tx_act_payload_sz(tx),
 			blk_bytes, &blk_desc);
+	wal_tx_compress(mc, tx, umem_tx_act_nr(tx) + dc_arr.dca_nr, &blk_desc, &zip);
 
 	D_ASSERT(blk_desc.bd_blks > 0);
 	if (blk_desc.bd_blks > WAL_MAX_TRANS_BLKS) {
@@ -1053,6 +1519,13 @@ bio_wal_commit(struct bio_meta_context *mc, struct umem_wal_tx *tx, struct bio_d
 		}
 	}
 
+	if (wal_batch_enabled(mc, blk_desc.bd_blks)) {
+		rc = wal_batch_commit(mc, tx, biod_data, &dc_arr, &zip, &blk_desc, stats);
+		goto out;
+	}
+	/* Don't let the following transactions join the open batch across this one */
+	wal_batch_close(si);
+
 	biod = bio_iod_alloc(mc->mc_wal, NULL, 1, BIO_IOD_TYPE_UPDATE);
 	if (biod == NULL) {
 		rc = -DER_NOMEM;
@@ -1097,6 +1570,7 @@ bio_wal_commit(struct bio_meta_context *mc, struct umem_wal_tx *tx, struct bio_d
 	if (stats) {
 		stats->ws_size = (blk_desc.bd_blks - 1) * blk_bytes + blk_desc.bd_tail_off;
 		stats->ws_qd = si->si_pending_tx;
+		stats->ws_batch_txs = 1;
 	}
 
 	/* Update next unused ID */
@@ -1115,7 +1589,7 @@ bio_wal_commit(struct bio_meta_context *mc, struct umem_wal_tx *tx, struct bio_d
 	}
 
 	/* Fill DMA buffer with transaction entries */
-	fill_trans_blks(mc, bsgl, tx, &dc_arr, blk_bytes, &blk_desc);
+	fill_trans_blks(mc, bsgl, tx, &dc_arr, &zip, blk_bytes, &blk_desc);
 
 	/* Set proper completion callbacks for data I/O & WAL I/O */
 	if (biod_data != NULL) {
@@ -1138,6 +1612,7 @@ bio_wal_commit(struct bio_meta_context *mc, struct umem_wal_tx *tx, struct bio_d
 	wait_tx_committed(&wal_tx);
 out:
 	free_data_csum(&dc_arr);
+	wal_tx_zip_free(&zip);
 	if (biod != NULL)
 		bio_iod_free(biod);
 	return rc;
@@ -1167,7 +1642,8 @@ load_wal_header(struct bio_meta_context *mc)
 		return -DER_UNINIT;
 	}
 
-	if (hdr->wh_version != BIO_WAL_VERSION && hdr->wh_version != 1) {
+	if (hdr->wh_version != BIO_WAL_VERSION_ZIP && hdr->wh_version != BIO_WAL_VERSION &&
+	    hdr->wh_version != 1) {
 		D_ERROR("Invalid WAL version. %u\n", hdr->wh_version);
 		return -DER_DF_INCOMPT;
 	}
@@ -1186,6 +1662,11 @@ load_wal_header(struct bio_meta_context *mc)
 		return -DER_CSUM;
 	}
 
+	if (hdr->wh_version != 1 && (hdr->wh_compat & ~WAL_COMPAT_KNOWN)) {
+		D_ERROR("Unknown WAL compatibility bits. %x\n", hdr->wh_compat);
+		return -DER_DF_INCOMPT;
+	}
+
 	return 0;
 }
 
@@ -1235,36 +1716,28 @@ bio_wal_flush_header(struct bio_meta_context *mc)
 	return write_header(mc, mc->mc_wal, hdr, sizeof(*hdr), &hdr->wh_csum);
 }
 
+/* Setup the SGL for reading 'max_blks' WAL blocks starting from block offset 'off' */
 static int
-load_wal(struct bio_meta_context *mc, char *buf, unsigned int max_blks, uint64_t tx_id)
+wal_region_sgl(struct wal_super_info *si, struct bio_sglist *bsgl, unsigned int off,
+	       unsigned int max_blks)
 {
-	struct wal_super_info	*si = &mc->mc_wal_info;
 	unsigned int		 tot_blks = si->si_header.wh_tot_blks;
 	unsigned int		 blk_bytes = si->si_header.wh_blk_bytes;
-	struct bio_sglist	 bsgl;
 	struct bio_iov		*biov;
-	d_sg_list_t		 sgl;
-	d_iov_t			 iov;
-	unsigned int		 nr_blks, blks, off;
+	unsigned int		 nr_blks, blks;
 	bio_addr_t		 addr = { 0 };
 	int			 iov_nr, rc;
 
-	d_iov_set(&iov, buf, max_blks * blk_bytes);
-	sgl.sg_iovs = &iov;
-	sgl.sg_nr = 1;
-	sgl.sg_nr_out = 0;
-
 	/* Read in 1MB sized IOVs */
 	nr_blks = (1UL << 20) / blk_bytes;
 	D_ASSERT(nr_blks > 0);
 	iov_nr = (max_blks + nr_blks - 1) / nr_blks + 1;
-	rc = bio_sgl_init(&bsgl, iov_nr);
+	rc = bio_sgl_init(bsgl, iov_nr);
 	if (rc)
 		return rc;
 
-	off = id2off(tx_id);
 	while (max_blks > 0) {
-		biov = &bsgl.bs_iovs[bsgl.bs_nr_out];
+		biov = &bsgl->bs_iovs[bsgl->bs_nr_out];
 
 		bio_addr_set(&addr, DAOS_MEDIA_NVME, off2lba(si, off));
 		blks = min(max_blks, nr_blks);
@@ -1272,15 +1745,37 @@ load_wal(struct bio_meta_context *mc, char *buf, unsigned int max_blks, uint64_t
 			blks = tot_blks - off;
 		bio_iov_set(biov, addr, (uint64_t)blks * blk_bytes);
 
-		bsgl.bs_nr_out++;
+		bsgl->bs_nr_out++;
 		max_blks -= blks;
 		off += blks;
 		if (off == tot_blks)
 			off = 0;
-		D_ASSERT(bsgl.bs_nr_out <= iov_nr);
+		D_ASSERT(bsgl->bs_nr_out <= iov_nr);
 	}
 	/* Adjust the bs_nr for following bio_readv() */
-	bsgl.bs_nr = bsgl.bs_nr_out;
+	bsgl->bs_nr = bsgl->bs_nr_out;
+
+	return 0;
+}
+
+static int
+load_wal(struct bio_meta_context *mc, char *buf, unsigned int max_blks, uint64_t tx_id)
+{
+	struct wal_super_info	*si = &mc->mc_wal_info;
+	unsigned int		 blk_bytes = si->si_header.wh_blk_bytes;
+	struct bio_sglist	 bsgl = { 0 };
+	d_sg_list_t		 sgl;
+	d_iov_t			 iov;
+	int			 rc;
+
+	d_iov_set(&iov, buf, max_blks * blk_bytes);
+	sgl.sg_iovs = &iov;
+	sgl.sg_nr = 1;
+	sgl.sg_nr_out = 0;
+
+	rc = wal_region_sgl(si, &bsgl, id2off(tx_id), max_blks);
+	if (rc)
+		return rc;
 
 	rc = bio_readv(mc->mc_wal, &bsgl, &sgl);
 	bio_sgl_fini(&bsgl);
@@ -1288,6 +1783,145 @@ load_wal(struct bio_meta_context *mc, char *buf, unsigned int max_blks, uint64_t
 	return rc;
 }
 
+/*
+ * WAL replay buffer. The WAL is loaded by asynchronous prefetch of fixed sized regions,
+ * the prefetch of next region is issued as soon as current region is loaded, so that the
+ * WAL reads are overlapped with the verification and replay of loaded transactions.
+ */
+struct wal_replay_buf {
+	struct bio_meta_context	*rb_mc;
+	struct bio_desc		*rb_pf_biod;	/* In-flight prefetch */
+	char			*rb_buf;
+	unsigned int		 rb_buf_blks;	/* Buffer capacity in blocks */
+	unsigned int		 rb_valid_blks;	/* Loaded blocks in buffer */
+	unsigned int		 rb_pf_off;	/* Start block offset of in-flight prefetch */
+	unsigned int		 rb_pf_blks;	/* Blocks per prefetch */
+};
+
+static int
+replay_prefetch_start(struct wal_replay_buf *rb)
+{
+	struct bio_meta_context	*mc = rb->rb_mc;
+	struct bio_desc		*biod;
+	int			 rc;
+
+	D_ASSERT(rb->rb_pf_biod == NULL);
+	biod = bio_iod_alloc(mc->mc_wal, NULL, 1, BIO_IOD_TYPE_FETCH);
+	if (biod == NULL)
+		return -DER_NOMEM;
+
+	rc = wal_region_sgl(&mc->mc_wal_info, bio_iod_sgl(biod, 0), rb->rb_pf_off,
+			    rb->rb_pf_blks);
+	if (rc)
+		goto out;
+
+	rc = bio_iod_prefetch(biod);
+	if (rc) {
+		DL_ERROR(rc, "Failed to prefetch WAL, off:%u blks:%u", rb->rb_pf_off,
+			 rb->rb_pf_blks);
+		goto out;
+	}
+	rb->rb_pf_biod = biod;
+out:
+	if (rc)
+		bio_iod_free(biod);
+	return rc;
+}
+
+/* Wait for in-flight prefetch, copy the loaded blocks to 'buf' if it's not NULL */
+static int
+replay_prefetch_end(struct wal_replay_buf *rb, char *buf)
+{
+	struct bio_desc	*biod = rb->rb_pf_biod;
+	unsigned int	 blk_bytes = rb->rb_mc->mc_wal_info.si_header.wh_blk_bytes;
+	d_sg_list_t	 sgl;
+	d_iov_t		 iov;
+	int		 rc;
+
+	D_ASSERT(biod != NULL);
+	rb->rb_pf_biod = NULL;
+
+	rc = bio_iod_prefetch_wait(biod);
+	if (rc == 0 && buf != NULL) {
+		d_iov_set(&iov, buf, rb->rb_pf_blks * blk_bytes);
+		sgl.sg_iovs = &iov;
+		sgl.sg_nr = 1;
+		sgl.sg_nr_out = 0;
+
+		rc = bio_iod_copy(biod, &sgl, 1);
+	}
+	bio_iod_post(biod, rc);
+	bio_iod_free(biod);
+
+	return rc;
+}
+
+static int
+replay_buf_init(struct bio_meta_context *mc, struct wal_replay_buf *rb, unsigned int max_blks,
+		uint64_t tx_id)
+{
+	struct wal_super_info	*si = &mc->mc_wal_info;
+	unsigned int		 blk_bytes = si->si_header.wh_blk_bytes;
+	int			 rc;
+
+	memset(rb, 0, sizeof(*rb));
+	rb->rb_mc = mc;
+	rb->rb_pf_blks = min(WAL_REPLAY_PREFETCH_SZ / blk_bytes, si->si_header.wh_tot_blks);
+	D_ASSERT(rb->rb_pf_blks > 0);
+	/* Leave room for a partially loaded transaction */
+	rb->rb_buf_blks = max_blks + rb->rb_pf_blks;
+
+	D_ALLOC(rb->rb_buf, (size_t)rb->rb_buf_blks * blk_bytes);
+	if (rb->rb_buf == NULL)
+		return -DER_NOMEM;
+
+	rb->rb_pf_off = id2off(tx_id);
+	rc = replay_prefetch_start(rb);
+	if (rc)
+		D_FREE(rb->rb_buf);
+	return rc;
+}
+
+static void
+replay_buf_fini(struct wal_replay_buf *rb)
+{
+	/* Drain the in-flight prefetch */
+	if (rb->rb_pf_biod != NULL)
+		replay_prefetch_end(rb, NULL);
+	D_FREE(rb->rb_buf);
+}
+
+/*
+ * Move the partially replayed blocks (start from 'blk_off') to buffer head, append the
+ * prefetched region and issue the prefetch for next region.
+ */
+static int
+replay_buf_load(struct wal_replay_buf *rb, unsigned int *blk_off)
+{
+	struct wal_super_info	*si = &rb->rb_mc->mc_wal_info;
+	unsigned int		 blk_bytes = si->si_header.wh_blk_bytes;
+	int			 rc;
+
+	D_ASSERT(*blk_off <= rb->rb_valid_blks);
+	if (*blk_off > 0) {
+		rb->rb_valid_blks -= *blk_off;
+		memmove(rb->rb_buf, rb->rb_buf + (size_t)*blk_off * blk_bytes,
+			(size_t)rb->rb_valid_blks * blk_bytes);
+		*blk_off = 0;
+	}
+
+	D_ASSERT(rb->rb_valid_blks + rb->rb_pf_blks <= rb->rb_buf_blks);
+	rc = replay_prefetch_end(rb, rb->rb_buf + (size_t)rb->rb_valid_blks * blk_bytes);
+	if (rc) {
+		DL_ERROR(rc, "Failed to load WAL");
+		return rc;
+	}
+	rb->rb_valid_blks += rb->rb_pf_blks;
+
+	rb->rb_pf_off = (rb->rb_pf_off + rb->rb_pf_blks) % si->si_header.wh_tot_blks;
+	return replay_prefetch_start(rb);
+}
+
 /* Check if a tx_id is known to be committed */
 static bool
 tx_known_committed(struct wal_super_info *si, uint64_t tx_id)
@@ -1316,7 +1950,8 @@ verify_tx_hdr(struct wal_super_info *si, struct wal_trans_head *hdr, uint64_t tx
 	bool	committed = tx_known_committed(si, tx_id);
 	int     rc        = 0;
 
-	if (hdr->th_magic != WAL_HDR_MAGIC) {
+	if (hdr->th_magic != WAL_HDR_MAGIC &&
+	    (hdr->th_magic != WAL_TX_MAGIC_ZIP || !(si->si_header.wh_compat & WAL_COMPAT_ZIP))) {
 		D_CDEBUG(committed, DLOG_ERR, DB_IO, "Mismatched WAL head magic, %x != %x\n",
 			 hdr->th_magic, WAL_HDR_MAGIC);
 		rc = committed ? -DER_INVAL : 1;
@@ -1620,14 +2255,95 @@ copy_payload(struct wal_blks_desc *bd, struct wal_trans_blk *tb, void *addr, uin
 	}
 }
 
+/* Payload source for replay, it's either the WAL blocks or the decompressed payload */
+struct wal_payload_src {
+	struct wal_blks_desc	*ps_bd;
+	struct wal_trans_blk	*ps_blk;
+	char			*ps_buf;	/* Decompressed payload, NULL if not compressed */
+	unsigned int		 ps_len;
+	unsigned int		 ps_off;
+};
+
 static int
-replay_tx(struct wal_super_info *si, char *buf,
+replay_payload(struct wal_payload_src *ps, void *addr, uint32_t len)
+{
+	if (ps->ps_buf == NULL) {
+		copy_payload(ps->ps_bd, ps->ps_blk, addr, len);
+		return 0;
+	}
+
+	if (ps->ps_off + len > ps->ps_len) {
+		D_ERROR("Decompressed payload is too short, %u + %u > %u\n", ps->ps_off, len,
+			ps->ps_len);
+		return -DER_INVAL;
+	}
+	memcpy(addr, ps->ps_buf + ps->ps_off, len);
+	ps->ps_off += len;
+	return 0;
+}
+
+/* Load the compressed payload from WAL blocks and decompress it */
+static int
+decompress_payload(struct bio_meta_context *mc, struct wal_trans_head *hdr,
+		   struct wal_payload_src *ps)
+{
+	unsigned int	 max_len = WAL_MAX_REPLAY_BLKS * mc->mc_wal_info.si_header.wh_blk_bytes;
+	uint32_t	 raw_len;
+	size_t		 produced = 0;
+	char		*zbuf;
+	int		 rc;
+
+	if (mc->mc_compressor == NULL) {
+		D_ERROR("No compressor for compressed WAL tx "DF_U64"\n", hdr->th_id);
+		return -DER_NOTSUPPORTED;
+	}
+
+	if (hdr->th_tot_payload <= sizeof(raw_len)) {
+		D_ERROR("Invalid compressed payload size %u\n", hdr->th_tot_payload);
+		return -DER_INVAL;
+	}
+
+	D_ALLOC(zbuf, hdr->th_tot_payload);
+	if (zbuf == NULL)
+		return -DER_NOMEM;
+
+	copy_payload(ps->ps_bd, ps->ps_blk, zbuf, hdr->th_tot_payload);
+	memcpy(&raw_len, zbuf, sizeof(raw_len));
+	if (raw_len == 0 || raw_len > max_len) {
+		D_ERROR("Invalid uncompressed payload size %u\n", raw_len);
+		D_GOTO(out, rc = -DER_INVAL);
+	}
+
+	D_ALLOC(ps->ps_buf, raw_len);
+	if (ps->ps_buf == NULL)
+		D_GOTO(out, rc = -DER_NOMEM);
+
+	rc = daos_compressor_decompress(mc->mc_compressor, (uint8_t *)zbuf + sizeof(raw_len),
+					hdr->th_tot_payload - sizeof(raw_len),
+					(uint8_t *)ps->ps_buf, raw_len, &produced);
+	if (rc != DC_STATUS_OK || produced != raw_len) {
+		D_ERROR("Failed to decompress WAL tx "DF_U64" payload, rc:%d, %zu/%u\n",
+			hdr->th_id, rc, produced, raw_len);
+		D_FREE(ps->ps_buf);
+		D_GOTO(out, rc = -DER_INVAL);
+	}
+	ps->ps_len = raw_len;
+	rc = 0;
+out:
+	D_FREE(zbuf);
+	return rc;
+}
+
+static int
+replay_tx(struct bio_meta_context *mc, char *buf,
 	  int (*replay_cb)(uint64_t tx_id, struct umem_action *act, void *arg),
 	  void *arg, struct wal_blks_desc *bd, struct umem_action *act)
 {
+	struct wal_super_info	*si = &mc->mc_wal_info;
 	struct wal_trans_head	*hdr = (struct wal_trans_head *)buf;
 	struct wal_trans_entry	*entry;
 	struct wal_trans_blk	 entry_blk, payload_blk;
+	struct wal_payload_src	 ps = { 0 };
 	unsigned int		 blk_sz = si->si_header.wh_blk_bytes;
 	int			 nr = 0, rc = 0;
 
@@ -1641,6 +2357,14 @@ replay_tx(struct wal_super_info *si, char *buf,
 	payload_blk.tb_off = bd->bd_payload_off;
 	payload_blk.tb_blk_sz = blk_sz;
 
+	ps.ps_bd = bd;
+	ps.ps_blk = &payload_blk;
+	if (hdr->th_magic == WAL_TX_MAGIC_ZIP) {
+		rc = decompress_payload(mc, hdr, &ps);
+		if (rc)
+			return rc;
+	}
+
 	while (1) {
 		entry = (struct wal_trans_entry *)(entry_blk.tb_buf + entry_blk.tb_off);
 
@@ -1652,7 +2376,7 @@ replay_tx(struct wal_super_info *si, char *buf,
 			act->ac_copy.addr = entry->te_off;
 			act->ac_copy.size = entry->te_len;
 			D_ASSERT(entry->te_len <= UMEM_ACT_PAYLOAD_MAX_LEN);
-			copy_payload(bd, &payload_blk, &act->ac_copy.payload, entry->te_len);
+			rc = replay_payload(&ps, &act->ac_copy.payload, entry->te_len);
 			break;
 		case UMEM_ACT_ASSIGN:
 			act->ac_assign.addr = entry->te_off;
@@ -1662,7 +2386,7 @@ replay_tx(struct wal_super_info *si, char *buf,
 		case UMEM_ACT_MOVE:
 			act->ac_move.dst = entry->te_off;
 			act->ac_move.size = entry->te_len;
-			copy_payload(bd, &payload_blk, &act->ac_move.src, sizeof(uint64_t));
+			rc = replay_payload(&ps, &act->ac_move.src, sizeof(uint64_t));
 			break;
 		case UMEM_ACT_SET:
 			act->ac_set.addr = entry->te_off;
@@ -1681,6 +2405,8 @@ replay_tx(struct wal_super_info *si, char *buf,
 			D_ASSERTF(0, "Invalid opc %u\n", act->ac_opc);
 			break;
 		}
+		if (rc)
+			break;
 
 		if (act->ac_opc != UMEM_ACT_CSUM) {
 			rc = replay_cb(hdr->th_id, act, arg);
@@ -1696,6 +2422,7 @@ replay_tx(struct wal_super_info *si, char *buf,
 		entry_move_next(&entry_blk, bd);
 	}
 
+	D_FREE(ps.ps_buf);
 	return rc;
 }
 
@@ -1762,6 +2489,19 @@ unmap_wal(struct bio_meta_context *mc, uint64_t unmap_start, uint64_t unmap_end,
 	return 0;
 }
 
+static inline void
+replay_tm_add(struct bio_wal_rp_stats *wrs, uint64_t *tm, uint64_t *s_us)
+{
+	uint64_t	now;
+
+	if (wrs == NULL)
+		return;
+
+	now = daos_getutime();
+	*tm += now - *s_us;
+	*s_us = now;
+}
+
 int
 bio_wal_replay(struct bio_meta_context *mc, struct bio_wal_rp_stats *wrs,
 	       int (*replay_cb)(uint64_t tx_id, struct umem_action *act, void *arg),
@@ -1771,42 +2511,38 @@ bio_wal_replay(struct bio_meta_context *mc, struct bio_wal_rp_stats *wrs,
 	struct wal_trans_head	*hdr;
 	unsigned int		 blk_bytes = si->si_header.wh_blk_bytes;
 	struct wal_blks_desc	 blk_desc = { 0 };
-	char			*buf, *dbuf = NULL;
+	struct wal_replay_buf	 rb;
+	char			*dbuf = NULL;
 	struct umem_action	*act;
-	unsigned int             max_blks    = WAL_MAX_REPLAY_BLKS, blk_off;
-	unsigned int		 nr_replayed = 0, tight_loop, dbuf_len = 0;
+	unsigned int             max_blks    = WAL_MAX_REPLAY_BLKS, blk_off = 0;
+	unsigned int		 nr_replayed = 0, tight_loop = 0, dbuf_len = 0;
 	uint64_t		 tx_id, start_id, unmap_start, unmap_end;
 	int			 rc;
 	uint64_t		 total_bytes = 0, rpl_entries = 0, total_tx = 0;
-	uint64_t                 s_us = 0;
+	uint64_t                 s_us = 0, phase_us = 0;
+	uint64_t		 load_tm = 0, verify_tm = 0, apply_tm = 0;
 
 	if (DAOS_FAIL_CHECK(DAOS_WAL_NO_REPLAY))
 		return 0;
 
-	D_ALLOC(buf, max_blks * blk_bytes);
-	if (buf == NULL)
-		return -DER_NOMEM;
-
 	D_ALLOC(act, sizeof(*act) + UMEM_ACT_PAYLOAD_MAX_LEN);
-	if (act == NULL) {
-		rc = -DER_NOMEM;
-		goto out;
-	}
+	if (act == NULL)
+		return -DER_NOMEM;
 
 	tx_id = wal_next_id(si, si->si_ckp_id, si->si_ckp_blks);
 	start_id = tx_id;
 
 	/* upper layer (VOS) rehydration metrics if any */
-	if (wrs != NULL)
+	if (wrs != NULL) {
 		s_us = daos_getutime();
+		phase_us = s_us;
+	}
 
-load_wal:
-	tight_loop = 0;
-	blk_off = 0;
-	rc = load_wal(mc, buf, max_blks, tx_id);
+	rc = replay_buf_init(mc, &rb, max_blks, tx_id);
 	if (rc) {
 		D_ERROR("Failed to load WAL. "DF_RC"\n", DP_RC(rc));
-		goto out;
+		D_FREE(act);
+		return rc;
 	}
 
 	while (1) {
@@ -1817,28 +2553,43 @@ load_wal:
 			break;
 		}
 
-		hdr = (struct wal_trans_head *)(buf + blk_off * blk_bytes);
+		if (blk_off == rb.rb_valid_blks) {
+			rc = replay_buf_load(&rb, &blk_off);
+			replay_tm_add(wrs, &load_tm, &phase_us);
+			if (rc)
+				break;
+		}
+
+		hdr = (struct wal_trans_head *)(rb.rb_buf + blk_off * blk_bytes);
 		rc = verify_tx_hdr(si, hdr, tx_id);
 		if (rc)
 			break;
 
 		calc_trans_blks(hdr->th_tot_ents, hdr->th_tot_payload, blk_bytes, &blk_desc);
+		if (blk_desc.bd_blks > max_blks) {
+			D_ERROR("Too large tx, the WAL is corrupted\n");
+			rc = -DER_INVAL;
+			break;
+		}
 
-		if (blk_off + blk_desc.bd_blks > max_blks) {
-			if (blk_off == 0) {
-				D_ERROR("Too large tx, the WAL is corrupted\n");
-				rc = -DER_INVAL;
+		/* The tx is partially loaded */
+		while (blk_off + blk_desc.bd_blks > rb.rb_valid_blks) {
+			rc = replay_buf_load(&rb, &blk_off);
+			if (rc)
 				break;
-			}
-			memset(buf, 0, max_blks * blk_bytes);
-			goto load_wal;
 		}
+		replay_tm_add(wrs, &load_tm, &phase_us);
+		if (rc)
+			break;
+		hdr = (struct wal_trans_head *)(rb.rb_buf + blk_off * blk_bytes);
 
 		rc = verify_tx(mc, (char *)hdr, &blk_desc, &dbuf, &dbuf_len);
+		replay_tm_add(wrs, &verify_tm, &phase_us);
 		if (rc)
 			break;
 
-		rc = replay_tx(si, (char *)hdr, replay_cb, arg, &blk_desc, act);
+		rc = replay_tx(mc, (char *)hdr, replay_cb, arg, &blk_desc, act);
+		replay_tm_add(wrs, &apply_tm, &phase_us);
 		if (rc)
 			break;
 
@@ -1860,14 +2611,11 @@ load_wal:
 		}
 		tx_id = wal_next_id(si, tx_id, blk_desc.bd_blks);
 
-		if (blk_off == max_blks) {
-			memset(buf, 0, max_blks * blk_bytes);
-			goto load_wal;
-		}
-
 		if (tight_loop >= 20) {
 			tight_loop = 0;
 			bio_yield(NULL);
+			if (wrs != NULL)
+				phase_us = daos_getutime();
 		}
 
 		/* test need generate enough tx */
@@ -1877,7 +2625,8 @@ load_wal:
 			break;
 		}
 	}
-out:
+	replay_buf_fini(&rb);
+
 	if (rc >= 0) {
 		D_DEBUG(DB_IO, "Replayed %u WAL transactions\n", nr_replayed);
 		D_ASSERT(si->si_commit_blks == 0 || wal_id_cmp(si, tx_id, si->si_commit_id) > 0);
@@ -1915,6 +2664,9 @@ out:
 			wrs->wrs_sz = total_bytes;
 			wrs->wrs_entries = rpl_entries;
 			wrs->wrs_tx_cnt = total_tx;
+			wrs->wrs_load_tm = load_tm;
+			wrs->wrs_verify_tm = verify_tm;
+			wrs->wrs_apply_tm = apply_tm;
 		}
 	} else {
 		DL_ERROR(rc, "WAL replay failed, nr_replayed:%u", nr_replayed);
@@ -1922,7 +2674,6 @@ out:
 
 	D_FREE(dbuf);
 	D_FREE(act);
-	D_FREE(buf);
 	return rc;
 }
 
@@ -2005,6 +2756,7 @@ wal_close(struct bio_meta_context *mc)
 
 	D_ASSERT(d_list_empty(&si->si_pending_list));
 	D_ASSERT(si->si_tx_failed == 0);
+	D_ASSERT(si->si_batch == NULL);
 	if (si->si_rsrv_waiters > 0)
 		wakeup_reserve_waiters(si, true);
 
@@ -2019,6 +2771,10 @@ wal_close(struct bio_meta_context *mc)
 	if (rc)
 		D_ERROR("Flush WAL header failed. "DF_RC"\n", DP_RC(rc));
 
+	if (mc->mc_compressor != NULL)
+		daos_compressor_destroy(&mc->mc_compressor);
+	D_FREE(mc->mc_zip_buf);
+	mc->mc_zip_buf_sz = 0;
 	ABT_mutex_free(&si->si_mutex);
 	ABT_cond_free(&si->si_rsrv_wq);
 }
@@ -2064,6 +2820,8 @@ wal_open(struct bio_meta_context *mc)
 	si->si_rsrv_waiters = 0;
 	si->si_pending_tx = 0;
 	si->si_tx_failed = 0;
+	si->si_batch = NULL;
+	si->si_batch_lat = 0;
 
 	si->si_ckp_id = hdr->wh_ckp_id;
 	si->si_ckp_blks = hdr->wh_ckp_blks;
@@ -2076,6 +2834,30 @@ wal_open(struct bio_meta_context *mc)
 
 	si->si_unused_id = wal_next_id(si, si->si_commit_id, si->si_commit_blks);
 
+	/* Always needed by replay, since compression could have been enabled before restart */
+	rc = daos_compressor_init_with_type(&mc->mc_compressor, COMPRESS_TYPE_LZ4, false, 0);
+	if (rc != DC_STATUS_OK) {
+		DL_WARN(rc, "Failed to init WAL compressor");
+		mc->mc_compressor = NULL;
+	}
+	mc->mc_zip_buf = NULL;
+	mc->mc_zip_buf_sz = 0;
+
+	/*
+	 * Mark the header before the first compressed transaction is written, the mark is kept
+	 * until the WAL is re-formatted, since compressed transactions could still be replayed.
+	 */
+	if (bio_wal_compress && mc->mc_compressor != NULL && !(hdr->wh_compat & WAL_COMPAT_ZIP)) {
+		hdr->wh_compat |= WAL_COMPAT_ZIP;
+		hdr->wh_version = BIO_WAL_VERSION_ZIP;
+		rc = write_header(mc, mc->mc_wal, hdr, sizeof(*hdr), &hdr->wh_csum);
+		if (rc) {
+			DL_WARN(rc, "Failed to mark WAL header for compression");
+			hdr->wh_compat &= ~WAL_COMPAT_ZIP;
+			hdr->wh_version = BIO_WAL_VERSION;
+		}
+	}
+
 	return 0;
 
 }
@@ -15,6 +15,11 @@
 
 #define BIO_WAL_MAGIC    (0xaf202209)
 #define BIO_WAL_VERSION  2
+/*
+ * WAL with WAL_COMPAT_ZIP set. Engines which don't know the compatibility bits only accept
+ * version 1 & 2, so they refuse to replay a WAL which may contain compressed transactions.
+ */
+#define BIO_WAL_VERSION_ZIP	3
 
 enum meta_hdr_flags {
 	META_HDR_FL_EMPTY	= (1UL << 0),
@@ -73,6 +78,13 @@ enum wal_hdr_flags {
 	WAL_HDR_FL_NO_TAIL	= (1 << 0),	/* No tail checksum */
 };
 
+/* WAL header compatibility bits, a WAL with unknown bits can't be opened */
+enum wal_compat_flags {
+	WAL_COMPAT_ZIP		= (1 << 0),	/* Transactions could be compressed */
+};
+
+#define WAL_COMPAT_KNOWN	(WAL_COMPAT_ZIP)
+
 /* WAL blob header */
 struct wal_header {
 	uint32_t wh_magic;
@@ -121,6 +133,13 @@ struct wal_header_v1 {
  * head of each block.
  */
 
+/*
+ * When the payload of a transaction is compressed, the header magic is WAL_TX_MAGIC_ZIP and
+ * th_tot_payload is the size of the compressed payload, which starts with the uncompressed
+ * payload size (uint32_t) followed by the compressed data. Compressed transactions are only
+ * written to a WAL with WAL_COMPAT_ZIP set in the header.
+ */
+
 /* WAL transaction header */
 struct wal_trans_head {
 	uint32_t	th_magic;
@@ -157,6 +176,8 @@ struct wal_super_info {
 	unsigned int		si_rsrv_waiters;/* Number of waiters in reserve waitqueue */
 	unsigned int		si_pending_tx;	/* Number of pending transactions */
 	unsigned int		si_tx_failed:1;	/* Indicating some transaction failed */
+	struct wal_batch	*si_batch;	/* Open group commit batch */
+	uint64_t		si_batch_lat;	/* Average batch WAL write latency, in usecs */
 };
 
 /* In-memory Meta context, exported as opaque data structure */
@@ -168,6 +189,9 @@ struct bio_meta_context {
 	struct wal_super_info	 mc_wal_info;	/* WAL blob super information */
 	struct hash_ft		*mc_csum_algo;
 	void			*mc_csum_ctx;
+	struct daos_compressor	*mc_compressor;	/* WAL payload compressor */
+	char			*mc_zip_buf;	/* Scratch buffer for WAL payload compression */
+	unsigned int		 mc_zip_buf_sz;
 };
 
 struct meta_fmt_info {
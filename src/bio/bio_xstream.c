@@ -38,6 +38,7 @@
 #define DAOS_DMA_CHUNK_INIT_PCT 50      /* Default per-xstream init chunks, in percentage */
 #define DAOS_DMA_CHUNK_CNT_MAX	128	/* Default per-xstream max chunks, 1GB */
 #define DAOS_DMA_CHUNK_CNT_MIN	32	/* Per-xstream min chunks, 256MB */
+#define DAOS_DMA_CHUNK_SMALL_PCT 10     /* Default chunks reserved for small IODs, in percentage */
 
 /* Max in-flight blob IOs per io channel */
 #define BIO_BS_MAX_CHANNEL_OPS	(4096)
@@ -54,6 +55,8 @@ unsigned int bio_chk_cnt_max;
 unsigned int bio_numa_node;
 /* Per-xstream initial DMA buffer size (in percentage) */
 static unsigned int bio_chk_init_pct;
+/* Percentage of per-xstream DMA buffer reserved for small IODs */
+unsigned int bio_chk_small_pct = DAOS_DMA_CHUNK_SMALL_PCT;
 /* Diret RDMA over SCM */
 bool bio_scm_rdma;
 /* Whether SPDK inited */
@@ -65,6 +68,12 @@ unsigned int        bio_spdk_power_mgmt_val = NVME_POWER_MGMT_UNINIT;
 /* How many blob unmap calls can be called in a row */
 unsigned int bio_spdk_max_unmap_cnt = 32;
 unsigned int bio_max_async_sz = (1UL << 15) /* 32k */;
+/* Coalesce back to back WAL transactions into one WAL write */
+bool                bio_wal_group_commit;
+/* Max time the WAL group commit leader waits for followers */
+unsigned int        bio_wal_batch_window = 200; /* us */
+/* LZ4 compress WAL transaction payload when it saves WAL blocks */
+bool                bio_wal_compress;
 unsigned int        bio_io_timeout         = 120000000; /* us, 120 seconds */
 
 struct bio_nvme_data {
@@ -90,6 +99,8 @@ struct bio_nvme_data {
 	unsigned int		 bd_nvme_roles;
 	bool			 bd_started;
 	bool			 bd_bypass_health_collect;
+	/* Number of VOS targets */
+	unsigned int		 bd_tgt_nr;
 	/* Setting to enable SPDK JSON-RPC server */
 	bool			 bd_enable_rpc_srv;
 	const char		*bd_rpc_srv_addr;
@@ -275,6 +286,7 @@ bio_nvme_init_ext(const char *nvme_conf, int numa_node, unsigned int mem_size,
 	nvme_glb.bd_init_xs               = NULL;
 	nvme_glb.bd_nvme_conf = NULL;
 	nvme_glb.bd_bypass_health_collect = bypass_health_collect;
+	nvme_glb.bd_tgt_nr = tgt_nr;
 	nvme_glb.bd_enable_rpc_srv = false;
 	nvme_glb.bd_rpc_srv_addr = NULL;
 	D_INIT_LIST_HEAD(&nvme_glb.bd_bdevs);
@@ -321,6 +333,16 @@ bio_nvme_init_ext(const char *nvme_conf, int numa_node, unsigned int mem_size,
 	d_getenv_uint("DAOS_MAX_ASYNC_SZ", &bio_max_async_sz);
 	D_INFO("Max async data size is set to %u bytes\n", bio_max_async_sz);
 
+	d_getenv_bool("DAOS_WAL_GROUP_COMMIT", &bio_wal_group_commit);
+	d_getenv_uint("DAOS_WAL_BATCH_WINDOW", &bio_wal_batch_window);
+	D_INFO("WAL group commit is %s, batch window %u us\n",
+	       bio_wal_group_commit ? "enabled" : "disabled", bio_wal_batch_window);
+
+	d_getenv_bool("DAOS_WAL_COMPRESS", &bio_wal_compress);
+	D_INFO("WAL payload compression is %s\n", bio_wal_compress ? "enabled" : "disabled");
+
+	bio_sched_env_init();
+
 	d_getenv_uint("DAOS_SPDK_IO_TIMEOUT", &io_timeout_secs);
 	if (io_timeout_secs > 0) {
 		if (io_timeout_secs < 30 || io_timeout_secs > 300)
@@ -363,6 +385,14 @@ bio_nvme_init_ext(const char *nvme_conf, int numa_node, unsigned int mem_size,
 	D_INFO("Set per-xstream DMA buffer upper bound to %u %uMB chunks, prealloc %u chunks\n",
 	       bio_chk_cnt_max, size_mb, init_chk_cnt());
 
+	d_getenv_uint("DAOS_DMA_SMALL_PCT", &bio_chk_small_pct);
+	if (bio_chk_small_pct >= 50) {
+		D_WARN("DAOS_DMA_SMALL_PCT %u is invalid, default %u is used\n",
+		       bio_chk_small_pct, DAOS_DMA_CHUNK_SMALL_PCT);
+		bio_chk_small_pct = DAOS_DMA_CHUNK_SMALL_PCT;
+	}
+	D_INFO("Reserve %u%% of per-xstream DMA buffer for small IODs\n", bio_chk_small_pct);
+
 	d_getenv_uint("DAOS_BS_CLUSTER_MB", &cluster_mb);
 	if (cluster_mb < 32 || cluster_mb > 1024) {
 		D_WARN("DAOS_BS_CLUSTER_MB %u is invalid, default %u is used\n", cluster_mb,
@@ -1341,6 +1371,7 @@ alloc_xs_blobstore(void)
 
 	D_INIT_LIST_HEAD(&bxb->bxb_pending_ios);
 	D_INIT_LIST_HEAD(&bxb->bxb_io_ctxts);
+	bio_sched_init(&bxb->bxb_sched);
 
 	return bxb;
 }
@@ -1506,6 +1537,9 @@ init_xs_blobstore_ctxt(struct bio_xs_context *ctxt, int tgt_id, enum smd_dev_typ
 	}
 
 	bxb = ctxt->bxc_xs_blobstores[st];
+	if (st == SMD_DEV_TYPE_DATA && tgt_id >= 0)
+		bio_sched_metrics_init(&bxb->bxb_sched, tgt_id, nvme_glb.bd_tgt_nr);
+
 	/* Hold bbs refcount for current xstream */
 	bxb->bxb_blobstore = get_bio_blobstore(d_bdev->bb_blobstore, ctxt);
 	if (bxb->bxb_blobstore == NULL)
@@ -0,0 +1,246 @@
+/**
+ * (C) Copyright 2026 Hewlett Packard Enterprise Development LP
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+/*
+ * Unit tests for the I/O class selection and the per-xstream admission of the blobstore
+ * I/O scheduler
+ */
+#define D_LOGFAC	DD_FAC(tests)
+
+#include <stdarg.h>
+#include <stdlib.h>
+#include <setjmp.h>
+#include <cmocka.h>
+
+#include "../bio_internal.h"
+
+static struct bio_xs_context	ut_xs_ctxt = { .bxc_self_polling = 1 };
+static struct bio_xs_blobstore	ut_bxb[2];
+
+/* Polls of the waiting I/O, and the callback simulating the progress of in-flight I/Os */
+static unsigned int		ut_polls;
+static void			(*ut_poll_cb)(void);
+/* Polls done when the nested waiter of test_fifo() is admitted */
+static unsigned int		ut_nested_polls;
+
+/* The waiting I/O polls the SPDK thread on a self polling xstream */
+int
+spdk_thread_poll(struct spdk_thread *thread, uint32_t max_msgs, uint64_t now)
+{
+	ut_polls++;
+	if (ut_poll_cb != NULL)
+		ut_poll_cb();
+	return 0;
+}
+
+static inline struct bio_sched_class *
+ut_class(int xs, unsigned int ioc)
+{
+	return &ut_bxb[xs].bxb_sched.bis_classes[ioc];
+}
+
+static void
+ut_sched_env(const char *name, const char *val)
+{
+	setenv(name, val, 1);
+	bio_sched_env_init();
+}
+
+static int
+ut_setup(void **state)
+{
+	int	i;
+
+	/* The deadline isn't expected to be hit unless it's set by test */
+	setenv("DAOS_BIO_SCHED", "1", 1);
+	setenv("DAOS_BIO_QD_SCRUB", "8", 1);
+	setenv("DAOS_BIO_BW_SCRUB", "0", 1);
+	setenv("DAOS_BIO_DEADLINE_SCRUB", "60000", 1);
+	bio_sched_env_init();
+
+	for (i = 0; i < ARRAY_SIZE(ut_bxb); i++)
+		bio_sched_init(&ut_bxb[i].bxb_sched);
+	ut_polls = 0;
+	ut_poll_cb = NULL;
+	ut_nested_polls = 0;
+
+	return 0;
+}
+
+static void
+test_io_class(void **state)
+{
+	struct bio_desc	biod = { 0 };
+
+	assert_int_equal(bio_sched_io_class(&biod), BIO_IOC_FG);
+
+	biod.bd_chk_type = BIO_CHK_TYPE_REBUILD;
+	assert_int_equal(bio_sched_io_class(&biod), BIO_IOC_REBUILD);
+
+	/* Non-blocking prep is from checkpointing */
+	biod.bd_chk_type = BIO_CHK_TYPE_IO;
+	biod.bd_non_blocking = 1;
+	assert_int_equal(bio_sched_io_class(&biod), BIO_IOC_CHKPT);
+
+	/* Class specified by caller wins */
+	biod.bd_chk_type = BIO_CHK_TYPE_REBUILD;
+	biod.bd_io_class = BIO_IOC_SCRUB;
+	assert_int_equal(bio_sched_io_class(&biod), BIO_IOC_SCRUB);
+}
+
+static void
+test_fg_unthrottled(void **state)
+{
+	int	i;
+
+	ut_sched_env("DAOS_BIO_QD_SCRUB", "1");
+	for (i = 0; i < 100; i++)
+		bio_sched_admit(&ut_xs_ctxt, &ut_bxb[0], BIO_IOC_FG, 1 << 20);
+	assert_int_equal(ut_class(0, BIO_IOC_FG)->bsc_inflights, 100);
+
+	/* Nothing is throttled when the scheduler is disabled */
+	ut_sched_env("DAOS_BIO_SCHED", "0");
+	for (i = 0; i < 10; i++)
+		bio_sched_admit(&ut_xs_ctxt, &ut_bxb[0], BIO_IOC_SCRUB, 4096);
+	assert_int_equal(ut_class(0, BIO_IOC_SCRUB)->bsc_inflights, 10);
+	assert_int_equal(ut_polls, 0);
+}
+
+static void
+ut_complete_scrub(void)
+{
+	bio_sched_done(&ut_bxb[0], BIO_IOC_SCRUB);
+}
+
+static void
+test_qd_cap(void **state)
+{
+	struct bio_sched_class	*cls = ut_class(0, BIO_IOC_SCRUB);
+	int			 i;
+
+	for (i = 0; i < 8; i++)
+		bio_sched_admit(&ut_xs_ctxt, &ut_bxb[0], BIO_IOC_SCRUB, 4096);
+	assert_int_equal(cls->bsc_inflights, 8);
+	assert_int_equal(ut_polls, 0);
+
+	/* The 9th I/O waits until an in-flight one is completed */
+	ut_poll_cb = ut_complete_scrub;
+	bio_sched_admit(&ut_xs_ctxt, &ut_bxb[0], BIO_IOC_SCRUB, 4096);
+	assert_int_equal(ut_polls, 1);
+	assert_int_equal(cls->bsc_inflights, 8);
+	assert_int_equal(cls->bsc_waiter_cnt, 0);
+	assert_int_equal(ut_bxb[0].bxb_sched.bis_waiter_cnt, 0);
+}
+
+static void
+ut_fifo_poll(void)
+{
+	switch (ut_polls) {
+	case 1:
+		/* Queue the second waiter behind the first one */
+		bio_sched_admit(&ut_xs_ctxt, &ut_bxb[0], BIO_IOC_SCRUB, 4096);
+		ut_nested_polls = ut_polls;
+		break;
+	case 2:
+		/* Admits the first waiter, the second one has to wait for another completion */
+		assert_int_equal(ut_class(0, BIO_IOC_SCRUB)->bsc_waiter_cnt, 2);
+		bio_sched_done(&ut_bxb[0], BIO_IOC_SCRUB);
+		assert_int_equal(ut_class(0, BIO_IOC_SCRUB)->bsc_waiter_cnt, 1);
+		break;
+	default:
+		bio_sched_done(&ut_bxb[0], BIO_IOC_SCRUB);
+		break;
+	}
+}
+
+static void
+test_fifo(void **state)
+{
+	struct bio_sched_class	*cls = ut_class(0, BIO_IOC_SCRUB);
+
+	ut_sched_env("DAOS_BIO_QD_SCRUB", "1");
+	bio_sched_admit(&ut_xs_ctxt, &ut_bxb[0], BIO_IOC_SCRUB, 4096);
+
+	ut_poll_cb = ut_fifo_poll;
+	bio_sched_admit(&ut_xs_ctxt, &ut_bxb[0], BIO_IOC_SCRUB, 4096);
+	assert_int_equal(ut_nested_polls, 3);
+	assert_int_equal(ut_polls, 3);
+	assert_int_equal(cls->bsc_inflights, 1);
+	assert_int_equal(cls->bsc_waiter_cnt, 0);
+}
+
+static void
+test_deadline(void **state)
+{
+	struct bio_sched_class	*cls = ut_class(0, BIO_IOC_SCRUB);
+
+	ut_sched_env("DAOS_BIO_QD_SCRUB", "1");
+	ut_sched_env("DAOS_BIO_DEADLINE_SCRUB", "0");
+
+	/* A waiter passed its deadline exceeds the queue depth cap */
+	bio_sched_admit(&ut_xs_ctxt, &ut_bxb[0], BIO_IOC_SCRUB, 4096);
+	bio_sched_admit(&ut_xs_ctxt, &ut_bxb[0], BIO_IOC_SCRUB, 4096);
+	assert_int_equal(cls->bsc_inflights, 2);
+	assert_int_equal(ut_polls, 0);
+}
+
+static void
+test_bw_limit(void **state)
+{
+	struct bio_sched_class	*cls = ut_class(0, BIO_IOC_SCRUB);
+	uint64_t		 start;
+
+	/* 100MB/s, the burst is 10MB */
+	ut_sched_env("DAOS_BIO_QD_SCRUB", "0");
+	ut_sched_env("DAOS_BIO_BW_SCRUB", "100");
+
+	/* A large I/O is admitted by borrowing tokens, following I/O waits for the refill */
+	start = daos_getutime();
+	bio_sched_admit(&ut_xs_ctxt, &ut_bxb[0], BIO_IOC_SCRUB, 20 << 20);
+	assert_int_equal(ut_polls, 0);
+	bio_sched_admit(&ut_xs_ctxt, &ut_bxb[0], BIO_IOC_SCRUB, 4096);
+	assert_true(ut_polls > 0);
+	assert_true(daos_getutime() - start >= 100000);
+	assert_int_equal(cls->bsc_inflights, 2);
+}
+
+static void
+test_per_xstream(void **state)
+{
+	ut_sched_env("DAOS_BIO_QD_SCRUB", "1");
+
+	/* The cap of one class doesn't block other classes or other xstreams */
+	bio_sched_admit(&ut_xs_ctxt, &ut_bxb[0], BIO_IOC_SCRUB, 4096);
+	bio_sched_admit(&ut_xs_ctxt, &ut_bxb[0], BIO_IOC_AGG, 4096);
+	bio_sched_admit(&ut_xs_ctxt, &ut_bxb[1], BIO_IOC_SCRUB, 4096);
+	assert_int_equal(ut_polls, 0);
+	assert_int_equal(ut_class(0, BIO_IOC_SCRUB)->bsc_inflights, 1);
+	assert_int_equal(ut_class(0, BIO_IOC_AGG)->bsc_inflights, 1);
+	assert_int_equal(ut_class(1, BIO_IOC_SCRUB)->bsc_inflights, 1);
+
+	/* Completion on one xstream doesn't admit waiters of another one */
+	ut_poll_cb = ut_complete_scrub;
+	bio_sched_admit(&ut_xs_ctxt, &ut_bxb[0], BIO_IOC_SCRUB, 4096);
+	assert_int_equal(ut_class(0, BIO_IOC_SCRUB)->bsc_inflights, 1);
+	assert_int_equal(ut_class(1, BIO_IOC_SCRUB)->bsc_inflights, 1);
+}
+
+int
+main(void)
+{
+	const struct CMUnitTest tests[] = {
+	    cmocka_unit_test_setup(test_io_class, ut_setup),
+	    cmocka_unit_test_setup(test_fg_unthrottled, ut_setup),
+	    cmocka_unit_test_setup(test_qd_cap, ut_setup),
+	    cmocka_unit_test_setup(test_fifo, ut_setup),
+	    cmocka_unit_test_setup(test_deadline, ut_setup),
+	    cmocka_unit_test_setup(test_bw_limit, ut_setup),
+	    cmocka_unit_test_setup(test_per_xstream, ut_setup),
+	};
+
+	d_register_alt_assert(mock_assert);
+
+	return cmocka_run_group_tests_name("bio_sched_ut", tests, NULL, NULL);
+}
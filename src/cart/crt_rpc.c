@@ -1981,6 +1981,23 @@ out:
 	return rc;
 }
 
+int
+crt_req_rpcid_get(crt_rpc_t *rpc, uint64_t *rpcid)
+{
+	struct crt_rpc_priv    *rpc_priv;
+	int			rc = 0;
+
+	if (rpc == NULL || rpcid == NULL) {
+		D_ERROR("NULL pointer passed\n");
+		D_GOTO(out, rc = -DER_INVAL);
+	}
+
+	rpc_priv = container_of(rpc, struct crt_rpc_priv, crp_pub);
+	*rpcid = rpc_priv->crp_req_hdr.cch_rpcid;
+out:
+	return rc;
+}
+
 int
 crt_register_hlc_error_cb(crt_hlc_error_cb event_handler, void *arg)
 {
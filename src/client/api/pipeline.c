@@ -13,11 +13,14 @@
 void
 daos_pipeline_init(daos_pipeline_t *pipeline)
 {
-	pipeline->version          = 1;
+	pipeline->version          = 2;
 	pipeline->num_filters      = 0;
 	pipeline->filters          = NULL;
 	pipeline->num_aggr_filters = 0;
 	pipeline->aggr_filters     = NULL;
+	pipeline->group_by         = NULL;
+	pipeline->order_by         = NULL;
+	pipeline->limit            = 0;
 }
 
 void
@@ -57,6 +60,18 @@ daos_pipeline_add(daos_pipeline_t *pipeline, daos_filter_t *filter)
 
 		pipeline->aggr_filters[pipeline->num_aggr_filters] = filter;
 		pipeline->num_aggr_filters += 1;
+	} else if (!strncmp((char *)filter->filter_type.iov_buf, "DAOS_FILTER_GROUP_BY",
+			    filter->filter_type.iov_len)) {
+		if (pipeline->group_by != NULL)
+			return -DER_EXIST;
+		pipeline->group_by = filter;
+	} else if (!strncmp((char *)filter->filter_type.iov_buf, "DAOS_FILTER_ORDER_BY",
+			    filter->filter_type.iov_len) ||
+		   !strncmp((char *)filter->filter_type.iov_buf, "DAOS_FILTER_ORDER_BY_DESC",
+			    filter->filter_type.iov_len)) {
+		if (pipeline->order_by != NULL)
+			return -DER_EXIST;
+		pipeline->order_by = filter;
 	} else {
 		return -DER_INVAL;
 	}
@@ -127,6 +142,17 @@ daos_pipeline_free(daos_pipeline_t *pipeline)
 		return rc;
 	D_FREE(pipeline->aggr_filters);
 
+	if (pipeline->group_by != NULL) {
+		rc = free_filters(&pipeline->group_by, 1);
+		if (rc != 0)
+			return rc;
+	}
+	if (pipeline->order_by != NULL) {
+		rc = free_filters(&pipeline->order_by, 1);
+		if (rc != 0)
+			return rc;
+	}
+
 	daos_pipeline_init(pipeline);
 
 	return 0;
@@ -154,3 +180,30 @@ daos_pipeline_run(daos_handle_t coh, daos_handle_t oh, daos_pipeline_t *pipeline
 
 	return dc_task_schedule(task, true);
 }
+
+int
+daos_pipeline_scan(daos_handle_t coh, daos_handle_t oh, daos_pipeline_t *pipeline, daos_handle_t th,
+		   uint64_t flags, uint32_t *nr_iods, daos_iod_t *iods,
+		   daos_pipeline_stream_t *stream, d_sg_list_t *sgl_agg,
+		   daos_pipeline_stats_t *stats, daos_event_t *ev)
+{
+	tse_task_t *task;
+	int         rc;
+
+	if (stream == NULL || stream->nr_kds == 0 ||
+	    (stream->recs_cb == NULL && pipeline->num_aggr_filters == 0))
+		return -DER_INVAL;
+	if (pipeline->group_by != NULL || pipeline->order_by != NULL)
+		return -DER_NOTSUPPORTED;
+
+	rc = dc_pipeline_check(pipeline);
+	if (rc != 0)
+		return rc; /** bad pipeline */
+
+	rc = dc_pipeline_scan_task_create(coh, oh, th, pipeline, flags, nr_iods, iods, stream,
+					  sgl_agg, stats, ev, NULL, &task);
+	if (rc)
+		return rc;
+
+	return dc_task_schedule(task, true);
+}
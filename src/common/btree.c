@@ -1616,6 +1616,47 @@ btr_cmp(struct btr_context *tcx, umem_off_t nd_off,
 	return cmp;
 }
 
+/**
+ * Search integer key \a key in node \a nd_off, return the position of the
+ * first record that is not less than \a key, or of the last record if all
+ * records are less than \a key. \a cmp_p returns the comparison result of
+ * the record at that position, the same as btr_cmp() does.
+ *
+ * The comparison result does not steer branches, the compiler turns the
+ * loop body into a conditional move, so there is no misprediction even if
+ * keys are random. The number of steps only depends on the number of keys.
+ */
+static int
+btr_node_search_int(struct btr_context *tcx, umem_off_t nd_off, uint64_t key,
+		    int *cmp_p)
+{
+	struct btr_node	*nd = btr_off2ptr(tcx, nd_off);
+	char		*addr = (char *)&nd[1];
+	uint32_t	 size = btr_rec_size(tcx);
+	uint32_t	 nr = nd->tn_keyn;
+	uint32_t	 at = 0;
+	uint32_t	 half;
+	uint64_t	 ukey;
+
+	D_ASSERT(nr > 0);
+#define node_ukey(at)	(((struct btr_record *)&addr[size * (at)])->rec_ukey[0])
+	while (nr > 1) {
+		half = nr / 2;
+		at = node_ukey(at + half - 1) < key ? at + half : at;
+		nr -= half;
+	}
+	ukey = node_ukey(at);
+#undef node_ukey
+
+	if (ukey < key)
+		*cmp_p = BTR_CMP_LT;
+	else if (ukey > key)
+		*cmp_p = BTR_CMP_GT;
+	else
+		*cmp_p = BTR_CMP_EQ;
+	return at;
+}
+
 bool
 btr_probe_valid(dbtree_probe_opc_t opc)
 {
@@ -1774,6 +1815,12 @@ btr_probe(struct btr_context *tcx, dbtree_probe_opc_t probe_opc,
 		} else if (probe_opc == BTR_PROBE_LAST) {
 			at = start = end;
 			cmp = BTR_CMP_LT;
+		} else if (hkey != NULL && btr_is_int_key(tcx)) {
+			D_ASSERT(probe_opc & BTR_PROBE_SPEC);
+			/* the whole node is searched in one go */
+			at = btr_node_search_int(tcx, nd_off, *(uint64_t *)hkey, &cmp);
+			start = end = at;
+			D_DEBUG(DB_TRACE, "searched integer key at %d, cmp %d\n", at, cmp);
 		} else {
 			D_ASSERT(probe_opc & BTR_PROBE_SPEC);
 			/* binary search */
@@ -2628,6 +2675,486 @@ dbtree_upsert(daos_handle_t toh, dbtree_probe_opc_t opc, uint32_t intent,
 	return btr_tx_end(tcx, rc);
 }
 
+/**
+ * Compare record \a at of node \a nd_off with \a key, resolve hash collision
+ * of leaf records by comparing the full key.
+ */
+static int
+btr_cmp_key(struct btr_context *tcx, umem_off_t nd_off, int at, char *hkey, d_iov_t *key)
+{
+	int	cmp;
+
+	cmp = btr_cmp(tcx, nd_off, at, hkey, key);
+	if (cmp == BTR_CMP_EQ && btr_has_collision(tcx) && btr_node_is_leaf(tcx, nd_off))
+		cmp = btr_cmp(tcx, nd_off, at, NULL, key);
+
+	return cmp;
+}
+
+/**
+ * Search \a key in the leaf of the current trace without probing from the
+ * root. It is only possible if \a key is greater than the record of the trace
+ * and less than the first key of the next leaf, PROBE_RC_UNKNOWN is returned
+ * otherwise.
+ */
+static enum btr_probe_rc
+btr_probe_leaf(struct btr_context *tcx, d_iov_t *key, char *hkey)
+{
+	struct btr_trace	*trace = &tcx->tc_trace.ti_trace[tcx->tc_depth - 1];
+	struct btr_trace	*par_tr;
+	struct btr_node		*nd;
+	int			 start;
+	int			 end;
+	int			 at;
+	int			 cmp;
+
+	nd = btr_off2ptr(tcx, trace->tr_node);
+	if (trace->tr_at >= nd->tn_keyn)
+		return PROBE_RC_UNKNOWN;
+
+	cmp = btr_cmp_key(tcx, trace->tr_node, trace->tr_at, hkey, key);
+	if (cmp != BTR_CMP_LT)
+		return PROBE_RC_UNKNOWN;
+
+	/* the lowest ancestor having a right sibling subtree holds the bound */
+	for (par_tr = trace - 1; par_tr >= tcx->tc_trace.ti_trace; par_tr--) {
+		struct btr_node *par_nd = btr_off2ptr(tcx, par_tr->tr_node);
+
+		if (par_tr->tr_at == par_nd->tn_keyn)
+			continue;
+
+		cmp = btr_cmp(tcx, par_tr->tr_node, par_tr->tr_at, hkey, key);
+		if (cmp != BTR_CMP_GT)
+			return PROBE_RC_UNKNOWN;
+		break;
+	}
+
+	start = trace->tr_at + 1;
+	end   = nd->tn_keyn - 1;
+	while (start <= end) {
+		at  = (start + end) / 2;
+		cmp = btr_cmp_key(tcx, trace->tr_node, at, hkey, key);
+		if (cmp == BTR_CMP_ERR)
+			return PROBE_RC_ERR;
+
+		if (cmp == BTR_CMP_EQ) {
+			trace->tr_at = at;
+			return PROBE_RC_OK;
+		}
+
+		if (cmp & BTR_CMP_LT)
+			start = at + 1;
+		else
+			end = at - 1;
+	}
+	/* position for the follow-on insert */
+	trace->tr_at = start;
+	return PROBE_RC_NONE;
+}
+
+static int
+btr_upsert_batch(struct btr_context *tcx, d_iov_t *keys, d_iov_t *vals, int nr)
+{
+	char	hkey[DAOS_HKEY_MAX];
+	bool	reuse = false;
+	int	rc = 0;
+	int	i;
+
+	for (i = 0; i < nr; i++) {
+		rc = btr_verify_key(tcx, &keys[i]);
+		if (rc != 0)
+			break;
+
+		btr_hkey_gen(tcx, &keys[i], hkey);
+		rc = reuse ? btr_probe_leaf(tcx, &keys[i], hkey) : PROBE_RC_UNKNOWN;
+		if (rc == PROBE_RC_UNKNOWN)
+			rc = btr_probe(tcx, BTR_PROBE_EQ, DAOS_INTENT_UPDATE, &keys[i], hkey);
+
+		/* The trace is still valid for the next key if the leaf is
+		 * neither split nor resized by this upsert. Availability check
+		 * can skip records, so always probe for those trees.
+		 */
+		reuse = tcx->tc_depth != 0 && !btr_has_embedded_value(tcx) &&
+			btr_ops(tcx)->to_check_availability == NULL &&
+			(rc == PROBE_RC_OK ||
+			 (rc == PROBE_RC_NONE && !btr_root_resize_needed(tcx) &&
+			  !btr_node_is_full(tcx, tcx->tc_trace.ti_trace[tcx->tc_depth - 1].tr_node)));
+
+		tcx->tc_probe_rc = rc;
+		rc = btr_upsert(tcx, BTR_PROBE_BYPASS, DAOS_INTENT_UPDATE, &keys[i], &vals[i],
+				NULL);
+		if (rc != 0)
+			break;
+	}
+
+	tcx->tc_probe_rc = PROBE_RC_UNKNOWN;
+	return rc;
+}
+
+/**
+ * Update or insert a batch of records. Keys should be sorted in the order of
+ * the tree, a key that falls into the same leaf as the previous one is then
+ * located by searching that leaf only, instead of probing from the root.
+ * Unsorted keys are still upserted correctly, they just don't benefit from it.
+ * All records are upserted in one transaction.
+ *
+ * \param[in] toh	Tree open handle.
+ * \param[in] keys	Array of keys.
+ * \param[in] vals	Array of values, one for each key.
+ * \param[in] nr		Number of records.
+ *
+ * \return		0	success
+ *			-ve	error code
+ */
+int
+dbtree_upsert_batch(daos_handle_t toh, d_iov_t *keys, d_iov_t *vals, int nr)
+{
+	struct btr_context *tcx;
+	int		    rc;
+
+	tcx = btr_hdl2tcx(toh);
+	if (tcx == NULL)
+		return -DER_NO_HDL;
+
+	rc = btr_tx_begin(tcx);
+	if (rc != 0)
+		return rc;
+
+	rc = btr_upsert_batch(tcx, keys, vals, nr);
+
+	return btr_tx_end(tcx, rc);
+}
+
+/** The node being filled on one level of a tree built by dbtree_bulk_load */
+struct btr_bulk_level {
+	/** node being filled */
+	umem_off_t		bl_node;
+	/** the previous node on this level, it is full and linked to its parent */
+	umem_off_t		bl_prev;
+	/** separator of bl_node for its parent, the smallest key under bl_node */
+	union btr_rec_buf	bl_sep;
+};
+
+struct btr_bulk {
+	struct btr_bulk_level	bk_levels[BTR_TRACE_MAX];
+	/** number of levels built so far */
+	int			bk_depth;
+	/** number of records loaded */
+	uint64_t		bk_nr;
+};
+
+/**
+ * Append child \a child_off to the node being filled at \a level, start a new
+ * node if it is full and link the full node to the upper level.
+ */
+static int
+btr_bulk_add_child(struct btr_context *tcx, struct btr_bulk *bulk, int level,
+		   umem_off_t child_off, struct btr_record *sep)
+{
+	struct btr_bulk_level	*bl;
+	struct btr_record	*rec;
+	struct btr_node		*nd;
+	int			 rc;
+
+	if (level >= BTR_TRACE_MAX) {
+		D_ERROR("Tree is too deep\n");
+		return -DER_OVERFLOW;
+	}
+
+	bl = &bulk->bk_levels[level];
+	if (!UMOFF_IS_NULL(bl->bl_node)) {
+		nd = btr_off2ptr(tcx, bl->bl_node);
+		if (nd->tn_keyn < tcx->tc_order - 1) {
+			rec = btr_node_rec_at(tcx, bl->bl_node, nd->tn_keyn);
+			rec->rec_off = child_off;
+			btr_rec_copy_hkey(tcx, rec, sep);
+			nd->tn_keyn++;
+			return 0;
+		}
+
+		rc = btr_bulk_add_child(tcx, bulk, level + 1, bl->bl_node, &bl->bl_sep.rb_rec);
+		if (rc != 0)
+			return rc;
+		bl->bl_prev = bl->bl_node;
+	}
+
+	rc = btr_node_alloc(tcx, &bl->bl_node);
+	if (rc != 0)
+		return rc;
+
+	nd = btr_off2ptr(tcx, bl->bl_node);
+	nd->tn_child = child_off;
+	btr_rec_copy_hkey(tcx, &bl->bl_sep.rb_rec, sep);
+	bulk->bk_depth = max(bulk->bk_depth, level + 1);
+	return 0;
+}
+
+/** Append record \a rec to the leaf being filled */
+static int
+btr_bulk_add_rec(struct btr_context *tcx, struct btr_bulk *bulk, struct btr_record *rec)
+{
+	struct btr_bulk_level	*bl = &bulk->bk_levels[0];
+	struct btr_node		*nd;
+	int			 rc;
+
+	if (!UMOFF_IS_NULL(bl->bl_node)) {
+		nd = btr_off2ptr(tcx, bl->bl_node);
+		if (nd->tn_keyn < tcx->tc_order - 1) {
+			btr_rec_copy(tcx, btr_node_rec_at(tcx, bl->bl_node, nd->tn_keyn), rec, 1);
+			nd->tn_keyn++;
+			goto out;
+		}
+
+		rc = btr_bulk_add_child(tcx, bulk, 1, bl->bl_node, &bl->bl_sep.rb_rec);
+		if (rc != 0)
+			return rc;
+		bl->bl_prev = bl->bl_node;
+	}
+
+	rc = btr_node_alloc(tcx, &bl->bl_node);
+	if (rc != 0)
+		return rc;
+
+	rc = btr_node_set(tcx, bl->bl_node, BTR_NODE_LEAF, false);
+	if (rc != 0)
+		return rc;
+
+	nd = btr_off2ptr(tcx, bl->bl_node);
+	btr_rec_copy(tcx, btr_node_rec_at(tcx, bl->bl_node, 0), rec, 1);
+	nd->tn_keyn = 1;
+
+	/* direct key is compared against the first record of the leaf */
+	if (btr_is_direct_key(tcx))
+		bl->bl_sep.rb_rec.rec_node[0] = bl->bl_node;
+	else
+		btr_rec_copy_hkey(tcx, &bl->bl_sep.rb_rec, rec);
+	bulk->bk_depth = max(bulk->bk_depth, 1);
+out:
+	bulk->bk_nr++;
+	return 0;
+}
+
+/** Whether \a key can be appended after the last record loaded */
+static bool
+btr_bulk_in_order(struct btr_context *tcx, struct btr_bulk *bulk, d_iov_t *key, char *hkey)
+{
+	umem_off_t	 nd_off = bulk->bk_levels[0].bl_node;
+	struct btr_node	*nd;
+	int		 cmp;
+
+	if (bulk->bk_nr == 0)
+		return true;
+
+	nd = btr_off2ptr(tcx, nd_off);
+	if (btr_is_direct_key(tcx))
+		cmp = btr_key_cmp(tcx, btr_node_rec_at(tcx, nd_off, nd->tn_keyn - 1), key);
+	else
+		cmp = btr_hkey_cmp(tcx, btr_node_rec_at(tcx, nd_off, nd->tn_keyn - 1), hkey);
+
+	return (cmp & (BTR_CMP_LT | BTR_CMP_ERR)) == BTR_CMP_LT;
+}
+
+/**
+ * Link the nodes being filled to their parents, and install the top node as
+ * the root of the tree.
+ */
+static int
+btr_bulk_finish(struct btr_context *tcx, struct btr_bulk *bulk)
+{
+	struct btr_bulk_level	*bl;
+	struct btr_root		*root = tcx->tc_tins.ti_root;
+	struct btr_record	*last;
+	struct btr_record	*rec;
+	struct btr_node		*nd;
+	struct btr_node		*prev;
+	union btr_rec_buf	 rec_buf;
+	int			 level;
+	int			 rc;
+
+	if (bulk->bk_nr == 0)
+		return 0;
+
+	if (bulk->bk_nr == 1 && btr_supports_embedded_value(tcx)) {
+		/* a single record is embedded in the root, as btr_insert does */
+		bl = &bulk->bk_levels[0];
+		btr_rec_copy(tcx, &rec_buf.rb_rec, btr_node_rec_at(tcx, bl->bl_node, 0), 1);
+		rc = btr_node_free(tcx, bl->bl_node);
+		if (rc != 0)
+			return rc;
+
+		btr_context_set_depth(tcx, 0);
+		return btr_root_start(tcx, &rec_buf.rb_rec, NULL, true);
+	}
+
+	for (level = 0; level < bulk->bk_depth - 1; level++) {
+		bl = &bulk->bk_levels[level];
+		nd = btr_off2ptr(tcx, bl->bl_node);
+		if (level > 0 && nd->tn_keyn == 0) {
+			/* An internal node needs two children at least, move the
+			 * last child of the full previous node to this one.
+			 */
+			D_ASSERT(!UMOFF_IS_NULL(bl->bl_prev));
+			prev = btr_off2ptr(tcx, bl->bl_prev);
+			last = btr_node_rec_at(tcx, bl->bl_prev, prev->tn_keyn - 1);
+			rec  = btr_node_rec_at(tcx, bl->bl_node, 0);
+
+			rec->rec_off = nd->tn_child;
+			btr_rec_copy_hkey(tcx, rec, &bl->bl_sep.rb_rec);
+			nd->tn_child = last->rec_off;
+			btr_rec_copy_hkey(tcx, &bl->bl_sep.rb_rec, last);
+			nd->tn_keyn = 1;
+			prev->tn_keyn--;
+		}
+
+		rc = btr_bulk_add_child(tcx, bulk, level + 1, bl->bl_node, &bl->bl_sep.rb_rec);
+		if (rc != 0)
+			return rc;
+	}
+
+	bl = &bulk->bk_levels[bulk->bk_depth - 1];
+	rc = btr_node_set(tcx, bl->bl_node, BTR_NODE_ROOT, false);
+	if (rc != 0)
+		return rc;
+
+	/* root has been added to TX by btr_bulk_load */
+	root->tr_node  = bl->bl_node;
+	root->tr_depth = bulk->bk_depth;
+	btr_context_set_depth(tcx, root->tr_depth);
+
+	D_DEBUG(DB_TRACE, "Bulk loaded "DF_U64" records, depth %d\n",
+		bulk->bk_nr, bulk->bk_depth);
+	return 0;
+}
+
+static int
+btr_bulk_load(struct btr_context *tcx, dbtree_bulk_next_t next, void *arg)
+{
+	struct btr_root		*root = tcx->tc_tins.ti_root;
+	struct btr_bulk		*bulk;
+	struct btr_record	*rec;
+	union btr_rec_buf	 rec_buf;
+	d_iov_t			 key;
+	d_iov_t			 val;
+	int			 level;
+	int			 rc;
+
+	tcx->tc_feats = root->tr_feats;
+	btr_context_set_depth(tcx, root->tr_depth);
+
+	/* bottom-up build starts from scratch, otherwise fall back to upsert */
+	if (!btr_root_empty(tcx) || btr_has_embedded_value(tcx)) {
+		bulk = NULL;
+	} else {
+		D_ALLOC_PTR(bulk);
+		if (bulk == NULL)
+			return -DER_NOMEM;
+
+		for (level = 0; level < BTR_TRACE_MAX; level++) {
+			bulk->bk_levels[level].bl_node = BTR_NODE_NULL;
+			bulk->bk_levels[level].bl_prev = BTR_NODE_NULL;
+		}
+
+		if (btr_has_tx(tcx)) {
+			rc = btr_root_tx_add(tcx);
+			if (rc != 0)
+				goto out;
+		}
+		/* dynamic root starts small, all nodes are full-size here */
+		root->tr_node_size = tcx->tc_order;
+	}
+
+	while (1) {
+		rc = next(arg, &key, &val);
+		if (rc != 0) {
+			if (rc > 0) /* no more records */
+				rc = 0;
+			break;
+		}
+
+		rc = btr_verify_key(tcx, &key);
+		if (rc != 0)
+			break;
+
+		if (bulk == NULL) {
+			rc = btr_upsert(tcx, BTR_PROBE_EQ, DAOS_INTENT_UPDATE, &key, &val, NULL);
+			if (rc != 0)
+				break;
+			continue;
+		}
+
+		memset(&rec_buf, 0, sizeof(rec_buf));
+		rec = &rec_buf.rb_rec;
+		btr_hkey_gen(tcx, &key, &rec->rec_hkey[0]);
+		if (!btr_bulk_in_order(tcx, bulk, &key, &rec->rec_hkey[0])) {
+			D_DEBUG(DB_TRACE, "Unsorted key, fall back to upsert after "DF_U64
+				" records\n", bulk->bk_nr);
+			rc = btr_bulk_finish(tcx, bulk);
+			D_FREE(bulk);
+			if (rc != 0)
+				break;
+
+			rc = btr_upsert(tcx, BTR_PROBE_EQ, DAOS_INTENT_UPDATE, &key, &val, NULL);
+			if (rc != 0)
+				break;
+			continue;
+		}
+
+		rc = btr_rec_alloc(tcx, &key, &val, rec, NULL);
+		if (rc != 0)
+			break;
+
+		rc = btr_bulk_add_rec(tcx, bulk, rec);
+		if (rc != 0) {
+			btr_rec_free(tcx, rec, NULL);
+			break;
+		}
+	}
+
+	if (bulk != NULL && rc == 0)
+		rc = btr_bulk_finish(tcx, bulk);
+out:
+	D_FREE(bulk);
+	tcx->tc_probe_rc = PROBE_RC_UNKNOWN; /* path changed */
+	return rc;
+}
+
+/**
+ * Load records into the tree. The records are fetched one by one by calling
+ * \a next, and they should be in the order of the tree, e.g. the order in
+ * which a tree of the same class iterates them.
+ *
+ * If the tree is empty, leaf nodes are filled up with the sorted records and
+ * internal nodes are built bottom-up, without probing or splitting. If the
+ * tree is not empty, or once a record is out of order, the rest records are
+ * inserted by upsert. All changes are made in one transaction.
+ *
+ * \param[in] toh	Tree open handle.
+ * \param[in] next	Callback to fetch the next record, it returns 1 if there
+ *			is no more record.
+ * \param[in] arg	Argument of \a next.
+ *
+ * \return		0	success
+ *			-ve	error code
+ */
+int
+dbtree_bulk_load(daos_handle_t toh, dbtree_bulk_next_t next, void *arg)
+{
+	struct btr_context *tcx;
+	int		    rc;
+
+	tcx = btr_hdl2tcx(toh);
+	if (tcx == NULL)
+		return -DER_NO_HDL;
+
+	rc = btr_tx_begin(tcx);
+	if (rc != 0)
+		return rc;
+
+	rc = btr_bulk_load(tcx, next, arg);
+
+	return btr_tx_end(tcx, rc);
+}
+
 /** When pairing down from 2 entries in the root to 2 we can remove
  * the node and restore the embedded entry.  This function will modify
  * the root and set flags accordingly.
@@ -3417,14 +3944,18 @@ btr_root_del_rec(struct btr_context *tcx, struct btr_trace *trace, void *args)
 	return rc;
 }
 
+/**
+ * Delete the record or child pointed by the trace of \a level, and bubble up
+ * the deletion if it is needed.
+ */
 static int
-btr_delete(struct btr_context *tcx, void *args)
+btr_delete_at(struct btr_context *tcx, int level, void *args)
 {
 	struct btr_trace	*par_tr;
 	struct btr_trace	*cur_tr;
 	int			 rc = 0;
 
-	for (cur_tr = &tcx->tc_trace.ti_trace[tcx->tc_depth - 1];; cur_tr = par_tr) {
+	for (cur_tr = &tcx->tc_trace.ti_trace[level];; cur_tr = par_tr) {
 		if (cur_tr == tcx->tc_trace.ti_trace) { /* root */
 			rc = btr_root_del_rec(tcx, cur_tr, args);
 			break;
@@ -3443,6 +3974,12 @@ btr_delete(struct btr_context *tcx, void *args)
 	return rc;
 }
 
+static int
+btr_delete(struct btr_context *tcx, void *args)
+{
+	return btr_delete_at(tcx, tcx->tc_depth - 1, args);
+}
+
 static int
 btr_tx_delete(struct btr_context *tcx, void *args)
 {
@@ -3504,6 +4041,230 @@ delete:
 	return rc;
 }
 
+/**
+ * Find the highest level of the current trace, whose subtree starts from the
+ * traced record and ends before \a key (or anywhere if \a key is NULL), so the
+ * whole subtree can be dropped. Return -1 if there is no such subtree.
+ */
+static int
+btr_range_subtree(struct btr_context *tcx, d_iov_t *key, char *hkey)
+{
+	struct btr_trace	*trace;
+	struct btr_node		*nd;
+	umem_off_t		 nd_off;
+	int			 level;
+	int			 found = -1;
+	int			 cmp;
+
+	/* availability check is done for the probed record only */
+	if (btr_ops(tcx)->to_check_availability != NULL)
+		return -1;
+
+	for (level = tcx->tc_depth - 1; level >= 0; level--) {
+		trace = &tcx->tc_trace.ti_trace[level];
+		if (trace->tr_at != 0)
+			break;
+
+		if (key != NULL) {
+			/* the last record of the subtree is in its rightmost leaf */
+			for (nd_off = trace->tr_node; !btr_node_is_leaf(tcx, nd_off);) {
+				nd	= btr_off2ptr(tcx, nd_off);
+				nd_off	= btr_node_child_at(tcx, nd_off, nd->tn_keyn);
+			}
+			nd  = btr_off2ptr(tcx, nd_off);
+			cmp = btr_cmp_key(tcx, nd_off, nd->tn_keyn - 1, hkey, key);
+			if (cmp & (BTR_CMP_GT | BTR_CMP_ERR))
+				break;
+		}
+		found = level;
+	}
+	return found;
+}
+
+/**
+ * Free all records under the node traced by \a level, then delete the node
+ * from its parent.
+ */
+static int
+btr_range_drop(struct btr_context *tcx, int level, void *args)
+{
+	struct btr_trace	*trace = &tcx->tc_trace.ti_trace[level];
+	struct btr_trace	*anc_tr;
+	struct btr_node		*nd;
+	umem_off_t		 nd_off;
+	int			 rc;
+	int			 i;
+
+	D_DEBUG(DB_TRACE, "Drop subtree "DF_X64" at level %d\n", trace->tr_node, level);
+	if (level == 0)
+		return btr_root_del_rec_last(tcx, trace, args);
+
+	/* Direct key of a parent record refers to the first leaf of the child
+	 * subtree. If the dropped subtree is the leftmost child of its parent,
+	 * its first leaf is referred by an upper ancestor, which should refer
+	 * to the first leaf of the next subtree instead.
+	 */
+	if (btr_is_direct_key(tcx) && trace[-1].tr_at == 0) {
+		for (anc_tr = trace - 2; anc_tr >= tcx->tc_trace.ti_trace; anc_tr--) {
+			if (anc_tr->tr_at != 0)
+				break;
+		}
+
+		if (anc_tr >= tcx->tc_trace.ti_trace) {
+			nd_off = btr_node_child_at(tcx, trace[-1].tr_node, 1);
+			while (!btr_node_is_leaf(tcx, nd_off))
+				nd_off = btr_node_child_at(tcx, nd_off, 0);
+
+			if (btr_has_tx(tcx)) {
+				rc = btr_node_tx_add(tcx, anc_tr->tr_node);
+				if (rc != 0)
+					return rc;
+			}
+			btr_node_rec_at(tcx, anc_tr->tr_node, anc_tr->tr_at - 1)->rec_node[0] = nd_off;
+		}
+	}
+
+	/* the node itself is freed by btr_node_del_child_only() */
+	nd = btr_off2ptr(tcx, trace->tr_node);
+	if (btr_node_is_leaf(tcx, trace->tr_node)) {
+		for (i = nd->tn_keyn - 1; i >= 0; i--) {
+			rc = btr_rec_free(tcx, btr_node_rec_at(tcx, trace->tr_node, i), args);
+			if (rc != 0)
+				return rc;
+		}
+	} else {
+		for (i = nd->tn_keyn; i >= 0; i--) {
+			rc = btr_node_destroy(tcx, btr_node_child_at(tcx, trace->tr_node, i),
+					      args, NULL);
+			if (rc != 0)
+				return rc;
+		}
+	}
+
+	return btr_delete_at(tcx, level - 1, args);
+}
+
+static int
+btr_delete_range(struct btr_context *tcx, d_iov_t *key_lo, d_iov_t *key_hi, void *args)
+{
+	struct btr_trace	*trace;
+	char			 hkey_lo[DAOS_HKEY_MAX];
+	char			 hkey_hi[DAOS_HKEY_MAX];
+	int			 level;
+	int			 cmp;
+	int			 rc;
+
+	if (key_lo != NULL)
+		btr_hkey_gen(tcx, key_lo, hkey_lo);
+	if (key_hi != NULL)
+		btr_hkey_gen(tcx, key_hi, hkey_hi);
+
+	while (1) {
+		if (key_lo != NULL)
+			rc = btr_probe(tcx, BTR_PROBE_GE, DAOS_INTENT_KILL, key_lo, hkey_lo);
+		else
+			rc = btr_probe(tcx, BTR_PROBE_FIRST, DAOS_INTENT_KILL, NULL, NULL);
+
+		switch (rc) {
+		case PROBE_RC_OK:
+			break;
+		case PROBE_RC_NONE:
+			D_GOTO(out, rc = 0);
+		case PROBE_RC_INPROGRESS:
+			D_DEBUG(DB_TRACE, "Target is in some uncommitted DTX.\n");
+			D_GOTO(out, rc = -DER_INPROGRESS);
+		case PROBE_RC_DATA_LOSS:
+			D_DEBUG(DB_TRACE, "Delete hit some corrupted transaction.\n");
+			D_GOTO(out, rc = -DER_DATA_LOSS);
+		default:
+			D_GOTO(out, rc = -DER_INVAL);
+		}
+
+		if (btr_has_embedded_value(tcx)) {
+			if (key_hi != NULL) {
+				tcx->tc_record.rec_off = tcx->tc_tins.ti_root->tr_node;
+				cmp = btr_key_cmp(tcx, &tcx->tc_record, key_hi);
+				if (cmp & BTR_CMP_GT)
+					D_GOTO(out, rc = 0);
+			}
+			rc = btr_delete(tcx, args);
+			if (rc != 0)
+				goto out;
+			continue;
+		}
+
+		if (key_hi != NULL) {
+			trace = &tcx->tc_trace.ti_trace[tcx->tc_depth - 1];
+			cmp = btr_cmp_key(tcx, trace->tr_node, trace->tr_at, hkey_hi, key_hi);
+			if (cmp == BTR_CMP_ERR)
+				D_GOTO(out, rc = -DER_INVAL);
+			if (cmp & BTR_CMP_GT)
+				D_GOTO(out, rc = 0);
+		}
+
+		level = btr_range_subtree(tcx, key_hi, hkey_hi);
+		if (level < 0)
+			rc = btr_delete(tcx, args);
+		else
+			rc = btr_range_drop(tcx, level, args);
+		if (rc != 0)
+			goto out;
+	}
+out:
+	tcx->tc_probe_rc = PROBE_RC_UNKNOWN;
+	return rc;
+}
+
+/**
+ * Delete all records with keys in the range [\a key_lo, \a key_hi], which is
+ * in the order of the tree, i.e. the order of iteration.
+ *
+ * Instead of deleting records one by one, a subtree fully covered by the range
+ * is dropped as a whole, records in it are released by btr_ops_t::to_rec_free
+ * without probing or rebalancing for each of them. So the cost of rebalancing
+ * is proportional to the tree height rather than the number of records.
+ * All records are deleted in one transaction.
+ *
+ * \param[in] toh	Tree open handle.
+ * \param[in] key_lo	The first key of the range, NULL for the first
+ *			record of the tree.
+ * \param[in] key_hi	The last key of the range, NULL for the last record
+ *			of the tree.
+ * \param[in] args	Optional: user parameter for btr_ops_t::to_rec_free
+ *
+ * \return		0	success
+ *			-ve	error code
+ */
+int
+dbtree_delete_range(daos_handle_t toh, d_iov_t *key_lo, d_iov_t *key_hi, void *args)
+{
+	struct btr_context *tcx;
+	int		    rc;
+
+	tcx = btr_hdl2tcx(toh);
+	if (tcx == NULL)
+		return -DER_NO_HDL;
+
+	if (key_lo != NULL) {
+		rc = btr_verify_key(tcx, key_lo);
+		if (rc)
+			return rc;
+	}
+	if (key_hi != NULL) {
+		rc = btr_verify_key(tcx, key_hi);
+		if (rc)
+			return rc;
+	}
+
+	rc = btr_tx_begin(tcx);
+	if (rc != 0)
+		return rc;
+
+	rc = btr_delete_range(tcx, key_lo, key_hi, args);
+
+	return btr_tx_end(tcx, rc);
+}
+
 /** gather statistics from a tree node and all its children recursively. */
 static void
 btr_node_stat(struct btr_context *tcx, umem_off_t nd_off,
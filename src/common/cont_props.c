@@ -80,6 +80,12 @@ daos_props_2cont_props(daos_prop_t *props, struct cont_props *cont_prop)
 	/** object version */
 	if (daos_prop_entry_get(props, DAOS_PROP_CO_OBJ_VERSION) != NULL)
 		cont_prop->dcp_obj_version = daos_cont_prop2obj_version(props);
+
+	/** QoS limits */
+	if (daos_prop_entry_get(props, DAOS_PROP_CO_QOS_IOPS) != NULL)
+		cont_prop->dcp_qos_iops = daos_cont_prop2qos_iops(props);
+	if (daos_prop_entry_get(props, DAOS_PROP_CO_QOS_BW) != NULL)
+		cont_prop->dcp_qos_bw = daos_cont_prop2qos_bw(props);
 }
 
 uint16_t
@@ -294,6 +300,24 @@ daos_cont_prop2obj_version(daos_prop_t *props)
 	return prop == NULL ? 0 : (uint32_t)prop->dpe_val;
 }
 
+uint64_t
+daos_cont_prop2qos_iops(daos_prop_t *props)
+{
+	struct daos_prop_entry *prop =
+		daos_prop_entry_get(props, DAOS_PROP_CO_QOS_IOPS);
+
+	return prop == NULL ? DAOS_PROP_CO_QOS_IOPS_DEFAULT : prop->dpe_val;
+}
+
+uint64_t
+daos_cont_prop2qos_bw(daos_prop_t *props)
+{
+	struct daos_prop_entry *prop =
+		daos_prop_entry_get(props, DAOS_PROP_CO_QOS_BW);
+
+	return prop == NULL ? DAOS_PROP_CO_QOS_BW_DEFAULT : prop->dpe_val;
+}
+
 /** Convert the redun_fac to number of allowed failures */
 int
 daos_cont_rf2allowedfailures(int rf)
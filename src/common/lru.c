@@ -83,6 +83,278 @@ static d_hash_table_ops_t lru_ops = {
 	.hop_rec_free		= lru_hop_rec_free,
 };
 
+/*
+ * CLOCK mode: refs live in an open-addressing table with linear probing, the
+ * table is kept at most 3/4 full. Unused refs stay in their slots, a hit sets
+ * the referenced bit, and the hand sweeps the slots to reclaim unused refs
+ * without the bit when the cache is over its size.
+ */
+#define LRU_CLOCK_SLOTS_MIN	16
+
+static int
+lru_clock_init(struct daos_lru_cache *lcache, int bits)
+{
+	uint32_t	nr = LRU_CLOCK_SLOTS_MIN;
+
+	/* twice of the cache size to keep probe sequences short */
+	while (bits >= 0 && nr < (2U << bits))
+		nr <<= 1;
+
+	D_ALLOC_ARRAY(lcache->dlc_slots, nr);
+	if (lcache->dlc_slots == NULL)
+		return -DER_NOMEM;
+
+	lcache->dlc_slots_mask = nr - 1;
+	return 0;
+}
+
+static void
+lru_clock_fini(struct daos_lru_cache *lcache)
+{
+	struct daos_llink	*llink;
+	uint32_t		 i;
+
+	for (i = 0; i <= lcache->dlc_slots_mask; i++) {
+		llink = lcache->dlc_slots[i];
+		if (llink != NULL)
+			llink->ll_ops->lop_free_ref(llink);
+	}
+	D_FREE(lcache->dlc_slots);
+}
+
+static struct daos_llink *
+lru_clock_find(struct daos_lru_cache *lcache, uint32_t hash, void *key,
+	       unsigned int key_size)
+{
+	struct daos_llink	*llink;
+	uint32_t		 i;
+
+	for (i = hash & lcache->dlc_slots_mask; (llink = lcache->dlc_slots[i]) != NULL;
+	     i = (i + 1) & lcache->dlc_slots_mask) {
+		if (llink->ll_hash == hash && !llink->ll_evicted &&
+		    llink->ll_ops->lop_cmp_keys(key, key_size, llink))
+			return llink;
+	}
+	return NULL;
+}
+
+static void
+lru_clock_place(struct daos_lru_cache *lcache, struct daos_llink *llink)
+{
+	uint32_t	i;
+
+	for (i = llink->ll_hash & lcache->dlc_slots_mask; lcache->dlc_slots[i] != NULL;
+	     i = (i + 1) & lcache->dlc_slots_mask)
+		;
+	lcache->dlc_slots[i] = llink;
+	llink->ll_slot = i;
+}
+
+static int
+lru_clock_grow(struct daos_lru_cache *lcache)
+{
+	struct daos_llink	**old = lcache->dlc_slots;
+	uint32_t		  nr = lcache->dlc_slots_mask + 1;
+	uint32_t		  i;
+
+	D_ALLOC_ARRAY(lcache->dlc_slots, nr * 2);
+	if (lcache->dlc_slots == NULL) {
+		lcache->dlc_slots = old;
+		return -DER_NOMEM;
+	}
+
+	lcache->dlc_slots_mask = nr * 2 - 1;
+	lcache->dlc_hand = 0;
+	for (i = 0; i < nr; i++) {
+		if (old[i] != NULL)
+			lru_clock_place(lcache, old[i]);
+	}
+	D_FREE(old);
+	return 0;
+}
+
+static int
+lru_clock_insert(struct daos_lru_cache *lcache, struct daos_llink *llink)
+{
+	int	rc;
+
+	/* busy refs can push the count over the cache size, grow on demand */
+	if ((lcache->dlc_count + 1) * 4 > (lcache->dlc_slots_mask + 1) * 3) {
+		rc = lru_clock_grow(lcache);
+		if (rc)
+			return rc;
+	}
+
+	lru_clock_place(lcache, llink);
+	lcache->dlc_count++;
+	return 0;
+}
+
+/** Remove the unused ref from its slot and free it */
+static void
+lru_clock_del(struct daos_lru_cache *lcache, struct daos_llink *llink)
+{
+	struct daos_llink	**slots = lcache->dlc_slots;
+	uint32_t		  mask = lcache->dlc_slots_mask;
+	uint32_t		  i = llink->ll_slot;
+	uint32_t		  j = i;
+	uint32_t		  k;
+
+	D_ASSERT(llink->ll_ref == 1);
+	D_ASSERT(lcache->dlc_count > 0);
+	D_ASSERT(slots[i] == llink);
+
+	/* backward shift deletion, no tombstone is left for lookup */
+	slots[i] = NULL;
+	for (;;) {
+		j = (j + 1) & mask;
+		if (slots[j] == NULL)
+			break;
+
+		k = slots[j]->ll_hash & mask;
+		/* stay if the home slot is cyclically in (i, j] */
+		if (i <= j ? (i < k && k <= j) : (i < k || k <= j))
+			continue;
+
+		slots[i] = slots[j];
+		slots[i]->ll_slot = i;
+		slots[j] = NULL;
+		i = j;
+	}
+	lcache->dlc_count--;
+	llink->ll_ops->lop_free_ref(llink);
+}
+
+static void
+lru_clock_sweep(struct daos_lru_cache *lcache)
+{
+	struct daos_llink	*llink;
+	uint32_t		 moves = 0;
+
+	while (lcache->dlc_count >= lcache->dlc_csize && lcache->dlc_idle > 0) {
+		llink = lcache->dlc_slots[lcache->dlc_hand];
+		if (llink != NULL && llink->ll_ref == 1 && !llink->ll_clock_ref) {
+			/* the hand stays, the slot may be refilled by backward shift */
+			lcache->dlc_idle--;
+			lru_clock_del(lcache, llink);
+			continue;
+		}
+
+		/* two rounds clear all referenced bits, stop if everything is busy */
+		if (++moves > 2 * (lcache->dlc_slots_mask + 1))
+			break;
+		if (llink != NULL && llink->ll_ref == 1)
+			llink->ll_clock_ref = 0;
+		lcache->dlc_hand = (lcache->dlc_hand + 1) & lcache->dlc_slots_mask;
+	}
+}
+
+static int
+lru_clock_hold(struct daos_lru_cache *lcache, void *key, unsigned int key_size,
+	       void *create_args, struct daos_llink **llink_pp)
+{
+	struct daos_llink	*llink;
+	struct daos_llink	*tmp;
+	uint32_t		 hash;
+	int			 rc;
+
+	hash  = d_hash_string_u32(key, key_size);
+	llink = lru_clock_find(lcache, hash, key, key_size);
+	if (llink != NULL) {
+		lcache->dlc_hits++;
+		goto found;
+	}
+
+	lcache->dlc_misses++;
+	if (create_args == NULL)
+		return -DER_NONEXIST;
+
+	rc = lcache->dlc_ops->lop_alloc_ref(key, key_size, create_args, &llink);
+	if (rc)
+		return rc;
+
+	/* allocation may yield, somebody else could have inserted the key */
+	tmp = lru_clock_find(lcache, hash, key, key_size);
+	if (tmp != NULL) {
+		lcache->dlc_ops->lop_free_ref(llink);
+		llink = tmp;
+		goto found;
+	}
+
+	D_DEBUG(DB_TRACE, "Inserting %p item into LRU CLOCK table\n", llink);
+	llink->ll_evicted   = 0;
+	llink->ll_clock_ref = 1;
+	llink->ll_ref	    = 2; /* 1 for caller, 1 for cache */
+	llink->ll_hash	    = hash;
+	llink->ll_ops	    = lcache->dlc_ops;
+	D_INIT_LIST_HEAD(&llink->ll_qlink);
+
+	rc = lru_clock_insert(lcache, llink);
+	if (rc) {
+		lcache->dlc_ops->lop_free_ref(llink);
+		return rc;
+	}
+	*llink_pp = llink;
+	return 0;
+found:
+	D_ASSERT(llink->ll_evicted == 0);
+	if (llink->ll_ref == 1)
+		lcache->dlc_idle--;
+	llink->ll_ref++;
+	llink->ll_clock_ref = 1;
+	*llink_pp = llink;
+	return 0;
+}
+
+static void
+lru_clock_release(struct daos_lru_cache *lcache, struct daos_llink *llink)
+{
+	lru_hop_rec_decref(NULL, &llink->ll_link);
+
+	if (llink->ll_ref == 1) { /* the last refcount */
+		/* zero-sized cache always evicts unused item */
+		if (lcache->dlc_csize == 0 || llink->ll_evicted)
+			lru_clock_del(lcache, llink);
+		else
+			lcache->dlc_idle++;
+	}
+	lru_clock_sweep(lcache);
+}
+
+static void
+lru_clock_evict(struct daos_lru_cache *lcache, daos_lru_cond_cb_t cond, void *arg)
+{
+	struct daos_llink	*llink;
+	struct daos_llink	*tmp;
+	unsigned int		 count = 0;
+	uint32_t		 i;
+	d_list_t		 list;
+
+	/* collect first, deletion shifts the slots */
+	D_INIT_LIST_HEAD(&list);
+	for (i = 0; i <= lcache->dlc_slots_mask; i++) {
+		llink = lcache->dlc_slots[i];
+		if (llink == NULL)
+			continue;
+
+		if (llink->ll_evicted || cond == NULL || cond(llink, arg)) {
+			llink->ll_evicted = 1;
+			if (llink->ll_ref == 1)
+				d_list_move(&llink->ll_qlink, &list);
+		}
+	}
+
+	d_list_for_each_entry_safe(llink, tmp, &list, ll_qlink) {
+		d_list_del_init(&llink->ll_qlink);
+		D_DEBUG(DB_TRACE, "Remove %p from LRU cache\n", llink);
+		lcache->dlc_idle--;
+		lru_clock_del(lcache, llink);
+		count++;
+	}
+	D_DEBUG(DB_TRACE, "Evicted %u items, total count %u of %u\n",
+		count, lcache->dlc_count, lcache->dlc_csize);
+}
+
 int
 daos_lru_cache_create(int bits, uint32_t feats,
 		      struct daos_llink_ops *ops,
@@ -107,13 +379,21 @@ daos_lru_cache_create(int bits, uint32_t feats,
 		D_GOTO(out, rc = -DER_INVAL);
 	}
 
+	if ((feats & DAOS_LRU_FT_CLOCK) && !(feats & D_HASH_FT_NOLOCK)) {
+		D_ERROR("DAOS_LRU_FT_CLOCK requires D_HASH_FT_NOLOCK\n");
+		D_GOTO(out, rc = -DER_INVAL);
+	}
+
 	D_ALLOC_PTR(lcache);
 	if (lcache == NULL)
 		D_GOTO(out, rc = -DER_NOMEM);
 
-	rc = d_hash_table_create_inplace(feats | D_HASH_FT_LRU,
-					 (uint32_t)max_t(int, 4, bits - 3),
-					 NULL, &lru_ops, &lcache->dlc_htable);
+	if (feats & DAOS_LRU_FT_CLOCK)
+		rc = lru_clock_init(lcache, bits);
+	else
+		rc = d_hash_table_create_inplace(feats | D_HASH_FT_LRU,
+						 (uint32_t)max_t(int, 4, bits - 3),
+						 NULL, &lru_ops, &lcache->dlc_htable);
 	if (rc)
 		D_GOTO(out, rc);
 
@@ -139,9 +419,14 @@ daos_lru_cache_destroy(struct daos_lru_cache *lcache)
 	if (lcache == NULL)
 		return;
 
-	D_DEBUG(DB_TRACE, "Destroying LRU cache\n");
-	d_hash_table_debug(&lcache->dlc_htable);
-	d_hash_table_destroy_inplace(&lcache->dlc_htable, true);
+	D_DEBUG(DB_TRACE, "Destroying LRU cache, hits "DF_U64", misses "DF_U64"\n",
+		lcache->dlc_hits, lcache->dlc_misses);
+	if (daos_lru_is_clock(lcache)) {
+		lru_clock_fini(lcache);
+	} else {
+		d_hash_table_debug(&lcache->dlc_htable);
+		d_hash_table_destroy_inplace(&lcache->dlc_htable, true);
+	}
 	D_FREE(lcache);
 }
 
@@ -188,6 +473,11 @@ daos_lru_cache_evict(struct daos_lru_cache *lcache,
 	unsigned int		 count = 0;
 	int			 rc;
 
+	if (daos_lru_is_clock(lcache)) {
+		lru_clock_evict(lcache, cond, arg);
+		return;
+	}
+
 	D_INIT_LIST_HEAD(&cb_arg.list);
 	rc = d_hash_table_traverse(&lcache->dlc_htable, lru_evict_cb, &cb_arg);
 	D_ASSERT(rc == 0);
@@ -216,9 +506,14 @@ daos_lru_ref_hold(struct daos_lru_cache *lcache, void *key,
 	if (lcache->dlc_ops->lop_print_key)
 		lcache->dlc_ops->lop_print_key(key, key_size);
 
+	if (daos_lru_is_clock(lcache))
+		return lru_clock_hold(lcache, key, key_size, create_args, llink_pp);
+
 lookup_again:
 	link = d_hash_rec_find(&lcache->dlc_htable, key, key_size);
 	if (link != NULL) {
+		if (!retried)
+			lcache->dlc_hits++;
 		llink = link2llink(link);
 		D_ASSERT(llink->ll_evicted == 0);
 		/* remove busy item from LRU */
@@ -227,6 +522,8 @@ lookup_again:
 		D_GOTO(found, rc = 0);
 	}
 
+	if (!retried)
+		lcache->dlc_misses++;
 	if (create_args == NULL)
 		D_GOTO(out, rc = -DER_NONEXIST);
 
@@ -267,6 +564,11 @@ daos_lru_ref_release(struct daos_lru_cache *lcache, struct daos_llink *llink)
 		  "May hit corrupted item in LRU cache %p: llink %p, refs %d, prev %p, next %p\n",
 		  lcache, llink, llink->ll_ref, llink->ll_qlink.prev, llink->ll_qlink.next);
 
+	if (daos_lru_is_clock(lcache)) {
+		lru_clock_release(lcache, llink);
+		return;
+	}
+
 	lru_hop_rec_decref(&lcache->dlc_htable, &llink->ll_link);
 
 	if (llink->ll_ref == 1) { /* the last refcount */
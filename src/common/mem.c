@@ -2147,6 +2147,8 @@ struct umem_page_info {
 	uint64_t pi_last_checkpoint;
 	/** Highest transaction ID of writes to the page */
 	uint64_t pi_last_inflight;
+	/** Lower bound of the transaction IDs of writes not yet durable on MD-blob, 0 if none */
+	uint64_t pi_first_inflight;
 	/** link to global LRU lists, or global free page list, or global pinned list */
 	d_list_t pi_lru_link;
 	/** link to global dirty page list, or wait commit list, or temporary list for flushing */
@@ -2507,6 +2509,7 @@ cache_unmap_page(struct umem_cache *cache, struct umem_page_info *pinfo)
 	pinfo->pi_mapped = 0;
 	pinfo->pi_loaded = 0;
 	pinfo->pi_last_inflight                  = 0;
+	pinfo->pi_first_inflight                 = 0;
 	pinfo->pi_last_checkpoint                = 0;
 	cache->ca_pages[pinfo->pi_pg_id].pg_info = NULL;
 
@@ -2648,6 +2651,25 @@ is_page_dirty(struct umem_page_info *pinfo)
 	return (pinfo->pi_last_inflight != pinfo->pi_last_checkpoint);
 }
 
+/* Lower one of two transaction IDs, 0 stands for none */
+static inline uint64_t
+wal_id_min(struct umem_store *store, uint64_t id_a, uint64_t id_b)
+{
+	if (id_a == 0)
+		return id_b;
+	if (id_b == 0 || store->stor_ops->so_wal_id_cmp(store, id_a, id_b) < 0)
+		return id_a;
+	return id_b;
+}
+
+/* Account a page dirtied outside of the running checkpoint */
+static inline void
+cache_track_inflight(struct umem_cache *cache, uint64_t tx_id)
+{
+	cache->ca_chkpt_min_inflight = wal_id_min(cache->ca_store, tx_id,
+						  cache->ca_chkpt_min_inflight);
+}
+
 static inline void
 touch_page(struct umem_store *store, struct umem_page_info *pinfo, uint64_t wr_tx,
 	   umem_off_t first_byte, umem_off_t last_byte)
@@ -2675,6 +2697,10 @@ touch_page(struct umem_store *store, struct umem_page_info *pinfo, uint64_t wr_t
 
 	D_ASSERT(pinfo->pi_loaded == 1);
 	pinfo->pi_last_inflight = wr_tx;
+	if (pinfo->pi_first_inflight == 0) {
+		pinfo->pi_first_inflight = wr_tx;
+		cache_track_inflight(cache, wr_tx);
+	}
 
 	/* Don't change the pi_dirty_link while the page is being flushed */
 	if (!d_list_empty(&pinfo->pi_flush_link))
@@ -2740,6 +2766,8 @@ umem_cache_touch(struct umem_store *store, uint64_t wr_tx, umem_off_t addr, daos
 #define MAX_IO_SIZE       (8 * 1024 * 1024)
 /** Maximum number of pages that can be in one set */
 #define MAX_PAGES_PER_SET 10
+/** Number of pages flushed by a checkpoint before the WAL is reclaimed */
+#define CHKPT_BATCH_PAGES (MAX_INFLIGHT_SETS * MAX_PAGES_PER_SET)
 /** Maximum number of ranges that can be in one page */
 #define MAX_IOD_PER_PAGE  ((UMEM_CACHE_BMAP_SZ_MAX << UMEM_CHUNK_IDX_SHIFT) / 2)
 /** Maximum number of IODs a set can handle */
@@ -2858,7 +2886,7 @@ chkpt_insert_sorted(struct umem_store *store, struct umem_checkpoint_data *chkpt
 }
 
 static void
-page_flush_completion(struct umem_cache *cache, struct umem_page_info *pinfo)
+page_flush_completion(struct umem_cache *cache, struct umem_page_info *pinfo, int rc)
 {
 	D_ASSERT(d_list_empty(&pinfo->pi_dirty_link));
 	D_ASSERT(pinfo->pi_io == 1);
@@ -2866,17 +2894,181 @@ page_flush_completion(struct umem_cache *cache, struct umem_page_info *pinfo)
 	D_ASSERT(!d_list_empty(&pinfo->pi_flush_link));
 	d_list_del_init(&pinfo->pi_flush_link);
 
-	if (is_page_dirty(pinfo))
+	/*
+	 * Writes issued while the page was being flushed all have IDs above the checkpointed
+	 * one, use it as a conservative lower bound for them.
+	 */
+	if (rc == 0)
+		pinfo->pi_first_inflight = is_page_dirty(pinfo) ? pinfo->pi_last_checkpoint : 0;
+
+	if (is_page_dirty(pinfo)) {
 		d_list_add_tail(&pinfo->pi_dirty_link, &cache->ca_pgs_dirty);
+		cache_track_inflight(cache, pinfo->pi_first_inflight);
+	}
 
 	page_wakeup_io(cache, pinfo);
 }
 
+/* Checkpoint progress, used to report the durable transactions every CHKPT_BATCH_PAGES pages */
+struct chkpt_sorter {
+	struct umem_store	 *cs_store;
+	umem_cache_batch_cb_t	 *cs_batch_cb;
+	void			 *cs_arg;
+	/** Dirty pages, oldest first and in MD-blob offset order within a batch */
+	struct umem_page_info	**cs_pages;
+	/** Lowest pi_first_inflight of cs_pages[i] ~ cs_pages[cs_nr - 1], 0 if none */
+	uint64_t		 *cs_min_ids;
+	unsigned int		  cs_nr;
+	/** Start of the range being sorted */
+	unsigned int		  cs_off;
+	/** Pages submitted for flush, the ones after them in cs_pages are still dirty */
+	unsigned int		  cs_submitted;
+	/** Highest transaction ID of each page flushed in the current batch */
+	uint64_t		  cs_ids[CHKPT_BATCH_PAGES + MAX_PAGES_PER_SET];
+	unsigned int		  cs_ids_nr;
+	/** Dirty chunks flushed in the current batch */
+	uint64_t		  cs_dchunks;
+};
+
+static void
+chkpt_sort_swap(void *array, int a, int b)
+{
+	struct chkpt_sorter	 *sorter = array;
+	struct umem_page_info	**pages = &sorter->cs_pages[sorter->cs_off];
+	struct umem_page_info	 *tmp;
+
+	tmp      = pages[a];
+	pages[a] = pages[b];
+	pages[b] = tmp;
+}
+
+/** Oldest dirty page first */
+static int
+chkpt_age_cmp(void *array, int a, int b)
+{
+	struct chkpt_sorter	 *sorter = array;
+	struct umem_store	 *store = sorter->cs_store;
+	struct umem_page_info	**pages = &sorter->cs_pages[sorter->cs_off];
+
+	return store->stor_ops->so_wal_id_cmp(store, pages[a]->pi_first_inflight,
+					      pages[b]->pi_first_inflight);
+}
+
+/** MD-blob offset order */
+static int
+chkpt_lba_cmp(void *array, int a, int b)
+{
+	struct chkpt_sorter	 *sorter = array;
+	struct umem_page_info	**pages = &sorter->cs_pages[sorter->cs_off];
+	uint32_t		  pg_a = pages[a]->pi_pg_id;
+	uint32_t		  pg_b = pages[b]->pi_pg_id;
+
+	if (pg_a > pg_b)
+		return 1;
+	if (pg_a < pg_b)
+		return -1;
+	return 0;
+}
+
+static daos_sort_ops_t chkpt_age_sort_ops = {
+	.so_swap	= chkpt_sort_swap,
+	.so_cmp		= chkpt_age_cmp,
+};
+
+static daos_sort_ops_t chkpt_lba_sort_ops = {
+	.so_swap	= chkpt_sort_swap,
+	.so_cmp		= chkpt_lba_cmp,
+};
+
+/*
+ * Reorder @dirty_list once for the whole checkpoint: oldest dirty pages first, so that the WAL
+ * tail covered by the flushed pages can be reclaimed every CHKPT_BATCH_PAGES pages, and in
+ * MD-blob offset order within each batch.
+ */
+static void
+chkpt_sort(struct chkpt_sorter *sorter, d_list_t *dirty_list)
+{
+	struct umem_page_info	*pinfo;
+	unsigned int		 i = 0;
+
+	d_list_for_each_entry(pinfo, dirty_list, pi_dirty_link) {
+		D_ASSERT(i < sorter->cs_nr);
+		sorter->cs_pages[i++] = pinfo;
+	}
+	D_ASSERT(i == sorter->cs_nr);
+
+	sorter->cs_off = 0;
+	if (sorter->cs_nr > CHKPT_BATCH_PAGES)
+		daos_array_sort(sorter, sorter->cs_nr, false, &chkpt_age_sort_ops);
+
+	for (i = 0; i < sorter->cs_nr; i += CHKPT_BATCH_PAGES) {
+		sorter->cs_off = i;
+		daos_array_sort(sorter, min(sorter->cs_nr - i, CHKPT_BATCH_PAGES), false,
+				&chkpt_lba_sort_ops);
+	}
+
+	sorter->cs_min_ids[sorter->cs_nr] = 0;
+	for (i = sorter->cs_nr; i > 0; i--) {
+		pinfo = sorter->cs_pages[i - 1];
+		d_list_move(&pinfo->pi_dirty_link, dirty_list);
+		sorter->cs_min_ids[i - 1] = wal_id_min(sorter->cs_store, pinfo->pi_first_inflight,
+						       sorter->cs_min_ids[i]);
+	}
+}
+
+/*
+ * Called when a set of pages is durable on MD-blob. Every CHKPT_BATCH_PAGES pages, report the
+ * highest transaction ID flushed by the batch that is below all the non-durable transactions,
+ * every transaction up to it is durable on MD-blob.
+ */
+static void
+chkpt_set_done(struct umem_cache *cache, struct chkpt_sorter *sorter,
+	       struct umem_checkpoint_data *chkpt_data, d_list_t *waiting_list, bool last)
+{
+	struct umem_store		*store = cache->ca_store;
+	struct umem_checkpoint_data	*inflight;
+	uint64_t			 min_id;
+	uint64_t			 durable_id = 0;
+	int				 i;
+
+	if (sorter == NULL || sorter->cs_batch_cb == NULL)
+		return;
+
+	for (i = 0; i < chkpt_data->cd_nr_pages; i++)
+		sorter->cs_ids[sorter->cs_ids_nr++] = chkpt_data->cd_pages[i]->pi_last_checkpoint;
+	sorter->cs_dchunks += chkpt_data->cd_nr_dchunks;
+
+	if (sorter->cs_ids_nr < CHKPT_BATCH_PAGES && !last)
+		return;
+
+	/* Pages not submitted yet, pages being flushed and pages dirtied since the start */
+	min_id = wal_id_min(store, sorter->cs_min_ids[sorter->cs_submitted],
+			    cache->ca_chkpt_min_inflight);
+	d_list_for_each_entry(inflight, waiting_list, cd_link) {
+		for (i = 0; i < inflight->cd_nr_pages; i++)
+			min_id = wal_id_min(store, inflight->cd_pages[i]->pi_first_inflight, min_id);
+	}
+
+	for (i = 0; i < sorter->cs_ids_nr; i++) {
+		if (min_id != 0 &&
+		    store->stor_ops->so_wal_id_cmp(store, sorter->cs_ids[i], min_id) >= 0)
+			continue;
+		if (durable_id == 0 ||
+		    store->stor_ops->so_wal_id_cmp(store, sorter->cs_ids[i], durable_id) > 0)
+			durable_id = sorter->cs_ids[i];
+	}
+
+	sorter->cs_batch_cb(sorter->cs_arg, durable_id,
+			    sorter->cs_dchunks << UMEM_CACHE_CHUNK_SZ_SHIFT);
+	sorter->cs_ids_nr  = 0;
+	sorter->cs_dchunks = 0;
+}
+
 static int
 cache_flush_pages(struct umem_cache *cache, d_list_t *dirty_list,
 		  struct umem_checkpoint_data *chkpt_data_all, int chkpt_nr,
 		  umem_cache_wait_cb_t wait_commit_cb, void *arg, uint64_t *chkpt_id,
-		  struct umem_cache_chkpt_stats *stats)
+		  struct umem_cache_chkpt_stats *stats, struct chkpt_sorter *sorter)
 {
 	struct umem_store		*store = cache->ca_store;
 	struct umem_checkpoint_data	*chkpt_data;
@@ -2946,8 +3138,8 @@ cache_flush_pages(struct umem_cache *cache, d_list_t *dirty_list,
 			rc = store->stor_ops->so_flush_prep(store, &chkpt_data->cd_store_iod,
 							    &chkpt_data->cd_fh);
 			if (rc != 0) {
-				/** Just put the pages back and break the loop */
-				for (i = 0; i < chkpt_data->cd_nr_pages; i++) {
+				/** Just put the pages back (in order) and break the loop */
+				for (i = chkpt_data->cd_nr_pages - 1; i >= 0; i--) {
 					pinfo             = chkpt_data->cd_pages[i];
 					pinfo->pi_copying = 0;
 					d_list_add(&pinfo->pi_dirty_link, dirty_list);
@@ -2961,6 +3153,8 @@ cache_flush_pages(struct umem_cache *cache, d_list_t *dirty_list,
 				pinfo                     = chkpt_data->cd_pages[i];
 				pinfo->pi_last_checkpoint = pinfo->pi_last_inflight;
 			}
+			if (sorter != NULL)
+				sorter->cs_submitted += chkpt_data->cd_nr_pages;
 
 			/*
 			 * DAV allocator uses valgrind macros to mark certain portions of
@@ -3024,7 +3218,7 @@ cache_flush_pages(struct umem_cache *cache, d_list_t *dirty_list,
 		rc = store->stor_ops->so_flush_post(chkpt_data->cd_fh, rc);
 		for (i = 0; i < chkpt_data->cd_nr_pages; i++) {
 			pinfo = chkpt_data->cd_pages[i];
-			page_flush_completion(cache, pinfo);
+			page_flush_completion(cache, pinfo, rc);
 		}
 		inflight--;
 
@@ -3042,18 +3236,23 @@ cache_flush_pages(struct umem_cache *cache, d_list_t *dirty_list,
 			break;
 		}
 
+		chkpt_set_done(cache, sorter, chkpt_data, &waiting_list,
+			       inflight == 0 && d_list_empty(dirty_list));
+
 	} while (inflight != 0 || !d_list_empty(dirty_list));
 
 	return rc;
 }
 
 int
-umem_cache_checkpoint(struct umem_store *store, umem_cache_wait_cb_t wait_cb, void *arg,
-		      uint64_t *out_id, struct umem_cache_chkpt_stats *stats)
+umem_cache_checkpoint(struct umem_store *store, umem_cache_wait_cb_t wait_cb,
+		      umem_cache_batch_cb_t batch_cb, void *arg, uint64_t *out_id,
+		      struct umem_cache_chkpt_stats *stats)
 {
 	struct umem_cache		*cache;
 	struct umem_page_info		*pinfo;
 	struct umem_checkpoint_data	*chkpt_data_all;
+	struct chkpt_sorter		 sorter = { 0 };
 	d_list_t			 dirty_list;
 	uint64_t			 chkpt_id = *out_id;
 	int				 rc = 0;
@@ -3074,13 +3273,35 @@ umem_cache_checkpoint(struct umem_store *store, umem_cache_wait_cb_t wait_cb, vo
 	D_INIT_LIST_HEAD(&dirty_list);
 	d_list_splice_init(&cache->ca_pgs_dirty, &dirty_list);
 
-	rc = cache_flush_pages(cache, &dirty_list, chkpt_data_all, MAX_INFLIGHT_SETS, wait_cb, arg,
-			       &chkpt_id, stats);
+	/* Track the pages being evicted and the pages dirtied while the checkpoint is running */
+	cache->ca_chkpt_min_inflight = 0;
+	d_list_for_each_entry(pinfo, &cache->ca_pgs_flushing, pi_flush_link)
+		cache_track_inflight(cache, pinfo->pi_first_inflight);
 
+	d_list_for_each_entry(pinfo, &dirty_list, pi_dirty_link)
+		sorter.cs_nr++;
+
+	sorter.cs_store    = store;
+	sorter.cs_batch_cb = batch_cb;
+	sorter.cs_arg      = arg;
+	D_ALLOC_ARRAY(sorter.cs_pages, sorter.cs_nr);
+	D_ALLOC_ARRAY(sorter.cs_min_ids, sorter.cs_nr + 1);
+	if (sorter.cs_pages == NULL || sorter.cs_min_ids == NULL) {
+		rc = -DER_NOMEM;
+		goto out;
+	}
+
+	/* Sort once, the flush pipeline then walks the list without draining between batches */
+	chkpt_sort(&sorter, &dirty_list);
+	rc = cache_flush_pages(cache, &dirty_list, chkpt_data_all, MAX_INFLIGHT_SETS, wait_cb, arg,
+			       &chkpt_id, stats, &sorter);
+out:
+	D_FREE(sorter.cs_min_ids);
+	D_FREE(sorter.cs_pages);
 	D_FREE(chkpt_data_all);
 	if (!d_list_empty(&dirty_list)) {
 		D_ASSERT(rc != 0);
-		d_list_move(&dirty_list, &cache->ca_pgs_dirty);
+		d_list_splice_init(&dirty_list, &cache->ca_pgs_dirty);
 	}
 wait:
 	/* Wait for the evicting pages (if any) with lower checkpoint id */
@@ -3232,7 +3453,7 @@ cache_flush_page(struct umem_cache *cache, struct umem_page_info *pinfo)
 	arg.wca_pinfo = pinfo;
 
 	rc = cache_flush_pages(cache, &dirty_list, chkpt_data_all, 1, wait_page_commit_cb, &arg,
-			       &chkpt_id, NULL);
+			       &chkpt_id, NULL, NULL);
 	D_FREE(chkpt_data_all);
 	D_ASSERT(d_list_empty(&dirty_list));
 	inc_cache_stats(cache, UMEM_CACHE_STATS_FLUSH);
@@ -3463,6 +3684,123 @@ retry:
 	return rc;
 }
 
+#define UMEM_PAGES_ON_STACK	16
+#define UMEM_LOAD_BATCH_SZ	(64UL << 20)
+
+/*
+ * Read-ahead all the missing pages (already mapped & pinned) in one vectored read, so
+ * the MD-blob reads for a batch of buckets are in flight concurrently rather than being
+ * issued one page after another. Pages being loaded by others are left to the caller.
+ */
+static int
+cache_load_pages(struct umem_cache *cache, uint32_t *pages, int page_nr)
+{
+	struct umem_store		*store = cache->ca_store;
+	struct umem_page_info		*pinfo_inline[UMEM_PAGES_ON_STACK];
+	struct umem_store_region	 rg_inline[UMEM_PAGES_ON_STACK];
+	d_iov_t				 iov_inline[UMEM_PAGES_ON_STACK];
+	struct umem_page_info		**pinfos = &pinfo_inline[0], *pinfo;
+	struct umem_store_region	*regions = &rg_inline[0];
+	d_iov_t				*iovs = &iov_inline[0];
+	struct umem_store_iod		 iod;
+	d_sg_list_t			 sgl;
+	uint64_t			 offset;
+	daos_size_t			 len;
+	int				 i, load_nr = 0, rc;
+
+	if (store->stor_ops->so_read == NULL)
+		return 0;
+
+	for (i = 0; i < page_nr; i++) {
+		pinfo = cache->ca_pages[pages[i]].pg_info;
+		D_ASSERT(pinfo != NULL);
+		if (pinfo->pi_loaded == 0 && pinfo->pi_io == 0)
+			load_nr++;
+	}
+
+	/* Single page load is handled by cache_load_page() */
+	if (load_nr < 2)
+		return 0;
+
+	if (load_nr > UMEM_PAGES_ON_STACK) {
+		D_ALLOC_ARRAY(pinfos, load_nr);
+		D_ALLOC_ARRAY(regions, load_nr);
+		D_ALLOC_ARRAY(iovs, load_nr);
+		if (pinfos == NULL || regions == NULL || iovs == NULL) {
+			rc = -DER_NOMEM;
+			goto out;
+		}
+	}
+
+	load_nr = 0;
+	for (i = 0; i < page_nr; i++) {
+		pinfo = cache->ca_pages[pages[i]].pg_info;
+		if (pinfo->pi_loaded == 1 || pinfo->pi_io == 1)
+			continue;
+
+		D_ASSERT(pinfo->pi_mapped == 1);
+		offset = cache_id2off(cache, pinfo->pi_pg_id);
+		D_ASSERT(offset < store->stor_size);
+		len = min(cache->ca_page_sz, store->stor_size - offset);
+		pinfo->pi_io = 1;
+
+		regions[load_nr].sr_addr = offset;
+		regions[load_nr].sr_size = len;
+		d_iov_set(&iovs[load_nr], (char *)pinfo->pi_addr, len);
+		pinfos[load_nr] = pinfo;
+		load_nr++;
+
+		if (DAOS_ON_VALGRIND)
+			VALGRIND_DISABLE_ADDR_ERROR_REPORTING_IN_RANGE((char *)pinfo->pi_addr, len);
+	}
+
+	/* Bound the DMA buffer consumed by one submission */
+	for (i = 0, rc = 0; i < load_nr && rc == 0; i += iod.io_nr) {
+		iod.io_nr = min(load_nr - i, UMEM_LOAD_BATCH_SZ / cache->ca_page_sz);
+		if (iod.io_nr == 0)
+			iod.io_nr = 1;
+		iod.io_regions = &regions[i];
+		sgl.sg_nr = iod.io_nr;
+		sgl.sg_nr_out = 0;
+		sgl.sg_iovs = &iovs[i];
+
+		rc = store->stor_ops->so_read(store, &iod, &sgl);
+		if (rc)
+			DL_ERROR(rc, "Read %d pages from MD blob failed.", iod.io_nr);
+	}
+
+	for (i = 0; i < load_nr; i++) {
+		pinfo = pinfos[i];
+		if (DAOS_ON_VALGRIND)
+			VALGRIND_ENABLE_ADDR_ERROR_REPORTING_IN_RANGE((char *)pinfo->pi_addr,
+								      iovs[i].iov_len);
+		pinfo->pi_io = 0;
+
+		if (rc == 0 && cache->ca_evtcb_fn) {
+			rc = cache->ca_evtcb_fn(UMEM_CACHE_EVENT_PGLOAD, cache->ca_fn_arg,
+						pinfo->pi_pg_id);
+			if (rc)
+				DL_ERROR(rc, "Pageload callback failed.");
+		}
+
+		if (rc == 0) {
+			pinfo->pi_loaded = 1;
+			/* Add to LRU when it's unpinned */
+			if (pinfo->pi_ref == 0)
+				cache_add2lru(cache, pinfo);
+			inc_cache_stats(cache, UMEM_CACHE_STATS_LOAD);
+		}
+		page_wakeup_io(cache, pinfo);
+	}
+out:
+	if (pinfos != &pinfo_inline[0]) {
+		D_FREE(pinfos);
+		D_FREE(regions);
+		D_FREE(iovs);
+	}
+	return rc;
+}
+
 static int
 cache_pin_pages(struct umem_cache *cache, uint32_t *pages, int page_nr, bool for_sys)
 {
@@ -3518,6 +3856,10 @@ next:
 			pinned++;
 	}
 
+	rc = cache_load_pages(cache, pages, page_nr);
+	if (rc)
+		goto error;
+
 	for (i = 0; i < page_nr; i++) {
 		pg_id = pages[i];
 		pinfo = cache->ca_pages[pg_id].pg_info;
@@ -3616,8 +3958,6 @@ error:
 	return rc;
 }
 
-#define UMEM_PAGES_ON_STACK	16
-
 void
 umem_cache_post_replay(struct umem_store *store)
 {
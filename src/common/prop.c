@@ -455,6 +455,19 @@ daos_prop_valid(daos_prop_t *prop, bool pool, bool input)
 				return false;
 			}
 			break;
+		case DAOS_PROP_PO_QOS_IOPS:
+		case DAOS_PROP_PO_QOS_BW:
+		case DAOS_PROP_CO_QOS_IOPS:
+		case DAOS_PROP_CO_QOS_BW:
+			/* accepting any number for QoS limits, 0 means unlimited */
+			break;
+		case DAOS_PROP_PO_QOS_SLO:
+			val = prop->dpp_entries[i].dpe_val;
+			if (val > UINT32_MAX) {
+				D_ERROR("invalid qos_slo "DF_U64".\n", val);
+				return false;
+			}
+			break;
 		/* container-only properties */
 		case DAOS_PROP_CO_LAYOUT_TYPE:
 			val = prop->dpp_entries[i].dpe_val;
@@ -768,6 +768,225 @@ ik_btr_batch_oper(void **state)
 	D_FREE(arr);
 }
 
+struct ik_bulk_arg {
+	unsigned int	ba_next;
+	unsigned int	ba_nr;
+	uint64_t	ba_key;
+	char		ba_val[16];
+};
+
+static int
+ik_bulk_next(void *arg, d_iov_t *key, d_iov_t *val)
+{
+	struct ik_bulk_arg *ba = arg;
+
+	if (ba->ba_next == ba->ba_nr)
+		return 1;
+
+	ba->ba_key = ++ba->ba_next;
+	sprintf(ba->ba_val, "%u", ba->ba_next);
+	d_iov_set(key, &ba->ba_key, sizeof(ba->ba_key));
+	d_iov_set(val, ba->ba_val, strlen(ba->ba_val) + 1);
+	return 0;
+}
+
+/**
+ * bulk load @key_nr sorted integer keys into an empty tree, then lookup
+ * all of them in random order and verify their values.
+ */
+static void
+ik_btr_bulk_load(void **state)
+{
+	struct ik_bulk_arg	 ba = {0};
+	unsigned int		*arr;
+	char			 buf[16];
+	double			 then;
+	double			 now;
+	int			 i;
+	int			 rc;
+
+	ba.ba_nr = atoi(tst_fn_val.optval);
+	if (ba.ba_nr == 0 || ba.ba_nr > (1U << 28)) {
+		D_PRINT("Invalid key number: %d\n", ba.ba_nr);
+		fail();
+	}
+
+	D_ALLOC_ARRAY(arr, ba.ba_nr);
+	if (arr == NULL) {
+		fail_msg("Array allocation failed");
+		return;
+	}
+
+	D_PRINT("Bulk load %u records.\n", ba.ba_nr);
+	then = dts_time_now();
+	rc = dbtree_bulk_load(ik_toh, ik_bulk_next, &ba);
+	if (rc != 0)
+		fail_msg("Failed to bulk load: %s\n", d_errstr(rc));
+	now = dts_time_now();
+	D_PRINT("bulk load = %10.2f/sec\n", ba.ba_nr / (now - then));
+
+	ik_btr_query(NULL);
+
+	ik_btr_gen_keys(arr, ba.ba_nr);
+	for (i = 0; i < ba.ba_nr; i++) {
+		d_iov_t		key_iov;
+		d_iov_t		val_iov;
+		uint64_t	key = arr[i];
+
+		d_iov_set(&key_iov, &key, sizeof(key));
+		d_iov_set(&val_iov, NULL, 0);
+		rc = dbtree_lookup(ik_toh, &key_iov, &val_iov);
+		if (rc != 0)
+			fail_msg("Failed to lookup "DF_U64"\n", key);
+
+		sprintf(buf, "%u", arr[i]);
+		if (strcmp(buf, val_iov.iov_buf) != 0)
+			fail_msg("Wrong value %s for key "DF_U64"\n",
+				 (char *)val_iov.iov_buf, key);
+	}
+	D_FREE(arr);
+}
+
+#define UPSERT_BATCH	1000
+/**
+ * upsert integer keys from 1 to @key_nr in sorted batches, then lookup all
+ * of them and verify their values.
+ */
+static void
+ik_btr_upsert_batch(void **state)
+{
+	d_iov_t		*key_iovs;
+	d_iov_t		*val_iovs;
+	uint64_t	*keys;
+	char		*vals;
+	char		 buf[16];
+	unsigned int	 key_nr;
+	int		 nr;
+	int		 i;
+	int		 j;
+	int		 rc;
+
+	key_nr = atoi(tst_fn_val.optval);
+	if (key_nr == 0 || key_nr > (1U << 28)) {
+		D_PRINT("Invalid key number: %d\n", key_nr);
+		fail();
+	}
+
+	D_ALLOC_ARRAY(key_iovs, UPSERT_BATCH);
+	D_ALLOC_ARRAY(val_iovs, UPSERT_BATCH);
+	D_ALLOC_ARRAY(keys, UPSERT_BATCH);
+	D_ALLOC_ARRAY(vals, UPSERT_BATCH * sizeof(buf));
+	if (key_iovs == NULL || val_iovs == NULL || keys == NULL || vals == NULL)
+		fail_msg("Array allocation failed");
+
+	D_PRINT("Batch upsert %u records.\n", key_nr);
+	for (i = 0; i < key_nr; i += nr) {
+		nr = min(key_nr - i, UPSERT_BATCH);
+		for (j = 0; j < nr; j++) {
+			keys[j] = i + j + 1;
+			sprintf(&vals[j * sizeof(buf)], DF_U64, keys[j]);
+			d_iov_set(&key_iovs[j], &keys[j], sizeof(keys[j]));
+			d_iov_set(&val_iovs[j], &vals[j * sizeof(buf)],
+				  strlen(&vals[j * sizeof(buf)]) + 1);
+		}
+
+		rc = dbtree_upsert_batch(ik_toh, key_iovs, val_iovs, nr);
+		if (rc != 0)
+			fail_msg("Failed to upsert batch: %s\n", d_errstr(rc));
+	}
+
+	ik_btr_query(NULL);
+
+	for (i = 0; i < key_nr; i++) {
+		d_iov_t		key_iov;
+		d_iov_t		val_iov;
+		uint64_t	key = i + 1;
+
+		d_iov_set(&key_iov, &key, sizeof(key));
+		d_iov_set(&val_iov, NULL, 0);
+		rc = dbtree_lookup(ik_toh, &key_iov, &val_iov);
+		if (rc != 0)
+			fail_msg("Failed to lookup "DF_U64"\n", key);
+
+		sprintf(buf, DF_U64, key);
+		if (strcmp(buf, val_iov.iov_buf) != 0)
+			fail_msg("Wrong value %s for key "DF_U64"\n",
+				 (char *)val_iov.iov_buf, key);
+	}
+
+	D_FREE(key_iovs);
+	D_FREE(val_iovs);
+	D_FREE(keys);
+	D_FREE(vals);
+}
+
+/**
+ * delete integer keys in the range of "lo:hi", either bound can be omitted,
+ * then verify no key in the range is left.
+ */
+static void
+ik_btr_delete_range(void **state)
+{
+	struct btr_stat	 stat;
+	daos_handle_t	 ih;
+	d_iov_t		 lo_iov;
+	d_iov_t		 hi_iov;
+	uint64_t	 lo = 0;
+	uint64_t	 hi = UINT64_MAX;
+	uint64_t	 rec_nr;
+	char		*str = tst_fn_val.optval;
+	char		*sep;
+	int		 rc;
+
+	sep = strchr(str, IK_SEP_VAL);
+	if (sep == NULL)
+		fail_msg("Invalid range %s\n", str);
+
+	if (sep != str)
+		lo = strtoul(str, NULL, 0);
+	if (sep[1] != '\0')
+		hi = strtoul(sep + 1, NULL, 0);
+	d_iov_set(&lo_iov, &lo, sizeof(lo));
+	d_iov_set(&hi_iov, &hi, sizeof(hi));
+
+	rc = dbtree_query(ik_toh, NULL, &stat);
+	if (rc != 0)
+		fail_msg("Failed to query btree: %d\n", rc);
+	rec_nr = stat.bs_rec_nr;
+
+	rc = dbtree_delete_range(ik_toh, sep != str ? &lo_iov : NULL,
+				 sep[1] != '\0' ? &hi_iov : NULL, NULL);
+	if (rc != 0)
+		fail_msg("Failed to delete range %s: %s\n", str, d_errstr(rc));
+
+	rc = dbtree_query(ik_toh, NULL, &stat);
+	if (rc != 0)
+		fail_msg("Failed to query btree: %d\n", rc);
+	D_PRINT("Deleted "DF_U64" records in range %s\n", rec_nr - stat.bs_rec_nr, str);
+
+	rc = dbtree_iter_prepare(ik_toh, BTR_ITER_EMBEDDED, &ih);
+	if (rc != 0)
+		fail_msg("Failed to initialize iterator: %d\n", rc);
+
+	rc = dbtree_iter_probe(ih, BTR_PROBE_FIRST, DAOS_INTENT_DEFAULT, NULL, NULL);
+	while (rc == 0) {
+		d_iov_t		key_iov;
+		uint64_t	key;
+
+		d_iov_set(&key_iov, &key, sizeof(key));
+		rc = dbtree_iter_fetch(ih, &key_iov, NULL, NULL);
+		if (rc != 0)
+			fail_msg("Failed to fetch: %d\n", rc);
+
+		if (key >= lo && key <= hi)
+			fail_msg("Key "DF_U64" in range %s is not deleted\n", key, str);
+		rc = dbtree_iter_next(ih);
+	}
+	if (rc != -DER_NONEXIST)
+		fail_msg("Failed to iterate: %d\n", rc);
+	dbtree_iter_finish(ih);
+}
+
 static void
 ik_btr_perf(void **state)
 {
@@ -945,10 +1164,13 @@ static struct option btr_ops[] = {
     {"iterate", required_argument, NULL, 'i'},
     {"batch", required_argument, NULL, 'b'},
     {"perf", required_argument, NULL, 'p'},
+    {"bulk", required_argument, NULL, 'l'},
+    {"upsert_batch", required_argument, NULL, 'x'},
+    {"del_range", required_argument, NULL, 'g'},
     {NULL, 0, NULL, 0},
 };
 
-#define BTR_SHORTOPTS "+S:R::M::C:Deocqu:f:d:r:qi:b:p:"
+#define BTR_SHORTOPTS "+S:R::M::C:Deocqu:f:d:r:qi:b:p:l:x:g:"
 
 /**
  * Execute test based on the given sequence of steps.
@@ -1024,6 +1246,15 @@ ts_group(void **state) {
 		case 'p':
 			ik_btr_perf(st);
 			break;
+		case 'l':
+			ik_btr_bulk_load(st);
+			break;
+		case 'x':
+			ik_btr_upsert_batch(st);
+			break;
+		case 'g':
+			ik_btr_delete_range(st);
+			break;
 		default:
 			fail_msg("Unsupported command %c\n", opt);
 		}
@@ -143,6 +143,24 @@ run_test()
         -R"${DYN}" -M"${PMEM}" -C "${UINT}${IPL}o:$ORDER" \
         -e -D
 
+        echo "B+tree bulk load test..."
+        eval "${VCMD}" "$BTR" \
+        --start-test "'btree bulk load ${test_conf_pre} ${test_conf}'" \
+        -R"${DYN}" -M"${PMEM}" -C "${UINT}${IPL}o:$ORDER" \
+        -l "$BAT_NUM"                               \
+        -D
+
+        echo "B+tree batch upsert and range delete test..."
+        eval "${VCMD}" "$BTR" \
+        --start-test "'btree range ${test_conf_pre} ${test_conf}'" \
+        -R"${DYN}" -M"${PMEM}" -C "${UINT}${IPL}o:$ORDER" \
+        -x "$BAT_NUM"                               \
+        -g "10:$((BAT_NUM / 2))"                    \
+        -g "$((BAT_NUM - 10)):"                     \
+        -q                                          \
+        -g ":"                                      \
+        -D
+
     else
         echo "B+tree performance test..."
         eval "${VCMD}" "$BTR" \
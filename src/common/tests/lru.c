@@ -107,16 +107,21 @@ main(int argc, char **argv)
 	uint64_t		*keys = NULL;
 	struct daos_llink	*link_ret[3] = {NULL};
 	struct daos_lru_cache	*tcache = NULL;
+	uint32_t		feats = D_HASH_FT_RWLOCK;
 
 	rc = daos_debug_init(DAOS_LOG_DEFAULT);
 	if (rc != 0)
 		return rc;
 
 	if (argc < 3) {
-		D_ERROR("<exec><size bits(^2)><num_keys>\n");
+		D_ERROR("<exec><size bits(^2)><num_keys>[clock]\n");
 		exit(-1);
 	}
 
+	/* CLOCK mode is lockless */
+	if (argc > 3 && strcmp(argv[3], "clock") == 0)
+		feats = D_HASH_FT_NOLOCK | DAOS_LRU_FT_CLOCK;
+
 	csize = strtol(argv[1], (char **)NULL, 10);
 	num_keys = strtol(argv[2], (char **)NULL, 10);
 
@@ -126,7 +131,7 @@ main(int argc, char **argv)
 		D_GOTO(exit, rc);
 	}
 
-	rc = daos_lru_cache_create(csize, D_HASH_FT_RWLOCK,
+	rc = daos_lru_cache_create(csize, feats,
 				   &uint_ref_llink_ops,
 				   &tcache);
 	if (rc)
@@ -181,6 +186,8 @@ main(int argc, char **argv)
 	daos_lru_ref_release(tcache, link_ret[1]);
 	D_PRINT("Completed ref release for key: %"PRIu64"\n",
 		keys[1]);
+	D_PRINT("Cache hits: "DF_U64", misses: "DF_U64"\n",
+		tcache->dlc_hits, tcache->dlc_misses);
 exit:
 	daos_lru_cache_destroy(tcache);
 	D_FREE(keys);
@@ -1,5 +1,6 @@
 /**
  * (C) Copyright 2019-2024 Intel Corporation.
+ * (C) Copyright 2026 Hewlett Packard Enterprise Development LP
  *
  * SPDX-License-Identifier: BSD-2-Clause-Patent
  */
@@ -452,14 +453,14 @@ test_page_cache(void **state)
 	touch_mem(arg, 3, 2 * UMEM_CACHE_PAGE_SZ + (UMEM_CACHE_CHUNK_SZ * 2) + 1,
 		  UMEM_CACHE_CHUNK_SZ * 80);
 
-	rc = umem_cache_checkpoint(&arg->ta_store, wait_cb, NULL, &id, NULL);
+	rc = umem_cache_checkpoint(&arg->ta_store, wait_cb, NULL, NULL, &id, NULL);
 	assert_rc_equal(rc, 0);
 	assert_int_equal(id, 3);
 	check_lists_empty(arg);
 
 	/** This should be a noop so set ta_nr to ridiculous value that will assert */
 	reset_arg(arg);
-	rc = umem_cache_checkpoint(&arg->ta_store, wait_cb, NULL, &id, NULL);
+	rc = umem_cache_checkpoint(&arg->ta_store, wait_cb, NULL, NULL, &id, NULL);
 	assert_rc_equal(rc, 0);
 	assert_int_equal(id, 3);
 
@@ -468,7 +469,7 @@ test_page_cache(void **state)
 
 	touch_mem(arg, 5, 80, 40);
 
-	rc = umem_cache_checkpoint(&arg->ta_store, wait_cb, NULL, &id, NULL);
+	rc = umem_cache_checkpoint(&arg->ta_store, wait_cb, NULL, NULL, &id, NULL);
 	assert_rc_equal(rc, 0);
 	assert_int_equal(id, 5);
 	check_lists_empty(arg);
@@ -514,7 +515,7 @@ test_many_pages(void **state)
 		touch_mem(arg, tx_id, offset + UMEM_CACHE_PAGE_SZ - 20, 10);
 	}
 
-	rc = umem_cache_checkpoint(&arg->ta_store, wait_cb, NULL, &id, NULL);
+	rc = umem_cache_checkpoint(&arg->ta_store, wait_cb, NULL, NULL, &id, NULL);
 	assert_rc_equal(rc, 0);
 	assert_int_equal(id, LARGE_NUM_PAGES + 1);
 	check_lists_empty(arg);
@@ -555,7 +556,7 @@ test_many_writes(void **state)
 		offset += UMEM_CACHE_CHUNK_SZ * 3 + 1;
 	}
 
-	rc = umem_cache_checkpoint(&arg->ta_store, wait_cb, NULL, &id, NULL);
+	rc = umem_cache_checkpoint(&arg->ta_store, wait_cb, NULL, NULL, &id, NULL);
 	assert_rc_equal(rc, 0);
 	assert_int_equal(id, tx_id - 1);
 	check_lists_empty(arg);
@@ -563,6 +564,65 @@ test_many_writes(void **state)
 	umem_cache_free(&arg->ta_store);
 }
 
+struct batch_arg {
+	uint64_t	ba_ids[LARGE_NUM_PAGES];
+	int		ba_nr;
+	uint64_t	ba_bytes;
+};
+
+static void
+batch_cb(void *arg, uint64_t durable_tx, uint64_t flushed_bytes)
+{
+	struct batch_arg *ba = arg;
+
+	assert_true(ba->ba_nr < LARGE_NUM_PAGES);
+	ba->ba_ids[ba->ba_nr++] = durable_tx;
+	ba->ba_bytes += flushed_bytes;
+}
+
+static void
+test_chkpt_batches(void **state)
+{
+	struct test_arg               *arg = *state;
+	struct umem_cache_chkpt_stats  stats = {0};
+	struct batch_arg               ba    = {0};
+	uint64_t                       id    = 0;
+	uint64_t                       offset;
+	uint64_t                       tx_id;
+	int                            rc;
+
+	arg->ta_store.stor_size = LARGE_CACHE_SIZE;
+	arg->ta_store.stor_ops  = &stor_ops;
+
+	/** In case prior test failed */
+	umem_cache_free(&arg->ta_store);
+
+	rc = umem_cache_alloc(&arg->ta_store, UMEM_CACHE_PAGE_SZ, LARGE_NUM_PAGES, 0, 0, 0,
+			      (void *)(UMEM_CACHE_PAGE_SZ), NULL, NULL, NULL);
+	assert_rc_equal(rc, 0);
+
+	/** The last page is the oldest dirty page, it should be flushed first */
+	reset_arg(arg);
+	tx_id = LARGE_NUM_PAGES;
+	for (offset = 0; offset < LARGE_CACHE_SIZE; offset += UMEM_CACHE_PAGE_SZ)
+		touch_mem(arg, tx_id--, offset, 10);
+
+	rc = umem_cache_checkpoint(&arg->ta_store, wait_cb, batch_cb, &ba, &id, &stats);
+	assert_rc_equal(rc, 0);
+	assert_int_equal(id, LARGE_NUM_PAGES);
+	check_lists_empty(arg);
+
+	/** WAL is reclaimable every 40 pages, up to the youngest page of each batch */
+	assert_int_equal(ba.ba_nr, 3);
+	assert_int_equal(ba.ba_ids[0], 40);
+	assert_int_equal(ba.ba_ids[1], 80);
+	assert_int_equal(ba.ba_ids[2], LARGE_NUM_PAGES);
+	assert_int_equal(stats.uccs_nr_pages, LARGE_NUM_PAGES);
+	assert_int_equal(ba.ba_bytes, stats.uccs_nr_dchunks * UMEM_CACHE_CHUNK_SZ);
+
+	umem_cache_free(&arg->ta_store);
+}
+
 static int
 waitqueue_create(void **wq)
 {
@@ -741,7 +801,7 @@ test_p2_evict(void **state)
 	umem_cache_unpin(&arg->ta_store, pin_hdl);
 	assert_int_equal(cache->ca_pgs_stats[UMEM_PG_STATS_PINNED], 0);
 
-	rc = umem_cache_checkpoint(&arg->ta_store, wait_cb, NULL, &id, NULL);
+	rc = umem_cache_checkpoint(&arg->ta_store, wait_cb, NULL, NULL, &id, NULL);
 	assert_rc_equal(rc, 0);
 	assert_int_equal(id, PAGE_NUM_MEM);
 	check_lists_empty(arg);
@@ -749,6 +809,90 @@ test_p2_evict(void **state)
 	umem_cache_free(&arg->ta_store);
 }
 
+static int	store_load_cnt;
+static int	store_read_cnt;
+
+static int
+store_load_cnt_fn(struct umem_store *store, char *start_addr, daos_off_t offset,
+		  daos_size_t len)
+{
+	store_load_cnt++;
+	return 0;
+}
+
+static int
+store_read_fn(struct umem_store *store, struct umem_store_iod *iod, d_sg_list_t *sgl)
+{
+	assert_int_equal(iod->io_nr, sgl->sg_nr);
+	store_read_cnt++;
+	return 0;
+}
+
+static struct umem_store_ops p2_ra_ops = {
+	.so_waitqueue_create	= waitqueue_create,
+	.so_waitqueue_destroy	= waitqueue_destroy,
+	.so_waitqueue_wait	= waitqueue_wait,
+	.so_waitqueue_wakeup	= waitqueue_wakeup,
+	.so_load		= store_load_cnt_fn,
+	.so_read		= store_read_fn,
+	.so_flush_prep		= flush_prep,
+	.so_flush_copy		= flush_copy,
+	.so_flush_post		= flush_post,
+	.so_wal_id_cmp		= wal_id_cmp,
+};
+
+static void
+test_p2_readahead(void **state)
+{
+	struct test_arg		*arg = *state;
+	struct umem_cache	*cache;
+	struct umem_cache_range	 rgs[3];
+	struct umem_pin_handle	*pin_hdl;
+	uint64_t		 loaded;
+	int			 i, rc;
+
+	arg->ta_store.stor_size = UMEM_CACHE_PAGE_SZ * PAGE_NUM_MD;
+	arg->ta_store.stor_ops  = &p2_ra_ops;
+	arg->ta_store.store_type = DAOS_MD_BMEM;
+
+	rc = umem_cache_alloc(&arg->ta_store, UMEM_CACHE_PAGE_SZ, PAGE_NUM_MD, PAGE_NUM_MEM,
+			      PAGE_NUM_MAX_NE, 4096, (void *)(UMEM_CACHE_PAGE_SZ), is_evictable_fn,
+			      pagevnt_fn, NULL);
+	assert_rc_equal(rc, 0);
+
+	cache = arg->ta_store.cache;
+	assert_non_null(cache);
+
+	reset_arg(arg);
+	store_load_cnt = 0;
+	store_read_cnt = 0;
+
+	/* Pin three cold evictable buckets, they should be loaded in one read */
+	for (i = 0; i < 3; i++) {
+		rgs[i].cr_off	= cache->ca_base_off + (PAGE_NUM_MAX_NE + i * 2) * UMEM_CACHE_PAGE_SZ;
+		rgs[i].cr_size	= UMEM_CACHE_PAGE_SZ;
+	}
+	loaded = cache->ca_cache_stats[UMEM_CACHE_STATS_LOAD];
+	rc = umem_cache_pin(&arg->ta_store, &rgs[0], 3, false, &pin_hdl);
+	assert_rc_equal(rc, 0);
+	assert_int_equal(cache->ca_pgs_stats[UMEM_PG_STATS_PINNED], 3);
+	assert_int_equal(cache->ca_cache_stats[UMEM_CACHE_STATS_LOAD], loaded + 3);
+	assert_int_equal(store_read_cnt, 1);
+	assert_int_equal(store_load_cnt, 0);
+	umem_cache_unpin(&arg->ta_store, pin_hdl);
+
+	/* Cached buckets & single cold bucket don't go through batched read */
+	rgs[2].cr_off	= cache->ca_base_off + (PAGE_NUM_MAX_NE + 5) * UMEM_CACHE_PAGE_SZ;
+	rc = umem_cache_pin(&arg->ta_store, &rgs[0], 3, false, &pin_hdl);
+	assert_rc_equal(rc, 0);
+	assert_int_equal(cache->ca_cache_stats[UMEM_CACHE_STATS_LOAD], loaded + 4);
+	assert_int_equal(store_read_cnt, 1);
+	assert_int_equal(store_load_cnt, 1);
+	umem_cache_unpin(&arg->ta_store, pin_hdl);
+
+	umem_cache_free(&arg->ta_store);
+}
+
 int
 main(int argc, char **argv)
 {
@@ -762,6 +906,8 @@ main(int argc, char **argv)
 	    {"UMEM007: Test page cache many writes", test_many_writes, NULL, NULL},
 	    {"UMEM008: Test phase2 APIs", test_p2_basic, NULL, NULL},
 	    {"UMEM009: Test phase2 eviction", test_p2_evict, NULL, NULL},
+	    {"UMEM010: Test phase2 batched page load", test_p2_readahead, NULL, NULL},
+	    {"UMEM011: Test checkpoint batches", test_chkpt_batches, NULL, NULL},
 	    {NULL, NULL, NULL, NULL}};
 
 	d_register_alt_assert(mock_assert);
@@ -1402,6 +1402,12 @@ cont_query_bits(daos_prop_t *prop)
 		case DAOS_PROP_CO_OBJ_VERSION:
 			bits |= DAOS_CO_QUERY_PROP_OBJ_VERSION;
 			break;
+		case DAOS_PROP_CO_QOS_IOPS:
+			bits |= DAOS_CO_QUERY_PROP_QOS_IOPS;
+			break;
+		case DAOS_PROP_CO_QOS_BW:
+			bits |= DAOS_CO_QUERY_PROP_QOS_BW;
+			break;
 		default:
 			D_ERROR("ignore bad dpt_type %d.\n", entry->dpe_type);
 			break;
@@ -358,6 +358,14 @@ cont_iv_prop_l2g(daos_prop_t *prop, struct cont_iv_prop *iv_prop)
 			iv_prop->cip_obj_version = prop_entry->dpe_val;
 			bits |= DAOS_CO_QUERY_PROP_OBJ_VERSION;
 			break;
+		case DAOS_PROP_CO_QOS_IOPS:
+			iv_prop->cip_qos_iops = prop_entry->dpe_val;
+			bits |= DAOS_CO_QUERY_PROP_QOS_IOPS;
+			break;
+		case DAOS_PROP_CO_QOS_BW:
+			iv_prop->cip_qos_bw = prop_entry->dpe_val;
+			bits |= DAOS_CO_QUERY_PROP_QOS_BW;
+			break;
 		case DAOS_PROP_CO_ACL:
 			acl = prop_entry->dpe_val_ptr;
 			if (acl != NULL)
@@ -1499,6 +1507,16 @@ cont_iv_prop_g2l(struct cont_iv_prop *iv_prop, daos_prop_t **prop_out)
 		prop_entry->dpe_val = iv_prop->cip_scrubbing_disabled;
 		prop_entry->dpe_type = DAOS_PROP_CO_SCRUBBER_DISABLED;
 	}
+	if (bits & DAOS_CO_QUERY_PROP_QOS_IOPS) {
+		prop_entry = &prop->dpp_entries[i++];
+		prop_entry->dpe_val = iv_prop->cip_qos_iops;
+		prop_entry->dpe_type = DAOS_PROP_CO_QOS_IOPS;
+	}
+	if (bits & DAOS_CO_QUERY_PROP_QOS_BW) {
+		prop_entry = &prop->dpp_entries[i++];
+		prop_entry->dpe_val = iv_prop->cip_qos_bw;
+		prop_entry->dpe_type = DAOS_PROP_CO_QOS_BW;
+	}
 out:
 	if (rc)
 		daos_prop_free(prop);
@@ -1542,6 +1560,8 @@ cont_iv_prop_update(void *ns, uuid_t cont_uuid, daos_prop_t *prop, bool sync)
 	D_ASSERT(daos_prop_entry_get(prop, DAOS_PROP_CO_STATUS) != NULL);
 	D_ASSERT(daos_prop_entry_get(prop, DAOS_PROP_CO_RP_PDA) != NULL);
 	D_ASSERT(daos_prop_entry_get(prop, DAOS_PROP_CO_PERF_DOMAIN) != NULL);
+	D_ASSERT(daos_prop_entry_get(prop, DAOS_PROP_CO_QOS_IOPS) != NULL);
+	D_ASSERT(daos_prop_entry_get(prop, DAOS_PROP_CO_QOS_BW) != NULL);
 
 	uuid_copy(iv_entry->cont_uuid, cont_uuid);
 	cont_iv_prop_l2g(prop, &iv_entry->iv_prop);
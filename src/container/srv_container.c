@@ -685,6 +685,8 @@ cont_create_prop_prepare(struct ds_pool_hdl *pool_hdl,
 		case DAOS_PROP_CO_RP_PDA:
 		case DAOS_PROP_CO_PERF_DOMAIN:
 		case DAOS_PROP_CO_SCRUBBER_DISABLED:
+		case DAOS_PROP_CO_QOS_IOPS:
+		case DAOS_PROP_CO_QOS_BW:
 			entry_def->dpe_val = entry->dpe_val;
 			break;
 		case DAOS_PROP_CO_REDUN_FAC:
@@ -1015,6 +1017,14 @@ cont_prop_write(struct rdb_tx *tx, const rdb_path_t *kvs, daos_prop_t *prop,
 			if (rc)
 				return rc;
 			break;
+		case DAOS_PROP_CO_QOS_IOPS:
+			d_iov_set(&value, &entry->dpe_val, sizeof(entry->dpe_val));
+			rc = rdb_tx_update(tx, kvs, &ds_cont_prop_qos_iops, &value);
+			break;
+		case DAOS_PROP_CO_QOS_BW:
+			d_iov_set(&value, &entry->dpe_val, sizeof(entry->dpe_val));
+			rc = rdb_tx_update(tx, kvs, &ds_cont_prop_qos_bw, &value);
+			break;
 		default:
 			D_ERROR("bad dpe_type %d.\n", entry->dpe_type);
 			return -DER_INVAL;
@@ -3372,6 +3382,35 @@ cont_prop_read(struct rdb_tx *tx, struct cont *cont, uint64_t bits,
 		prop->dpp_entries[idx].dpe_val = val;
 		idx++;
 	}
+	/* QoS limits are optional, the containers created before them are unlimited */
+	if (bits & DAOS_CO_QUERY_PROP_QOS_IOPS) {
+		d_iov_set(&value, &val, sizeof(val));
+		rc = rdb_tx_lookup(tx, &cont->c_prop, &ds_cont_prop_qos_iops, &value);
+		if (rc == -DER_NONEXIST) {
+			val = DAOS_PROP_CO_QOS_IOPS_DEFAULT;
+			rc  = 0;
+		} else if (rc != 0) {
+			D_GOTO(out, rc);
+		}
+		D_ASSERT(idx < nr);
+		prop->dpp_entries[idx].dpe_type = DAOS_PROP_CO_QOS_IOPS;
+		prop->dpp_entries[idx].dpe_val = val;
+		idx++;
+	}
+	if (bits & DAOS_CO_QUERY_PROP_QOS_BW) {
+		d_iov_set(&value, &val, sizeof(val));
+		rc = rdb_tx_lookup(tx, &cont->c_prop, &ds_cont_prop_qos_bw, &value);
+		if (rc == -DER_NONEXIST) {
+			val = DAOS_PROP_CO_QOS_BW_DEFAULT;
+			rc  = 0;
+		} else if (rc != 0) {
+			D_GOTO(out, rc);
+		}
+		D_ASSERT(idx < nr);
+		prop->dpp_entries[idx].dpe_type = DAOS_PROP_CO_QOS_BW;
+		prop->dpp_entries[idx].dpe_val = val;
+		idx++;
+	}
 	if (bits & DAOS_CO_QUERY_PROP_REDUN_FAC) {
 		d_iov_set(&value, &val, sizeof(val));
 		rc = rdb_tx_lookup(tx, &cont->c_prop, &ds_cont_prop_redun_fac,
@@ -3930,6 +3969,8 @@ cont_query(struct rdb_tx *tx, struct ds_pool_hdl *pool_hdl, struct cont *cont,
 			case DAOS_PROP_CO_GLOBAL_VERSION:
 			case DAOS_PROP_CO_SCRUBBER_DISABLED:
 			case DAOS_PROP_CO_OBJ_VERSION:
+			case DAOS_PROP_CO_QOS_IOPS:
+			case DAOS_PROP_CO_QOS_BW:
 				if (entry->dpe_val != iv_entry->dpe_val) {
 					D_ERROR("type %d mismatch "DF_U64" - "
 						DF_U64".\n", entry->dpe_type,
@@ -159,6 +159,9 @@ struct cont_iv_prop {
 	uint32_t	cip_perf_domain;
 	uint32_t	cip_global_version;
 	uint32_t	cip_obj_version;
+	/* QoS limits, they change the IV layout so that all engines must run the same version */
+	uint64_t	cip_qos_iops;
+	uint64_t	cip_qos_bw;
 	uint64_t	cip_valid_bits;
 	struct daos_prop_co_roots	cip_roots;
 	struct daos_co_status		cip_co_status;
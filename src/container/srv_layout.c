@@ -54,6 +54,8 @@ RDB_STRING_KEY(ds_cont_prop_, cont_global_version);
 RDB_STRING_KEY(ds_cont_prop_, scrubber_disabled);
 RDB_STRING_KEY(ds_cont_prop_, co_md_times);
 RDB_STRING_KEY(ds_cont_prop_, cont_obj_version);
+RDB_STRING_KEY(ds_cont_prop_, qos_iops);
+RDB_STRING_KEY(ds_cont_prop_, qos_bw);
 RDB_STRING_KEY(ds_cont_prop_, nhandles);
 RDB_STRING_KEY(ds_cont_prop_, ec_agg_eph);
 
@@ -207,6 +209,12 @@ struct daos_prop_entry cont_prop_entries_default[CONT_PROP_NUM] = {
 	}, {
 		.dpe_type	= DAOS_PROP_CO_PERF_DOMAIN,
 		.dpe_val	= 0, /* inherit from pool by default */
+	}, {
+		.dpe_type	= DAOS_PROP_CO_QOS_IOPS,
+		.dpe_val	= DAOS_PROP_CO_QOS_IOPS_DEFAULT,
+	}, {
+		.dpe_type	= DAOS_PROP_CO_QOS_BW,
+		.dpe_val	= DAOS_PROP_CO_QOS_BW_DEFAULT,
 	}
 };
 
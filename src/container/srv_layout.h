@@ -140,6 +140,8 @@ extern d_iov_t ds_cont_prop_cont_global_version;/* uint32_t */
 extern d_iov_t ds_cont_prop_scrubber_disabled;	/* uint64_t */
 extern d_iov_t ds_cont_prop_co_md_times;	/* co_md_times */
 extern d_iov_t ds_cont_prop_cont_obj_version;	/* uint32_t */
+extern d_iov_t ds_cont_prop_qos_iops;		/* uint64_t */
+extern d_iov_t ds_cont_prop_qos_bw;		/* uint64_t */
 extern d_iov_t ds_cont_prop_nhandles;		/* uint32_t */
 extern d_iov_t ds_cont_prop_oit_oids;		/* snapshot OIT OID KVS */
 extern d_iov_t ds_cont_prop_ec_agg_eph;         /* uint64_t */
@@ -92,7 +92,7 @@ ds_cont_get_props(struct cont_props *cont_props, uuid_t pool_uuid,
 	/* The provided prop entry types should cover the types used in
 	 * daos_props_2cont_props().
 	 */
-	props = daos_prop_alloc(17);
+	props = daos_prop_alloc(19);
 	if (props == NULL)
 		return -DER_NOMEM;
 
@@ -113,6 +113,8 @@ ds_cont_get_props(struct cont_props *cont_props, uuid_t pool_uuid,
 	props->dpp_entries[14].dpe_type = DAOS_PROP_CO_OBJ_VERSION;
 	props->dpp_entries[15].dpe_type = DAOS_PROP_CO_STATUS;
 	props->dpp_entries[16].dpe_type = DAOS_PROP_CO_PERF_DOMAIN;
+	props->dpp_entries[17].dpe_type = DAOS_PROP_CO_QOS_IOPS;
+	props->dpp_entries[18].dpe_type = DAOS_PROP_CO_QOS_BW;
 
 	rc = cont_iv_prop_fetch(pool_uuid, cont_uuid, props);
 	if (rc == DER_SUCCESS)
@@ -123,6 +125,14 @@ ds_cont_get_props(struct cont_props *cont_props, uuid_t pool_uuid,
 	return rc;
 }
 
+/* The object module looks up the containers for QoS limits only if the pool has any */
+static inline void
+cont_child_qos_check(struct ds_cont_child *cont)
+{
+	if (cont->sc_props.dcp_qos_iops != 0 || cont->sc_props.dcp_qos_bw != 0)
+		cont->sc_pool->spc_pool->sp_cont_qos = true;
+}
+
 int
 ds_cont_csummer_init(struct ds_cont_child *cont)
 {
@@ -150,6 +160,7 @@ ds_cont_csummer_init(struct ds_cont_child *cont)
 	rc = ds_cont_get_props(cont_props, cont->sc_pool_uuid, cont->sc_uuid);
 	if (rc != 0)
 		goto done;
+	cont_child_qos_check(cont);
 
 	csum_val = cont_props->dcp_csum_type;
 	if (!daos_cont_csum_prop_is_enabled(csum_val)) {
@@ -2922,6 +2933,7 @@ cont_child_prop_update(void *data)
 		goto out;
 	}
 	daos_props_2cont_props(arg->cpa_prop, &child->sc_props);
+	cont_child_qos_check(child);
 
 	iv_entry = daos_prop_entry_get(arg->cpa_prop, DAOS_PROP_CO_STATUS);
 	if (iv_entry != NULL) {
@@ -2953,9 +2965,11 @@ ds_cont_tgt_prop_update(uuid_t pool_uuid, uuid_t cont_uuid, daos_prop_t	*prop)
 	struct cont_prop_set_arg arg;
 	int			 rc;
 
-	/* XXX only need update status and obj_version now? */
+	/* XXX only need update status, obj_version and QoS limits now? */
 	if (daos_prop_entry_get(prop, DAOS_PROP_CO_STATUS) == NULL &&
-	    daos_prop_entry_get(prop, DAOS_PROP_CO_OBJ_VERSION) == NULL)
+	    daos_prop_entry_get(prop, DAOS_PROP_CO_OBJ_VERSION) == NULL &&
+	    daos_prop_entry_get(prop, DAOS_PROP_CO_QOS_IOPS) == NULL &&
+	    daos_prop_entry_get(prop, DAOS_PROP_CO_QOS_BW) == NULL)
 		return 0;
 
 	D_DEBUG(DB_MD, DF_CONT" property update.\n", DP_CONT(pool_uuid, cont_uuid));
@@ -84,6 +84,8 @@ const (
 	ContainerPropScubberDisabled ContainerPropType = C.DAOS_PROP_CO_SCRUBBER_DISABLED
 	ContainerPropObjectVersion   ContainerPropType = C.DAOS_PROP_CO_OBJ_VERSION
 	ContainerPropPerfDomain      ContainerPropType = C.DAOS_PROP_CO_PERF_DOMAIN
+	ContainerPropQosIops         ContainerPropType = C.DAOS_PROP_CO_QOS_IOPS
+	ContainerPropQosBw           ContainerPropType = C.DAOS_PROP_CO_QOS_BW
 	containerPropMax             ContainerPropType = C.DAOS_PROP_CO_MAX
 )
 
@@ -141,6 +143,10 @@ func (cpt ContainerPropType) String() string {
 		return C.DAOS_PROP_ENTRY_OBJ_VERSION
 	case ContainerPropPerfDomain:
 		return C.DAOS_PROP_ENTRY_PERF_DOMAIN
+	case ContainerPropQosIops:
+		return C.DAOS_PROP_ENTRY_QOS_IOPS
+	case ContainerPropQosBw:
+		return C.DAOS_PROP_ENTRY_QOS_BW
 	default:
 		return fmt.Sprintf("unknown container property type %d", cpt)
 	}
@@ -674,6 +680,38 @@ var propHdlrs = propHdlrMap{
 		boolStringer,
 		true,
 	},
+	C.DAOS_PROP_ENTRY_QOS_IOPS: {
+		C.DAOS_PROP_CO_QOS_IOPS,
+		"Client I/O IOPS limit",
+		func(_ *propHdlr, p *ContainerProperty, v string) error {
+			value, err := strconv.ParseUint(v, 10, 64)
+			if err != nil {
+				return propError("invalid %s %q", p.Name, v)
+			}
+
+			return p.SetValue(value)
+		},
+		nil,
+		nil,
+		qosStringer,
+		false,
+	},
+	C.DAOS_PROP_ENTRY_QOS_BW: {
+		C.DAOS_PROP_CO_QOS_BW,
+		"Client I/O bandwidth limit (MiB/s)",
+		func(_ *propHdlr, p *ContainerProperty, v string) error {
+			value, err := strconv.ParseUint(v, 10, 64)
+			if err != nil {
+				return propError("invalid %s %q", p.Name, v)
+			}
+
+			return p.SetValue(value)
+		},
+		nil,
+		nil,
+		qosStringer,
+		false,
+	},
 }
 
 func (p *ContainerProperty) MarshalJSON() ([]byte, error) {
@@ -1203,6 +1241,14 @@ func uintStringer(p *ContainerProperty) string {
 	return fmt.Sprintf("%d", p.GetValue())
 }
 
+func qosStringer(p *ContainerProperty) string {
+	if !p.IsUnset() && p.GetValue() == 0 {
+		return "unlimited"
+	}
+
+	return uintStringer(p)
+}
+
 func boolStringer(p *ContainerProperty) string {
 	if p.IsUnset() {
 		return "not set"
@@ -96,6 +96,12 @@ const (
 	PoolPropertyReintMode      = C.DAOS_PROP_PO_REINT_MODE
 	PoolPropertySvcOpsEnabled  = C.DAOS_PROP_PO_SVC_OPS_ENABLED
 	PoolPropertySvcOpsEntryAge = C.DAOS_PROP_PO_SVC_OPS_ENTRY_AGE
+	//PoolPropertyQosIops is the pool-wide client I/O IOPS limit
+	PoolPropertyQosIops = C.DAOS_PROP_PO_QOS_IOPS
+	//PoolPropertyQosBw is the pool-wide client I/O bandwidth limit in MiB/s
+	PoolPropertyQosBw = C.DAOS_PROP_PO_QOS_BW
+	//PoolPropertyQosSlo is the p99 queueing delay target of client I/O in ms
+	PoolPropertyQosSlo = C.DAOS_PROP_PO_QOS_SLO
 )
 
 const (
@@ -390,6 +396,78 @@ func PoolProperties() PoolPropertyMap {
 				valueMarshaler: numericMarshaler,
 			},
 		},
+		"qos_iops": {
+			Property: PoolProperty{
+				Number:      PoolPropertyQosIops,
+				Description: "Client I/O IOPS limit, 0 for unlimited",
+				valueHandler: func(s string) (*PoolPropertyValue, error) {
+					qVal, err := strconv.ParseUint(s, 10, 64)
+					if err != nil {
+						return nil, errors.Errorf("invalid qos_iops %s", s)
+					}
+					return &PoolPropertyValue{qVal}, nil
+				},
+				valueStringer: func(v *PoolPropertyValue) string {
+					n, err := v.GetNumber()
+					if err != nil {
+						return "not set"
+					}
+					if n == 0 {
+						return "unlimited"
+					}
+					return fmt.Sprintf("%d", n)
+				},
+				valueMarshaler: numericMarshaler,
+			},
+		},
+		"qos_bw": {
+			Property: PoolProperty{
+				Number:      PoolPropertyQosBw,
+				Description: "Client I/O bandwidth limit in MiB/s, 0 for unlimited",
+				valueHandler: func(s string) (*PoolPropertyValue, error) {
+					qVal, err := strconv.ParseUint(s, 10, 64)
+					if err != nil {
+						return nil, errors.Errorf("invalid qos_bw %s", s)
+					}
+					return &PoolPropertyValue{qVal}, nil
+				},
+				valueStringer: func(v *PoolPropertyValue) string {
+					n, err := v.GetNumber()
+					if err != nil {
+						return "not set"
+					}
+					if n == 0 {
+						return "unlimited"
+					}
+					return fmt.Sprintf("%d", n)
+				},
+				valueMarshaler: numericMarshaler,
+			},
+		},
+		"qos_slo": {
+			Property: PoolProperty{
+				Number:      PoolPropertyQosSlo,
+				Description: "Client I/O p99 queueing delay target in ms, 0 for engine default",
+				valueHandler: func(s string) (*PoolPropertyValue, error) {
+					qVal, err := strconv.ParseUint(s, 10, 32)
+					if err != nil {
+						return nil, errors.Errorf("invalid qos_slo %s", s)
+					}
+					return &PoolPropertyValue{qVal}, nil
+				},
+				valueStringer: func(v *PoolPropertyValue) string {
+					n, err := v.GetNumber()
+					if err != nil {
+						return "not set"
+					}
+					if n == 0 {
+						return "engine default"
+					}
+					return fmt.Sprintf("%d ms", n)
+				},
+				valueMarshaler: numericMarshaler,
+			},
+		},
 		"label": {
 			Property: PoolProperty{
 				Number:      PoolPropertyLabel,
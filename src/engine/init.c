@@ -658,8 +658,18 @@ metrics_region_size(int num_tgts)
 {
 	const uint64_t	est_std_metrics = 1024; /* high estimate to allow for pool links */
 	const uint64_t	est_tgt_metrics = 128; /* high estimate */
+	const uint64_t	est_tgt_loghists = 16; /* log-linear histogram shards per target */
+	uint64_t	size;
 
-	return (est_std_metrics + est_tgt_metrics * num_tgts) * D_TM_METRIC_SIZE;
+	size = (est_std_metrics + est_tgt_metrics * num_tgts) * D_TM_METRIC_SIZE +
+	       est_tgt_loghists * num_tgts *
+	       D_TM_LOGHIST_SIZE(1, D_TM_LOGHIST_SUB_BITS, D_TM_LOGHIST_MAX_BITS);
+
+	/* One trace ring per xstream */
+	if (dss_trace_sample != 0)
+		size += DSS_XS_NR_TOTAL * D_TM_TRACE_SIZE(IO_TRACE_NR_RECS);
+
+	return size;
 }
 
 static int
@@ -700,6 +710,10 @@ server_init(int argc, char *argv[])
 	if (rc != 0)
 		D_GOTO(exit_debug_init, rc);
 
+	d_getenv_uint("DAOS_IO_TRACE_SAMPLE", &dss_trace_sample);
+	if (dss_trace_sample != 0)
+		D_INFO("Tracing 1 of every %u RPCs\n", dss_trace_sample);
+
 	rc = d_tm_init(dss_instance_idx, metrics_region_size(dss_tgt_nr), D_TM_SERVER_PROCESS);
 	if (rc != 0)
 		goto exit_debug_init;
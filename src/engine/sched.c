@@ -14,6 +14,7 @@
 #include <daos_srv/vos.h>
 #include <gurt/telemetry_producer.h>
 #include "srv_internal.h"
+#include "sched_qos.h"
 
 /*
  * CPU weights for each type of ULTs, the ULT consuming more CPU in a schedule
@@ -133,6 +134,18 @@ struct sched_req_info {
 	uint32_t		sri_req_limit;
 };
 
+/* Container QoS info is freed after being idle for this long, in msecs */
+#define SCHED_QOS_IDLE_MAX	10000
+
+struct sched_cont_qos {
+	/* Link to 'sched_pool_info->spi_cont_qos' */
+	d_list_t		scq_link;
+	uuid_t			scq_cont_id;
+	struct sched_qos_bucket	scq_bucket;
+	/* Last time when any request accessed the bucket, in msecs */
+	uint64_t		scq_access_ts;
+};
+
 struct sched_pool_info {
 	/* Link to 'sched_info->si_pool_hash' */
 	d_list_t		spi_hash_link;
@@ -148,6 +161,12 @@ struct sched_pool_info {
 	int			spi_ref;
 	uint32_t		spi_req_cnt;
 	struct stats_window	spi_stats_window;
+	struct sched_slo_info	spi_slo;
+	struct sched_qos_bucket	spi_qos;
+	/* DRR deficit of the QoS limited IO, in bytes */
+	int64_t			spi_qos_deficit;
+	/* QoS info of the containers having limits */
+	d_list_t		spi_cont_qos;
 };
 
 struct sched_request {
@@ -163,6 +182,7 @@ struct sched_request {
 	void			*sr_arg;
 	ABT_thread		 sr_ult;
 	struct sched_pool_info	*sr_pool_info;
+	struct sched_cont_qos	*sr_cont_qos;
 	/* Wakeup time for the sleeping request, in milli seconds */
 	uint64_t		 sr_wakeup_time;
 	/* When the request is enqueued, in msecs */
@@ -171,7 +191,11 @@ struct sched_request {
 				 /* sr_ult is sched_request-owned */
 				 sr_owned:1,
 				 /* request is in heap */
-				 sr_in_heap:1;
+				 sr_in_heap:1,
+				 /* request is subject to QoS limits */
+				 sr_qos:1,
+				 /* request has been held by QoS limits */
+				 sr_qos_throttled:1;
 };
 
 bool		sched_prio_disabled;
@@ -181,6 +205,8 @@ unsigned int	sched_unit_runtime_max = 32; /* ms */
 bool		sched_watchdog_all;
 unsigned int    sched_inactive_max = 300000; /* ms, 5 mins */
 bool            sched_monitor_kill = true;
+unsigned int    sched_slo_target; /* ms, 0: latency SLO disabled */
+bool            sched_slo_reject;
 
 enum {
 	/* All requests for various pools are processed in FIFO */
@@ -318,6 +344,7 @@ static void
 spi_rec_free(struct d_hash_table *htable, d_list_t *rlink)
 {
 	struct sched_pool_info	*spi = sched_rlink2spi(rlink);
+	struct sched_cont_qos	*scq, *tmp;
 	unsigned int		 type;
 
 	/*
@@ -338,6 +365,12 @@ spi_rec_free(struct d_hash_table *htable, d_list_t *rlink)
 		D_ASSERT(d_list_empty(pool2req_list(spi, type)));
 	}
 
+	d_list_for_each_entry_safe(scq, tmp, &spi->spi_cont_qos, scq_link) {
+		D_ASSERT(scq->scq_bucket.sqb_queued == 0);
+		d_list_del(&scq->scq_link);
+		D_FREE(scq);
+	}
+
 	D_FREE(spi);
 }
 
@@ -493,6 +526,7 @@ sched_metrics_init(struct dss_xstream *dx)
 {
 	struct sched_info	*info = &dx->dx_sched_info;
 	struct sched_stats	*stats = &info->si_stats;
+	char			 path[D_TM_MAX_NAME_LEN];
 	int			 rc;
 
 	stats->ss_busy_ts = info->si_cur_ts;
@@ -533,6 +567,36 @@ sched_metrics_init(struct dss_xstream *dx)
 			     "req", "sched/total_reject/xs_%u", dx->dx_xs_id);
 	if (rc)
 		D_WARN("Failed to create total_reject telemetry: "DF_RC"\n", DP_RC(rc));
+
+	if (!dx->dx_main_xs)
+		return;
+
+	rc = d_tm_add_metric(&stats->ss_qos_throttled, D_TM_COUNTER,
+			     "IO requests held by pool/container QoS limits", "req",
+			     "sched/qos_throttled/xs_%u", dx->dx_xs_id);
+	if (rc)
+		D_WARN("Failed to create qos_throttled telemetry: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&stats->ss_qos_reject, D_TM_COUNTER,
+			     "IO requests rejected by pool/container QoS limits", "req",
+			     "sched/qos_reject/xs_%u", dx->dx_xs_id);
+	if (rc)
+		D_WARN("Failed to create qos_reject telemetry: "DF_RC"\n", DP_RC(rc));
+
+	/* The SLO could be enabled by the pool property even if there is no engine default */
+	snprintf(path, sizeof(path), "sched/io_queue_delay/xs_%u", dx->dx_xs_id);
+	rc = d_tm_add_metric(&stats->ss_io_delay, D_TM_STATS_GAUGE, "IO queueing delay", "ms",
+			     path);
+	if (rc)
+		D_WARN("Failed to create io_queue_delay telemetry: "DF_RC"\n", DP_RC(rc));
+	else if (d_tm_init_histogram(stats->ss_io_delay, path, SCHED_SLO_BUCKETS, 1, 2, "ms"))
+		D_WARN("Failed to init io_queue_delay histogram\n");
+
+	rc = d_tm_add_metric(&stats->ss_slo_violation, D_TM_COUNTER,
+			     "Pool windows exceeded the queueing delay SLO", "window",
+			     "sched/slo_violation/xs_%u", dx->dx_xs_id);
+	if (rc)
+		D_WARN("Failed to create slo_violation telemetry: "DF_RC"\n", DP_RC(rc));
 }
 
 static int
@@ -669,7 +733,11 @@ cur_pool_info(struct sched_info *info, uuid_t pool_uuid)
 		return NULL;
 
 	D_INIT_LIST_HEAD(&spi->spi_hash_link);
+	D_INIT_LIST_HEAD(&spi->spi_cont_qos);
 	uuid_copy(spi->spi_pool_id, pool_uuid);
+	spi->spi_slo.ssi_target = sched_slo_target;
+	spi->spi_slo.ssi_sys_pct = 100;
+	spi->spi_slo.ssi_window_ts = info->si_cur_ts;
 
 	for (type = SCHED_REQ_UPDATE; type < SCHED_REQ_MAX; type++) {
 		list = pool2req_list(spi, type);
@@ -727,6 +795,9 @@ req_get(struct dss_xstream *dx, struct sched_req_attr *attr,
 	req->sr_abort	= 0;
 	req->sr_owned	= (owned ? 1 : 0);
 	req->sr_pool_info = spi;
+	req->sr_cont_qos = NULL;
+	req->sr_qos	= 0;
+	req->sr_qos_throttled = 0;
 
 	return req;
 }
@@ -749,11 +820,165 @@ req_kickoff_internal(struct dss_xstream *dx, struct sched_req_attr *attr,
 	D_ASSERT(attr && func && arg);
 	D_ASSERT(attr->sra_type < SCHED_REQ_TYPE_MAX);
 
+	DSS_TRACE(&attr->sra_trace, DISPATCH);
 	return sched_create_thread(dx, func, arg, ABT_THREAD_ATTR_NULL, NULL,
 				   attr->sra_flags & SCHED_REQ_FL_PERIODIC ?
 					DSS_ULT_FL_PERIODIC : 0);
 }
 
+static inline bool
+is_system_req(int req_type)
+{
+	if (req_type == SCHED_REQ_UPDATE || req_type == SCHED_REQ_FETCH)
+		return false;
+
+	return true;
+}
+
+/* Account the queueing delay of IO request for the latency SLO */
+static inline void
+slo_record(struct sched_info *info, struct sched_pool_info *spi, struct sched_request *req)
+{
+	struct sched_slo_info	*ssi = &spi->spi_slo;
+	uint64_t		 delay;
+
+	if (ssi->ssi_target == 0 || is_system_req(req->sr_attr.sra_type))
+		return;
+
+	delay = info->si_cur_ts - req->sr_enqueue_ts;
+	slo_hist_add(ssi, delay);
+	if (info->si_stats.ss_io_delay)
+		d_tm_set_gauge(info->si_stats.ss_io_delay, delay);
+}
+
+static struct sched_cont_qos *
+cont_qos_lookup(struct sched_pool_info *spi, uuid_t cont_id)
+{
+	struct sched_cont_qos	*scq;
+
+	d_list_for_each_entry(scq, &spi->spi_cont_qos, scq_link) {
+		if (uuid_compare(scq->scq_cont_id, cont_id) == 0)
+			return scq;
+	}
+
+	return NULL;
+}
+
+/*
+ * Attach the IO request to the token buckets of its pool and container. The limits
+ * are carried by each request, so that property changes take effect immediately.
+ */
+static void
+qos_req_attach(struct sched_info *info, struct sched_request *req)
+{
+	struct sched_pool_info	*spi = req->sr_pool_info;
+	struct sched_req_attr	*attr = &req->sr_attr;
+	struct sched_cont_qos	*scq;
+
+	if (spi == NULL || is_system_req(attr->sra_type))
+		return;
+
+	qos_bucket_set_limit(&spi->spi_qos, &attr->sra_pool_qos, info->si_cur_ts);
+
+	/* Only the containers having limits are tracked, the others skip the lookup */
+	scq = NULL;
+	if (qos_limited(&attr->sra_cont_qos)) {
+		scq = cont_qos_lookup(spi, attr->sra_cont_id);
+		if (scq == NULL) {
+			D_ALLOC_PTR(scq);
+			if (scq != NULL) {
+				uuid_copy(scq->scq_cont_id, attr->sra_cont_id);
+				d_list_add_tail(&scq->scq_link, &spi->spi_cont_qos);
+			}
+		}
+	}
+
+	if (scq != NULL) {
+		qos_bucket_set_limit(&scq->scq_bucket, &attr->sra_cont_qos, info->si_cur_ts);
+		scq->scq_access_ts = info->si_cur_ts;
+	}
+
+	if (scq == NULL && !qos_limited(&spi->spi_qos.sqb_limit))
+		return;
+
+	req->sr_qos = 1;
+	req->sr_cont_qos = scq;
+	spi->spi_qos.sqb_queued++;
+	spi->spi_qos.sqb_queued_bytes += attr->sra_size;
+	if (scq != NULL) {
+		scq->scq_bucket.sqb_queued++;
+		scq->scq_bucket.sqb_queued_bytes += attr->sra_size;
+	}
+}
+
+static void
+qos_bucket_detach(struct sched_qos_bucket *sqb, uint64_t size, bool consume)
+{
+	D_ASSERT(sqb->sqb_queued > 0);
+	D_ASSERT(sqb->sqb_queued_bytes >= size);
+	sqb->sqb_queued--;
+	sqb->sqb_queued_bytes -= size;
+
+	if (consume)
+		qos_bucket_consume(sqb, size);
+}
+
+static void
+qos_req_detach(struct sched_request *req, bool consume)
+{
+	uint64_t	size = req->sr_attr.sra_size;
+
+	if (!req->sr_qos)
+		return;
+
+	qos_bucket_detach(&req->sr_pool_info->spi_qos, size, consume);
+	if (consume)
+		qos_drr_consume(&req->sr_pool_info->spi_qos_deficit, size);
+	if (req->sr_cont_qos != NULL)
+		qos_bucket_detach(&req->sr_cont_qos->scq_bucket, size, consume);
+	req->sr_qos = 0;
+	req->sr_cont_qos = NULL;
+}
+
+/*
+ * Can the IO request be kicked off without exceeding the QoS limits, and within the DRR
+ * deficit of its pool?
+ */
+static bool
+qos_req_ready(struct sched_info *info, struct sched_request *req)
+{
+	struct sched_qos_bucket	*sqb = &req->sr_pool_info->spi_qos;
+
+	if (!qos_drr_ready(req->sr_pool_info->spi_qos_deficit, req->sr_attr.sra_size))
+		return false;
+
+	qos_bucket_refill(sqb, info->si_cur_ts);
+	if (!qos_bucket_ready(sqb))
+		return false;
+
+	if (req->sr_cont_qos == NULL)
+		return true;
+
+	sqb = &req->sr_cont_qos->scq_bucket;
+	qos_bucket_refill(sqb, info->si_cur_ts);
+	return qos_bucket_ready(sqb);
+}
+
+/* Free the QoS info of idle containers */
+static void
+qos_purge_idle(struct sched_info *info, struct sched_pool_info *spi)
+{
+	struct sched_cont_qos	*scq, *tmp;
+
+	d_list_for_each_entry_safe(scq, tmp, &spi->spi_cont_qos, scq_link) {
+		if (scq->scq_bucket.sqb_queued != 0 ||
+		    (info->si_cur_ts - scq->scq_access_ts) < SCHED_QOS_IDLE_MAX)
+			continue;
+		d_list_del(&scq->scq_link);
+		D_FREE(scq);
+	}
+}
+
 static int
 req_kickoff(struct dss_xstream *dx, struct sched_request *req)
 {
@@ -783,6 +1008,8 @@ req_kickoff(struct dss_xstream *dx, struct sched_request *req)
 	D_ASSERT(info->si_req_cnt[req->sr_attr.sra_type] > 0);
 	info->si_req_cnt[req->sr_attr.sra_type]--;
 	sw_cycle_update(&spi->spi_stats_window, req->sr_attr.sra_type);
+	slo_record(info, spi, req);
+	qos_req_detach(req, true);
 
 	if (req->sr_in_heap)
 		d_binheap_remove(&info->si_heap, &req->sr_node);
@@ -882,6 +1109,13 @@ out:
 /* max cycle time in msecs */
 #define MAX_CYCLE_TIME		((MAX_KICKED_REQ_CNT * 20) / 1000)
 
+static inline bool
+is_req_expired(struct sched_info *info, struct sched_request *req)
+{
+	return req->sr_attr.sra_timeout > MAX_CYCLE_TIME &&
+	       (info->si_cur_ts - req->sr_enqueue_ts) > (req->sr_attr.sra_timeout - MAX_CYCLE_TIME);
+}
+
 static int
 process_req(struct dss_xstream *dx, struct sched_request *req)
 {
@@ -899,16 +1133,27 @@ process_req(struct dss_xstream *dx, struct sched_request *req)
 	if (info->si_stop)
 		goto kickoff;
 
-	if (sri->sri_req_kicked < sri->sri_req_limit)
+	if (req->sr_attr.sra_flags & SCHED_REQ_FL_NO_DELAY)
 		goto kickoff;
 
-	if (req->sr_attr.sra_flags & SCHED_REQ_FL_NO_DELAY)
+	/*
+	 * Hold the request exceeding QoS limits in the queue, so that the requests for other
+	 * pools and containers can move ahead of it.
+	 */
+	if (req->sr_qos && !qos_req_ready(info, req)) {
+		if (is_req_expired(info, req))
+			goto kickoff;
+		if (!req->sr_qos_throttled) {
+			req->sr_qos_throttled = 1;
+			d_tm_inc_counter(info->si_stats.ss_qos_throttled, 1);
+		}
+		return 1;
+	}
+
+	if (sri->sri_req_kicked < sri->sri_req_limit)
 		goto kickoff;
 
-	/* Request expired */
-	if (req->sr_attr.sra_timeout > MAX_CYCLE_TIME &&
-	    (info->si_cur_ts - req->sr_enqueue_ts) >
-	    (req->sr_attr.sra_timeout - MAX_CYCLE_TIME))
+	if (is_req_expired(info, req))
 		goto kickoff;
 
 	/*
@@ -1150,13 +1395,66 @@ throttle_sys(struct stats_window *sw, uint32_t *kick, struct pressure_ratio *pr)
 		apportion_wts(avail_wts, kick, SCHED_REQ_SCRUB);
 }
 
-static bool
-is_system_req(int req_type)
+/*
+ * Evaluate the p99 IO queueing delay of the pool on every SLO window, the percentage
+ * of system requests (GC, scrub, rebuild) being kicked off is halved when the SLO is
+ * violated, and increased additively when the SLO is met.
+ */
+static void
+slo_update(struct sched_info *info, struct sched_pool_info *spi)
 {
-	if (req_type == SCHED_REQ_UPDATE || req_type == SCHED_REQ_FETCH)
-		return false;
+	struct sched_slo_info	*ssi = &spi->spi_slo;
 
-	return true;
+	/* The SLO of the pool could be disabled by a property change */
+	if (ssi->ssi_target == 0) {
+		if (ssi->ssi_cnt != 0 || ssi->ssi_sys_pct != 100) {
+			ssi->ssi_violated = false;
+			ssi->ssi_sys_pct = 100;
+			slo_hist_reset(ssi, info->si_cur_ts);
+		}
+		return;
+	}
+
+	if ((info->si_cur_ts - ssi->ssi_window_ts) < SCHED_SLO_WINDOW)
+		return;
+
+	ssi->ssi_p99 = slo_hist_p99(ssi);
+	if (ssi->ssi_p99 > ssi->ssi_target) {
+		if (!ssi->ssi_violated)
+			D_DEBUG(DB_TRACE, "Pool:"DF_UUID" p99 queueing delay %u > SLO %u ms\n",
+				DP_UUID(spi->spi_pool_id), ssi->ssi_p99, ssi->ssi_target);
+		ssi->ssi_violated = true;
+		ssi->ssi_sys_pct = max(ssi->ssi_sys_pct / 2, SCHED_SLO_SYS_MIN);
+		d_tm_inc_counter(info->si_stats.ss_slo_violation, 1);
+	} else {
+		ssi->ssi_violated = false;
+		ssi->ssi_sys_pct = min(ssi->ssi_sys_pct + SCHED_SLO_SYS_STEP, 100);
+	}
+
+	slo_hist_reset(ssi, info->si_cur_ts);
+}
+
+/*
+ * Back off system requests when IO queueing delay exceeds the SLO. GC isn't throttled
+ * under space pressure, otherwise space can't be reclaimed for the IO.
+ */
+static void
+throttle_slo(struct sched_pool_info *spi, uint32_t *kick, int press)
+{
+	uint32_t	pct = spi->spi_slo.ssi_sys_pct;
+	int		i;
+
+	if (pct >= 100)
+		return;
+
+	for (i = SCHED_REQ_UPDATE; i < SCHED_REQ_MAX; i++) {
+		if (!is_system_req(i))
+			continue;
+		if (i == SCHED_REQ_GC && press != SCHED_SPACE_PRESS_NONE)
+			continue;
+		/* Round up to keep at least one request moving */
+		kick[i] = ((uint64_t)kick[i] * pct + 99) / 100;
+	}
 }
 
 static int
@@ -1175,6 +1473,9 @@ process_pool_cb(d_list_t *rlink, void *arg)
 
 	/* Update stats window no matter if any pending ULT or not */
 	sw_window_update(&spi->spi_stats_window);
+	slo_update(info, spi);
+	qos_purge_idle(info, spi);
+	qos_drr_round(&spi->spi_qos_deficit, spi->spi_qos.sqb_queued != 0);
 	/* check_space_pressure() can't be skipped, otherwise, destroyed pool won't be detected */
 	press = check_space_pressure(dx, spi);
 	if (spi->spi_req_cnt == 0)
@@ -1206,6 +1507,8 @@ process_pool_cb(d_list_t *rlink, void *arg)
 	else
 		throttle_io(info, spi, &kick[SCHED_REQ_UPDATE], pr);
 
+	throttle_slo(spi, &kick[SCHED_REQ_UPDATE], press);
+
 	for (i = SCHED_REQ_UPDATE; i < SCHED_REQ_MAX; i++) {
 		set_req_limit(dx, spi, i, kick[i]);
 		info->si_kicked_req_cnt[i] = 0;
@@ -1421,6 +1724,55 @@ req_need_reject(struct sched_req_attr *attr, struct sched_info *info)
 	return false;
 }
 
+/* The SLO target of pool property is carried by client IO, 0 means the engine default */
+static inline void
+slo_set_target(struct sched_pool_info *spi, struct sched_req_attr *attr)
+{
+	if (is_system_req(attr->sra_type))
+		return;
+
+	spi->spi_slo.ssi_target = attr->sra_slo_target != 0 ? attr->sra_slo_target :
+							       sched_slo_target;
+}
+
+/* Reject IO request when the pool is violating the queueing delay SLO */
+static bool
+slo_need_reject(struct sched_req_attr *attr, struct sched_info *info)
+{
+	struct sched_pool_info	*spi;
+
+	if (!sched_slo_reject || is_system_req(attr->sra_type))
+		return false;
+
+	/* Retried RPC won't be rejected again */
+	if (attr->sra_flags & (SCHED_REQ_FL_NO_REJECT | SCHED_REQ_FL_RESENT))
+		return false;
+
+	spi = cur_pool_info(info, attr->sra_pool_id);
+	if (spi == NULL || !spi->spi_slo.ssi_violated)
+		return false;
+
+	/* Only reject when there are IO requests queued ahead */
+	return (pool2req_cnt(spi, SCHED_REQ_UPDATE) + pool2req_cnt(spi, SCHED_REQ_FETCH)) != 0;
+}
+
+/* Reject IO request when the backlog held by QoS limits can't be drained in time */
+static bool
+qos_need_reject(struct sched_request *req)
+{
+	struct sched_req_attr	*attr = &req->sr_attr;
+	uint64_t		 wait;
+
+	if (!req->sr_qos || (attr->sra_flags & (SCHED_REQ_FL_NO_REJECT | SCHED_REQ_FL_RESENT)))
+		return false;
+
+	wait = qos_bucket_backlog(&req->sr_pool_info->spi_qos);
+	if (req->sr_cont_qos != NULL)
+		wait = max(wait, qos_bucket_backlog(&req->sr_cont_qos->scq_bucket));
+
+	return wait > attr->sra_timeout / 2;
+}
+
 int
 sched_req_enqueue(struct dss_xstream *dx, struct sched_req_attr *attr,
 		  void (*func)(void *), void *arg)
@@ -1453,12 +1805,27 @@ sched_req_enqueue(struct dss_xstream *dx, struct sched_req_attr *attr,
 		return req_kickoff_internal(dx, attr, func, arg);
 
 	D_ASSERT(attr->sra_type < SCHED_REQ_MAX);
+	if (slo_need_reject(attr, info)) {
+		d_tm_inc_counter(info->si_stats.ss_total_reject, 1);
+		return -DER_OVERLOAD_RETRY;
+	}
+
 	req = req_get(dx, attr, func, arg, ABT_THREAD_NULL, false);
 	if (req == NULL) {
 		D_ERROR("Get req failed.\n");
 		return -DER_NOMEM;
 	}
 
+	slo_set_target(req->sr_pool_info, attr);
+	qos_req_attach(info, req);
+	if (qos_need_reject(req)) {
+		qos_req_detach(req, false);
+		req_put(dx, req);
+		d_tm_inc_counter(info->si_stats.ss_qos_reject, 1);
+		d_tm_inc_counter(info->si_stats.ss_total_reject, 1);
+		return -DER_OVERLOAD_RETRY;
+	}
+
 	return req_enqueue(dx, req);
 }
 
@@ -0,0 +1,225 @@
+/**
+ * (C) Copyright 2026 Hewlett Packard Enterprise Development LP
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+/**
+ * Token buckets and deficit round robin used by the scheduler to enforce the pool and
+ * container QoS limits of client IO, and the queueing delay histogram of the latency SLO.
+ */
+
+#ifndef __DAOS_SCHED_QOS_H__
+#define __DAOS_SCHED_QOS_H__
+
+#include <daos/common.h>
+#include <daos_srv/daos_engine.h>
+
+/* Bytes granted to each backlogged pool per schedule cycle by deficit round robin */
+#define SCHED_QOS_QUANTUM	(1ULL << 20)
+/* The deficit carried over the cycles is capped, a larger request runs at the cap */
+#define SCHED_QOS_DEFICIT_MAX	(SCHED_QOS_QUANTUM * 16)
+
+/*
+ * Token bucket for the QoS limits of client IO. Tokens are in units of 1/1000, so that
+ * low rate limits can be refilled on each msec. The bucket is allowed to run into deficit
+ * by a large request, following requests are held until the deficit is paid off.
+ */
+struct sched_qos_bucket {
+	struct sched_qos_limit	sqb_limit;
+	int64_t			sqb_iops_tokens;
+	int64_t			sqb_bw_tokens;
+	/* When the tokens were refilled, in msecs */
+	uint64_t		sqb_refill_ts;
+	/* Queued requests and bytes subject to this bucket */
+	uint32_t		sqb_queued;
+	uint64_t		sqb_queued_bytes;
+};
+
+static inline bool
+qos_limited(struct sched_qos_limit *limit)
+{
+	return limit->sql_iops != 0 || limit->sql_bw != 0;
+}
+
+static inline void
+qos_bucket_set_limit(struct sched_qos_bucket *sqb, struct sched_qos_limit *limit,
+		     uint64_t cur_ts)
+{
+	if (sqb->sqb_limit.sql_iops == limit->sql_iops && sqb->sqb_limit.sql_bw == limit->sql_bw)
+		return;
+
+	/* Start from a full bucket on limit change */
+	sqb->sqb_limit = *limit;
+	sqb->sqb_iops_tokens = limit->sql_iops * 1000;
+	sqb->sqb_bw_tokens = limit->sql_bw * 1000;
+	sqb->sqb_refill_ts = cur_ts;
+}
+
+/* Refill the tokens by elapsed time, the burst is capped to one second worth of tokens */
+static inline void
+qos_bucket_refill(struct sched_qos_bucket *sqb, uint64_t cur_ts)
+{
+	struct sched_qos_limit	*limit = &sqb->sqb_limit;
+	uint64_t		 elapsed;
+
+	if (cur_ts <= sqb->sqb_refill_ts)
+		return;
+
+	elapsed = min(cur_ts - sqb->sqb_refill_ts, 1000);
+	sqb->sqb_refill_ts = cur_ts;
+
+	if (limit->sql_iops != 0)
+		sqb->sqb_iops_tokens = min(sqb->sqb_iops_tokens + (int64_t)(limit->sql_iops * elapsed),
+					   (int64_t)(limit->sql_iops * 1000));
+	if (limit->sql_bw != 0)
+		sqb->sqb_bw_tokens = min(sqb->sqb_bw_tokens + (int64_t)(limit->sql_bw * elapsed),
+					 (int64_t)(limit->sql_bw * 1000));
+}
+
+static inline bool
+qos_bucket_ready(struct sched_qos_bucket *sqb)
+{
+	if (sqb->sqb_limit.sql_iops != 0 && sqb->sqb_iops_tokens <= 0)
+		return false;
+	if (sqb->sqb_limit.sql_bw != 0 && sqb->sqb_bw_tokens <= 0)
+		return false;
+	return true;
+}
+
+static inline void
+qos_bucket_consume(struct sched_qos_bucket *sqb, uint64_t size)
+{
+	if (sqb->sqb_limit.sql_iops != 0)
+		sqb->sqb_iops_tokens -= 1000;
+	if (sqb->sqb_limit.sql_bw != 0)
+		sqb->sqb_bw_tokens -= (int64_t)(size * 1000);
+}
+
+/* Estimated time to drain the requests queued on the bucket, in msecs */
+static inline uint64_t
+qos_bucket_backlog(struct sched_qos_bucket *sqb)
+{
+	struct sched_qos_limit	*limit = &sqb->sqb_limit;
+	int64_t			 need;
+	uint64_t		 wait = 0;
+
+	if (limit->sql_iops != 0) {
+		need = (int64_t)sqb->sqb_queued * 1000 - sqb->sqb_iops_tokens;
+		if (need > 0)
+			wait = need / limit->sql_iops;
+	}
+	if (limit->sql_bw != 0) {
+		need = (int64_t)sqb->sqb_queued_bytes * 1000 - sqb->sqb_bw_tokens;
+		if (need > 0)
+			wait = max(wait, need / limit->sql_bw);
+	}
+
+	return wait;
+}
+
+/*
+ * Deficit round robin across the pools having QoS limits, in bytes. Each schedule cycle
+ * grants a quantum to the backlogged pools, the part not used by the cycle is carried over
+ * to the next one, and it's reset once the pool has nothing queued.
+ */
+static inline void
+qos_drr_round(int64_t *deficit, bool backlogged)
+{
+	if (!backlogged)
+		*deficit = 0;
+	else
+		*deficit = min(*deficit + (int64_t)SCHED_QOS_QUANTUM,
+			       (int64_t)SCHED_QOS_DEFICIT_MAX);
+}
+
+static inline bool
+qos_drr_ready(int64_t deficit, uint64_t size)
+{
+	return deficit >= (int64_t)size || deficit >= (int64_t)SCHED_QOS_DEFICIT_MAX;
+}
+
+static inline void
+qos_drr_consume(int64_t *deficit, uint64_t size)
+{
+	*deficit = max(*deficit - (int64_t)size, 0);
+}
+
+/* Queueing delay histogram buckets, bucket N (N > 0) covers [2^(N-1), 2^N) msecs */
+#define SCHED_SLO_BUCKETS	16
+/* Window for evaluating the queueing delay SLO, in msecs */
+#define SCHED_SLO_WINDOW	1000
+/* Minimum percentage of system requests kicked off when the SLO is violated */
+#define SCHED_SLO_SYS_MIN	10
+/* Percentage of system requests increased per window when the SLO is met */
+#define SCHED_SLO_SYS_STEP	10
+
+struct sched_slo_info {
+	/* Queueing delay histogram of IO requests in current window */
+	uint32_t		ssi_buckets[SCHED_SLO_BUCKETS];
+	uint32_t		ssi_cnt;
+	/* When current window started, in msecs */
+	uint64_t		ssi_window_ts;
+	/* Target p99 queueing delay, in msecs */
+	uint32_t		ssi_target;
+	/* p99 queueing delay of last window, in msecs */
+	uint32_t		ssi_p99;
+	/* Percentage of pending system requests being kicked off */
+	uint32_t		ssi_sys_pct;
+	bool			ssi_violated;
+};
+
+static inline unsigned int
+slo_delay2bucket(uint64_t delay)
+{
+	if (delay == 0)
+		return 0;
+
+	return min(64 - __builtin_clzll(delay), SCHED_SLO_BUCKETS - 1);
+}
+
+static inline void
+slo_hist_add(struct sched_slo_info *ssi, uint64_t delay)
+{
+	ssi->ssi_buckets[slo_delay2bucket(delay)]++;
+	ssi->ssi_cnt++;
+}
+
+/*
+ * p99 queueing delay of the histogram in msecs, linearly interpolated within the bucket
+ * holding the p99 rank, the samples are assumed to be evenly spread over the bucket.
+ */
+static inline uint32_t
+slo_hist_p99(struct sched_slo_info *ssi)
+{
+	uint32_t	rank, sum = 0, lo, hi;
+	int		i;
+
+	if (ssi->ssi_cnt == 0)
+		return 0;
+
+	rank = ((uint64_t)ssi->ssi_cnt * 99 + 99) / 100;
+	for (i = 0; i < SCHED_SLO_BUCKETS; i++) {
+		if (sum + ssi->ssi_buckets[i] >= rank)
+			break;
+		sum += ssi->ssi_buckets[i];
+	}
+	D_ASSERT(i < SCHED_SLO_BUCKETS);
+
+	/* Bucket 0 only holds zero delay */
+	if (i == 0)
+		return 0;
+
+	lo = 1U << (i - 1);
+	hi = 1U << i;
+	return lo + (uint64_t)(hi - lo) * (rank - sum) / ssi->ssi_buckets[i];
+}
+
+static inline void
+slo_hist_reset(struct sched_slo_info *ssi, uint64_t cur_ts)
+{
+	memset(ssi->ssi_buckets, 0, sizeof(ssi->ssi_buckets));
+	ssi->ssi_cnt = 0;
+	ssi->ssi_window_ts = cur_ts;
+}
+
+#endif /* __DAOS_SCHED_QOS_H__ */
@@ -95,6 +95,9 @@ unsigned int            dss_sys_xs_nr = DSS_SYS_XS_NR_DEFAULT;
  */
 bool		dss_helper_pool;
 
+/** Trace 1 of every dss_trace_sample RPCs, 0 to disable tracing */
+unsigned int	dss_trace_sample;
+
 /** Bypass for the nvme health check */
 bool		dss_nvme_bypass_health_check;
 
@@ -318,6 +321,7 @@ dss_rpc_hdlr(crt_context_t *ctx, void *hdlr_arg,
 		attr.sra_type = SCHED_REQ_ANONYM;
 	}
 
+	dss_trace_rpc(rpc, &attr.sra_trace, IO_TRACE_RECV);
 	rc = sched_req_enqueue(dx, &attr, real_rpc_hdlr, rpc);
 	if (rc != -DER_OVERLOAD_RETRY)
 		return rc;
@@ -710,6 +714,49 @@ dss_mem_stats_init(struct mem_stats *stats, int xs_id)
 	stats->ms_current = 0;
 }
 
+static void
+dss_trace_init(struct dss_xstream *dx)
+{
+	int rc;
+
+	if (dss_trace_sample == 0)
+		return;
+
+	rc = d_tm_add_trace(&dx->dx_trace, IO_TRACE_NR_RECS, "Sampled RPC phase markers",
+			    IO_TRACE_DIR "/xs_%u", dx->dx_xs_id);
+	if (rc)
+		D_WARN("Failed to create trace telemetry: "DF_RC"\n", DP_RC(rc));
+}
+
+void
+dss_trace_rpc_init(crt_rpc_t *rpc, struct io_trace *trace, enum io_trace_phase phase)
+{
+	uint64_t	rpcid;
+
+	trace->it_sampled = 0;
+	if (crt_req_rpcid_get(rpc, &rpcid) != 0)
+		return;
+
+	/* Stateless decision, the same RPC is sampled on each xstream it goes through */
+	if (d_hash_mix64(rpcid) % dss_trace_sample != 0)
+		return;
+
+	trace->it_id      = rpcid;
+	trace->it_opc     = rpc->cr_opc;
+	trace->it_sampled = 1;
+	dss_trace_mark(trace, phase);
+}
+
+/* Only the owner xstream writes its trace ring, so the ring has a single writer */
+void
+dss_trace_mark(struct io_trace *trace, enum io_trace_phase phase)
+{
+	struct dss_xstream	*dx = dss_current_xstream();
+
+	if (dx != NULL)
+		d_tm_record_trace(dx->dx_trace, trace->it_id, trace->it_opc, phase);
+}
+
 void
 dss_mem_total_alloc_track(void *arg, daos_size_t bytes)
 {
@@ -834,6 +881,7 @@ dss_start_one_xstream(hwloc_cpuset_t cpus, int tag, int xs_id)
 	}
 
 	dss_mem_stats_init(&dx->dx_mem_stats, xs_id);
+	dss_trace_init(dx);
 
 	/** start XS, ABT rank 0 is reserved for the primary xstream */
 	rc = ABT_xstream_create_with_rank(dx->dx_sched, xs_id + 1,
@@ -1140,6 +1188,12 @@ dss_xstreams_init(void)
 	D_INFO("Watchdog [runtime_max:%u ms, all:%d], Monitor [inactive_max:%u ms, kill:%d]\n",
 	       sched_unit_runtime_max, sched_watchdog_all, sched_inactive_max, sched_monitor_kill);
 
+	d_getenv_uint("DAOS_SCHED_SLO_MS", &sched_slo_target);
+	d_getenv_bool("DAOS_SCHED_SLO_REJECT", &sched_slo_reject);
+	if (sched_slo_target != 0)
+		D_INFO("IO queueing delay SLO [p99:%u ms, reject:%d]\n", sched_slo_target,
+		       sched_slo_reject);
+
 	dss_chore_credits = DSS_CHORE_CREDITS_DEF;
 	d_getenv_uint("DAOS_IO_CHORE_CREDITS", &dss_chore_credits);
 	if (dss_chore_credits < DSS_CHORE_CREDITS_MIN) {
@@ -1149,6 +1203,9 @@ dss_xstreams_init(void)
 	}
 	D_INFO("Set DAOS IO chore credits as %u\n", dss_chore_credits);
 
+	d_getenv_bool("DAOS_IO_CHORE_STEAL", &dss_chore_steal);
+	D_INFO("IO chore stealing is %s\n", dss_chore_steal ? "enabled" : "disabled");
+
 	/* start the execution streams */
 	D_DEBUG(DB_TRACE,
 		"%d cores total detected starting %d main xstreams\n",
@@ -34,6 +34,10 @@ struct sched_stats {
 	struct d_tm_node_t	*ss_cycle_duration;	/* Cycle duration (ms) */
 	struct d_tm_node_t	*ss_cycle_size;		/* Total ULTs in a cycle */
 	struct d_tm_node_t	*ss_total_reject;	/* Total Rejected requests */
+	struct d_tm_node_t	*ss_io_delay;		/* IO queueing delay (ms) */
+	struct d_tm_node_t	*ss_slo_violation;	/* Windows exceeded latency SLO */
+	struct d_tm_node_t	*ss_qos_throttled;	/* IO requests held by QoS limits */
+	struct d_tm_node_t	*ss_qos_reject;		/* IO requests rejected by QoS limits */
 	uint64_t		 ss_busy_ts;		/* Last busy timestamp (ms) */
 	uint64_t		 ss_watchdog_ts;	/* Last watchdog print ts (ms) */
 	void			*ss_last_unit;		/* Last executed unit */
@@ -77,12 +81,20 @@ struct mem_stats {
 
 /* See dss_chore. */
 struct dss_chore_queue {
-	d_list_t   chq_list;
-	int32_t    chq_credits;
-	bool       chq_stop;
-	ABT_mutex  chq_mutex;
-	ABT_cond   chq_cond;
-	ABT_thread chq_ult;
+	d_list_t            chq_list;
+	int32_t             chq_credits;
+	/* Number of chores in chq_list */
+	uint32_t            chq_depth;
+	/* NUMA node of the xstream, chores are only stolen within the same node */
+	int                 chq_numa;
+	bool                chq_stop;
+	/* Queue ULT is waiting for new chores */
+	bool                chq_idle;
+	ABT_mutex           chq_mutex;
+	ABT_cond            chq_cond;
+	ABT_thread          chq_ult;
+	struct d_tm_node_t *chq_depth_tm; /* Queue depth */
+	struct d_tm_node_t *chq_steal_tm; /* Chores stolen from peers */
 };
 
 /** Per-xstream configuration data */
@@ -116,6 +128,8 @@ struct dss_xstream {
 	bool			dx_progress_started;	/* Network poll started */
 	int                     dx_tag;                 /** tag for xstream */
 	struct dss_chore_queue	dx_chore_queue;
+	/* Trace ring of the sampled RPCs processed on this xstream */
+	struct d_tm_node_t     *dx_trace;
 };
 
 /** Engine module's metrics */
@@ -171,6 +185,8 @@ extern unsigned int          dss_offload_per_numa_nr;
 extern unsigned int          dss_tgt_per_numa_nr;
 /** The maximum number of credits for each IO chore queue. That is per helper XS. */
 extern uint32_t              dss_chore_credits;
+/** Idle helper XS steals chores from busy peers on the same NUMA node */
+extern bool                  dss_chore_steal;
 
 /** Number of dRPC xstreams */
 #define DRPC_XS_NR            (1)
@@ -179,6 +195,8 @@ extern uint32_t              dss_chore_credits;
 
 #define DSS_CHORE_CREDITS_MIN 1024
 #define DSS_CHORE_CREDITS_DEF 4096
+/** Queue depth to kick an idle peer for stealing */
+#define DSS_CHORE_STEAL_DEPTH 8
 
 /** Shadow dss_get_module_info */
 struct dss_module_info *get_module_info(void);
@@ -263,6 +281,8 @@ extern unsigned int sched_unit_runtime_max;
 extern bool sched_watchdog_all;
 extern unsigned int sched_inactive_max;
 extern bool         sched_monitor_kill;
+extern unsigned int sched_slo_target;
+extern bool         sched_slo_reject;
 
 void dss_sched_fini(struct dss_xstream *dx);
 int dss_sched_init(struct dss_xstream *dx);
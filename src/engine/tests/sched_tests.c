@@ -0,0 +1,183 @@
+/*
+ * (C) Copyright 2026 Hewlett Packard Enterprise Development LP
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+
+/*
+ * Unit tests for the QoS token buckets, deficit round robin and latency SLO histogram
+ * of the scheduler
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include "../sched_qos.h"
+
+static void
+test_qos_unlimited(void **state)
+{
+	struct sched_qos_limit	limit = { 0 };
+	struct sched_qos_bucket	sqb = { 0 };
+
+	assert_false(qos_limited(&limit));
+
+	qos_bucket_set_limit(&sqb, &limit, 0);
+	qos_bucket_consume(&sqb, 1 << 20);
+	assert_true(qos_bucket_ready(&sqb));
+
+	sqb.sqb_queued       = 100;
+	sqb.sqb_queued_bytes = 100 << 20;
+	assert_int_equal(qos_bucket_backlog(&sqb), 0);
+}
+
+static void
+test_qos_iops(void **state)
+{
+	struct sched_qos_limit	limit = { .sql_iops = 10 };
+	struct sched_qos_bucket	sqb = { 0 };
+	int			i;
+
+	assert_true(qos_limited(&limit));
+	qos_bucket_set_limit(&sqb, &limit, 1000);
+
+	/* The bucket starts full, with one second worth of tokens */
+	for (i = 0; i < 10; i++) {
+		assert_true(qos_bucket_ready(&sqb));
+		qos_bucket_consume(&sqb, 0);
+	}
+	assert_false(qos_bucket_ready(&sqb));
+
+	/* One request per 100 msecs, a partial token is enough to run into deficit */
+	qos_bucket_refill(&sqb, 1001);
+	assert_true(qos_bucket_ready(&sqb));
+	qos_bucket_consume(&sqb, 0);
+	qos_bucket_refill(&sqb, 1100);
+	assert_false(qos_bucket_ready(&sqb));
+	qos_bucket_refill(&sqb, 1101);
+	assert_true(qos_bucket_ready(&sqb));
+
+	/* Burst is capped to one second */
+	qos_bucket_refill(&sqb, 60000);
+	assert_int_equal(sqb.sqb_iops_tokens, 10 * 1000);
+
+	/* 20 queued requests over 10 tokens, the other 10 take one second */
+	sqb.sqb_queued = 20;
+	assert_int_equal(qos_bucket_backlog(&sqb), 1000);
+
+	/* Limit change starts from a full bucket */
+	limit.sql_iops = 100;
+	qos_bucket_consume(&sqb, 0);
+	qos_bucket_set_limit(&sqb, &limit, 60000);
+	assert_int_equal(sqb.sqb_iops_tokens, 100 * 1000);
+}
+
+static void
+test_qos_bw_deficit(void **state)
+{
+	struct sched_qos_limit	limit = { .sql_bw = 1000 };
+	struct sched_qos_bucket	sqb = { 0 };
+	uint64_t		ts = 0;
+
+	qos_bucket_set_limit(&sqb, &limit, ts);
+
+	/* A large request runs the bucket into deficit, which is paid off over time */
+	assert_true(qos_bucket_ready(&sqb));
+	qos_bucket_consume(&sqb, 5000);
+	assert_false(qos_bucket_ready(&sqb));
+
+	sqb.sqb_queued_bytes = 1000;
+	assert_int_equal(qos_bucket_backlog(&sqb), 5000);
+
+	for (ts = 1000; ts <= 4000; ts += 1000) {
+		qos_bucket_refill(&sqb, ts);
+		assert_false(qos_bucket_ready(&sqb));
+	}
+	qos_bucket_refill(&sqb, 4001);
+	assert_true(qos_bucket_ready(&sqb));
+}
+
+static void
+test_qos_drr(void **state)
+{
+	int64_t	deficit = 0;
+	int	i;
+
+	/* Nothing is granted before the first round */
+	assert_false(qos_drr_ready(deficit, 4096));
+	assert_true(qos_drr_ready(deficit, 0));
+
+	qos_drr_round(&deficit, true);
+	assert_int_equal(deficit, SCHED_QOS_QUANTUM);
+	assert_true(qos_drr_ready(deficit, SCHED_QOS_QUANTUM / 2));
+	qos_drr_consume(&deficit, SCHED_QOS_QUANTUM / 2);
+
+	/* The unused deficit is carried over to the next round */
+	assert_false(qos_drr_ready(deficit, SCHED_QOS_QUANTUM));
+	qos_drr_round(&deficit, true);
+	assert_int_equal(deficit, SCHED_QOS_QUANTUM * 3 / 2);
+	assert_true(qos_drr_ready(deficit, SCHED_QOS_QUANTUM));
+	qos_drr_consume(&deficit, SCHED_QOS_QUANTUM);
+	assert_int_equal(deficit, SCHED_QOS_QUANTUM / 2);
+
+	/* ... and reset once the pool isn't backlogged */
+	qos_drr_round(&deficit, false);
+	assert_int_equal(deficit, 0);
+
+	/* A request larger than the cap runs at the cap */
+	for (i = 0; i < 100; i++)
+		qos_drr_round(&deficit, true);
+	assert_int_equal(deficit, SCHED_QOS_DEFICIT_MAX);
+	assert_true(qos_drr_ready(deficit, SCHED_QOS_DEFICIT_MAX * 4));
+	qos_drr_consume(&deficit, SCHED_QOS_DEFICIT_MAX * 4);
+	assert_int_equal(deficit, 0);
+}
+
+static void
+test_slo_p99(void **state)
+{
+	struct sched_slo_info	ssi = { 0 };
+	int			i;
+
+	assert_int_equal(slo_hist_p99(&ssi), 0);
+
+	for (i = 0; i < 100; i++)
+		slo_hist_add(&ssi, 0);
+	assert_int_equal(slo_hist_p99(&ssi), 0);
+
+	/* All samples in [4, 8) msecs, interpolated toward the upper bound */
+	slo_hist_reset(&ssi, 0);
+	for (i = 0; i < 100; i++)
+		slo_hist_add(&ssi, 5);
+	assert_int_equal(slo_hist_p99(&ssi), 7);
+
+	/* p99 rank is the first of the two samples in [64, 128) msecs */
+	slo_hist_reset(&ssi, 1000);
+	assert_int_equal(ssi.ssi_window_ts, 1000);
+	for (i = 0; i < 98; i++)
+		slo_hist_add(&ssi, 1);
+	slo_hist_add(&ssi, 100);
+	slo_hist_add(&ssi, 120);
+	assert_int_equal(slo_hist_p99(&ssi), 96);
+
+	/* Delays over the range are counted in the last bucket */
+	slo_hist_reset(&ssi, 2000);
+	slo_hist_add(&ssi, 1ULL << 40);
+	assert_int_equal(ssi.ssi_buckets[SCHED_SLO_BUCKETS - 1], 1);
+	assert_int_equal(slo_hist_p99(&ssi), 1U << (SCHED_SLO_BUCKETS - 1));
+}
+
+int
+main(void)
+{
+	const struct CMUnitTest tests[] = {
+	    cmocka_unit_test(test_qos_unlimited),
+	    cmocka_unit_test(test_qos_iops),
+	    cmocka_unit_test(test_qos_bw_deficit),
+	    cmocka_unit_test(test_qos_drr),
+	    cmocka_unit_test(test_slo_p99),
+	};
+
+	return cmocka_run_group_tests_name("sched_tests", tests, NULL, NULL);
+}
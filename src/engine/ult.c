@@ -17,6 +17,8 @@
 
 /** The maximum number of credits for each IO chore queue. That is per helper XS. */
 uint32_t dss_chore_credits;
+/** Idle helper XS steals chores from busy peers on the same NUMA node */
+bool     dss_chore_steal;
 
 struct aggregator_arg_type {
 	struct dss_stream_arg_type	at_args;
@@ -704,6 +706,89 @@ dss_chore_ult(void *arg)
 	dss_chore_diy_internal(chore);
 }
 
+static inline struct dss_chore_queue *
+dss_chore_queue_get(int xs_id)
+{
+	struct dss_xstream *dx = dss_get_xstream(xs_id);
+
+	/* See with_chore_queue in dss_srv_handler */
+	if (dx == NULL || !dx->dx_iofw || dx->dx_main_xs)
+		return NULL;
+	return &dx->dx_chore_queue;
+}
+
+/* Wake up an idle peer on the same NUMA node to steal chores from the busy queue */
+static void
+dss_chore_queue_kick(struct dss_chore_queue *busy)
+{
+	struct dss_chore_queue *peer;
+	bool                    idle;
+	int                     i;
+
+	for (i = dss_sys_xs_nr; i < DSS_XS_NR_TOTAL; i++) {
+		peer = dss_chore_queue_get(i);
+		/* chq_idle is read without lock as a hint */
+		if (peer == NULL || peer == busy || peer->chq_numa != busy->chq_numa ||
+		    !peer->chq_idle)
+			continue;
+
+		ABT_mutex_lock(peer->chq_mutex);
+		idle = peer->chq_idle && !peer->chq_stop;
+		if (idle)
+			ABT_cond_broadcast(peer->chq_cond);
+		ABT_mutex_unlock(peer->chq_mutex);
+		if (idle)
+			break;
+	}
+}
+
+/*
+ * Steal half of the new chores from the busiest peer on the same NUMA node. The
+ * stolen chores keep cho_hint pointing to the original queue, so the credits are
+ * returned to the original queue on dss_chore_deregister.
+ */
+static int
+dss_chore_queue_steal(struct dss_chore_queue *queue, d_list_t *list)
+{
+	struct dss_chore_queue *peer, *victim = NULL;
+	struct dss_chore       *chore;
+	uint32_t                depth = 1;
+	int                     i, nr;
+
+	/* chq_depth is read without lock as a hint */
+	for (i = dss_sys_xs_nr; i < DSS_XS_NR_TOTAL; i++) {
+		peer = dss_chore_queue_get(i);
+		if (peer == NULL || peer == queue || peer->chq_numa != queue->chq_numa)
+			continue;
+		if (peer->chq_depth > depth) {
+			depth  = peer->chq_depth;
+			victim = peer;
+		}
+	}
+
+	if (victim == NULL)
+		return 0;
+
+	ABT_mutex_lock(victim->chq_mutex);
+	nr = victim->chq_stop ? 0 : victim->chq_depth / 2;
+	for (i = 0; i < nr; i++) {
+		chore = d_list_entry(victim->chq_list.next, struct dss_chore, cho_link);
+		d_list_move_tail(&chore->cho_link, list);
+	}
+	victim->chq_depth -= nr;
+	if (victim->chq_depth_tm)
+		d_tm_set_gauge(victim->chq_depth_tm, victim->chq_depth);
+	ABT_mutex_unlock(victim->chq_mutex);
+
+	if (nr > 0) {
+		if (queue->chq_steal_tm)
+			d_tm_inc_counter(queue->chq_steal_tm, nr);
+		D_DEBUG(DB_TRACE, "queue %p stole %d chores from queue %p\n", queue, nr, victim);
+	}
+
+	return nr;
+}
+
 /**
  * Add \a chore for \a func to the chore queue of some other xstream.
  *
@@ -718,6 +803,7 @@ dss_chore_register(struct dss_chore *chore)
 	int                     xs_id;
 	struct dss_xstream     *dx;
 	struct dss_chore_queue *queue;
+	uint32_t                depth;
 
 	D_ASSERT(chore->cho_credits > 0);
 
@@ -762,9 +848,15 @@ dss_chore_register(struct dss_chore *chore)
 	queue->chq_credits -= chore->cho_credits;
 	chore->cho_hint = queue;
 	d_list_add_tail(&chore->cho_link, &queue->chq_list);
+	depth = ++queue->chq_depth;
+	if (queue->chq_depth_tm)
+		d_tm_set_gauge(queue->chq_depth_tm, depth);
 	ABT_cond_broadcast(queue->chq_cond);
 	ABT_mutex_unlock(queue->chq_mutex);
 
+	if (dss_chore_steal && depth > DSS_CHORE_STEAL_DEPTH)
+		dss_chore_queue_kick(queue);
+
 	D_DEBUG(DB_TRACE, "register chore %p on queue %p: tgt=%d -> xs=%d dx.tgt=%d, credits %u\n",
 		chore, queue, info->dmi_tgt_id, xs_id, dx->dx_tgt_id, chore->cho_credits);
 	return 0;
@@ -816,6 +908,7 @@ dss_chore_queue_ult(void *arg)
 		struct dss_chore *chore;
 		struct dss_chore *chore_tmp;
 		bool              stop = false;
+		int               nr;
 
 		/*
 		 * The scheduling order shall be
@@ -829,6 +922,9 @@ dss_chore_queue_ult(void *arg)
 		for (;;) {
 			if (!d_list_empty(&queue->chq_list)) {
 				d_list_splice_init(&queue->chq_list, &list);
+				queue->chq_depth = 0;
+				if (queue->chq_depth_tm)
+					d_tm_set_gauge(queue->chq_depth_tm, 0);
 				break;
 			}
 			if (!d_list_empty(&list))
@@ -837,7 +933,16 @@ dss_chore_queue_ult(void *arg)
 				stop = true;
 				break;
 			}
+			if (dss_chore_steal) {
+				ABT_mutex_unlock(queue->chq_mutex);
+				nr = dss_chore_queue_steal(queue, &list);
+				ABT_mutex_lock(queue->chq_mutex);
+				if (nr > 0)
+					continue;
+			}
+			queue->chq_idle = true;
 			sched_cond_wait_for_business(queue->chq_cond, queue->chq_mutex);
+			queue->chq_idle = false;
 		}
 		ABT_mutex_unlock(queue->chq_mutex);
 
@@ -877,8 +982,33 @@ dss_chore_queue_init(struct dss_xstream *dx)
 	int                     rc;
 
 	D_INIT_LIST_HEAD(&queue->chq_list);
-	queue->chq_stop = false;
-	queue->chq_credits = dss_chore_credits;
+	queue->chq_stop     = false;
+	queue->chq_idle     = false;
+	queue->chq_credits  = dss_chore_credits;
+	queue->chq_depth    = 0;
+	queue->chq_numa     = 0;
+	queue->chq_depth_tm = NULL;
+	queue->chq_steal_tm = NULL;
+
+	/* See dss_start_xs_id for how helper xstreams are split among NUMA nodes */
+	if (dss_numa_nr > 1 && dss_offload_per_numa_nr > 0 &&
+	    dx->dx_xs_id >= dss_sys_xs_nr + dss_tgt_nr)
+		queue->chq_numa = (dx->dx_xs_id - dss_sys_xs_nr - dss_tgt_nr) /
+				  dss_offload_per_numa_nr;
+
+	/* See with_chore_queue in dss_srv_handler */
+	if (dx->dx_iofw && !dx->dx_main_xs) {
+		rc = d_tm_add_metric(&queue->chq_depth_tm, D_TM_GAUGE, "Chore queue depth",
+				     "chore", "sched/chore_queue/xs_%u", dx->dx_xs_id);
+		if (rc)
+			D_WARN("Failed to create chore_queue telemetry: "DF_RC"\n", DP_RC(rc));
+
+		rc = d_tm_add_metric(&queue->chq_steal_tm, D_TM_COUNTER,
+				     "Chores stolen from peers", "chore",
+				     "sched/chore_steal/xs_%u", dx->dx_xs_id);
+		if (rc)
+			D_WARN("Failed to create chore_steal telemetry: "DF_RC"\n", DP_RC(rc));
+	}
 
 	rc = ABT_mutex_create(&queue->chq_mutex);
 	if (rc != ABT_SUCCESS) {
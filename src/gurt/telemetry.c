@@ -1356,6 +1356,54 @@ d_tm_print_gauge(uint64_t val, struct d_tm_stats_t *stats, char *name,
 		d_tm_print_stats(stream, stats, format);
 }
 
+/**
+ * Prints the sample count and the percentiles of a log-linear histogram with
+ * \a name to the \a stream provided
+ *
+ * \param[in]	count		Number of samples
+ * \param[in]	pcts		Percentiles requested, in the range [0, 100]
+ * \param[in]	vals		Values of the percentiles
+ * \param[in]	nr		Number of percentiles
+ * \param[in]	name		Histogram name
+ * \param[in]	format		Output format.
+ *				Choose D_TM_STANDARD for standard output.
+ *				Choose D_TM_CSV for comma separated values.
+ * \param[in]	units		The units expressed as a string
+ * \param[in]	opt_fields	A bitmask.  Set to D_TM_INCLUDE_TYPE to display
+ *				metric type.
+ * \param[in]	stream		Output stream (stdout, stderr)
+ */
+void
+d_tm_print_loghist(uint64_t count, double *pcts, uint64_t *vals, int nr, char *name,
+		   int format, char *units, int opt_fields, FILE *stream)
+{
+	int	i;
+
+	if ((name == NULL) || (stream == NULL))
+		return;
+
+	if (format == D_TM_CSV) {
+		fprintf(stream, "%s", name);
+		if (opt_fields & D_TM_INCLUDE_TYPE)
+			fprintf(stream, ",loghist");
+		fprintf(stream, ",%lu", count);
+		return;
+	}
+
+	if (opt_fields & D_TM_INCLUDE_TYPE)
+		fprintf(stream, "type: loghist, ");
+	fprintf(stream, "%s: %lu samples", name, count);
+	if (count == 0)
+		return;
+
+	fprintf(stream, " [");
+	for (i = 0; i < nr; i++)
+		fprintf(stream, "%sp%g: %lu", i == 0 ? "" : ", ", pcts[i], vals[i]);
+	fprintf(stream, "]");
+	if (units != NULL)
+		fprintf(stream, " %s", units);
+}
+
 /**
  * Client function to print the metadata strings \a desc and \a units
  * to the \a stream provided
@@ -1423,6 +1471,9 @@ d_tm_print_node(struct d_tm_context *ctx, struct d_tm_node_t *node, int level,
 	char               *desc           = NULL;
 	char               *units          = NULL;
 	struct d_tm_meminfo_t	meminfo;
+	double              pcts[]         = {50, 90, 99, 99.9};
+	uint64_t            pct_vals[ARRAY_SIZE(pcts)];
+	uint32_t            trace_nr;
 	bool                stats_printed  = false;
 	bool                show_timestamp = false;
 	bool                show_meta      = false;
@@ -1538,6 +1589,32 @@ d_tm_print_node(struct d_tm_context *ctx, struct d_tm_node_t *node, int level,
 		if (stats.sample_size > 0)
 			stats_printed = true;
 		break;
+	case D_TM_LOGHIST:
+		rc = d_tm_get_percentiles(ctx, &val, pcts, pct_vals, ARRAY_SIZE(pcts), node);
+		if (rc != DER_SUCCESS) {
+			fprintf(stream, "Error on loghist read: %d\n", rc);
+			break;
+		}
+		d_tm_print_loghist(val, pcts, pct_vals, ARRAY_SIZE(pcts), name, format, units,
+				   opt_fields, stream);
+		break;
+	case D_TM_TRACE:
+		rc = d_tm_get_trace(ctx, NULL, &trace_nr, node);
+		if (rc != DER_SUCCESS) {
+			fprintf(stream, "Error on trace read: %d\n", rc);
+			break;
+		}
+		if (format == D_TM_CSV) {
+			fprintf(stream, "%s", name);
+			if (opt_fields & D_TM_INCLUDE_TYPE)
+				fprintf(stream, ",trace");
+			fprintf(stream, ",%u", trace_nr);
+		} else {
+			if (opt_fields & D_TM_INCLUDE_TYPE)
+				fprintf(stream, "type: trace, ");
+			fprintf(stream, "%s: %u records", name, trace_nr);
+		}
+		break;
 	default:
 		fprintf(stream, "Item: %s has unknown type: 0x%x\n", name,
 			node->dtn_type);
@@ -1633,7 +1710,9 @@ _reset_node(struct d_tm_context *ctx, struct d_tm_node_t *node)
 	struct d_tm_metric_t	*metric_data = NULL;
 	struct d_tm_stats_t	*dtm_stats = NULL;
 	struct d_tm_histogram_t *dtm_histogram = NULL;
+	struct d_tm_loghist_t   *dtm_loghist   = NULL;
 	struct d_tm_mem_hdr     *mem_hdr       = NULL;
+	uint64_t                *counts;
 	int			 rc;
 
 	if (ctx == NULL || node == NULL)
@@ -1649,11 +1728,19 @@ _reset_node(struct d_tm_context *ctx, struct d_tm_node_t *node)
 
 	dtm_stats     = conv_ptr(mem_hdr, metric_data->dtm_stats);
 	dtm_histogram = conv_ptr(mem_hdr, metric_data->dtm_histogram);
+	dtm_loghist   = conv_ptr(mem_hdr, metric_data->dtm_loghist);
 	d_tm_node_lock(node);
 	memset(&metric_data->dtm_data, 0, sizeof(metric_data->dtm_data));
 	if (dtm_stats != NULL)
 		memset(dtm_stats, 0, sizeof(*dtm_stats));
 
+	if (dtm_loghist != NULL) {
+		counts = conv_ptr(mem_hdr, dtm_loghist->dtl_counts);
+		if (counts != NULL)
+			memset(counts, 0, (size_t)dtm_loghist->dtl_nr_shards *
+				       dtm_loghist->dtl_nr_buckets * sizeof(*counts));
+	}
+
 	if (dtm_histogram != NULL) {
 		int i;
 
@@ -1700,8 +1787,12 @@ d_tm_reset_node(struct d_tm_context *ctx, struct d_tm_node_t *node, int level, c
 	case (D_TM_DURATION | D_TM_CLOCK_THREAD_CPUTIME):
 	case D_TM_GAUGE:
 	case D_TM_STATS_GAUGE:
+	case D_TM_LOGHIST:
 		_reset_node(ctx, node);
 		break;
+	case D_TM_TRACE:
+		/* Single writer ring, the old records are overwritten on wrap */
+		break;
 	default:
 		fprintf(stream, "Item: %s has unknown type: 0x%x\n", name,
 			node->dtn_type);
@@ -2240,6 +2331,117 @@ d_tm_dec_gauge(struct d_tm_node_t *metric, uint64_t value)
 	d_tm_node_unlock(metric);
 }
 
+/** Index of the log-linear histogram bucket for \a value */
+static inline uint32_t
+loghist_bucket(uint32_t sub_bits, uint32_t max_bits, uint64_t value)
+{
+	int	shift;
+
+	if (value >= (1ULL << max_bits))
+		value = (1ULL << max_bits) - 1;
+
+	if (value < (1ULL << sub_bits))
+		return value;
+
+	shift = 63 - __builtin_clzl(value) - sub_bits;
+	return ((uint32_t)shift << sub_bits) + (value >> shift);
+}
+
+/** The smallest and the largest values counted in the log-linear histogram \a bucket */
+static inline void
+loghist_bucket_range(uint32_t sub_bits, uint32_t bucket, uint64_t *min, uint64_t *max)
+{
+	uint32_t	shift;
+	uint64_t	sub;
+
+	if (bucket < (1U << sub_bits)) {
+		*min = *max = bucket;
+		return;
+	}
+
+	shift = (bucket >> sub_bits) - 1;
+	sub = bucket - (shift << sub_bits);
+	*min = sub << shift;
+	*max = ((sub + 1) << shift) - 1;
+}
+
+/**
+ * Record a sample \a value in the log-linear histogram.  Each writer is expected
+ * to use its own \a shard, the counter is updated without taking the node lock.
+ *
+ * \param[in]	metric	Pointer to the metric
+ * \param[in]	shard	Shard of the caller, e.g. the target index of the xstream
+ * \param[in]	value	The sample value
+ */
+void
+d_tm_record_loghist(struct d_tm_node_t *metric, int shard, uint64_t value)
+{
+	struct d_tm_loghist_t	*loghist;
+	uint64_t		*counter;
+
+	if (metric == NULL)
+		return;
+
+	if (unlikely(metric->dtn_type != D_TM_LOGHIST)) {
+		D_ERROR("Failed to record loghist [%s] on item "
+			"not a loghist.  Operation mismatch: " DF_RC "\n",
+			metric->dtn_name, DP_RC(-DER_OP_NOT_PERMITTED));
+		return;
+	}
+
+	loghist = metric->dtn_metric->dtm_loghist;
+	if (unlikely(loghist == NULL || shard < 0 || shard >= loghist->dtl_nr_shards))
+		return;
+
+	counter = &loghist->dtl_counts[(size_t)shard * loghist->dtl_nr_buckets +
+				       loghist_bucket(loghist->dtl_sub_bits, loghist->dtl_max_bits,
+						      value)];
+	atomic_fetch_add_relaxed((_Atomic uint64_t *)counter, 1);
+}
+
+/**
+ * Append a record to the trace ring, the oldest record is overwritten when the
+ * ring is full.  The ring has a single writer, it is updated without taking the
+ * node lock.
+ *
+ * \param[in]	metric	Pointer to the metric
+ * \param[in]	id	Identifier of the traced request
+ * \param[in]	opc	Opcode of the traced request
+ * \param[in]	phase	Phase of the request reached
+ */
+void
+d_tm_record_trace(struct d_tm_node_t *metric, uint64_t id, uint32_t opc, uint32_t phase)
+{
+	struct d_tm_trace_t	*trace;
+	struct d_tm_trace_rec	*rec;
+	struct timespec		 now;
+	uint64_t		 head;
+
+	if (metric == NULL)
+		return;
+
+	if (unlikely(metric->dtn_type != D_TM_TRACE)) {
+		D_ERROR("Failed to record trace [%s] on item "
+			"not a trace.  Operation mismatch: " DF_RC "\n",
+			metric->dtn_name, DP_RC(-DER_OP_NOT_PERMITTED));
+		return;
+	}
+
+	trace = metric->dtn_metric->dtm_trace;
+	if (unlikely(trace == NULL))
+		return;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	head = atomic_load_relaxed((_Atomic uint64_t *)&trace->dtt_head);
+	rec  = &trace->dtt_recs[head & (trace->dtt_nr_recs - 1)];
+
+	rec->dtr_ts    = now.tv_sec * NSEC_PER_SEC + now.tv_nsec;
+	rec->dtr_id    = id;
+	rec->dtr_opc   = opc;
+	rec->dtr_phase = phase;
+	atomic_store_release((_Atomic uint64_t *)&trace->dtt_head, head + 1);
+}
+
 /**
  * Convert a D_TM_CLOCK_* type into a clockid_t
  *
@@ -2599,6 +2801,191 @@ failure:
 	return rc;
 }
 
+/**
+ * Adds a new log-linear histogram metric at the specified path.  The counters of
+ * \a nr_shards shards are allocated from the shared memory at this time, so that
+ * the recording is lock free and allocation free.
+ *
+ * \param[out]	node		Points to the new metric if supplied
+ * \param[in]	nr_shards	Number of writers recording the histogram
+ * \param[in]	sub_bits	Linear sub-buckets per power of two range, in
+ *				bits.  D_TM_LOGHIST_SUB_BITS is the default.
+ * \param[in]	max_bits	Values at or above 2^max_bits are counted in the
+ *				last bucket.  Must be > sub_bits and < 64.
+ * \param[in]	desc		A description of the metric containing
+ *				D_TM_MAX_DESC_LEN - 1 characters maximum
+ * \param[in]	units		A string defining the units of the metric
+ *				containing D_TM_UNIT_LEN - 1 characters maximum
+ * \param[in]	fmt		Format specifier for the name and full path of
+ *				the new metric followed by optional args to
+ *				populate the string, printf style.
+ * \return			DER_SUCCESS		Success
+ *				-DER_NO_SHMEM		Out of shared memory
+ *				-DER_INVAL		Invalid parameters
+ *				-DER_OP_NOT_PERMITTED	Metric exists but is
+ *							not a loghist
+ *				-DER_ADD_METRIC_FAILED	Operation failed
+ *				-DER_UNINIT		API not initialized
+ */
+int
+d_tm_add_loghist(struct d_tm_node_t **node, int nr_shards, int sub_bits, int max_bits,
+		 char *desc, char *units, const char *fmt, ...)
+{
+	struct d_tm_node_t	*tmp_node = NULL;
+	struct d_tm_loghist_t	*loghist;
+	struct d_tm_mem_hdr	*mem_hdr;
+	char			 path[D_TM_MAX_NAME_LEN] = {};
+	uint32_t		 nr_buckets;
+	int			 rc;
+	va_list			 args;
+
+	if (!is_initialized())
+		return -DER_UNINIT;
+
+	if (fmt == NULL || nr_shards < 1 || sub_bits < 0 || sub_bits > D_TM_LOGHIST_SUB_BITS_MAX ||
+	    max_bits <= sub_bits || max_bits >= 64)
+		return -DER_INVAL;
+
+	va_start(args, fmt);
+	rc = parse_path_fmt(path, sizeof(path), fmt, args);
+	va_end(args);
+	if (rc != 0)
+		goto failure;
+
+	rc = d_tm_lock_shmem();
+	if (rc != 0) {
+		D_ERROR("Failed to get mutex: " DF_RC "\n", DP_RC(rc));
+		goto failure;
+	}
+
+	/* Added by another writer sharing the histogram */
+	tmp_node = d_tm_find_metric(tm_mem.ctx, path);
+	if (tmp_node != NULL) {
+		if (tmp_node->dtn_type != D_TM_LOGHIST)
+			D_GOTO(unlock, rc = -DER_OP_NOT_PERMITTED);
+		d_tm_unlock_shmem();
+		if (node != NULL)
+			*node = tmp_node;
+		return DER_SUCCESS;
+	}
+
+	D_DEBUG(DB_TRACE, "adding loghist: [%s]\n", path);
+	rc = add_metric(tm_mem.ctx, &tmp_node, D_TM_LOGHIST, desc, units, path);
+	if (rc != 0)
+		goto unlock;
+
+	mem_hdr = get_mem_region_for_key(tm_mem.ctx, tmp_node->dtn_shmem_key);
+	if (mem_hdr == NULL)
+		D_GOTO(unlock, rc = -DER_NO_SHMEM);
+
+	nr_buckets = D_TM_LOGHIST_NR_BUCKETS(sub_bits, max_bits);
+	loghist = tm_alloc(mem_hdr, sizeof(*loghist));
+	if (loghist == NULL)
+		D_GOTO(unlock, rc = -DER_NO_SHMEM);
+
+	loghist->dtl_counts = tm_alloc(mem_hdr, nr_shards * nr_buckets * sizeof(uint64_t));
+	if (loghist->dtl_counts == NULL)
+		D_GOTO(unlock, rc = -DER_NO_SHMEM);
+
+	loghist->dtl_sub_bits = sub_bits;
+	loghist->dtl_max_bits = max_bits;
+	loghist->dtl_nr_buckets = nr_buckets;
+	loghist->dtl_nr_shards = nr_shards;
+	tmp_node->dtn_metric->dtm_loghist = loghist;
+
+	d_tm_unlock_shmem();
+	if (node != NULL)
+		*node = tmp_node;
+	return DER_SUCCESS;
+
+unlock:
+	d_tm_unlock_shmem();
+failure:
+	D_ERROR("Failed to add loghist [%s]: " DF_RC "\n", path, DP_RC(rc));
+	return rc;
+}
+
+/**
+ * Adds a new trace ring metric at the specified path.  The \a nr_recs records
+ * are allocated from the shared memory at this time, so that the recording is
+ * lock free and allocation free.
+ *
+ * \param[out]	node		Points to the new metric if supplied
+ * \param[in]	nr_recs		Number of records in the ring, must be a power
+ *				of two
+ * \param[in]	desc		A description of the metric containing
+ *				D_TM_MAX_DESC_LEN - 1 characters maximum
+ * \param[in]	fmt		Format specifier for the name and full path of
+ *				the new metric followed by optional args to
+ *				populate the string, printf style.
+ * \return			DER_SUCCESS		Success
+ *				-DER_NO_SHMEM		Out of shared memory
+ *				-DER_INVAL		Invalid parameters
+ *				-DER_EXIST		Metric already exists
+ *				-DER_ADD_METRIC_FAILED	Operation failed
+ *				-DER_UNINIT		API not initialized
+ */
+int
+d_tm_add_trace(struct d_tm_node_t **node, uint32_t nr_recs, char *desc, const char *fmt, ...)
+{
+	struct d_tm_node_t	*tmp_node = NULL;
+	struct d_tm_trace_t	*trace;
+	struct d_tm_mem_hdr	*mem_hdr;
+	char			 path[D_TM_MAX_NAME_LEN] = {};
+	int			 rc;
+	va_list			 args;
+
+	if (!is_initialized())
+		return -DER_UNINIT;
+
+	if (fmt == NULL || nr_recs == 0 || (nr_recs & (nr_recs - 1)) != 0)
+		return -DER_INVAL;
+
+	va_start(args, fmt);
+	rc = parse_path_fmt(path, sizeof(path), fmt, args);
+	va_end(args);
+	if (rc != 0)
+		goto failure;
+
+	rc = d_tm_lock_shmem();
+	if (rc != 0) {
+		D_ERROR("Failed to get mutex: " DF_RC "\n", DP_RC(rc));
+		goto failure;
+	}
+
+	D_DEBUG(DB_TRACE, "adding trace: [%s]\n", path);
+	rc = add_metric(tm_mem.ctx, &tmp_node, D_TM_TRACE, desc, NULL, path);
+	if (rc != 0)
+		goto unlock;
+
+	mem_hdr = get_mem_region_for_key(tm_mem.ctx, tmp_node->dtn_shmem_key);
+	if (mem_hdr == NULL)
+		D_GOTO(unlock, rc = -DER_NO_SHMEM);
+
+	trace = tm_alloc(mem_hdr, sizeof(*trace));
+	if (trace == NULL)
+		D_GOTO(unlock, rc = -DER_NO_SHMEM);
+
+	trace->dtt_recs = tm_alloc(mem_hdr, nr_recs * sizeof(*trace->dtt_recs));
+	if (trace->dtt_recs == NULL)
+		D_GOTO(unlock, rc = -DER_NO_SHMEM);
+
+	trace->dtt_head = 0;
+	trace->dtt_nr_recs = nr_recs;
+	tmp_node->dtn_metric->dtm_trace = trace;
+
+	d_tm_unlock_shmem();
+	if (node != NULL)
+		*node = tmp_node;
+	return DER_SUCCESS;
+
+unlock:
+	d_tm_unlock_shmem();
+failure:
+	D_ERROR("Failed to add trace [%s]: " DF_RC "\n", path, DP_RC(rc));
+	return rc;
+}
+
 static void
 invalidate_link_node(struct d_tm_mem_hdr *parent, struct d_tm_node_t *node)
 {
@@ -3796,6 +4183,183 @@ d_tm_get_gauge(struct d_tm_context *ctx, uint64_t *val,
 	return DER_SUCCESS;
 }
 
+/**
+ * Client function to read the percentiles of the specified log-linear histogram.
+ * The shards are merged on read.  The value reported for each percentile is the
+ * midpoint of the bucket it falls into.
+ *
+ * \param[in]	ctx	Client context
+ * \param[out]	count	Total number of samples
+ * \param[in]	pcts	Percentiles requested, in the range [0, 100]
+ * \param[out]	vals	The values of the percentiles are stored here,
+ *			0 if there isn't any sample
+ * \param[in]	nr	Number of percentiles
+ * \param[in]	node	Pointer to the stored metric node
+ *
+ * \return	DER_SUCCESS		Success
+ *		-DER_INVAL		Invalid input
+ *		-DER_METRIC_NOT_FOUND	Metric not found
+ *		-DER_OP_NOT_PERMITTED	Metric was not a loghist
+ *		-DER_NOMEM		Out of heap
+ */
+int
+d_tm_get_percentiles(struct d_tm_context *ctx, uint64_t *count, double *pcts, uint64_t *vals,
+		     int nr, struct d_tm_node_t *node)
+{
+	struct d_tm_metric_t	*metric_data = NULL;
+	struct d_tm_loghist_t	*loghist;
+	struct d_tm_mem_hdr     *mem_hdr     = NULL;
+	uint64_t		*counts;
+	uint64_t		*merged;
+	uint64_t		 total = 0, rank, cum, min, max;
+	uint32_t		 i, j;
+	int			 k, rc;
+
+	if (ctx == NULL || count == NULL || node == NULL || (nr > 0 && (pcts == NULL ||
+	    vals == NULL)))
+		return -DER_INVAL;
+
+	rc = validate_node_ptr(ctx, node, &mem_hdr);
+	if (rc != 0)
+		return rc;
+
+	if (node->dtn_type != D_TM_LOGHIST)
+		return -DER_OP_NOT_PERMITTED;
+
+	if (unlikely(!node_is_readable(node)))
+		return -DER_AGAIN;
+
+	metric_data = conv_ptr(mem_hdr, node->dtn_metric);
+	if (metric_data == NULL)
+		return -DER_METRIC_NOT_FOUND;
+
+	loghist = conv_ptr(mem_hdr, metric_data->dtm_loghist);
+	if (loghist == NULL)
+		return -DER_AGAIN;
+
+	counts = conv_ptr(mem_hdr, loghist->dtl_counts);
+	if (counts == NULL)
+		return -DER_METRIC_NOT_FOUND;
+
+	D_ALLOC_ARRAY(merged, loghist->dtl_nr_buckets);
+	if (merged == NULL)
+		return -DER_NOMEM;
+
+	for (i = 0; i < loghist->dtl_nr_shards; i++) {
+		for (j = 0; j < loghist->dtl_nr_buckets; j++) {
+			merged[j] += atomic_load_relaxed((_Atomic uint64_t *)counts);
+			counts++;
+		}
+	}
+
+	for (j = 0; j < loghist->dtl_nr_buckets; j++)
+		total += merged[j];
+	*count = total;
+
+	for (k = 0; k < nr; k++) {
+		vals[k] = 0;
+		if (total == 0)
+			continue;
+
+		rank = (uint64_t)ceil(pcts[k] / 100 * total);
+		if (rank == 0)
+			rank = 1;
+		else if (rank > total)
+			rank = total;
+
+		for (j = 0, cum = 0; j < loghist->dtl_nr_buckets; j++) {
+			cum += merged[j];
+			if (cum >= rank)
+				break;
+		}
+		D_ASSERT(j < loghist->dtl_nr_buckets);
+		loghist_bucket_range(loghist->dtl_sub_bits, j, &min, &max);
+		vals[k] = min + (max - min) / 2;
+	}
+
+	D_FREE(merged);
+	return DER_SUCCESS;
+}
+
+/**
+ * Client function to copy the records of the specified trace ring, oldest first.
+ * The records overwritten by the writer while being copied are dropped.
+ *
+ * \param[in]	ctx	Client context
+ * \param[out]	recs	The records are stored here.  If NULL, only the number
+ *			of records available in the ring is returned.
+ * \param[in,out]	nr	[in] Capacity of \a recs
+ *			[out] Number of records returned
+ * \param[in]	node	Pointer to the stored metric node
+ *
+ * \return	DER_SUCCESS		Success
+ *		-DER_INVAL		Invalid input
+ *		-DER_METRIC_NOT_FOUND	Metric not found
+ *		-DER_OP_NOT_PERMITTED	Metric was not a trace
+ */
+int
+d_tm_get_trace(struct d_tm_context *ctx, struct d_tm_trace_rec *recs, uint32_t *nr,
+	       struct d_tm_node_t *node)
+{
+	struct d_tm_metric_t	*metric_data = NULL;
+	struct d_tm_trace_t	*trace;
+	struct d_tm_trace_rec	*ring;
+	struct d_tm_mem_hdr     *mem_hdr     = NULL;
+	uint64_t		 head, start, valid, i;
+	uint32_t		 cnt;
+	int			 rc;
+
+	if (ctx == NULL || nr == NULL || node == NULL)
+		return -DER_INVAL;
+
+	rc = validate_node_ptr(ctx, node, &mem_hdr);
+	if (rc != 0)
+		return rc;
+
+	if (node->dtn_type != D_TM_TRACE)
+		return -DER_OP_NOT_PERMITTED;
+
+	if (unlikely(!node_is_readable(node)))
+		return -DER_AGAIN;
+
+	metric_data = conv_ptr(mem_hdr, node->dtn_metric);
+	if (metric_data == NULL)
+		return -DER_METRIC_NOT_FOUND;
+
+	trace = conv_ptr(mem_hdr, metric_data->dtm_trace);
+	if (trace == NULL)
+		return -DER_AGAIN;
+
+	ring = conv_ptr(mem_hdr, trace->dtt_recs);
+	if (ring == NULL)
+		return -DER_METRIC_NOT_FOUND;
+
+	head = atomic_load_explicit((_Atomic uint64_t *)&trace->dtt_head, memory_order_acquire);
+	cnt  = min(head, trace->dtt_nr_recs);
+	if (recs == NULL) {
+		*nr = cnt;
+		return DER_SUCCESS;
+	}
+
+	cnt   = min(cnt, *nr);
+	start = head - cnt;
+	for (i = 0; i < cnt; i++)
+		recs[i] = ring[(start + i) & (trace->dtt_nr_recs - 1)];
+
+	/* The slot of record (head - nr_recs) may be overwritten by now */
+	atomic_thread_fence(memory_order_acquire);
+	head = atomic_load_relaxed((_Atomic uint64_t *)&trace->dtt_head);
+	valid = head >= trace->dtt_nr_recs ? head - trace->dtt_nr_recs + 1 : 0;
+	if (valid > start) {
+		i = min(valid - start, cnt);
+		cnt -= i;
+		memmove(recs, &recs[i], cnt * sizeof(*recs));
+	}
+
+	*nr = cnt;
+	return DER_SUCCESS;
+}
+
 /**
  * Client function to read the metadata for the specified metric.
  * Memory is allocated for the \a desc and \a units and should be freed by the
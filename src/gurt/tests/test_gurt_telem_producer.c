@@ -678,6 +678,120 @@ test_gauge_with_histogram_multiplier_2(void **state)
 	check_histogram_metadata(path);
 }
 
+static void
+test_loghist(void **state)
+{
+	struct d_tm_node_t	*loghist;
+	struct d_tm_node_t	*tmp;
+	double			 pcts[] = {0, 50, 99, 100};
+	uint64_t		 vals[ARRAY_SIZE(pcts)];
+	uint64_t		 exp[] = {1, 5000, 9900, 10000};
+	uint64_t		 count;
+	char			*path = "gurt/tests/telem/test_loghist";
+	int			 nr_shards = 4;
+	int			 i;
+	int			 rc;
+
+	rc = d_tm_add_loghist(&loghist, nr_shards, D_TM_LOGHIST_SUB_BITS, D_TM_LOGHIST_MAX_BITS,
+			      "A log-linear histogram", D_TM_MICROSECOND, path);
+	assert_rc_equal(rc, DER_SUCCESS);
+
+	/* Writers sharing the histogram get the same node */
+	rc = d_tm_add_loghist(&tmp, nr_shards, D_TM_LOGHIST_SUB_BITS, D_TM_LOGHIST_MAX_BITS,
+			      "A log-linear histogram", D_TM_MICROSECOND, path);
+	assert_rc_equal(rc, DER_SUCCESS);
+	assert_ptr_equal(tmp, loghist);
+
+	rc = d_tm_add_loghist(&tmp, 0, D_TM_LOGHIST_SUB_BITS, D_TM_LOGHIST_MAX_BITS, NULL, NULL,
+			      "gurt/tests/telem/test_loghist_inval");
+	assert_rc_equal(rc, -DER_INVAL);
+
+	for (i = 1; i <= 10000; i++)
+		d_tm_record_loghist(loghist, i % nr_shards, i);
+	/* Out of range shard is ignored */
+	d_tm_record_loghist(loghist, nr_shards, 1);
+
+	rc = d_tm_get_percentiles(cli_ctx, &count, pcts, vals, ARRAY_SIZE(pcts),
+				  srv_to_cli_node(loghist));
+	assert_rc_equal(rc, DER_SUCCESS);
+	assert_int_equal(count, 10000);
+
+	/* Relative error is bounded by 2^-(sub_bits + 1) */
+	for (i = 0; i < ARRAY_SIZE(pcts); i++) {
+		uint64_t	diff = vals[i] > exp[i] ? vals[i] - exp[i] : exp[i] - vals[i];
+
+		assert_true(diff * (2 << D_TM_LOGHIST_SUB_BITS) <= exp[i]);
+	}
+
+	/* Values beyond the range are counted in the last bucket */
+	d_tm_record_loghist(loghist, 0, UINT64_MAX);
+	rc = d_tm_get_percentiles(cli_ctx, &count, &pcts[3], &vals[3], 1,
+				  srv_to_cli_node(loghist));
+	assert_rc_equal(rc, DER_SUCCESS);
+	assert_int_equal(count, 10001);
+	assert_true(vals[3] < (1ULL << D_TM_LOGHIST_MAX_BITS));
+	assert_true(vals[3] >= (1ULL << (D_TM_LOGHIST_MAX_BITS - 1)));
+
+	d_tm_reset_node(cli_ctx, srv_to_cli_node(loghist), 0, NULL, D_TM_STANDARD, 0, stdout);
+	rc = d_tm_get_percentiles(cli_ctx, &count, pcts, vals, ARRAY_SIZE(pcts),
+				  srv_to_cli_node(loghist));
+	assert_rc_equal(rc, DER_SUCCESS);
+	assert_int_equal(count, 0);
+	assert_int_equal(vals[1], 0);
+}
+
+static void
+test_trace(void **state)
+{
+	struct d_tm_node_t	*trace;
+	struct d_tm_trace_rec	 recs[16];
+	uint32_t		 nr_recs = 8;
+	uint32_t		 nr;
+	int			 i;
+	int			 rc;
+
+	rc = d_tm_add_trace(&trace, 6, "Not a power of two", "gurt/tests/telem/test_trace_inval");
+	assert_rc_equal(rc, -DER_INVAL);
+
+	rc = d_tm_add_trace(&trace, nr_recs, "A trace ring", "gurt/tests/telem/test_trace");
+	assert_rc_equal(rc, DER_SUCCESS);
+
+	for (i = 0; i < 5; i++)
+		d_tm_record_trace(trace, i, 1, i);
+
+	nr = ARRAY_SIZE(recs);
+	rc = d_tm_get_trace(cli_ctx, recs, &nr, srv_to_cli_node(trace));
+	assert_rc_equal(rc, DER_SUCCESS);
+	assert_int_equal(nr, 5);
+	for (i = 0; i < nr; i++) {
+		assert_int_equal(recs[i].dtr_id, i);
+		assert_int_equal(recs[i].dtr_phase, i);
+		if (i > 0)
+			assert_true(recs[i].dtr_ts >= recs[i - 1].dtr_ts);
+	}
+
+	/* Oldest records are overwritten on wrap, the reader gets the newest ones */
+	for (i = 5; i < 20; i++)
+		d_tm_record_trace(trace, i, 1, i);
+
+	nr = ARRAY_SIZE(recs);
+	rc = d_tm_get_trace(cli_ctx, recs, &nr, srv_to_cli_node(trace));
+	assert_rc_equal(rc, DER_SUCCESS);
+	assert_true(nr > 0 && nr <= nr_recs);
+	assert_int_equal(recs[nr - 1].dtr_id, 19);
+	assert_int_equal(recs[0].dtr_id, 20 - nr);
+
+	nr = 2;
+	rc = d_tm_get_trace(cli_ctx, recs, &nr, srv_to_cli_node(trace));
+	assert_rc_equal(rc, DER_SUCCESS);
+	assert_int_equal(nr, 2);
+	assert_int_equal(recs[0].dtr_id, 18);
+
+	rc = d_tm_get_trace(cli_ctx, NULL, &nr, srv_to_cli_node(trace));
+	assert_rc_equal(rc, DER_SUCCESS);
+	assert_int_equal(nr, nr_recs);
+}
+
 static void
 test_units(void **state)
 {
@@ -1419,6 +1533,8 @@ main(int argc, char **argv)
 	    cmocka_unit_test(test_gauge_with_histogram_multiplier_1),
 	    cmocka_unit_test(test_gauge_with_histogram_multiplier_2),
 	    cmocka_unit_test(benchmark_histogram_fast_vs_slow),
+	    cmocka_unit_test(test_loghist),
+	    cmocka_unit_test(test_trace),
 	    cmocka_unit_test(test_units),
 	    cmocka_unit_test(test_ephemeral_simple),
 	    cmocka_unit_test(test_ephemeral_nested),
@@ -552,6 +552,19 @@ crt_req_dst_tag_get(crt_rpc_t *req, uint32_t *tag);
 int
 crt_req_src_timeout_get(crt_rpc_t *rpc, uint32_t *timeout);
 
+/**
+ * Return the RPC id, it is unique among the RPCs sent by the origin and the
+ * same as logged by CaRT for the request
+ *
+ * \param[in] req              Pointer to RPC request
+ * \param[out] rpcid           Returned RPC id
+ *
+ * \return                     DER_SUCCESS on success or error
+ *                             on failure
+ */
+int
+crt_req_rpcid_get(crt_rpc_t *req, uint64_t *rpcid);
+
 /**
  * Return reply buffer
  *
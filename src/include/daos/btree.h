@@ -564,8 +564,14 @@ int  dbtree_fetch_prev(daos_handle_t toh, d_iov_t *key_out, d_iov_t *val_out, bo
 int  dbtree_fetch_next(daos_handle_t toh, d_iov_t *key_out, d_iov_t *val_out, bool move);
 int  dbtree_upsert(daos_handle_t toh, dbtree_probe_opc_t opc, uint32_t intent,
 		   d_iov_t *key, d_iov_t *val, d_iov_t *val_out);
+/** Fetch the next record for dbtree_bulk_load, return 1 if there is no more */
+typedef int (*dbtree_bulk_next_t)(void *arg, d_iov_t *key, d_iov_t *val);
+int  dbtree_bulk_load(daos_handle_t toh, dbtree_bulk_next_t next, void *arg);
+int  dbtree_upsert_batch(daos_handle_t toh, d_iov_t *keys, d_iov_t *vals, int nr);
 int  dbtree_delete(daos_handle_t toh, dbtree_probe_opc_t opc,
 		   d_iov_t *key, void *args);
+int  dbtree_delete_range(daos_handle_t toh, d_iov_t *key_lo, d_iov_t *key_hi,
+			 void *args);
 int  dbtree_query(daos_handle_t toh, struct btr_attr *attr,
 		  struct btr_stat *stat);
 int  dbtree_is_empty(daos_handle_t toh);
@@ -37,6 +37,8 @@
 #define DAOS_PROP_ENTRY_ACL             "acl"
 #define DAOS_PROP_ENTRY_SCRUB_DISABLED  "scrub_disabled"
 #define DAOS_PROP_ENTRY_ROOT_OIDS       "root_oids"
+#define DAOS_PROP_ENTRY_QOS_IOPS        "qos_iops"
+#define DAOS_PROP_ENTRY_QOS_BW          "qos_bw"
 
 /** DAOS deprecated property entry names keeped for backward compatibility */
 #define DAOS_PROP_ENTRY_REDUN_FAC_OLD	"rf"
@@ -61,6 +63,9 @@ struct cont_props {
 	uint32_t	 dcp_perf_domain;
 	uint32_t	 dcp_global_version;
 	uint32_t	 dcp_obj_version;
+	/** QoS limits of client I/O (IOPS, MiB/s), 0 means unlimited */
+	uint64_t	 dcp_qos_iops;
+	uint64_t	 dcp_qos_bw;
 	uint32_t	 dcp_csum_enabled:1,
 			 dcp_srv_verify:1,
 			 dcp_dedup_enabled:1,
@@ -167,6 +172,15 @@ daos_cont_prop2global_version(daos_prop_t *prop);
 uint32_t
 daos_cont_prop2obj_version(daos_prop_t *prop);
 
+/**
+ * QoS limit properties
+ */
+uint64_t
+daos_cont_prop2qos_iops(daos_prop_t *prop);
+
+uint64_t
+daos_cont_prop2qos_bw(daos_prop_t *prop);
+
 static inline uint32_t
 daos_cont_props2pda(struct cont_props *props, bool is_ec_obj)
 {
@@ -0,0 +1,69 @@
+/**
+ * (C) Copyright 2026 Hewlett Packard Enterprise Development LP
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+/**
+ * This file is part of daos
+ *
+ * src/include/daos/io_trace.h
+ *
+ * Phases of the sampled I/O request tracing, shared by the engine which records
+ * the phase markers and the tool which dumps them as per-request timelines.
+ */
+
+#ifndef __DAOS_IO_TRACE_H__
+#define __DAOS_IO_TRACE_H__
+
+#include <stdint.h>
+
+/** Telemetry directory of the per-xstream trace rings, "io/trace/xs_$id" */
+#define IO_TRACE_DIR		"io/trace"
+/** Number of records in each per-xstream trace ring */
+#define IO_TRACE_NR_RECS	2048
+
+#define IO_TRACE_PHASES						\
+	X(RECV,		"recv")		/* RPC received */	\
+	X(DISPATCH,	"dispatch")	/* Handler ULT created */ \
+	X(HANDLER,	"handler")	/* Handler started */	\
+	X(VOS_BEGIN,	"vos_begin")	/* VOS tree operations */ \
+	X(VOS_END,	"vos_end")				\
+	X(DMA_BEGIN,	"dma_begin")	/* bio_iod_prep() */	\
+	X(DMA_END,	"dma_end")				\
+	X(BULK_BEGIN,	"bulk_begin")	/* Bulk transfer */	\
+	X(BULK_END,	"bulk_end")				\
+	X(NVME_BEGIN,	"nvme_begin")	/* bio_iod_post() */	\
+	X(NVME_END,	"nvme_end")				\
+	X(DTX_BEGIN,	"dtx_begin")	/* DTX commit */	\
+	X(DTX_END,	"dtx_end")				\
+	X(DONE,		"done")		/* Handler completed */
+
+enum io_trace_phase {
+#define X(phase, name)	IO_TRACE_##phase,
+	IO_TRACE_PHASES
+#undef X
+	IO_TRACE_PHASE_MAX,
+};
+
+/** Tracing state of a RPC */
+struct io_trace {
+	uint64_t	it_id;		/* RPC id */
+	uint32_t	it_opc;		/* RPC opcode */
+	uint32_t	it_sampled;	/* The RPC is traced */
+};
+
+static inline const char *
+io_trace_phase2name(unsigned int phase)
+{
+	static const char *names[] = {
+#define X(phase, name)	name,
+		IO_TRACE_PHASES
+#undef X
+	};
+
+	if (phase >= IO_TRACE_PHASE_MAX)
+		return "unknown";
+	return names[phase];
+}
+
+#endif /* __DAOS_IO_TRACE_H__ */
@@ -40,11 +40,23 @@ struct daos_llink {
 	uint32_t		 ll_ref;	/**< refcount for this ref */
 	uint32_t		 ll_evicted:1;	/**< has been evicted */
 	uint32_t		 ll_wait_evict:1; /**< wait for completion of eviction */
+	uint32_t		 ll_clock_ref:1; /**< referenced bit, CLOCK mode only */
+	uint32_t		 ll_hash;	/**< key hash, CLOCK mode only */
+	uint32_t		 ll_slot;	/**< slot index, CLOCK mode only */
 	struct daos_llink_ops	*ll_ops;	/**< ops to maintain refs */
 };
 
 /**
- * LRU cache implementation using d_hash_table and d_list_t
+ * Replace the hash table and LRU list with an open-addressing table and a
+ * CLOCK (second chance) sweep. A cache hit only sets the referenced bit of the
+ * item, it never touches any list. The cache is never locked, so it must be
+ * private to one xstream.
+ */
+#define DAOS_LRU_FT_CLOCK	(1U << 31)
+
+/**
+ * LRU cache implementation using d_hash_table and d_list_t, or an open-addressing
+ * table swept by a CLOCK hand if it is created with DAOS_LRU_FT_CLOCK.
  */
 struct daos_lru_cache {
 	uint32_t		 dlc_csize;	/**< Provided cache size */
@@ -52,6 +64,13 @@ struct daos_lru_cache {
 	d_list_t		 dlc_lru;	/**< list head of LRU */
 	struct d_hash_table	 dlc_htable;	/**< Hash table for all refs */
 	struct daos_llink_ops	*dlc_ops;	/**< ops to maintain refs */
+	/** CLOCK mode: open-addressing slots, NULL for the LRU mode */
+	struct daos_llink	**dlc_slots;
+	uint32_t		 dlc_slots_mask; /**< number of slots - 1 */
+	uint32_t		 dlc_hand;	/**< CLOCK hand */
+	uint32_t		 dlc_idle;	/**< CLOCK mode: unused refs */
+	uint64_t		 dlc_hits;	/**< number of cache hits */
+	uint64_t		 dlc_misses;	/**< number of cache misses */
 };
 
 /**
@@ -59,7 +78,8 @@ struct daos_lru_cache {
  * This function creates an LRU cache in DRAM
  *
  * \param[in]  bits		power2(bits) is the size of the LRU cache
- * \param[in]  feats		Feature bits for DHASH, see DHASH_FT_*
+ * \param[in]  feats		Feature bits for DHASH, see DHASH_FT_*, and
+ *				DAOS_LRU_FT_CLOCK
  * \param[in]  ops		DAOS LRU callbacks
  * \param[out] lcache		Newly created LRU cache
  *
@@ -121,6 +141,13 @@ daos_lru_ref_hold(struct daos_lru_cache *lcache, void *key, unsigned int ksize,
 void
 daos_lru_ref_release(struct daos_lru_cache *lcache, struct daos_llink *llink);
 
+/** Whether the cache is in CLOCK mode */
+static inline bool
+daos_lru_is_clock(struct daos_lru_cache *lcache)
+{
+	return lcache->dlc_slots != NULL;
+}
+
 /**
  * Evict the item from LRU before releasing the refcount on it.
  *
@@ -134,7 +161,9 @@ daos_lru_ref_evict(struct daos_lru_cache *lcache, struct daos_llink *llink)
 		return;
 
 	llink->ll_evicted = 1;
-	d_hash_rec_evict_at(&lcache->dlc_htable, &llink->ll_link);
+	/* CLOCK lookup skips evicted item, it is removed on the last release */
+	if (!daos_lru_is_clock(lcache))
+		d_hash_rec_evict_at(&lcache->dlc_htable, &llink->ll_link);
 }
 
 /**
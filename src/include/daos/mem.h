@@ -277,6 +277,8 @@ struct umem_cache {
 	d_list_t         ca_pgs_pinned;
 	/** Highest committed transaction ID */
 	uint64_t         ca_commit_id;
+	/** Lowest non-durable transaction ID of pages dirtied during checkpoint, 0 if none */
+	uint64_t         ca_chkpt_min_inflight;
 	/** Callback to tell if a page is evictable */
 	bool		 (*ca_evictable_fn)(void *arg, uint32_t pg_id);
 	/** Callback being called on page loaded/evicted */
@@ -515,20 +517,34 @@ umem_cache_touch(struct umem_store *store, uint64_t wr_tx, umem_off_t addr, daos
 typedef void
 umem_cache_wait_cb_t(void *arg, uint64_t chkpt_tx, uint64_t *committed_tx);
 
+/** Callback invoked by checkpoint after each batch of dirty pages is durable on MD-blob.
+ *
+ * \param[in]	arg		Argument passed to umem_cache_checkpoint
+ * \param[in]	durable_tx	All WAL transactions up to (and including) this ID are durable
+ *				on MD-blob and their WAL space can be reclaimed, 0 if none
+ * \param[in]	flushed_bytes	Bytes written to MD-blob by this batch
+ */
+typedef void
+umem_cache_batch_cb_t(void *arg, uint64_t durable_tx, uint64_t flushed_bytes);
+
 /**
  * This function can yield internally, it is called by checkpoint service of upper level stack.
+ * Dirty pages are flushed in batches, oldest dirty pages first and in MD-blob offset order
+ * within a batch, so WAL space can be reclaimed incrementally through \a batch_cb.
  *
  * \param[in]		store		The umem store
  * \param[in]		wait_cb		Callback for to wait for wal commit completion
- * \param[in]		arg		argument for wait_cb
+ * \param[in]		batch_cb	Optional callback called when a batch is durable
+ * \param[in]		arg		argument for wait_cb and batch_cb
  * \param[in,out]	chkpt_id	Input is last committed id, output is checkpointed id
  * \param[out]		chkpt_stats	check point stats
  *
  * \return 0 on success
  */
 int
-umem_cache_checkpoint(struct umem_store *store, umem_cache_wait_cb_t wait_cb, void *arg,
-		      uint64_t *chkpt_id, struct umem_cache_chkpt_stats *chkpt_stats);
+umem_cache_checkpoint(struct umem_store *store, umem_cache_wait_cb_t wait_cb,
+		      umem_cache_batch_cb_t batch_cb, void *arg, uint64_t *chkpt_id,
+		      struct umem_cache_chkpt_stats *chkpt_stats);
 
 #endif /*DAOS_PMEM_BUILD*/
 
@@ -272,6 +272,12 @@ dc_pipeline_run_task_create(daos_handle_t coh, daos_handle_t oh, daos_handle_t t
 			    d_sg_list_t *sgl_recx, daos_size_t *recx_size, d_sg_list_t *sgl_agg,
 			    daos_pipeline_stats_t *stats, daos_event_t *ev, tse_sched_t *tse,
 			    tse_task_t **task);
+int
+dc_pipeline_scan_task_create(daos_handle_t coh, daos_handle_t oh, daos_handle_t th,
+			     daos_pipeline_t *pipeline, uint64_t flags, uint32_t *nr_iods,
+			     daos_iod_t *iods, daos_pipeline_stream_t *stream,
+			     d_sg_list_t *sgl_agg, daos_pipeline_stats_t *stats, daos_event_t *ev,
+			     tse_sched_t *tse, tse_task_t **task);
 
 void *
 dc_task_get_args(tse_task_t *task);
@@ -120,6 +120,17 @@ typedef struct {
 	 *          Records in, and records (meeting condition) out
 	 *   -- DAOS_FILTER_AGGREGATION:
 	 *          Records in, a single value out (see aggregation functions above)
+	 *   -- DAOS_FILTER_GROUP_BY:
+	 *          Key of the groups the aggregations are computed for. The filter is an
+	 *          expression (a dkey, an akey, or an arithmetic function), evaluated for every
+	 *          record passing the conditions. Records with the same key are aggregated
+	 *          together, and one row with the aggregated values is returned per group.
+	 *   -- DAOS_FILTER_ORDER_BY, DAOS_FILTER_ORDER_BY_DESC:
+	 *          Key the returned records are sorted by (in increasing or decreasing order). The
+	 *          filter is an expression, as for DAOS_FILTER_GROUP_BY. Only the first
+	 *          \a limit records in that order are returned (see daos_pipeline_t).
+	 *
+	 *       NULL keys (e.g., a missing akey) are smaller than any other key.
 	 *
 	 * NOTE: Pipeline nodes can only be chained the following way:
 	 *             (condition) --> (condition)
@@ -169,8 +180,35 @@ typedef struct {
 	 * Pointer to the first aggregation filter in the array of filters.
 	 */
 	daos_filter_t **aggr_filters;
+	/**
+	 * Optional DAOS_FILTER_GROUP_BY filter. Needs at least one aggregation filter.
+	 */
+	daos_filter_t  *group_by;
+	/**
+	 * Optional DAOS_FILTER_ORDER_BY(_DESC) filter. Needs \a limit, and can't be used with
+	 * aggregations.
+	 */
+	daos_filter_t  *order_by;
+	/**
+	 * Max number of records (or groups) returned by the whole scan, over all the calls to
+	 * daos_pipeline_run() sharing an anchor. The scan stops as soon as the limit is reached.
+	 * 0 for no limit. Can't be used with aggregations, unless grouped.
+	 */
+	uint64_t        limit;
 } daos_pipeline_t;
 
+/**
+ * Counters of one part of a filter, see daos_pipeline_stats_t.
+ */
+typedef struct {
+	/** number of times the part was evaluated */
+	uint64_t nr_evals;
+	/** number of evaluations where the part was false */
+	uint64_t nr_false;
+	/** total time spent evaluating the part, in nanoseconds */
+	uint64_t eval_ns;
+} daos_pipeline_part_stats_t;
+
 /**
  * Gather some statistics of daos_pipeline_run(); like the number of items that have been scanned.
  */
@@ -192,8 +230,47 @@ typedef struct {
 	 * akeys are being filtered from a particular dkey.
 	 */
 	uint64_t nr_akeys;
+	/**
+	 * Optional array of counters for the parts of the (non aggregation) filters. Part \a j of
+	 * filter \a i is at index num_parts(filter 0) + ... + num_parts(filter i - 1) + j.
+	 * Counters are only kept for the operands of AND and OR functions, which are reordered
+	 * during the scan to evaluate first the cheapest operands deciding the result most often.
+	 * They are measured on a sample of the scanned records, and are left at zero for the other
+	 * parts. \a nr_parts is the number of entries in \a parts (0 if not needed).
+	 */
+	uint32_t                    nr_parts;
+	daos_pipeline_part_stats_t *parts;
 } daos_pipeline_stats_t;
 
+/**
+ * Callback of daos_pipeline_scan(), receiving the records returned by one round trip to one shard
+ * of the object. The arguments are the same as the outputs of daos_pipeline_run(), and are only
+ * valid during the call. Callbacks of the same scan are never called concurrently, but records of
+ * different shards are received in no particular order. Returning non-zero stops the scan, and
+ * the value is returned by daos_pipeline_scan().
+ */
+typedef int (*daos_pipeline_recs_cb_t)(void *arg, uint32_t nr_kds, daos_key_desc_t *kds,
+				       d_sg_list_t *sgl_keys, uint32_t nr_iods,
+				       daos_size_t *recx_size, d_sg_list_t *sgl_recx);
+
+/**
+ * How daos_pipeline_scan() runs the shards of the object, and where the records are returned.
+ */
+typedef struct {
+	/** max number of shards scanned at the same time, 0 to scan all of them at once */
+	uint32_t                max_inflight;
+	/** max number of records returned by one round trip to a shard */
+	uint32_t                nr_kds;
+	/** size of the buffer for the dkeys returned by one round trip */
+	daos_size_t             keys_buf_size;
+	/** size of the buffer for the akey data returned by one round trip */
+	daos_size_t             recx_buf_size;
+	/** receives the records, not needed with aggregations */
+	daos_pipeline_recs_cb_t recs_cb;
+	/** first argument of \a recs_cb */
+	void                   *cb_arg;
+} daos_pipeline_stream_t;
+
 /**
  * Initializes a new pipeline object.
  *
@@ -282,7 +359,9 @@ daos_pipeline_free(daos_pipeline_t *pipeline);
  *
  * \param[in,out]	anchor		Hash anchor for the next call, it should be set to zeroes
  *					for the first call, it should not be changed by caller
- *					between calls.
+ *					between calls. Pipelines with a GROUP BY or ORDER BY filter
+ *					scan all the shards of the object in a single call, and
+ *					always return an EOF anchor.
  *
  * \param[in,out]	nr_kds		[in]: Number of key descriptors in \a kds.
  *					[out]: Number of returned key descriptors.
@@ -320,10 +399,20 @@ daos_pipeline_free(daos_pipeline_t *pipeline);
  *					numeric type of the akey being aggregated. This means that
  *					the buffer for each iov should be at least 8 bytes.
  *					[out]: All returned aggregated values.
+ *					With a GROUP BY filter, one row is returned per group, in
+ *					increasing order of the group keys: the key of group \a j
+ *					is returned in \a sgl_keys and \a kds[j] (8 bytes for
+ *					numeric keys, the data for strings, 0 bytes for NULL), and
+ *					its aggregated values at index \a j of the array of doubles
+ *					in each iov of \a sgl_agg, which has to be large enough for
+ *					\a nr_kds doubles. -DER_TRUNC is returned when there are
+ *					more than \a nr_kds groups (the first \a nr_kds groups are
+ *					still returned).
  *
  * \param[out]		stats		[in]: Optional preallocated object.
  *					[out]: The total number of items (objects, dkeys, and akeys)
- *					scanned while filtering and/or aggregating.
+ *					scanned while filtering and/or aggregating, and the
+ *					counters of the filter parts if \a stats->parts is set.
  *
  * \param[in]		ev		Completion event. It is optional. Function will run in
  *					blocking mode if \a ev is NULL.
@@ -335,6 +424,46 @@ daos_pipeline_run(daos_handle_t coh, daos_handle_t oh, daos_pipeline_t *pipeline
 		  d_sg_list_t *sgl_keys, d_sg_list_t *sgl_recx, daos_size_t *recx_size,
 		  d_sg_list_t *sgl_agg, daos_pipeline_stats_t *stats, daos_event_t *ev);
 
+/**
+ * Runs a pipeline on all the shards of an object in a single call. Up to
+ * \a stream->max_inflight shards are scanned concurrently, instead of one shard after the other as
+ * with the anchor of daos_pipeline_run(), so the scan takes about the time of the slowest shard.
+ * Records are passed to \a stream->recs_cb as soon as each shard returns them, in buffers allocated
+ * for each shard being scanned. Aggregations are merged into \a sgl_agg as the results of each
+ * shard arrive. Pipelines with a GROUP BY or ORDER BY filter are not supported (they already
+ * scan all the shards in a single call of daos_pipeline_run()).
+ *
+ * \params[in]		coh		Container open handle.
+ *
+ * \param[in]		oh		Object open handle.
+ *
+ * \param[in]		pipeline	Pipeline object. With a limit, at most \a pipeline->limit
+ *					records are passed to \a stream->recs_cb.
+ *
+ * \param[in]		th		Optional transaction handle. Use DAOS_TX_NONE for an
+ *					independent transaction.
+ *
+ * \param[in]		flags		Conditional operations.
+ *
+ * \param[in]		nr_iods		Number of I/O descriptors in the iods table.
+ *
+ * \param[in]		iods		Array of I/O descriptors, see daos_pipeline_run().
+ *
+ * \param[in]		stream		Shards scanned at once, buffer sizes and callback.
+ *
+ * \param[in,out]	sgl_agg		Optional, as in daos_pipeline_run().
+ *
+ * \param[in,out]	stats		Optional, as in daos_pipeline_run().
+ *
+ * \param[in]		ev		Completion event. It is optional. Function will run in
+ *					blocking mode if \a ev is NULL.
+ */
+int
+daos_pipeline_scan(daos_handle_t coh, daos_handle_t oh, daos_pipeline_t *pipeline, daos_handle_t th,
+		   uint64_t flags, uint32_t *nr_iods, daos_iod_t *iods,
+		   daos_pipeline_stream_t *stream, d_sg_list_t *sgl_agg,
+		   daos_pipeline_stats_t *stats, daos_event_t *ev);
+
 #if defined(__cplusplus)
 }
 #endif
@@ -140,6 +140,12 @@ enum daos_pool_props {
 	DAOS_PROP_PO_SVC_OPS_ENABLED,
 	/** Metadata duplicate operations SVC_OPS KVS max entry age (seconds), default 300 */
 	DAOS_PROP_PO_SVC_OPS_ENTRY_AGE,
+	/** QoS limit of client I/O operations per second for the pool, 0 means unlimited */
+	DAOS_PROP_PO_QOS_IOPS,
+	/** QoS limit of client I/O bandwidth (MiB/s) for the pool, 0 means unlimited */
+	DAOS_PROP_PO_QOS_BW,
+	/** p99 queueing delay target (ms) of client I/O for the pool, 0 means the engine default */
+	DAOS_PROP_PO_QOS_SLO,
 	DAOS_PROP_PO_MAX,
 };
 
@@ -270,6 +276,11 @@ enum {
 #define DAOS_PROP_PO_SVC_OPS_ENTRY_AGE_DEFAULT 300       /* 300 seconds */
 #define DAOS_PROP_PO_SVC_OPS_ENTRY_AGE_MIN     60        /* 60 seconds */
 #define DAOS_PROP_PO_SVC_OPS_ENTRY_AGE_MAX     600       /* 600 seconds */
+#define DAOS_PROP_PO_QOS_IOPS_DEFAULT          0         /* unlimited */
+#define DAOS_PROP_PO_QOS_BW_DEFAULT            0         /* unlimited */
+#define DAOS_PROP_PO_QOS_SLO_DEFAULT           0         /* engine default */
+#define DAOS_PROP_CO_QOS_IOPS_DEFAULT          0         /* unlimited */
+#define DAOS_PROP_CO_QOS_BW_DEFAULT            0         /* unlimited */
 
 /** self healing strategy bits */
 #define DAOS_SELF_HEAL_AUTO_EXCLUDE	(1U << 0)
@@ -395,6 +406,10 @@ enum daos_cont_props {
 	DAOS_PROP_CO_OBJ_VERSION,
 	/** The container performance domain, now always inherit from pool */
 	DAOS_PROP_CO_PERF_DOMAIN,
+	/** QoS limit of client I/O operations per second for the container, 0 means unlimited */
+	DAOS_PROP_CO_QOS_IOPS,
+	/** QoS limit of client I/O bandwidth (MiB/s) for the container, 0 means unlimited */
+	DAOS_PROP_CO_QOS_BW,
 	DAOS_PROP_CO_MAX,
 };
 
@@ -661,6 +661,32 @@ int bio_write(struct bio_io_context *ctxt, bio_addr_t addr, d_iov_t *iov);
  */
 int bio_read(struct bio_io_context *ctxt, bio_addr_t addr, d_iov_t *iov);
 
+/*
+ * I/O classes of the per-xstream blobstore I/O scheduler. Foreground I/O is never throttled,
+ * other classes are subject to per-class queue depth and bandwidth limits.
+ */
+enum bio_io_class {
+	BIO_IOC_FG	= 0,	/* Foreground I/O */
+	BIO_IOC_CHKPT,		/* Metadata checkpointing */
+	BIO_IOC_REBUILD,	/* Rebuild/migration */
+	BIO_IOC_AGG,		/* Aggregation */
+	BIO_IOC_SCRUB,		/* Checksum scrubbing */
+	BIO_IOC_MAX,
+};
+
+/**
+ * Read from per VOS instance blob, the I/O is scheduled in specified I/O class.
+ *
+ * \param[IN] ctxt	VOS instance I/O context
+ * \param[IN] addr	SPDK blob addr info including byte offset
+ * \param[IN] iov	IO vector containing buffer from read
+ * \param[IN] ioc	I/O class, see bio_io_class
+ *
+ * \returns		Zero on success, negative value on error
+ */
+int bio_read_class(struct bio_io_context *ctxt, bio_addr_t addr, d_iov_t *iov,
+		   enum bio_io_class ioc);
+
 /**
  * Write SGL to per VOS instance blob.
  *
@@ -1092,6 +1118,7 @@ struct bio_wal_stats {
 	uint32_t	ws_size;	/* WAL size for single tx in bytes */
 	uint32_t	ws_qd;		/* WAL tx QD */
 	uint32_t	ws_waiters;	/* Waiters for WAL reclaiming */
+	uint32_t	ws_batch_txs;	/* Transactions committed by the same WAL write */
 };
 
 /*
@@ -1137,6 +1164,9 @@ struct bio_wal_rp_stats {
 	uint64_t	wrs_sz;		/* bytes replayed */
 	uint64_t	wrs_entries;	/* replayed entries count */
 	uint64_t	wrs_tx_cnt;	/* total transactions */
+	uint64_t	wrs_load_tm;	/* time waiting for WAL loading */
+	uint64_t	wrs_verify_tm;	/* time on verifying transactions */
+	uint64_t	wrs_apply_tm;	/* time on replaying transactions */
 };
 
 /*
@@ -17,6 +17,7 @@
 #include <daos/rpc.h>
 #include <daos/cont_props.h>
 #include <daos/tls.h>
+#include <daos/io_trace.h>
 #include <daos_srv/iv.h>
 #include <daos_srv/vos_types.h>
 #include <daos_srv/pool.h>
@@ -167,6 +168,43 @@ enum {
 	SCHED_REQ_FL_RESENT	= (1 << 3),
 };
 
+/* QoS limits of client IO on current target, 0 means unlimited */
+struct sched_qos_limit {
+	/* IO requests per second */
+	uint64_t	sql_iops;
+	/* Bytes per second */
+	uint64_t	sql_bw;
+};
+
+/**
+ * Sampled I/O request tracing. 1 of every dss_trace_sample RPCs is traced, its
+ * phase markers are recorded into the trace ring of current xstream, keyed by
+ * the RPC id and opcode. Tracing is disabled when dss_trace_sample is 0.
+ */
+extern unsigned int dss_trace_sample;
+
+void
+dss_trace_rpc_init(crt_rpc_t *rpc, struct io_trace *trace, enum io_trace_phase phase);
+void
+dss_trace_mark(struct io_trace *trace, enum io_trace_phase phase);
+
+/**
+ * Decide if the RPC is traced and mark the first \a phase if it is. The overhead
+ * is a single branch when tracing is disabled.
+ */
+static inline void
+dss_trace_rpc(crt_rpc_t *rpc, struct io_trace *trace, enum io_trace_phase phase)
+{
+	if (unlikely(dss_trace_sample != 0))
+		dss_trace_rpc_init(rpc, trace, phase);
+}
+
+#define DSS_TRACE(trace, phase)						\
+	do {								\
+		if (unlikely((trace)->it_sampled))			\
+			dss_trace_mark(trace, IO_TRACE_##phase);	\
+	} while (0)
+
 struct sched_req_attr {
 	uuid_t		sra_pool_id;
 	uint32_t	sra_type;
@@ -174,6 +212,15 @@ struct sched_req_attr {
 	uint32_t	sra_timeout;
 	/* Hint for RPC rejection */
 	uint64_t	sra_enqueue_id;
+	/* Container ID (valid if sra_cont_qos is set) and payload size of QoS limited IO */
+	uuid_t		sra_cont_id;
+	uint64_t	sra_size;
+	struct sched_qos_limit	sra_pool_qos;
+	struct sched_qos_limit	sra_cont_qos;
+	/* p99 queueing delay target (msecs) of client IO for the pool, 0 for engine default */
+	uint32_t	sra_slo_target;
+	/* Tracing state of the sampled RPC */
+	struct io_trace	sra_trace;
 };
 
 static inline void
@@ -183,6 +230,12 @@ sched_req_attr_init(struct sched_req_attr *attr, unsigned int type,
 	attr->sra_type = type;
 	attr->sra_flags = 0;
 	uuid_copy(attr->sra_pool_id, *pool_id);
+	uuid_clear(attr->sra_cont_id);
+	attr->sra_size = 0;
+	memset(&attr->sra_pool_qos, 0, sizeof(attr->sra_pool_qos));
+	memset(&attr->sra_cont_qos, 0, sizeof(attr->sra_cont_qos));
+	attr->sra_slo_target = 0;
+	memset(&attr->sra_trace, 0, sizeof(attr->sra_trace));
 }
 
 struct sched_request;	/* Opaque schedule request */
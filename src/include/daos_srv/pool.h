@@ -119,6 +119,15 @@ struct ds_pool {
 	uint32_t                 sp_checkpoint_freq;
 	uint32_t                 sp_checkpoint_thresh;
 	uint32_t		 sp_reint_mode;
+	/** Pool-wide QoS limits (IOPS, MiB/s) for client I/O, 0 means unlimited */
+	uint64_t		 sp_qos_iops;
+	uint64_t		 sp_qos_bw;
+	/** p99 queueing delay target (msecs) of client I/O, 0 means the engine default */
+	uint32_t		 sp_qos_slo;
+	/** Number of UP/UPIN targets sharing the pool-wide QoS limits */
+	uint32_t		 sp_qos_tgt_nr;
+	/** Set once any container of the pool has QoS limits */
+	bool			 sp_cont_qos;
 	/* Hold wlock when recover container, rlock when handle container create/destroy RPC. */
 	ABT_rwlock               sp_recov_lock;
 };
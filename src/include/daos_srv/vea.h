@@ -1,5 +1,6 @@
 /**
  * (C) Copyright 2018-2023 Intel Corporation.
+ * (C) Copyright 2026 Hewlett Packard Enterprise Development LP
  *
  * SPDX-License-Identifier: BSD-2-Clause-Patent
  */
@@ -111,14 +112,17 @@ struct vea_attr {
 struct vea_stat {
 	uint64_t	vs_free_persistent;	/* Persistent free blocks */
 	uint64_t	vs_free_transient;	/* Transient free blocks */
+	uint64_t	vs_free_mag;	/* Free blocks cached in magazines, in vs_free_transient */
 	uint64_t	vs_resrv_hint;	/* Number of hint reserve */
 	uint64_t	vs_resrv_large;	/* Number of large reserve */
 	uint64_t	vs_resrv_small;	/* Number of small reserve */
 	uint64_t	vs_resrv_bitmap; /* Number of bitmap reserve */
+	uint64_t	vs_resrv_mag;	/* Number of magazine reserve */
 	uint64_t	vs_frags_large;	/* Large free frags */
 	uint64_t	vs_frags_small;	/* Small free frags */
 	uint64_t	vs_frags_bitmap; /* Bitmap frags */
 	uint64_t	vs_frags_aging;	/* Aging frags */
+	uint64_t	vs_frag_index;	/* Fragmentation index in per mille */
 };
 
 struct vea_space_info;
@@ -357,4 +361,25 @@ int vea_metrics_count(void);
  */
 int vea_enumerate_free(struct vea_space_info *vsi, vea_free_callback_t cb, void *cb_arg);
 
+/**
+ * Check if the extent locates in the region being compacted, caller (VOS aggregation)
+ * is expected to relocate the extent when it returns true.
+ *
+ * \param vsi        [IN]	In-memory compound index
+ * \param blk_off    [IN]	Block offset of the extent
+ * \param blk_cnt    [IN]	Blocks to be rewritten for relocating the extent
+ *
+ * \return			True if the extent needs be relocated
+ */
+bool vea_compact_needed(struct vea_space_info *vsi, uint64_t blk_off, uint32_t blk_cnt);
+
+/**
+ * Account the blocks relocated for compaction against the compaction budget, it's
+ * supposed to be called after the relocation is committed.
+ *
+ * \param vsi        [IN]	In-memory compound index
+ * \param blk_cnt    [IN]	Rewritten blocks
+ */
+void vea_compact_done(struct vea_space_info *vsi, uint32_t blk_cnt);
+
 #endif /* __VEA_API_H__ */
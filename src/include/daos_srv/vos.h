@@ -1552,18 +1552,23 @@ void vos_db_fini(void);
 typedef void (*vos_chkpt_update_cb_t)(void *arg, uint64_t commit_id, uint32_t used_blocks,
 				      uint32_t total_blocks);
 typedef void (*vos_chkpt_wait_cb_t)(void *arg, uint64_t chkpt_id, uint64_t *committed_id);
+typedef void (*vos_chkpt_sleep_cb_t)(void *arg, uint32_t msecs);
 /**
  * Initialize checkpointing callbacks, retrieve the store.  Function will invoke commit_cb and
  * reserve_cb to initialize values.
  *
  * \param[in]	poh		Open pool handle
  * \param[in]	update_cb	Callback to invoke after wal changes
+ * \param[in]	wait_cb		Callback to wait for wal commit
+ * \param[in]	sleep_cb	Optional callback to sleep when the checkpoint is throttled by
+ *				DAOS_MD_CHKPT_MAX_BW, no throttling if it's NULL
  * \param[in]	arg		Callback argument
  * \param[out]	store		Return the umem_store associated with the pool
  */
 void
 vos_pool_checkpoint_init(daos_handle_t poh, vos_chkpt_update_cb_t update_cb,
-			 vos_chkpt_wait_cb_t wait_cb, void *arg, struct umem_store **store);
+			 vos_chkpt_wait_cb_t wait_cb, vos_chkpt_sleep_cb_t sleep_cb, void *arg,
+			 struct umem_store **store);
 
 /**
  * Clears saved checkpoint callbacks to avoid any race on shutdown
@@ -1754,6 +1759,85 @@ vos_obj_key2anchor(daos_handle_t coh, daos_unit_oid_t oid, daos_key_t *dkey, dao
 int
 vos_obj_layout_upgrade(daos_handle_t hdl, daos_unit_oid_t oid, uint32_t layout_ver);
 
+/**
+ * Get the summary of the dkeys and single values of an object. The summary is kept in the
+ * object cache and maintained by updates, it has to be built by vos_obj_summ_build() after the
+ * object is loaded into the cache. This function never scans the object.
+ *
+ * \param[in]	coh	Container open handle
+ * \param[in]	oid	Object ID
+ * \param[out]	summ	Copy of the summary
+ *
+ * \return 0 on success, -DER_NONEXIST if the object doesn't exist, -DER_AGAIN if the summary
+ *	   isn't built, -DER_INPROGRESS if it's being built, error otherwise.
+ */
+int
+vos_obj_summ_get(daos_handle_t coh, daos_unit_oid_t oid, struct vos_obj_summ *summ);
+
+/**
+ * Build the summary of an object by scanning all the versions of its keys and values. The scan
+ * yields every \a credits dkeys, the updates made meanwhile are added to the summary. Nothing is
+ * done if the summary is already built or being built.
+ *
+ * \param[in]	coh		Container open handle
+ * \param[in]	oid		Object ID
+ * \param[in]	credits		Number of dkeys scanned between yields, 0 for the default
+ * \param[in]	yield_func	Called to yield, the build is aborted if it returns a negative
+ *				value. bio_yield() is used if it's NULL.
+ * \param[in]	yield_arg	Argument of \a yield_func
+ *
+ * \return 0 on success, -DER_NONEXIST if the object doesn't exist, -DER_CANCELED if aborted
+ *	   by \a yield_func, -DER_AGAIN if the object was evicted from the cache, error otherwise.
+ */
+int
+vos_obj_summ_build(daos_handle_t coh, daos_unit_oid_t oid, uint32_t credits,
+		   int (*yield_func)(void *arg), void *yield_arg);
+
+/**
+ * Find the range of the values of an akey in an object summary.
+ *
+ * \param[in]	summ	Object summary
+ * \param[in]	akey	Attribute key
+ *
+ * \return range of the values of \a akey, with sr_nr == 0 if the akey has no single value,
+ *	   or NULL if the values of \a akey are not summarized.
+ */
+const struct vos_summ_range *
+vos_obj_summ_akey(struct vos_obj_summ *summ, daos_key_t *akey);
+
+/**
+ * Check whether a dkey may be in an object, according to its summary.
+ *
+ * \param[in]	summ	Object summary
+ * \param[in]	dkey	Distribution key
+ *
+ * \return false if \a dkey is certainly not in the object.
+ */
+bool
+vos_obj_summ_dkey_maybe(struct vos_obj_summ *summ, daos_key_t *dkey);
+
+/**
+ * Hold an object through the object cache and release it, without touching its trees.
+ * It is used to benchmark the object cache.
+ *
+ * \param[in]	coh	Container open handle
+ * \param[in]	oid	Object ID
+ *
+ * \return 0 on success, -DER_NONEXIST if the object doesn't exist, error otherwise.
+ */
+int
+vos_obj_cache_probe(daos_handle_t coh, daos_unit_oid_t oid);
+
+/**
+ * Get the number of hits and misses of the object cache used by a container.
+ *
+ * \param[in]	coh	Container open handle
+ * \param[out]	hits	Number of cache hits
+ * \param[out]	misses	Number of cache misses
+ */
+void
+vos_obj_cache_stat(daos_handle_t coh, uint64_t *hits, uint64_t *misses);
+
 /**
  * Init standalone VOS TLS.
  * \param[in]	tags
@@ -611,6 +611,52 @@ struct vos_iter_anchors {
 	unsigned int ia_probe_level;
 };
 
+/** Number of bits of the Bloom filter of the dkeys of an object summary */
+#define VOS_SUMM_BLOOM_BITS	1024
+/** Max number of akeys whose values are summarized per object */
+#define VOS_SUMM_AKEY_MAX	8
+
+/**
+ * Range of the dkeys, or of the single values of an akey, of an object. Values are summarized as
+ * little-endian numbers when they all have the same length of up to 8 bytes, i.e., when
+ * sr_min_len == sr_max_len <= 8: unsigned and signed integers, and floating point numbers for
+ * lengths 4 and 8 (NaN are left out, as comparisons with them are false).
+ */
+struct vos_summ_range {
+	/** Hash of the akey, unused for dkeys */
+	uint64_t	sr_hash;
+	/** Number of values, 0 if there is none */
+	uint64_t	sr_nr;
+	/** Min and max length of the values */
+	uint32_t	sr_min_len;
+	uint32_t	sr_max_len;
+	uint64_t	sr_min_u;
+	uint64_t	sr_max_u;
+	int64_t		sr_min_i;
+	int64_t		sr_max_i;
+	double		sr_min_d;
+	double		sr_max_d;
+	/** Some values can not be summarized (array, NVMe), the range must not be used */
+	bool		sr_unknown;
+};
+
+/**
+ * Summary of the dkeys and single values of an object, covering all the versions, committed or
+ * not, ever written to it. It is a superset of what any reader can see, so it only tells which
+ * values are certainly not in the object. See vos_obj_summ_get().
+ */
+struct vos_obj_summ {
+	/** Range of the dkeys */
+	struct vos_summ_range	os_dkeys;
+	/** Bloom filter of the dkeys */
+	uint64_t		os_bloom[VOS_SUMM_BLOOM_BITS / 64];
+	/** Ranges of the akeys */
+	struct vos_summ_range	os_akeys[VOS_SUMM_AKEY_MAX];
+	uint32_t		os_nr_akeys;
+	/** Object has more akeys than VOS_SUMM_AKEY_MAX, or flat dkeys without akeys */
+	bool			os_akeys_full;
+};
+
 /* Ignores DTX as they are transient records */
 enum VOS_TREE_CLASS {
 	VOS_TC_CONTAINER,
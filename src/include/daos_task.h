@@ -1082,6 +1082,8 @@ typedef struct {
 	d_sg_list_t			*sgl_agg;
 	/** returned pipeline stats  */
 	daos_pipeline_stats_t		*stats;
+	/** all the shards are scanned at once, see daos_pipeline_scan() */
+	daos_pipeline_stream_t		*stream;
 } daos_pipeline_run_t;
 
 /**
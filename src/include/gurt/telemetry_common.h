@@ -143,6 +143,8 @@ enum {
 	D_TM_CLOCK_THREAD_CPUTIME	= 0x200,
 	D_TM_LINK			= 0x400,
 	D_TM_MEMINFO			= 0x800,
+	D_TM_LOGHIST			= 0x1000,
+	D_TM_TRACE			= 0x2000,
 	D_TM_ALL_NODES			= (D_TM_DIRECTORY | \
 					   D_TM_COUNTER | \
 					   D_TM_TIMESTAMP | \
@@ -151,7 +153,9 @@ enum {
 					   D_TM_GAUGE | \
 					   D_TM_STATS_GAUGE | \
 					   D_TM_LINK | \
-					   D_TM_MEMINFO)
+					   D_TM_MEMINFO | \
+					   D_TM_LOGHIST | \
+					   D_TM_TRACE)
 };
 
 enum {
@@ -213,6 +217,62 @@ struct d_tm_histogram_t {
 	int                      dth_value_multiplier;
 };
 
+/**
+ * Log-linear (HDR style) histogram. Values below 2^sub_bits are counted exactly,
+ * every power of two range above is split into 2^sub_bits linear sub-buckets, so
+ * the value reported for a percentile is within 2^-(sub_bits + 1) relative error.
+ * Values at or above 2^max_bits are counted in the last bucket.
+ *
+ * Each writer (e.g. a target xstream) records into its own shard without locking,
+ * the shards are merged by the reader.
+ */
+struct d_tm_loghist_t {
+	uint64_t	*dtl_counts; /** dtl_nr_shards * dtl_nr_buckets counters */
+	uint32_t	 dtl_sub_bits;
+	uint32_t	 dtl_max_bits;
+	uint32_t	 dtl_nr_buckets;
+	uint32_t	 dtl_nr_shards;
+};
+
+/** Default log-linear histogram precision: 16 sub-buckets, 3.125% max error */
+#define D_TM_LOGHIST_SUB_BITS		4
+#define D_TM_LOGHIST_SUB_BITS_MAX	10
+/** Default log-linear histogram range: 2^24 us (~16 seconds) for latency */
+#define D_TM_LOGHIST_MAX_BITS		24
+
+/** Number of buckets of a log-linear histogram */
+#define D_TM_LOGHIST_NR_BUCKETS(sub_bits, max_bits)	\
+	(((max_bits) - (sub_bits) + 1) << (sub_bits))
+
+/** Shared memory consumed by a log-linear histogram, excluding the metric itself */
+#define D_TM_LOGHIST_SIZE(nr_shards, sub_bits, max_bits)			\
+	(sizeof(struct d_tm_loghist_t) +					\
+	 (nr_shards) * D_TM_LOGHIST_NR_BUCKETS(sub_bits, max_bits) * sizeof(uint64_t))
+
+/** A timestamped marker recorded in a trace ring */
+struct d_tm_trace_rec {
+	uint64_t	dtr_ts;		/** CLOCK_MONOTONIC time in ns */
+	uint64_t	dtr_id;		/** Identifier of the traced request */
+	uint32_t	dtr_opc;	/** Opcode of the traced request */
+	uint32_t	dtr_phase;	/** Caller defined phase of the request */
+};
+
+/**
+ * Single writer ring buffer of trace records. The writer fills the slot
+ * (dtt_head % dtt_nr_recs) then publishes it by advancing dtt_head, the oldest
+ * records are overwritten when the ring wraps. The reader validates the records
+ * it copied against dtt_head, so that neither side takes a lock.
+ */
+struct d_tm_trace_t {
+	struct d_tm_trace_rec	*dtt_recs;
+	uint64_t		 dtt_head;	/** Number of records ever written */
+	uint32_t		 dtt_nr_recs;	/** Power of two */
+};
+
+/** Shared memory consumed by a trace ring, excluding the metric itself */
+#define D_TM_TRACE_SIZE(nr_recs)					\
+	(sizeof(struct d_tm_trace_t) + (nr_recs) * sizeof(struct d_tm_trace_rec))
+
 struct d_tm_meminfo_t {
 	uint64_t arena;
 	uint64_t ordblks;
@@ -228,6 +288,8 @@ struct d_tm_metric_t {
 	}			dtm_data;
 	struct d_tm_stats_t	*dtm_stats;
 	struct d_tm_histogram_t	*dtm_histogram;
+	struct d_tm_loghist_t	*dtm_loghist;
+	struct d_tm_trace_t	*dtm_trace;
 	char			*dtm_desc;
 	char			*dtm_units;
 };
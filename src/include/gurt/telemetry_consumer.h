@@ -28,6 +28,12 @@ int d_tm_get_num_buckets(struct d_tm_context *ctx,
 int d_tm_get_bucket_range(struct d_tm_context *ctx,
 			  struct d_tm_bucket_t *bucket, int bucket_id,
 			  struct d_tm_node_t *node);
+int
+    d_tm_get_percentiles(struct d_tm_context *ctx, uint64_t *count, double *pcts, uint64_t *vals,
+			 int nr, struct d_tm_node_t *node);
+int
+d_tm_get_trace(struct d_tm_context *ctx, struct d_tm_trace_rec *recs, uint32_t *nr,
+	       struct d_tm_node_t *node);
 
 /* Developer facing client API to discover topology and manage results */
 struct d_tm_context *d_tm_open(int id);
@@ -76,6 +82,9 @@ void d_tm_print_duration(struct timespec *tms, struct d_tm_stats_t *stats,
 			 FILE *stream);
 void d_tm_print_gauge(uint64_t val, struct d_tm_stats_t *stats, char *name,
 		      int format, char *units, int opt_fields, FILE *stream);
+void
+     d_tm_print_loghist(uint64_t count, double *pcts, uint64_t *vals, int nr, char *name,
+			int format, char *units, int opt_fields, FILE *stream);
 void d_tm_print_metadata(char *desc, char *units, int format, FILE *stream);
 int d_tm_clock_id(int clk_id);
 char *d_tm_clock_string(int clk_id);
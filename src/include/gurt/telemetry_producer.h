@@ -20,6 +20,8 @@ void d_tm_mark_duration_end(struct d_tm_node_t *metric);
 void d_tm_set_gauge(struct d_tm_node_t *metric, uint64_t value);
 void d_tm_inc_gauge(struct d_tm_node_t *metric, uint64_t value);
 void d_tm_dec_gauge(struct d_tm_node_t *metric, uint64_t value);
+void d_tm_record_loghist(struct d_tm_node_t *metric, int shard, uint64_t value);
+void d_tm_record_trace(struct d_tm_node_t *metric, uint64_t id, uint32_t opc, uint32_t phase);
 
 /* Other server functions */
 int d_tm_init(int id, uint64_t mem_size, int flags);
@@ -30,6 +32,11 @@ int
 			int multiplier, const char *unit);
 int d_tm_add_metric(struct d_tm_node_t **node, int metric_type, char *desc,
 		    char *units, const char *fmt, ...);
+int
+    d_tm_add_loghist(struct d_tm_node_t **node, int nr_shards, int sub_bits, int max_bits,
+		     char *desc, char *units, const char *fmt, ...);
+int
+d_tm_add_trace(struct d_tm_node_t **node, uint32_t nr_recs, char *desc, const char *fmt, ...);
 int d_tm_add_ephemeral_dir(struct d_tm_node_t **node, size_t size_bytes,
 			   const char *fmt, ...);
 int
@@ -24,6 +24,7 @@
 #include <daos/cont_props.h>
 #include <daos/container.h>
 #include <daos/tls.h>
+#include <daos/io_trace.h>
 
 #include "obj_rpc.h"
 #include "obj_ec.h"
@@ -917,6 +918,7 @@ struct obj_io_context {
 	uint32_t		 ioc_opc;
 	uint64_t		 ioc_start_time;
 	uint64_t		 ioc_io_size;
+	struct io_trace		 ioc_trace;
 	uint32_t		 ioc_began:1,
 				 ioc_update_ec_ts:1,
 				 ioc_free_sgls:1,
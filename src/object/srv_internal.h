@@ -182,6 +182,10 @@ struct obj_tls {
 	struct d_tm_node_t	*ot_op_lat[OBJ_PROTO_CLI_COUNT];
 	/** Count number of per-opcode active requests (type = gauge) */
 	struct d_tm_node_t	*ot_op_active[OBJ_PROTO_CLI_COUNT];
+	/** Latency percentiles of update/fetch, shared by all targets (type = loghist) */
+	struct d_tm_node_t	*ot_op_lat_hist[OBJ_PROTO_CLI_COUNT];
+	/** Shard of the shared loghist metrics */
+	int			 ot_tgt_id;
 
 	/** Measure update/fetch latency based on I/O size (type = gauge) */
 	struct d_tm_node_t	*ot_update_lat[NR_LATENCY_BUCKETS];
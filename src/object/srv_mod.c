@@ -1,6 +1,6 @@
 /**
  * (C) Copyright 2016-2024 Intel Corporation.
- * (C) Copyright 2025 Hewlett Packard Enterprise Development LP
+ * (C) Copyright 2025-2026 Hewlett Packard Enterprise Development LP
  *
  * SPDX-License-Identifier: BSD-2-Clause-Patent
  */
@@ -12,6 +12,7 @@
 #include <daos_srv/daos_engine.h>
 #include <daos_srv/vos.h>
 #include <daos_srv/pool.h>
+#include <daos_srv/container.h>
 #include <daos/rpc.h>
 #include <daos/metrics.h>
 #include "obj_rpc.h"
@@ -125,6 +126,8 @@ obj_tls_init(int tags, int xs_id, int tgt_id)
 		/** skip sensor setup on system xstreams */
 		return tls;
 
+	tls->ot_tgt_id = tgt_id;
+
 	/** register different per-opcode sensors */
 	for (opc = 0; opc < OBJ_PROTO_CLI_COUNT; opc++) {
 		/** Start with number of active requests, of type gauge */
@@ -138,9 +141,18 @@ obj_tls_init(int tags, int xs_id, int tgt_id)
 
 		if (opc == DAOS_OBJ_RPC_UPDATE ||
 		    opc == DAOS_OBJ_RPC_TGT_UPDATE ||
-		    opc == DAOS_OBJ_RPC_FETCH)
+		    opc == DAOS_OBJ_RPC_FETCH) {
+			/** Latency percentiles of all targets, each target records its own shard */
+			rc = d_tm_add_loghist(&tls->ot_op_lat_hist[opc], dss_tgt_nr,
+					      D_TM_LOGHIST_SUB_BITS, D_TM_LOGHIST_MAX_BITS,
+					      "object RPC processing time percentiles", "us",
+					      "io/ops/%s/latency_hist", obj_opc_to_str(opc));
+			if (rc)
+				D_WARN("Failed to create latency histogram: "DF_RC"\n",
+				       DP_RC(rc));
 			/** See below, latency reported per size for those */
 			continue;
+		}
 
 		/** And finally the per-opcode latency, of type gauge */
 		rc = d_tm_add_metric(&tls->ot_op_lat[opc], D_TM_STATS_GAUGE,
@@ -207,6 +219,57 @@ struct dss_module_key obj_module_key = {
 	.dmk_fini = obj_tls_fini,
 };
 
+/* Pool-wide QoS limit is evenly shared by all the pool targets */
+static inline uint64_t
+obj_qos_tgt_share(uint64_t limit, uint32_t tgt_nr)
+{
+	if (limit == 0 || tgt_nr <= 1)
+		return limit;
+
+	return max(limit / tgt_nr, 1);
+}
+
+/* Fill the QoS limits of pool and container for the client IO request */
+static void
+obj_get_qos_attr(struct obj_rw_in *orw, struct sched_req_attr *attr)
+{
+	struct ds_pool_child	*child;
+	struct ds_cont_child	*cont;
+	struct ds_pool		*pool;
+	struct cont_props	*props;
+	daos_size_t		 size;
+	uint32_t		 tgt_nr;
+
+	child = ds_pool_child_lookup(orw->orw_pool_uuid);
+	if (child == NULL)
+		return;
+
+	/* Most pools have no limit, check the cached pool properties before the container */
+	pool = child->spc_pool;
+	attr->sra_slo_target = pool->sp_qos_slo;
+	if (pool->sp_qos_iops == 0 && pool->sp_qos_bw == 0 && !pool->sp_cont_qos)
+		goto out;
+
+	tgt_nr = max(pool->sp_qos_tgt_nr, 1);
+	attr->sra_pool_qos.sql_iops = obj_qos_tgt_share(pool->sp_qos_iops, tgt_nr);
+	attr->sra_pool_qos.sql_bw   = obj_qos_tgt_share(pool->sp_qos_bw << 20, tgt_nr);
+
+	if (pool->sp_cont_qos &&
+	    ds_cont_child_lookup(orw->orw_pool_uuid, orw->orw_co_uuid, &cont) == 0) {
+		props = &cont->sc_props;
+		attr->sra_cont_qos.sql_iops = obj_qos_tgt_share(props->dcp_qos_iops, tgt_nr);
+		attr->sra_cont_qos.sql_bw   = obj_qos_tgt_share(props->dcp_qos_bw << 20, tgt_nr);
+		uuid_copy(attr->sra_cont_id, orw->orw_co_uuid);
+		ds_cont_child_put(cont);
+	}
+
+	/* Size of fetch could be unknown, only the IOPS limit applies then */
+	size = daos_iods_len(orw->orw_iod_array.oia_iods, orw->orw_iod_array.oia_iod_nr);
+	attr->sra_size = size == (daos_size_t)-1 ? 0 : size;
+out:
+	ds_pool_child_put(child);
+}
+
 static int
 obj_get_req_attr(crt_rpc_t *rpc, struct sched_req_attr *attr)
 {
@@ -238,6 +301,8 @@ obj_get_req_attr(crt_rpc_t *rpc, struct sched_req_attr *attr)
 		else
 			type = SCHED_REQ_FETCH;
 		sched_req_attr_init(attr, type, &orw->orw_pool_uuid);
+		if (type != SCHED_REQ_MIGRATE)
+			obj_get_qos_attr(orw, attr);
 		break;
 	}
 	case DAOS_OBJ_RPC_MIGRATE: {
@@ -1512,11 +1512,13 @@ obj_local_rw_internal(crt_rpc_t *rpc, struct obj_io_context *ioc, daos_iod_t *io
 		if (orw->orw_flags & ORF_EC)
 			cond_flags |= VOS_OF_EC;
 
+		DSS_TRACE(&ioc->ioc_trace, VOS_BEGIN);
 		rc = vos_update_begin(ioc->ioc_vos_coh, orw->orw_oid,
 			      orw->orw_epoch, cond_flags, dkey,
 			      iods_nr, iods, iod_csums,
 			      ioc->ioc_coc->sc_props.dcp_dedup_size,
 			      &ioh, dth);
+		DSS_TRACE(&ioc->ioc_trace, VOS_END);
 		if (rc) {
 			D_ERROR(DF_UOID" Update begin failed: "DF_RC"\n",
 				DP_UOID(orw->orw_oid), DP_RC(rc));
@@ -1621,9 +1623,11 @@ obj_local_rw_internal(crt_rpc_t *rpc, struct obj_io_context *ioc, daos_iod_t *io
 		}
 
 		time = daos_get_ntime();
+		DSS_TRACE(&ioc->ioc_trace, VOS_BEGIN);
 		rc = vos_fetch_begin(ioc->ioc_vos_coh, orw->orw_oid,
 				     orw->orw_epoch, dkey, iods_nr, iods,
 				     cond_flags | fetch_flags, shadows, &ioh, dth);
+		DSS_TRACE(&ioc->ioc_trace, VOS_END);
 		daos_recx_ep_list_free(shadows, iods_nr);
 		if (rc) {
 			DL_CDEBUG(rc == -DER_INPROGRESS || rc == -DER_NONEXIST ||
@@ -1711,7 +1715,9 @@ obj_local_rw_internal(crt_rpc_t *rpc, struct obj_io_context *ioc, daos_iod_t *io
 
 	time = daos_get_ntime();
 	biod = vos_ioh2desc(ioh);
+	DSS_TRACE(&ioc->ioc_trace, DMA_BEGIN);
 	rc   = bio_iod_prep(biod, BIO_CHK_TYPE_IO, rma ? rpc->cr_ctx : NULL, CRT_BULK_RW);
+	DSS_TRACE(&ioc->ioc_trace, DMA_END);
 	if (rc) {
 		D_ERROR(DF_UOID " bio_iod_prep failed: " DF_RC "\n", DP_UOID(orw->orw_oid),
 			DP_RC(rc));
@@ -1763,8 +1769,10 @@ obj_local_rw_internal(crt_rpc_t *rpc, struct obj_io_context *ioc, daos_iod_t *io
 
 	if (rma) {
 		bulk_bind = orw->orw_flags & ORF_BULK_BIND;
+		DSS_TRACE(&ioc->ioc_trace, BULK_BEGIN);
 		rc = obj_bulk_transfer(rpc, bulk_op, bulk_bind, orw->orw_bulks.ca_arrays, offs,
 				       skips, ioh, NULL, iods_nr, orw->orw_bulks.ca_count, NULL);
+		DSS_TRACE(&ioc->ioc_trace, BULK_END);
 		if (rc == 0) {
 			bio_iod_flush(biod);
 
@@ -1828,7 +1836,9 @@ obj_local_rw_internal(crt_rpc_t *rpc, struct obj_io_context *ioc, daos_iod_t *io
 		obj_log_csum_err(orw->orw_oid);
 post:
 	time = daos_get_ntime();
+	DSS_TRACE(&ioc->ioc_trace, NVME_BEGIN);
 	rc = bio_iod_post_async(biod, rc);
+	DSS_TRACE(&ioc->ioc_trace, NVME_END);
 	bio_post_latency = daos_get_ntime() - time;
 out:
 	/* The DTX has been aborted during long time bulk data transfer. */
@@ -1868,7 +1878,9 @@ out:
 	if (rc == 0 && skips != NULL && orwo->orw_rels.ca_arrays != NULL && orw->orw_nr != iods_nr)
 		rc = obj_rw_recx_list_post(orw, orwo, skips, rc);
 
+	DSS_TRACE(&ioc->ioc_trace, VOS_BEGIN);
 	rc = obj_rw_complete(rpc, ioc, ioh, rc, dth);
+	DSS_TRACE(&ioc->ioc_trace, VOS_END);
 	if (rc == 0) {
 		/* Update latency after getting fetch/update IO size by obj_rw_complete */
 		if (obj_rpc_is_update(rpc))
@@ -2188,6 +2200,7 @@ obj_ioc_init(uuid_t pool_uuid, uuid_t coh_uuid, uuid_t cont_uuid, crt_rpc_t *rpc
 	crt_req_addref(rpc);
 	ioc->ioc_rpc = rpc;
 	ioc->ioc_opc = opc_get(rpc->cr_opc);
+	dss_trace_rpc(rpc, &ioc->ioc_trace, IO_TRACE_HANDLER);
 	rc = ds_cont_find_hdl(pool_uuid, coh_uuid, &coh);
 	if (rc) {
 		if (rc == -DER_NONEXIST)
@@ -2426,11 +2439,13 @@ obj_update_sensors(struct obj_io_context *ioc, int err)
 		lat = tls->ot_op_lat[opc];
 	}
 	d_tm_set_gauge(lat, time);
+	d_tm_record_loghist(tls->ot_op_lat_hist[opc], tls->ot_tgt_id, time);
 }
 
 static void
 obj_ioc_end(struct obj_io_context *ioc, int err)
 {
+	DSS_TRACE(&ioc->ioc_trace, DONE);
 	if (likely(ioc->ioc_began)) {
 		dss_rpc_cntr_exit(DSS_RC_OBJ, !!err);
 		ioc->ioc_began = 0;
@@ -2925,8 +2940,11 @@ ds_obj_tgt_update_handler(crt_rpc_t *rpc)
 		    DP_UOID(orw->orw_oid), DP_DTI(&orw->orw_dti));
 
 out:
-	if (dth != NULL)
+	if (dth != NULL) {
+		DSS_TRACE(&ioc.ioc_trace, DTX_BEGIN);
 		rc = dtx_end(dth, ioc.ioc_coc, rc);
+		DSS_TRACE(&ioc.ioc_trace, DTX_END);
+	}
 	if (!(orw->orw_flags & ORF_RESEND) && DAOS_FAIL_CHECK(DAOS_DTX_RESEND_NONLEADER))
 		ioc.ioc_lost_reply = 1;
 	obj_rw_reply(rpc, rc, 0, true, &ioc);
@@ -3152,7 +3170,9 @@ ds_obj_rw_handler(crt_rpc_t *rpc)
 			       &orw->orw_oid, NULL, 0, dtx_flags, NULL, &dth);
 		if (rc == 0) {
 			rc = obj_local_rw(rpc, &ioc, dth);
+			DSS_TRACE(&ioc.ioc_trace, DTX_BEGIN);
 			rc = dtx_end(dth, ioc.ioc_coc, rc);
+			DSS_TRACE(&ioc.ioc_trace, DTX_END);
 		}
 
 		D_GOTO(out, rc);
@@ -3248,7 +3268,9 @@ again:
 		max_ver = dlh->dlh_rmt_ver;
 
 	/* Stop the distributed transaction */
+	DSS_TRACE(&ioc.ioc_trace, DTX_BEGIN);
 	rc = dtx_leader_end(dlh, ioc.ioc_coc, rc);
+	DSS_TRACE(&ioc.ioc_trace, DTX_END);
 	switch (rc) {
 	case -DER_TX_RESTART:
 		/*
@@ -30,10 +30,52 @@ struct pipeline_auxi_args {
 	d_list_t      shard_task_head;
 };
 
+/**
+ * Results of one shard, for pipelines whose results are merged on the client once all the shards
+ * are done (GROUP BY and ORDER BY). Each shard returns its results into private buffers.
+ */
+struct pipeline_shard_res {
+	daos_anchor_t    psr_anchor;
+	uint32_t         psr_nr_kds;
+	daos_key_desc_t *psr_kds;
+	daos_size_t     *psr_recx_size;
+	d_iov_t          psr_keys_iov;
+	d_iov_t          psr_recx_iov;
+	d_sg_list_t      psr_sgl_keys;
+	d_sg_list_t      psr_sgl_recx;
+	/** keys (and aggregations or akey data lengths) of the returned groups or records */
+	d_iov_t          psr_partials;
+	/** groups not returned by the shard */
+	uint32_t         psr_nr_trunc;
+};
+
+/** results of all the shards, merged by the completion call back */
+struct pipeline_merge_args {
+	uint32_t                   pm_nr;
+	struct pipeline_shard_res *pm_res;
+};
+
+/** buffers where one shard returns its results */
+struct pipeline_shard_bufs {
+	daos_anchor_t             *psb_anchor;
+	daos_key_desc_t           *psb_kds;
+	daos_size_t               *psb_recx_size;
+	d_sg_list_t               *psb_sgl_keys;
+	d_sg_list_t               *psb_sgl_recx;
+	/** NULL when the results are returned to the user directly */
+	struct pipeline_shard_res *psb_res;
+};
+
+struct pipeline_stream_args;
+
 struct shard_pipeline_run_args {
-	uint32_t                   pra_map_ver; /** I AM SETTING THIS BUT NOT USING IT */
-	uint32_t                   pra_shard;
-	uint32_t                   pra_target;
+	uint32_t                     pra_map_ver; /** I AM SETTING THIS BUT NOT USING IT */
+	uint32_t                     pra_shard;
+	uint32_t                     pra_target;
+	uint32_t                     pra_nr_kds;
+	struct pipeline_shard_bufs   pra_bufs;
+	/** NULL unless run by daos_pipeline_scan() */
+	struct pipeline_stream_args *pra_stream;
 
 	daos_pipeline_run_t       *pra_api_args;
 	daos_unit_oid_t            pra_oid;
@@ -52,17 +94,23 @@ struct pipeline_run_cb_args {
 				       * I AM SETTING THIS BUT NOT USING IT.
 				       * TODO: Do a pool map refersh to update this.
 				       */
-	daos_pipeline_run_t *api_args;
-	uint32_t             nr_iods;
-	uint32_t             nr_kds;
+	daos_pipeline_run_t         *api_args;
+	uint32_t                     nr_iods;
+	uint32_t                     nr_kds;
+	struct pipeline_shard_bufs   bufs;
+	struct pipeline_stream_args *stream;
 };
 
 /** final complete call back arguments */
 struct pipeline_comp_cb_args {
-	daos_pipeline_run_t     *api_args;
-	struct daos_oclass_attr *oca;
-	uint32_t                 total_shards;
-	uint32_t                 total_replicas;
+	daos_pipeline_run_t        *api_args;
+	struct daos_oclass_attr    *oca;
+	uint32_t                    total_shards;
+	uint32_t                    total_replicas;
+	/** NULL unless the results of all the shards are merged */
+	struct pipeline_merge_args *merge;
+	/** NULL unless run by daos_pipeline_scan() */
+	struct pipeline_stream_args *stream;
 };
 
 int
@@ -98,17 +146,641 @@ first_ever_cb(daos_anchor_t *anchor, uint32_t shard)
 		(shard == 0 || (daos_anchor_get_flags(anchor) & DIOF_TO_SPEC_SHARD));
 }
 
+static void
+pipeline_stats_reset(daos_pipeline_stats_t *stats)
+{
+	stats->nr_objs  = 0;
+	stats->nr_dkeys = 0;
+	stats->nr_akeys = 0;
+	if (stats->parts != NULL)
+		memset(stats->parts, 0, stats->nr_parts * sizeof(*stats->parts));
+}
+
+/** adds the stats returned by one shard to the ones returned to the user */
+static void
+pipeline_stats_add(daos_pipeline_stats_t *dst, daos_pipeline_stats_t *src)
+{
+	uint32_t i;
+
+	dst->nr_objs  += src->nr_objs;
+	dst->nr_dkeys += src->nr_dkeys;
+	dst->nr_akeys += src->nr_akeys;
+
+	if (dst->parts == NULL)
+		return;
+	for (i = 0; i < min(dst->nr_parts, src->nr_parts); i++) {
+		dst->parts[i].nr_evals += src->parts[i].nr_evals;
+		dst->parts[i].nr_false += src->parts[i].nr_false;
+		dst->parts[i].eval_ns  += src->parts[i].eval_ns;
+	}
+}
+
+static void
+shard_pipeline_set_buffers_to_zero(d_sg_list_t *sgl)
+{
+	uint32_t i;
+
+	if (sgl != NULL && sgl->sg_iovs != NULL) {
+		for (i = 0; i < sgl->sg_nr; i++)
+			sgl->sg_iovs[i].iov_len = 0;
+		sgl->sg_nr_out = 0;
+	}
+}
+
+/** records returned so far by the calls sharing the anchor, when the pipeline has a limit */
+static inline uint64_t
+pipeline_anchor_returned(daos_anchor_t *anchor)
+{
+	return anchor->da_sub_anchors;
+}
+
+static void
+pipeline_shard_res_fini(struct pipeline_shard_res *res)
+{
+	D_FREE(res->psr_kds);
+	D_FREE(res->psr_recx_size);
+	D_FREE(res->psr_keys_iov.iov_buf);
+	D_FREE(res->psr_recx_iov.iov_buf);
+	D_FREE(res->psr_partials.iov_buf);
+}
+
+/**
+ * Allocates the buffers of one shard returning up to \a nr_kds records, with \a keys_len bytes of
+ * dkeys and \a recx_len bytes of akey data.
+ */
+static int
+pipeline_shard_res_init(struct pipeline_shard_res *res, uint32_t nr_kds, uint32_t nr_iods,
+			daos_size_t keys_len, daos_size_t recx_len)
+{
+	D_ALLOC_ARRAY(res->psr_kds, nr_kds);
+	if (res->psr_kds == NULL)
+		goto err;
+	if (nr_iods > 0) {
+		D_ALLOC_ARRAY(res->psr_recx_size, nr_kds * nr_iods);
+		if (res->psr_recx_size == NULL)
+			goto err;
+	}
+	D_ALLOC(res->psr_keys_iov.iov_buf, keys_len);
+	if (res->psr_keys_iov.iov_buf == NULL && keys_len > 0)
+		goto err;
+	res->psr_keys_iov.iov_buf_len = keys_len;
+	D_ALLOC(res->psr_recx_iov.iov_buf, recx_len);
+	if (res->psr_recx_iov.iov_buf == NULL && recx_len > 0)
+		goto err;
+	res->psr_recx_iov.iov_buf_len = recx_len;
+
+	res->psr_sgl_keys.sg_nr   = 1;
+	res->psr_sgl_keys.sg_iovs = &res->psr_keys_iov;
+	res->psr_sgl_recx.sg_nr   = 1;
+	res->psr_sgl_recx.sg_iovs = &res->psr_recx_iov;
+	return 0;
+err:
+	pipeline_shard_res_fini(res);
+	return -DER_NOMEM;
+}
+
+static void
+pipeline_merge_free(struct pipeline_merge_args *merge)
+{
+	uint32_t i;
+
+	if (merge == NULL)
+		return;
+	for (i = 0; i < merge->pm_nr; i++)
+		pipeline_shard_res_fini(&merge->pm_res[i]);
+	D_FREE(merge->pm_res);
+	D_FREE(merge);
+}
+
+/**
+ * Allocates the buffers of \a nr shards returning up to \a nr_kds records each. GROUP BY only
+ * returns partials, while ORDER BY needs room for as much data as the user buffers can hold.
+ */
+static int
+pipeline_merge_alloc(daos_pipeline_run_t *api_args, uint32_t nr, uint32_t nr_kds,
+		     struct pipeline_merge_args **merge_out)
+{
+	struct pipeline_merge_args *merge;
+	daos_size_t                 keys_len;
+	daos_size_t                 recx_len;
+	uint32_t                    i;
+	int                         rc;
+
+	D_ALLOC_PTR(merge);
+	if (merge == NULL)
+		return -DER_NOMEM;
+	D_ALLOC_ARRAY(merge->pm_res, nr);
+	if (merge->pm_res == NULL) {
+		D_FREE(merge);
+		return -DER_NOMEM;
+	}
+	merge->pm_nr = nr;
+	if (api_args->pipeline->order_by == NULL)
+		goto out;
+
+	keys_len = daos_sgl_buf_size(api_args->sgl_keys);
+	recx_len = daos_sgl_buf_size(api_args->sgl_recx);
+	for (i = 0; i < nr; i++) {
+		rc = pipeline_shard_res_init(&merge->pm_res[i], nr_kds, *api_args->nr_iods,
+					     keys_len, recx_len);
+		if (rc != 0) {
+			pipeline_merge_free(merge);
+			return rc;
+		}
+	}
+out:
+	*merge_out = merge;
+	return 0;
+}
+
+/**
+ * State of daos_pipeline_scan(), shared by its shard tasks. Each shard task has its own buffers,
+ * and scans shards one after the other, reinitializing itself for each round trip, so no more
+ * than ps_nr shards are scanned at the same time.
+ */
+struct pipeline_stream_args {
+	daos_pipeline_stream_t    *ps_stream;
+	/** serializes the merges of the results, and the calls to recs_cb */
+	pthread_mutex_t            ps_lock;
+	struct pipeline_shard_res *ps_res;
+	uint32_t                   ps_nr;
+	/** target of the first replica of each group of shards */
+	uint32_t                  *ps_targets;
+	uint32_t                   ps_nr_grps;
+	uint32_t                   ps_grp_size;
+	/** next group of shards to scan */
+	uint32_t                   ps_next_grp;
+	/** records passed to recs_cb */
+	uint64_t                   ps_returned;
+	/** first error, or value returned by recs_cb to stop the scan */
+	int                        ps_rc;
+};
+
+static void
+pipeline_stream_free(struct pipeline_stream_args *ps)
+{
+	uint32_t i;
+
+	if (ps == NULL)
+		return;
+	for (i = 0; i < ps->ps_nr; i++)
+		pipeline_shard_res_fini(&ps->ps_res[i]);
+	D_FREE(ps->ps_res);
+	D_FREE(ps->ps_targets);
+	D_MUTEX_DESTROY(&ps->ps_lock);
+	D_FREE(ps);
+}
+
+static int
+pipeline_stream_alloc(daos_pipeline_run_t *api_args, struct pl_obj_layout *layout,
+		      struct pipeline_stream_args **ps_out)
+{
+	daos_pipeline_stream_t      *stream = api_args->stream;
+	struct pipeline_stream_args *ps;
+	uint32_t                     i;
+	int                          rc;
+
+	D_ALLOC_PTR(ps);
+	if (ps == NULL)
+		return -DER_NOMEM;
+	rc = D_MUTEX_INIT(&ps->ps_lock, NULL);
+	if (rc != 0) {
+		D_FREE(ps);
+		return rc;
+	}
+	ps->ps_stream   = stream;
+	ps->ps_nr_grps  = layout->ol_grp_nr;
+	ps->ps_grp_size = layout->ol_grp_size;
+	ps->ps_nr       = ps->ps_nr_grps;
+	if (stream->max_inflight > 0 && stream->max_inflight < ps->ps_nr)
+		ps->ps_nr = stream->max_inflight;
+
+	D_ALLOC_ARRAY(ps->ps_targets, ps->ps_nr_grps);
+	D_ALLOC_ARRAY(ps->ps_res, ps->ps_nr);
+	if (ps->ps_targets == NULL || ps->ps_res == NULL) {
+		ps->ps_nr = 0;
+		D_GOTO(err, rc = -DER_NOMEM);
+	}
+	for (i = 0; i < ps->ps_nr_grps; i++)
+		ps->ps_targets[i] = layout->ol_shards[i * ps->ps_grp_size].po_target;
+	for (i = 0; i < ps->ps_nr; i++) {
+		rc = pipeline_shard_res_init(&ps->ps_res[i], stream->nr_kds, *api_args->nr_iods,
+					     stream->keys_buf_size, stream->recx_buf_size);
+		if (rc != 0)
+			D_GOTO(err, rc);
+	}
+	ps->ps_next_grp = ps->ps_nr;
+
+	*ps_out = ps;
+	return 0;
+err:
+	pipeline_stream_free(ps);
+	return rc;
+}
+
+/**
+ * Merges the aggregations returned by one round trip of a scan, and passes its records to the
+ * callback of the user.
+ */
+static void
+pipeline_stream_recv(daos_pipeline_run_t *api_args, struct pipeline_stream_args *ps,
+		     struct pipeline_shard_res *res, struct pipeline_run_out *pro)
+{
+	daos_pipeline_t *pipe = api_args->pipeline;
+	uint64_t         nr   = pro->pro_nr_kds;
+	double          *dst;
+	uint32_t         i;
+	int              rc;
+
+	D_MUTEX_LOCK(&ps->ps_lock);
+	res->psr_anchor = pro->pro_anchor;
+	for (i = 0; i < pipe->num_aggr_filters; i++) {
+		dst = (double *)api_args->sgl_agg->sg_iovs[i].iov_buf;
+		pipeline_aggr_merge(pipe->aggr_filters[i], dst,
+				    *(double *)pro->pro_sgl_agg.sg_iovs[i].iov_buf);
+	}
+	if (api_args->stats != NULL)
+		pipeline_stats_add(api_args->stats, &pro->stats);
+
+	if (pipe->limit > 0)
+		nr = min(nr, pipe->limit - ps->ps_returned);
+	if (ps->ps_rc != 0 || pipe->num_aggr_filters > 0 || nr == 0)
+		goto out;
+
+	rc = ps->ps_stream->recs_cb(ps->ps_stream->cb_arg, nr, res->psr_kds, &res->psr_sgl_keys,
+				    *api_args->nr_iods, res->psr_recx_size, &res->psr_sgl_recx);
+	ps->ps_returned += nr;
+	if (rc != 0)
+		ps->ps_rc = rc;
+out:
+	D_MUTEX_UNLOCK(&ps->ps_lock);
+}
+
+/**
+ * Moves the shard task of a scan to its next round trip: the same shard while it has records
+ * left, then the next shard not scanned yet. Returns false when the task is done.
+ */
+static bool
+pipeline_stream_next(tse_task_t *task, struct pipeline_stream_args *ps, int ret)
+{
+	struct shard_pipeline_run_args *args = tse_task_buf_embedded(task, sizeof(*args));
+	struct pipeline_shard_res      *res  = args->pra_bufs.psb_res;
+	daos_pipeline_t                *pipe = args->pra_api_args->pipeline;
+	bool                            next = false;
+	uint32_t                        grp;
+	int                             rc;
+
+	D_MUTEX_LOCK(&ps->ps_lock);
+	if (ret != 0 && ps->ps_rc == 0)
+		ps->ps_rc = ret;
+	if (ps->ps_rc != 0 || (pipe->limit > 0 && ps->ps_returned >= pipe->limit))
+		goto out;
+
+	if (daos_anchor_is_eof(&res->psr_anchor)) {
+		if (ps->ps_next_grp == ps->ps_nr_grps)
+			goto out;
+		grp                    = ps->ps_next_grp++;
+		args->pra_shard        = grp * ps->ps_grp_size;
+		args->pra_target       = ps->ps_targets[grp];
+		args->pra_oid.id_shard = args->pra_shard;
+		daos_anchor_set_zero(&res->psr_anchor);
+		dc_obj_shard2anchor(&res->psr_anchor, args->pra_shard);
+	}
+	args->pra_nr_kds = ps->ps_stream->nr_kds;
+	if (pipe->limit > 0)
+		args->pra_nr_kds = min(args->pra_nr_kds, pipe->limit - ps->ps_returned);
+	next = true;
+out:
+	D_MUTEX_UNLOCK(&ps->ps_lock);
+	if (!next)
+		return false;
+
+	rc = tse_task_reinit(task);
+	if (rc != 0) {
+		D_ERROR("task %p, reinit for the next shard " DF_RC "\n", task, DP_RC(rc));
+		D_MUTEX_LOCK(&ps->ps_lock);
+		if (ps->ps_rc == 0)
+			ps->ps_rc = rc;
+		D_MUTEX_UNLOCK(&ps->ps_lock);
+		return false;
+	}
+	return true;
+}
+
+/** one group returned by a shard */
+struct pipeline_merge_group {
+	struct pipeline_key_t mg_key;
+	uint64_t              mg_count;
+	/** aggregation values, not aligned, in the partials of the shard */
+	char                 *mg_aggr;
+};
+
+static int
+merge_group_cmp(const void *a, const void *b)
+{
+	struct pipeline_merge_group *ga = (struct pipeline_merge_group *)a;
+	struct pipeline_merge_group *gb = (struct pipeline_merge_group *)b;
+
+	return pipeline_key_cmp(&ga->mg_key, &gb->mg_key);
+}
+
+/** copies the key of a group to the user buffers: 8 bytes for numbers, no bytes for NULL */
+static int
+merge_group_key_out(daos_pipeline_run_t *api_args, struct pipeline_key_t *key, uint32_t j,
+		    uint32_t *iov_idx)
+{
+	d_iov_t iov;
+
+	if (key->cls == PIPELINE_KEY_NULL)
+		d_iov_set(&iov, NULL, 0);
+	else if (key->cls == 3)
+		d_iov_set(&iov, key->data, key->len);
+	else
+		d_iov_set(&iov, &key->v, sizeof(key->v));
+
+	api_args->kds[j] = (daos_key_desc_t){.kd_key_len = iov.iov_len};
+	if (iov.iov_len == 0)
+		return 0;
+	return pipeline_pack_value(api_args->sgl_keys, iov_idx, &iov);
+}
+
+/**
+ * Merges the groups returned by all the shards: the groups with the same key are combined, and
+ * the first ones in key order are returned to the user.
+ */
+static int
+pipeline_merge_groups(daos_pipeline_run_t *api_args, struct pipeline_merge_args *merge)
+{
+	daos_pipeline_t             *pipe   = api_args->pipeline;
+	uint32_t                     nr_agg = pipe->num_aggr_filters;
+	struct pipeline_merge_group *grps;
+	struct pipeline_merge_group *grp;
+	struct pipeline_shard_res   *res;
+	uint64_t                     count;
+	double                       val;
+	double                      *dst;
+	char                        *ptr;
+	char                        *end;
+	uint32_t                     nr      = 0;
+	uint32_t                     nr_out  = 0;
+	uint32_t                     iov_idx = 0;
+	uint32_t                     cap;
+	uint32_t                     i;
+	uint32_t                     j;
+	uint32_t                     g;
+	uint32_t                     s;
+	bool                         trunc = false;
+	int                          rc    = 0;
+
+	for (s = 0; s < merge->pm_nr; s++) {
+		nr += merge->pm_res[s].psr_nr_kds;
+		if (merge->pm_res[s].psr_nr_trunc > 0)
+			trunc = true;
+	}
+	cap = *api_args->nr_kds;
+	if (pipe->limit > 0 && pipe->limit < cap)
+		cap = pipe->limit;
+	for (i = 0; i < nr_agg; i++)
+		cap = min(cap, api_args->sgl_agg->sg_iovs[i].iov_buf_len / sizeof(double));
+
+	shard_pipeline_set_buffers_to_zero(api_args->sgl_keys);
+	shard_pipeline_set_buffers_to_zero(api_args->sgl_agg);
+	*api_args->nr_kds = 0;
+	if (nr == 0)
+		goto out;
+
+	D_ALLOC_ARRAY(grps, nr);
+	if (grps == NULL)
+		return -DER_NOMEM;
+
+	/** unpacking the groups: key, count and the value of each aggregation */
+	grp = grps;
+	for (s = 0; s < merge->pm_nr; s++) {
+		res = &merge->pm_res[s];
+		ptr = res->psr_partials.iov_buf;
+		end = ptr + res->psr_partials.iov_len;
+		for (i = 0; i < res->psr_nr_kds; i++, grp++) {
+			rc = pipeline_key_unpack(&ptr, end, &grp->mg_key);
+			if (rc != 0)
+				D_GOTO(out_free, rc);
+			if (ptr + sizeof(uint64_t) + nr_agg * sizeof(double) > end)
+				D_GOTO(out_free, rc = -DER_PROTO);
+			memcpy(&grp->mg_count, ptr, sizeof(uint64_t));
+			grp->mg_aggr  = ptr + sizeof(uint64_t);
+			ptr          += sizeof(uint64_t) + nr_agg * sizeof(double);
+		}
+	}
+	qsort(grps, nr, sizeof(*grps), merge_group_cmp);
+
+	/** combining the groups with the same key */
+	for (i = 0; i < nr; i = j) {
+		if (nr_out == cap) {
+			trunc = true;
+			break;
+		}
+		rc = merge_group_key_out(api_args, &grps[i].mg_key, nr_out, &iov_idx);
+		if (rc != 0)
+			D_GOTO(out_free, rc);
+
+		for (count = 0, j = i; j < nr; j++) {
+			if (pipeline_key_cmp(&grps[i].mg_key, &grps[j].mg_key) != 0)
+				break;
+			count += grps[j].mg_count;
+		}
+		for (s = 0; s < nr_agg; s++) {
+			dst  = (double *)api_args->sgl_agg->sg_iovs[s].iov_buf + nr_out;
+			*dst = pipeline_aggr_init_value(pipe->aggr_filters[s]);
+			for (g = i; g < j; g++) {
+				memcpy(&val, grps[g].mg_aggr + s * sizeof(double), sizeof(val));
+				pipeline_aggr_merge(pipe->aggr_filters[s], dst, val);
+			}
+			/** shards return the sum of the values for AVG */
+			if (pipeline_aggr_is_avg(pipe->aggr_filters[s]) && count > 0)
+				*dst /= count;
+		}
+		nr_out++;
+	}
+out_free:
+	D_FREE(grps);
+	if (rc != 0)
+		return rc;
+	*api_args->nr_kds = nr_out;
+out:
+	for (i = 0; i < nr_agg; i++)
+		api_args->sgl_agg->sg_iovs[i].iov_len = *api_args->nr_kds * sizeof(double);
+	api_args->sgl_agg->sg_nr_out = nr_agg;
+
+	if (trunc && (pipe->limit == 0 || pipe->limit > cap))
+		return -DER_TRUNC;
+	return 0;
+}
+
+/** position in the records returned by one shard, sorted by their ORDER BY key */
+struct pipeline_merge_cursor {
+	struct pipeline_shard_res *mc_res;
+	uint32_t                   mc_idx;
+	struct pipeline_key_t      mc_key;
+	/** partials, dkey and akey data of the current record */
+	char                      *mc_part;
+	char                      *mc_part_end;
+	char                      *mc_keys;
+	char                      *mc_recx;
+};
+
+static int
+merge_cursor_load(struct pipeline_merge_cursor *cur)
+{
+	if (cur->mc_idx == cur->mc_res->psr_nr_kds)
+		return 0;
+	return pipeline_key_unpack(&cur->mc_part, cur->mc_part_end, &cur->mc_key);
+}
+
+/** copies the current record of \a cur to the user buffers as record \a j, and moves forward */
+static int
+merge_cursor_out(daos_pipeline_run_t *api_args, struct pipeline_merge_cursor *cur, uint32_t j,
+		 uint32_t *keys_idx, uint32_t *recx_idx)
+{
+	struct pipeline_shard_res *res     = cur->mc_res;
+	uint32_t                   nr_iods = *api_args->nr_iods;
+	uint64_t                   len;
+	d_iov_t                    iov;
+	uint32_t                   i;
+	int                        rc;
+
+	api_args->kds[j] = res->psr_kds[cur->mc_idx];
+	d_iov_set(&iov, cur->mc_keys, res->psr_kds[cur->mc_idx].kd_key_len);
+	rc = pipeline_pack_value(api_args->sgl_keys, keys_idx, &iov);
+	if (rc != 0)
+		return rc;
+	cur->mc_keys += iov.iov_len;
+
+	if (cur->mc_part + nr_iods * sizeof(len) > cur->mc_part_end)
+		return -DER_PROTO;
+	for (i = 0; i < nr_iods; i++) {
+		memcpy(&len, cur->mc_part, sizeof(len));
+		cur->mc_part += sizeof(len);
+
+		d_iov_set(&iov, cur->mc_recx, len);
+		rc = pipeline_pack_value(api_args->sgl_recx, recx_idx, &iov);
+		if (rc != 0)
+			return rc;
+		cur->mc_recx += len;
+		if (api_args->recx_size != NULL)
+			api_args->recx_size[j * nr_iods + i] =
+			    res->psr_recx_size[cur->mc_idx * nr_iods + i];
+	}
+	cur->mc_idx++;
+
+	return merge_cursor_load(cur);
+}
+
+/**
+ * Merges the records returned by all the shards, each one already sorted by the ORDER BY key,
+ * keeping the first ones up to the limit.
+ */
+static int
+pipeline_merge_order(daos_pipeline_run_t *api_args, struct pipeline_merge_args *merge)
+{
+	struct pipeline_merge_cursor *curs;
+	struct pipeline_merge_cursor *cur;
+	struct pipeline_shard_res    *res;
+	bool                          desc;
+	uint32_t                      k;
+	uint32_t                      j;
+	uint32_t                      s;
+	uint32_t                      keys_idx = 0;
+	uint32_t                      recx_idx = 0;
+	int                           cmp;
+	int                           rc       = 0;
+
+	desc = pipeline_order_is_desc(api_args->pipeline->order_by);
+	k    = min(*api_args->nr_kds, api_args->pipeline->limit);
+
+	D_ALLOC_ARRAY(curs, merge->pm_nr);
+	if (curs == NULL)
+		return -DER_NOMEM;
+	for (s = 0; s < merge->pm_nr; s++) {
+		res              = &merge->pm_res[s];
+		cur              = &curs[s];
+		cur->mc_res      = res;
+		cur->mc_part     = res->psr_partials.iov_buf;
+		cur->mc_part_end = cur->mc_part + res->psr_partials.iov_len;
+		cur->mc_keys     = res->psr_keys_iov.iov_buf;
+		cur->mc_recx     = res->psr_recx_iov.iov_buf;
+		rc               = merge_cursor_load(cur);
+		if (rc != 0)
+			D_GOTO(out, rc);
+	}
+
+	shard_pipeline_set_buffers_to_zero(api_args->sgl_keys);
+	shard_pipeline_set_buffers_to_zero(api_args->sgl_recx);
+	for (j = 0; j < k; j++) {
+		cur = NULL;
+		for (s = 0; s < merge->pm_nr; s++) {
+			if (curs[s].mc_idx == curs[s].mc_res->psr_nr_kds)
+				continue;
+			if (cur != NULL) {
+				cmp = pipeline_key_cmp(&curs[s].mc_key, &cur->mc_key);
+				if (desc ? cmp <= 0 : cmp >= 0)
+					continue;
+			}
+			cur = &curs[s];
+		}
+		if (cur == NULL)
+			break;
+
+		rc = merge_cursor_out(api_args, cur, j, &keys_idx, &recx_idx);
+		if (rc != 0)
+			D_GOTO(out, rc);
+	}
+	*api_args->nr_kds = j;
+out:
+	D_FREE(curs);
+	return rc;
+}
+
 static int
 pipeline_comp_cb(tse_task_t *task, void *data)
 {
 	struct pipeline_comp_cb_args  *cb_args;
 	daos_pipeline_run_t           *api_args;
+	uint32_t                       i;
+	int                            rc = 0;
 
 	cb_args  = (struct pipeline_comp_cb_args *)data;
 	api_args = cb_args->api_args;
 	if (task->dt_result != 0)
 		D_DEBUG(DB_IO, "pipeline_comp_db task=%p result=%d\n", task, task->dt_result);
 
+	if (cb_args->stream != NULL) {
+		for (i = 0; i < api_args->pipeline->num_aggr_filters; i++)
+			api_args->sgl_agg->sg_iovs[i].iov_len = sizeof(double);
+		if (api_args->pipeline->num_aggr_filters > 0)
+			api_args->sgl_agg->sg_nr_out = api_args->pipeline->num_aggr_filters;
+		rc = cb_args->stream->ps_rc;
+		pipeline_stream_free(cb_args->stream);
+		return rc;
+	}
+
+	if (cb_args->merge != NULL) {
+		/** all the shards were run at once; nothing left for the next call */
+		if (task->dt_result == 0 && api_args->pipeline->order_by != NULL)
+			rc = pipeline_merge_order(api_args, cb_args->merge);
+		else if (task->dt_result == 0)
+			rc = pipeline_merge_groups(api_args, cb_args->merge);
+		if (rc == 0 || rc == -DER_TRUNC)
+			daos_anchor_set_eof(api_args->anchor);
+		pipeline_merge_free(cb_args->merge);
+		return rc;
+	}
+
+	if (api_args->pipeline->limit > 0 &&
+	    pipeline_anchor_returned(api_args->anchor) >= api_args->pipeline->limit) {
+		/** limit reached, the shards left are not visited */
+		daos_anchor_set_eof(api_args->anchor);
+		return 0;
+	}
+
 	anchor_check_eof(api_args->anchor, cb_args->oca, cb_args->total_shards,
 			 cb_args->total_replicas);
 	return 0;
@@ -119,6 +791,8 @@ pipeline_shard_run_cb(tse_task_t *task, void *data)
 {
 	struct pipeline_run_cb_args  *cb_args;
 	daos_pipeline_run_t          *api_args;
+	struct pipeline_shard_bufs   *bufs;
+	struct pipeline_shard_res    *res;
 	struct pipeline_run_out      *pro; /** received data from srv */
 	struct pipeline_run_in	     *pri;
 	int                           opc;
@@ -128,10 +802,12 @@ pipeline_shard_run_cb(tse_task_t *task, void *data)
 	uint32_t                      nr_iods;
 	uint32_t                      nr_kds;
 	uint32_t                      nr_agg;
+	uint64_t                      returned;
 	uint32_t                      i;
 
 	cb_args  = (struct pipeline_run_cb_args *)data;
 	api_args = cb_args->api_args;
+	bufs     = &cb_args->bufs;
 	rpc      = cb_args->rpc;
 	opc      = opc_get(rpc->cr_opc);
 	pri	 = (struct pipeline_run_in *)crt_req_get(rpc);
@@ -157,8 +833,11 @@ pipeline_shard_run_cb(tse_task_t *task, void *data)
 	D_ASSERT(pro->pro_sgl_agg.sg_nr_out  == nr_agg);
 
 	if (rc != 0) {
-		if (rc == -DER_NONEXIST)
+		if (rc == -DER_NONEXIST) {
+			if (cb_args->stream != NULL)
+				daos_anchor_set_eof(&bufs->psb_res->psr_anchor);
 			D_GOTO(out, rc = 0);
+		}
 		if (rc == -DER_INPROGRESS || rc == -DER_TX_BUSY)
 			D_DEBUG(DB_TRACE, "rpc %p RPC %d may need retry: %d\n", rpc, opc, rc);
 		else
@@ -168,26 +847,50 @@ pipeline_shard_run_cb(tse_task_t *task, void *data)
 
 	if (pro->pro_kds.ca_count > 0) {
 		/** copying key descriptors */
-		memcpy((void *)api_args->kds, (void *)pro->pro_kds.ca_arrays,
-		       sizeof(*api_args->kds) * pro->pro_kds.ca_count);
+		memcpy((void *)bufs->psb_kds, (void *)pro->pro_kds.ca_arrays,
+		       sizeof(*bufs->psb_kds) * pro->pro_kds.ca_count);
 	}
 	if (pro->pro_sgl_keys.sg_nr_out > 0) {
 		/** copying keys */
-		rc = daos_sgls_copy_data_out(api_args->sgl_keys, 1, &pro->pro_sgl_keys, 1);
+		rc = daos_sgls_copy_data_out(bufs->psb_sgl_keys, 1, &pro->pro_sgl_keys, 1);
 		if (rc != 0)
 			D_GOTO(out, rc);
 	}
-	if (api_args->recx_size != NULL && pro->pro_recx_size.ca_count > 0) {
+	if (bufs->psb_recx_size != NULL && pro->pro_recx_size.ca_count > 0) {
 		/** copying records' size */
-		memcpy((void *)api_args->recx_size, (void *)pro->pro_recx_size.ca_arrays,
-		       sizeof(*api_args->recx_size) * pro->pro_recx_size.ca_count);
+		memcpy((void *)bufs->psb_recx_size, (void *)pro->pro_recx_size.ca_arrays,
+		       sizeof(*bufs->psb_recx_size) * pro->pro_recx_size.ca_count);
 	}
 	if (pro->pro_sgl_recx.sg_nr_out > 0) {
 		/** copying record data (akeys' values) */
-		rc = daos_sgls_copy_data_out(api_args->sgl_recx, 1, &pro->pro_sgl_recx, 1);
+		rc = daos_sgls_copy_data_out(bufs->psb_sgl_recx, 1, &pro->pro_sgl_recx, 1);
 		if (rc != 0)
 			D_GOTO(out, rc);
 	}
+
+	res = bufs->psb_res;
+	if (cb_args->stream != NULL) {
+		pipeline_stream_recv(api_args, cb_args->stream, res, pro);
+		D_GOTO(out, rc);
+	}
+	if (res != NULL) {
+		/** results merged with the ones of the other shards by pipeline_comp_cb() */
+		if (pro->pro_partials.iov_len > 0) {
+			D_ALLOC(res->psr_partials.iov_buf, pro->pro_partials.iov_len);
+			if (res->psr_partials.iov_buf == NULL)
+				D_GOTO(out, rc = -DER_NOMEM);
+			memcpy(res->psr_partials.iov_buf, pro->pro_partials.iov_buf,
+			       pro->pro_partials.iov_len);
+			res->psr_partials.iov_len     = pro->pro_partials.iov_len;
+			res->psr_partials.iov_buf_len = pro->pro_partials.iov_len;
+		}
+		res->psr_nr_kds   = pro->pro_nr_kds;
+		res->psr_nr_trunc = pro->pro_nr_trunc;
+		res->psr_anchor   = pro->pro_anchor;
+		if (api_args->stats != NULL)
+			pipeline_stats_add(api_args->stats, &pro->stats);
+		D_GOTO(out, rc);
+	}
 	for (i = 0; i < nr_agg; i++) {
 		/** copying aggregation buffers */
 		double             *src, *dst;
@@ -237,17 +940,16 @@ pipeline_shard_run_cb(tse_task_t *task, void *data)
 
 	if (api_args->stats != NULL) {
 		/** user wants stats */
-		if (first_ever_cb(api_args->anchor, cb_args->shard)) {
-			*api_args->stats = pro->stats;
-		} else {
-			api_args->stats->nr_objs += pro->stats.nr_objs;
-			api_args->stats->nr_dkeys += pro->stats.nr_dkeys;
-			api_args->stats->nr_akeys += pro->stats.nr_akeys;
-		}
+		if (first_ever_cb(api_args->anchor, cb_args->shard))
+			pipeline_stats_reset(api_args->stats);
+		pipeline_stats_add(api_args->stats, &pro->stats);
 	}
 
-	/** anchor should always be updated at the end */
+	/** anchor should always be updated at the end, keeping the records returned so far */
+	returned          = pipeline_anchor_returned(api_args->anchor);
 	*api_args->anchor = pro->pro_anchor;
+	if (api_args->pipeline->limit > 0)
+		api_args->anchor->da_sub_anchors = returned + pro->pro_nr_kds;
 
 out:
 	if (pri->pri_kds_bulk)
@@ -259,24 +961,15 @@ out:
 	if (pri->pri_sgl_recx_bulk)
 		crt_bulk_free(pri->pri_sgl_recx_bulk);
 	crt_req_decref(rpc);
-	tse_task_list_del(task);
-	tse_task_decref(task);
 
 	if (ret == 0) /** XXX: see obj_retry_error(int err) when retry I/O is implemented */
 		ret = rc;
-	return ret;
-}
-
-static void
-shard_pipeline_set_buffers_to_zero(d_sg_list_t *sgl)
-{
-	uint32_t i;
+	if (cb_args->stream != NULL && pipeline_stream_next(task, cb_args->stream, ret))
+		return 0; /** same task, run again for the next round trip of the scan */
 
-	if (sgl != NULL && sgl->sg_iovs != NULL) {
-		for (i = 0; i < sgl->sg_nr; i++)
-			sgl->sg_iovs[i].iov_len = 0;
-		sgl->sg_nr_out = 0;
-	}
+	tse_task_list_del(task);
+	tse_task_decref(task);
+	return ret;
 }
 
 #define KDS_BULK_LIMIT	128
@@ -295,6 +988,7 @@ shard_pipeline_run_task(tse_task_t *task)
 	struct pool_target              *map_tgt;
 	struct pipeline_run_cb_args      cb_args;
 	struct pipeline_run_in          *pri;
+	struct pipeline_shard_bufs      *bufs;
 	uint32_t                         nr_kds;
 	uint32_t                         nr_iods;
 	daos_size_t                      size;
@@ -302,6 +996,7 @@ shard_pipeline_run_task(tse_task_t *task)
 	int                              rc;
 
 	args    = tse_task_buf_embedded(task, sizeof(*args));
+	bufs    = &args->pra_bufs;
 	crt_ctx = daos_task2ctx(task);
 	opcode =
 	    DAOS_RPC_OPCODE(args->pipeline_auxi->opc, DAOS_PIPELINE_MODULE, DAOS_PIPELINE_VERSION);
@@ -328,7 +1023,7 @@ shard_pipeline_run_task(tse_task_t *task)
 	/** -- nr_iods, nr_kds for this shard */
 
 	nr_iods        = *args->pra_api_args->nr_iods;
-	nr_kds         = *args->pra_api_args->nr_kds;
+	nr_kds         = args->pra_nr_kds;
 
 	/** -- call back function arguments */
 
@@ -339,6 +1034,8 @@ shard_pipeline_run_task(tse_task_t *task)
 	cb_args.api_args     = args->pra_api_args;
 	cb_args.nr_iods      = nr_iods;
 	cb_args.nr_kds       = nr_kds;
+	cb_args.bufs         = *bufs;
+	cb_args.stream       = args->pra_stream;
 
 	/**
 	 * -- Forcing iov buffers to be empty. Pipeline API is read only for now, so we don't need
@@ -348,8 +1045,8 @@ shard_pipeline_run_task(tse_task_t *task)
 	 *  However, the content is not needed on the server, since it is merged on the client when
 	 *  the call back is executed.
 	 */
-	shard_pipeline_set_buffers_to_zero(args->pra_api_args->sgl_keys);
-	shard_pipeline_set_buffers_to_zero(args->pra_api_args->sgl_recx);
+	shard_pipeline_set_buffers_to_zero(bufs->psb_sgl_keys);
+	shard_pipeline_set_buffers_to_zero(bufs->psb_sgl_recx);
 	if (args->pra_api_args->pipeline->num_aggr_filters != 0)
 		shard_pipeline_set_buffers_to_zero(args->pra_api_args->sgl_agg);
 
@@ -371,8 +1068,8 @@ shard_pipeline_run_task(tse_task_t *task)
 
 	pri->pri_iods.nr      = nr_iods;
 	pri->pri_iods.iods    = args->pra_api_args->iods;
-	pri->pri_sgl_keys     = *args->pra_api_args->sgl_keys;
-	pri->pri_sgl_recx     = *args->pra_api_args->sgl_recx;
+	pri->pri_sgl_keys     = *bufs->psb_sgl_keys;
+	pri->pri_sgl_recx     = *bufs->psb_sgl_recx;
 
 	if (!args->pra_api_args->pipeline->num_aggr_filters) {
 		pri->pri_sgl_agg = (d_sg_list_t){.sg_nr = 0, .sg_nr_out = 0, .sg_iovs = NULL};
@@ -381,7 +1078,7 @@ shard_pipeline_run_task(tse_task_t *task)
 	}
 	D_ASSERT(pri->pri_sgl_agg.sg_nr == args->pra_api_args->pipeline->num_aggr_filters);
 
-	pri->pri_anchor       = *args->pra_api_args->anchor;
+	pri->pri_anchor       = *bufs->psb_anchor;
 	pri->pri_flags        = args->pra_api_args->flags;
 	pri->pri_nr_kds       = nr_kds;
 	uuid_copy(pri->pri_pool_uuid, pool->dp_pool);
@@ -399,8 +1096,8 @@ shard_pipeline_run_task(tse_task_t *task)
 		d_sg_list_t	tmp_sgl = {0};
 		d_iov_t		tmp_iov = {0};
 
-		tmp_iov.iov_buf_len	= sizeof(*args->pra_api_args->kds) * nr_kds;
-		tmp_iov.iov_buf		= args->pra_api_args->kds;
+		tmp_iov.iov_buf_len	= sizeof(*bufs->psb_kds) * nr_kds;
+		tmp_iov.iov_buf		= bufs->psb_kds;
 		tmp_sgl.sg_nr_out	= 1;
 		tmp_sgl.sg_nr		= 1;
 		tmp_sgl.sg_iovs		= &tmp_iov;
@@ -411,14 +1108,14 @@ shard_pipeline_run_task(tse_task_t *task)
 	}
 	/** everything else is based on packed size */
 	size = 0;
-	if (args->pra_api_args->recx_size != NULL && nr_iods > 0) {
+	if (bufs->psb_recx_size != NULL && nr_iods > 0) {
 		size += nr_iods * nr_kds * sizeof(daos_size_t);
 		if (size >= DAOS_BULK_LIMIT) {
 			d_sg_list_t	tmp_sgl = {0};
 			d_iov_t		tmp_iov = {0};
 
 			tmp_iov.iov_buf_len	= nr_iods * nr_kds * sizeof(daos_size_t);
-			tmp_iov.iov_buf		= args->pra_api_args->recx_size;
+			tmp_iov.iov_buf		= bufs->psb_recx_size;
 			tmp_sgl.sg_nr_out	= 1;
 			tmp_sgl.sg_nr		= 1;
 			tmp_sgl.sg_iovs		= &tmp_iov;
@@ -429,19 +1126,19 @@ shard_pipeline_run_task(tse_task_t *task)
 		}
 	}
 	if (nr_kds > 0) {
-		if (no_aggregation && args->pra_api_args->sgl_keys != NULL) {
-			size += daos_sgls_packed_size(args->pra_api_args->sgl_keys, 1, NULL);
+		if (no_aggregation && bufs->psb_sgl_keys != NULL) {
+			size += daos_sgls_packed_size(bufs->psb_sgl_keys, 1, NULL);
 			if (size >= DAOS_BULK_LIMIT) {
-				rc = crt_bulk_create(crt_ctx, args->pra_api_args->sgl_keys,
+				rc = crt_bulk_create(crt_ctx, bufs->psb_sgl_keys,
 						     CRT_BULK_RW, &pri->pri_sgl_keys_bulk);
 				if (rc < 0)
 					D_GOTO(out_req, rc);
 			}
 		}
-		if (args->pra_api_args->sgl_recx != NULL) {
-			size += daos_sgls_packed_size(args->pra_api_args->sgl_recx, 1, NULL);
+		if (bufs->psb_sgl_recx != NULL) {
+			size += daos_sgls_packed_size(bufs->psb_sgl_recx, 1, NULL);
 			if (size >= DAOS_BULK_LIMIT) {
-				rc = crt_bulk_create(crt_ctx, args->pra_api_args->sgl_recx,
+				rc = crt_bulk_create(crt_ctx, bufs->psb_sgl_recx,
 						     CRT_BULK_RW, &pri->pri_sgl_recx_bulk);
 				if (rc < 0)
 					D_GOTO(out_req, rc);
@@ -489,7 +1186,8 @@ static int
 queue_shard_pipeline_run_task(tse_task_t *api_task, struct pl_obj_layout *layout,
 			      struct pipeline_auxi_args *pipeline_auxi, int shard,
 			      unsigned int map_ver, daos_unit_oid_t oid, uuid_t coh_uuid,
-			      uuid_t cont_uuid)
+			      uuid_t cont_uuid, uint32_t nr_kds, struct pipeline_shard_res *res,
+			      struct pipeline_stream_args *stream)
 {
 	daos_pipeline_run_t             *api_args;
 	tse_sched_t                     *sched;
@@ -510,8 +1208,28 @@ queue_shard_pipeline_run_task(tse_task_t *api_task, struct pl_obj_layout *layout
 	args->pra_oid       = oid;
 	args->pipeline_auxi = pipeline_auxi;
 	args->pra_target    = layout->ol_shards[shard].po_target;
+	args->pra_nr_kds    = nr_kds;
 	uuid_copy(args->pra_coh_uuid, coh_uuid);
 	uuid_copy(args->pra_cont_uuid, cont_uuid);
+
+	if (res == NULL) {
+		args->pra_bufs.psb_anchor    = api_args->anchor;
+		args->pra_bufs.psb_kds       = api_args->kds;
+		args->pra_bufs.psb_recx_size = api_args->recx_size;
+		args->pra_bufs.psb_sgl_keys  = api_args->sgl_keys;
+		args->pra_bufs.psb_sgl_recx  = api_args->sgl_recx;
+	} else {
+		daos_anchor_set_zero(&res->psr_anchor);
+		dc_obj_shard2anchor(&res->psr_anchor, shard);
+		args->pra_bufs.psb_anchor    = &res->psr_anchor;
+		args->pra_bufs.psb_kds       = res->psr_kds;
+		args->pra_bufs.psb_recx_size = res->psr_recx_size;
+		args->pra_bufs.psb_sgl_keys  = &res->psr_sgl_keys;
+		args->pra_bufs.psb_sgl_recx  = &res->psr_sgl_recx;
+	}
+	args->pra_bufs.psb_res = res;
+	args->pra_stream       = stream;
+
 	rc = tse_task_register_deps(api_task, 1, &task);
 	if (rc != 0)
 		D_GOTO(out_task, rc);
@@ -611,6 +1329,29 @@ dc_pipeline_run(tse_task_t *api_task)
 	int                           shard;
 	struct pipeline_comp_cb_args  comp_cb_args;
 	uint16_t                       layout_gl_ver;
+	daos_pipeline_t              *pipe     = api_args->pipeline;
+	struct pipeline_merge_args   *merge    = NULL;
+	struct pipeline_stream_args  *stream   = NULL;
+	uint64_t                      returned = 0;
+	uint32_t                      nr_kds;
+	uint32_t                      i;
+
+	if (api_args->stream != NULL) {
+		nr_kds = api_args->stream->nr_kds;
+	} else {
+		returned = pipeline_anchor_returned(api_args->anchor);
+		if ((daos_anchor_is_eof(api_args->anchor) &&
+		     (pipe->group_by != NULL || pipe->order_by != NULL)) ||
+		    (pipe->limit > 0 && returned >= pipe->limit)) {
+			/** everything was already returned by previous calls */
+			daos_anchor_set_eof(api_args->anchor);
+			*api_args->nr_kds = 0;
+			D_GOTO(out, rc = 0);
+		}
+		nr_kds = *api_args->nr_kds;
+	}
+	if (pipe->limit > 0)
+		nr_kds = min(nr_kds, pipe->limit - returned);
 
 	coh = dc_obj_hdl2cont_hdl(api_args->oh);
 	rc  = dc_obj_hdl2obj_md(api_args->oh, &obj_md);
@@ -673,6 +1414,34 @@ dc_pipeline_run(tse_task_t *api_task)
 	comp_cb_args.total_shards   = total_shards;
 	comp_cb_args.total_replicas = total_replicas;
 
+	/**
+	 * GROUP BY and ORDER BY need the results of all the shards, so the first replica of each
+	 * group is run at once, and the results are merged when all of them are done.
+	 */
+	if (pipe->group_by != NULL || pipe->order_by != NULL) {
+		rc = pipeline_merge_alloc(api_args, layout->ol_grp_nr, nr_kds, &merge);
+		if (rc != 0)
+			D_GOTO(out, rc);
+		if (api_args->stats != NULL)
+			pipeline_stats_reset(api_args->stats);
+	}
+	/**
+	 * daos_pipeline_scan() runs up to max_inflight shards at once, each shard task moving to
+	 * the next shard once it is done with its own.
+	 */
+	if (api_args->stream != NULL) {
+		rc = pipeline_stream_alloc(api_args, layout, &stream);
+		if (rc != 0)
+			D_GOTO(out, rc);
+		if (api_args->stats != NULL)
+			pipeline_stats_reset(api_args->stats);
+		for (i = 0; i < pipe->num_aggr_filters; i++)
+			*(double *)api_args->sgl_agg->sg_iovs[i].iov_buf =
+			    pipeline_aggr_init_value(pipe->aggr_filters[i]);
+	}
+	comp_cb_args.merge          = merge;
+	comp_cb_args.stream         = stream;
+
 	pipeline_create_auxi(api_task, map_ver, &obj_md, &pipeline_auxi);
 
 	rc = tse_task_register_comp_cb(api_task, pipeline_comp_cb, &comp_cb_args,
@@ -680,12 +1449,14 @@ dc_pipeline_run(tse_task_t *api_task)
 	if (rc != 0) {
 		D_ERROR("task %p, register_comp_cb " DF_RC "\n", api_task, DP_RC(rc));
 		tse_task_stack_pop(api_task, sizeof(struct pipeline_auxi_args));
+		pipeline_merge_free(merge);
+		pipeline_stream_free(stream);
 		D_GOTO(out, rc);
 	}
 
 	/** current shard */
 
-	shard           = dc_obj_anchor2shard(api_args->anchor);
+	shard           = api_args->anchor != NULL ? dc_obj_anchor2shard(api_args->anchor) : 0;
 
 	/** object id */
 	oid.id_pub		= obj_md.omd_id;
@@ -698,10 +1469,30 @@ dc_pipeline_run(tse_task_t *api_task)
 	shard_task_head = &pipeline_auxi->shard_task_head;
 	D_ASSERT(d_list_empty(shard_task_head));
 
-	rc = queue_shard_pipeline_run_task(api_task, layout, pipeline_auxi, shard, map_ver, oid,
-					   coh_uuid, cont_uuid);
-	if (rc)
-		D_GOTO(out, rc);
+	if (merge == NULL && stream == NULL) {
+		rc = queue_shard_pipeline_run_task(api_task, layout, pipeline_auxi, shard, map_ver,
+						   oid, coh_uuid, cont_uuid, nr_kds, NULL, NULL);
+		if (rc)
+			D_GOTO(out, rc);
+	}
+	for (i = 0; merge != NULL && i < merge->pm_nr; i++) {
+		shard        = i * total_replicas;
+		oid.id_shard = shard;
+		rc = queue_shard_pipeline_run_task(api_task, layout, pipeline_auxi, shard, map_ver,
+						   oid, coh_uuid, cont_uuid, nr_kds,
+						   &merge->pm_res[i], NULL);
+		if (rc)
+			D_GOTO(out, rc);
+	}
+	for (i = 0; stream != NULL && i < stream->ps_nr; i++) {
+		shard        = i * total_replicas;
+		oid.id_shard = shard;
+		rc = queue_shard_pipeline_run_task(api_task, layout, pipeline_auxi, shard, map_ver,
+						   oid, coh_uuid, cont_uuid, nr_kds,
+						   &stream->ps_res[i], stream);
+		if (rc)
+			D_GOTO(out, rc);
+	}
 
 	/* -- schedule queued shard task */
 
@@ -6,6 +6,7 @@
 
 #define D_LOGFAC DD_FAC(pipeline)
 
+#include <math.h>
 #include <daos/common.h>
 #include "pipeline_internal.h"
 
@@ -429,6 +430,154 @@ do_checks_for_string_constants(size_t ft, size_t pa, daos_filter_part_t *part)
 	return 0;
 }
 
+/**
+ * Checks 2 ... 9 of d_pipeline_check() for filter \a i of the pipeline.
+ */
+static int
+pipeline_filter_check(daos_filter_t *ftr, size_t i, bool is_aggr)
+{
+	size_t    p;
+	uint32_t  num_parts = 0;
+	int       num_operands;
+	bool      res;
+	char     *data_type;
+	size_t    data_type_s;
+	int       rc = 0;
+
+	if (ftr->num_parts)
+		num_parts = 1;
+
+	/** -- Checks 2 ... 7 */
+
+	for (p = 0; p < ftr->num_parts; p++) {
+		daos_filter_part_t *part = ftr->parts[p];
+
+		/** 2 */
+
+		res = pipeline_part_chk_type((char *)part->part_type.iov_buf,
+					     part->part_type.iov_len, is_aggr);
+		if (!res) {
+			D_ERROR("filter %zu, part %zu: part type %.*s is not supported\n",
+				i, p, (int)part->part_type.iov_len,
+				(char *)part->part_type.iov_buf);
+			return -DER_NOSYS;
+		}
+
+		/** 3 */
+
+		num_operands = pipeline_part_nops((char *)part->part_type.iov_buf,
+						  part->part_type.iov_len);
+
+		if (num_operands < 0) { /** special cases for AND and OR */
+			if (part->num_operands < 2)
+				rc = -DER_INVAL;
+		} else if (((uint32_t)num_operands) != part->num_operands) {
+			rc = -DER_INVAL;
+		}
+		if (rc != 0) {
+			D_ERROR("filter %zu, part %zu: part has an incorrect number of "
+				"operands\n", i, p);
+			return rc;
+		}
+		num_parts += part->num_operands;
+
+		/** 4 */
+
+		if (strncmp((char *)part->part_type.iov_buf, "DAOS_FILTER_FUN",
+			    strlen("DAOS_FILTER_FUN")) &&
+		    !part->data_type.iov_len) {
+			D_ERROR("filter %zu, part %zu: no data type defined\n", i, p);
+			return -DER_INVAL;
+		}
+
+		if (part->part_type.iov_len == strlen("DAOS_FILTER_CONST") &&
+		    !strncmp((char *)part->part_type.iov_buf, "DAOS_FILTER_CONST",
+			    strlen("DAOS_FILTER_CONST"))) {
+
+			/** 5 and 6 */
+
+			rc = do_checks_for_string_constants(i, p, part);
+			if (rc != 0)
+				return rc;
+		}
+
+		/** 7 */
+
+		res = pipeline_part_chk_data_type((char *)part->data_type.iov_buf,
+						  part->data_type.iov_len);
+		if (!res) {
+			D_ERROR("filter %zu, part %zu: data type %.*s is not supported\n",
+				i, p, (int)part->data_type.iov_len,
+				(char *)part->data_type.iov_buf);
+			return -DER_NOSYS;
+		}
+	}
+	/** 3 (continued) */
+
+	if (num_parts != ftr->num_parts) {
+		D_ERROR("filter %zu: mismatch between counted parts %u and .num_parts %u\n",
+			i, num_parts, ftr->num_parts);
+		return -DER_INVAL;
+	}
+
+	/** 8 */
+
+	p            = 0;
+	data_type    = NULL;
+	data_type_s  = 0;
+	if (ftr->num_parts > 0) {
+		res = pipeline_filter_checkops(ftr, &p, &data_type, &data_type_s);
+		if (!res) {
+			D_ERROR("filter %zu: wrong type for some part operands\n", i);
+			return -DER_INVAL;
+		}
+	}
+
+	/** 9 */
+
+	p = 0;
+	if (ftr->num_parts > 0) {
+		res = pipeline_filter_check_array_constants(ftr, &p);
+		if (!res) {
+			D_ERROR("filter %zu: array of constants placed in wrong operand\n", i);
+			return -DER_INVAL;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * Checks that a GROUP BY or ORDER BY filter is an expression computing a key for each record: a
+ * dkey, an akey, or an arithmetic function of them.
+ */
+static int
+pipeline_key_filter_check(daos_filter_t *ftr, size_t i)
+{
+	char   *part_type;
+	size_t  part_type_s;
+	int     rc;
+
+	if (ftr->num_parts == 0) {
+		D_ERROR("filter %zu: key filter has no parts\n", i);
+		return -DER_INVAL;
+	}
+	rc = pipeline_filter_check(ftr, i, false);
+	if (rc != 0)
+		return rc;
+
+	part_type   = (char *)ftr->parts[0]->part_type.iov_buf;
+	part_type_s = ftr->parts[0]->part_type.iov_len;
+	if (!is_arith_func(part_type, part_type_s) &&
+	    strncmp(part_type, "DAOS_FILTER_DKEY", part_type_s) &&
+	    strncmp(part_type, "DAOS_FILTER_AKEY", part_type_s)) {
+		D_ERROR("filter %zu: part type %.*s can't be a key\n", i, (int)part_type_s,
+			part_type);
+		return -DER_INVAL;
+	}
+	return 0;
+}
+
 int
 d_pipeline_check(daos_pipeline_t *pipeline)
 {
@@ -436,7 +585,7 @@ d_pipeline_check(daos_pipeline_t *pipeline)
 	int     rc = 0;
 
 	/**
-	 * TOTAL: 9 checks:
+	 * TOTAL: 12 checks:
 	 *
 	 *      -- Check 0: Check that pipeline is not NULL.
 	 *      -- Check 1: Check that filters are chained together correctly.
@@ -449,6 +598,10 @@ d_pipeline_check(daos_pipeline_t *pipeline)
 	 *      -- Check 7: Check that all parts have a correct data type.
 	 *      -- Check 8: Check that all parts have the right type of operands.
 	 *      -- Check 9: Check that arrays of constants are always on the right operand.
+	 *      -- Check 10: Check that GROUP BY and ORDER BY filters are key expressions.
+	 *      -- Check 11: Check that GROUP BY is used with aggregations, and ORDER BY with a
+	 *                   limit and without aggregations.
+	 *      -- Check 12: Check that a limit is not used with global aggregations.
 	 */
 
 	/** 0 */
@@ -475,126 +628,118 @@ d_pipeline_check(daos_pipeline_t *pipeline)
 			return -DER_INVAL;
 		}
 	}
+	if (pipeline->group_by != NULL &&
+	    strncmp((char *)pipeline->group_by->filter_type.iov_buf, "DAOS_FILTER_GROUP_BY",
+		    pipeline->group_by->filter_type.iov_len)) {
+		D_ERROR("group_by: filter type is not DAOS_FILTER_GROUP_BY\n");
+		return -DER_INVAL;
+	}
+	if (pipeline->order_by != NULL &&
+	    strncmp((char *)pipeline->order_by->filter_type.iov_buf, "DAOS_FILTER_ORDER_BY",
+		    pipeline->order_by->filter_type.iov_len) &&
+	    strncmp((char *)pipeline->order_by->filter_type.iov_buf, "DAOS_FILTER_ORDER_BY_DESC",
+		    pipeline->order_by->filter_type.iov_len)) {
+		D_ERROR("order_by: filter type is not DAOS_FILTER_ORDER_BY(_DESC)\n");
+		return -DER_INVAL;
+	}
 
-	/** -- Rest of the checks are done for each filter */
-
-	for (i = 0; i < pipeline->num_filters + pipeline->num_aggr_filters; i++) {
-		daos_filter_t  *ftr;
-		size_t          p;
-		uint32_t        num_parts     = 0;
-		int             num_operands;
-		bool            res;
-		bool            is_aggr;
-		char           *data_type;
-		size_t          data_type_s;
-
-		if (i < pipeline->num_filters) {
-			ftr     = pipeline->filters[i];
-			is_aggr = false;
-		} else {
-			ftr     = pipeline->aggr_filters[i - pipeline->num_filters];
-			is_aggr = true;
-		}
-		if (ftr->num_parts)
-			num_parts = 1;
-
-		/** -- Checks 2 ... 7 */
-
-		for (p = 0; p < ftr->num_parts; p++) {
-			daos_filter_part_t *part = ftr->parts[p];
-
-			/** 2 */
-
-			res = pipeline_part_chk_type((char *)part->part_type.iov_buf,
-						     part->part_type.iov_len, is_aggr);
-			if (!res) {
-				D_ERROR("filter %zu, part %zu: part type %.*s is not supported\n",
-					i, p, (int)part->part_type.iov_len,
-					(char *)part->part_type.iov_buf);
-				return -DER_NOSYS;
-			}
-
-			/** 3 */
+	/** -- Checks 2 ... 9 are done for each filter */
 
-			num_operands = pipeline_part_nops((char *)part->part_type.iov_buf,
-							  part->part_type.iov_len);
+	for (i = 0; i < pipeline->num_filters; i++) {
+		rc = pipeline_filter_check(pipeline->filters[i], i, false);
+		if (rc != 0)
+			return rc;
+	}
+	for (i = 0; i < pipeline->num_aggr_filters; i++) {
+		rc = pipeline_filter_check(pipeline->aggr_filters[i], pipeline->num_filters + i,
+					   true);
+		if (rc != 0)
+			return rc;
+	}
 
-			if (num_operands < 0) { /** special cases for AND and OR */
-				if (part->num_operands < 2)
-					rc = -DER_INVAL;
-			} else if (((uint32_t)num_operands) != part->num_operands) {
-				rc = -DER_INVAL;
-			}
-			if (rc != 0) {
-				D_ERROR("filter %zu, part %zu: part has an incorrect number of "
-					"operands\n", i, p);
-				return rc;
-			}
-			num_parts += part->num_operands;
+	/** 10 */
 
-			/** 4 */
+	i = pipeline->num_filters + pipeline->num_aggr_filters;
+	if (pipeline->group_by != NULL) {
+		rc = pipeline_key_filter_check(pipeline->group_by, i++);
+		if (rc != 0)
+			return rc;
+	}
+	if (pipeline->order_by != NULL) {
+		rc = pipeline_key_filter_check(pipeline->order_by, i);
+		if (rc != 0)
+			return rc;
+	}
 
-			if (strncmp((char *)part->part_type.iov_buf, "DAOS_FILTER_FUN",
-				    strlen("DAOS_FILTER_FUN")) &&
-			    !part->data_type.iov_len) {
-				D_ERROR("filter %zu, part %zu: no data type defined\n", i, p);
-				return -DER_INVAL;
-			}
+	/** 11 */
 
-			if (part->part_type.iov_len == strlen("DAOS_FILTER_CONST") &&
-			    !strncmp((char *)part->part_type.iov_buf, "DAOS_FILTER_CONST",
-				    strlen("DAOS_FILTER_CONST"))) {
+	if (pipeline->group_by != NULL && pipeline->num_aggr_filters == 0) {
+		D_ERROR("GROUP BY needs at least one aggregation filter\n");
+		return -DER_INVAL;
+	}
+	if (pipeline->order_by != NULL &&
+	    (pipeline->limit == 0 || pipeline->num_aggr_filters > 0)) {
+		D_ERROR("ORDER BY needs a limit, and can't be used with aggregations\n");
+		return -DER_INVAL;
+	}
 
-				/** 5 and 6 */
+	/** 12 */
 
-				rc = do_checks_for_string_constants(i, p, part);
-				if (rc != 0)
-					return rc;
-			}
+	if (pipeline->limit > 0 && pipeline->num_aggr_filters > 0 && pipeline->group_by == NULL) {
+		D_ERROR("limit can't be used with aggregations without GROUP BY\n");
+		return -DER_INVAL;
+	}
 
-			/** 7 */
+	return 0;
+}
 
-			res = pipeline_part_chk_data_type((char *)part->data_type.iov_buf,
-							  part->data_type.iov_len);
-			if (!res) {
-				D_ERROR("filter %zu, part %zu: data type %.*s is not supported\n",
-					i, p, (int)part->data_type.iov_len,
-					(char *)part->data_type.iov_buf);
-				return -DER_NOSYS;
-			}
-		}
-		/** 3 (continued) */
+/**
+ * Appends \a iov to the data in \a sgl, starting at iov \a *iov_idx. Values are never split among
+ * several iovs of the sgl, \a *iov_idx is moved to the iov the value was copied to.
+ */
+int
+pipeline_pack_value(d_sg_list_t *sgl, uint32_t *iov_idx, d_iov_t *iov)
+{
+	uint32_t      iov_idx_bk = *iov_idx;
+	d_iov_t      *out_iov    = &sgl->sg_iovs[*iov_idx];
+	char         *ptr;
 
-		if (num_parts != ftr->num_parts) {
-			D_ERROR("filter %zu: mismatch between counted parts %u and .num_parts %u\n",
-				i, num_parts, ftr->num_parts);
-			return -DER_INVAL;
+try_out_iov:
+	if (iov->iov_len + out_iov->iov_len > out_iov->iov_buf_len) {
+		if (iov_idx_bk > *iov_idx || (iov_idx_bk == *iov_idx && !out_iov->iov_len)) {
+			/**
+			 * If we can't still copy the input iov in an empty out_iov, then the
+			 * out_iov is way too small. No empty iovs are skipped in the sgl.
+			 */
+			D_ERROR("iov has no space available for data value\n");
+			return -DER_REC2BIG;
 		}
-
-		/** 8 */
-
-		p            = 0;
-		data_type    = NULL;
-		data_type_s  = 0;
-		if (ftr->num_parts > 0) {
-			res = pipeline_filter_checkops(ftr, &p, &data_type, &data_type_s);
-			if (!res) {
-				D_ERROR("filter %zu: wrong type for some part operands\n", i);
-				return -DER_INVAL;
-			}
+		/**
+		 * No space left in current out_iov to copy the iov, and data values are never split
+		 * among different iovs. Trying one more time with the next iov in the sgl.
+		 */
+		iov_idx_bk++;
+		if (iov_idx_bk == sgl->sg_nr) {
+			D_ERROR("Consumed all iovs in the sgl, no space available for the rest of "
+				"the data\n");
+			return -DER_REC2BIG;
 		}
+		out_iov = &sgl->sg_iovs[iov_idx_bk];
+		goto try_out_iov;
+	}
+	*iov_idx = iov_idx_bk;
 
-		/** 9 */
+	ptr               = out_iov->iov_buf;
+	ptr              += out_iov->iov_len;
+	memcpy(ptr, iov->iov_buf, iov->iov_len);
 
-		p = 0;
-		if (ftr->num_parts > 0) {
-			res = pipeline_filter_check_array_constants(ftr, &p);
-			if (!res) {
-				D_ERROR("filter %zu: array of constants placed in wrong operand\n",
-					i);
-				return -DER_INVAL;
-			}
-		}
+	out_iov->iov_len += iov->iov_len;
+	if (out_iov->iov_len == iov->iov_len) {
+		/**
+		 * out_iov was a fresh new iov, so we need to increase the number of valid output
+		 * iovs in the sgl.
+		 */
+		sgl->sg_nr_out++;
 	}
 
 	return 0;
@@ -619,3 +764,150 @@ pipeline_aggregations_fixavgs(daos_pipeline_t *pipeline, double total, d_sg_list
 		}
 	}
 }
+
+/** true if the records are sorted by decreasing keys by ORDER BY filter \a ftr */
+bool
+pipeline_order_is_desc(daos_filter_t *ftr)
+{
+	return !strncmp((char *)ftr->filter_type.iov_buf, "DAOS_FILTER_ORDER_BY_DESC",
+			ftr->filter_type.iov_len);
+}
+
+/** initial value of the aggregation computed by \a ftr */
+double
+pipeline_aggr_init_value(daos_filter_t *ftr)
+{
+	char   *part_type   = (char *)ftr->parts[0]->part_type.iov_buf;
+	size_t  part_type_s = ftr->parts[0]->part_type.iov_len;
+
+	if (!strncmp(part_type, "DAOS_FILTER_FUNC_MAX", part_type_s))
+		return -INFINITY;
+	if (!strncmp(part_type, "DAOS_FILTER_FUNC_MIN", part_type_s))
+		return INFINITY;
+	return 0;
+}
+
+/**
+ * Merges \a src, the value of the aggregation computed by \a ftr over some records, into \a dst.
+ * Averages are merged as sums.
+ */
+void
+pipeline_aggr_merge(daos_filter_t *ftr, double *dst, double src)
+{
+	char   *part_type   = (char *)ftr->parts[0]->part_type.iov_buf;
+	size_t  part_type_s = ftr->parts[0]->part_type.iov_len;
+
+	if (!strncmp(part_type, "DAOS_FILTER_FUNC_SUM", part_type_s) ||
+	    !strncmp(part_type, "DAOS_FILTER_FUNC_AVG", part_type_s)) {
+		*dst += src;
+	} else if (!strncmp(part_type, "DAOS_FILTER_FUNC_MIN", part_type_s)) {
+		if (src < *dst)
+			*dst = src;
+	} else if (!strncmp(part_type, "DAOS_FILTER_FUNC_MAX", part_type_s)) {
+		if (src > *dst)
+			*dst = src;
+	}
+}
+
+/** true if the aggregation computed by \a ftr is an average */
+bool
+pipeline_aggr_is_avg(daos_filter_t *ftr)
+{
+	return !strncmp((char *)ftr->parts[0]->part_type.iov_buf, "DAOS_FILTER_FUNC_AVG",
+			ftr->parts[0]->part_type.iov_len);
+}
+
+/**
+ * Compares two GROUP BY or ORDER BY keys, NULL keys being the smallest ones. Returns a negative
+ * value, zero, or a positive value if \a a is smaller, equal, or larger than \a b.
+ */
+int
+pipeline_key_cmp(struct pipeline_key_t *a, struct pipeline_key_t *b)
+{
+	int rc;
+
+	if (a->cls != b->cls)
+		return a->cls == PIPELINE_KEY_NULL ? -1 : (b->cls == PIPELINE_KEY_NULL ? 1 :
+			(int)a->cls - (int)b->cls);
+
+	switch (a->cls) {
+	case SUBIDX_UINTEGER:
+		return a->v.u < b->v.u ? -1 : (a->v.u > b->v.u);
+	case SUBIDX_INTEGER:
+		return a->v.i < b->v.i ? -1 : (a->v.i > b->v.i);
+	case SUBIDX_DOUBLE:
+		return a->v.d < b->v.d ? -1 : (a->v.d > b->v.d);
+	case SUBIDX_STR:
+		rc = memcmp(a->data, b->data, min(a->len, b->len));
+		if (rc != 0)
+			return rc;
+		return a->len < b->len ? -1 : (a->len > b->len);
+	default:
+		return 0; /** NULL keys */
+	}
+}
+
+/**
+ * Size of a key packed by pipeline_key_pack(): one byte for the class of the key, followed by 8
+ * bytes for numbers, or by the 4 bytes length and the data for strings.
+ */
+size_t
+pipeline_key_size(struct pipeline_key_t *key)
+{
+	if (key->cls == PIPELINE_KEY_NULL)
+		return 1;
+	if (key->cls == SUBIDX_STR)
+		return 1 + sizeof(uint32_t) + key->len;
+	return 1 + sizeof(uint64_t);
+}
+
+/** packs \a key into \a buf, returning the end of the packed key */
+char *
+pipeline_key_pack(struct pipeline_key_t *key, char *buf)
+{
+	*buf++ = (char)key->cls;
+	if (key->cls == PIPELINE_KEY_NULL)
+		return buf;
+	if (key->cls == SUBIDX_STR) {
+		memcpy(buf, &key->len, sizeof(key->len));
+		buf += sizeof(key->len);
+		memcpy(buf, key->data, key->len);
+		return buf + key->len;
+	}
+	memcpy(buf, &key->v, sizeof(key->v));
+	return buf + sizeof(key->v);
+}
+
+/**
+ * Unpacks the key at \a *buf, which can't go past \a end, and moves \a *buf after it. The data of
+ * a string key points into the packed buffer.
+ */
+int
+pipeline_key_unpack(char **buf, char *end, struct pipeline_key_t *key)
+{
+	char *ptr = *buf;
+
+	if (ptr >= end)
+		return -DER_PROTO;
+	key->cls = (uint8_t)*ptr++;
+	if (key->cls == PIPELINE_KEY_NULL) {
+		*buf = ptr;
+		return 0;
+	}
+	if (key->cls == SUBIDX_STR) {
+		if (end - ptr < sizeof(key->len))
+			return -DER_PROTO;
+		memcpy(&key->len, ptr, sizeof(key->len));
+		ptr += sizeof(key->len);
+		if (end - ptr < key->len)
+			return -DER_PROTO;
+		key->data = ptr;
+		*buf      = ptr + key->len;
+		return 0;
+	}
+	if (key->cls > SUBIDX_STR || end - ptr < sizeof(key->v))
+		return -DER_PROTO;
+	memcpy(&key->v, ptr, sizeof(key->v));
+	*buf = ptr + sizeof(key->v);
+	return 0;
+}
@@ -11,56 +11,6 @@
 #include "pipeline_internal.h"
 #include <daos/common.h>
 
-#define NTYPES              13
-#define NTYPES_NOSIZE        4
-#define N_FILTER_FUNC_PTRS  53
-#define N_GETD_FUNC_PTRS    39
-
-#define SUBIDX_UINTEGER1  0
-#define SUBIDX_UINTEGER2  1
-#define SUBIDX_UINTEGER4  2
-#define SUBIDX_UINTEGER8  3
-#define SUBIDX_INTEGER1   4
-#define SUBIDX_INTEGER2   5
-#define SUBIDX_INTEGER4   6
-#define SUBIDX_INTEGER8   7
-#define SUBIDX_REAL4      8
-#define SUBIDX_REAL8      9
-#define SUBIDX_BINARY    10
-#define SUBIDX_STRING    11
-#define SUBIDX_CSTRING   12
-
-#define SUBIDX_UINTEGER   0
-#define SUBIDX_INTEGER    1
-#define SUBIDX_DOUBLE     2
-#define SUBIDX_STR        3
-
-#define SUBIDX_FUNC_EQ        0
-#define SUBIDX_FUNC_NE        NTYPES_NOSIZE
-#define SUBIDX_FUNC_LT        (NTYPES_NOSIZE * 2)
-#define SUBIDX_FUNC_LE        (NTYPES_NOSIZE * 3)
-#define SUBIDX_FUNC_GE        (NTYPES_NOSIZE * 4)
-#define SUBIDX_FUNC_GT        (NTYPES_NOSIZE * 5)
-
-#define SUBIDX_FUNC_ADD       (NTYPES_NOSIZE * 6) /** these do not work with strings */
-#define SUBIDX_FUNC_SUB       (SUBIDX_FUNC_ADD + (NTYPES_NOSIZE - 1))
-#define SUBIDX_FUNC_MUL       (SUBIDX_FUNC_ADD + (NTYPES_NOSIZE - 1) * 2)
-#define SUBIDX_FUNC_DIV       (SUBIDX_FUNC_ADD + (NTYPES_NOSIZE - 1) * 3)
-#define SUBIDX_FUNC_SUM       (SUBIDX_FUNC_ADD + (NTYPES_NOSIZE - 1) * 4)
-#define SUBIDX_FUNC_MAX       (SUBIDX_FUNC_ADD + (NTYPES_NOSIZE - 1) * 5)
-#define SUBIDX_FUNC_MIN       (SUBIDX_FUNC_ADD + (NTYPES_NOSIZE - 1) * 6)
-
-#define SUBIDX_FUNC_BITAND    (SUBIDX_FUNC_ADD + (NTYPES_NOSIZE - 1) * 7) /** only works w/ int */
-
-#define SUBIDX_FUNC_LIKE      (SUBIDX_FUNC_BITAND + (NTYPES_NOSIZE - 2))  /** only works w/ str */
-#define SUBIDX_FUNC_ISNULL    (SUBIDX_FUNC_LIKE + 1)/** type is N/A */
-#define SUBIDX_FUNC_ISNOTNULL (SUBIDX_FUNC_LIKE + 2)
-#define SUBIDX_FUNC_NOT       (SUBIDX_FUNC_LIKE + 3)
-#define SUBIDX_FUNC_AND       (SUBIDX_FUNC_LIKE + 4)
-#define SUBIDX_FUNC_OR        (SUBIDX_FUNC_LIKE + 5)
-
-#define SUBIDX_FUNCS_WITH_ONE_TYPE_ONLY SUBIDX_FUNC_LIKE
-
 static filter_func_t *filter_func_ptrs[N_FILTER_FUNC_PTRS] = {
     filter_func_eq_u,   filter_func_eq_i,      filter_func_eq_d,     filter_func_eq_st,
     filter_func_ne_u,   filter_func_ne_i,      filter_func_ne_d,     filter_func_ne_st,
@@ -92,24 +42,12 @@ static filter_func_t *getd_func_ptrs[N_GETD_FUNC_PTRS] = {
 void
 pipeline_aggregations_init(daos_pipeline_t *pipeline, d_sg_list_t *sgl_agg)
 {
-	uint32_t            i;
-	double             *buf;
-	daos_filter_part_t *part;
-	char               *part_type;
-	size_t              part_type_s;
+	uint32_t  i;
+	double   *buf;
 
 	for (i = 0; i < pipeline->num_aggr_filters; i++) {
-		part        = pipeline->aggr_filters[i]->parts[0];
-		buf         = (double *)sgl_agg->sg_iovs[i].iov_buf;
-		part_type   = (char *)part->part_type.iov_buf;
-		part_type_s = part->part_type.iov_len;
-
-		if (!strncmp(part_type, "DAOS_FILTER_FUNC_MAX", part_type_s))
-			*buf = -INFINITY;
-		else if (!strncmp(part_type, "DAOS_FILTER_FUNC_MIN", part_type_s))
-			*buf = INFINITY;
-		else
-			*buf = 0;
+		buf  = (double *)sgl_agg->sg_iovs[i].iov_buf;
+		*buf = pipeline_aggr_init_value(pipeline->aggr_filters[i]);
 
 		sgl_agg->sg_iovs[i].iov_len = sizeof(double);
 	}
@@ -121,7 +59,7 @@ pipeline_aggregations_init(daos_pipeline_t *pipeline, d_sg_list_t *sgl_agg)
  * function calc_type_idx(). There is only 4 types if we don't consider the size: unsigned int,
  * signed int, double and string.
  */
-static uint32_t
+uint32_t
 calc_type_nosize_idx(uint32_t idx)
 {
 	/** TODO: This could probably be done better with a FOREACH macro. */
@@ -138,7 +76,7 @@ calc_type_nosize_idx(uint32_t idx)
  * calculates the index of a type: this is used to point to the right function in the get data func
  * ptrs defined above.
  */
-static uint32_t
+uint32_t
 calc_type_idx(char *type, size_t type_len)
 {
 	/** TODO: This could probably be done better with a FOREACH macro. */
@@ -175,7 +113,7 @@ calc_type_idx(char *type, size_t type_len)
  * func ptrs defined above. The space between function classes is there for the different types.
  * For example, there is 4 EQ functions (unsigned int, signed int, doubles, and strings).
  */
-static uint32_t
+uint32_t
 calc_filterfunc_idx(daos_filter_part_t **parts, uint32_t idx)
 {
 	char  *part_type;
@@ -346,61 +284,141 @@ exit:
 	return rc;
 }
 
+/**
+ * Compiles the tree of filter_func_t of \a ftr into \a c_ftr.
+ */
 static int
-compile_filters(daos_filter_t **ftrs, uint32_t nftrs, struct filter_compiled_t *c_ftrs)
+compile_filter_parts(daos_filter_t *ftr, struct filter_compiled_t *c_ftr)
 {
-	uint32_t             part_idx;
-	uint32_t             comp_part_idx;
+	uint32_t             part_idx      = 0;
+	uint32_t             comp_part_idx = 0;
 	uint32_t             comp_num_parts;
-	uint32_t             i               = 0;
-	uint32_t             j, k;
-	char                *type;
-	size_t               type_len;
-	int                  rc;
+	uint32_t             j;
+	char                *type          = NULL;
+	size_t               type_len      = 0;
 	daos_filter_part_t  *part;
 
-	for (; i < nftrs; i++) {
-		comp_num_parts = ftrs[i]->num_parts;
+	comp_num_parts = ftr->num_parts;
+	for (j = 0; j < ftr->num_parts; j++) {
+		part = ftr->parts[j];
+		if (!strncmp((char *)part->part_type.iov_buf, "DAOS_FILTER_CONST",
+			     part->part_type.iov_len))
+			comp_num_parts += part->num_constants - 1;
+	}
 
-		for (j = 0; j < ftrs[i]->num_parts; j++) {
-			part = ftrs[i]->parts[j];
-			if (!strncmp((char *)part->part_type.iov_buf, "DAOS_FILTER_CONST",
-				     part->part_type.iov_len))
-				comp_num_parts += part->num_constants - 1;
-		}
+	D_ALLOC_ARRAY(c_ftr->parts, comp_num_parts);
+	if (c_ftr->parts == NULL)
+		return -DER_NOMEM;
 
-		D_ALLOC_ARRAY(c_ftrs[i].parts, comp_num_parts);
-		if (c_ftrs[i].parts == NULL)
-			D_GOTO(error, rc = -DER_NOMEM);
+	c_ftr->num_parts = comp_num_parts;
+	return compile_filter(ftr, c_ftr, &part_idx, &comp_part_idx, &type, &type_len);
+}
 
-		c_ftrs[i].num_parts = comp_num_parts;
-		part_idx            = 0;
-		comp_part_idx       = 0;
-		type                = NULL;
-		type_len            = 0;
-		rc = compile_filter(ftrs[i], &c_ftrs[i], &part_idx, &comp_part_idx, &type,
-				    &type_len);
+static int
+compile_filters(daos_filter_t **ftrs, uint32_t nftrs, struct filter_compiled_t *c_ftrs)
+{
+	uint32_t             i               = 0;
+	uint32_t             k;
+	int                  rc;
+
+	for (; i < nftrs; i++) {
+		rc = compile_filter_parts(ftrs[i], &c_ftrs[i]);
 		if (rc != 0)
 			D_GOTO(error, rc);
+
+		if (pipeline_prog_enabled) {
+			rc = filter_prog_compile(ftrs[i], &c_ftrs[i].prog);
+			if (rc != 0)
+				D_GOTO(error, rc);
+		}
 	}
 	return 0;
 error:
-	for (k = 0; k <= i; k++) {
+	for (k = 0; k <= i && k < nftrs; k++) {
 		if (c_ftrs[k].parts != NULL)
 			D_FREE(c_ftrs[k].parts);
+		filter_prog_free(c_ftrs[k].prog);
+		c_ftrs[k].prog = NULL;
 	}
 	return rc;
 }
 
+/**
+ * Compiles \a filter again into \a comp, e.g. after its operands have been reordered. \a comp is
+ * left untouched on error.
+ */
+int
+filter_recompile(daos_filter_t *filter, struct filter_compiled_t *comp)
+{
+	struct filter_compiled_t c_ftr = {0};
+	int                      rc;
+
+	rc = compile_filters(&filter, 1, &c_ftr);
+	if (rc != 0)
+		return rc;
+
+	D_FREE(comp->parts);
+	filter_prog_free(comp->prog);
+	comp->num_parts = c_ftr.num_parts;
+	comp->parts     = c_ftr.parts;
+	comp->prog      = c_ftr.prog;
+	return 0;
+}
+
+/**
+ * Compiles a GROUP BY or ORDER BY key. Keys are always evaluated with the filter_func_t tree, as
+ * filter programs only return booleans.
+ */
+static int
+compile_key(daos_filter_t *ftr, struct filter_key_t **key)
+{
+	daos_filter_part_t  *part;
+	uint32_t             i;
+	int                  rc;
+
+	D_ALLOC_PTR(*key);
+	if (*key == NULL)
+		return -DER_NOMEM;
+
+	rc = compile_filter_parts(ftr, &(*key)->ftr);
+	if (rc != 0)
+		return rc;
+
+	/** d_pipeline_check() made sure that all the operands have the same class of type */
+	for (i = 0; i < ftr->num_parts; i++) {
+		part = ftr->parts[i];
+		if (part->data_type.iov_len == 0)
+			continue;
+		(*key)->cls = calc_type_nosize_idx(calc_type_idx((char *)part->data_type.iov_buf,
+								 part->data_type.iov_len));
+		break;
+	}
+	return 0;
+}
+
+static void
+compile_key_free(struct filter_key_t *key)
+{
+	if (key == NULL)
+		return;
+	D_FREE(key->ftr.parts);
+	D_FREE(key);
+}
+
 int
 pipeline_compile(daos_pipeline_t *pipe, struct pipeline_compiled_t *comp_pipe)
 {
-	int rc;
+	uint32_t i;
+	int      rc;
 
 	comp_pipe->num_filters      = 0;
 	comp_pipe->filters          = NULL;
 	comp_pipe->num_aggr_filters = 0;
 	comp_pipe->aggr_filters     = NULL;
+	comp_pipe->num_cols         = 0;
+	comp_pipe->cols             = NULL;
+	comp_pipe->group_by         = NULL;
+	comp_pipe->order_by         = NULL;
 
 	if (pipe->num_filters > 0) {
 		D_ALLOC_ARRAY(comp_pipe->filters, pipe->num_filters);
@@ -423,12 +441,45 @@ pipeline_compile(daos_pipeline_t *pipe, struct pipeline_compiled_t *comp_pipe)
 		if (rc != 0)
 			D_GOTO(error, rc);
 	}
+	if (pipeline_batch_size > 1) {
+		for (i = 0; i < comp_pipe->num_filters; i++) {
+			rc = filter_vec_compile(comp_pipe, pipe->filters[i], false,
+						&comp_pipe->filters[i].vec);
+			if (rc != 0)
+				D_GOTO(error, rc);
+		}
+		/** grouped aggregations are computed per record, in the slots of their group */
+		for (i = 0; i < comp_pipe->num_aggr_filters && pipe->group_by == NULL; i++) {
+			rc = filter_vec_compile(comp_pipe, pipe->aggr_filters[i], true,
+						&comp_pipe->aggr_filters[i].vec);
+			if (rc != 0)
+				D_GOTO(error, rc);
+		}
+	}
+	if (pipe->group_by != NULL) {
+		rc = compile_key(pipe->group_by, &comp_pipe->group_by);
+		if (rc != 0)
+			D_GOTO(error, rc);
+	}
+	if (pipe->order_by != NULL) {
+		rc = compile_key(pipe->order_by, &comp_pipe->order_by);
+		if (rc != 0)
+			D_GOTO(error, rc);
+	}
+	if (pipeline_adapt_sample == 0)
+		return 0;
+
+	/** vectorized filters evaluate all their predicates, their order does not matter */
+	for (i = 0; i < comp_pipe->num_filters; i++) {
+		if (comp_pipe->filters[i].vec != NULL)
+			continue;
+		rc = filter_adapt_init(pipe->filters[i], &comp_pipe->filters[i].adapt);
+		if (rc != 0)
+			D_GOTO(error, rc);
+	}
 	return 0;
 error:
-	if (comp_pipe->filters != NULL)
-		D_FREE(comp_pipe->filters);
-	if (comp_pipe->aggr_filters != NULL)
-		D_FREE(comp_pipe->aggr_filters);
+	pipeline_compile_free(comp_pipe);
 	return rc;
 }
 
@@ -441,14 +492,27 @@ pipeline_compile_free(struct pipeline_compiled_t *comp_pipe)
 		for (i = 0; i < comp_pipe->num_filters; i++) {
 			if (comp_pipe->filters[i].num_parts > 0)
 				D_FREE(comp_pipe->filters[i].parts);
+			filter_prog_free(comp_pipe->filters[i].prog);
+			filter_vec_free(comp_pipe->filters[i].vec);
+			filter_adapt_free(comp_pipe->filters[i].adapt);
 		}
 		D_FREE(comp_pipe->filters);
+		comp_pipe->num_filters = 0;
 	}
 	if (comp_pipe->num_aggr_filters > 0) {
 		for (i = 0; i < comp_pipe->num_aggr_filters; i++) {
 			if (comp_pipe->aggr_filters[i].num_parts > 0)
 				D_FREE(comp_pipe->aggr_filters[i].parts);
+			filter_prog_free(comp_pipe->aggr_filters[i].prog);
+			filter_vec_free(comp_pipe->aggr_filters[i].vec);
 		}
 		D_FREE(comp_pipe->aggr_filters);
+		comp_pipe->num_aggr_filters = 0;
 	}
+	D_FREE(comp_pipe->cols);
+	comp_pipe->num_cols = 0;
+	compile_key_free(comp_pipe->group_by);
+	comp_pipe->group_by = NULL;
+	compile_key_free(comp_pipe->order_by);
+	comp_pipe->order_by = NULL;
 }
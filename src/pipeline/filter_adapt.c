@@ -0,0 +1,373 @@
+/**
+ * (C) Copyright 2026 Hewlett Packard Enterprise Development LP
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+/**
+ * Adaptive ordering of the operands of AND/OR functions.
+ *
+ * AND and OR stop at the first operand deciding their result (false for AND, true for OR), so
+ * the cost of a filter depends on the order of their operands. One record out of
+ * pipeline_adapt_sample is profiled: each operand of each AND/OR is evaluated on its own, timed,
+ * and its counters are updated. Every PIPELINE_ADAPT_PERIOD profiled records, the operands are
+ * sorted by increasing cost / P(operand decides the result), which minimizes the expected cost of
+ * independent operands, and the filter is compiled again if their order changed. Profiling is
+ * done less often while the order does not change, up to PIPELINE_ADAPT_BACKOFF times less.
+ *
+ * Filters received from the client are never modified: the reordered parts live in a copy of the
+ * filter, and counters are kept by index of the part in the original filter.
+ */
+#define D_LOGFAC DD_FAC(pipeline)
+
+#include <daos/common.h>
+#include "pipeline_internal.h"
+
+unsigned int pipeline_adapt_sample = PIPELINE_ADAPT_SAMPLE;
+
+/** cost of reading the clock, subtracted from the measured evaluation times */
+static int64_t adapt_clock_ns = -1;
+
+static void
+adapt_clock_calibrate(void)
+{
+	struct timespec t0;
+	struct timespec t1;
+	int64_t         ns;
+	int64_t         min_ns = INT64_MAX;
+	int             i;
+
+	for (i = 0; i < 16; i++) {
+		d_gettime(&t0);
+		d_gettime(&t1);
+		ns = d_timediff_ns(&t0, &t1);
+		if (ns < min_ns)
+			min_ns = ns;
+	}
+	adapt_clock_ns = max(min_ns, 0);
+}
+
+static bool
+part_is_func(daos_filter_part_t *part)
+{
+	size_t len = min(part->part_type.iov_len, strlen("DAOS_FILTER_FUNC"));
+
+	return !strncmp((char *)part->part_type.iov_buf, "DAOS_FILTER_FUNC", len);
+}
+
+static bool
+part_is_andor(daos_filter_part_t **parts, uint32_t idx)
+{
+	uint32_t func_idx;
+
+	if (!part_is_func(parts[idx]) || parts[idx]->num_operands < 2)
+		return false;
+	func_idx = calc_filterfunc_idx(parts, idx);
+	return func_idx == SUBIDX_FUNC_AND || func_idx == SUBIDX_FUNC_OR;
+}
+
+/** returns the index following the subtree of part \a idx */
+static uint32_t
+subtree_end(daos_filter_part_t **parts, uint32_t idx)
+{
+	uint32_t nops = 0;
+	uint32_t i;
+
+	if (part_is_func(parts[idx]))
+		nops = parts[idx]->num_operands;
+	idx++;
+	for (i = 0; i < nops; i++)
+		idx = subtree_end(parts, idx);
+	return idx;
+}
+
+/** same numbering as compile_filter(): constants take one compiled part per value */
+static void
+adapt_comp_idx(struct filter_adapt_t *adapt)
+{
+	daos_filter_part_t *part;
+	uint32_t            comp_idx = 0;
+	uint32_t            i;
+
+	for (i = 0; i < adapt->filter.num_parts; i++) {
+		part                = adapt->filter.parts[i];
+		adapt->comp_idx[i] = comp_idx++;
+		if (!strncmp((char *)part->part_type.iov_buf, "DAOS_FILTER_CONST",
+			     part->part_type.iov_len))
+			comp_idx += part->num_constants - 1;
+	}
+}
+
+int
+filter_adapt_init(daos_filter_t *filter, struct filter_adapt_t **adapt)
+{
+	struct filter_adapt_t *ad;
+	uint32_t               i;
+
+	*adapt = NULL;
+	for (i = 0; i < filter->num_parts; i++) {
+		if (part_is_andor(filter->parts, i))
+			break;
+	}
+	if (i == filter->num_parts)
+		return 0; /** nothing to reorder */
+
+	D_ALLOC_PTR(ad);
+	if (ad == NULL)
+		return -DER_NOMEM;
+	ad->filter = *filter;
+	D_ALLOC_ARRAY(ad->filter.parts, filter->num_parts);
+	D_ALLOC_ARRAY(ad->orig_idx, filter->num_parts);
+	D_ALLOC_ARRAY(ad->comp_idx, filter->num_parts);
+	D_ALLOC_ARRAY(ad->stats, filter->num_parts);
+	if (ad->filter.parts == NULL || ad->orig_idx == NULL || ad->comp_idx == NULL ||
+	    ad->stats == NULL) {
+		filter_adapt_free(ad);
+		return -DER_NOMEM;
+	}
+
+	for (i = 0; i < filter->num_parts; i++) {
+		ad->filter.parts[i] = filter->parts[i];
+		ad->orig_idx[i]     = i;
+	}
+	adapt_comp_idx(ad);
+	ad->interval  = pipeline_adapt_sample;
+	ad->countdown = 1; /** first record is profiled */
+	if (adapt_clock_ns < 0)
+		adapt_clock_calibrate();
+
+	*adapt = ad;
+	return 0;
+}
+
+void
+filter_adapt_free(struct filter_adapt_t *adapt)
+{
+	if (adapt == NULL)
+		return;
+	D_FREE(adapt->filter.parts);
+	D_FREE(adapt->orig_idx);
+	D_FREE(adapt->comp_idx);
+	D_FREE(adapt->stats);
+	D_FREE(adapt);
+}
+
+/**
+ * Evaluates and times each operand of the AND/ORs in the subtree of part \a idx. Returns the
+ * index following the subtree.
+ */
+static uint32_t
+adapt_profile(struct filter_adapt_t *adapt, struct filter_compiled_t *comp, uint32_t idx,
+	      struct filter_part_run_t *args)
+{
+	daos_filter_part_t         **parts = adapt->filter.parts;
+	daos_pipeline_part_stats_t  *st;
+	struct timespec              t0;
+	struct timespec              t1;
+	int64_t                      ns;
+	uint32_t                     nops;
+	uint32_t                     op;
+	uint32_t                     i;
+	bool                         andor;
+	int                          rc;
+
+	if (!part_is_func(parts[idx]))
+		return idx + 1;
+
+	nops  = parts[idx]->num_operands;
+	andor = part_is_andor(parts, idx);
+	op    = idx + 1;
+	for (i = 0; i < nops; i++) {
+		if (andor) {
+			args->parts    = comp->parts;
+			args->part_idx = adapt->comp_idx[op];
+			d_gettime(&t0);
+			rc = comp->parts[args->part_idx].filter_func(args);
+			d_gettime(&t1);
+			/** errors are reported by the evaluation of the whole filter */
+			if (rc == 0) {
+				ns = d_timediff_ns(&t0, &t1) - adapt_clock_ns;
+				st = &adapt->stats[adapt->orig_idx[op]];
+				st->nr_evals++;
+				st->nr_false += !args->log_out;
+				st->eval_ns  += max(ns, 0);
+			}
+		}
+		op = adapt_profile(adapt, comp, op, args);
+	}
+	return op;
+}
+
+/** expected cost of an operand per record whose AND/OR result it decides */
+static double
+adapt_rank(daos_pipeline_part_stats_t *st, bool is_and)
+{
+	double decided;
+
+	if (st->nr_evals == 0)
+		return 0.0;
+	decided = is_and ? st->nr_false : st->nr_evals - st->nr_false;
+	/** the +1/+2 keep an operand that never decided the result from ranking at infinity */
+	return ((double)st->eval_ns / st->nr_evals) / ((decided + 1.0) / (st->nr_evals + 2.0));
+}
+
+struct adapt_scratch {
+	daos_filter_part_t	**parts;
+	uint32_t		*orig_idx;
+	uint32_t		*start;
+	uint32_t		*perm;
+	double			*rank;
+};
+
+/**
+ * Orders the operands of the AND/ORs in the subtree of part \a idx, innermost first, as moving
+ * a subtree keeps its own order. Returns the index following the subtree.
+ */
+static uint32_t
+adapt_order(struct filter_adapt_t *adapt, uint32_t idx, struct adapt_scratch *tmp, bool *changed)
+{
+	daos_filter_part_t **parts = adapt->filter.parts;
+	uint32_t             nops;
+	uint32_t             end;
+	uint32_t             len;
+	uint32_t             pos;
+	uint32_t             i;
+	uint32_t             j;
+	uint32_t             k;
+	bool                 is_and;
+
+	if (!part_is_func(parts[idx]))
+		return idx + 1;
+
+	nops = parts[idx]->num_operands;
+	end  = idx + 1;
+	for (i = 0; i < nops; i++)
+		end = adapt_order(adapt, end, tmp, changed);
+	if (!part_is_andor(parts, idx))
+		return end;
+
+	/** stable insertion sort of the operands by rank */
+	is_and = calc_filterfunc_idx(parts, idx) == SUBIDX_FUNC_AND;
+	pos    = idx + 1;
+	for (i = 0; i < nops; i++) {
+		tmp->start[i] = pos;
+		tmp->rank[i]  = adapt_rank(&adapt->stats[adapt->orig_idx[pos]], is_and);
+		pos           = subtree_end(parts, pos);
+		for (j = i; j > 0 && tmp->rank[tmp->perm[j - 1]] > tmp->rank[i]; j--)
+			tmp->perm[j] = tmp->perm[j - 1];
+		tmp->perm[j] = i;
+	}
+	for (i = 0; i < nops; i++) {
+		if (tmp->perm[i] != i)
+			break;
+	}
+	if (i == nops)
+		return end; /** already ordered */
+
+	pos = 0;
+	for (i = 0; i < nops; i++) {
+		k   = tmp->perm[i];
+		len = (k + 1 < nops ? tmp->start[k + 1] : end) - tmp->start[k];
+		memcpy(&tmp->parts[pos], &parts[tmp->start[k]], len * sizeof(*parts));
+		memcpy(&tmp->orig_idx[pos], &adapt->orig_idx[tmp->start[k]],
+		       len * sizeof(*adapt->orig_idx));
+		pos += len;
+	}
+	memcpy(&parts[idx + 1], tmp->parts, pos * sizeof(*parts));
+	memcpy(&adapt->orig_idx[idx + 1], tmp->orig_idx, pos * sizeof(*adapt->orig_idx));
+	*changed = true;
+	return end;
+}
+
+static int
+adapt_reorder(struct filter_adapt_t *adapt, struct filter_compiled_t *comp)
+{
+	struct adapt_scratch tmp     = {0};
+	uint32_t             nr      = adapt->filter.num_parts;
+	bool                 changed = false;
+	int                  rc      = 0;
+
+	D_ALLOC_ARRAY(tmp.parts, nr);
+	D_ALLOC_ARRAY(tmp.orig_idx, nr);
+	D_ALLOC_ARRAY(tmp.start, nr);
+	D_ALLOC_ARRAY(tmp.perm, nr);
+	D_ALLOC_ARRAY(tmp.rank, nr);
+	if (tmp.parts == NULL || tmp.orig_idx == NULL || tmp.start == NULL || tmp.perm == NULL ||
+	    tmp.rank == NULL)
+		D_GOTO(out, rc = -DER_NOMEM);
+
+	adapt_order(adapt, 0, &tmp, &changed);
+	if (!changed) {
+		adapt->interval = min(adapt->interval * 2,
+				      pipeline_adapt_sample * PIPELINE_ADAPT_BACKOFF);
+		D_GOTO(out, rc = 0);
+	}
+
+	adapt->interval = pipeline_adapt_sample;
+	adapt_comp_idx(adapt);
+	rc = filter_recompile(&adapt->filter, comp);
+	if (rc == 0)
+		D_DEBUG(DB_TRACE, "filter operands reordered\n");
+out:
+	D_FREE(tmp.parts);
+	D_FREE(tmp.orig_idx);
+	D_FREE(tmp.start);
+	D_FREE(tmp.perm);
+	D_FREE(tmp.rank);
+	return rc;
+}
+
+/**
+ * Called for each record evaluated by filter \a comp, after its evaluation with \a args.
+ */
+int
+filter_adapt_record(struct filter_compiled_t *comp, struct filter_part_run_t *args)
+{
+	struct filter_adapt_t *adapt = comp->adapt;
+
+	if (--adapt->countdown > 0)
+		return 0;
+	adapt->countdown = adapt->interval;
+
+	adapt_profile(adapt, comp, 0, args);
+	if (++adapt->nr_samples < PIPELINE_ADAPT_PERIOD)
+		return 0;
+	adapt->nr_samples = 0;
+
+	return adapt_reorder(adapt, comp);
+}
+
+/**
+ * Returns the counters of the parts of the (non aggregation) filters in \a stats, which have to
+ * be freed by the caller.
+ */
+int
+filter_adapt_stats(struct pipeline_compiled_t *comp_pipe, daos_pipeline_t *pipe,
+		   daos_pipeline_stats_t *stats)
+{
+	struct filter_adapt_t *adapt;
+	uint32_t               nr       = 0;
+	bool                   profiled = false;
+	uint32_t               i;
+
+	for (i = 0; i < comp_pipe->num_filters; i++) {
+		nr       += pipe->filters[i]->num_parts;
+		profiled |= comp_pipe->filters[i].adapt != NULL;
+	}
+	if (!profiled)
+		return 0;
+
+	D_ALLOC_ARRAY(stats->parts, nr);
+	if (stats->parts == NULL)
+		return -DER_NOMEM;
+	stats->nr_parts = nr;
+
+	nr = 0;
+	for (i = 0; i < comp_pipe->num_filters; i++) {
+		adapt = comp_pipe->filters[i].adapt;
+		if (adapt != NULL)
+			memcpy(&stats->parts[nr], adapt->stats,
+			       pipe->filters[i]->num_parts * sizeof(*stats->parts));
+		nr += pipe->filters[i]->num_parts;
+	}
+	return 0;
+}
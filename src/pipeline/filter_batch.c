@@ -0,0 +1,609 @@
+/**
+ * (C) Copyright 2026 Hewlett Packard Enterprise Development LP
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+/**
+ * Batches of records and vectorized filters.
+ *
+ * Records are fetched in batches of up to pipeline_batch_size records. Filters made of
+ * comparisons between a numeric key and a constant, possibly joined by AND, and aggregations of
+ * a numeric key are "vectorized": the keys they use are loaded once per batch into columns (one
+ * typed array per key), and they are then evaluated with simple loops over the columns, without
+ * branches nor indirect calls per record. Conditions update a selection map with one byte per
+ * record; other filters only have to be evaluated for the records still selected.
+ *
+ * Filters that can not be vectorized are evaluated one record at a time as before.
+ */
+#define D_LOGFAC DD_FAC(pipeline)
+
+#include <daos/common.h>
+#include "pipeline_internal.h"
+
+unsigned int pipeline_batch_size = PIPELINE_BATCH_SIZE;
+
+#define FVEC_IOD_UNRESOLVED	(-2)
+
+struct fvec_ctx {
+	struct pipeline_compiled_t	*comp_pipe;
+	daos_filter_t			*filter;
+	uint32_t			 part_idx;
+	struct filter_vec_t		*vec;
+};
+
+static bool
+part_is(daos_filter_part_t *part, const char *name)
+{
+	return !strncmp((char *)part->part_type.iov_buf, name, part->part_type.iov_len);
+}
+
+static uint32_t
+part_type_idx(daos_filter_part_t *part)
+{
+	return calc_type_idx((char *)part->data_type.iov_buf, part->data_type.iov_len);
+}
+
+/**
+ * Returns in \a col_idx the column holding key \a part, adding the column if needed. Returns 1
+ * if \a part can not be loaded into a column.
+ */
+static int
+fvec_col_add(struct pipeline_compiled_t *comp_pipe, daos_filter_part_t *part, uint32_t *col_idx)
+{
+	struct filter_col_t  col = {0};
+	struct filter_col_t *cols;
+	struct filter_col_t *c;
+	uint32_t             i;
+
+	if (part_is(part, "DAOS_FILTER_AKEY"))
+		col.akey = &part->akey;
+	else if (!part_is(part, "DAOS_FILTER_DKEY"))
+		return 1;
+	col.type = part_type_idx(part);
+	if (col.type > SUBIDX_REAL8)
+		return 1;
+	col.iod_idx     = FVEC_IOD_UNRESOLVED;
+	col.data_offset = part->data_offset;
+	col.data_len    = part->data_len;
+
+	for (i = 0; i < comp_pipe->num_cols; i++) {
+		c = &comp_pipe->cols[i];
+		if (c->type != col.type || c->data_offset != col.data_offset ||
+		    c->data_len != col.data_len || (c->akey == NULL) != (col.akey == NULL))
+			continue;
+		if (c->akey != NULL && (c->akey->iov_len != col.akey->iov_len ||
+					memcmp(c->akey->iov_buf, col.akey->iov_buf, c->akey->iov_len)))
+			continue;
+		*col_idx = i;
+		return 0;
+	}
+
+	D_REALLOC_ARRAY(cols, comp_pipe->cols, comp_pipe->num_cols, comp_pipe->num_cols + 1);
+	if (cols == NULL)
+		return -DER_NOMEM;
+	comp_pipe->cols                      = cols;
+	comp_pipe->cols[comp_pipe->num_cols] = col;
+	*col_idx                             = comp_pipe->num_cols++;
+	return 0;
+}
+
+static void
+fvec_const(uint16_t type, char *buf, struct filter_vec_pred_t *pred)
+{
+	switch (type) {
+	case SUBIDX_UINTEGER1:
+		pred->cval.u = *((uint8_t *)buf);
+		break;
+	case SUBIDX_UINTEGER2:
+		pred->cval.u = *((uint16_t *)buf);
+		break;
+	case SUBIDX_UINTEGER4:
+		pred->cval.u = *((uint32_t *)buf);
+		break;
+	case SUBIDX_UINTEGER8:
+		pred->cval.u = *((uint64_t *)buf);
+		break;
+	case SUBIDX_INTEGER1:
+		pred->cval.i = *((int8_t *)buf);
+		break;
+	case SUBIDX_INTEGER2:
+		pred->cval.i = *((int16_t *)buf);
+		break;
+	case SUBIDX_INTEGER4:
+		pred->cval.i = *((int32_t *)buf);
+		break;
+	case SUBIDX_INTEGER8:
+		pred->cval.i = *((int64_t *)buf);
+		break;
+	case SUBIDX_REAL4:
+		pred->cval.d = *((float *)buf);
+		break;
+	default: /** SUBIDX_REAL8 */
+		pred->cval.d = *((double *)buf);
+		break;
+	}
+}
+
+/**
+ * Conditions: AND of comparisons between a key and a single constant. Returns 1 if the filter
+ * can not be vectorized.
+ */
+static int
+fvec_compile_cond(struct fvec_ctx *ctx)
+{
+	daos_filter_part_t       **parts = ctx->filter->parts;
+	daos_filter_part_t        *part;
+	daos_filter_part_t        *key;
+	daos_filter_part_t        *cnst;
+	struct filter_vec_pred_t  *pred;
+	uint32_t                   func_idx;
+	uint32_t                   key_type;
+	uint32_t                   cnst_type;
+	uint32_t                   col;
+	uint32_t                   i;
+	int                        rc;
+
+	if (ctx->part_idx >= ctx->filter->num_parts)
+		return -DER_INVAL;
+	part = parts[ctx->part_idx++];
+
+	if (part_is(part, "DAOS_FILTER_FUNC_AND")) {
+		for (i = 0; i < part->num_operands; i++) {
+			rc = fvec_compile_cond(ctx);
+			if (rc != 0)
+				return rc;
+		}
+		return 0;
+	}
+
+	/** IN is compiled as EQ */
+	func_idx = calc_filterfunc_idx(parts, ctx->part_idx - 1);
+	if (func_idx > SUBIDX_FUNC_GT || part_is(part, "DAOS_FILTER_FUNC_IN") ||
+	    part->num_operands != 2 || ctx->part_idx + 2 > ctx->filter->num_parts)
+		return 1;
+
+	key  = parts[ctx->part_idx++];
+	cnst = parts[ctx->part_idx++];
+	if (part_is(key, "DAOS_FILTER_CONST")) {
+		/** constant on the left side: CONST < KEY is KEY > CONST */
+		cnst = key;
+		key  = parts[ctx->part_idx - 1];
+		if (func_idx == SUBIDX_FUNC_LT)
+			func_idx = SUBIDX_FUNC_GT;
+		else if (func_idx == SUBIDX_FUNC_GT)
+			func_idx = SUBIDX_FUNC_LT;
+		else if (func_idx == SUBIDX_FUNC_LE)
+			func_idx = SUBIDX_FUNC_GE;
+		else if (func_idx == SUBIDX_FUNC_GE)
+			func_idx = SUBIDX_FUNC_LE;
+	}
+	if (!part_is(cnst, "DAOS_FILTER_CONST") || cnst->num_constants != 1)
+		return 1;
+
+	key_type  = part_type_idx(key);
+	cnst_type = part_type_idx(cnst);
+	if (cnst_type > SUBIDX_REAL8 ||
+	    calc_type_nosize_idx(key_type) != calc_type_nosize_idx(cnst_type) ||
+	    cnst->constant[0].iov_len < filter_type_size(cnst_type))
+		return 1;
+
+	rc = fvec_col_add(ctx->comp_pipe, key, &col);
+	if (rc != 0)
+		return rc;
+
+	pred           = &ctx->vec->preds[ctx->vec->num_preds++];
+	pred->func_idx = func_idx + calc_type_nosize_idx(cnst_type);
+	pred->col      = col;
+	fvec_const(cnst_type, (char *)cnst->constant[0].iov_buf, pred);
+	return 0;
+}
+
+/**
+ * Aggregations: SUM, AVG, MAX and MIN of a key. Returns 1 if the filter can not be vectorized.
+ */
+static int
+fvec_compile_aggr(struct fvec_ctx *ctx)
+{
+	daos_filter_part_t **parts = ctx->filter->parts;
+	uint32_t             func_idx;
+	uint32_t             col;
+	int                  rc;
+
+	if (ctx->filter->num_parts != 2)
+		return 1;
+	func_idx = calc_filterfunc_idx(parts, 0);
+	if (func_idx != SUBIDX_FUNC_SUM && func_idx != SUBIDX_FUNC_MAX &&
+	    func_idx != SUBIDX_FUNC_MIN)
+		return 1;
+
+	rc = fvec_col_add(ctx->comp_pipe, parts[1], &col);
+	if (rc != 0)
+		return rc;
+
+	ctx->vec->aggr_func_idx = func_idx + calc_type_nosize_idx(ctx->comp_pipe->cols[col].type);
+	ctx->vec->aggr_col      = col;
+	return 0;
+}
+
+/**
+ * Compiles the vectorized form of \a filter. \a vec is set to NULL if the filter can not be
+ * vectorized.
+ */
+int
+filter_vec_compile(struct pipeline_compiled_t *comp_pipe, daos_filter_t *filter, bool is_aggr,
+		   struct filter_vec_t **vec)
+{
+	struct fvec_ctx ctx      = {0};
+	uint32_t        num_cols = comp_pipe->num_cols;
+	int             rc;
+
+	*vec = NULL;
+	if (filter->num_parts == 0)
+		return 0;
+
+	D_ALLOC_PTR(ctx.vec);
+	if (ctx.vec == NULL)
+		return -DER_NOMEM;
+	ctx.comp_pipe = comp_pipe;
+	ctx.filter    = filter;
+
+	if (is_aggr) {
+		rc = fvec_compile_aggr(&ctx);
+	} else {
+		D_ALLOC_ARRAY(ctx.vec->preds, filter->num_parts);
+		if (ctx.vec->preds == NULL)
+			D_GOTO(out, rc = -DER_NOMEM);
+		rc = fvec_compile_cond(&ctx);
+	}
+	if (rc == 0) {
+		*vec = ctx.vec;
+		return 0;
+	}
+out:
+	/** columns added for this filter are not used */
+	comp_pipe->num_cols = num_cols;
+	filter_vec_free(ctx.vec);
+	return rc < 0 ? rc : 0;
+}
+
+void
+filter_vec_free(struct filter_vec_t *vec)
+{
+	if (vec == NULL)
+		return;
+	D_FREE(vec->preds);
+	D_FREE(vec);
+}
+
+/**
+ * Returns where the value of akey column \a col is stored in record \a rec, or NULL if the value
+ * is NULL. Numeric values not fully stored in the record are NULL.
+ */
+static inline char *
+fvec_col_akey_ptr(struct filter_col_t *col, struct filter_batch_t *batch, uint32_t rec,
+		  size_t size)
+{
+	uint32_t                  idx = rec * batch->nr_iods + col->iod_idx;
+	daos_iod_t               *iod = &batch->iods[idx];
+	d_iov_t                  *iov = &batch->akey_iovs[idx];
+	struct filter_part_run_t  args;
+	char                     *ptr;
+	size_t                    len;
+
+	if (iod->iod_type == DAOS_IOD_SINGLE) {
+		/** same as getdata_akey_iod() */
+		if (iov->iov_len == 0 || col->data_len < size ||
+		    col->data_offset + size > iod->iod_size)
+			return NULL;
+		return (char *)iov->iov_buf + col->data_offset;
+	}
+
+	args.nr_iods = batch->nr_iods;
+	filter_batch_args(batch, rec, &args);
+	len = col->data_len;
+	ptr = getdata_akey_iod(&args, col->iod_idx, col->data_offset, &len);
+	if (ptr != NULL && len < size)
+		return NULL;
+	return ptr;
+}
+
+#define FVEC_CASE_LOAD(type, ctype, field)                                                         \
+	case SUBIDX_##type:                                                                        \
+		for (r = 0; r < nr; r++)                                                           \
+			field[r] = valid[r] ? *((ctype *)ptrs[r]) : 0;                             \
+		break;
+
+/**
+ * Loads column \a col_idx for all the records of the batch, if not done yet.
+ */
+static void
+fvec_col_load(struct pipeline_compiled_t *comp_pipe, struct filter_batch_t *batch,
+	      uint32_t col_idx)
+{
+	struct filter_col_t  *col   = &comp_pipe->cols[col_idx];
+	uint64_t             *u     = &batch->col_vals[col_idx * batch->max];
+	int64_t              *i     = (int64_t *)u;
+	double               *d     = (double *)u;
+	uint8_t              *valid = &batch->col_valid[col_idx * batch->max];
+	char                **ptrs  = batch->ptrs;
+	size_t                size  = filter_type_size(col->type);
+	uint32_t              nr    = batch->nr;
+	uint32_t              r;
+
+	if (batch->col_loaded[col_idx])
+		return;
+	batch->col_loaded[col_idx] = true;
+
+	if (col->akey == NULL) {
+		for (r = 0; r < nr; r++) {
+			ptrs[r] = NULL;
+			if (col->data_offset + size <= batch->dkeys[r].iov_len)
+				ptrs[r] = (char *)batch->dkeys[r].iov_buf + col->data_offset;
+		}
+	} else {
+		/** iods do not change during a pipeline run, the akey is only searched once */
+		if (unlikely(col->iod_idx == FVEC_IOD_UNRESOLVED)) {
+			struct filter_part_run_t args = {0};
+
+			args.nr_iods = batch->nr_iods;
+			filter_batch_args(batch, 0, &args);
+			col->iod_idx = getdata_akey_idx(&args, col->akey);
+		}
+		for (r = 0; r < nr; r++)
+			ptrs[r] = col->iod_idx < 0 ? NULL : fvec_col_akey_ptr(col, batch, r, size);
+	}
+	for (r = 0; r < nr; r++)
+		valid[r] = (ptrs[r] != NULL);
+
+	switch (col->type) {
+	FVEC_CASE_LOAD(UINTEGER1, uint8_t, u)
+	FVEC_CASE_LOAD(UINTEGER2, uint16_t, u)
+	FVEC_CASE_LOAD(UINTEGER4, uint32_t, u)
+	FVEC_CASE_LOAD(UINTEGER8, uint64_t, u)
+	FVEC_CASE_LOAD(INTEGER1, int8_t, i)
+	FVEC_CASE_LOAD(INTEGER2, int16_t, i)
+	FVEC_CASE_LOAD(INTEGER4, int32_t, i)
+	FVEC_CASE_LOAD(INTEGER8, int64_t, i)
+	FVEC_CASE_LOAD(REAL4, float, d)
+	FVEC_CASE_LOAD(REAL8, double, d)
+	default:
+		D_ASSERTF(false, "type %u can not be loaded into a column\n", col->type);
+	}
+}
+
+#define FVEC_CASE_PRED_CLASS(func, class, field, oper)                                             \
+	case SUBIDX_FUNC_##func + SUBIDX_##class:                                                  \
+		for (r = 0; r < nr; r++)                                                           \
+			sel[r] &= valid[r] & (field[r] oper pred->cval.field);                     \
+		break;
+
+#define FVEC_CASE_PRED(func, oper)                                                                 \
+	FVEC_CASE_PRED_CLASS(func, UINTEGER, u, oper)                                              \
+	FVEC_CASE_PRED_CLASS(func, INTEGER, i, oper)                                               \
+	FVEC_CASE_PRED_CLASS(func, DOUBLE, d, oper)
+
+/**
+ * Unselects the records of the batch for which condition \a vec is false.
+ */
+void
+filter_vec_cond_run(struct pipeline_compiled_t *comp_pipe, struct filter_vec_t *vec,
+		    struct filter_batch_t *batch)
+{
+	struct filter_vec_pred_t *pred;
+	uint8_t                  *sel = batch->sel;
+	uint8_t                  *valid;
+	uint64_t                 *u;
+	int64_t                  *i;
+	double                   *d;
+	uint32_t                  nr = batch->nr;
+	uint32_t                  p;
+	uint32_t                  r;
+
+	for (p = 0; p < vec->num_preds; p++) {
+		pred = &vec->preds[p];
+		fvec_col_load(comp_pipe, batch, pred->col);
+		u     = &batch->col_vals[pred->col * batch->max];
+		i     = (int64_t *)u;
+		d     = (double *)u;
+		valid = &batch->col_valid[pred->col * batch->max];
+
+		switch (pred->func_idx) {
+		FVEC_CASE_PRED(EQ, ==)
+		FVEC_CASE_PRED(NE, !=)
+		FVEC_CASE_PRED(LT, <)
+		FVEC_CASE_PRED(LE, <=)
+		FVEC_CASE_PRED(GE, >=)
+		FVEC_CASE_PRED(GT, >)
+		default:
+			D_ASSERTF(false, "unknown comparison %u\n", pred->func_idx);
+		}
+	}
+}
+
+/** same order of operations as aggr_funcs.c, so that results do not depend on batching */
+#define FVEC_CASE_AGGR(class, field)                                                               \
+	case SUBIDX_FUNC_SUM + SUBIDX_##class:                                                     \
+		for (r = 0; r < nr; r++) {                                                         \
+			if (sel[r] & valid[r])                                                     \
+				acc += (double)field[r];                                           \
+		}                                                                                  \
+		break;                                                                             \
+	case SUBIDX_FUNC_MAX + SUBIDX_##class:                                                     \
+		for (r = 0; r < nr; r++) {                                                         \
+			val = (double)field[r];                                                    \
+			acc = ((sel[r] & valid[r]) && val > acc) ? val : acc;                      \
+		}                                                                                  \
+		break;                                                                             \
+	case SUBIDX_FUNC_MIN + SUBIDX_##class:                                                     \
+		for (r = 0; r < nr; r++) {                                                         \
+			val = (double)field[r];                                                    \
+			acc = ((sel[r] & valid[r]) && val < acc) ? val : acc;                      \
+		}                                                                                  \
+		break;
+
+/**
+ * Aggregates the records of the batch that are selected into \a aggr.
+ */
+void
+filter_vec_aggr_run(struct pipeline_compiled_t *comp_pipe, struct filter_vec_t *vec,
+		    struct filter_batch_t *batch, double *aggr)
+{
+	uint8_t  *sel   = batch->sel;
+	uint8_t  *valid = &batch->col_valid[vec->aggr_col * batch->max];
+	uint64_t *u     = &batch->col_vals[vec->aggr_col * batch->max];
+	int64_t  *i     = (int64_t *)u;
+	double   *d     = (double *)u;
+	double    acc   = *aggr;
+	double    val;
+	uint32_t  nr = batch->nr;
+	uint32_t  r;
+
+	fvec_col_load(comp_pipe, batch, vec->aggr_col);
+
+	switch (vec->aggr_func_idx) {
+	FVEC_CASE_AGGR(UINTEGER, u)
+	FVEC_CASE_AGGR(INTEGER, i)
+	FVEC_CASE_AGGR(DOUBLE, d)
+	default:
+		D_ASSERTF(false, "unknown aggregation %u\n", vec->aggr_func_idx);
+	}
+	*aggr = acc;
+}
+
+/**
+ * Allocates a batch of up to \a max records, reduced so that the records do not take more than
+ * PIPELINE_BATCH_BYTES.
+ */
+int
+filter_batch_alloc(struct pipeline_compiled_t *comp_pipe, daos_iod_t *iods, uint32_t nr_iods,
+		   uint32_t max, struct filter_batch_t *batch)
+{
+	size_t   *iov_sizes;
+	size_t    rec_size = 0;
+	char     *buf;
+	uint32_t  r;
+	uint32_t  i;
+	uint32_t  j;
+	int       rc;
+
+	D_ASSERT(nr_iods != 0);
+	*batch = (struct filter_batch_t){0};
+
+	D_ALLOC_ARRAY(iov_sizes, nr_iods);
+	if (iov_sizes == NULL)
+		return -DER_NOMEM;
+	for (i = 0; i < nr_iods; i++) {
+		if (iods[i].iod_type == DAOS_IOD_ARRAY) {
+			for (j = 0; j < iods[i].iod_nr; j++)
+				iov_sizes[i] += iods[i].iod_recxs[j].rx_nr;
+			iov_sizes[i] *= iods[i].iod_size;
+		} else {
+			iov_sizes[i] = iods[i].iod_size;
+		}
+		rec_size += iov_sizes[i];
+	}
+	if (max == 0)
+		max = 1;
+	if (rec_size > 0 && max > 1 && rec_size * max > PIPELINE_BATCH_BYTES)
+		max = max_t(size_t, PIPELINE_BATCH_BYTES / rec_size, 1);
+
+	batch->max      = max;
+	batch->nr_iods  = nr_iods;
+	batch->num_cols = comp_pipe->num_cols;
+
+	D_ALLOC_ARRAY(batch->dkeys, max);
+	D_ALLOC_ARRAY(batch->iods, max * nr_iods);
+	D_ALLOC_ARRAY(batch->akeys, max * nr_iods);
+	D_ALLOC_ARRAY(batch->akey_iovs, max * nr_iods);
+	D_ALLOC(batch->akey_bufs, max_t(size_t, rec_size * max, 1));
+	D_ALLOC(batch->sel, max);
+	if (batch->dkeys == NULL || batch->iods == NULL || batch->akeys == NULL ||
+	    batch->akey_iovs == NULL || batch->akey_bufs == NULL || batch->sel == NULL)
+		D_GOTO(error, rc = -DER_NOMEM);
+	if (batch->num_cols > 0) {
+		D_ALLOC_ARRAY(batch->col_vals, batch->num_cols * max);
+		D_ALLOC(batch->col_valid, batch->num_cols * max);
+		D_ALLOC_ARRAY(batch->col_loaded, batch->num_cols);
+		D_ALLOC_ARRAY(batch->ptrs, max);
+		if (batch->col_vals == NULL || batch->col_valid == NULL ||
+		    batch->col_loaded == NULL || batch->ptrs == NULL)
+			D_GOTO(error, rc = -DER_NOMEM);
+	}
+
+	buf = batch->akey_bufs;
+	for (r = 0; r < max; r++) {
+		memcpy(&batch->iods[r * nr_iods], iods, sizeof(*iods) * nr_iods);
+		for (i = 0; i < nr_iods; i++) {
+			j = r * nr_iods + i;
+			d_iov_set(&batch->akey_iovs[j], buf, 0);
+			batch->akey_iovs[j].iov_buf_len = iov_sizes[i];
+			batch->akeys[j].sg_nr           = 1;
+			batch->akeys[j].sg_nr_out       = 0;
+			batch->akeys[j].sg_iovs         = &batch->akey_iovs[j];
+			buf += iov_sizes[i];
+		}
+	}
+	D_FREE(iov_sizes);
+	return 0;
+error:
+	D_FREE(iov_sizes);
+	filter_batch_free(batch);
+	return rc;
+}
+
+void
+filter_batch_free(struct filter_batch_t *batch)
+{
+	uint32_t r;
+
+	/** with a single record, the dkey is not copied */
+	if (batch->dkeys != NULL && batch->max > 1) {
+		for (r = 0; r < batch->max; r++)
+			D_FREE(batch->dkeys[r].iov_buf);
+	}
+	D_FREE(batch->dkeys);
+	D_FREE(batch->iods);
+	D_FREE(batch->akeys);
+	D_FREE(batch->akey_iovs);
+	D_FREE(batch->akey_bufs);
+	D_FREE(batch->sel);
+	D_FREE(batch->col_vals);
+	D_FREE(batch->col_valid);
+	D_FREE(batch->col_loaded);
+	D_FREE(batch->ptrs);
+}
+
+void
+filter_batch_reset(struct filter_batch_t *batch)
+{
+	batch->nr = 0;
+	if (batch->num_cols > 0)
+		memset(batch->col_loaded, 0, sizeof(*batch->col_loaded) * batch->num_cols);
+}
+
+/**
+ * Adds the record that was just fetched into the next slot of the batch.
+ */
+int
+filter_batch_add(struct filter_batch_t *batch, d_iov_t *dkey)
+{
+	d_iov_t *slot = &batch->dkeys[batch->nr];
+	char    *buf;
+
+	D_ASSERT(batch->nr < batch->max);
+	if (batch->max == 1) {
+		*slot = *dkey;
+	} else {
+		if (slot->iov_buf_len < dkey->iov_len) {
+			D_REALLOC_NZ(buf, slot->iov_buf, dkey->iov_len);
+			if (buf == NULL)
+				return -DER_NOMEM;
+			slot->iov_buf     = buf;
+			slot->iov_buf_len = dkey->iov_len;
+		}
+		memcpy(slot->iov_buf, dkey->iov_buf, dkey->iov_len);
+		slot->iov_len = dkey->iov_len;
+	}
+	batch->nr++;
+	return 0;
+}
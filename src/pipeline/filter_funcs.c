@@ -147,14 +147,15 @@ DEFINE_FILTER_FUNC_LOG(le, d, double)
 DEFINE_FILTER_FUNC_LOG(ge, d, double)
 DEFINE_FILTER_FUNC_LOG(gt, d, double)
 
-static bool logfunc_eq_st(char *l, size_t ll, char *r, size_t rl)
+bool
+logfunc_eq_st(char *l, size_t ll, char *r, size_t rl)
 {
 	if (ll != rl)
 		return false;
 	return (memcmp(l, r, rl) == 0);
 }
 
-static bool
+bool
 logfunc_ne_st(char *l, size_t ll, char *r, size_t rl)
 {
 	if (ll != rl)
@@ -162,7 +163,7 @@ logfunc_ne_st(char *l, size_t ll, char *r, size_t rl)
 	return (memcmp(l, r, rl) != 0);
 }
 
-static bool
+bool
 logfunc_lt_st(char *l, size_t ll, char *r, size_t rl)
 {
 	size_t len = ll <= rl ? ll : rl;
@@ -170,7 +171,7 @@ logfunc_lt_st(char *l, size_t ll, char *r, size_t rl)
 	return (memcmp(l, r, len) < 0);
 }
 
-static bool
+bool
 logfunc_le_st(char *l, size_t ll, char *r, size_t rl)
 {
 	if (ll != rl) {
@@ -181,7 +182,7 @@ logfunc_le_st(char *l, size_t ll, char *r, size_t rl)
 	return (memcmp(l, r, rl) <= 0);
 }
 
-static bool
+bool
 logfunc_ge_st(char *l, size_t ll, char *r, size_t rl)
 {
 	if (ll != rl) {
@@ -192,7 +193,7 @@ logfunc_ge_st(char *l, size_t ll, char *r, size_t rl)
 	return (memcmp(l, r, rl) >= 0);
 }
 
-static bool
+bool
 logfunc_gt_st(char *l, size_t ll, char *r, size_t rl)
 {
 	size_t len = ll <= rl ? ll : rl;
@@ -343,25 +344,14 @@ DEFINE_FILTER_FUNC_BITAND(i, int64_t)
  */
 
 int
-filter_func_like(struct filter_part_run_t *args)
+filter_like_match(char *left_str, size_t left_size, char *right_str, size_t right_size,
+		  bool *match)
 {
-	char  *left_str  = NULL;
-	char  *right_str = NULL;
-	size_t left_size = 0;
 	size_t left_pos;
-	size_t right_size = 0;
 	size_t right_pos;
 	size_t right_anchor;
 	bool   right_anchor_set;
 	bool   scaping;
-	int    rc = 0;
-
-	rc = filter_func_getdata_st(args, &left_str, &left_size);
-	if (unlikely(rc != 0))
-		D_GOTO(exit, rc);
-	rc = filter_func_getdata_st(args, &right_str, &right_size);
-	if (unlikely(rc != 0))
-		D_GOTO(exit, rc);
 
 	left_pos         = 0;
 	right_pos        = 0;
@@ -374,15 +364,15 @@ filter_func_like(struct filter_part_run_t *args)
 			scaping = true;
 			right_pos++;
 			if (right_pos == right_size)
-				D_GOTO(exit, rc = -DER_INVAL); /** We should never reach this. */
+				return -DER_INVAL; /** We should never reach this. */
 		}
 		if (right_str[right_pos] == '%' && !scaping) {
 			right_anchor_set = true;
 			right_anchor     = ++right_pos;
 			if (right_pos == right_size) {
 				/** '%' is at the end of pattern. Pass. */
-				args->log_out = true;
-				D_GOTO(exit, rc = 0);
+				*match = true;
+				return 0;
 			}
 		}
 		if ((right_str[right_pos] == '_' && !scaping) ||
@@ -391,8 +381,8 @@ filter_func_like(struct filter_part_run_t *args)
 			right_pos++;
 		} else if (!right_anchor_set) {
 			/** Mismatch and no wildcard. No pass. */
-			args->log_out = false;
-			D_GOTO(exit, rc = 0);
+			*match = false;
+			return 0;
 		} else {
 			right_pos = right_anchor;
 			if (left_str[left_pos] != right_str[right_pos])
@@ -402,18 +392,35 @@ filter_func_like(struct filter_part_run_t *args)
 		if ((left_pos == left_size) && (right_pos == right_size - 1) &&
 		    right_str[right_pos] == '%') {
 			/** At the end of string and only thing left is '%'. Pass. */
-			args->log_out = true;
-			D_GOTO(exit, rc = 0);
+			*match = true;
+			return 0;
 		}
 	}
-	if (left_pos == left_size && right_pos == right_size) {
-		/** At the end of both strings. Function pass. */
-		args->log_out = true;
-	} else {
-		/** One string still has characters left. No pass. */
-		args->log_out = false;
-	}
+	/**
+	 * At the end of both strings the function passes. Otherwise, one string still has
+	 * characters left. No pass.
+	 */
+	*match = (left_pos == left_size && right_pos == right_size);
+	return 0;
+}
+
+int
+filter_func_like(struct filter_part_run_t *args)
+{
+	char  *left_str   = NULL;
+	char  *right_str  = NULL;
+	size_t left_size  = 0;
+	size_t right_size = 0;
+	int    rc         = 0;
+
+	rc = filter_func_getdata_st(args, &left_str, &left_size);
+	if (unlikely(rc != 0))
+		D_GOTO(exit, rc);
+	rc = filter_func_getdata_st(args, &right_str, &right_size);
+	if (unlikely(rc != 0))
+		D_GOTO(exit, rc);
 
+	rc = filter_like_match(left_str, left_size, right_str, right_size, &args->log_out);
 exit:
 	if (unlikely(rc != 0)) {
 		args->log_out = false;
@@ -0,0 +1,411 @@
+/**
+ * (C) Copyright 2026 Hewlett Packard Enterprise Development LP
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+
+/**
+ * GROUP BY and ORDER BY on the records of a shard.
+ *
+ * Grouped aggregations are computed in a hash table of groups, indexed by the packed GROUP BY
+ * key. ORDER BY keeps the records with the first k keys in a binary heap whose root is the last
+ * record kept, so a record can be rejected by a single comparison once the heap is full.
+ */
+
+#define D_LOGFAC DD_FAC(pipeline)
+
+#include <daos/common.h>
+#include "pipeline_internal.h"
+
+/** buckets of the hash table of groups */
+#define PIPELINE_GROUP_BITS	10
+
+int
+pipeline_key_eval(struct filter_key_t *key, struct filter_part_run_t *args,
+		  struct pipeline_key_t *out)
+{
+	int rc;
+
+	args->part_idx = 0;
+	args->parts    = key->ftr.parts;
+	args->data_out = NULL;
+	rc             = args->parts[0].filter_func(args);
+	if (rc < 0)
+		return rc;
+
+	/** arithmetic functions return 1 when one of their operands is NULL */
+	if (rc > 0 || args->data_out == NULL) {
+		out->cls = PIPELINE_KEY_NULL;
+		return 0;
+	}
+
+	out->cls = key->cls;
+	switch (key->cls) {
+	case SUBIDX_UINTEGER:
+		out->v.u = args->value_u_out;
+		break;
+	case SUBIDX_INTEGER:
+		out->v.i = args->value_i_out;
+		break;
+	case SUBIDX_DOUBLE:
+		/** -0.0 and 0.0 are the same group */
+		out->v.d = args->value_d_out == 0 ? 0 : args->value_d_out;
+		break;
+	default:
+		out->data = args->data_out;
+		out->len  = args->data_len_out;
+		break;
+	}
+	return 0;
+}
+
+/**
+ * Groups, indexed by their packed key.
+ */
+
+static struct pipeline_group_t *
+group_link2ptr(d_list_t *link)
+{
+	return container_of(link, struct pipeline_group_t, pg_link);
+}
+
+static bool
+group_key_cmp(struct d_hash_table *htable, d_list_t *link, const void *key, unsigned int ksize)
+{
+	struct pipeline_group_t *group = group_link2ptr(link);
+	struct pipeline_key_t    k;
+	char                    *buf   = (char *)key;
+
+	if (pipeline_key_unpack(&buf, buf + ksize, &k) != 0)
+		return false;
+	return pipeline_key_cmp(&group->pg_key, &k) == 0;
+}
+
+static d_hash_table_ops_t group_hops = {
+	.hop_key_cmp = group_key_cmp,
+};
+
+int
+pipeline_groups_init(struct pipeline_groups_t *groups, uint32_t nr_aggr)
+{
+	memset(groups, 0, sizeof(*groups));
+	groups->pgs_nr_aggr = nr_aggr;
+
+	return d_hash_table_create_inplace(D_HASH_FT_NOLOCK, PIPELINE_GROUP_BITS, NULL, &group_hops,
+					   &groups->pgs_htable);
+}
+
+void
+pipeline_groups_fini(struct pipeline_groups_t *groups)
+{
+	uint32_t i;
+
+	/** groups have no refcount, deleting them from the table does not free them */
+	d_hash_table_destroy_inplace(&groups->pgs_htable, true);
+	for (i = 0; i < groups->pgs_nr; i++)
+		D_FREE(groups->pgs_groups[i]);
+	D_FREE(groups->pgs_groups);
+	groups->pgs_nr  = 0;
+	groups->pgs_cap = 0;
+}
+
+/**
+ * Looks up the group of \a key, creating it (with its aggregations initialized) if needed.
+ */
+int
+pipeline_groups_find(struct pipeline_groups_t *groups, daos_pipeline_t *pipe,
+		     struct pipeline_key_t *key, struct pipeline_group_t **group)
+{
+	struct pipeline_group_t  *grp;
+	struct pipeline_group_t **ptr;
+	d_list_t                 *link;
+	char                      kbuf[64];
+	char                     *packed    = kbuf;
+	size_t                    ksize;
+	uint32_t                  cap;
+	uint32_t                  i;
+	int                       rc;
+
+	ksize = pipeline_key_size(key);
+	if (ksize > sizeof(kbuf)) {
+		D_ALLOC(packed, ksize);
+		if (packed == NULL)
+			return -DER_NOMEM;
+	}
+	pipeline_key_pack(key, packed);
+
+	link = d_hash_rec_find(&groups->pgs_htable, packed, ksize);
+	if (link != NULL) {
+		*group = group_link2ptr(link);
+		D_GOTO(out, rc = 0);
+	}
+
+	if (groups->pgs_nr == PIPELINE_GROUP_MAX) {
+		D_ERROR("too many groups (max %u)\n", PIPELINE_GROUP_MAX);
+		D_GOTO(out, rc = -DER_TRUNC);
+	}
+	if (groups->pgs_nr == groups->pgs_cap) {
+		cap = groups->pgs_cap == 0 ? 64 : groups->pgs_cap * 2;
+		D_REALLOC_ARRAY(ptr, groups->pgs_groups, groups->pgs_cap, cap);
+		if (ptr == NULL)
+			D_GOTO(out, rc = -DER_NOMEM);
+		groups->pgs_groups = ptr;
+		groups->pgs_cap    = cap;
+	}
+
+	/** aggregated values and the data of string keys are stored after the group */
+	D_ALLOC(grp, sizeof(*grp) + groups->pgs_nr_aggr * sizeof(double) +
+		(key->cls == SUBIDX_STR ? key->len : 0));
+	if (grp == NULL)
+		D_GOTO(out, rc = -DER_NOMEM);
+
+	grp->pg_aggr = (double *)(grp + 1);
+	for (i = 0; i < groups->pgs_nr_aggr; i++)
+		grp->pg_aggr[i] = pipeline_aggr_init_value(pipe->aggr_filters[i]);
+	grp->pg_key = *key;
+	if (key->cls == SUBIDX_STR) {
+		grp->pg_key.data = (char *)&grp->pg_aggr[groups->pgs_nr_aggr];
+		memcpy(grp->pg_key.data, key->data, key->len);
+	}
+
+	rc = d_hash_rec_insert(&groups->pgs_htable, packed, ksize, &grp->pg_link, false);
+	if (rc != 0) {
+		D_FREE(grp);
+		D_GOTO(out, rc);
+	}
+	groups->pgs_groups[groups->pgs_nr++] = grp;
+	*group                               = grp;
+out:
+	if (packed != kbuf)
+		D_FREE(packed);
+	return rc;
+}
+
+static int
+group_sort_cmp(const void *a, const void *b)
+{
+	struct pipeline_group_t *ga = *(struct pipeline_group_t **)a;
+	struct pipeline_group_t *gb = *(struct pipeline_group_t **)b;
+
+	return pipeline_key_cmp(&ga->pg_key, &gb->pg_key);
+}
+
+/**
+ * Packs the \a max groups with the smallest keys into \a out, in increasing order of the keys.
+ * Each group is packed as its key, followed by its number of records and its aggregated values
+ * (averages are returned as sums). The buffer of \a out is allocated here.
+ */
+int
+pipeline_groups_pack(struct pipeline_groups_t *groups, uint32_t max, d_iov_t *out,
+		     uint32_t *nr_out)
+{
+	struct pipeline_group_t *grp;
+	uint32_t                 nr;
+	uint32_t                 i;
+	size_t                   size = 0;
+	char                    *buf;
+
+	*nr_out = 0;
+	nr      = min(max, groups->pgs_nr);
+	if (nr == 0)
+		return 0;
+
+	qsort(groups->pgs_groups, groups->pgs_nr, sizeof(*groups->pgs_groups), group_sort_cmp);
+
+	for (i = 0; i < nr; i++)
+		size += pipeline_key_size(&groups->pgs_groups[i]->pg_key);
+	size += nr * (sizeof(uint64_t) + groups->pgs_nr_aggr * sizeof(double));
+
+	D_ALLOC(buf, size);
+	if (buf == NULL)
+		return -DER_NOMEM;
+	d_iov_set(out, buf, size);
+
+	for (i = 0; i < nr; i++) {
+		grp = groups->pgs_groups[i];
+		buf = pipeline_key_pack(&grp->pg_key, buf);
+		memcpy(buf, &grp->pg_count, sizeof(grp->pg_count));
+		buf += sizeof(grp->pg_count);
+		memcpy(buf, grp->pg_aggr, groups->pgs_nr_aggr * sizeof(double));
+		buf += groups->pgs_nr_aggr * sizeof(double);
+	}
+	*nr_out = nr;
+	return 0;
+}
+
+/**
+ * Records with the first k ORDER BY keys.
+ */
+
+static bool
+topk_cmp_asc(struct d_binheap_node *a, struct d_binheap_node *b)
+{
+	struct pipeline_topk_rec_t *ra = container_of(a, struct pipeline_topk_rec_t, tr_node);
+	struct pipeline_topk_rec_t *rb = container_of(b, struct pipeline_topk_rec_t, tr_node);
+
+	/** largest key at the root */
+	return pipeline_key_cmp(&ra->tr_key, &rb->tr_key) > 0;
+}
+
+static bool
+topk_cmp_desc(struct d_binheap_node *a, struct d_binheap_node *b)
+{
+	struct pipeline_topk_rec_t *ra = container_of(a, struct pipeline_topk_rec_t, tr_node);
+	struct pipeline_topk_rec_t *rb = container_of(b, struct pipeline_topk_rec_t, tr_node);
+
+	/** smallest key at the root */
+	return pipeline_key_cmp(&ra->tr_key, &rb->tr_key) < 0;
+}
+
+static struct d_binheap_ops topk_ops_asc = {
+	.hop_compare = topk_cmp_asc,
+};
+
+static struct d_binheap_ops topk_ops_desc = {
+	.hop_compare = topk_cmp_desc,
+};
+
+int
+pipeline_topk_init(struct pipeline_topk_t *topk, uint32_t k, uint32_t nr_iods, bool desc)
+{
+	topk->tk_k       = k;
+	topk->tk_nr_iods = nr_iods;
+
+	return d_binheap_create_inplace(DBH_FT_NOLOCK, k, NULL,
+					desc ? &topk_ops_desc : &topk_ops_asc, &topk->tk_heap);
+}
+
+void
+pipeline_topk_rec_free(struct pipeline_topk_rec_t *rec)
+{
+	D_FREE(rec);
+}
+
+void
+pipeline_topk_fini(struct pipeline_topk_t *topk)
+{
+	struct d_binheap_node *node;
+
+	while ((node = d_binheap_remove_root(&topk->tk_heap)) != NULL)
+		pipeline_topk_rec_free(container_of(node, struct pipeline_topk_rec_t, tr_node));
+	d_binheap_destroy_inplace(&topk->tk_heap);
+}
+
+/**
+ * Copies the record (\a dkey, \a iods, \a akeys) in a single allocation, as the buffers of the
+ * batch it comes from are reused for the next records.
+ */
+static int
+topk_rec_alloc(struct pipeline_topk_t *topk, struct pipeline_key_t *key, d_iov_t *dkey,
+	       daos_iod_t *iods, d_sg_list_t *akeys, struct pipeline_topk_rec_t **rec_out)
+{
+	struct pipeline_topk_rec_t *rec;
+	uint32_t                    nr_iods = topk->tk_nr_iods;
+	d_iov_t                    *iovs;
+	size_t                      size;
+	char                       *buf;
+	uint32_t                    i;
+
+	size = sizeof(*rec) + nr_iods * (sizeof(daos_iod_t) + sizeof(d_sg_list_t) +
+					 sizeof(d_iov_t)) + dkey->iov_len;
+	if (key->cls == SUBIDX_STR)
+		size += key->len;
+	for (i = 0; i < nr_iods; i++)
+		size += akeys[i].sg_iovs->iov_len;
+
+	D_ALLOC(rec, size);
+	if (rec == NULL)
+		return -DER_NOMEM;
+
+	rec->tr_iods  = (daos_iod_t *)(rec + 1);
+	rec->tr_akeys = (d_sg_list_t *)&rec->tr_iods[nr_iods];
+	iovs          = (d_iov_t *)&rec->tr_akeys[nr_iods];
+	buf           = (char *)&iovs[nr_iods];
+
+	memcpy(buf, dkey->iov_buf, dkey->iov_len);
+	d_iov_set(&rec->tr_dkey, buf, dkey->iov_len);
+	buf += dkey->iov_len;
+
+	/** only the size of the iods is needed to return the record */
+	for (i = 0; i < nr_iods; i++) {
+		rec->tr_iods[i].iod_size = iods[i].iod_size;
+		memcpy(buf, akeys[i].sg_iovs->iov_buf, akeys[i].sg_iovs->iov_len);
+		d_iov_set(&iovs[i], buf, akeys[i].sg_iovs->iov_len);
+		rec->tr_akeys[i].sg_nr     = 1;
+		rec->tr_akeys[i].sg_nr_out = 1;
+		rec->tr_akeys[i].sg_iovs   = &iovs[i];
+		buf += akeys[i].sg_iovs->iov_len;
+	}
+
+	rec->tr_key = *key;
+	if (key->cls == SUBIDX_STR) {
+		memcpy(buf, key->data, key->len);
+		rec->tr_key.data = buf;
+	}
+	*rec_out = rec;
+	return 0;
+}
+
+/**
+ * Adds a record to \a topk if its key is among the first k ones seen so far.
+ */
+int
+pipeline_topk_add(struct pipeline_topk_t *topk, struct pipeline_key_t *key, d_iov_t *dkey,
+		  daos_iod_t *iods, d_sg_list_t *akeys)
+{
+	struct pipeline_topk_rec_t  tmp;
+	struct pipeline_topk_rec_t *rec;
+	struct d_binheap_node      *root;
+	int                         rc;
+
+	if (topk->tk_k == 0)
+		return 0;
+
+	if (d_binheap_size(&topk->tk_heap) == topk->tk_k) {
+		/** the last record kept has to come strictly after the new one */
+		root       = d_binheap_root(&topk->tk_heap);
+		tmp.tr_key = *key;
+		if (!topk->tk_heap.d_bh_ops->hop_compare(root, &tmp.tr_node))
+			return 0;
+	}
+
+	rc = topk_rec_alloc(topk, key, dkey, iods, akeys, &rec);
+	if (rc != 0)
+		return rc;
+
+	if (d_binheap_size(&topk->tk_heap) == topk->tk_k) {
+		root = d_binheap_remove_root(&topk->tk_heap);
+		pipeline_topk_rec_free(container_of(root, struct pipeline_topk_rec_t, tr_node));
+	}
+	rc = d_binheap_insert(&topk->tk_heap, &rec->tr_node);
+	if (rc != 0)
+		pipeline_topk_rec_free(rec);
+	return rc;
+}
+
+/**
+ * Empties \a topk into the array \a recs, allocated here, sorted by ORDER BY key. The records have
+ * to be freed with pipeline_topk_rec_free().
+ */
+int
+pipeline_topk_sort(struct pipeline_topk_t *topk, struct pipeline_topk_rec_t ***recs, uint32_t *nr)
+{
+	struct d_binheap_node *node;
+	uint32_t               i;
+
+	*nr   = d_binheap_size(&topk->tk_heap);
+	*recs = NULL;
+	if (*nr == 0)
+		return 0;
+
+	D_ALLOC_ARRAY(*recs, *nr);
+	if (*recs == NULL)
+		return -DER_NOMEM;
+
+	/** the root is the last record in order */
+	for (i = *nr; i > 0; i--) {
+		node            = d_binheap_remove_root(&topk->tk_heap);
+		(*recs)[i - 1]  = container_of(node, struct pipeline_topk_rec_t, tr_node);
+	}
+	return 0;
+}
@@ -0,0 +1,777 @@
+/**
+ * (C) Copyright 2026 Hewlett Packard Enterprise Development LP
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+/**
+ * Filter programs.
+ *
+ * pipeline_compile() turns a filter into an array of filter parts that are evaluated through
+ * recursive filter_func_t calls, one indirect call per part and per record. Here, the same filter
+ * tree is flattened into a linear program working on a register file:
+ *
+ *  - akeys and dkeys become typed loads; constants are stored in registers at compile time,
+ *  - comparisons, arithmetic and aggregations read and write registers,
+ *  - AND and OR are lowered into short-circuit jumps,
+ *  - IN (several constants on the right side of a comparison) is a single comparison over a
+ *    range of registers,
+ *  - sub-expressions only depending on constants are folded at compile time.
+ *
+ * Opcodes of typed operations are the indexes used for filter_func_ptrs[] in filter.c, so both
+ * evaluators always agree on which operation (and which type) a filter part maps to.
+ */
+#define D_LOGFAC DD_FAC(pipeline)
+
+#include <daos/common.h>
+#include "pipeline_internal.h"
+
+bool pipeline_prog_enabled = true;
+
+#define FPROG_OP_LOAD_DKEY	0
+#define FPROG_OP_LOAD_AKEY	1
+#define FPROG_OP_JMP_FALSE	2
+#define FPROG_OP_JMP_TRUE	3
+#define FPROG_OP_END		4
+#define FPROG_OP_FUNC		8
+/** typed operations, \a func_idx is the index of the function in filter_func_ptrs[] */
+#define FPROG_OP(func_idx)	(FPROG_OP_FUNC + (func_idx))
+
+#define FPROG_REG_NONE		UINT16_MAX
+#define FPROG_JMP_NONE		UINT32_MAX
+#define FPROG_IOD_UNRESOLVED	(-2)
+#define FPROG_IOD_NONE		(-1)
+
+/** result of compiling a filter subtree */
+struct fprog_val {
+	/** first register holding the value */
+	uint16_t	reg;
+	/** number of values, only constant parts can have more than one */
+	uint16_t	nr;
+	/** value is known at compile time */
+	bool		is_const;
+};
+
+struct fprog_ctx {
+	daos_filter_t		*filter;
+	struct filter_prog_t	*prog;
+	uint32_t		 part_idx;
+	uint32_t		 max_insns;
+	uint32_t		 max_regs;
+	/** type of the last key or constant seen, same rule as compile_filter() */
+	char			*type;
+	size_t			 type_len;
+};
+
+static bool
+part_is(daos_filter_part_t *part, const char *name)
+{
+	return !strncmp((char *)part->part_type.iov_buf, name, part->part_type.iov_len);
+}
+
+static uint16_t
+fprog_reg_alloc(struct fprog_ctx *ctx)
+{
+	struct filter_prog_t *prog = ctx->prog;
+
+	D_ASSERT(prog->num_regs < ctx->max_regs);
+	prog->regs[prog->num_regs] = (struct filter_reg_t){0};
+	return prog->num_regs++;
+}
+
+static struct filter_insn_t *
+fprog_emit(struct fprog_ctx *ctx, uint16_t op, uint16_t dst, uint16_t src0, uint16_t src1)
+{
+	struct filter_prog_t *prog = ctx->prog;
+	struct filter_insn_t *insn;
+
+	D_ASSERT(prog->num_insns < ctx->max_insns);
+	insn          = &prog->insns[prog->num_insns++];
+	*insn         = (struct filter_insn_t){0};
+	insn->op      = op;
+	insn->dst     = dst;
+	insn->src[0]  = src0;
+	insn->src[1]  = src1;
+	insn->src_nr  = 1;
+	insn->jmp     = FPROG_JMP_NONE;
+	insn->iod_idx = FPROG_IOD_UNRESOLVED;
+	return insn;
+}
+
+/**
+ * Jumps to labels that are not known yet are chained through their \a jmp field, and patched
+ * once the label is reached.
+ */
+static void
+fprog_chain(struct fprog_ctx *ctx, uint32_t *chain)
+{
+	uint32_t idx = ctx->prog->num_insns - 1;
+
+	ctx->prog->insns[idx].jmp = *chain;
+	*chain                    = idx;
+}
+
+static void
+fprog_patch(struct fprog_ctx *ctx, uint32_t chain)
+{
+	struct filter_insn_t *insn;
+
+	while (chain != FPROG_JMP_NONE) {
+		insn      = &ctx->prog->insns[chain];
+		chain     = insn->jmp;
+		insn->jmp = ctx->prog->num_insns;
+	}
+}
+
+static void
+fprog_const_bool(struct fprog_ctx *ctx, uint32_t truncate, bool value, struct fprog_val *val)
+{
+	/** code emitted for this subtree is not needed anymore, all its jumps are local to it */
+	ctx->prog->num_insns = truncate;
+
+	val->reg                         = fprog_reg_alloc(ctx);
+	val->nr                          = 1;
+	val->is_const                    = true;
+	ctx->prog->regs[val->reg].v.b    = value;
+	ctx->prog->regs[val->reg].data   = (char *)&ctx->prog->regs[val->reg].v;
+}
+
+static void
+fprog_load(struct filter_reg_t *reg, uint16_t type, char *buf, size_t len)
+{
+	reg->data     = buf;
+	reg->data_len = len;
+	if (buf == NULL)
+		return;
+
+	switch (type) {
+	case SUBIDX_UINTEGER1:
+		reg->v.u = *((uint8_t *)buf);
+		break;
+	case SUBIDX_UINTEGER2:
+		reg->v.u = *((uint16_t *)buf);
+		break;
+	case SUBIDX_UINTEGER4:
+		reg->v.u = *((uint32_t *)buf);
+		break;
+	case SUBIDX_UINTEGER8:
+		reg->v.u = *((uint64_t *)buf);
+		break;
+	case SUBIDX_INTEGER1:
+		reg->v.i = *((int8_t *)buf);
+		break;
+	case SUBIDX_INTEGER2:
+		reg->v.i = *((int16_t *)buf);
+		break;
+	case SUBIDX_INTEGER4:
+		reg->v.i = *((int32_t *)buf);
+		break;
+	case SUBIDX_INTEGER8:
+		reg->v.i = *((int64_t *)buf);
+		break;
+	case SUBIDX_REAL4:
+		reg->v.d = *((float *)buf);
+		break;
+	case SUBIDX_REAL8:
+		reg->v.d = *((double *)buf);
+		break;
+	case SUBIDX_STRING:
+		if (len < sizeof(size_t)) {
+			reg->data = NULL;
+			break;
+		}
+		reg->data_len = *((size_t *)buf);
+		if (reg->data_len + sizeof(size_t) > len)
+			reg->data_len = len - sizeof(size_t);
+		reg->data = &buf[sizeof(size_t)];
+		break;
+	case SUBIDX_CSTRING:
+		reg->data_len = strnlen(buf, len);
+		break;
+	default: /** SUBIDX_BINARY */
+		break;
+	}
+}
+
+static void
+fprog_load_dkey(struct filter_part_run_t *args, struct filter_insn_t *insn,
+		struct filter_reg_t *reg)
+{
+	char  *buf = (char *)args->dkey->iov_buf;
+	size_t len;
+
+	if (insn->data_offset >= args->dkey->iov_len) {
+		fprog_load(reg, insn->type, NULL, 0);
+		return;
+	}
+	len = args->dkey->iov_len - insn->data_offset;
+	if (insn->type == SUBIDX_BINARY && insn->data_len < len)
+		len = insn->data_len;
+	if (len < filter_type_size(insn->type)) {
+		fprog_load(reg, insn->type, NULL, 0);
+		return;
+	}
+	fprog_load(reg, insn->type, &buf[insn->data_offset], len);
+}
+
+static void
+fprog_load_akey(struct filter_part_run_t *args, struct filter_insn_t *insn,
+		struct filter_reg_t *reg)
+{
+	char       *buf;
+	size_t      len;
+
+	/** iods do not change during a pipeline run, the akey is only searched once */
+	if (unlikely(insn->iod_idx == FPROG_IOD_UNRESOLVED))
+		insn->iod_idx = getdata_akey_idx(args, insn->iov);
+	if (insn->iod_idx == FPROG_IOD_NONE) {
+		fprog_load(reg, insn->type, NULL, 0);
+		return;
+	}
+
+	len = insn->data_len;
+	buf = getdata_akey_iod(args, insn->iod_idx, insn->data_offset, &len);
+	/** numeric values not fully stored in the record are NULL */
+	if (buf != NULL && len < filter_type_size(insn->type))
+		buf = NULL;
+	fprog_load(reg, insn->type, buf, len);
+}
+
+#define FPROG_CASE_CMP_NUM(func, class, field, oper)                                               \
+	case FPROG_OP(SUBIDX_FUNC_##func + SUBIDX_##class):                                        \
+		*res = (l->v.field oper r->v.field);                                               \
+		break;
+
+#define FPROG_CASE_CMP(func, name, oper)                                                           \
+	FPROG_CASE_CMP_NUM(func, UINTEGER, u, oper)                                                \
+	FPROG_CASE_CMP_NUM(func, INTEGER, i, oper)                                                 \
+	FPROG_CASE_CMP_NUM(func, DOUBLE, d, oper)                                                  \
+	case FPROG_OP(SUBIDX_FUNC_##func + SUBIDX_STR):                                            \
+		*res = logfunc_##name##_st(l->data, l->data_len, r->data, r->data_len);            \
+		break;
+
+/**
+ * Evaluates a comparison (or LIKE) between two non NULL registers.
+ */
+static inline int
+fprog_cmp(uint16_t op, struct filter_reg_t *l, struct filter_reg_t *r, bool *res)
+{
+	switch (op) {
+	FPROG_CASE_CMP(EQ, eq, ==)
+	FPROG_CASE_CMP(NE, ne, !=)
+	FPROG_CASE_CMP(LT, lt, <)
+	FPROG_CASE_CMP(LE, le, <=)
+	FPROG_CASE_CMP(GE, ge, >=)
+	FPROG_CASE_CMP(GT, gt, >)
+	case FPROG_OP(SUBIDX_FUNC_LIKE):
+		return filter_like_match(l->data, l->data_len, r->data, r->data_len, res);
+	default:
+		D_ASSERTF(false, "unknown comparison %u\n", op);
+		return -DER_INVAL;
+	}
+	return 0;
+}
+
+#define FPROG_CASE_ARITH(func, class, field, oper)                                                 \
+	case FPROG_OP(SUBIDX_FUNC_##func + SUBIDX_##class):                                        \
+		res->v.field = l->v.field oper r->v.field;                                         \
+		break;
+
+#define FPROG_CASE_DIV(class, field)                                                               \
+	case FPROG_OP(SUBIDX_FUNC_DIV + SUBIDX_##class):                                           \
+		if (r->v.field == 0)                                                               \
+			return -DER_DIV_BY_ZERO;                                                   \
+		res->v.field = l->v.field / r->v.field;                                            \
+		break;
+
+/**
+ * Evaluates an arithmetic function between two non NULL registers.
+ */
+static inline int
+fprog_arith(uint16_t op, struct filter_reg_t *l, struct filter_reg_t *r, struct filter_reg_t *res)
+{
+	switch (op) {
+	FPROG_CASE_ARITH(ADD, UINTEGER, u, +)
+	FPROG_CASE_ARITH(ADD, INTEGER, i, +)
+	FPROG_CASE_ARITH(ADD, DOUBLE, d, +)
+	FPROG_CASE_ARITH(SUB, UINTEGER, u, -)
+	FPROG_CASE_ARITH(SUB, INTEGER, i, -)
+	FPROG_CASE_ARITH(SUB, DOUBLE, d, -)
+	FPROG_CASE_ARITH(MUL, UINTEGER, u, *)
+	FPROG_CASE_ARITH(MUL, INTEGER, i, *)
+	FPROG_CASE_ARITH(MUL, DOUBLE, d, *)
+	FPROG_CASE_DIV(UINTEGER, u)
+	FPROG_CASE_DIV(INTEGER, i)
+	FPROG_CASE_DIV(DOUBLE, d)
+	FPROG_CASE_ARITH(BITAND, UINTEGER, u, &)
+	FPROG_CASE_ARITH(BITAND, INTEGER, i, &)
+	default:
+		D_ASSERTF(false, "unknown arithmetic function %u\n", op);
+		return -DER_INVAL;
+	}
+	res->data = (char *)&res->v;
+	return 0;
+}
+
+#define FPROG_CASE_AGGR(class, field)                                                              \
+	case FPROG_OP(SUBIDX_FUNC_SUM + SUBIDX_##class):                                           \
+		*aggr += (double)src->v.field;                                                     \
+		break;                                                                             \
+	case FPROG_OP(SUBIDX_FUNC_MAX + SUBIDX_##class):                                           \
+		if ((double)src->v.field > *aggr)                                                  \
+			*aggr = (double)src->v.field;                                              \
+		break;                                                                             \
+	case FPROG_OP(SUBIDX_FUNC_MIN + SUBIDX_##class):                                           \
+		if ((double)src->v.field < *aggr)                                                  \
+			*aggr = (double)src->v.field;                                              \
+		break;
+
+static inline void
+fprog_aggr(uint16_t op, struct filter_reg_t *src, double *aggr)
+{
+	switch (op) {
+	FPROG_CASE_AGGR(UINTEGER, u)
+	FPROG_CASE_AGGR(INTEGER, i)
+	FPROG_CASE_AGGR(DOUBLE, d)
+	default:
+		D_ASSERTF(false, "unknown aggregation function %u\n", op);
+	}
+}
+
+static bool
+func_is_cmp(uint32_t func_idx)
+{
+	return func_idx < SUBIDX_FUNC_ADD || func_idx == SUBIDX_FUNC_LIKE;
+}
+
+static bool
+func_is_arith(uint32_t func_idx)
+{
+	return (func_idx >= SUBIDX_FUNC_ADD && func_idx < SUBIDX_FUNC_SUM) ||
+	       func_idx == SUBIDX_FUNC_BITAND;
+}
+
+static bool
+func_is_aggr(uint32_t func_idx)
+{
+	return func_idx >= SUBIDX_FUNC_SUM && func_idx < SUBIDX_FUNC_BITAND;
+}
+
+static int
+fprog_compile_part(struct fprog_ctx *ctx, uint16_t dst, struct fprog_val *val);
+
+static int
+fprog_compile_key(struct fprog_ctx *ctx, daos_filter_part_t *part, struct fprog_val *val)
+{
+	struct filter_insn_t *insn;
+	struct filter_reg_t  *reg;
+	uint16_t              type;
+	size_t                i;
+
+	ctx->type     = (char *)part->data_type.iov_buf;
+	ctx->type_len = part->data_type.iov_len;
+	type          = calc_type_idx(ctx->type, ctx->type_len);
+
+	if (part_is(part, "DAOS_FILTER_CONST")) {
+		/** constants are loaded once, and live in consecutive registers */
+		for (i = 0; i < part->num_constants; i++) {
+			val->reg = fprog_reg_alloc(ctx);
+			reg      = &ctx->prog->regs[val->reg];
+			fprog_load(reg, type, (char *)part->constant[i].iov_buf,
+				   part->constant[i].iov_len);
+			if (reg->data == NULL)
+				return -DER_INVAL;
+		}
+		val->reg      -= part->num_constants - 1;
+		val->nr        = part->num_constants;
+		val->is_const  = true;
+		return 0;
+	}
+
+	val->reg      = fprog_reg_alloc(ctx);
+	val->nr       = 1;
+	val->is_const = false;
+	if (part_is(part, "DAOS_FILTER_AKEY")) {
+		insn      = fprog_emit(ctx, FPROG_OP_LOAD_AKEY, val->reg, FPROG_REG_NONE,
+				       FPROG_REG_NONE);
+		insn->iov = &part->akey;
+	} else { /** DAOS_FILTER_DKEY */
+		insn = fprog_emit(ctx, FPROG_OP_LOAD_DKEY, val->reg, FPROG_REG_NONE,
+				  FPROG_REG_NONE);
+	}
+	insn->type        = type;
+	insn->data_offset = part->data_offset;
+	insn->data_len    = part->data_len;
+	return 0;
+}
+
+/** AND and OR, \a is_and tells which */
+static int
+fprog_compile_logic(struct fprog_ctx *ctx, daos_filter_part_t *part, uint16_t dst, bool is_and,
+		    struct fprog_val *val)
+{
+	struct fprog_val child;
+	uint32_t         start = ctx->prog->num_insns;
+	uint32_t         chain = FPROG_JMP_NONE;
+	uint32_t         nr    = 0;
+	uint32_t         i;
+	int              rc;
+
+	if (dst == FPROG_REG_NONE)
+		dst = fprog_reg_alloc(ctx);
+
+	for (i = 0; i < part->num_operands; i++) {
+		rc = fprog_compile_part(ctx, dst, &child);
+		if (rc != 0)
+			return rc;
+		if (child.is_const) {
+			/** false for AND (true for OR) decides the result, otherwise skip it */
+			if (ctx->prog->regs[child.reg].v.b != is_and) {
+				/** the remaining operands still have to be consumed */
+				for (i++; i < part->num_operands; i++) {
+					rc = fprog_compile_part(ctx, dst, &child);
+					if (rc != 0)
+						return rc;
+				}
+				fprog_const_bool(ctx, start, !is_and, val);
+				return 0;
+			}
+			continue;
+		}
+		D_ASSERT(child.reg == dst);
+		fprog_emit(ctx, is_and ? FPROG_OP_JMP_FALSE : FPROG_OP_JMP_TRUE, FPROG_REG_NONE, dst,
+			   FPROG_REG_NONE);
+		fprog_chain(ctx, &chain);
+		nr++;
+	}
+	if (nr == 0) {
+		fprog_const_bool(ctx, start, is_and, val);
+		return 0;
+	}
+	/** the last jump goes to the next instruction */
+	ctx->prog->num_insns--;
+	chain = ctx->prog->insns[chain].jmp;
+	fprog_patch(ctx, chain);
+
+	val->reg      = dst;
+	val->nr       = 1;
+	val->is_const = false;
+	return 0;
+}
+
+/**
+ * Comparisons and LIKE. The left operand is compared against every value of the right operands
+ * (IN), and the result is true as soon as one comparison is true. A NULL operand makes the result
+ * false.
+ */
+static int
+fprog_compile_cmp(struct fprog_ctx *ctx, daos_filter_part_t *part, uint32_t func_idx, uint16_t dst,
+		  struct fprog_val *val)
+{
+	struct fprog_val      left;
+	struct fprog_val      right[part->num_operands];
+	struct filter_reg_t  *regs;
+	struct filter_insn_t *insn;
+	uint32_t              start = ctx->prog->num_insns;
+	uint32_t              chain = FPROG_JMP_NONE;
+	uint32_t              nr    = 0;
+	uint16_t              op;
+	uint32_t              i, j;
+	bool                  res;
+	int                   rc;
+
+	rc = fprog_compile_part(ctx, FPROG_REG_NONE, &left);
+	if (rc != 0)
+		return rc;
+	for (i = 1; i < part->num_operands; i++) {
+		rc = fprog_compile_part(ctx, FPROG_REG_NONE, &right[i]);
+		if (rc != 0)
+			return rc;
+	}
+
+	if (func_idx < SUBIDX_FUNCS_WITH_ONE_TYPE_ONLY)
+		func_idx += calc_type_nosize_idx(calc_type_idx(ctx->type, ctx->type_len));
+	op = FPROG_OP(func_idx);
+
+	if (dst == FPROG_REG_NONE)
+		dst = fprog_reg_alloc(ctx);
+	regs = ctx->prog->regs;
+
+	for (i = 1; i < part->num_operands; i++) {
+		if (left.is_const && right[i].is_const) {
+			for (j = 0; j < right[i].nr; j++) {
+				rc = fprog_cmp(op, &regs[left.reg], &regs[right[i].reg + j], &res);
+				if (rc != 0)
+					return rc;
+				if (res) {
+					fprog_const_bool(ctx, start, true, val);
+					return 0;
+				}
+			}
+			continue;
+		}
+		if (nr > 0) {
+			fprog_emit(ctx, FPROG_OP_JMP_TRUE, FPROG_REG_NONE, dst, FPROG_REG_NONE);
+			fprog_chain(ctx, &chain);
+		}
+		insn         = fprog_emit(ctx, op, dst, left.reg, right[i].reg);
+		insn->src_nr = right[i].nr;
+		fprog_chain(ctx, &chain);
+		nr++;
+	}
+	if (nr == 0) {
+		fprog_const_bool(ctx, start, false, val);
+		return 0;
+	}
+	fprog_patch(ctx, chain);
+
+	val->reg      = dst;
+	val->nr       = 1;
+	val->is_const = false;
+	return 0;
+}
+
+static int
+fprog_compile_part(struct fprog_ctx *ctx, uint16_t dst, struct fprog_val *val)
+{
+	daos_filter_part_t   *part;
+	struct fprog_val      child[2];
+	struct filter_reg_t  *regs;
+	uint32_t              start;
+	uint32_t              idx;
+	uint32_t              func_idx;
+	uint32_t              i;
+	uint16_t              op;
+	int                   rc;
+
+	if (ctx->part_idx >= ctx->filter->num_parts)
+		return -DER_INVAL;
+	idx  = ctx->part_idx++;
+	part = ctx->filter->parts[idx];
+
+	if (part->part_type.iov_len < strlen("DAOS_FILTER_FUNC") ||
+	    strncmp((char *)part->part_type.iov_buf, "DAOS_FILTER_FUNC", strlen("DAOS_FILTER_FUNC")))
+		return fprog_compile_key(ctx, part, val);
+
+	func_idx = calc_filterfunc_idx(ctx->filter->parts, idx);
+
+	if (func_idx == SUBIDX_FUNC_AND || func_idx == SUBIDX_FUNC_OR)
+		return fprog_compile_logic(ctx, part, dst, func_idx == SUBIDX_FUNC_AND, val);
+	if (func_is_cmp(func_idx)) {
+		if (part->num_operands < 2)
+			return -DER_INVAL;
+		return fprog_compile_cmp(ctx, part, func_idx, dst, val);
+	}
+
+	start = ctx->prog->num_insns;
+	if (func_idx == SUBIDX_FUNC_NOT) {
+		rc = fprog_compile_part(ctx, dst, &child[0]);
+		if (rc != 0)
+			return rc;
+		if (child[0].is_const) {
+			fprog_const_bool(ctx, start, !ctx->prog->regs[child[0].reg].v.b, val);
+			return 0;
+		}
+		/** NOT is applied in place */
+		fprog_emit(ctx, FPROG_OP(func_idx), child[0].reg, child[0].reg, FPROG_REG_NONE);
+		*val = child[0];
+		return 0;
+	}
+
+	/** the rest of functions have one or two single-valued operands */
+	if (part->num_operands == 0 || part->num_operands > 2)
+		return -DER_INVAL;
+	for (i = 0; i < part->num_operands; i++) {
+		rc = fprog_compile_part(ctx, FPROG_REG_NONE, &child[i]);
+		if (rc != 0)
+			return rc;
+		if (child[i].nr != 1)
+			return -DER_INVAL;
+	}
+
+	if ((func_idx == SUBIDX_FUNC_ISNULL || func_idx == SUBIDX_FUNC_ISNOTNULL) &&
+	    child[0].is_const) {
+		/** constants are never NULL */
+		fprog_const_bool(ctx, start, func_idx == SUBIDX_FUNC_ISNOTNULL, val);
+		return 0;
+	}
+
+	if (func_idx < SUBIDX_FUNCS_WITH_ONE_TYPE_ONLY)
+		func_idx += calc_type_nosize_idx(calc_type_idx(ctx->type, ctx->type_len));
+	op = FPROG_OP(func_idx);
+
+	if (func_is_aggr(func_idx)) {
+		fprog_emit(ctx, op, FPROG_REG_NONE, child[0].reg, FPROG_REG_NONE);
+		val->reg      = FPROG_REG_NONE;
+		val->nr       = 0;
+		val->is_const = false;
+		return 0;
+	}
+
+	if (dst == FPROG_REG_NONE || func_is_arith(func_idx))
+		dst = fprog_reg_alloc(ctx);
+	regs = ctx->prog->regs;
+
+	if (func_is_arith(func_idx)) {
+		if (part->num_operands != 2)
+			return -DER_INVAL;
+		if (child[0].is_const && child[1].is_const &&
+		    fprog_arith(op, &regs[child[0].reg], &regs[child[1].reg], &regs[dst]) == 0) {
+			ctx->prog->num_insns = start;
+			val->reg             = dst;
+			val->nr              = 1;
+			val->is_const        = true;
+			return 0;
+		}
+		/** division by zero is left to be reported at run time */
+		fprog_emit(ctx, op, dst, child[0].reg, child[1].reg);
+	} else { /** ISNULL, ISNOTNULL */
+		fprog_emit(ctx, op, dst, child[0].reg, FPROG_REG_NONE);
+	}
+
+	val->reg      = dst;
+	val->nr       = 1;
+	val->is_const = false;
+	return 0;
+}
+
+int
+filter_prog_compile(daos_filter_t *filter, struct filter_prog_t **prog_out)
+{
+	struct filter_prog_t *prog;
+	struct fprog_ctx      ctx = {0};
+	struct fprog_val      val;
+	daos_filter_part_t   *part;
+	uint32_t              nr_parts;
+	uint32_t              i;
+	int                   rc;
+
+	nr_parts = filter->num_parts;
+	for (i = 0; i < filter->num_parts; i++) {
+		part = filter->parts[i];
+		if (part_is(part, "DAOS_FILTER_CONST"))
+			nr_parts += part->num_constants;
+	}
+	/** each part emits at most two instructions and allocates at most two registers */
+	if (2 * nr_parts + 2 >= FPROG_REG_NONE)
+		return -DER_NOTSUPPORTED;
+
+	D_ALLOC_PTR(prog);
+	if (prog == NULL)
+		return -DER_NOMEM;
+	ctx.max_insns = 2 * nr_parts + 2;
+	ctx.max_regs  = 2 * nr_parts + 2;
+	D_ALLOC_ARRAY(prog->insns, ctx.max_insns);
+	if (prog->insns == NULL)
+		D_GOTO(error, rc = -DER_NOMEM);
+	D_ALLOC_ARRAY(prog->regs, ctx.max_regs);
+	if (prog->regs == NULL)
+		D_GOTO(error, rc = -DER_NOMEM);
+
+	ctx.filter = filter;
+	ctx.prog   = prog;
+	rc         = fprog_compile_part(&ctx, FPROG_REG_NONE, &val);
+	if (rc != 0)
+		D_GOTO(error, rc);
+
+	fprog_emit(&ctx, FPROG_OP_END, FPROG_REG_NONE, val.reg, FPROG_REG_NONE);
+
+	D_DEBUG(DB_TRACE, "filter with %u parts compiled into %u instructions, %u registers\n",
+		filter->num_parts, prog->num_insns, prog->num_regs);
+	*prog_out = prog;
+	return 0;
+error:
+	filter_prog_free(prog);
+	return rc;
+}
+
+void
+filter_prog_free(struct filter_prog_t *prog)
+{
+	if (prog == NULL)
+		return;
+	D_FREE(prog->insns);
+	D_FREE(prog->regs);
+	D_FREE(prog);
+}
+
+/**
+ * Runs \a prog for the current record in \a args. For conditions, the result is returned in
+ * args->log_out. For aggregations, args->iov_aggr is updated.
+ */
+int
+filter_prog_run(struct filter_prog_t *prog, struct filter_part_run_t *args)
+{
+	struct filter_reg_t  *regs = prog->regs;
+	struct filter_insn_t *insn;
+	struct filter_reg_t  *l;
+	struct filter_reg_t  *r;
+	uint32_t              pc = 0;
+	uint32_t              i;
+	int                   rc;
+
+	while (1) {
+		insn = &prog->insns[pc++];
+
+		switch (insn->op) {
+		case FPROG_OP_LOAD_DKEY:
+			fprog_load_dkey(args, insn, &regs[insn->dst]);
+			break;
+		case FPROG_OP_LOAD_AKEY:
+			fprog_load_akey(args, insn, &regs[insn->dst]);
+			break;
+		case FPROG_OP_JMP_FALSE:
+			if (!regs[insn->src[0]].v.b)
+				pc = insn->jmp;
+			break;
+		case FPROG_OP_JMP_TRUE:
+			if (regs[insn->src[0]].v.b)
+				pc = insn->jmp;
+			break;
+		case FPROG_OP_END:
+			if (insn->src[0] != FPROG_REG_NONE)
+				args->log_out = regs[insn->src[0]].v.b;
+			return 0;
+		case FPROG_OP(SUBIDX_FUNC_NOT):
+			regs[insn->dst].v.b = !regs[insn->src[0]].v.b;
+			break;
+		case FPROG_OP(SUBIDX_FUNC_ISNULL):
+			regs[insn->dst].v.b = (regs[insn->src[0]].data == NULL);
+			break;
+		case FPROG_OP(SUBIDX_FUNC_ISNOTNULL):
+			regs[insn->dst].v.b = (regs[insn->src[0]].data != NULL);
+			break;
+		default:
+			l = &regs[insn->src[0]];
+			if (func_is_aggr(insn->op - FPROG_OP_FUNC)) {
+				if (l->data != NULL)
+					fprog_aggr(insn->op, l, (double *)args->iov_aggr->iov_buf);
+				break;
+			}
+			r = &regs[insn->src[1]];
+			if (func_is_arith(insn->op - FPROG_OP_FUNC)) {
+				if (unlikely(l->data == NULL || r->data == NULL)) {
+					regs[insn->dst].data = NULL;
+					break;
+				}
+				rc = fprog_arith(insn->op, l, r, &regs[insn->dst]);
+				if (unlikely(rc != 0))
+					return rc;
+				break;
+			}
+			if (unlikely(l->data == NULL || r->data == NULL)) {
+				regs[insn->dst].v.b = false;
+				pc                  = insn->jmp;
+				break;
+			}
+			rc = fprog_cmp(insn->op, l, r, &regs[insn->dst].v.b);
+			if (unlikely(rc != 0))
+				return rc;
+			for (i = 1; i < insn->src_nr && !regs[insn->dst].v.b; i++) {
+				rc = fprog_cmp(insn->op, l, &r[i], &regs[insn->dst].v.b);
+				if (unlikely(rc != 0))
+					return rc;
+			}
+			break;
+		}
+	}
+}
@@ -95,76 +95,92 @@ getdata_func_dkey_cst(struct filter_part_run_t *args)
 	return 0;
 }
 
-static void
-getdata_func_akey_(struct filter_part_run_t *args)
+/**
+ * Returns a pointer to the data of akey \a iod_idx starting at record \a target_offset, or NULL if
+ * the akey has no data for this record. \a len is clamped to the size actually available.
+ */
+char *
+getdata_akey_iod(struct filter_part_run_t *args, uint32_t iod_idx, size_t target_offset,
+		 size_t *len)
 {
-	char        *akey_name_str;
-	size_t       akey_name_size;
 	daos_iod_t  *iod;
 	d_iov_t     *akey;
 	/*daos_iom_t  *iom;*/
 	daos_recx_t *recx;
-	char        *iod_name_str;
-	size_t       iod_name_size;
-	uint32_t     i, j;
 	char        *buf;
-	size_t       target_offset;
 	size_t       offset;
-	size_t       len;
+	uint32_t     j;
+
+	iod  = &args->iods[iod_idx];
+	akey = args->akeys[iod_idx].sg_iovs;
+	if (akey->iov_len == 0)
+		return NULL;
+
+	if (iod->iod_type == DAOS_IOD_SINGLE) {
+		buf = (char *)akey->iov_buf;
+		buf = &buf[target_offset];
+		if (target_offset + *len > iod->iod_size)
+			*len = iod->iod_size - target_offset;
+		return buf;
+	}
+	/** DAOS_IOD_ARRAY */
+	/*iom = &args->ioms[iod_idx];*/
+
+	offset = 0;
+	/*for (j = 0; j < iom->iom_nr_out; j++)*/
+	for (j = 0; j < iod->iod_nr; j++) {
+		/*recx = &iom->iom_recxs[j];*/
+		recx = &iod->iod_recxs[j];
+
+		if ((target_offset < recx->rx_idx + recx->rx_nr) &&
+		    target_offset >= recx->rx_idx) { /** extend found */
+			buf = (char *)akey->iov_buf;
+			buf = &buf[offset];
+			if (iod->iod_size * recx->rx_nr < *len)
+				*len = (size_t)recx->rx_nr * iod->iod_size;
+			return buf;
+		}
+		offset += (size_t)recx->rx_nr * iod->iod_size;
+	}
+	return NULL;
+}
 
-	akey_name_str  = (char *)args->parts[args->part_idx].iov->iov_buf;
-	akey_name_size = args->parts[args->part_idx].iov->iov_len;
-	target_offset  = args->parts[args->part_idx].data_offset;
-	len            = args->parts[args->part_idx].data_len;
-	buf            = NULL;
+/**
+ * Returns the index of the iod of akey \a akey, or -1 if the akey is not part of the iods.
+ */
+int32_t
+getdata_akey_idx(struct filter_part_run_t *args, d_iov_t *akey)
+{
+	daos_iod_t *iod;
+	uint32_t    i;
 
 	for (i = 0; i < args->nr_iods; i++) {
-		iod           = &args->iods[i];
-		iod_name_str  = (char *)iod->iod_name.iov_buf;
-		iod_name_size = iod->iod_name.iov_len;
-		if (iod_name_size != akey_name_size)
-			continue;
-
-		akey = args->akeys[i].sg_iovs;
-		/** akey exists and has data */
-		if (!memcmp(akey_name_str, iod_name_str, iod_name_size) &&
-		    akey->iov_len > 0) {
-			if (iod->iod_type == DAOS_IOD_SINGLE) {
-				buf = (char *)akey->iov_buf;
-				buf = &buf[target_offset];
-				if (target_offset + len > iod->iod_size)
-					len = iod->iod_size - target_offset;
-
-				D_GOTO(exit, buf);
-			}
-			/** DAOS_IOD_ARRAY */
-			/*iom = &args->ioms[i];*/
-
-			offset = 0;
-			/*for (j = 0; j < iom->iom_nr_out; j++)*/
-			for (j = 0; j < iod->iod_nr; j++) {
-				/*recx = &iom->iom_recxs[j];*/
-				recx = &iod->iod_recxs[j];
-
-				if ((target_offset < recx->rx_idx + recx->rx_nr) &&
-				    target_offset >= recx->rx_idx) { /** extend found */
-					buf = (char *)akey->iov_buf;
-					buf = &buf[offset];
-					if (iod->iod_size * recx->rx_nr < len)
-						len = (size_t)recx->rx_nr * iod->iod_size;
-
-					D_GOTO(exit, buf);
-				}
-				offset += (size_t)recx->rx_nr * iod->iod_size;
-			}
-			D_GOTO(exit, buf);
-			/**
-			 * Even if extent is not found we return, since there are not two akeys
-			 * with the same name (i.e., key value)
-			 */
-		}
+		iod = &args->iods[i];
+		if (iod->iod_name.iov_len == akey->iov_len &&
+		    !memcmp(iod->iod_name.iov_buf, akey->iov_buf, akey->iov_len))
+			return i;
 	}
-exit:
+	return -1;
+}
+
+static void
+getdata_func_akey_(struct filter_part_run_t *args)
+{
+	int32_t      i;
+	char        *buf;
+	size_t       len;
+
+	len = args->parts[args->part_idx].data_len;
+	buf = NULL;
+
+	/**
+	 * Even if extent is not found we return, since there are not two akeys with the same name
+	 * (i.e., key value)
+	 */
+	i = getdata_akey_idx(args, args->parts[args->part_idx].iov);
+	if (i >= 0)
+		buf = getdata_akey_iod(args, i, args->parts[args->part_idx].data_offset, &len);
+
 	args->data_out     = buf;
 	args->data_len_out = len;
 }
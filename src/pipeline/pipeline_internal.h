@@ -7,8 +7,60 @@
 #ifndef __DAOS_PIPE_INTERNAL_H__
 #define __DAOS_PIPE_INTERNAL_H__
 
+#include <daos/common.h>
+#include <gurt/heap.h>
 #include <daos_pipeline.h>
 
+#define NTYPES              13
+#define NTYPES_NOSIZE        4
+#define N_FILTER_FUNC_PTRS  53
+#define N_GETD_FUNC_PTRS    39
+
+#define SUBIDX_UINTEGER1  0
+#define SUBIDX_UINTEGER2  1
+#define SUBIDX_UINTEGER4  2
+#define SUBIDX_UINTEGER8  3
+#define SUBIDX_INTEGER1   4
+#define SUBIDX_INTEGER2   5
+#define SUBIDX_INTEGER4   6
+#define SUBIDX_INTEGER8   7
+#define SUBIDX_REAL4      8
+#define SUBIDX_REAL8      9
+#define SUBIDX_BINARY    10
+#define SUBIDX_STRING    11
+#define SUBIDX_CSTRING   12
+
+#define SUBIDX_UINTEGER   0
+#define SUBIDX_INTEGER    1
+#define SUBIDX_DOUBLE     2
+#define SUBIDX_STR        3
+
+#define SUBIDX_FUNC_EQ        0
+#define SUBIDX_FUNC_NE        NTYPES_NOSIZE
+#define SUBIDX_FUNC_LT        (NTYPES_NOSIZE * 2)
+#define SUBIDX_FUNC_LE        (NTYPES_NOSIZE * 3)
+#define SUBIDX_FUNC_GE        (NTYPES_NOSIZE * 4)
+#define SUBIDX_FUNC_GT        (NTYPES_NOSIZE * 5)
+
+#define SUBIDX_FUNC_ADD       (NTYPES_NOSIZE * 6) /** these do not work with strings */
+#define SUBIDX_FUNC_SUB       (SUBIDX_FUNC_ADD + (NTYPES_NOSIZE - 1))
+#define SUBIDX_FUNC_MUL       (SUBIDX_FUNC_ADD + (NTYPES_NOSIZE - 1) * 2)
+#define SUBIDX_FUNC_DIV       (SUBIDX_FUNC_ADD + (NTYPES_NOSIZE - 1) * 3)
+#define SUBIDX_FUNC_SUM       (SUBIDX_FUNC_ADD + (NTYPES_NOSIZE - 1) * 4)
+#define SUBIDX_FUNC_MAX       (SUBIDX_FUNC_ADD + (NTYPES_NOSIZE - 1) * 5)
+#define SUBIDX_FUNC_MIN       (SUBIDX_FUNC_ADD + (NTYPES_NOSIZE - 1) * 6)
+
+#define SUBIDX_FUNC_BITAND    (SUBIDX_FUNC_ADD + (NTYPES_NOSIZE - 1) * 7) /** only works w/ int */
+
+#define SUBIDX_FUNC_LIKE      (SUBIDX_FUNC_BITAND + (NTYPES_NOSIZE - 2))  /** only works w/ str */
+#define SUBIDX_FUNC_ISNULL    (SUBIDX_FUNC_LIKE + 1)/** type is N/A */
+#define SUBIDX_FUNC_ISNOTNULL (SUBIDX_FUNC_LIKE + 2)
+#define SUBIDX_FUNC_NOT       (SUBIDX_FUNC_LIKE + 3)
+#define SUBIDX_FUNC_AND       (SUBIDX_FUNC_LIKE + 4)
+#define SUBIDX_FUNC_OR        (SUBIDX_FUNC_LIKE + 5)
+
+#define SUBIDX_FUNCS_WITH_ONE_TYPE_ONLY SUBIDX_FUNC_LIKE
+
 struct filter_part_run_t {
 	d_iov_t				*dkey;
 	uint32_t			nr_iods;
@@ -41,6 +93,138 @@ struct filter_part_compiled_t {
 struct filter_compiled_t {
 	uint32_t			num_parts;
 	struct filter_part_compiled_t	*parts;
+	struct filter_prog_t		*prog;
+	struct filter_vec_t		*vec;
+	struct filter_adapt_t		*adapt;
+};
+
+/**
+ * Compiled filter programs (see filter_prog.c). The filter tree is flattened into a linear array
+ * of instructions operating on a register file, so a record is evaluated with a single dispatch
+ * loop instead of one indirect call per filter part.
+ */
+
+/** A register holds either a number or a string; \a data == NULL means the value is NULL */
+struct filter_reg_t {
+	union {
+		uint64_t	u;
+		int64_t		i;
+		double		d;
+		bool		b;
+	} v;
+	char			*data;
+	size_t			data_len;
+};
+
+struct filter_insn_t {
+	uint16_t		op;
+	uint16_t		dst;
+	uint16_t		src[2];
+	/** comparisons: number of consecutive registers from src[1] compared against (IN) */
+	uint16_t		src_nr;
+	/** jump target for branches, and for comparisons when one of the operands is NULL */
+	uint32_t		jmp;
+	/** type of data for loads (SUBIDX_UINTEGER1, ...) */
+	uint16_t		type;
+	/** akey loads resolve the index of the iod lazily on first use */
+	int32_t			iod_idx;
+	d_iov_t			*iov;
+	size_t			data_offset;
+	size_t			data_len;
+};
+
+struct filter_prog_t {
+	uint32_t		num_insns;
+	uint32_t		num_regs;
+	struct filter_insn_t	*insns;
+	struct filter_reg_t	*regs;
+};
+
+/**
+ * Vectorized filters (see filter_batch.c). Records are fetched in batches, and the keys used by
+ * vectorized filters are loaded into columns: one typed array per key holding its value for
+ * every record of the batch. Conditions then update a selection map (one byte per record), and
+ * aggregations reduce the selected values of a column.
+ */
+
+/** a dkey or akey loaded into a column */
+struct filter_col_t {
+	/** akey name, NULL for the dkey */
+	d_iov_t			*akey;
+	/** type of data (SUBIDX_UINTEGER1, ...), only numeric types are loaded into columns */
+	uint16_t		type;
+	/** akey iod index, resolved on first use */
+	int32_t			iod_idx;
+	size_t			data_offset;
+	size_t			data_len;
+};
+
+/** comparison between a column and a constant */
+struct filter_vec_pred_t {
+	/** function index (SUBIDX_FUNC_EQ + SUBIDX_UINTEGER, ...) */
+	uint32_t		func_idx;
+	uint32_t		col;
+	union {
+		uint64_t	u;
+		int64_t		i;
+		double		d;
+	} cval;
+};
+
+struct filter_vec_t {
+	/** conditions: predicates all need to be true (AND) */
+	uint32_t			num_preds;
+	struct filter_vec_pred_t	*preds;
+	/** aggregations: function index (SUBIDX_FUNC_SUM + SUBIDX_UINTEGER, ...) and column */
+	uint32_t			aggr_func_idx;
+	uint32_t			aggr_col;
+};
+
+/** records fetched together, with the columns loaded for them */
+struct filter_batch_t {
+	/** max number of records, and number of records fetched */
+	uint32_t		max;
+	uint32_t		nr;
+	uint32_t		nr_iods;
+	/** dkeys are copied as VOS can yield while the batch is being filled */
+	d_iov_t			*dkeys;
+	/** iods and sgls of the akeys, nr_iods per record */
+	daos_iod_t		*iods;
+	d_sg_list_t		*akeys;
+	d_iov_t			*akey_iovs;
+	char			*akey_bufs;
+	/** records selected by the filters evaluated so far */
+	uint8_t			*sel;
+	/** values of the columns, max per column; col_valid is 0 for NULL values */
+	uint32_t		num_cols;
+	uint64_t		*col_vals;
+	uint8_t			*col_valid;
+	bool			*col_loaded;
+	/** location of the values while a column is loaded */
+	char			**ptrs;
+};
+
+/** adaptive ordering of the operands of AND/OR functions (see filter_adapt.c) */
+struct filter_adapt_t {
+	/** copy of the filter, with the operands reordered */
+	daos_filter_t			filter;
+	/** index of each part of \a filter in the original filter, and in the compiled parts */
+	uint32_t			*orig_idx;
+	uint32_t			*comp_idx;
+	/** counters of the parts, by index in the original filter */
+	daos_pipeline_part_stats_t	*stats;
+	/** records per profiled record, and records left before the next profiled one */
+	uint32_t			interval;
+	uint32_t			countdown;
+	/** records profiled since the operands were last ordered */
+	uint32_t			nr_samples;
+};
+
+/** GROUP BY or ORDER BY key expression */
+struct filter_key_t {
+	struct filter_compiled_t	ftr;
+	/** class of the values of the key (SUBIDX_UINTEGER, ...) */
+	uint8_t				cls;
 };
 
 struct pipeline_compiled_t {
@@ -48,6 +232,67 @@ struct pipeline_compiled_t {
 	struct filter_compiled_t	*filters;
 	uint32_t			num_aggr_filters;
 	struct filter_compiled_t	*aggr_filters;
+	/** columns used by vectorized filters */
+	uint32_t			num_cols;
+	struct filter_col_t		*cols;
+	/** optional GROUP BY and ORDER BY keys */
+	struct filter_key_t		*group_by;
+	struct filter_key_t		*order_by;
+};
+
+/** class of a NULL key */
+#define PIPELINE_KEY_NULL	0xff
+
+/**
+ * Value of a GROUP BY or ORDER BY key. The data of string keys is not owned by the key.
+ */
+struct pipeline_key_t {
+	/** SUBIDX_UINTEGER, SUBIDX_INTEGER, SUBIDX_DOUBLE, SUBIDX_STR, or PIPELINE_KEY_NULL */
+	uint8_t		cls;
+	union {
+		uint64_t	u;
+		int64_t		i;
+		double		d;
+	} v;
+	char		*data;
+	uint32_t	len;
+};
+
+/** max number of groups a shard aggregates separately */
+#define PIPELINE_GROUP_MAX	(1 << 16)
+
+/** a group of records with the same GROUP BY key (see filter_group.c) */
+struct pipeline_group_t {
+	d_list_t		pg_link;
+	struct pipeline_key_t	pg_key;
+	/** number of records in the group, and their aggregated values */
+	uint64_t		pg_count;
+	double			*pg_aggr;
+};
+
+struct pipeline_groups_t {
+	struct d_hash_table	pgs_htable;
+	uint32_t		pgs_nr_aggr;
+	uint32_t		pgs_nr;
+	uint32_t		pgs_cap;
+	/** groups in order of creation */
+	struct pipeline_group_t	**pgs_groups;
+};
+
+/** a record kept by ORDER BY, with a copy of its dkey and akeys (see filter_group.c) */
+struct pipeline_topk_rec_t {
+	struct d_binheap_node	tr_node;
+	struct pipeline_key_t	tr_key;
+	d_iov_t			tr_dkey;
+	daos_iod_t		*tr_iods;
+	d_sg_list_t		*tr_akeys;
+};
+
+/** records with the \a k first ORDER BY keys; the root of the heap is the last one kept */
+struct pipeline_topk_t {
+	struct d_binheap	tk_heap;
+	uint32_t		tk_k;
+	uint32_t		tk_nr_iods;
 };
 
 typedef struct {
@@ -64,6 +309,24 @@ void ds_pipeline_run_handler(crt_rpc_t *rpc);
 
 int d_pipeline_check(daos_pipeline_t *pipeline);
 
+int pipeline_pack_value(d_sg_list_t *sgl, uint32_t *iov_idx, d_iov_t *iov);
+
+bool pipeline_order_is_desc(daos_filter_t *ftr);
+
+double pipeline_aggr_init_value(daos_filter_t *ftr);
+
+void pipeline_aggr_merge(daos_filter_t *ftr, double *dst, double src);
+
+bool pipeline_aggr_is_avg(daos_filter_t *ftr);
+
+int pipeline_key_cmp(struct pipeline_key_t *a, struct pipeline_key_t *b);
+
+size_t pipeline_key_size(struct pipeline_key_t *key);
+
+char *pipeline_key_pack(struct pipeline_key_t *key, char *buf);
+
+int pipeline_key_unpack(char **buf, char *end, struct pipeline_key_t *key);
+
 void pipeline_aggregations_init(daos_pipeline_t *pipeline,
 				d_sg_list_t *sgl_agg);
 
@@ -73,6 +336,127 @@ int pipeline_compile(daos_pipeline_t *pipe, struct pipeline_compiled_t *comp_pip
 
 void pipeline_compile_free(struct pipeline_compiled_t *comp_pipe);
 
+int filter_prog_compile(daos_filter_t *filter, struct filter_prog_t **prog);
+
+void filter_prog_free(struct filter_prog_t *prog);
+
+int filter_prog_run(struct filter_prog_t *prog, struct filter_part_run_t *args);
+
+uint32_t calc_type_nosize_idx(uint32_t idx);
+
+uint32_t calc_type_idx(char *type, size_t type_len);
+
+uint32_t calc_filterfunc_idx(daos_filter_part_t **parts, uint32_t idx);
+
+char *getdata_akey_iod(struct filter_part_run_t *args, uint32_t iod_idx, size_t target_offset,
+		       size_t *len);
+
+int filter_like_match(char *left_str, size_t left_size, char *right_str, size_t right_size,
+		      bool *match);
+
+bool logfunc_eq_st(char *l, size_t ll, char *r, size_t rl);
+bool logfunc_ne_st(char *l, size_t ll, char *r, size_t rl);
+bool logfunc_lt_st(char *l, size_t ll, char *r, size_t rl);
+bool logfunc_le_st(char *l, size_t ll, char *r, size_t rl);
+bool logfunc_ge_st(char *l, size_t ll, char *r, size_t rl);
+bool logfunc_gt_st(char *l, size_t ll, char *r, size_t rl);
+
+int32_t getdata_akey_idx(struct filter_part_run_t *args, d_iov_t *akey);
+
+/** when false, filters are evaluated with the filter_func_t tree instead of filter programs */
+extern bool pipeline_prog_enabled;
+
+/** default max number of records fetched and filtered together */
+#define PIPELINE_BATCH_SIZE	256
+/** max size of the record data buffered by a batch */
+#define PIPELINE_BATCH_BYTES	(4 << 20)
+
+/** records fetched per batch, batches and vectorized filters are disabled when it is <= 1 */
+extern unsigned int pipeline_batch_size;
+
+int filter_vec_compile(struct pipeline_compiled_t *comp_pipe, daos_filter_t *filter, bool is_aggr,
+		       struct filter_vec_t **vec);
+
+void filter_vec_free(struct filter_vec_t *vec);
+
+void filter_vec_cond_run(struct pipeline_compiled_t *comp_pipe, struct filter_vec_t *vec,
+			 struct filter_batch_t *batch);
+
+void filter_vec_aggr_run(struct pipeline_compiled_t *comp_pipe, struct filter_vec_t *vec,
+			 struct filter_batch_t *batch, double *aggr);
+
+int filter_batch_alloc(struct pipeline_compiled_t *comp_pipe, daos_iod_t *iods, uint32_t nr_iods,
+		       uint32_t max, struct filter_batch_t *batch);
+
+void filter_batch_free(struct filter_batch_t *batch);
+
+void filter_batch_reset(struct filter_batch_t *batch);
+
+int filter_batch_add(struct filter_batch_t *batch, d_iov_t *dkey);
+
+/** default number of records seen per profiled record when ordering AND/OR operands */
+#define PIPELINE_ADAPT_SAMPLE	16
+/** number of profiled records between two orderings of the AND/OR operands */
+#define PIPELINE_ADAPT_PERIOD	32
+/** max factor by which profiling is slowed down while the order of the operands is stable */
+#define PIPELINE_ADAPT_BACKOFF	64
+
+/** records seen per profiled record, AND/OR operands are never reordered when it is 0 */
+extern unsigned int pipeline_adapt_sample;
+
+int filter_adapt_init(daos_filter_t *filter, struct filter_adapt_t **adapt);
+
+void filter_adapt_free(struct filter_adapt_t *adapt);
+
+int filter_adapt_record(struct filter_compiled_t *comp, struct filter_part_run_t *args);
+
+int filter_adapt_stats(struct pipeline_compiled_t *comp_pipe, daos_pipeline_t *pipe,
+		       daos_pipeline_stats_t *stats);
+
+int filter_recompile(daos_filter_t *filter, struct filter_compiled_t *comp);
+
+int pipeline_key_eval(struct filter_key_t *key, struct filter_part_run_t *args,
+		      struct pipeline_key_t *out);
+
+int pipeline_groups_init(struct pipeline_groups_t *groups, uint32_t nr_aggr);
+
+void pipeline_groups_fini(struct pipeline_groups_t *groups);
+
+int pipeline_groups_find(struct pipeline_groups_t *groups, daos_pipeline_t *pipe,
+			 struct pipeline_key_t *key, struct pipeline_group_t **group);
+
+int pipeline_groups_pack(struct pipeline_groups_t *groups, uint32_t max, d_iov_t *out,
+			 uint32_t *nr_out);
+
+int pipeline_topk_init(struct pipeline_topk_t *topk, uint32_t k, uint32_t nr_iods, bool desc);
+
+void pipeline_topk_fini(struct pipeline_topk_t *topk);
+
+int pipeline_topk_add(struct pipeline_topk_t *topk, struct pipeline_key_t *key, d_iov_t *dkey,
+		      daos_iod_t *iods, d_sg_list_t *akeys);
+
+int pipeline_topk_sort(struct pipeline_topk_t *topk, struct pipeline_topk_rec_t ***recs,
+		       uint32_t *nr);
+
+void pipeline_topk_rec_free(struct pipeline_topk_rec_t *rec);
+
+static inline void
+filter_batch_args(struct filter_batch_t *batch, uint32_t rec, struct filter_part_run_t *args)
+{
+	args->dkey  = &batch->dkeys[rec];
+	args->iods  = &batch->iods[rec * batch->nr_iods];
+	args->akeys = &batch->akeys[rec * batch->nr_iods];
+}
+
+/** size of numeric types, 0 for strings and binary data */
+static inline size_t
+filter_type_size(uint16_t type)
+{
+	static const size_t sizes[] = {1, 2, 4, 8, 1, 2, 4, 8, 4, 8};
+
+	return type <= SUBIDX_REAL8 ? sizes[type] : 0;
+}
+
 typedef uint8_t _uint8_t;
 typedef uint16_t _uint16_t;
 typedef uint32_t _uint32_t;
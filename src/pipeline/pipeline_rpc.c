@@ -164,6 +164,22 @@ exit:
 	return rc;
 }
 
+static int
+pipeline_t_proc_filter(crt_proc_t proc, crt_proc_op_t proc_op, daos_filter_t *filter)
+{
+	int rc;
+
+	rc = crt_proc_d_iov_t(proc, proc_op, &filter->filter_type);
+	if (unlikely(rc))
+		return rc;
+
+	rc = crt_proc_uint32_t(proc, proc_op, &filter->num_parts);
+	if (unlikely(rc))
+		return rc;
+
+	return pipeline_t_proc_parts(proc, proc_op, filter->num_parts, &filter->parts);
+}
+
 static int
 pipeline_t_proc_filters(crt_proc_t proc, crt_proc_op_t proc_op, uint32_t num_filters,
 			daos_filter_t ***filters)
@@ -186,19 +202,7 @@ pipeline_t_proc_filters(crt_proc_t proc, crt_proc_op_t proc_op, uint32_t num_fil
 		}
 		filter = (*filters)[i++];
 
-		rc     = crt_proc_d_iov_t(proc, proc_op, &filter->filter_type);
-		if (unlikely(rc)) {
-			if (DECODING(proc_op))
-				D_GOTO(exit_free, rc);
-			D_GOTO(exit, rc);
-		}
-		rc = crt_proc_uint32_t(proc, proc_op, &filter->num_parts);
-		if (unlikely(rc)) {
-			if (DECODING(proc_op))
-				D_GOTO(exit_free, rc);
-			D_GOTO(exit, rc);
-		}
-		rc = pipeline_t_proc_parts(proc, proc_op, filter->num_parts, &filter->parts);
+		rc     = pipeline_t_proc_filter(proc, proc_op, filter);
 		if (unlikely(rc)) {
 			if (DECODING(proc_op))
 				D_GOTO(exit_free, rc);
@@ -216,6 +220,42 @@ exit:
 	return rc;
 }
 
+/** optional filter (GROUP BY or ORDER BY), preceded by a flag telling whether it is set */
+static int
+pipeline_t_proc_filter_opt(crt_proc_t proc, crt_proc_op_t proc_op, daos_filter_t **filter)
+{
+	uint32_t present = 0;
+	int      rc;
+
+	if (!DECODING(proc_op))
+		present = (*filter != NULL);
+	rc = crt_proc_uint32_t(proc, proc_op, &present);
+	if (unlikely(rc))
+		return rc;
+
+	if (!present) {
+		if (DECODING(proc_op))
+			*filter = NULL;
+		return 0;
+	}
+
+	if (DECODING(proc_op)) {
+		D_ALLOC_PTR(*filter);
+		if (*filter == NULL)
+			return -DER_NOMEM;
+	}
+	rc = pipeline_t_proc_filter(proc, proc_op, *filter);
+	if (unlikely(rc)) {
+		if (DECODING(proc_op))
+			D_FREE(*filter);
+		return rc;
+	}
+	if (FREEING(proc_op))
+		D_FREE(*filter);
+
+	return 0;
+}
+
 static int
 crt_proc_daos_pipeline_t(crt_proc_t proc, crt_proc_op_t proc_op, daos_pipeline_t *pipe)
 {
@@ -241,6 +281,18 @@ crt_proc_daos_pipeline_t(crt_proc_t proc, crt_proc_op_t proc_op, daos_pipeline_t
 	if (unlikely(rc))
 		D_GOTO(exit, rc);
 
+	rc = pipeline_t_proc_filter_opt(proc, proc_op, &pipe->group_by);
+	if (unlikely(rc))
+		D_GOTO(exit, rc);
+
+	rc = pipeline_t_proc_filter_opt(proc, proc_op, &pipe->order_by);
+	if (unlikely(rc))
+		D_GOTO(exit, rc);
+
+	rc = crt_proc_uint64_t(proc, proc_op, &pipe->limit);
+	if (unlikely(rc))
+		D_GOTO(exit, rc);
+
 exit:
 	return rc;
 }
@@ -341,6 +393,30 @@ crt_proc_daos_pipeline_stats_t(crt_proc_t proc, crt_proc_op_t proc_op, daos_pipe
 	if (unlikely(rc))
 		return rc;
 
+	rc = crt_proc_uint32_t(proc, proc_op, &stats->nr_parts);
+	if (unlikely(rc))
+		return rc;
+
+	if (stats->nr_parts == 0)
+		return 0;
+
+	if (DECODING(proc_op)) {
+		D_ALLOC_ARRAY(stats->parts, stats->nr_parts);
+		if (stats->parts == NULL)
+			return -DER_NOMEM;
+	}
+
+	rc = crt_proc_memcpy(proc, proc_op, stats->parts,
+			     stats->nr_parts * sizeof(*stats->parts));
+	if (unlikely(rc)) {
+		if (DECODING(proc_op))
+			D_FREE(stats->parts);
+		return rc;
+	}
+
+	if (FREEING(proc_op))
+		D_FREE(stats->parts);
+
 	return 0;
 }
 
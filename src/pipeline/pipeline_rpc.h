@@ -50,6 +50,11 @@ extern struct crt_proto_format pipeline_proto_fmt;
 	((uint32_t)		(pri_nr_kds)		CRT_VAR)	\
 	((uint32_t)		(pri_pad32)		CRT_VAR)
 
+/**
+ * pro_partials holds the results merged by the client when the pipeline has a GROUP BY filter
+ * (the groups, see pipeline_groups_pack()), or an ORDER BY one (the keys of the returned records,
+ * see pipeline_topk_pack()). pro_nr_trunc is the number of groups left out of pro_partials.
+ */
 #define DAOS_OSEQ_PIPELINE_RUN	/* output fields */			\
 	((daos_size_t)			(pro_recx_size)	CRT_ARRAY)	\
 	((daos_anchor_t)		(pro_anchor)	CRT_RAW)	\
@@ -58,11 +63,12 @@ extern struct crt_proto_format pipeline_proto_fmt;
 	((d_sg_list_t)			(pro_sgl_recx)	CRT_VAR)	\
 	((d_sg_list_t)			(pro_sgl_agg)	CRT_VAR)	\
 	((daos_pipeline_stats_t)	(stats)		CRT_VAR)	\
+	((d_iov_t)			(pro_partials)	CRT_VAR)	\
 	((uint64_t)			(pro_epoch)	CRT_VAR)	\
 	((int32_t)			(pro_ret)	CRT_VAR)	\
 	((uint32_t)			(pro_nr_kds)	CRT_VAR)	\
 	((uint32_t)			(pro_nr_iods)	CRT_VAR)	\
-	((uint32_t)			(pro_pad32)	CRT_VAR)
+	((uint32_t)			(pro_nr_trunc)	CRT_VAR)
 
 CRT_RPC_DECLARE(pipeline_run, DAOS_ISEQ_PIPELINE_RUN, DAOS_OSEQ_PIPELINE_RUN)
 
@@ -42,6 +42,28 @@ dc_pipeline_run_task_create(daos_handle_t coh, daos_handle_t oh, daos_handle_t t
 	args->recx_size    = recx_size;
 	args->sgl_agg      = sgl_agg;
 	args->stats        = stats;
+	args->stream       = NULL;
+
+	return 0;
+}
+
+int
+dc_pipeline_scan_task_create(daos_handle_t coh, daos_handle_t oh, daos_handle_t th,
+			     daos_pipeline_t *pipeline, uint64_t flags, uint32_t *nr_iods,
+			     daos_iod_t *iods, daos_pipeline_stream_t *stream,
+			     d_sg_list_t *sgl_agg, daos_pipeline_stats_t *stats, daos_event_t *ev,
+			     tse_sched_t *tse, tse_task_t **task)
+{
+	daos_pipeline_run_t *args;
+	int                  rc;
+
+	rc = dc_pipeline_run_task_create(coh, oh, th, pipeline, flags, NULL, nr_iods, iods, NULL,
+					 NULL, NULL, NULL, NULL, NULL, sgl_agg, stats, ev, tse, task);
+	if (rc)
+		return rc;
+
+	args         = dc_task_get_args(*task);
+	args->stream = stream;
 
 	return 0;
 }
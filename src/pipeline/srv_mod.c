@@ -13,6 +13,14 @@
 static int
 pipeline_mod_init(void)
 {
+	d_getenv_bool("DAOS_PIPELINE_COMPILED", &pipeline_prog_enabled);
+	D_INFO("Pipeline filters are evaluated by %s\n",
+	       pipeline_prog_enabled ? "compiled programs" : "filter function trees");
+	d_getenv_uint("DAOS_PIPELINE_BATCH_SIZE", &pipeline_batch_size);
+	D_INFO("Pipeline records are fetched in batches of up to %u\n", pipeline_batch_size);
+	d_getenv_uint("DAOS_PIPELINE_ADAPT_SAMPLE", &pipeline_adapt_sample);
+	D_INFO("Pipeline AND/OR operands are %s\n",
+	       pipeline_adapt_sample == 0 ? "not reordered" : "reordered by sampled selectivity");
 	return 0;
 }
 
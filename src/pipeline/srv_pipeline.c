@@ -138,178 +138,334 @@ out:
 	return rc;
 }
 
-static int
-pipeline_aggregations(struct pipeline_compiled_t *pipe, struct filter_part_run_t *args,
-		      d_iov_t *dkey, d_sg_list_t *akeys, d_sg_list_t *sgl_agg)
+/**
+ * Evaluates one compiled filter for the current record, using its filter program if the
+ * pipeline was compiled with programs enabled.
+ */
+static inline int
+pipeline_filter_eval(struct filter_compiled_t *filter, struct filter_part_run_t *args)
 {
-	uint32_t i;
-	int      rc = 0;
+	if (filter->prog != NULL)
+		return filter_prog_run(filter->prog, args);
 
-	args->dkey  = dkey;
-	args->akeys = akeys;
-	for (i = 0; i < pipe->num_aggr_filters; i++) {
-		args->part_idx = 0;
-		args->parts    = pipe->aggr_filters[i].parts;
-		args->iov_aggr = &sgl_agg->sg_iovs[i];
+	args->part_idx = 0;
+	args->parts    = filter->parts;
+	return args->parts[0].filter_func(args);
+}
 
-		rc             = args->parts[0].filter_func(args);
-		if (rc != 0)
-			D_GOTO(exit, rc);
+/**
+ * Checks whether comparison \a pred of key \a col with a constant can be true for any record,
+ * given the range of the values of the key.
+ */
+static bool
+pipeline_summ_pred_maybe(struct vos_obj_summ *summ, struct filter_col_t *col,
+			 struct filter_vec_pred_t *pred)
+{
+	const struct vos_summ_range *range;
+	uint32_t                     cls  = pred->func_idx % NTYPES_NOSIZE;
+	uint32_t                     func = pred->func_idx - cls;
+	char                         buf[8];
+	d_iov_t                      iov;
+	bool                         lt_lo;
+	bool                         gt_hi;
+	bool                         le_lo;
+	bool                         ge_hi;
+	bool                         single;
+
+	range = col->akey == NULL ? &summ->os_dkeys : vos_obj_summ_akey(summ, col->akey);
+	if (range == NULL)
+		return true; /** not summarized */
+	if (range->sr_nr == 0)
+		return false; /** no value: the key is NULL for all the records */
+	if (col->data_offset != 0 || col->data_len != filter_type_size(col->type) ||
+	    range->sr_min_len != col->data_len || range->sr_max_len != col->data_len)
+		return true; /** the values are not the numbers compared */
+
+	switch (cls) {
+	case SUBIDX_UINTEGER:
+		lt_lo  = pred->cval.u < range->sr_min_u;
+		gt_hi  = pred->cval.u > range->sr_max_u;
+		le_lo  = pred->cval.u <= range->sr_min_u;
+		ge_hi  = pred->cval.u >= range->sr_max_u;
+		single = range->sr_min_u == range->sr_max_u;
+		break;
+	case SUBIDX_INTEGER:
+		lt_lo  = pred->cval.i < range->sr_min_i;
+		gt_hi  = pred->cval.i > range->sr_max_i;
+		le_lo  = pred->cval.i <= range->sr_min_i;
+		ge_hi  = pred->cval.i >= range->sr_max_i;
+		single = range->sr_min_i == range->sr_max_i;
+		break;
+	default: /** NaN are not in the range, but NaN != c is true */
+		lt_lo  = pred->cval.d < range->sr_min_d;
+		gt_hi  = pred->cval.d > range->sr_max_d;
+		le_lo  = pred->cval.d <= range->sr_min_d;
+		ge_hi  = pred->cval.d >= range->sr_max_d;
+		single = false;
+		break;
+	}
+
+	switch (func) {
+	case SUBIDX_FUNC_EQ:
+		if (lt_lo || gt_hi)
+			return false;
+		if (col->akey != NULL || cls == SUBIDX_DOUBLE)
+			return true;
+		/** integers have the same bytes as the dkeys they are equal to (not 0.0 and -0.0) */
+		memcpy(buf, &pred->cval, col->data_len);
+		d_iov_set(&iov, buf, col->data_len);
+		return vos_obj_summ_dkey_maybe(summ, &iov);
+	case SUBIDX_FUNC_NE:
+		return !(single && le_lo && !lt_lo);
+	case SUBIDX_FUNC_LT:
+		return !le_lo;
+	case SUBIDX_FUNC_LE:
+		return !lt_lo;
+	case SUBIDX_FUNC_GE:
+		return !gt_hi;
+	default: /** SUBIDX_FUNC_GT */
+		return !ge_hi;
 	}
-exit:
-	return rc;
 }
 
 static int
-pipeline_filters(struct pipeline_compiled_t *pipe, struct filter_part_run_t *args, d_iov_t *dkey,
-		 d_sg_list_t *akeys)
+pipeline_summ_yield(void *arg)
 {
-	uint32_t i;
-	int      rc = 0;
+	struct ds_cont_child *coc = arg;
 
-	args->dkey  = dkey;
-	args->akeys = akeys;
-	for (i = 0; i < pipe->num_filters; i++) {
-		args->part_idx = 0;
-		args->parts    = pipe->filters[i].parts;
+	if (coc->sc_stopping)
+		return -1;
+	dss_sleep(0); /** 0 msec will not sleep, just yield */
+	return 0;
+}
 
-		rc             = args->parts[0].filter_func(args);
-		if (rc != 0)
-			D_GOTO(exit, rc);
-		if (!args->log_out)
-			D_GOTO(exit, rc = 1);
-	}
-exit:
-	return rc;
+struct pipeline_summ_build_arg {
+	struct ds_cont_child *psb_coc;
+	daos_unit_oid_t       psb_oid;
+};
+
+static void
+pipeline_summ_build_ult(void *arg)
+{
+	struct pipeline_summ_build_arg *psb = arg;
+
+	/** failures are logged by VOS, the object is simply not skipped */
+	vos_obj_summ_build(psb->psb_coc->sc_hdl, psb->psb_oid, 0, pipeline_summ_yield,
+			   psb->psb_coc);
+	ds_cont_child_put(psb->psb_coc);
+	D_FREE(psb);
 }
 
-static int
-alloc_iter_bufs(daos_iod_t *iods, uint32_t nr, daos_iod_t **iods_iter, d_sg_list_t **sgl_recx_iter)
+/**
+ * Starts building the summary of the object in a separate ULT, so that the RPC doesn't wait for
+ * the scan of the whole object.
+ */
+static void
+pipeline_summ_build(struct ds_cont_child *coc, daos_unit_oid_t oid)
 {
-	daos_iod_t     *iods_iter_out;
-	d_sg_list_t    *sgl_recx_iter_out  = NULL;
-	d_iov_t        *sgl_recx_iter_iovs = NULL;
-	uint32_t        i;
-	uint32_t        j;
-	size_t          iov_alloc_size;
-	int             rc;
-
-	D_ASSERT(nr != 0);
-	D_ALLOC_ARRAY(sgl_recx_iter_out, nr);
-	if (sgl_recx_iter_out == NULL)
-		return -DER_NOMEM;
-	D_ALLOC_ARRAY(sgl_recx_iter_iovs, nr);
-	if (sgl_recx_iter_iovs == NULL) {
-		D_FREE(sgl_recx_iter_out);
-		return -DER_NOMEM;
-	}
-	D_ALLOC_ARRAY(iods_iter_out, nr);
-	if (iods_iter_out == NULL) {
-		D_FREE(sgl_recx_iter_out);
-		D_FREE(sgl_recx_iter_iovs);
-		return -DER_NOMEM;
-	}
-
-	memcpy(iods_iter_out, iods, sizeof(*iods) * nr);
+	struct pipeline_summ_build_arg *psb;
+	int                             rc;
 
-	for (i = 0; i < nr; i++) {
-		iov_alloc_size = 0;
-		if (iods[i].iod_type == DAOS_IOD_ARRAY) {
-			for (j = 0; j < iods[i].iod_nr; j++)
-				iov_alloc_size += iods[i].iod_recxs[j].rx_nr;
-			iov_alloc_size *= iods[i].iod_size;
-		} else {
-			iov_alloc_size = iods[i].iod_size;
-		}
-		D_ALLOC(sgl_recx_iter_iovs[i].iov_buf, iov_alloc_size);
-		if (sgl_recx_iter_iovs[i].iov_buf == NULL)
-			D_GOTO(error, rc = -DER_NOMEM);
-		sgl_recx_iter_iovs[i].iov_buf_len = iov_alloc_size;
+	D_ALLOC_PTR(psb);
+	if (psb == NULL)
+		return;
 
-		sgl_recx_iter_out[i].sg_nr     = 1;
-		sgl_recx_iter_out[i].sg_nr_out = 0;
-		sgl_recx_iter_out[i].sg_iovs   = &sgl_recx_iter_iovs[i];
+	ds_cont_child_get(coc);
+	psb->psb_coc = coc;
+	psb->psb_oid = oid;
+	rc           = dss_ult_create(pipeline_summ_build_ult, psb, DSS_XS_SELF, 0, 0, NULL);
+	if (rc != 0) {
+		DL_WARN(rc, DF_UOID " failed to start summary build", DP_UOID(oid));
+		ds_cont_child_put(coc);
+		D_FREE(psb);
+	}
+}
+
+/**
+ * Checks, with the summary of the object, whether any record of the object can pass the
+ * conditions. Only the vectorized conditions compiled with the pipeline, made of comparisons
+ * between a key and a constant joined by AND, are checked; the others are assumed to pass. An
+ * object whose summary isn't built yet may always match.
+ */
+static int
+pipeline_summ_maybe(struct ds_cont_child *coc, daos_unit_oid_t oid,
+		    struct pipeline_compiled_t *comp_pipe, bool *maybe)
+{
+	struct filter_vec_t *vec;
+	struct vos_obj_summ  summ;
+	uint32_t             i;
+	uint32_t             p;
+	int                  rc;
+
+	*maybe = true;
+	for (i = 0; i < comp_pipe->num_filters; i++) {
+		if (comp_pipe->filters[i].vec != NULL)
+			break;
+	}
+	if (i == comp_pipe->num_filters)
+		return 0; /** no condition can be checked */
+
+	rc = vos_obj_summ_get(coc->sc_hdl, oid, &summ);
+	switch (rc) {
+	case 0:
+		break;
+	case -DER_NONEXIST:
+		*maybe = false;
+		return 0;
+	case -DER_AGAIN:
+		pipeline_summ_build(coc, oid);
+		return 0;
+	case -DER_INPROGRESS:
+		return 0;
+	default:
+		return rc;
 	}
 
-	*iods_iter     = iods_iter_out;
-	*sgl_recx_iter = sgl_recx_iter_out;
+	for (i = 0; i < comp_pipe->num_filters && *maybe; i++) {
+		vec = comp_pipe->filters[i].vec;
+		if (vec == NULL)
+			continue;
+		for (p = 0; p < vec->num_preds && *maybe; p++)
+			*maybe = pipeline_summ_pred_maybe(&summ, &comp_pipe->cols[vec->preds[p].col],
+							  &vec->preds[p]);
+	}
 	return 0;
-error:
-	if (iods_iter_out != NULL)
-		D_FREE(iods_iter_out);
-	for (j = 0; j < i; j++)
-		D_FREE(sgl_recx_iter_iovs[j].iov_buf);
-	if (sgl_recx_iter_iovs != NULL)
-		D_FREE(sgl_recx_iter_iovs);
-	if (sgl_recx_iter_out != NULL)
-		D_FREE(sgl_recx_iter_out);
-	return rc;
 }
 
-static void
-free_iter_bufs(uint32_t nr, daos_iod_t *iods_iter, d_sg_list_t *sgl_recx_iter)
+/**
+ * Fetches up to \a max records into \a batch.
+ */
+static int
+pipeline_fetch_batch(daos_handle_t vos_coh, daos_unit_oid_t oid, struct vos_iter_anchors *anchors,
+		     daos_epoch_range_t epr, uint32_t max, struct filter_batch_t *batch,
+		     struct enum_credits *credits, daos_pipeline_stats_t *stats)
 {
-	uint32_t i;
+	d_iov_t  d_key;
+	uint32_t idx;
+	int      rc;
 
-	if (sgl_recx_iter != NULL) {
-		for (i = 0; i < nr; i++) {
-			if (sgl_recx_iter[i].sg_iovs != NULL &&
-			    sgl_recx_iter[i].sg_iovs->iov_buf != NULL)
-				D_FREE(sgl_recx_iter[i].sg_iovs->iov_buf);
+	filter_batch_reset(batch);
+	while (batch->nr < max && !daos_anchor_is_eof(&anchors->ia_dkey)) {
+		idx = batch->nr * batch->nr_iods;
+		rc  = pipeline_fetch_record(vos_coh, oid, anchors, epr, &batch->iods[idx],
+					    batch->nr_iods, &d_key, &batch->akeys[idx]);
+		if (rc < 0)
+			return rc; /** error */
+		if (rc == 1)
+			continue; /** nothing returned; no more records? */
+
+		rc = filter_batch_add(batch, &d_key);
+		if (rc != 0)
+			return rc;
+
+		stats->nr_dkeys += 1; /** new record considered for filtering */
+
+		credits->used++;
+		if (credits->used > credits->max) {
+			/** we have used all the credit. Yielding... */
+			credits->used = 0;
+			dss_sleep(0); /** 0 msec will not sleep, just yield */
 		}
-		if (sgl_recx_iter[0].sg_iovs != NULL)
-			D_FREE(sgl_recx_iter[0].sg_iovs);
-		D_FREE(sgl_recx_iter);
 	}
-	if (iods_iter != NULL)
-		D_FREE(iods_iter);
+	return 0;
 }
 
 static int
-pack_value(d_sg_list_t *sgl, uint32_t *iov_idx, d_iov_t *iov)
+pipeline_aggregations(struct pipeline_compiled_t *pipe, struct filter_part_run_t *args,
+		      struct filter_batch_t *batch, d_sg_list_t *sgl_agg)
 {
-	uint32_t      iov_idx_bk = *iov_idx;
-	d_iov_t      *out_iov    = &sgl->sg_iovs[*iov_idx];
-	char         *ptr;
+	uint32_t i;
+	uint32_t r;
+	int      rc = 0;
 
-try_out_iov:
-	if (iov->iov_len + out_iov->iov_len > out_iov->iov_buf_len) {
-		if (iov_idx_bk > *iov_idx || (iov_idx_bk == *iov_idx && !out_iov->iov_len)) {
-			/**
-			 * If we can't still copy the input iov in an empty out_iov, then the
-			 * out_iov is way too small. No empty iovs are skipped in the sgl.
-			 */
-			D_ERROR("iov has no space available for data value\n");
-			return -DER_REC2BIG;
+	for (i = 0; i < pipe->num_aggr_filters; i++) {
+		if (pipe->aggr_filters[i].vec != NULL) {
+			filter_vec_aggr_run(pipe, pipe->aggr_filters[i].vec, batch,
+					    (double *)sgl_agg->sg_iovs[i].iov_buf);
+			continue;
 		}
-		/**
-		 * No space left in current out_iov to copy the iov, and data values are never split
-		 * among different iovs. Trying one more time with the next iov in the sgl.
-		 */
-		iov_idx_bk++;
-		if (iov_idx_bk == sgl->sg_nr) {
-			D_ERROR("Consumed all iovs in the sgl, no space available for the rest of "
-				"the data\n");
-			return -DER_REC2BIG;
+
+		args->iov_aggr = &sgl_agg->sg_iovs[i];
+		for (r = 0; r < batch->nr; r++) {
+			if (!batch->sel[r])
+				continue;
+			filter_batch_args(batch, r, args);
+			rc = pipeline_filter_eval(&pipe->aggr_filters[i], args);
+			if (rc != 0)
+				D_GOTO(exit, rc);
 		}
-		out_iov = &sgl->sg_iovs[iov_idx_bk];
-		goto try_out_iov;
 	}
-	*iov_idx = iov_idx_bk;
+exit:
+	return rc;
+}
 
-	ptr               = out_iov->iov_buf;
-	ptr              += out_iov->iov_len;
-	memcpy(ptr, iov->iov_buf, iov->iov_len);
+/**
+ * Selects the records of \a batch passing all the filters. Vectorized filters are evaluated
+ * first, so the other ones only run for the records that passed them.
+ */
+static int
+pipeline_filters(struct pipeline_compiled_t *pipe, struct filter_part_run_t *args,
+		 struct filter_batch_t *batch)
+{
+	uint32_t i;
+	uint32_t r;
+	int      rc = 0;
 
-	out_iov->iov_len += iov->iov_len;
-	if (out_iov->iov_len == iov->iov_len) {
-		/**
-		 * out_iov was a fresh new iov, so we need to increase the number of valid output
-		 * iovs in the sgl.
-		 */
-		sgl->sg_nr_out++;
+	memset(batch->sel, 1, batch->nr);
+	for (i = 0; i < pipe->num_filters; i++) {
+		if (pipe->filters[i].vec != NULL)
+			filter_vec_cond_run(pipe, pipe->filters[i].vec, batch);
 	}
+	for (i = 0; i < pipe->num_filters; i++) {
+		if (pipe->filters[i].vec != NULL)
+			continue;
+		for (r = 0; r < batch->nr; r++) {
+			if (!batch->sel[r])
+				continue;
+			filter_batch_args(batch, r, args);
+			rc = pipeline_filter_eval(&pipe->filters[i], args);
+			if (rc != 0)
+				D_GOTO(exit, rc);
+			batch->sel[r] = args->log_out;
+			if (pipe->filters[i].adapt != NULL) {
+				rc = filter_adapt_record(&pipe->filters[i], args);
+				if (rc != 0)
+					D_GOTO(exit, rc);
+			}
+		}
+	}
+exit:
+	return rc;
+}
+
+/**
+ * Aggregates the current record into its group.
+ */
+static int
+pipeline_group_record(struct pipeline_compiled_t *pipe, daos_pipeline_t *pipeline,
+		      struct pipeline_groups_t *groups, struct filter_part_run_t *args)
+{
+	struct pipeline_group_t *group;
+	struct pipeline_key_t    key;
+	d_iov_t                  iov_aggr;
+	uint32_t                 i;
+	int                      rc;
+
+	rc = pipeline_key_eval(pipe->group_by, args, &key);
+	if (rc != 0)
+		return rc;
+	rc = pipeline_groups_find(groups, pipeline, &key, &group);
+	if (rc != 0)
+		return rc;
 
+	group->pg_count++;
+	for (i = 0; i < pipe->num_aggr_filters; i++) {
+		d_iov_set(&iov_aggr, &group->pg_aggr[i], sizeof(double));
+		args->iov_aggr = &iov_aggr;
+		rc = pipeline_filter_eval(&pipe->aggr_filters[i], args);
+		if (rc != 0)
+			return rc;
+	}
 	return 0;
 }
 
@@ -326,7 +482,7 @@ pack_record(d_iov_t *d_key_iter, daos_iod_t *iods_iter, d_sg_list_t *sgl_recx_it
 	 * dkey
 	 */
 	idx = pack_args->keys_iov_idx;
-	rc  = pack_value(pack_args->keys, &idx, d_key_iter);
+	rc  = pipeline_pack_value(pack_args->keys, &idx, d_key_iter);
 	if (rc != 0)
 		return rc;
 	pack_args->keys_iov_idx             = idx;
@@ -337,7 +493,7 @@ pack_record(d_iov_t *d_key_iter, daos_iod_t *iods_iter, d_sg_list_t *sgl_recx_it
 	 */
 	idx = pack_args->recx_iov_idx;
 	for (i = 0; i < nr_iods; i++) {
-		rc = pack_value(pack_args->recx, &idx, sgl_recx_iter[i].sg_iovs);
+		rc = pipeline_pack_value(pack_args->recx, &idx, sgl_recx_iter[i].sg_iovs);
 		if (rc != 0)
 			return rc;
 
@@ -348,20 +504,86 @@ pack_record(d_iov_t *d_key_iter, daos_iod_t *iods_iter, d_sg_list_t *sgl_recx_it
 	return 0;
 }
 
+/**
+ * Returns the records kept by ORDER BY, in order. The key of each record, followed by the length
+ * of the data of each of its akeys, is packed into \a partials, so the client can merge the
+ * records returned by all the shards.
+ */
+static int
+pipeline_topk_pack(struct pipeline_topk_t *topk, struct pack_ret_data_args *pack_args,
+		   d_iov_t *partials, uint32_t *nr_out)
+{
+	struct pipeline_topk_rec_t **recs;
+	struct pipeline_topk_rec_t  *rec;
+	uint32_t                     nr;
+	uint32_t                     i;
+	uint32_t                     j;
+	uint64_t                     len;
+	size_t                       size = 0;
+	char                        *buf  = NULL;
+	char                        *ptr;
+	int                          rc;
+
+	*nr_out = 0;
+	rc      = pipeline_topk_sort(topk, &recs, &nr);
+	if (rc != 0 || nr == 0)
+		return rc;
+
+	for (i = 0; i < nr; i++)
+		size += pipeline_key_size(&recs[i]->tr_key);
+	size += nr * pack_args->nr_iods * sizeof(uint64_t);
+	D_ALLOC(buf, size);
+	if (buf == NULL)
+		D_GOTO(out, rc = -DER_NOMEM);
+
+	ptr = buf;
+	for (i = 0; i < nr; i++) {
+		rec = recs[i];
+		rc  = pack_record(&rec->tr_dkey, rec->tr_iods, rec->tr_akeys, i, pack_args);
+		if (rc != 0)
+			D_GOTO(out, rc);
+
+		ptr = pipeline_key_pack(&rec->tr_key, ptr);
+		for (j = 0; j < pack_args->nr_iods; j++) {
+			len = rec->tr_akeys[j].sg_iovs->iov_len;
+			memcpy(ptr, &len, sizeof(len));
+			ptr += sizeof(len);
+		}
+	}
+	d_iov_set(partials, buf, size);
+	*nr_out = nr;
+out:
+	if (rc != 0)
+		D_FREE(buf);
+	for (i = 0; i < nr; i++)
+		pipeline_topk_rec_free(recs[i]);
+	D_FREE(recs);
+	return rc;
+}
+
 /** TODO: This code still assumes dkey==NULL. The code for dkey!=NULL has to be written */
 static int
-ds_pipeline_run(daos_handle_t vos_coh, daos_unit_oid_t oid, daos_pipeline_t pipeline,
+ds_pipeline_run(struct ds_cont_child *coc, daos_unit_oid_t oid, daos_pipeline_t pipeline,
 		daos_epoch_range_t epr, uint64_t flags, daos_key_t *dkey, uint32_t nr_iods,
 		uint32_t *nr_iods_out, daos_iod_t *iods, daos_anchor_t *anchor, uint32_t nr_kds,
 		uint32_t *nr_kds_out, daos_key_desc_t *kds, daos_size_t *recx_size,
 		d_sg_list_t *sgl_keys, d_sg_list_t *sgl_recx, d_sg_list_t *sgl_agg,
-		daos_pipeline_stats_t *stats)
+		daos_pipeline_stats_t *stats, d_iov_t *partials, uint32_t *nr_trunc)
 {
+	daos_handle_t               vos_coh = coc->sc_hdl;
 	int                         rc;
 	uint32_t                    nr_kds_pass;
-	d_iov_t                     d_key_iter;
-	d_sg_list_t                *sgl_recx_iter      = NULL;
-	daos_iod_t                 *iods_iter          = NULL;
+	uint32_t                    batch_max;
+	uint32_t                    max;
+	uint32_t                    i;
+	bool                        scan_all;
+	bool                        maybe;
+	struct pipeline_key_t       key;
+	struct pipeline_groups_t    groups             = {0};
+	struct pipeline_topk_t      topk               = {0};
+	bool                        groups_inited      = false;
+	bool                        topk_inited        = false;
+	struct filter_batch_t       batch              = {0};
 	struct enum_credits         credits            = {0};
 	struct vos_iter_anchors     anchors            = {0};
 	struct pipeline_compiled_t  pipeline_compiled  = {0};
@@ -373,7 +595,7 @@ ds_pipeline_run(daos_handle_t vos_coh, daos_unit_oid_t oid, daos_pipeline_t pipe
 	rc           = d_pipeline_check(&pipeline);
 	if (rc != 0)
 		D_GOTO(exit, rc); /** bad pipeline */
-	if (pipeline.version != 1)
+	if (pipeline.version != 2)
 		D_GOTO(exit, rc = -DER_MISMATCH); /** wrong version */
 	if (daos_anchor_is_eof(anchor))
 		D_GOTO(exit, rc = 0); /** no more rows */
@@ -392,16 +614,21 @@ ds_pipeline_run(daos_handle_t vos_coh, daos_unit_oid_t oid, daos_pipeline_t pipe
 	if (rc != 0)
 		D_GOTO(exit, rc); /** compilation failed. Bad pipeline? */
 
-	/** -- allocating space for temporary bufs */
+	/**
+	 * -- allocating space for temporary bufs. Records are fetched in batches only when some
+	 *    filters are vectorized.
+	 */
 
-	rc = alloc_iter_bufs(iods, nr_iods, &iods_iter, &sgl_recx_iter);
+	batch_max = 1;
+	if (pipeline_compiled.num_cols > 0)
+		batch_max = pipeline_batch_size;
+	rc = filter_batch_alloc(&pipeline_compiled, iods, nr_iods, batch_max, &batch);
 	if (rc != 0)
 		D_GOTO(exit, rc);
 
 	/** -- init pipe run data struct and pack result data struct */
 
 	pipe_run_args.nr_iods  = nr_iods;
-	pipe_run_args.iods     = iods_iter;
 
 	pack_args.recx_size    = recx_size;
 	pack_args.nr_iods      = nr_iods;
@@ -411,6 +638,26 @@ ds_pipeline_run(daos_handle_t vos_coh, daos_unit_oid_t oid, daos_pipeline_t pipe
 	pack_args.keys_iov_idx = 0;
 	pack_args.recx_iov_idx = 0;
 
+	/**
+	 * -- GROUP BY aggregates records by group, and ORDER BY keeps the nr_kds records with the
+	 *    first keys. Both, and aggregations, have to scan all the records of the shard.
+	 */
+
+	if (pipeline.group_by != NULL) {
+		rc = pipeline_groups_init(&groups, pipeline.num_aggr_filters);
+		if (rc != 0)
+			D_GOTO(exit, rc);
+		groups_inited = true;
+	}
+	if (pipeline.order_by != NULL) {
+		rc = pipeline_topk_init(&topk, nr_kds, nr_iods,
+					pipeline_order_is_desc(pipeline.order_by));
+		if (rc != 0)
+			D_GOTO(exit, rc);
+		topk_inited = true;
+	}
+	scan_all = pipeline.num_aggr_filters > 0 || pipeline.order_by != NULL;
+
 	/**
 	 *  -- Iterating over dkeys and doing filtering and aggregation. The variable nr_kds_pass
 	 *     stores the number of dkeys in total that pass the filter.
@@ -420,64 +667,96 @@ ds_pipeline_run(daos_handle_t vos_coh, daos_unit_oid_t oid, daos_pipeline_t pipe
 	anchors.ia_dkey = *anchor;
 	credits.max     = PIPELINE_ITERATION_MAX;
 
+	/** -- objects where no record can pass the filters are not scanned */
+
+	rc = pipeline_summ_maybe(coc, oid, &pipeline_compiled, &maybe);
+	if (rc != 0)
+		D_GOTO(exit, rc);
+	if (!maybe)
+		daos_anchor_set_eof(&anchors.ia_dkey);
+
 	while (!daos_anchor_is_eof(&anchors.ia_dkey)) {
-		if (pipeline.num_aggr_filters == 0 && nr_kds_pass == nr_kds)
+		if (!scan_all && nr_kds_pass == nr_kds)
 			break; /** all records read */
 
-		/** -- fetching record */
+		/**
+		 * -- fetching records. Without aggregations, no more records than needed are
+		 *    fetched, as the anchor must not go past records that are not returned.
+		 */
 
-		rc = pipeline_fetch_record(vos_coh, oid, &anchors, epr, iods_iter, nr_iods,
-					   &d_key_iter, sgl_recx_iter);
+		max = batch.max;
+		if (!scan_all)
+			max = min(max, nr_kds - nr_kds_pass);
+		rc = pipeline_fetch_batch(vos_coh, oid, &anchors, epr, max, &batch, &credits,
+					  stats);
 		if (rc < 0)
 			D_GOTO(exit, rc); /** error */
-		if (rc == 1)
-			continue; /** nothing returned; no more records? */
-
-		stats->nr_dkeys += 1; /** new record considered for filtering */
-
-		credits.used++;
-		if (credits.used > credits.max) {
-			/** we have used all the credit. Yielding... */
-			credits.used = 0;
-			dss_sleep(0); /** 0 msec will not sleep, just yield */
-		}
+		if (batch.nr == 0)
+			continue;
 
 		/** -- doing filtering... */
 
-		rc = pipeline_filters(&pipeline_compiled, &pipe_run_args, &d_key_iter,
-				      sgl_recx_iter);
+		rc = pipeline_filters(&pipeline_compiled, &pipe_run_args, &batch);
 		if (rc < 0)
 			D_GOTO(exit, rc); /** error */
-		if (rc == 1)
-			continue; /** record does not pass filters */
-
-		/** -- dkey+akey pass filters */
 
-		nr_kds_pass++;
+		/** -- aggregations, grouped ones are done per record below */
 
-		/** -- aggregations */
+		if (pipeline.group_by == NULL) {
+			rc = pipeline_aggregations(&pipeline_compiled, &pipe_run_args, &batch,
+						   sgl_agg);
+			if (rc < 0)
+				D_GOTO(exit, rc);
+		}
 
-		rc = pipeline_aggregations(&pipeline_compiled, &pipe_run_args, &d_key_iter,
-					   sgl_recx_iter, sgl_agg);
-		if (rc < 0)
-			D_GOTO(exit, rc);
+		for (i = 0; i < batch.nr; i++) {
+			if (!batch.sel[i])
+				continue; /** record does not pass filters */
+
+			/** -- dkey+akey pass filters */
+
+			nr_kds_pass++;
+
+			if (pipeline.group_by != NULL) {
+				filter_batch_args(&batch, i, &pipe_run_args);
+				rc = pipeline_group_record(&pipeline_compiled, &pipeline, &groups,
+							   &pipe_run_args);
+				if (rc != 0)
+					D_GOTO(exit, rc);
+				continue; /** groups are returned instead of records */
+			}
+			if (pipeline.order_by != NULL) {
+				filter_batch_args(&batch, i, &pipe_run_args);
+				rc = pipeline_key_eval(pipeline_compiled.order_by, &pipe_run_args,
+						       &key);
+				if (rc != 0)
+					D_GOTO(exit, rc);
+				rc = pipeline_topk_add(&topk, &key, &batch.dkeys[i],
+						       &batch.iods[i * nr_iods],
+						       &batch.akeys[i * nr_iods]);
+				if (rc != 0)
+					D_GOTO(exit, rc);
+				continue; /** records are returned in order once all are read */
+			}
 
-		/**
-		 * -- Returning matching records. We don't need to return all matching records if
-		 *    aggregation is being performed: at most one is returned.
-		 */
+			/**
+			 * -- Returning matching records. We don't need to return all matching
+			 *    records if aggregation is being performed: at most one is returned.
+			 */
 
-		if (nr_kds == 0 || (nr_kds > 0 && pipeline.num_aggr_filters > 0 && nr_kds_pass > 1))
-			continue;
+			if (nr_kds == 0 ||
+			    (nr_kds > 0 && pipeline.num_aggr_filters > 0 && nr_kds_pass > 1))
+				continue;
 
-		/**
-		 * -- Saving record info to be returned.
-		 */
+			/**
+			 * -- Saving record info to be returned.
+			 */
 
-		rc = pack_record(&d_key_iter, iods_iter, sgl_recx_iter, nr_kds_pass - 1,
-				 &pack_args);
-		if (rc != 0)
-			D_GOTO(exit, rc);
+			rc = pack_record(&batch.dkeys[i], &batch.iods[i * nr_iods],
+					 &batch.akeys[i * nr_iods], nr_kds_pass - 1, &pack_args);
+			if (rc != 0)
+				D_GOTO(exit, rc);
+		}
 	}
 
 	/**
@@ -485,7 +764,7 @@ ds_pipeline_run(daos_handle_t vos_coh, daos_unit_oid_t oid, daos_pipeline_t pipe
 	 *    filters
 	 */
 
-	if (nr_kds_pass > 0)
+	if (nr_kds_pass > 0 && pipeline.group_by == NULL)
 		pipeline_aggregations_fixavgs(&pipeline, (double)nr_kds_pass, sgl_agg);
 
 	/** -- backing up anchor */
@@ -494,7 +773,19 @@ ds_pipeline_run(daos_handle_t vos_coh, daos_unit_oid_t oid, daos_pipeline_t pipe
 
 	/** -- kds and recx returned */
 
-	if (nr_kds > 0 && pipeline.num_aggr_filters == 0) {
+	if (pipeline.group_by != NULL) {
+		rc = pipeline_groups_pack(&groups, nr_kds, partials, &i);
+		if (rc != 0)
+			D_GOTO(exit, rc);
+		*nr_trunc    = groups.pgs_nr - i;
+		*nr_kds_out  = 0;
+		*nr_iods_out = 0;
+	} else if (pipeline.order_by != NULL) {
+		rc = pipeline_topk_pack(&topk, &pack_args, partials, nr_kds_out);
+		if (rc != 0)
+			D_GOTO(exit, rc);
+		*nr_iods_out = nr_iods * *nr_kds_out;
+	} else if (nr_kds > 0 && pipeline.num_aggr_filters == 0) {
 		*nr_kds_out     = nr_kds_pass;
 		*nr_iods_out    = nr_iods * nr_kds_pass;
 	} else if (nr_kds > 0 && pipeline.num_aggr_filters > 0 && nr_kds_pass > 0) {
@@ -505,10 +796,16 @@ ds_pipeline_run(daos_handle_t vos_coh, daos_unit_oid_t oid, daos_pipeline_t pipe
 		*nr_iods_out    = 0;
 	}
 
-	rc = 0;
+	/** -- counters of the filter parts */
+
+	rc = filter_adapt_stats(&pipeline_compiled, &pipeline, stats);
 exit:
+	if (groups_inited)
+		pipeline_groups_fini(&groups);
+	if (topk_inited)
+		pipeline_topk_fini(&topk);
 	pipeline_compile_free(&pipeline_compiled);
-	free_iter_bufs(nr_iods, iods_iter, sgl_recx_iter);
+	filter_batch_free(&batch);
 
 	return rc;
 }
@@ -797,12 +1094,13 @@ ds_pipeline_run_handler(crt_rpc_t *rpc)
 	int                      rc;
 	struct ds_cont_hdl      *coh;
 	struct ds_cont_child    *coc         = NULL;
-	daos_handle_t            vos_coh;
 	daos_key_desc_t         *kds         = NULL;
 	daos_size_t             *recx_size   = NULL;
 	uint32_t                 nr_kds_out  = 0;
 	uint32_t                 nr_iods_out = 0;
 	daos_pipeline_stats_t    stats       = {0};
+	d_iov_t                  partials    = {0};
+	uint32_t                 nr_trunc    = 0;
 
 	pri = crt_req_get(rpc);
 	D_ASSERT(pri != NULL);
@@ -816,8 +1114,7 @@ ds_pipeline_run_handler(crt_rpc_t *rpc)
 	if (rc != 0)
 		D_GOTO(exit, rc);
 
-	coc     = coh->sch_cont;
-	vos_coh = coc->sc_hdl;
+	coc = coh->sch_cont;
 
 	/** --  */
 
@@ -840,10 +1137,11 @@ ds_pipeline_run_handler(crt_rpc_t *rpc)
 
 	/** -- calling pipeline run */
 
-	rc = ds_pipeline_run(vos_coh, pri->pri_oid, pri->pri_pipe, pri->pri_epr, pri->pri_flags,
+	rc = ds_pipeline_run(coc, pri->pri_oid, pri->pri_pipe, pri->pri_epr, pri->pri_flags,
 			     &pri->pri_dkey, pri->pri_iods.nr, &nr_iods_out, pri->pri_iods.iods,
 			     &pri->pri_anchor, pri->pri_nr_kds, &nr_kds_out, kds, recx_size,
-			     &pri->pri_sgl_keys, &pri->pri_sgl_recx, &pri->pri_sgl_agg, &stats);
+			     &pri->pri_sgl_keys, &pri->pri_sgl_recx, &pri->pri_sgl_agg, &stats,
+			     &partials, &nr_trunc);
 
 exit0:
 	ds_cont_hdl_put(coh);
@@ -867,6 +1165,8 @@ exit:
 		pro->pro_sgl_recx          = pri->pri_sgl_recx;
 		pro->pro_sgl_agg           = pri->pri_sgl_agg;
 		pro->stats                 = stats;
+		pro->pro_partials          = partials;
+		pro->pro_nr_trunc          = nr_trunc;
 		pro->pro_nr_kds            = nr_kds_out;
 
 		/** TODO: for dkey!=NULL, this will be nr_iods_out */
@@ -893,6 +1193,8 @@ exit:
 	/** free memory after sending RPC */
 	D_FREE(kds);
 	D_FREE(recx_size);
+	D_FREE(stats.parts);
+	D_FREE(partials.iov_buf);
 	d_sgl_fini(&pri->pri_sgl_keys, true);
 	d_sgl_fini(&pri->pri_sgl_recx, true);
 	d_sgl_fini(&pri->pri_sgl_agg, true);
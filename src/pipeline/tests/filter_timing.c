@@ -0,0 +1,876 @@
+/**
+ * (C) Copyright 2026 Hewlett Packard Enterprise Development LP
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+/**
+ * Microbenchmark comparing the evaluators of pipeline filters: the tree of filter_func_t parts,
+ * filter programs (filter_prog.c), for filters that can be vectorized, batches of records
+ * (filter_batch.c) and, for filters with AND/OR, programs with adaptive operand ordering
+ * (filter_adapt.c). Records are generated in memory, so only the cost of evaluating filters is
+ * measured. All evaluators must return the same result for every record, otherwise the benchmark
+ * fails.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include <math.h>
+
+#include <daos/common.h>
+#include "../pipeline_internal.h"
+
+#define NR_AKEYS	4
+#define AKEY_STR_LEN	16
+#define NR_IN_CONSTS	16
+
+static bool verbose;
+
+/** one generated record: a dkey and the values of NR_AKEYS akeys */
+struct timing_rec {
+	uint64_t	dkey;
+	uint32_t	a;
+	int64_t		b;
+	char		c[AKEY_STR_LEN];
+	double		d;
+};
+
+static char *akey_names[NR_AKEYS] = {"a", "b", "c", "d"};
+
+/** filter parts are kept in a pool so that filters can be built with a few helper calls */
+#define MAX_PARTS	64
+
+struct timing_filter {
+	const char		*name;
+	daos_filter_t		 filter;
+	daos_filter_part_t	*parts[MAX_PARTS];
+};
+
+static daos_filter_part_t part_pool[1024];
+static uint32_t           part_pool_idx;
+static d_iov_t            const_pool[1024];
+static uint32_t           const_pool_idx;
+static uint64_t           const_vals[1024];
+
+static daos_filter_part_t *
+part_add(struct timing_filter *tf, const char *part_type, const char *data_type,
+	 uint32_t num_operands)
+{
+	daos_filter_part_t *part = &part_pool[part_pool_idx++];
+
+	*part = (daos_filter_part_t){0};
+	d_iov_set(&part->part_type, (void *)part_type, strlen(part_type));
+	if (data_type != NULL)
+		d_iov_set(&part->data_type, (void *)data_type, strlen(data_type));
+	part->num_operands                        = num_operands;
+	tf->parts[tf->filter.num_parts++]         = part;
+	return part;
+}
+
+static void
+func_add(struct timing_filter *tf, const char *func, uint32_t num_operands)
+{
+	part_add(tf, func, NULL, num_operands);
+}
+
+static void
+akey_add(struct timing_filter *tf, const char *data_type, const char *akey, size_t len)
+{
+	daos_filter_part_t *part = part_add(tf, "DAOS_FILTER_AKEY", data_type, 0);
+
+	d_iov_set(&part->akey, (void *)akey, strlen(akey));
+	part->data_len = len;
+}
+
+static void
+dkey_add(struct timing_filter *tf, const char *data_type, size_t len)
+{
+	daos_filter_part_t *part = part_add(tf, "DAOS_FILTER_DKEY", data_type, 0);
+
+	part->data_len = len;
+}
+
+static void
+consts_add(struct timing_filter *tf, const char *data_type, uint64_t *vals, size_t nr,
+	   size_t size)
+{
+	daos_filter_part_t *part = part_add(tf, "DAOS_FILTER_CONST", data_type, 0);
+	size_t              i;
+
+	part->num_constants = nr;
+	part->constant      = &const_pool[const_pool_idx];
+	for (i = 0; i < nr; i++) {
+		const_vals[const_pool_idx] = vals[i];
+		d_iov_set(&const_pool[const_pool_idx], &const_vals[const_pool_idx], size);
+		const_pool_idx++;
+	}
+}
+
+static void
+const_add(struct timing_filter *tf, const char *data_type, uint64_t val, size_t size)
+{
+	consts_add(tf, data_type, &val, 1, size);
+}
+
+static void
+const_str_add(struct timing_filter *tf, const char *str)
+{
+	daos_filter_part_t *part = part_add(tf, "DAOS_FILTER_CONST", "DAOS_FILTER_TYPE_CSTRING", 0);
+
+	part->num_constants = 1;
+	part->constant      = &const_pool[const_pool_idx++];
+	d_iov_set(part->constant, (void *)str, strlen(str) + 1);
+}
+
+static uint64_t
+dbl2u64(double d)
+{
+	uint64_t u;
+
+	memcpy(&u, &d, sizeof(u));
+	return u;
+}
+
+static void
+filter_init(struct timing_filter *tf, const char *name, const char *type)
+{
+	tf->name = name;
+	d_iov_set(&tf->filter.filter_type, (void *)type, strlen(type));
+	tf->filter.parts = tf->parts;
+}
+
+/** a > 500 */
+static void
+build_simple(struct timing_filter *tf)
+{
+	filter_init(tf, "a > 500", "DAOS_FILTER_CONDITION");
+	func_add(tf, "DAOS_FILTER_FUNC_GT", 2);
+	akey_add(tf, "DAOS_FILTER_TYPE_UINTEGER4", "a", 4);
+	const_add(tf, "DAOS_FILTER_TYPE_UINTEGER4", 500, 4);
+}
+
+/** a > 100 AND b < 0 AND c LIKE "ab%" */
+static void
+build_conj(struct timing_filter *tf)
+{
+	filter_init(tf, "a > 100 AND b < 0 AND c LIKE 'ab%'", "DAOS_FILTER_CONDITION");
+	func_add(tf, "DAOS_FILTER_FUNC_AND", 3);
+	func_add(tf, "DAOS_FILTER_FUNC_GT", 2);
+	akey_add(tf, "DAOS_FILTER_TYPE_UINTEGER4", "a", 4);
+	const_add(tf, "DAOS_FILTER_TYPE_UINTEGER4", 100, 4);
+	func_add(tf, "DAOS_FILTER_FUNC_LT", 2);
+	akey_add(tf, "DAOS_FILTER_TYPE_INTEGER8", "b", 8);
+	const_add(tf, "DAOS_FILTER_TYPE_INTEGER8", 0, 8);
+	func_add(tf, "DAOS_FILTER_FUNC_LIKE", 2);
+	akey_add(tf, "DAOS_FILTER_TYPE_CSTRING", "c", AKEY_STR_LEN);
+	const_str_add(tf, "ab%");
+}
+
+/** b IN (-8, ..., 7) */
+static void
+build_in(struct timing_filter *tf)
+{
+	uint64_t vals[NR_IN_CONSTS];
+	int      i;
+
+	for (i = 0; i < NR_IN_CONSTS; i++)
+		vals[i] = (uint64_t)(int64_t)(i - NR_IN_CONSTS / 2);
+
+	filter_init(tf, "b IN (-8, ..., 7)", "DAOS_FILTER_CONDITION");
+	func_add(tf, "DAOS_FILTER_FUNC_IN", 2);
+	akey_add(tf, "DAOS_FILTER_TYPE_INTEGER8", "b", 8);
+	consts_add(tf, "DAOS_FILTER_TYPE_INTEGER8", vals, NR_IN_CONSTS, 8);
+}
+
+/** (d * (2.0 + 2.0) >= 1.0 OR dkey % 8 == 3) AND NOT (a == 7) */
+static void
+build_arith(struct timing_filter *tf)
+{
+	filter_init(tf, "(d * (2.0 + 2.0) >= 1.0 OR dkey & 7 == 3) AND NOT (a == 7)",
+		    "DAOS_FILTER_CONDITION");
+	func_add(tf, "DAOS_FILTER_FUNC_AND", 2);
+	func_add(tf, "DAOS_FILTER_FUNC_OR", 2);
+	func_add(tf, "DAOS_FILTER_FUNC_GE", 2);
+	func_add(tf, "DAOS_FILTER_FUNC_MUL", 2);
+	akey_add(tf, "DAOS_FILTER_TYPE_REAL8", "d", 8);
+	func_add(tf, "DAOS_FILTER_FUNC_ADD", 2);
+	const_add(tf, "DAOS_FILTER_TYPE_REAL8", dbl2u64(2.0), 8);
+	const_add(tf, "DAOS_FILTER_TYPE_REAL8", dbl2u64(2.0), 8);
+	const_add(tf, "DAOS_FILTER_TYPE_REAL8", dbl2u64(1.0), 8);
+	func_add(tf, "DAOS_FILTER_FUNC_EQ", 2);
+	func_add(tf, "DAOS_FILTER_FUNC_BITAND", 2);
+	dkey_add(tf, "DAOS_FILTER_TYPE_UINTEGER8", 8);
+	const_add(tf, "DAOS_FILTER_TYPE_UINTEGER8", 7, 8);
+	const_add(tf, "DAOS_FILTER_TYPE_UINTEGER8", 3, 8);
+	func_add(tf, "DAOS_FILTER_FUNC_NOT", 1);
+	func_add(tf, "DAOS_FILTER_FUNC_EQ", 2);
+	akey_add(tf, "DAOS_FILTER_TYPE_UINTEGER4", "a", 4);
+	const_add(tf, "DAOS_FILTER_TYPE_UINTEGER4", 7, 4);
+}
+
+/** a >= 100 AND b < 0 AND 0.25 <= d */
+static void
+build_conj_num(struct timing_filter *tf)
+{
+	filter_init(tf, "a >= 100 AND b < 0 AND 0.25 <= d", "DAOS_FILTER_CONDITION");
+	func_add(tf, "DAOS_FILTER_FUNC_AND", 3);
+	func_add(tf, "DAOS_FILTER_FUNC_GE", 2);
+	akey_add(tf, "DAOS_FILTER_TYPE_UINTEGER4", "a", 4);
+	const_add(tf, "DAOS_FILTER_TYPE_UINTEGER4", 100, 4);
+	func_add(tf, "DAOS_FILTER_FUNC_LT", 2);
+	akey_add(tf, "DAOS_FILTER_TYPE_INTEGER8", "b", 8);
+	const_add(tf, "DAOS_FILTER_TYPE_INTEGER8", 0, 8);
+	func_add(tf, "DAOS_FILTER_FUNC_LE", 2);
+	const_add(tf, "DAOS_FILTER_TYPE_REAL8", dbl2u64(0.25), 8);
+	akey_add(tf, "DAOS_FILTER_TYPE_REAL8", "d", 8);
+}
+
+/** c LIKE '%99%' AND a < 50: the cheap and selective operand comes last */
+static void
+build_misordered(struct timing_filter *tf)
+{
+	filter_init(tf, "c LIKE '%99%' AND a < 50", "DAOS_FILTER_CONDITION");
+	func_add(tf, "DAOS_FILTER_FUNC_AND", 2);
+	func_add(tf, "DAOS_FILTER_FUNC_LIKE", 2);
+	akey_add(tf, "DAOS_FILTER_TYPE_CSTRING", "c", AKEY_STR_LEN);
+	const_str_add(tf, "%99%");
+	func_add(tf, "DAOS_FILTER_FUNC_LT", 2);
+	akey_add(tf, "DAOS_FILTER_TYPE_UINTEGER4", "a", 4);
+	const_add(tf, "DAOS_FILTER_TYPE_UINTEGER4", 50, 4);
+}
+
+/** SUM(a) */
+static void
+build_sum(struct timing_filter *tf)
+{
+	filter_init(tf, "SUM(a)", "DAOS_FILTER_AGGREGATION");
+	func_add(tf, "DAOS_FILTER_FUNC_SUM", 1);
+	akey_add(tf, "DAOS_FILTER_TYPE_UINTEGER4", "a", 4);
+}
+
+/** MAX(d) */
+static void
+build_max(struct timing_filter *tf)
+{
+	filter_init(tf, "MAX(d)", "DAOS_FILTER_AGGREGATION");
+	func_add(tf, "DAOS_FILTER_FUNC_MAX", 1);
+	akey_add(tf, "DAOS_FILTER_TYPE_REAL8", "d", 8);
+}
+
+static void (*builders[])(struct timing_filter *) = {
+	build_simple, build_conj, build_conj_num, build_in, build_arith, build_misordered,
+	build_sum,    build_max,
+};
+
+#define NR_FILTERS	ARRAY_SIZE(builders)
+
+static void
+gen_records(struct timing_rec *recs, uint32_t nr)
+{
+	static const char *prefixes[] = {"ab", "ac", "ba", "abc"};
+	uint32_t           i;
+
+	srand(1);
+	for (i = 0; i < nr; i++) {
+		recs[i].dkey = i;
+		recs[i].a    = rand() % 1000;
+		recs[i].b    = (rand() % 64) - 32;
+		recs[i].d    = (double)rand() / RAND_MAX;
+		snprintf(recs[i].c, AKEY_STR_LEN, "%s%d", prefixes[rand() % 4], rand() % 1000);
+	}
+}
+
+/** points the iods/sgls used by the evaluators at record \a rec */
+static void
+set_record(struct filter_part_run_t *args, d_iov_t *dkey, d_iov_t *akey_iovs,
+	   struct timing_rec *rec)
+{
+	d_iov_set(dkey, &rec->dkey, sizeof(rec->dkey));
+	d_iov_set(&akey_iovs[0], &rec->a, sizeof(rec->a));
+	d_iov_set(&akey_iovs[1], &rec->b, sizeof(rec->b));
+	d_iov_set(&akey_iovs[2], rec->c, AKEY_STR_LEN);
+	d_iov_set(&akey_iovs[3], &rec->d, sizeof(rec->d));
+	args->dkey = dkey;
+}
+
+/** sets up the iods and sgls of the akeys of the generated records */
+static void
+init_iods(struct filter_part_run_t *args, daos_iod_t *iods, d_sg_list_t *sgls, d_iov_t *akey_iovs)
+{
+	uint32_t i;
+
+	for (i = 0; i < NR_AKEYS; i++) {
+		iods[i]          = (daos_iod_t){0};
+		iods[i].iod_type = DAOS_IOD_SINGLE;
+		iods[i].iod_nr   = 1;
+		d_iov_set(&iods[i].iod_name, akey_names[i], strlen(akey_names[i]));
+		sgls[i].sg_nr     = 1;
+		sgls[i].sg_nr_out = 1;
+		sgls[i].sg_iovs   = &akey_iovs[i];
+	}
+	iods[0].iod_size = sizeof(((struct timing_rec *)0)->a);
+	iods[1].iod_size = sizeof(((struct timing_rec *)0)->b);
+	iods[2].iod_size = AKEY_STR_LEN;
+	iods[3].iod_size = sizeof(((struct timing_rec *)0)->d);
+	args->nr_iods    = NR_AKEYS;
+	args->iods       = iods;
+	args->akeys      = sgls;
+}
+
+static int
+eval_tree(struct filter_compiled_t *cf, struct filter_part_run_t *args)
+{
+	args->part_idx = 0;
+	args->parts    = cf->parts;
+	return args->parts[0].filter_func(args);
+}
+
+static int
+eval_prog(struct filter_compiled_t *cf, struct filter_part_run_t *args)
+{
+	return filter_prog_run(cf->prog, args);
+}
+
+/**
+ * Evaluates the vectorized form of the filter over batches of records. As in the engine, a single
+ * batch is refilled with the next records once evaluated; only the evaluation is timed.
+ */
+static int
+run_batches(struct timing_filter *tf, struct pipeline_compiled_t *comp, daos_iod_t *iods,
+	    struct timing_rec *recs, uint32_t nr, uint32_t iterations, bool is_aggr, uint8_t *res,
+	    double *aggr, uint64_t *ns)
+{
+	struct filter_vec_t   *vec;
+	struct filter_batch_t  batch;
+	struct timing_rec     *rec;
+	struct timespec        start, end;
+	uint32_t               i, r, it;
+	d_iov_t                dkey;
+	d_iov_t               *iovs;
+	int                    rc = 0;
+
+	vec = is_aggr ? comp->aggr_filters[0].vec : comp->filters[0].vec;
+	if (vec == NULL)
+		return 1;
+
+	rc = filter_batch_alloc(comp, iods, NR_AKEYS, pipeline_batch_size, &batch);
+	if (rc != 0)
+		return rc;
+
+	*aggr = 0;
+	*ns   = 0;
+	for (it = 0; it < iterations; it++) {
+		for (i = 0; i < nr; i += batch.max) {
+			filter_batch_reset(&batch);
+			for (r = i; r < nr && batch.nr < batch.max; r++) {
+				rec  = &recs[r];
+				iovs = &batch.akey_iovs[batch.nr * NR_AKEYS];
+				memcpy(iovs[0].iov_buf, &rec->a, sizeof(rec->a));
+				memcpy(iovs[1].iov_buf, &rec->b, sizeof(rec->b));
+				memcpy(iovs[2].iov_buf, rec->c, AKEY_STR_LEN);
+				memcpy(iovs[3].iov_buf, &rec->d, sizeof(rec->d));
+				iovs[0].iov_len = sizeof(rec->a);
+				iovs[1].iov_len = sizeof(rec->b);
+				iovs[2].iov_len = AKEY_STR_LEN;
+				iovs[3].iov_len = sizeof(rec->d);
+				d_iov_set(&dkey, &rec->dkey, sizeof(rec->dkey));
+				rc = filter_batch_add(&batch, &dkey);
+				if (rc != 0)
+					D_GOTO(out, rc);
+			}
+
+			d_gettime(&start);
+			memset(batch.sel, 1, batch.nr);
+			if (is_aggr)
+				filter_vec_aggr_run(comp, vec, &batch, aggr);
+			else
+				filter_vec_cond_run(comp, vec, &batch);
+			d_gettime(&end);
+			*ns += d_timediff_ns(&start, &end);
+
+			if (is_aggr || it > 0)
+				continue;
+			for (r = 0; r < batch.nr; r++) {
+				if (res[i + r] != batch.sel[r]) {
+					printf("'%s' mismatch on record %u: tree %d, batch %d\n",
+					       tf->name, i + r, res[i + r], batch.sel[r]);
+					D_GOTO(out, rc = -DER_MISMATCH);
+				}
+			}
+		}
+	}
+out:
+	filter_batch_free(&batch);
+	return rc;
+}
+
+/**
+ * Evaluates the filter program while the operands of its AND/ORs are reordered, as done by the
+ * engine for filters that are not vectorized.
+ */
+static int
+run_adaptive(struct timing_filter *tf, struct filter_compiled_t *cf,
+	     struct filter_part_run_t *args, d_iov_t *dkey, d_iov_t *akey_iovs,
+	     struct timing_rec *recs, uint32_t nr, uint32_t iterations, uint8_t *res, uint64_t *ns)
+{
+	struct timespec start, end;
+	uint32_t        i, it;
+	int             rc;
+
+	d_gettime(&start);
+	for (it = 0; it < iterations; it++) {
+		for (i = 0; i < nr; i++) {
+			set_record(args, dkey, akey_iovs, &recs[i]);
+			rc = eval_prog(cf, args);
+			if (rc == 0 && res[i] != args->log_out) {
+				printf("'%s' mismatch on record %u: tree %d, adaptive %d\n",
+				       tf->name, i, res[i], args->log_out);
+				return -DER_MISMATCH;
+			}
+			/** profiling evaluates the operands again, overwriting args->log_out */
+			if (rc == 0)
+				rc = filter_adapt_record(cf, args);
+			if (rc != 0) {
+				printf("'%s' failed on record %u: " DF_RC "\n", tf->name, i,
+				       DP_RC(rc));
+				return rc;
+			}
+		}
+	}
+	d_gettime(&end);
+	*ns = d_timediff_ns(&start, &end);
+	return 0;
+}
+
+static void
+print_part_stats(struct timing_filter *tf, struct filter_adapt_t *adapt)
+{
+	daos_pipeline_part_stats_t *st;
+	uint32_t                    i;
+
+	for (i = 0; i < tf->filter.num_parts; i++) {
+		st = &adapt->stats[i];
+		if (st->nr_evals == 0)
+			continue;
+		printf("\tpart %u (%.*s): %lu evals, %lu false, %.1f ns/eval\n", i,
+		       (int)tf->parts[i]->part_type.iov_len,
+		       (char *)tf->parts[i]->part_type.iov_buf, st->nr_evals, st->nr_false,
+		       (double)st->eval_ns / st->nr_evals);
+	}
+}
+
+static int
+run_filter(struct timing_filter *tf, struct timing_rec *recs, uint32_t nr, uint32_t iterations)
+{
+	daos_pipeline_t           pipe    = {0};
+	daos_filter_t            *ftrs[1] = {&tf->filter};
+	struct pipeline_compiled_t comp;
+	struct filter_part_run_t  args    = {0};
+	daos_iod_t                iods[NR_AKEYS];
+	d_sg_list_t               sgls[NR_AKEYS];
+	d_iov_t                   akey_iovs[NR_AKEYS];
+	d_iov_t                   dkey;
+	d_iov_t                   aggr_iov;
+	double                    aggr[3];
+	uint8_t                  *res;
+	uint64_t                  ns[4];
+	uint64_t                  passed[2] = {0};
+	struct timespec           start, end;
+	bool                      is_aggr;
+	bool                      batched;
+	struct filter_adapt_t    *adapt = NULL;
+	uint32_t                  i, it, e;
+	int                       rc;
+
+	is_aggr = !strncmp(tf->filter.filter_type.iov_buf, "DAOS_FILTER_AGGREGATION",
+			   tf->filter.filter_type.iov_len);
+	pipe.version = 1;
+	if (is_aggr) {
+		pipe.num_aggr_filters = 1;
+		pipe.aggr_filters     = ftrs;
+	} else {
+		pipe.num_filters = 1;
+		pipe.filters     = ftrs;
+	}
+	rc = d_pipeline_check(&pipe);
+	if (rc != 0) {
+		printf("filter '%s' is not valid: " DF_RC "\n", tf->name, DP_RC(rc));
+		return rc;
+	}
+	rc = pipeline_compile(&pipe, &comp);
+	if (rc != 0) {
+		printf("failed to compile '%s': " DF_RC "\n", tf->name, DP_RC(rc));
+		return rc;
+	}
+
+	init_iods(&args, iods, sgls, akey_iovs);
+	args.iov_aggr = &aggr_iov;
+
+	D_ALLOC(res, nr);
+	if (res == NULL)
+		D_GOTO(out, rc = -DER_NOMEM);
+
+	for (e = 0; e < 2; e++) {
+		int (*eval)(struct filter_compiled_t *, struct filter_part_run_t *);
+
+		eval    = e == 0 ? eval_tree : eval_prog;
+		aggr[e] = 0;
+		d_iov_set(&aggr_iov, &aggr[e], sizeof(aggr[e]));
+
+		d_gettime(&start);
+		for (it = 0; it < iterations; it++) {
+			for (i = 0; i < nr; i++) {
+				set_record(&args, &dkey, akey_iovs, &recs[i]);
+				if (is_aggr)
+					rc = eval(&comp.aggr_filters[0], &args);
+				else
+					rc = eval(&comp.filters[0], &args);
+				if (rc != 0) {
+					printf("'%s' failed on record %u: " DF_RC "\n", tf->name,
+					       i, DP_RC(rc));
+					D_GOTO(out, rc);
+				}
+				if (is_aggr || it > 0)
+					continue;
+				if (e == 0) {
+					res[i] = args.log_out;
+				} else if (res[i] != args.log_out) {
+					printf("'%s' mismatch on record %u: tree %d, program %d\n",
+					       tf->name, i, res[i], args.log_out);
+					D_GOTO(out, rc = -DER_MISMATCH);
+				}
+				passed[e] += args.log_out;
+			}
+		}
+		d_gettime(&end);
+		ns[e] = d_timediff_ns(&start, &end);
+	}
+	if (is_aggr && aggr[0] != aggr[1]) {
+		printf("'%s' mismatch: tree %f, program %f\n", tf->name, aggr[0], aggr[1]);
+		D_GOTO(out, rc = -DER_MISMATCH);
+	}
+
+	rc = run_batches(tf, &comp, iods, recs, nr, iterations, is_aggr, res, &aggr[2], &ns[2]);
+	if (rc < 0)
+		D_GOTO(out, rc);
+	batched = rc == 0;
+	if (batched && is_aggr && aggr[0] != aggr[2]) {
+		printf("'%s' mismatch: tree %f, batch %f\n", tf->name, aggr[0], aggr[2]);
+		D_GOTO(out, rc = -DER_MISMATCH);
+	}
+
+	if (!is_aggr)
+		adapt = comp.filters[0].adapt;
+	if (adapt != NULL) {
+		rc = run_adaptive(tf, &comp.filters[0], &args, &dkey, akey_iovs, recs, nr,
+				  iterations, res, &ns[3]);
+		if (rc != 0)
+			D_GOTO(out, rc);
+	}
+
+	printf("%-52s tree %6.1f, program %6.1f (%.2fx)", tf->name,
+	       (double)ns[0] / ((uint64_t)nr * iterations),
+	       (double)ns[1] / ((uint64_t)nr * iterations), (double)ns[0] / ns[1]);
+	if (batched)
+		printf(", batch %6.1f (%.2fx)", (double)ns[2] / ((uint64_t)nr * iterations),
+		       (double)ns[0] / ns[2]);
+	else
+		printf(", batch      -        ");
+	if (adapt != NULL)
+		printf(", adaptive %6.1f (%.2fx) ns/rec",
+		       (double)ns[3] / ((uint64_t)nr * iterations), (double)ns[0] / ns[3]);
+	else
+		printf(", adaptive      - ns/rec");
+	rc = 0;
+	if (is_aggr)
+		printf(" (result %.0f)\n", aggr[1] / iterations);
+	else
+		printf(" (%lu/%u passed)\n", passed[1], nr);
+	if (verbose)
+		printf("\t%u parts, %u instructions, %u registers\n", tf->filter.num_parts,
+		       comp.aggr_filters == NULL ? comp.filters[0].prog->num_insns :
+		       comp.aggr_filters[0].prog->num_insns,
+		       comp.aggr_filters == NULL ? comp.filters[0].prog->num_regs :
+		       comp.aggr_filters[0].prog->num_regs);
+	if (verbose && adapt != NULL)
+		print_part_stats(tf, adapt);
+out:
+	D_FREE(res);
+	pipeline_compile_free(&comp);
+	return rc;
+}
+
+#define GROUP_MIN	(-32)
+#define NR_GROUPS	64
+#define TOPK		10
+
+static int
+dbl_cmp_desc(const void *a, const void *b)
+{
+	double da = *(double *)a;
+	double db = *(double *)b;
+
+	return da < db ? 1 : (da > db ? -1 : 0);
+}
+
+/** SUM(a) GROUP BY b, checked against the sums computed directly */
+static int
+run_group_by(struct timing_rec *recs, uint32_t nr, uint32_t iterations)
+{
+	struct timing_filter       key     = {0};
+	struct timing_filter       sum     = {0};
+	daos_filter_t             *ftrs[1] = {&sum.filter};
+	daos_pipeline_t            pipe    = {0};
+	struct pipeline_compiled_t comp;
+	struct pipeline_groups_t   groups;
+	struct pipeline_group_t   *grp;
+	struct pipeline_key_t      k;
+	struct filter_part_run_t   args    = {0};
+	daos_iod_t                 iods[NR_AKEYS];
+	d_sg_list_t                sgls[NR_AKEYS];
+	d_iov_t                    akey_iovs[NR_AKEYS];
+	d_iov_t                    dkey;
+	d_iov_t                    aggr_iov;
+	double                     sums[NR_GROUPS] = {0};
+	struct timespec            start, end;
+	uint32_t                   i, it;
+	int                        rc;
+
+	filter_init(&key, "b", "DAOS_FILTER_GROUP_BY");
+	akey_add(&key, "DAOS_FILTER_TYPE_INTEGER8", "b", 8);
+	filter_init(&sum, "SUM(a)", "DAOS_FILTER_AGGREGATION");
+	func_add(&sum, "DAOS_FILTER_FUNC_SUM", 1);
+	akey_add(&sum, "DAOS_FILTER_TYPE_UINTEGER4", "a", 4);
+	pipe.version          = 2;
+	pipe.num_aggr_filters = 1;
+	pipe.aggr_filters     = ftrs;
+	pipe.group_by         = &key.filter;
+	rc = d_pipeline_check(&pipe);
+	if (rc == 0)
+		rc = pipeline_compile(&pipe, &comp);
+	if (rc != 0) {
+		printf("GROUP BY pipeline is not valid: " DF_RC "\n", DP_RC(rc));
+		return rc;
+	}
+	init_iods(&args, iods, sgls, akey_iovs);
+	for (i = 0; i < nr; i++)
+		sums[recs[i].b - GROUP_MIN] += recs[i].a;
+
+	d_gettime(&start);
+	for (it = 0; it < iterations; it++) {
+		rc = pipeline_groups_init(&groups, 1);
+		if (rc != 0)
+			D_GOTO(out, rc);
+		for (i = 0; i < nr; i++) {
+			set_record(&args, &dkey, akey_iovs, &recs[i]);
+			rc = pipeline_key_eval(comp.group_by, &args, &k);
+			if (rc == 0)
+				rc = pipeline_groups_find(&groups, &pipe, &k, &grp);
+			if (rc != 0)
+				break;
+			grp->pg_count++;
+			d_iov_set(&aggr_iov, &grp->pg_aggr[0], sizeof(double));
+			args.iov_aggr = &aggr_iov;
+			rc = eval_prog(&comp.aggr_filters[0], &args);
+			if (rc != 0)
+				break;
+		}
+		if (rc == 0 && groups.pgs_nr != NR_GROUPS)
+			rc = -DER_MISMATCH;
+		for (i = 0; rc == 0 && i < groups.pgs_nr; i++) {
+			grp = groups.pgs_groups[i];
+			if (grp->pg_aggr[0] != sums[grp->pg_key.v.i - GROUP_MIN])
+				rc = -DER_MISMATCH;
+		}
+		pipeline_groups_fini(&groups);
+		if (rc != 0) {
+			printf("SUM(a) GROUP BY b failed: " DF_RC "\n", DP_RC(rc));
+			D_GOTO(out, rc);
+		}
+	}
+	d_gettime(&end);
+	printf("%-52s %6.1f ns/rec (%u groups)\n", "SUM(a) GROUP BY b",
+	       (double)d_timediff_ns(&start, &end) / ((uint64_t)nr * iterations), NR_GROUPS);
+out:
+	pipeline_compile_free(&comp);
+	return rc;
+}
+
+/** ORDER BY d DESC LIMIT TOPK, checked against all the values sorted */
+static int
+run_order_by(struct timing_rec *recs, uint32_t nr, uint32_t iterations)
+{
+	struct timing_filter         key  = {0};
+	daos_pipeline_t              pipe = {0};
+	struct pipeline_compiled_t   comp;
+	struct pipeline_topk_t       topk;
+	struct pipeline_topk_rec_t **out_recs;
+	struct pipeline_key_t        k;
+	struct filter_part_run_t     args = {0};
+	daos_iod_t                   iods[NR_AKEYS];
+	d_sg_list_t                  sgls[NR_AKEYS];
+	d_iov_t                      akey_iovs[NR_AKEYS];
+	d_iov_t                      dkey;
+	double                      *vals;
+	struct timespec              start, end;
+	uint32_t                     nr_out;
+	uint32_t                     i, it;
+	int                          rc;
+
+	filter_init(&key, "d", "DAOS_FILTER_ORDER_BY_DESC");
+	akey_add(&key, "DAOS_FILTER_TYPE_REAL8", "d", 8);
+	pipe.version  = 2;
+	pipe.order_by = &key.filter;
+	pipe.limit    = TOPK;
+	rc = d_pipeline_check(&pipe);
+	if (rc == 0)
+		rc = pipeline_compile(&pipe, &comp);
+	if (rc != 0) {
+		printf("ORDER BY pipeline is not valid: " DF_RC "\n", DP_RC(rc));
+		return rc;
+	}
+	init_iods(&args, iods, sgls, akey_iovs);
+
+	D_ALLOC_ARRAY(vals, nr);
+	if (vals == NULL)
+		D_GOTO(out, rc = -DER_NOMEM);
+	for (i = 0; i < nr; i++)
+		vals[i] = recs[i].d;
+	qsort(vals, nr, sizeof(*vals), dbl_cmp_desc);
+
+	d_gettime(&start);
+	for (it = 0; it < iterations; it++) {
+		rc = pipeline_topk_init(&topk, TOPK, NR_AKEYS, true);
+		if (rc != 0)
+			D_GOTO(out, rc);
+		for (i = 0; i < nr; i++) {
+			set_record(&args, &dkey, akey_iovs, &recs[i]);
+			rc = pipeline_key_eval(comp.order_by, &args, &k);
+			if (rc == 0)
+				rc = pipeline_topk_add(&topk, &k, &dkey, iods, sgls);
+			if (rc != 0)
+				break;
+		}
+		if (rc == 0)
+			rc = pipeline_topk_sort(&topk, &out_recs, &nr_out);
+		pipeline_topk_fini(&topk);
+		if (rc == 0) {
+			if (nr_out != min(nr, TOPK))
+				rc = -DER_MISMATCH;
+			for (i = 0; i < nr_out; i++) {
+				if (out_recs[i]->tr_key.v.d != vals[i])
+					rc = -DER_MISMATCH;
+				pipeline_topk_rec_free(out_recs[i]);
+			}
+			D_FREE(out_recs);
+		}
+		if (rc != 0) {
+			printf("ORDER BY d DESC failed: " DF_RC "\n", DP_RC(rc));
+			D_GOTO(out, rc);
+		}
+	}
+	d_gettime(&end);
+	printf("%-52s %6.1f ns/rec\n", "ORDER BY d DESC LIMIT 10",
+	       (double)d_timediff_ns(&start, &end) / ((uint64_t)nr * iterations));
+out:
+	D_FREE(vals);
+	pipeline_compile_free(&comp);
+	return rc;
+}
+
+static void
+print_usage(const char *name)
+{
+	printf("Usage: %s [OPTIONS]\n"
+	       "  -n, --records N     number of records (default 100000)\n"
+	       "  -i, --iterations N  scans over all records (default 10)\n"
+	       "  -b, --batch N       records per batch (default %u)\n"
+	       "  -s, --sample N      records per profiled record when reordering AND/OR\n"
+	       "                      operands, 0 disables reordering (default %u)\n"
+	       "  -v, --verbose       print details of compiled programs\n"
+	       "  -h, --help          show this message\n", name, PIPELINE_BATCH_SIZE,
+	       PIPELINE_ADAPT_SAMPLE);
+}
+
+int
+main(int argc, char *argv[])
+{
+	struct timing_filter  tf;
+	struct timing_rec    *recs;
+	uint32_t              nr         = 100000;
+	uint32_t              iterations = 10;
+	uint32_t              i;
+	int                   opt;
+	int                   rc;
+
+	static struct option long_options[] = {
+		{"records", required_argument, 0, 'n'},
+		{"iterations", required_argument, 0, 'i'},
+		{"batch", required_argument, 0, 'b'},
+		{"sample", required_argument, 0, 's'},
+		{"verbose", no_argument, 0, 'v'},
+		{"help", no_argument, 0, 'h'},
+		{0, 0, 0, 0},
+	};
+
+	while ((opt = getopt_long(argc, argv, "n:i:b:s:vh", long_options, NULL)) != -1) {
+		switch (opt) {
+		case 'n':
+			nr = atoi(optarg);
+			break;
+		case 'i':
+			iterations = atoi(optarg);
+			break;
+		case 'b':
+			pipeline_batch_size = atoi(optarg);
+			break;
+		case 's':
+			pipeline_adapt_sample = atoi(optarg);
+			break;
+		case 'v':
+			verbose = true;
+			break;
+		case 'h':
+			print_usage(argv[0]);
+			return 0;
+		default:
+			print_usage(argv[0]);
+			return 1;
+		}
+	}
+	if (nr == 0 || iterations == 0 || pipeline_batch_size < 2) {
+		print_usage(argv[0]);
+		return 1;
+	}
+
+	rc = daos_debug_init(DAOS_LOG_DEFAULT);
+	if (rc != 0)
+		return rc;
+
+	D_ALLOC_ARRAY(recs, nr);
+	if (recs == NULL)
+		D_GOTO(out, rc = -DER_NOMEM);
+	gen_records(recs, nr);
+
+	printf("Evaluating %u records, %u iterations, %u records per batch\n", nr, iterations,
+	       pipeline_batch_size);
+	for (i = 0; i < NR_FILTERS; i++) {
+		memset(&tf, 0, sizeof(tf));
+		part_pool_idx  = 0;
+		const_pool_idx = 0;
+		builders[i](&tf);
+		rc = run_filter(&tf, recs, nr, iterations);
+		if (rc != 0)
+			break;
+	}
+	part_pool_idx = 0;
+	if (rc == 0)
+		rc = run_group_by(recs, nr, iterations);
+	part_pool_idx = 0;
+	if (rc == 0)
+		rc = run_order_by(recs, nr, iterations);
+	D_FREE(recs);
+out:
+	daos_debug_fini();
+	return rc == 0 ? 0 : 1;
+}
@@ -1,6 +1,6 @@
 /**
  * (C) Copyright 2016-2024 Intel Corporation.
- * (C) Copyright 2025 Hewlett Packard Enterprise Development LP
+ * (C) Copyright 2025-2026 Hewlett Packard Enterprise Development LP
  *
  * SPDX-License-Identifier: BSD-2-Clause-Patent
  */
@@ -339,6 +339,15 @@ pool_query_bits(daos_pool_info_t *po_info, daos_prop_t *prop)
 		case DAOS_PROP_PO_SVC_OPS_ENTRY_AGE:
 			bits |= DAOS_PO_QUERY_PROP_SVC_OPS_ENTRY_AGE;
 			break;
+		case DAOS_PROP_PO_QOS_IOPS:
+			bits |= DAOS_PO_QUERY_PROP_QOS_IOPS;
+			break;
+		case DAOS_PROP_PO_QOS_BW:
+			bits |= DAOS_PO_QUERY_PROP_QOS_BW;
+			break;
+		case DAOS_PROP_PO_QOS_SLO:
+			bits |= DAOS_PO_QUERY_PROP_QOS_SLO;
+			break;
 		default:
 			D_ERROR("ignore bad dpt_type %d.\n", entry->dpe_type);
 			break;
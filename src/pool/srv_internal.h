@@ -1,7 +1,7 @@
 /*
  * (C) Copyright 2016-2024 Intel Corporation.
  * (C) Copyright 2025 Google LLC
- * (C) Copyright 2025 Hewlett Packard Enterprise Development LP
+ * (C) Copyright 2025-2026 Hewlett Packard Enterprise Development LP
  *
  * SPDX-License-Identifier: BSD-2-Clause-Patent
  */
@@ -103,6 +103,10 @@ struct pool_iv_prop {
 	uint32_t	pip_reint_mode;
 	uint32_t         pip_svc_ops_enabled;
 	uint32_t         pip_svc_ops_entry_age;
+	/* QoS limits, they change the IV layout so that all engines must run the same version */
+	uint64_t	 pip_qos_iops;
+	uint64_t	 pip_qos_bw;
+	uint32_t	 pip_qos_slo;
 	char		pip_iv_buf[0];
 };
 
@@ -1,7 +1,7 @@
 /**
  * (C) Copyright 2017-2024 Intel Corporation.
  * (C) Copyright 2025 Google LLC
- * (C) Copyright 2025 Hewlett Packard Enterprise Development LP
+ * (C) Copyright 2025-2026 Hewlett Packard Enterprise Development LP
  *
  * SPDX-License-Identifier: BSD-2-Clause-Patent
  */
@@ -206,6 +206,15 @@ pool_iv_prop_l2g(daos_prop_t *prop, struct pool_iv_prop *iv_prop)
 		case DAOS_PROP_PO_SVC_OPS_ENTRY_AGE:
 			iv_prop->pip_svc_ops_entry_age = prop_entry->dpe_val;
 			break;
+		case DAOS_PROP_PO_QOS_IOPS:
+			iv_prop->pip_qos_iops = prop_entry->dpe_val;
+			break;
+		case DAOS_PROP_PO_QOS_BW:
+			iv_prop->pip_qos_bw = prop_entry->dpe_val;
+			break;
+		case DAOS_PROP_PO_QOS_SLO:
+			iv_prop->pip_qos_slo = prop_entry->dpe_val;
+			break;
 		default:
 			D_ASSERTF(0, "bad dpe_type %d\n", prop_entry->dpe_type);
 			break;
@@ -346,6 +355,15 @@ pool_iv_prop_g2l(struct pool_iv_prop *iv_prop, daos_prop_t *prop)
 		case DAOS_PROP_PO_SVC_OPS_ENTRY_AGE:
 			prop_entry->dpe_val = iv_prop->pip_svc_ops_entry_age;
 			break;
+		case DAOS_PROP_PO_QOS_IOPS:
+			prop_entry->dpe_val = iv_prop->pip_qos_iops;
+			break;
+		case DAOS_PROP_PO_QOS_BW:
+			prop_entry->dpe_val = iv_prop->pip_qos_bw;
+			break;
+		case DAOS_PROP_PO_QOS_SLO:
+			prop_entry->dpe_val = iv_prop->pip_qos_slo;
+			break;
 		default:
 			D_ASSERTF(0, "bad dpe_type %d\n", prop_entry->dpe_type);
 			break;
@@ -1,6 +1,6 @@
 /*
  * (C) Copyright 2017-2023 Intel Corporation.
- * (C) Copyright 2025 Hewlett Packard Enterprise Development LP
+ * (C) Copyright 2025-2026 Hewlett Packard Enterprise Development LP
  *
  * SPDX-License-Identifier: BSD-2-Clause-Patent
  */
@@ -57,6 +57,9 @@ RDB_STRING_KEY(ds_pool_prop_, checkpoint_mode);
 RDB_STRING_KEY(ds_pool_prop_, checkpoint_freq);
 RDB_STRING_KEY(ds_pool_prop_, checkpoint_thresh);
 RDB_STRING_KEY(ds_pool_prop_, reint_mode);
+RDB_STRING_KEY(ds_pool_prop_, qos_iops);
+RDB_STRING_KEY(ds_pool_prop_, qos_bw);
+RDB_STRING_KEY(ds_pool_prop_, qos_slo);
 
 /** default properties, should cover all optional pool properties */
 struct daos_prop_entry pool_prop_entries_default[DAOS_PROP_PO_NUM] = {
@@ -166,6 +169,18 @@ struct daos_prop_entry pool_prop_entries_default[DAOS_PROP_PO_NUM] = {
     {
 	.dpe_type = DAOS_PROP_PO_SVC_OPS_ENTRY_AGE,
 	.dpe_val  = DAOS_PROP_PO_SVC_OPS_ENTRY_AGE_DEFAULT,
+    },
+    {
+	.dpe_type = DAOS_PROP_PO_QOS_IOPS,
+	.dpe_val  = DAOS_PROP_PO_QOS_IOPS_DEFAULT,
+    },
+    {
+	.dpe_type = DAOS_PROP_PO_QOS_BW,
+	.dpe_val  = DAOS_PROP_PO_QOS_BW_DEFAULT,
+    },
+    {
+	.dpe_type = DAOS_PROP_PO_QOS_SLO,
+	.dpe_val  = DAOS_PROP_PO_QOS_SLO_DEFAULT,
     }};
 
 daos_prop_t pool_prop_default = {
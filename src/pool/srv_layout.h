@@ -1,6 +1,6 @@
 /*
  * (C) Copyright 2016-2023 Intel Corporation.
- * (C) Copyright 2025 Hewlett Packard Enterprise Development LP
+ * (C) Copyright 2025-2026 Hewlett Packard Enterprise Development LP
  *
  * SPDX-License-Identifier: BSD-2-Clause-Patent
  */
@@ -80,6 +80,9 @@ extern d_iov_t ds_pool_prop_checkpoint_mode;    /* uint32_t */
 extern d_iov_t ds_pool_prop_checkpoint_freq;    /* uint32_t */
 extern d_iov_t ds_pool_prop_checkpoint_thresh;  /* uint32_t */
 extern d_iov_t ds_pool_prop_reint_mode;		/* uint32_t */
+extern d_iov_t ds_pool_prop_qos_iops;		/* uint64_t */
+extern d_iov_t ds_pool_prop_qos_bw;		/* uint64_t */
+extern d_iov_t ds_pool_prop_qos_slo;		/* uint32_t */
 extern d_iov_t ds_pool_prop_svc_ops;            /* service ops KVS */
 extern d_iov_t ds_pool_prop_svc_ops_enabled;    /* uint32_t */
 extern d_iov_t ds_pool_prop_svc_ops_max;        /* uint32_t */
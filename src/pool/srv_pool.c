@@ -445,6 +445,9 @@ pool_prop_default_copy(daos_prop_t *prop_def, daos_prop_t *prop)
 		case DAOS_PROP_PO_CHECKPOINT_THRESH:
 		case DAOS_PROP_PO_CHECKPOINT_FREQ:
 		case DAOS_PROP_PO_REINT_MODE:
+		case DAOS_PROP_PO_QOS_IOPS:
+		case DAOS_PROP_PO_QOS_BW:
+		case DAOS_PROP_PO_QOS_SLO:
 			entry_def->dpe_val = entry->dpe_val;
 			break;
 		case DAOS_PROP_PO_ACL:
@@ -749,6 +752,25 @@ pool_prop_write(struct rdb_tx *tx, const rdb_path_t *kvs, daos_prop_t *prop)
 			if (rc)
 				return rc;
 			break;
+		case DAOS_PROP_PO_QOS_IOPS:
+			d_iov_set(&value, &entry->dpe_val, sizeof(entry->dpe_val));
+			rc = rdb_tx_update(tx, kvs, &ds_pool_prop_qos_iops, &value);
+			if (rc)
+				return rc;
+			break;
+		case DAOS_PROP_PO_QOS_BW:
+			d_iov_set(&value, &entry->dpe_val, sizeof(entry->dpe_val));
+			rc = rdb_tx_update(tx, kvs, &ds_pool_prop_qos_bw, &value);
+			if (rc)
+				return rc;
+			break;
+		case DAOS_PROP_PO_QOS_SLO:
+			val32 = entry->dpe_val;
+			d_iov_set(&value, &val32, sizeof(val32));
+			rc = rdb_tx_update(tx, kvs, &ds_pool_prop_qos_slo, &value);
+			if (rc)
+				return rc;
+			break;
 		default:
 			D_ERROR("bad dpe_type %d.\n", entry->dpe_type);
 			return -DER_INVAL;
@@ -3637,6 +3659,58 @@ pool_prop_read(struct rdb_tx *tx, const struct pool_svc *svc, uint64_t bits,
 		idx++;
 	}
 
+	/* QoS limits are optional, the pools created before them are unlimited */
+	if (bits & DAOS_PO_QUERY_PROP_QOS_IOPS) {
+		d_iov_set(&value, &val, sizeof(val));
+		rc = rdb_tx_lookup(tx, &svc->ps_root, &ds_pool_prop_qos_iops, &value);
+		if (rc == -DER_NONEXIST) {
+			rc  = 0;
+			val = DAOS_PROP_PO_QOS_IOPS_DEFAULT;
+		} else if (rc != 0) {
+			DL_ERROR(rc, DF_UUID ": failed to lookup DAOS_PROP_PO_QOS_IOPS",
+				 DP_UUID(svc->ps_uuid));
+			D_GOTO(out_prop, rc);
+		}
+		D_ASSERT(idx < nr);
+		prop->dpp_entries[idx].dpe_type = DAOS_PROP_PO_QOS_IOPS;
+		prop->dpp_entries[idx].dpe_val  = val;
+		idx++;
+	}
+
+	if (bits & DAOS_PO_QUERY_PROP_QOS_BW) {
+		d_iov_set(&value, &val, sizeof(val));
+		rc = rdb_tx_lookup(tx, &svc->ps_root, &ds_pool_prop_qos_bw, &value);
+		if (rc == -DER_NONEXIST) {
+			rc  = 0;
+			val = DAOS_PROP_PO_QOS_BW_DEFAULT;
+		} else if (rc != 0) {
+			DL_ERROR(rc, DF_UUID ": failed to lookup DAOS_PROP_PO_QOS_BW",
+				 DP_UUID(svc->ps_uuid));
+			D_GOTO(out_prop, rc);
+		}
+		D_ASSERT(idx < nr);
+		prop->dpp_entries[idx].dpe_type = DAOS_PROP_PO_QOS_BW;
+		prop->dpp_entries[idx].dpe_val  = val;
+		idx++;
+	}
+
+	if (bits & DAOS_PO_QUERY_PROP_QOS_SLO) {
+		d_iov_set(&value, &val32, sizeof(val32));
+		rc = rdb_tx_lookup(tx, &svc->ps_root, &ds_pool_prop_qos_slo, &value);
+		if (rc == -DER_NONEXIST) {
+			rc    = 0;
+			val32 = DAOS_PROP_PO_QOS_SLO_DEFAULT;
+		} else if (rc != 0) {
+			DL_ERROR(rc, DF_UUID ": failed to lookup DAOS_PROP_PO_QOS_SLO",
+				 DP_UUID(svc->ps_uuid));
+			D_GOTO(out_prop, rc);
+		}
+		D_ASSERT(idx < nr);
+		prop->dpp_entries[idx].dpe_type = DAOS_PROP_PO_QOS_SLO;
+		prop->dpp_entries[idx].dpe_val  = val32;
+		idx++;
+	}
+
 	*prop_out = prop;
 	return 0;
 
@@ -5490,6 +5564,9 @@ pool_query_handler(crt_rpc_t *rpc, int handler_version)
 			case DAOS_PROP_PO_SVC_OPS_ENABLED:
 			case DAOS_PROP_PO_SVC_OPS_ENTRY_AGE:
 			case DAOS_PROP_PO_DATA_THRESH:
+			case DAOS_PROP_PO_QOS_IOPS:
+			case DAOS_PROP_PO_QOS_BW:
+			case DAOS_PROP_PO_QOS_SLO:
 				if (entry->dpe_val != iv_entry->dpe_val) {
 					D_ERROR("type %d mismatch "DF_U64" - "
 						DF_U64".\n", entry->dpe_type,
@@ -82,6 +82,15 @@ done:
 	*committed_tx = ctx->cc_commit_id;
 }
 
+/** Throttle the checkpoint, foreground I/O can run in the meantime */
+static void
+sleep_cb(void *arg, uint32_t msecs)
+{
+	struct chkpt_ctx *ctx = arg;
+
+	sched_req_sleep(ctx->cc_sched_arg, msecs);
+}
+
 static void
 update_cb(void *arg, uint64_t id, uint32_t used_blocks, uint32_t total_blocks)
 {
@@ -198,7 +207,7 @@ chkpt_ult(void *arg)
 	ctx.cc_pool         = child->spc_pool;
 	ctx.cc_sched_arg    = child->spc_chkpt_req;
 
-	vos_pool_checkpoint_init(poh, update_cb, wait_cb, &ctx, &ctx.cc_store);
+	vos_pool_checkpoint_init(poh, update_cb, wait_cb, sleep_cb, &ctx, &ctx.cc_store);
 
 	while (!dss_ult_exiting(child->spc_chkpt_req)) {
 		if (!need_checkpoint(child, &ctx, &start))
@@ -2162,6 +2162,10 @@ ds_pool_tgt_map_update(struct ds_pool *pool, struct pool_buf *buf,
 		pool->sp_map = map;
 		map = tmp;
 
+		/* Pool-wide QoS limits are shared by the targets serving I/O */
+		pool_map_find_tgts_by_state(pool->sp_map, PO_COMP_ST_UP | PO_COMP_ST_UPIN, NULL,
+					    &pool->sp_qos_tgt_nr);
+
 		/* Invalidate pool->sp_map_bc. */
 		if (pool->sp_map_bc != NULL) {
 			map_bc_put(pool->sp_map_bc);
@@ -2378,6 +2382,9 @@ ds_pool_tgt_prop_update(struct ds_pool *pool, struct pool_iv_prop *iv_prop)
 	pool->sp_scrub_freq_sec = iv_prop->pip_scrub_freq;
 	pool->sp_scrub_thresh = iv_prop->pip_scrub_thresh;
 	pool->sp_reint_mode = iv_prop->pip_reint_mode;
+	pool->sp_qos_iops = iv_prop->pip_qos_iops;
+	pool->sp_qos_bw = iv_prop->pip_qos_bw;
+	pool->sp_qos_slo = iv_prop->pip_qos_slo;
 
 	arg.uvp_pool                     = pool;
 	arg.uvp_checkpoint_props_changed = false;
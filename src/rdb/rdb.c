@@ -1136,7 +1136,8 @@ rdb_chkpt_enabled(struct rdb *db)
 	}
 
 	D_DEBUG(DB_MD, DF_DB ": checkpointing is enabled for rdb replica\n", DP_DB(db));
-	vos_pool_checkpoint_init(db->d_pool, rdb_chkpt_update, rdb_chkpt_wait, db, &dcr->dcr_store);
+	vos_pool_checkpoint_init(db->d_pool, rdb_chkpt_update, rdb_chkpt_wait, NULL, db,
+				 &dcr->dcr_store);
 
 	dcr->dcr_enabled = 1;
 	dcr->dcr_init    = 1;
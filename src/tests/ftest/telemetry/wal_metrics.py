@@ -67,8 +67,9 @@ class WalMetrics(TestWithTelemetry):
         """JIRA ID: DAOS-11626.
 
         The WAL replay metrics is per-pool metrics in 'vos_wal' under each pool folder, it includes
-        'replay_size', 'replay_time', 'replay_entries', 'replay_count' and 'replay_transactions'
-        (see vos_metrics_alloc() in src/vos/vos_common.c). WAL replay metrics are only updated when
+        'replay_size', 'replay_time', 'replay_entries', 'replay_count', 'replay_transactions' and
+        the per-phase 'replay_load_time', 'replay_verify_time' and 'replay_apply_time' (see
+        vos_metrics_alloc() in src/vos/vos_common.c). WAL replay metrics are only updated when
         a pool is opened on engine start (or when creating a pool).
 
         Test steps:
@@ -106,6 +107,9 @@ class WalMetrics(TestWithTelemetry):
                     elif metric.endswith('_replay_transactions'):
                         # Replay transactions should be > 0 after pool create for MD on SSD
                         ranges[metric][label] = [1]
+                    elif metric.endswith(('_load_time', '_verify_time', '_apply_time')):
+                        # Replay phase times are bounded by the total replay time
+                        ranges[metric][label] = [0, 1000000]
                 else:
                     ranges[metric][label] = [0, 0]
 
@@ -56,16 +56,21 @@ class TelemetryUtils():
     ENGINE_POOL_BLOCK_ALLOCATOR_METRICS = [
         "engine_pool_block_allocator_alloc_hint",
         "engine_pool_block_allocator_alloc_large",
+        "engine_pool_block_allocator_alloc_magazine",
         "engine_pool_block_allocator_alloc_small",
+        "engine_pool_block_allocator_compact_blks",
+        "engine_pool_block_allocator_frag_index",
         "engine_pool_block_allocator_frags_aging",
         "engine_pool_block_allocator_frags_large",
         "engine_pool_block_allocator_frags_small",
         "engine_pool_block_allocator_free_blks"]
     ENGINE_POOL_CHECKPOINT_METRICS = [
+        *_gen_stats_metrics("engine_pool_checkpoint_bandwidth"),
         *_gen_stats_metrics("engine_pool_checkpoint_dirty_chunks"),
         *_gen_stats_metrics("engine_pool_checkpoint_dirty_pages"),
         *_gen_stats_metrics("engine_pool_checkpoint_duration"),
         *_gen_stats_metrics("engine_pool_checkpoint_iovs_copied"),
+        "engine_pool_checkpoint_wal_fill",
         *_gen_stats_metrics("engine_pool_checkpoint_wal_purged")]
     ENGINE_POOL_EC_UPDATE_METRICS = [
         "engine_pool_EC_update_full_stripe",
@@ -152,13 +157,17 @@ class TelemetryUtils():
         *_gen_stats_metrics("engine_pool_vos_wal_wal_sz"),
         *_gen_stats_metrics("engine_pool_vos_wal_wal_qd"),
         *_gen_stats_metrics("engine_pool_vos_wal_wal_waiters"),
+        *_gen_stats_metrics("engine_pool_vos_wal_wal_batch"),
         *_gen_stats_metrics("engine_pool_vos_wal_wal_dur")]
     ENGINE_POOL_VOS_WAL_REPLAY_METRICS = [
         "engine_pool_vos_wal_replay_count",
         "engine_pool_vos_wal_replay_entries",
         "engine_pool_vos_wal_replay_size",
         "engine_pool_vos_wal_replay_time",
-        "engine_pool_vos_wal_replay_transactions"]
+        "engine_pool_vos_wal_replay_transactions",
+        "engine_pool_vos_wal_replay_load_time",
+        "engine_pool_vos_wal_replay_verify_time",
+        "engine_pool_vos_wal_replay_apply_time"]
     ENGINE_POOL_VOS_CACHE_METRICS = [
         "engine_pool_vos_cache_page_evict",
         "engine_pool_vos_cache_page_flush",
@@ -198,6 +207,10 @@ class TelemetryUtils():
         "engine_sched_wait_queue",
         "engine_sched_sleep_queue",
         "engine_sched_total_reject",
+        "engine_sched_qos_throttled",
+        "engine_sched_qos_reject",
+        "engine_sched_slo_violation",
+        *_gen_stats_metrics("engine_sched_io_queue_delay"),
         *_gen_stats_metrics("engine_sched_cycle_duration"),
         *_gen_stats_metrics("engine_sched_cycle_size")]
     ENGINE_DTX_METRICS = [
@@ -208,6 +221,11 @@ class TelemetryUtils():
         "engine_dmabuff_used_chunks_io",
         "engine_dmabuff_used_chunks_local",
         "engine_dmabuff_used_chunks_rebuild",
+        "engine_dmabuff_used_chunks_small",
+        "engine_dmabuff_used_chunks_medium",
+        "engine_dmabuff_used_chunks_large",
+        "engine_dmabuff_huge_cached",
+        "engine_dmabuff_rsv_waits",
         "engine_dmabuff_bulk_grps",
         "engine_dmabuff_active_reqs",
         "engine_dmabuff_queued_reqs",
@@ -721,7 +721,8 @@ show_result(struct pf_param *param, uint64_t start, uint64_t end,
 		double		latency;
 		double		rate;
 
-		if (strcmp(test_name, "QUERY") == 0) {
+		if (strcmp(test_name, "QUERY") == 0 ||
+		    strcmp(test_name, "OBJ CACHE") == 0) {
 			total = ts_ctx.tsc_mpi_size * param->pa_iteration *
 				param->pa_obj_nr;
 		} else if (strcmp(test_name, "AGGREGATE") == 0 ||
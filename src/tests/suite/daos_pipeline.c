@@ -1185,6 +1185,132 @@ simple_pipeline(void **state)
 	assert_rc_equal(rc, 0);
 }
 
+/** counts and prints the records received by daos_pipeline_scan() */
+static int
+scan_count_cb(void *arg, uint32_t nr_kds, daos_key_desc_t *kds, d_sg_list_t *sgl_keys,
+	      uint32_t nr_iods, daos_size_t *recx_size, d_sg_list_t *sgl_recx)
+{
+	char     *dkey = (char *)sgl_keys->sg_iovs->iov_buf;
+	uint32_t  i;
+
+	for (i = 0; i < nr_kds; i++) {
+		print_message("\tname(dkey)=%.*s\n", (int)kds[i].kd_key_len, dkey);
+		dkey += kds[i].kd_key_len;
+	}
+	*(uint32_t *)arg += nr_kds;
+	return 0;
+}
+
+static uint32_t
+scan_simple_pipeline(daos_handle_t coh, daos_handle_t oh, daos_pipeline_t *pipeline,
+		     char *fields[], uint32_t max_inflight, double *aggr)
+{
+	daos_pipeline_stream_t	stream = {0};
+	daos_iod_t		iods[NR_IODS];
+	d_sg_list_t		sgl_aggr = {0};
+	d_iov_t			iov_aggr;
+	uint32_t		nr_iods = NR_IODS;
+	uint32_t		nr = 0;
+	uint32_t		i;
+	int			rc;
+
+	for (i = 0; i < nr_iods; i++) {
+		iods[i].iod_nr    = 1;
+		iods[i].iod_size  = STRING_MAX_LEN;
+		iods[i].iod_recxs = NULL;
+		iods[i].iod_type  = DAOS_IOD_SINGLE;
+		d_iov_set(&iods[i].iod_name, (void *)fields[i], strlen(fields[i]));
+	}
+
+	/** two records per round trip, so that shards are visited more than once */
+	stream.max_inflight  = max_inflight;
+	stream.nr_kds        = 2;
+	stream.keys_buf_size = stream.nr_kds * STRING_MAX_LEN;
+	stream.recx_buf_size = stream.nr_kds * nr_iods * STRING_MAX_LEN;
+	stream.recs_cb       = scan_count_cb;
+	stream.cb_arg        = &nr;
+
+	if (pipeline->num_aggr_filters > 0) {
+		d_iov_set(&iov_aggr, aggr, sizeof(*aggr));
+		sgl_aggr.sg_nr   = 1;
+		sgl_aggr.sg_iovs = &iov_aggr;
+	}
+
+	rc = daos_pipeline_scan(coh, oh, pipeline, DAOS_TX_NONE, 0, &nr_iods, iods, &stream,
+				pipeline->num_aggr_filters > 0 ? &sgl_aggr : NULL, NULL, NULL);
+	assert_rc_equal(rc, 0);
+
+	return nr;
+}
+
+static void
+scan_pipeline(void **state)
+{
+	test_arg_t	*arg = *state;
+	daos_obj_id_t   oid;
+	int             rc;
+	daos_handle_t	coh, oh;
+	daos_pipeline_t pipeline1, pipeline3, pipeline4;
+	static char	*fields[NR_IODS] = {"Owner", "Species", "Sex", "Age"};
+	double		aggr = 0;
+
+	skip_if_pipeline_disabled();
+
+	rc = daos_cont_create_with_label(arg->pool.poh, "scan_pipeline_cont", NULL, NULL, NULL);
+	assert_rc_equal(rc, 0);
+
+	rc = daos_cont_open(arg->pool.poh, "scan_pipeline_cont", DAOS_COO_RW, &coh, NULL, NULL);
+	assert_rc_equal(rc, 0);
+
+	/** records spread on all the shards of the object */
+	oid.hi = 0;
+	oid.lo = 5;
+	daos_obj_generate_oid(coh, &oid, DAOS_OT_MULTI_LEXICAL, OC_SX, 0, 0);
+
+	rc = daos_obj_open(coh, oid, DAOS_OO_RW, &oh, NULL);
+	assert_rc_equal(rc, 0);
+
+	insert_simple_records(oh, fields);
+
+	/** FILTER "Owner == Benny" */
+	daos_pipeline_init(&pipeline1);
+	build_simple_pipeline_one(&pipeline1);
+	print_message("scanning all the shards at once (Owner=Benny):\n");
+	assert_int_equal(scan_simple_pipeline(coh, oh, &pipeline1, fields, 0, NULL), 2);
+	print_message("scanning two shards at a time (Owner=Benny):\n");
+	assert_int_equal(scan_simple_pipeline(coh, oh, &pipeline1, fields, 2, NULL), 2);
+
+	/** FILTER "Owner == Benny", AGGREGATE "SUM(age)" */
+	daos_pipeline_init(&pipeline3);
+	build_simple_pipeline_three(&pipeline3);
+	print_message("scanning with SUM(age) (Owner=Benny):\n");
+	scan_simple_pipeline(coh, oh, &pipeline3, fields, 2, &aggr);
+	assert_true(aggr == 8);
+
+	/** FILTER "Age & 1", with and without a limit */
+	daos_pipeline_init(&pipeline4);
+	build_simple_pipeline_four(&pipeline4);
+	print_message("scanning one shard at a time ((Age & 1) > 0):\n");
+	assert_int_equal(scan_simple_pipeline(coh, oh, &pipeline4, fields, 1, NULL), 4);
+	pipeline4.limit = 3;
+	print_message("scanning with a limit of 3 ((Age & 1) > 0):\n");
+	assert_int_equal(scan_simple_pipeline(coh, oh, &pipeline4, fields, 0, NULL), 3);
+
+	rc = free_pipeline(&pipeline1);
+	assert_rc_equal(rc, 0);
+	rc = free_pipeline(&pipeline3);
+	assert_rc_equal(rc, 0);
+	rc = free_pipeline(&pipeline4);
+	assert_rc_equal(rc, 0);
+
+	rc = daos_obj_close(oh, NULL);
+	assert_rc_equal(rc, 0);
+	rc = daos_cont_close(coh, NULL);
+	assert_rc_equal(rc, 0);
+	rc = daos_cont_destroy(arg->pool.poh, "scan_pipeline_cont", 0, NULL);
+	assert_rc_equal(rc, 0);
+}
+
 #define NR_RECXS	4
 
 void
@@ -2018,6 +2144,8 @@ static const struct CMUnitTest pipeline_tests[] = {
 	 simple_pipeline_arrays, async_disable, NULL},
 	{"DAOS_PIPELINE4: Testing simple pipeline for DFS Entry",
 	 simple_pipeline_dfs, async_disable, NULL},
+	{"DAOS_PIPELINE5: Testing pipeline scan of all the shards at once",
+	 scan_pipeline, async_disable, NULL},
 };
 
 int
@@ -35,6 +35,7 @@ bool                    ts_zero_copy; /* use zero-copy API for VOS */
 daos_unit_oid_t	*ts_uoids;	/* object shard IDs */
 
 bool		ts_in_ult;	/* Run tests in ULT mode */
+bool		ts_obj_clock;	/* CLOCK eviction for object cache */
 static ABT_xstream	abt_xstream;
 
 static int
@@ -577,6 +578,44 @@ pf_query(struct pf_test *ts, struct pf_param *param)
 	return rc;
 }
 
+static int
+pf_obj_cache(struct pf_test *ts, struct pf_param *param)
+{
+	uint64_t	hits, misses;
+	uint64_t	hits_new, misses_new;
+	uint64_t	start = 0;
+	int		i, idx;
+	int		rc = 0;
+
+	rc = objects_open();
+	if (rc)
+		return rc;
+
+	vos_obj_cache_stat(ts_ctx.tsc_coh, &hits, &misses);
+
+	TS_TIME_START(&param->pa_duration, start);
+	for (i = 0; i < param->pa_obj_nr; i++) {
+		idx = ts_random ? rand() % param->pa_obj_nr : i;
+		rc = vos_obj_cache_probe(ts_ctx.tsc_coh, ts_uoids[idx]);
+		if (rc != 0 && rc != -DER_NONEXIST)
+			break;
+		rc = 0;
+	}
+	TS_TIME_END(&param->pa_duration, start);
+	if (rc)
+		return rc;
+
+	vos_obj_cache_stat(ts_ctx.tsc_coh, &hits_new, &misses_new);
+	hits   = hits_new - hits;
+	misses = misses_new - misses;
+	if (param->pa_perf || param->pa_verbose)
+		fprintf(stdout, "\tobject cache : hits "DF_U64", misses "DF_U64
+			", hit ratio %.2f%%\n", hits, misses,
+			hits + misses == 0 ? 0.0 : 100.0 * hits / (hits + misses));
+
+	return objects_close();
+}
+
 /**
  * Example: "U;p Q;p;"
  * 'U' is update test.  Integer dkey required
@@ -585,6 +624,9 @@ pf_query(struct pf_test *ts, struct pf_param *param)
  * 'Q' is query test
  *	'p': parameter of query and it means outputting performance result
  *	'v' enables verbosity
+ *
+ * 'O' is object cache test, it holds and releases each object
+ *	'p': parameter of object cache test, it outputs hold/release latency and hit ratio
  */
 static int
 pf_parse_query(char *str, struct pf_param *pa, char **strp)
@@ -688,6 +730,12 @@ struct pf_test pf_tests[] = {
 		.ts_parse	= pf_parse_query,
 		.ts_func	= pf_query,
 	},
+	{
+		.ts_code	= 'O',
+		.ts_name	= "OBJ CACHE",
+		.ts_parse	= pf_parse_query,
+		.ts_func	= pf_obj_cache,
+	},
 	{
 		.ts_code	= 'P',
 		.ts_name	= "PUNCH",
@@ -731,6 +779,7 @@ const char perf_vos_usage[] = "\n"
 			      "-I	Use constant akey.  Required for QUERY test.\n\n"
 			      "-f	Use a flat DKEY object type\n\n"
 			      "-x	Run each test in an ABT ULT.\n\n"
+			      "-C	Use CLOCK eviction for the object cache.\n\n"
 			      "Examples:\n"
 			      "	$ vos_perf -s 1024k -A -R 'U U;o=4k;s=4k V'\n";
 
@@ -752,10 +801,11 @@ const struct option perf_vos_opts[] = {
     {"flat_dkey", no_argument, NULL, 'f'},
     {"const_akey", no_argument, NULL, 'I'},
     {"abt_ult", no_argument, NULL, 'x'},
+    {"obj_clock", no_argument, NULL, 'C'},
     {NULL, -1, NULL, 0},
 };
 
-const char perf_vos_optstr[] = "D:zifIx";
+const char perf_vos_optstr[] = "D:zifIxC";
 
 int
 main(int argc, char **argv)
@@ -821,6 +871,9 @@ main(int argc, char **argv)
 		case 'x':
 			ts_in_ult = true;
 			break;
+		case 'C':
+			ts_obj_clock = true;
+			break;
 		}
 	}
 	perf_free_opts(ts_opts, ts_optstr);
@@ -905,6 +958,10 @@ main(int argc, char **argv)
 
 	ts_update_or_fetch_fn = vos_update_or_fetch;
 
+	/* object caches are created with the VOS TLS */
+	if (ts_obj_clock)
+		setenv("DAOS_VOS_OBJ_CACHE_CLOCK", "1", 1);
+
 	rc = dts_ctx_init(&ts_ctx, &vos_engine);
 	if (rc)
 		return -1;
@@ -926,6 +983,7 @@ main(int argc, char **argv)
 			"\tvalue type    : %s\n"
 			"\tvalue size    : %u\n"
 			"\tzero copy     : %s\n"
+			"\tobject cache  : %s\n"
 			"\tVOS file      : %s\n",
 			uuid_buf,
 			(unsigned int)(ts_scm_size >> 20),
@@ -939,6 +997,7 @@ main(int argc, char **argv)
 			ts_val_type(),
 			ts_stride,
 			ts_yes_or_no(ts_zero_copy),
+			ts_obj_clock ? "CLOCK" : "LRU",
 			ts_pmem_file);
 	}
 
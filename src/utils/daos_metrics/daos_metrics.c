@@ -55,6 +55,8 @@ print_usage(const char *prog_name)
 	       "\tInclude timer snapshots\n"
 	       "--gauge, -g\n"
 	       "\tInclude gauges\n"
+	       "--loghist, -l\n"
+	       "\tInclude log-linear histograms (sample count and percentiles)\n"
 	       "--read, -r\n"
 	       "\tInclude timestamp of when metric was read\n"
 	       "--reset, -e\n"
@@ -155,6 +157,7 @@ main(int argc, char **argv)
 						       {"timestamp", no_argument, NULL, 't'},
 						       {"snapshot", no_argument, NULL, 's'},
 						       {"gauge", no_argument, NULL, 'g'},
+						       {"loghist", no_argument, NULL, 'l'},
 						       {"iterations", required_argument, NULL, 'i'},
 						       {"path", required_argument, NULL, 'p'},
 						       {"delay", required_argument, NULL, 'D'},
@@ -168,7 +171,7 @@ main(int argc, char **argv)
 						       {"help", no_argument, NULL, 'h'},
 						       {NULL, 0, NULL, 0}};
 
-		opt = getopt_long_only(argc, argv, "S:cCdtsgi:p:D:MmTrj:P:he", long_options, NULL);
+		opt = getopt_long_only(argc, argv, "S:cCdtsgli:p:D:MmTrj:P:he", long_options, NULL);
 		if (opt == -1)
 			break;
 
@@ -194,6 +197,9 @@ main(int argc, char **argv)
 		case 'g':
 			filter |= D_TM_GAUGE | D_TM_STATS_GAUGE;
 			break;
+		case 'l':
+			filter |= D_TM_LOGHIST;
+			break;
 		case 'i':
 			num_iter = atoi(optarg);
 			break;
@@ -237,7 +243,7 @@ main(int argc, char **argv)
 
 	if (filter == 0)
 		filter = D_TM_COUNTER | D_TM_DURATION | D_TM_TIMESTAMP | D_TM_MEMINFO |
-			 D_TM_TIMER_SNAPSHOT | D_TM_GAUGE | D_TM_STATS_GAUGE;
+			 D_TM_TIMER_SNAPSHOT | D_TM_GAUGE | D_TM_STATS_GAUGE | D_TM_LOGHIST;
 
 	if (show_when_read)
 		extra_descriptors |= D_TM_INCLUDE_TIMESTAMP;
@@ -0,0 +1,201 @@
+/*
+ * (C) Copyright 2026 Hewlett Packard Enterprise Development LP
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+
+/*
+ * This utility dumps the sampled RPC traces of the specified I/O Engine as
+ * per-request timelines
+ */
+
+#include <getopt.h>
+#include <string.h>
+#include <daos/io_trace.h>
+#include <gurt/common.h>
+#include <gurt/telemetry_common.h>
+#include <gurt/telemetry_consumer.h>
+
+struct trace_recs {
+	struct d_tm_trace_rec	*tr_recs;
+	uint32_t		 tr_nr;
+	uint32_t		 tr_cap;
+	int			 tr_rc;
+};
+
+static void
+print_usage(const char *prog_name)
+{
+	printf("Usage: %s [optional arguments]\n"
+	       "\n"
+	       "Dump the RPCs sampled by an I/O Engine started with DAOS_IO_TRACE_SAMPLE=N "
+	       "as per-request timelines\n"
+	       "\n"
+	       "--srv_idx, -S\n"
+	       "\tShow traces from this I/O Engine local index "
+	       "(default 0)\n"
+	       "--path, -p\n"
+	       "\tDump the trace rings at or below the specified path\n"
+	       "\tDefault is " IO_TRACE_DIR "\n"
+	       "--id, -i\n"
+	       "\tOnly dump the RPC with this id\n"
+	       "--help, -h\n"
+	       "\tThis help text\n",
+	       prog_name);
+}
+
+static void
+iter_collect(struct d_tm_context *ctx, struct d_tm_node_t *node, int level, char *path,
+	     int format, int opt_fields, void *arg)
+{
+	struct trace_recs	*tr = arg;
+	struct d_tm_trace_rec	*recs;
+	uint32_t		 nr;
+	int			 rc;
+
+	if (tr->tr_rc != 0)
+		return;
+
+	rc = d_tm_get_trace(ctx, NULL, &nr, node);
+	if (rc != 0 || nr == 0)
+		goto out;
+
+	if (tr->tr_nr + nr > tr->tr_cap) {
+		D_REALLOC_ARRAY(recs, tr->tr_recs, tr->tr_cap, tr->tr_nr + nr);
+		if (recs == NULL)
+			D_GOTO(out, rc = -DER_NOMEM);
+		tr->tr_recs = recs;
+		tr->tr_cap  = tr->tr_nr + nr;
+	}
+
+	rc = d_tm_get_trace(ctx, &tr->tr_recs[tr->tr_nr], &nr, node);
+	if (rc == 0)
+		tr->tr_nr += nr;
+out:
+	/* Other errors only skip this ring */
+	if (rc == -DER_NOMEM)
+		tr->tr_rc = rc;
+}
+
+static int
+rec_cmp(const void *a, const void *b)
+{
+	const struct d_tm_trace_rec *ra = a;
+	const struct d_tm_trace_rec *rb = b;
+
+	if (ra->dtr_id != rb->dtr_id)
+		return ra->dtr_id < rb->dtr_id ? -1 : 1;
+	if (ra->dtr_opc != rb->dtr_opc)
+		return ra->dtr_opc < rb->dtr_opc ? -1 : 1;
+	if (ra->dtr_ts != rb->dtr_ts)
+		return ra->dtr_ts < rb->dtr_ts ? -1 : 1;
+	return 0;
+}
+
+/* Records of the same RPC are adjacent after sorting, print them as one timeline */
+static void
+print_timelines(struct trace_recs *tr, bool filter_id, uint64_t id)
+{
+	struct d_tm_trace_rec	*rec;
+	struct d_tm_trace_rec	*first;
+	uint32_t		 i, j;
+
+	qsort(tr->tr_recs, tr->tr_nr, sizeof(*tr->tr_recs), rec_cmp);
+
+	for (i = 0; i < tr->tr_nr; i = j) {
+		first = &tr->tr_recs[i];
+		for (j = i + 1; j < tr->tr_nr; j++) {
+			rec = &tr->tr_recs[j];
+			if (rec->dtr_id != first->dtr_id || rec->dtr_opc != first->dtr_opc)
+				break;
+		}
+
+		if (filter_id && first->dtr_id != id)
+			continue;
+
+		printf("rpcid: 0x%lx, opc: 0x%x, total: %.3f us\n", first->dtr_id, first->dtr_opc,
+		       (tr->tr_recs[j - 1].dtr_ts - first->dtr_ts) / 1000.0);
+		for (rec = first; rec < &tr->tr_recs[j]; rec++)
+			printf("\t%-12s %12.3f us  (+%.3f us)\n",
+			       io_trace_phase2name(rec->dtr_phase),
+			       (rec->dtr_ts - first->dtr_ts) / 1000.0,
+			       rec == first ? 0.0 : (rec->dtr_ts - rec[-1].dtr_ts) / 1000.0);
+		printf("\n");
+	}
+}
+
+int
+main(int argc, char **argv)
+{
+	char			 dirname[D_TM_MAX_NAME_LEN] = IO_TRACE_DIR;
+	struct trace_recs	 tr = { 0 };
+	struct d_tm_context	*ctx = NULL;
+	struct d_tm_node_t	*node;
+	uint64_t		 id = 0;
+	bool			 filter_id = false;
+	int			 srv_idx = 0;
+	int			 opt;
+	int			 rc = 0;
+
+	/********************* Parse user arguments *********************/
+	while (1) {
+		static struct option long_options[] = {{"srv_idx", required_argument, NULL, 'S'},
+						       {"path", required_argument, NULL, 'p'},
+						       {"id", required_argument, NULL, 'i'},
+						       {"help", no_argument, NULL, 'h'},
+						       {NULL, 0, NULL, 0}};
+
+		opt = getopt_long_only(argc, argv, "S:p:i:h", long_options, NULL);
+		if (opt == -1)
+			break;
+
+		switch (opt) {
+		case 'S':
+			srv_idx = atoi(optarg);
+			break;
+		case 'p':
+			snprintf(dirname, sizeof(dirname), "%s", optarg);
+			break;
+		case 'i':
+			id = strtoull(optarg, NULL, 0);
+			filter_id = true;
+			break;
+		case 'h':
+		case '?':
+		default:
+			print_usage(argv[0]);
+			exit(0);
+		}
+	}
+
+	ctx = d_tm_open(srv_idx);
+	if (ctx == NULL) {
+		printf("Unable to attach to the shared memory for the server index: %d"
+		       "\nMake sure to run the I/O Engine with the same index to "
+		       "initialize the shared memory and populate it with metrics.\n"
+		       "Verify user/group settings match those that started the I/O "
+		       "Engine.\n",
+		       srv_idx);
+		return -1;
+	}
+
+	node = d_tm_find_metric(ctx, dirname);
+	if (node == NULL) {
+		printf("No traces found at: '%s', is DAOS_IO_TRACE_SAMPLE set for the engine?\n",
+		       dirname);
+		D_GOTO(out, rc = 0);
+	}
+
+	d_tm_iterate(ctx, node, 0, D_TM_TRACE, NULL, D_TM_STANDARD, 0, iter_collect, &tr);
+	rc = tr.tr_rc;
+	if (rc != 0) {
+		printf("Failed to read traces: " DF_RC "\n", DP_RC(rc));
+		goto out;
+	}
+
+	print_timelines(&tr, filter_id, id);
+out:
+	D_FREE(tr.tr_recs);
+	d_tm_close(&ctx);
+	return rc != 0 ? -1 : 0;
+}
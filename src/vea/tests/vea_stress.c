@@ -1,5 +1,6 @@
 /**
  * (C) Copyright 2021-2023 Intel Corporation.
+ * (C) Copyright 2026 Hewlett Packard Enterprise Development LP
  *
  * SPDX-License-Identifier: BSD-2-Clause-Patent
  */
@@ -25,6 +26,9 @@ unsigned int cont_per_pool	= 1;
 unsigned int obj_per_cont	= 100;
 unsigned int test_duration	= (2 * 60);		/* 2 mins */
 unsigned int upd_blks_max	= 256;			/* 1MB by default */
+unsigned int upd_blks_min	= 1;
+bool upd_blks_pow2;					/* power of two update size */
+bool mag_enabled;					/* enable VEA magazines */
 unsigned int rand_seed;
 bool loading_test;					/* test loading pool */
 
@@ -43,11 +47,15 @@ enum {
 #define VS_MERGE_CNT_MAX	10		/* extents */
 #define VS_AGG_BLKS_MAX		1024		/* 4MB */
 
+#define VS_LAT_LINEAR		1024		/* 1us granularity below 1ms */
+#define VS_LAT_BUCKETS		(VS_LAT_LINEAR + 22)
+
 struct vs_perf_cntr {
 	uint64_t	vpc_count;		/* sample counter */
 	uint64_t	vpc_tot;		/* total us */
 	uint32_t	vpc_max;		/* max us */
 	uint32_t	vpc_min;		/* min us */
+	uint64_t	vpc_hist[VS_LAT_BUCKETS];	/* latency histogram */
 };
 
 enum {
@@ -90,10 +98,46 @@ struct vea_stress_pool {
 	uint64_t			 vsp_free_blks;		/* free blocks */
 	uint64_t			 vsp_alloc_blks;	/* allocated blocks */
 	struct vs_perf_cntr		 vsp_cntr[VS_OP_MAX];
+	struct vs_perf_cntr		 vsp_intvl_cntr;	/* reserve in interval */
 	struct vea_stress_cont		 vsp_conts[0];
 };
 
+/* Linear buckets below 1ms, log2 buckets above */
+static inline unsigned int
+vs_lat2bucket(uint64_t lat)
+{
+	unsigned int bucket;
+
+	if (lat < VS_LAT_LINEAR)
+		return lat;
+
+	bucket = VS_LAT_LINEAR + (63 - __builtin_clzll(lat)) - 10;
+	return min(bucket, VS_LAT_BUCKETS - 1);
+}
+
+/* Upper bound of the bucket */
+static inline uint64_t
+vs_bucket2lat(unsigned int bucket)
+{
+	if (bucket < VS_LAT_LINEAR)
+		return bucket;
+
+	return (2ULL << (bucket - VS_LAT_LINEAR + 10)) - 1;
+}
+
 static void
+vs_counter_add(struct vs_perf_cntr *cntr, uint64_t elapsed)
+{
+	if (cntr->vpc_count == 0 || cntr->vpc_min > elapsed)
+		cntr->vpc_min = elapsed;
+	cntr->vpc_count++;
+	cntr->vpc_tot += elapsed;
+	if (cntr->vpc_max < elapsed)
+		cntr->vpc_max = elapsed;
+	cntr->vpc_hist[vs_lat2bucket(elapsed)]++;
+}
+
+static uint64_t
 vs_counter_inc(struct vs_perf_cntr *cntr, uint64_t ts)
 {
 	uint64_t elapsed = daos_getutime();
@@ -103,12 +147,28 @@ vs_counter_inc(struct vs_perf_cntr *cntr, uint64_t ts)
 	else
 		elapsed = 0;
 
-	cntr->vpc_count++;
-	cntr->vpc_tot += elapsed;
-	if (cntr->vpc_max < elapsed)
-		cntr->vpc_max = elapsed;
-	if (cntr->vpc_min > elapsed)
-		cntr->vpc_min = elapsed;
+	vs_counter_add(cntr, elapsed);
+	return elapsed;
+}
+
+/* Latency percentile, @pct is in per mille */
+static uint64_t
+vs_counter_pct(struct vs_perf_cntr *cntr, unsigned int pct)
+{
+	uint64_t	target, sum = 0;
+	int		i;
+
+	if (cntr->vpc_count == 0)
+		return 0;
+
+	target = (cntr->vpc_count * pct + 999) / 1000;
+	for (i = 0; i < VS_LAT_BUCKETS; i++) {
+		sum += cntr->vpc_hist[i];
+		if (sum >= target)
+			return min(vs_bucket2lat(i), cntr->vpc_max);
+	}
+
+	return cntr->vpc_max;
 }
 
 static bool
@@ -271,6 +331,21 @@ get_random_count(unsigned int max)
 	return cnt == 0 ? 1 : cnt;
 }
 
+static inline unsigned int
+get_update_blks(void)
+{
+	unsigned int blk_cnt;
+
+	blk_cnt = upd_blks_min + rand() % (upd_blks_max - upd_blks_min + 1);
+	if (upd_blks_pow2) {
+		blk_cnt = 1U << (31 - __builtin_clz(blk_cnt));
+		if (blk_cnt < upd_blks_min)
+			blk_cnt <<= 1;
+	}
+
+	return blk_cnt;
+}
+
 static inline struct vea_stress_cont *
 pick_update_cont(struct vea_stress_pool *vs_pool)
 {
@@ -297,7 +372,7 @@ vs_update(struct vea_stress_pool *vs_pool)
 	d_list_t		 r_list, a_list;
 	struct vea_resrvd_ext	*rsrvd, *dup;
 	unsigned int		 blk_cnt, rsrv_cnt, alloc_blks = 0;
-	uint64_t		 cur_ts;
+	uint64_t		 cur_ts, elapsed;
 	int			 i, rc;
 
 	vs_cont = pick_update_cont(vs_pool);
@@ -311,7 +386,7 @@ vs_update(struct vea_stress_pool *vs_pool)
 
 	rsrv_cnt = get_random_count(VS_RSRV_CNT_MAX);
 	for (i = 0; i < rsrv_cnt; i++) {
-		blk_cnt = get_random_count(upd_blks_max);
+		blk_cnt = get_update_blks();
 
 		cur_ts = daos_getutime();
 		rc = vea_reserve(vs_pool->vsp_vsi, blk_cnt, hint, &r_list);
@@ -319,7 +394,8 @@ vs_update(struct vea_stress_pool *vs_pool)
 			fprintf(stderr, "failed to reserve %u blks for io\n", blk_cnt);
 			goto error;
 		}
-		vs_counter_inc(&vs_pool->vsp_cntr[VS_OP_RESERVE], cur_ts);
+		elapsed = vs_counter_inc(&vs_pool->vsp_cntr[VS_OP_RESERVE], cur_ts);
+		vs_counter_add(&vs_pool->vsp_intvl_cntr, elapsed);
 
 		/*
 		 * Reserved list will be freed on publish, duplicate it to track the
@@ -562,7 +638,8 @@ static bool
 vs_stop_run(struct vea_stress_pool *vs_pool, int rc)
 {
 	static uint64_t	last_print_ts;
-	uint64_t	now = daos_wallclock_secs(), heap_bytes;
+	uint64_t	now = daos_wallclock_secs(), heap_bytes, frags;
+	struct vs_perf_cntr *intvl = &vs_pool->vsp_intvl_cntr;
 	struct vea_stat	stat;
 	unsigned int	duration = 0;
 	bool		stop;
@@ -600,12 +677,22 @@ vs_stop_run(struct vea_stress_pool *vs_pool, int rc)
 		return stop;
 	}
 
-	fprintf(stdout, "free_blks:["DF_12U64","DF_12U64"] frags_l:"DF_12U64" frags_s:"DF_12U64" "
-		"frags_a:"DF_12U64" frags_bitmap:"DF_12U64" r_hint:"DF_12U64" r_large:"DF_12U64" "
-		"r_small:"DF_12U64" r_bitmap:"DF_12U64"\n",
-		stat.vs_free_persistent, stat.vs_free_transient, stat.vs_frags_large,
+	fprintf(stdout, "free_blks:["DF_12U64","DF_12U64","DF_12U64"] frags_l:"DF_12U64" "
+		"frags_s:"DF_12U64" frags_a:"DF_12U64" frags_bitmap:"DF_12U64" r_hint:"DF_12U64" "
+		"r_large:"DF_12U64" r_small:"DF_12U64" r_bitmap:"DF_12U64" r_mag:"DF_12U64"\n",
+		stat.vs_free_persistent, stat.vs_free_transient, stat.vs_free_mag, stat.vs_frags_large,
 		stat.vs_frags_small, stat.vs_frags_aging, stat.vs_frags_bitmap,
-		stat.vs_resrv_hint, stat.vs_resrv_large, stat.vs_resrv_small, stat.vs_resrv_bitmap);
+		stat.vs_resrv_hint, stat.vs_resrv_large, stat.vs_resrv_small, stat.vs_resrv_bitmap,
+		stat.vs_resrv_mag);
+
+	/* Average free extent size indicates how fragmented the free space is */
+	frags = stat.vs_frags_large + stat.vs_frags_small;
+	fprintf(stdout, "avg_frag_blks:"DF_12U64" reserve(us) samples:"DF_12U64" p50:%-8"PRIu64" "
+		"p90:%-8"PRIu64" p99:%-8"PRIu64" p99.9:%-8"PRIu64" max:%u\n",
+		frags ? stat.vs_free_transient / frags : 0, intvl->vpc_count,
+		vs_counter_pct(intvl, 500), vs_counter_pct(intvl, 900), vs_counter_pct(intvl, 990),
+		vs_counter_pct(intvl, 999), intvl->vpc_max);
+	memset(intvl, 0, sizeof(*intvl));
 
 	return stop;
 }
@@ -876,6 +963,9 @@ vs_init(void)
 const char vs_stress_options[] =
 "Available options are:\n"
 "-b <block_nr>		max blocks per update\n"
+"-m <block_nr>		min blocks per update\n"
+"-p			power of two update size\n"
+"-M			enable VEA magazines\n"
 "-C <capacity>		pool capacity\n"
 "-c <cont_nr>		container nr\n"
 "-d <duration>		test duration in seconds\n"
@@ -936,6 +1026,9 @@ int main(int argc, char **argv)
 {
 	static struct option long_ops[] = {
 		{ "block_max",	required_argument,	NULL,	'b' },
+		{ "block_min",	required_argument,	NULL,	'm' },
+		{ "pow2",	no_argument,		NULL,	'p' },
+		{ "magazine",	no_argument,		NULL,	'M' },
 		{ "capacity",	required_argument,	NULL,	'C' },
 		{ "cont_nr",	required_argument,	NULL,	'c' },
 		{ "duration",	required_argument,	NULL,	'd' },
@@ -953,7 +1046,7 @@ int main(int argc, char **argv)
 
 	rand_seed = (unsigned int)(time(NULL) & 0xFFFFFFFFUL);
 	memset(pool_file, 0, sizeof(pool_file));
-	while ((rc = getopt_long(argc, argv, "b:C:c:d:f:H:lo:s:h", long_ops, NULL)) != -1) {
+	while ((rc = getopt_long(argc, argv, "b:m:pMC:c:d:f:H:lo:s:h", long_ops, NULL)) != -1) {
 		switch (rc) {
 		case 'b':
 			upd_blks_max = strtoull(optarg, &endp, 0);
@@ -963,6 +1056,20 @@ int main(int argc, char **argv)
 				return -1;
 			}
 			break;
+		case 'm':
+			upd_blks_min = strtoull(optarg, &endp, 0);
+			if (*endp != '\0' || upd_blks_min == 0) {
+				printf("invalid update min blocks\n");
+				print_usage();
+				return -1;
+			}
+			break;
+		case 'p':
+			upd_blks_pow2 = true;
+			break;
+		case 'M':
+			mag_enabled = true;
+			break;
 		case 'C':
 			pool_capacity = strtoul(optarg, &endp, 0);
 			pool_capacity = val_unit(pool_capacity, *endp);
@@ -1002,12 +1109,25 @@ int main(int argc, char **argv)
 	if (strlen(pool_file) == 0)
 		strncpy(pool_file, "/mnt/daos/vea_stress_pool", sizeof(pool_file));
 
+	if (upd_blks_min > upd_blks_max) {
+		printf("min blocks %u is larger than max blocks %u\n", upd_blks_min, upd_blks_max);
+		print_usage();
+		return -1;
+	}
+
+	/* Magazines are disabled by default for non-server mode */
+	if (mag_enabled)
+		setenv("DAOS_VEA_MAGAZINE", "1", 1);
+
 	fprintf(stdout, "Start VEA stress test\n");
 	fprintf(stdout, "pool_file  : %s\n", pool_file);
 	fprintf(stdout, "capacity   : "DF_U64" bytes\n", pool_capacity);
 	fprintf(stdout, "heap_size  : "DF_U64" bytes\n", heap_size);
 	fprintf(stdout, "cont_nr    : %u\n", cont_per_pool);
 	fprintf(stdout, "obj_nr     : %u\n", obj_per_cont);
+	fprintf(stdout, "update_blks: [%u, %u]%s\n", upd_blks_min, upd_blks_max,
+		upd_blks_pow2 ? " power of two" : "");
+	fprintf(stdout, "magazine   : %s\n", mag_enabled ? "enabled" : "disabled");
 	fprintf(stdout, "duration   : %u secs\n", test_duration);
 	fprintf(stdout, "rand_seed  : %u\n\n", rand_seed);
 
@@ -1035,14 +1155,18 @@ int main(int argc, char **argv)
 		fprintf(stdout, "VEA stress test succeeded\n");
 
 	fprintf(stdout, "\n");
-	fprintf(stdout, "%-11s %-12s %-12s %-10s %-10s %-10s\n",
-		"Operation", "Samples", "Time(us)", "Min(us)", "Max(us)", "Avg(us)");
+	fprintf(stdout, "%-11s %-12s %-12s %-10s %-10s %-10s %-10s %-10s %-10s\n",
+		"Operation", "Samples", "Time(us)", "Min(us)", "Max(us)", "Avg(us)", "P50(us)",
+		"P99(us)", "P99.9(us)");
 	for (i = 0; i < VS_OP_MAX; i++) {
 		struct vs_perf_cntr *cntr = &vs_pool->vsp_cntr[i];
 
-		fprintf(stdout, "%-11s "DF_12U64" "DF_12U64" %-10u %-10u %-10u\n",
+		fprintf(stdout, "%-11s "DF_12U64" "DF_12U64" %-10u %-10u %-10u %-10"PRIu64" "
+			"%-10"PRIu64" %-10"PRIu64"\n",
 			vs_op2str(i), cntr->vpc_count, cntr->vpc_tot, cntr->vpc_min, cntr->vpc_max,
-			cntr->vpc_count ? (unsigned int)(cntr->vpc_tot / cntr->vpc_count) : 0);
+			cntr->vpc_count ? (unsigned int)(cntr->vpc_tot / cntr->vpc_count) : 0,
+			vs_counter_pct(cntr, 500), vs_counter_pct(cntr, 990),
+			vs_counter_pct(cntr, 999));
 	}
 
 teardown:
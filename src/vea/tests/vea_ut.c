@@ -1,5 +1,6 @@
 /**
  * (C) Copyright 2018-2024 Intel Corporation.
+ * (C) Copyright 2026 Hewlett Packard Enterprise Development LP
  *
  * SPDX-License-Identifier: BSD-2-Clause-Patent
  */
@@ -1584,6 +1585,191 @@ ut_reclaim_unused_bitmap(void **state)
 	ut_teardown(&args);
 }
 
+static inline bool
+ut_in_region(struct vea_compact_info *vci, struct vea_resrvd_ext *ext)
+{
+	return ext->vre_blk_off < vci->vci_blk_off + vci->vci_blk_cnt &&
+	       ext->vre_blk_off + ext->vre_blk_cnt > vci->vci_blk_off;
+}
+
+static void
+ut_compaction(void **state)
+{
+	struct vea_ut_args	 args;
+	struct vea_unmap_context unmap_ctxt = { 0 };
+	struct vea_hint_df	 hint_df = { 0 };
+	struct vea_hint_context	*hint;
+	struct vea_compact_info	*vci;
+	struct vea_resrvd_ext	*ext;
+	d_list_t		*keep_list, *cancel_list, *r_list;
+	uint64_t		 capacity = 1llu << 28; /* 256 MiB */
+	uint32_t		 block_size = 4096;
+	uint32_t		 header_blocks = 1;
+	bool			 keep = true, in_region = false;
+	int			 i, rc;
+
+	print_message("Test free space compaction\n");
+	ut_setup(&args);
+	rc = vea_format(&args.vua_umm, &args.vua_txd, args.vua_md, block_size,
+			header_blocks, capacity, NULL, NULL, false, VEA_COMPAT_MASK);
+	assert_rc_equal(rc, 0);
+
+	rc = vea_load(&args.vua_umm, &args.vua_txd, args.vua_md, &unmap_ctxt,
+		      NULL, &args.vua_vsi);
+	assert_rc_equal(rc, 0);
+
+	/* Sequential reserves through a hint, keep 100 blocks and free the next 200 blocks */
+	rc = vea_hint_load(&hint_df, &hint);
+	assert_rc_equal(rc, 0);
+
+	keep_list = &args.vua_resrvd_list[0];
+	cancel_list = &args.vua_resrvd_list[1];
+	while (rc == 0) {
+		rc = vea_reserve(args.vua_vsi, keep ? 100 : 200, hint,
+				 keep ? keep_list : cancel_list);
+		keep = !keep;
+	}
+	assert_rc_equal(rc, -DER_NOSPACE);
+	vea_hint_unload(hint);
+
+	rc = umem_tx_begin(&args.vua_umm, &args.vua_txd);
+	assert_int_equal(rc, 0);
+	rc = vea_tx_publish(args.vua_vsi, NULL, keep_list);
+	assert_int_equal(rc, 0);
+	rc = umem_tx_commit(&args.vua_umm);
+	assert_int_equal(rc, 0);
+
+	rc = vea_cancel(args.vua_vsi, NULL, cancel_list);
+	assert_rc_equal(rc, 0);
+
+	/* Pick the compaction target, the scan takes a few flushes with small credits */
+	vci = &args.vua_vsi->vsi_compact;
+	vci->vci_enabled = true;
+	vci->vci_budget_max = 1000;
+	vci->vci_check_time = 0;
+	vci->vci_scan_credits = 16;
+	compact_check(args.vua_vsi);
+	assert_true(vci->vci_scan.vcs_active);
+	assert_int_equal(vci->vci_blk_cnt, 0);
+
+	for (i = 1; vci->vci_scan.vcs_active; i++)
+		compact_check(args.vua_vsi);
+	assert_true(i > 2);
+
+	print_message("frag index:%u, target region ["DF_U64", %u]\n", vci->vci_frag_index,
+		      vci->vci_blk_off, vci->vci_blk_cnt);
+	assert_true(vci->vci_frag_index >= VEA_COMPACT_FRAG_THRESH);
+	assert_int_equal(vci->vci_blk_cnt, VEA_COMPACT_REGION_BLKS);
+	assert_int_equal(vci->vci_blk_off % VEA_COMPACT_REGION_BLKS, 0);
+	assert_int_equal(vci->vci_budget, 1000);
+
+	/* Budget accounting */
+	assert_true(vea_compact_needed(args.vua_vsi, vci->vci_blk_off, 600));
+	assert_false(vea_compact_needed(args.vua_vsi, vci->vci_blk_off + vci->vci_blk_cnt, 1));
+	vea_compact_done(args.vua_vsi, 600);
+	assert_int_equal(vci->vci_budget, 400);
+	assert_int_equal(vci->vci_relocated, 600);
+	assert_false(vea_compact_needed(args.vua_vsi, vci->vci_blk_off, 600));
+	assert_true(vea_compact_needed(args.vua_vsi, vci->vci_blk_off, 400));
+
+	/* Reserves don't land in the target region while there is free space elsewhere */
+	r_list = &args.vua_resrvd_list[2];
+	for (i = 0; i < 32; i++) {
+		rc = vea_reserve(args.vua_vsi, 200, NULL, r_list);
+		assert_rc_equal(rc, 0);
+		ext = d_list_entry(r_list->prev, struct vea_resrvd_ext, vre_link);
+		assert_false(ut_in_region(vci, ext));
+	}
+
+	/* The target region is used when nothing else left */
+	while (rc == 0) {
+		rc = vea_reserve(args.vua_vsi, 200, NULL, r_list);
+		if (rc == 0) {
+			ext = d_list_entry(r_list->prev, struct vea_resrvd_ext, vre_link);
+			in_region |= ut_in_region(vci, ext);
+		}
+	}
+	assert_rc_equal(rc, -DER_NOSPACE);
+	assert_true(in_region);
+	assert_false(vci->vci_no_excl);
+
+	vea_unload(args.vua_vsi);
+	ut_teardown(&args);
+}
+
+static void
+ut_magazine(void **state)
+{
+	struct vea_ut_args	 args;
+	struct vea_unmap_context unmap_ctxt = { 0 };
+	struct vea_stat		 stat;
+	struct vea_resrvd_ext	*ext;
+	d_list_t		*r_list;
+	uint64_t		 capacity = 1llu << 28; /* 256 MiB */
+	uint64_t		 free_blks;
+	uint32_t		 block_size = 4096;
+	uint32_t		 header_blocks = 1;
+	uint32_t		 blk_cnt = 256; /* 1MiB size class */
+	uint32_t		 nr;
+	int			 rc;
+
+	print_message("Test magazine reserve and accounting\n");
+	ut_setup(&args);
+	rc = vea_format(&args.vua_umm, &args.vua_txd, args.vua_md, block_size,
+			header_blocks, capacity, NULL, NULL, false, VEA_COMPAT_MASK);
+	assert_rc_equal(rc, 0);
+
+	d_setenv("DAOS_VEA_MAGAZINE", "1", 1);
+	rc = vea_load(&args.vua_umm, &args.vua_txd, args.vua_md, &unmap_ctxt,
+		      NULL, &args.vua_vsi);
+	d_unsetenv("DAOS_VEA_MAGAZINE");
+	assert_rc_equal(rc, 0);
+	assert_true(args.vua_vsi->vsi_mag_enabled);
+
+	rc = vea_query(args.vua_vsi, NULL, &stat);
+	assert_rc_equal(rc, 0);
+	free_blks = stat.vs_free_transient;
+	assert_int_equal(stat.vs_free_mag, 0);
+
+	r_list = &args.vua_resrvd_list[0];
+	rc = vea_reserve(args.vua_vsi, blk_cnt, NULL, r_list);
+	assert_rc_equal(rc, 0);
+	ext = d_list_entry(r_list->next, struct vea_resrvd_ext, vre_link);
+
+	/* The refill isn't counted as a reserve, the rest of the batch is cached free */
+	nr = min(VEA_MAG_REFILL_BLKS / blk_cnt, VEA_MAG_SLOTS);
+	rc = vea_query(args.vua_vsi, NULL, &stat);
+	assert_rc_equal(rc, 0);
+	assert_int_equal(stat.vs_resrv_mag, 1);
+	assert_int_equal(stat.vs_resrv_large + stat.vs_resrv_small, 0);
+	assert_int_equal(stat.vs_free_mag, (nr - 1) * blk_cnt);
+	assert_int_equal(stat.vs_free_transient, free_blks - blk_cnt);
+
+	/* The reserved extent is allocated, the adjacent cached one isn't */
+	rc = vea_verify_alloc(args.vua_vsi, true, ext->vre_blk_off, blk_cnt, false);
+	assert_rc_equal(rc, 0);
+	rc = vea_verify_alloc(args.vua_vsi, true, ext->vre_blk_off + blk_cnt, blk_cnt, false);
+	assert_rc_equal(rc, 1);
+
+	/* The next reserve of the size class is served by the magazine */
+	rc = vea_reserve(args.vua_vsi, blk_cnt, NULL, r_list);
+	assert_rc_equal(rc, 0);
+	ext = d_list_entry(r_list->prev, struct vea_resrvd_ext, vre_link);
+	rc = vea_verify_alloc(args.vua_vsi, true, ext->vre_blk_off, blk_cnt, false);
+	assert_rc_equal(rc, 0);
+
+	rc = vea_query(args.vua_vsi, NULL, &stat);
+	assert_rc_equal(rc, 0);
+	assert_int_equal(stat.vs_resrv_mag, 2);
+	assert_int_equal(stat.vs_free_mag, (nr - 2) * blk_cnt);
+
+	rc = vea_cancel(args.vua_vsi, NULL, r_list);
+	assert_rc_equal(rc, 0);
+
+	vea_unload(args.vua_vsi);
+	ut_teardown(&args);
+}
+
 static const struct CMUnitTest vea_uts[] = {
 	{ "vea_format", ut_format, NULL, NULL},
 	{ "vea_load", ut_load, NULL, NULL},
@@ -1612,7 +1798,9 @@ static const struct CMUnitTest vea_uts[] = {
 	{ "vea_free_invalid_space", ut_free_invalid_space, NULL, NULL},
 	{ "vea_interleaved_ops", ut_interleaved_ops, NULL, NULL},
 	{ "vea_fragmentation", ut_fragmentation, NULL, NULL},
-	{ "vea_reclaim_unused_bitmap", ut_reclaim_unused_bitmap, NULL, NULL}
+	{ "vea_reclaim_unused_bitmap", ut_reclaim_unused_bitmap, NULL, NULL},
+	{ "vea_compaction", ut_compaction, NULL, NULL},
+	{ "vea_magazine", ut_magazine, NULL, NULL}
 };
 
 int main(int argc, char **argv)
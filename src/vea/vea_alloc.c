@@ -1,5 +1,6 @@
 /**
  * (C) Copyright 2018-2023 Intel Corporation.
+ * (C) Copyright 2026 Hewlett Packard Enterprise Development LP
  *
  * SPDX-License-Identifier: BSD-2-Clause-Patent
  */
@@ -70,6 +71,10 @@ reserve_hint(struct vea_space_info *vsi, uint32_t blk_cnt,
 	if (entry->vee_ext.vfe_blk_cnt < vfe.vfe_blk_cnt)
 		return 0;
 
+	/* Don't refill the region being compacted */
+	if (compact_excluded(vsi, vfe.vfe_blk_off, vfe.vfe_blk_cnt))
+		return 0;
+
 	rc = compound_alloc_extent(vsi, &vfe, entry);
 	if (rc)
 		return rc;
@@ -87,14 +92,66 @@ reserve_hint(struct vea_space_info *vsi, uint32_t blk_cnt,
 
 static int
 reserve_small(struct vea_space_info *vsi, uint32_t blk_cnt,
-	      struct vea_resrvd_ext *resrvd);
+	      struct vea_resrvd_ext *resrvd, unsigned int flags);
 static int
 reserve_size_tree(struct vea_space_info *vsi, uint32_t blk_cnt,
-		  struct vea_resrvd_ext *resrvd);
+		  struct vea_resrvd_ext *resrvd, unsigned int flags);
+
+static inline void
+inc_resrv_stats(struct vea_space_info *vsi, unsigned int type, unsigned int flags)
+{
+	if (!(flags & VEA_FL_NO_STATS))
+		inc_stats(vsi, type, 1);
+}
+
+/*
+ * The largest free extent overlaps the region being compacted, reserve from the part
+ * after or before the region.
+ */
+static int
+reserve_extent_excl(struct vea_space_info *vsi, struct vea_extent_entry *entry,
+		    uint32_t blk_cnt, struct vea_resrvd_ext *resrvd, unsigned int flags)
+{
+	struct vea_compact_info	*vci = &vsi->vsi_compact;
+	struct vea_free_extent	 vfe;
+	uint64_t		 ext_end, rgn_end;
+	int			 rc;
+
+	ext_end = entry->vee_ext.vfe_blk_off + entry->vee_ext.vfe_blk_cnt;
+	rgn_end = vci->vci_blk_off + vci->vci_blk_cnt;
+
+	if (ext_end >= rgn_end + blk_cnt) {
+		/* Reserve from the tail, shrink the extent */
+		vfe.vfe_blk_off = ext_end - blk_cnt;
+		extent_free_class_remove(vsi, entry);
+		entry->vee_ext.vfe_blk_cnt -= blk_cnt;
+		rc = extent_free_class_add(vsi, entry);
+		if (rc)
+			return rc;
+	} else if (entry->vee_ext.vfe_blk_off + blk_cnt <= vci->vci_blk_off) {
+		vfe.vfe_blk_off = entry->vee_ext.vfe_blk_off;
+		vfe.vfe_blk_cnt = blk_cnt;
+		rc = compound_alloc_extent(vsi, &vfe, entry);
+		if (rc)
+			return rc;
+	} else {
+		return 0;
+	}
+
+	resrvd->vre_blk_off = vfe.vfe_blk_off;
+	resrvd->vre_blk_cnt = blk_cnt;
+
+	inc_resrv_stats(vsi, STAT_RESRV_LARGE, flags);
+
+	D_DEBUG(DB_IO, "["DF_U64", %u]\n", resrvd->vre_blk_off,
+		resrvd->vre_blk_cnt);
+
+	return 0;
+}
 
 static int
 reserve_extent(struct vea_space_info *vsi, uint32_t blk_cnt,
-	       struct vea_resrvd_ext *resrvd)
+	       struct vea_resrvd_ext *resrvd, unsigned int flags)
 {
 	struct vea_free_class *vfc = &vsi->vsi_class;
 	struct vea_free_extent vfe;
@@ -116,6 +173,9 @@ reserve_extent(struct vea_space_info *vsi, uint32_t blk_cnt,
 	if (entry->vee_ext.vfe_blk_cnt < blk_cnt)
 		return 0;
 
+	if (compact_excluded(vsi, entry->vee_ext.vfe_blk_off, entry->vee_ext.vfe_blk_cnt))
+		return reserve_extent_excl(vsi, entry, blk_cnt, resrvd, flags);
+
 	/*
 	 * If the largest free extent is large enough for splitting, divide it in
 	 * half-and-half then reserve from the second half, otherwise, try to
@@ -163,7 +223,7 @@ reserve_extent(struct vea_space_info *vsi, uint32_t blk_cnt,
 	resrvd->vre_blk_off = vfe.vfe_blk_off;
 	resrvd->vre_blk_cnt = blk_cnt;
 
-	inc_stats(vsi, STAT_RESRV_LARGE, 1);
+	inc_resrv_stats(vsi, STAT_RESRV_LARGE, flags);
 
 	D_DEBUG(DB_IO, "["DF_U64", %u]\n", resrvd->vre_blk_off,
 		resrvd->vre_blk_cnt);
@@ -173,13 +233,13 @@ reserve_extent(struct vea_space_info *vsi, uint32_t blk_cnt,
 
 static int
 reserve_size_tree(struct vea_space_info *vsi, uint32_t blk_cnt,
-		  struct vea_resrvd_ext *resrvd)
+		  struct vea_resrvd_ext *resrvd, unsigned int flags)
 {
 	daos_handle_t		 btr_hdl;
 	struct vea_sized_class	*sc;
 	struct vea_free_extent	 vfe;
 	struct vea_extent_entry	*extent_entry;
-	d_iov_t			 key, val_out;
+	d_iov_t			 key, key_out, val_out;
 	uint64_t		 int_key = blk_cnt;
 	int			 rc;
 
@@ -187,9 +247,11 @@ reserve_size_tree(struct vea_space_info *vsi, uint32_t blk_cnt,
 	D_ASSERT(daos_handle_is_valid(btr_hdl));
 
 	d_iov_set(&key, &int_key, sizeof(int_key));
+next_class:
+	d_iov_set(&key_out, NULL, 0);
 	d_iov_set(&val_out, NULL, 0);
 
-	rc = dbtree_fetch(btr_hdl, BTR_PROBE_GE, DAOS_INTENT_DEFAULT, &key, NULL, &val_out);
+	rc = dbtree_fetch(btr_hdl, BTR_PROBE_GE, DAOS_INTENT_DEFAULT, &key, &key_out, &val_out);
 	if (rc == -DER_NONEXIST)
 		return 0;
 	else if (rc)
@@ -198,8 +260,14 @@ reserve_size_tree(struct vea_space_info *vsi, uint32_t blk_cnt,
 	sc = (struct vea_sized_class *)val_out.iov_buf;
 	D_ASSERT(sc != NULL);
 
-	/* Get the least used item from head */
-	extent_entry = d_list_entry(sc->vsc_extent_lru.next, struct vea_extent_entry, vee_link);
+	/* Get the least used item from head, skip the ones in the region being compacted */
+	d_list_for_each_entry(extent_entry, &sc->vsc_extent_lru, vee_link) {
+		if (!compact_excluded(vsi, extent_entry->vee_ext.vfe_blk_off, blk_cnt))
+			goto found;
+	}
+	int_key = *(uint64_t *)key_out.iov_buf + 1;
+	goto next_class;
+found:
 	D_ASSERT(extent_entry->vee_sized_class == sc);
 	D_ASSERT(extent_entry->vee_ext.vfe_blk_cnt >= blk_cnt);
 
@@ -212,7 +280,7 @@ reserve_size_tree(struct vea_space_info *vsi, uint32_t blk_cnt,
 	resrvd->vre_blk_off = vfe.vfe_blk_off;
 	resrvd->vre_blk_cnt = blk_cnt;
 	resrvd->vre_private = NULL;
-	inc_stats(vsi, STAT_RESRV_SMALL, 1);
+	inc_resrv_stats(vsi, STAT_RESRV_SMALL, flags);
 
 	return 0;
 }
@@ -238,7 +306,7 @@ reserve_bitmap_chunk(struct vea_space_info *vsi, uint32_t blk_cnt,
 	if (blk_cnt >= vsi->vsi_class.vfc_large_thresh)
 		goto extent;
 
-	rc = reserve_size_tree(vsi, blk_cnt, resrvd);
+	rc = reserve_size_tree(vsi, blk_cnt, resrvd, 0);
 	if (rc)
 		return rc;
 
@@ -246,7 +314,7 @@ reserve_bitmap_chunk(struct vea_space_info *vsi, uint32_t blk_cnt,
 		goto done;
 
 extent:
-	rc = reserve_extent(vsi, blk_cnt, resrvd);
+	rc = reserve_extent(vsi, blk_cnt, resrvd, 0);
 	if (resrvd->vre_blk_cnt <= 0)
 		return -DER_NOSPACE;
 done:
@@ -391,7 +459,7 @@ reserve_bitmap(struct vea_space_info *vsi, uint32_t blk_cnt,
 
 static int
 reserve_small(struct vea_space_info *vsi, uint32_t blk_cnt,
-	      struct vea_resrvd_ext *resrvd)
+	      struct vea_resrvd_ext *resrvd, unsigned int flags)
 {
 	int			 rc;
 
@@ -403,27 +471,27 @@ reserve_small(struct vea_space_info *vsi, uint32_t blk_cnt,
 	if (rc || resrvd->vre_blk_cnt > 0)
 		return rc;
 
-	return reserve_size_tree(vsi, blk_cnt, resrvd);
+	return reserve_size_tree(vsi, blk_cnt, resrvd, flags);
 }
 
 int
 reserve_single(struct vea_space_info *vsi, uint32_t blk_cnt,
-	       struct vea_resrvd_ext *resrvd)
+	       struct vea_resrvd_ext *resrvd, unsigned int flags)
 {
 	struct vea_free_class	*vfc = &vsi->vsi_class;
 	int			 rc;
 
 	/* No large free extent available */
 	if (d_binheap_is_empty(&vfc->vfc_heap))
-		return reserve_small(vsi, blk_cnt, resrvd);
+		return reserve_small(vsi, blk_cnt, resrvd, flags);
 
 	if (blk_cnt < vsi->vsi_class.vfc_large_thresh) {
-		rc = reserve_small(vsi, blk_cnt, resrvd);
+		rc = reserve_small(vsi, blk_cnt, resrvd, flags);
 		if (rc || resrvd->vre_blk_cnt > 0)
 			return rc;
 	}
 
-	return reserve_extent(vsi, blk_cnt, resrvd);
+	return reserve_extent(vsi, blk_cnt, resrvd, flags);
 }
 
 static int
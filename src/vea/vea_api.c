@@ -1,6 +1,6 @@
 /**
  * (C) Copyright 2018-2023 Intel Corporation.
- * (C) Copyright 2025 Hewlett Packard Enterprise Development LP
+ * (C) Copyright 2025-2026 Hewlett Packard Enterprise Development LP
  *
  * SPDX-License-Identifier: BSD-2-Clause-Patent
  */
@@ -343,6 +343,8 @@ vea_load(struct umem_instance *umem, struct umem_tx_stage_data *txd,
 	vsi->vsi_flush_scheduled = false;
 	vsi->vsi_unmap_ctxt = *unmap_ctxt;
 	vsi->vsi_metrics = metrics;
+	magazine_init(vsi);
+	compact_init(vsi);
 
 	rc = create_free_class(&vsi->vsi_class, md);
 	if (rc)
@@ -412,6 +414,11 @@ inline_aging_flush(struct vea_space_info *vsi, bool force, uint32_t nr_flush, ui
 	if (nr_flushed)
 		*nr_flushed = 0;
 
+	/* Return the idle magazines to compound index */
+	rc = magazine_drain(vsi, false, NULL);
+	if (rc)
+		DL_ERROR(rc, "Magazine drain failed.");
+
 	/* Don't do inline flush when external flush is specified */
 	if (vsi->vsi_unmap_ctxt.vnc_ext_flush)
 		return;
@@ -431,11 +438,13 @@ inline_aging_flush(struct vea_space_info *vsi, bool force, uint32_t nr_flush, ui
  * Reserve an extent on block device, reserve attempting order:
  *
  * 1. Reserve from the free extent with 'hinted' start offset. (lookup vsi_free_btr)
- * 2. If the largest free extent is large enough for splitting, divide it in
+ * 2. Reserve from the magazine of the size class, the magazine is refilled with a
+ *    batch of consecutive extents through following steps. (lookup vsi_mags)
+ * 3. If the largest free extent is large enough for splitting, divide it in
  *    half-and-half then reserve from the latter half. (lookup vfc_heap). Otherwise;
- * 3. Try to reserve from some small free extent (<= VEA_LARGE_EXT_MB) in best-fit,
+ * 4. Try to reserve from some small free extent (<= VEA_LARGE_EXT_MB) in best-fit,
  *    if it fails, reserve from the largest free extent. (lookup vfc_size_btr)
- * 4. Fail reserve with ENOMEM if all above attempts fail.
+ * 5. Fail reserve with ENOMEM if all above attempts fail.
  */
 int
 vea_reserve(struct vea_space_info *vsi, uint32_t blk_cnt,
@@ -443,6 +452,7 @@ vea_reserve(struct vea_space_info *vsi, uint32_t blk_cnt,
 {
 	struct vea_resrvd_ext	*resrvd;
 	uint32_t		 nr_flushed;
+	uint64_t		 nr_drained;
 	bool			 force = false;
 	int			 rc = 0;
 	bool			 try_hint = true;
@@ -476,24 +486,40 @@ retry:
 			goto done;
 	}
 
+	/* Reserve from the magazine of the size class */
+	rc = reserve_magazine(vsi, blk_cnt, resrvd);
+	if (rc != 0)
+		goto error;
+	else if (resrvd->vre_blk_cnt != 0)
+		goto done;
+
 	/* Reserve from the largest extent or a small extent */
-	rc = reserve_single(vsi, blk_cnt, resrvd);
+	rc = reserve_single(vsi, blk_cnt, resrvd, 0);
 	if (rc != 0)
 		goto error;
 	else if (resrvd->vre_blk_cnt != 0)
 		goto done;
 
-	rc = -DER_NOSPACE;
 	if (!force) {
 		force = true;
-		inline_aging_flush(vsi, force, MAX_FLUSH_FRAGS * 10, &nr_flushed);
-		if (nr_flushed == 0)
+		/* Cached extents could be merged with other free extents */
+		rc = magazine_drain(vsi, force, &nr_drained);
+		if (rc)
 			goto error;
+		inline_aging_flush(vsi, force, MAX_FLUSH_FRAGS * 10, &nr_flushed);
+		if (nr_flushed != 0 || nr_drained != 0)
+			goto retry;
+	}
+
+	/* Only the region being compacted is left */
+	if (vsi->vsi_compact.vci_blk_cnt != 0 && !vsi->vsi_compact.vci_no_excl) {
+		vsi->vsi_compact.vci_no_excl = true;
 		goto retry;
-	} else {
-		goto error;
 	}
+	rc = -DER_NOSPACE;
+	goto error;
 done:
+	vsi->vsi_compact.vci_no_excl = false;
 	D_ASSERT(resrvd->vre_blk_cnt == blk_cnt);
 
 	/* Update hint offset if allocation is from extent */
@@ -510,6 +536,7 @@ done:
 
 	return 0;
 error:
+	vsi->vsi_compact.vci_no_excl = false;
 	D_FREE(resrvd);
 	return rc;
 }
@@ -950,11 +977,15 @@ vea_query(struct vea_space_info *vsi, struct vea_attr *attr,
 				    (void *)&stat->vs_free_transient);
 		if (rc != 0)
 			return rc;
+		stat->vs_free_mag = magazine_free_blocks(vsi);
+		stat->vs_free_transient += stat->vs_free_mag;
 
 		stat->vs_resrv_hint = vsi->vsi_stat[STAT_RESRV_HINT];
 		stat->vs_resrv_large = vsi->vsi_stat[STAT_RESRV_LARGE];
 		stat->vs_resrv_small = vsi->vsi_stat[STAT_RESRV_SMALL];
 		stat->vs_resrv_bitmap = vsi->vsi_stat[STAT_RESRV_BITMAP];
+		stat->vs_resrv_mag = vsi->vsi_stat[STAT_RESRV_MAG];
+		stat->vs_frag_index = compact_frag_index(vsi);
 		stat->vs_frags_large = vsi->vsi_stat[STAT_FRAGS_LARGE];
 		stat->vs_frags_small = vsi->vsi_stat[STAT_FRAGS_SMALL];
 		stat->vs_frags_bitmap = vsi->vsi_stat[STAT_FRAGS_BITMAP];
@@ -967,11 +998,20 @@ vea_query(struct vea_space_info *vsi, struct vea_attr *attr,
 int
 vea_flush(struct vea_space_info *vsi, uint32_t nr_flush, uint32_t *nr_flushed)
 {
+	int	rc;
+
 	if (!umem_tx_none(vsi->vsi_umem)) {
 		D_ERROR("This function isn't supposed to be called in transaction!\n");
 		return -DER_INVAL;
 	}
 
+	rc = magazine_drain(vsi, false, NULL);
+	if (rc)
+		DL_ERROR(rc, "Magazine drain failed.");
+
+	/* Update fragmentation index and pick compaction target periodically */
+	compact_check(vsi);
+
 	return trigger_aging_flush(vsi, false, nr_flush, nr_flushed);
 }
 
@@ -0,0 +1,233 @@
+/**
+ * (C) Copyright 2026 Hewlett Packard Enterprise Development LP
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+#define D_LOGFAC	DD_FAC(vos)
+
+#include <daos/common.h>
+#include "vea_internal.h"
+
+/*
+ * Online free space compaction. VEA periodically picks the region with the most
+ * free blocks scattered in small free extents as the compaction target, by a scan
+ * over the free extent tree which is spread across flushes. The live
+ * extents in the target region are relocated by VOS aggregation (which updates the
+ * evtree records with new addresses), then the freed extents are merged with the
+ * existing holes into contiguous free space. The target region is excluded from
+ * reserving until nothing else is left, so relocated data doesn't land in its holes.
+ */
+
+void
+compact_init(struct vea_space_info *vsi)
+{
+	struct vea_compact_info	*vci = &vsi->vsi_compact;
+	unsigned int		 budget_mb = VEA_COMPACT_BUDGET_MB;
+	bool			 enabled;
+
+	/* Enabled by default in server mode only */
+	enabled = vsi->vsi_unmap_ctxt.vnc_ext_flush;
+	d_getenv_bool("DAOS_VEA_COMPACT", &enabled);
+	d_getenv_uint("DAOS_VEA_COMPACT_MB", &budget_mb);
+
+	memset(vci, 0, sizeof(*vci));
+	vci->vci_enabled = enabled;
+	vci->vci_budget_max = ((uint64_t)budget_mb << 20) / vsi->vsi_md->vsd_blk_sz;
+	vci->vci_scan_credits = VEA_COMPACT_SCAN_CREDITS;
+	if (enabled)
+		D_DEBUG(DB_IO, "VEA compaction enabled, %u MB per %u secs.\n", budget_mb,
+			VEA_COMPACT_INTVL);
+}
+
+/*
+ * Fragmentation index in per mille: 0 means all free extent blocks are in one
+ * contiguous extent, it approaches 1000 when free space is scattered.
+ */
+uint32_t
+compact_frag_index(struct vea_space_info *vsi)
+{
+	struct vea_free_class	*vfc = &vsi->vsi_class;
+	struct vea_extent_entry	*entry;
+	uint64_t		 free_blks, largest = 0, int_key = UINT64_MAX;
+	d_iov_t			 key, key_out, val;
+	int			 rc;
+
+	free_blks = vsi->vsi_stat[STAT_FREE_EXTENT_BLKS];
+	free_blks -= min(free_blks, magazine_free_blocks(vsi));
+	if (free_blks == 0)
+		return 0;
+
+	if (!d_binheap_is_empty(&vfc->vfc_heap)) {
+		entry = container_of(d_binheap_root(&vfc->vfc_heap), struct vea_extent_entry,
+				     vee_node);
+		largest = entry->vee_ext.vfe_blk_cnt;
+	} else {
+		d_iov_set(&key, &int_key, sizeof(int_key));
+		d_iov_set(&key_out, NULL, 0);
+		d_iov_set(&val, NULL, 0);
+		rc = dbtree_fetch(vfc->vfc_size_btr, BTR_PROBE_LE, DAOS_INTENT_DEFAULT, &key,
+				  &key_out, &val);
+		if (rc == 0)
+			largest = *(uint64_t *)key_out.iov_buf;
+		else if (rc != -DER_NONEXIST)
+			DL_ERROR(rc, "Failed to lookup largest free extent.");
+	}
+
+	largest = min(largest, free_blks);
+	return 1000 - (uint32_t)(largest * 1000 / free_blks);
+}
+
+static inline void
+compact_scan_region_end(struct vea_compact_scan *vcs)
+{
+	if (vcs->vcs_free > vcs->vcs_best_free) {
+		vcs->vcs_best = vcs->vcs_region;
+		vcs->vcs_best_free = vcs->vcs_free;
+	}
+	vcs->vcs_free = 0;
+}
+
+/* The whole free extent tree is scanned, pick the target region */
+static void
+compact_scan_end(struct vea_compact_info *vci)
+{
+	struct vea_compact_scan	*vcs = &vci->vci_scan;
+
+	compact_scan_region_end(vcs);
+	vcs->vcs_active = false;
+
+	/* Only the region with at least half blocks free is worth relocating */
+	if (vcs->vcs_best_free < VEA_COMPACT_REGION_BLKS / 2) {
+		vci->vci_blk_off = 0;
+		vci->vci_blk_cnt = 0;
+		return;
+	}
+
+	vci->vci_blk_off = vcs->vcs_best * VEA_COMPACT_REGION_BLKS;
+	vci->vci_blk_cnt = VEA_COMPACT_REGION_BLKS;
+	D_DEBUG(DB_IO, "Compaction target ["DF_U64", %u] with "DF_U64" scattered free blks\n",
+		vci->vci_blk_off, vci->vci_blk_cnt, vcs->vcs_best_free);
+}
+
+/*
+ * Visit a bounded number of free extents from the cursor, the scan over a large free
+ * extent tree is spread across flushes, and the previous target region is kept until
+ * the scan is completed.
+ */
+static void
+compact_scan_step(struct vea_space_info *vsi)
+{
+	struct vea_compact_info	*vci = &vsi->vsi_compact;
+	struct vea_compact_scan	*vcs = &vci->vci_scan;
+	struct vea_extent_entry	*entry;
+	daos_handle_t		 ih;
+	d_iov_t			 key, val;
+	uint64_t		 region;
+	unsigned int		 credits = vci->vci_scan_credits;
+	int			 rc;
+
+	rc = dbtree_iter_prepare(vsi->vsi_free_btr, 0, &ih);
+	if (rc) {
+		DL_ERROR(rc, "Failed to prepare free extents iterator.");
+		return;
+	}
+
+	d_iov_set(&key, &vcs->vcs_cursor, sizeof(vcs->vcs_cursor));
+	rc = dbtree_iter_probe(ih, BTR_PROBE_GE, DAOS_INTENT_DEFAULT, &key, NULL);
+	while (rc == 0 && credits > 0) {
+		d_iov_set(&val, NULL, 0);
+		rc = dbtree_iter_fetch(ih, NULL, &val, NULL);
+		if (rc)
+			break;
+
+		entry = val.iov_buf;
+		region = entry->vee_ext.vfe_blk_off / VEA_COMPACT_REGION_BLKS;
+		if (region != vcs->vcs_region) {
+			compact_scan_region_end(vcs);
+			vcs->vcs_region = region;
+		}
+
+		/* Large free extents are contiguous enough */
+		if (entry->vee_ext.vfe_blk_cnt < VEA_COMPACT_SMALL_BLKS)
+			vcs->vcs_free += entry->vee_ext.vfe_blk_cnt;
+
+		vcs->vcs_cursor = entry->vee_ext.vfe_blk_off + 1;
+		credits--;
+		rc = dbtree_iter_next(ih);
+	}
+	dbtree_iter_finish(ih);
+
+	if (rc == -DER_NONEXIST) {
+		compact_scan_end(vci);
+	} else if (rc) {
+		DL_ERROR(rc, "Failed to scan free extents.");
+		vcs->vcs_active = false;
+	}
+}
+
+static void
+compact_update(struct vea_space_info *vsi)
+{
+	struct vea_compact_info	*vci = &vsi->vsi_compact;
+	struct vea_metrics	*metrics = vsi->vsi_metrics;
+
+	vci->vci_frag_index = compact_frag_index(vsi);
+	if (metrics && metrics->vm_frag_index)
+		d_tm_set_gauge(metrics->vm_frag_index, vci->vci_frag_index);
+
+	if (!vci->vci_enabled)
+		return;
+
+	/* Refill the relocating budget for next interval */
+	vci->vci_budget = vci->vci_budget_max;
+	if (vci->vci_frag_index < VEA_COMPACT_FRAG_THRESH) {
+		vci->vci_blk_off = 0;
+		vci->vci_blk_cnt = 0;
+		vci->vci_scan.vcs_active = false;
+		return;
+	}
+
+	/* A scan not completed in last interval is carried on */
+	if (!vci->vci_scan.vcs_active) {
+		memset(&vci->vci_scan, 0, sizeof(vci->vci_scan));
+		vci->vci_scan.vcs_active = true;
+	}
+}
+
+void
+compact_check(struct vea_space_info *vsi)
+{
+	struct vea_compact_info	*vci = &vsi->vsi_compact;
+	uint32_t		 cur_age = get_current_age();
+
+	if (cur_age >= vci->vci_check_time + VEA_COMPACT_INTVL) {
+		vci->vci_check_time = cur_age;
+		compact_update(vsi);
+	}
+
+	if (vci->vci_scan.vcs_active)
+		compact_scan_step(vsi);
+}
+
+bool
+vea_compact_needed(struct vea_space_info *vsi, uint64_t blk_off, uint32_t blk_cnt)
+{
+	struct vea_compact_info	*vci = &vsi->vsi_compact;
+
+	if (vci->vci_blk_cnt == 0 || vci->vci_budget < blk_cnt)
+		return false;
+
+	return blk_off >= vci->vci_blk_off && blk_off < vci->vci_blk_off + vci->vci_blk_cnt;
+}
+
+void
+vea_compact_done(struct vea_space_info *vsi, uint32_t blk_cnt)
+{
+	struct vea_compact_info	*vci = &vsi->vsi_compact;
+	struct vea_metrics	*metrics = vsi->vsi_metrics;
+
+	vci->vci_budget -= min(vci->vci_budget, blk_cnt);
+	vci->vci_relocated += blk_cnt;
+	if (metrics && metrics->vm_compact_blks)
+		d_tm_set_counter(metrics->vm_compact_blks, vci->vci_relocated);
+}
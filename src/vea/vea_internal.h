@@ -1,6 +1,6 @@
 /**
  * (C) Copyright 2018-2023 Intel Corporation.
- * (C) Copyright 2025 Hewlett Packard Enterprise Development LP
+ * (C) Copyright 2025-2026 Hewlett Packard Enterprise Development LP
  *
  * SPDX-License-Identifier: BSD-2-Clause-Patent
  */
@@ -28,6 +28,31 @@
 #define VEA_BITMAP_MIN_CHUNK_BLKS	256				/* 1MiB */
 #define VEA_BITMAP_MAX_CHUNK_BLKS	(VEA_MAX_BITMAP_CLASS * 256)	/* 64 MiB */
 
+/* Magazine size classes, power of two extents from 64KiB to 4MiB */
+#define VEA_MAG_MIN_SHIFT	4
+#define VEA_MAG_MAX_SHIFT	10
+#define VEA_MAG_CLASS_NR	(VEA_MAG_MAX_SHIFT - VEA_MAG_MIN_SHIFT + 1)
+/* Max extents cached in a magazine */
+#define VEA_MAG_SLOTS		32
+/* Blocks carved from extent trees on each magazine refill, 16MiB */
+#define VEA_MAG_REFILL_BLKS	4096
+/* Idle magazine is returned to the compound index after this many seconds */
+#define VEA_MAG_IDLE_SECS	10
+
+/*
+ * Per size-class cache of free extents. Extents cached in magazine are removed
+ * from the in-memory compound index but still free in persistent tree, so they
+ * are accounted as free blocks until reserved.
+ */
+struct vea_magazine {
+	/* Block offsets of cached extents, in ascending order */
+	uint64_t	vmg_offs[VEA_MAG_SLOTS];
+	/* Number of cached extents */
+	uint32_t	vmg_cnt;
+	/* Last access timestamp */
+	uint32_t	vmg_age;
+};
+
 
 /* Common free bitmap structure for both SCM & in-memory index */
 struct vea_free_bitmap {
@@ -135,29 +160,81 @@ enum {
 	STAT_RESRV_SMALL	= 2,
 	/* Number of bitmap reserve */
 	STAT_RESRV_BITMAP	= 3,
+	/* Number of magazine reserve */
+	STAT_RESRV_MAG		= 4,
 	/* Max reserve type */
-	STAT_RESRV_TYPE_MAX	= 4,
+	STAT_RESRV_TYPE_MAX	= 5,
 	/* Number of large(> VEA_LARGE_EXT_MB) free frags available for allocation */
-	STAT_FRAGS_LARGE	= 4,
+	STAT_FRAGS_LARGE	= 5,
 	/* Number of small free extent frags available for allocation */
-	STAT_FRAGS_SMALL	= 5,
+	STAT_FRAGS_SMALL	= 6,
 	/* Number of frags in aging buffer (to be unmapped) */
-	STAT_FRAGS_AGING	= 6,
+	STAT_FRAGS_AGING	= 7,
 	/* Number of bitmaps */
-	STAT_FRAGS_BITMAP	= 7,
+	STAT_FRAGS_BITMAP	= 8,
 	/* Max frag type */
 	STAT_FRAGS_TYPE_MAX	= 4,
 	/* Number of extent blocks available for allocation */
-	STAT_FREE_EXTENT_BLKS	= 8,
+	STAT_FREE_EXTENT_BLKS	= 9,
 	/* Number of bitmap blocks available for allocation */
-	STAT_FREE_BITMAP_BLKS	= 9,
-	STAT_MAX		= 10,
+	STAT_FREE_BITMAP_BLKS	= 10,
+	STAT_MAX		= 11,
 };
 
 struct vea_metrics {
 	struct d_tm_node_t	*vm_rsrv[STAT_RESRV_TYPE_MAX];
 	struct d_tm_node_t	*vm_frags[STAT_FRAGS_TYPE_MAX];
 	struct d_tm_node_t	*vm_free_blks;
+	struct d_tm_node_t	*vm_frag_index;
+	struct d_tm_node_t	*vm_compact_blks;
+};
+
+/* Compaction region size, 64MiB */
+#define VEA_COMPACT_REGION_BLKS	16384
+/* Free extents smaller than this are regarded as scattered, 1MiB */
+#define VEA_COMPACT_SMALL_BLKS	256
+/* Fragmentation index (per mille) threshold to start compaction */
+#define VEA_COMPACT_FRAG_THRESH	500
+/* Compaction check interval in seconds */
+#define VEA_COMPACT_INTVL	30
+/* Default relocating budget per interval */
+#define VEA_COMPACT_BUDGET_MB	256
+/* Free extents visited by the region scan on each flush */
+#define VEA_COMPACT_SCAN_CREDITS	1024
+
+/* Incremental scan over the free extent tree for picking the target region */
+struct vea_compact_scan {
+	/* Block offset to resume the scan from */
+	uint64_t	vcs_cursor;
+	/* Current region and blocks in small free extents of it */
+	uint64_t	vcs_region;
+	uint64_t	vcs_free;
+	/* Best region found so far */
+	uint64_t	vcs_best;
+	uint64_t	vcs_best_free;
+	bool		vcs_active;
+};
+
+/* Online compaction state */
+struct vea_compact_info {
+	/* Target region being compacted */
+	uint64_t	vci_blk_off;
+	uint32_t	vci_blk_cnt;
+	/* Free extents visited by each scan step */
+	uint32_t	vci_scan_credits;
+	struct vea_compact_scan	vci_scan;
+	/* Fragmentation index in per mille */
+	uint32_t	vci_frag_index;
+	/* Blocks could be relocated in current interval */
+	uint64_t	vci_budget;
+	uint64_t	vci_budget_max;
+	/* Total relocated blocks */
+	uint64_t	vci_relocated;
+	/* Last check timestamp */
+	uint32_t	vci_check_time;
+	bool		vci_enabled;
+	/* Reserve from the target region, only when no other free space left */
+	bool		vci_no_excl;
 };
 
 #define MAX_FLUSH_FRAGS	256
@@ -203,6 +280,12 @@ struct vea_space_info {
 	/* Last aging buffer flush timestamp */
 	uint32_t			 vsi_flush_time;
 	bool				 vsi_flush_scheduled;
+	/* Magazines are enabled */
+	bool				 vsi_mag_enabled;
+	/* Per size-class magazines */
+	struct vea_magazine		 vsi_mags[VEA_MAG_CLASS_NR];
+	/* Online compaction */
+	struct vea_compact_info		 vsi_compact;
 };
 
 struct free_commit_cb_arg {
@@ -222,6 +305,8 @@ get_current_age(void)
 enum vea_free_flags {
 	VEA_FL_NO_MERGE		= (1 << 0),
 	VEA_FL_NO_ACCOUNTING	= (1 << 1),
+	/* Internal reserve (e.g. magazine refill), not counted in reserve stats */
+	VEA_FL_NO_STATS		= (1 << 2),
 };
 
 static inline bool
@@ -230,6 +315,19 @@ is_bitmap_feature_enabled(struct vea_space_info *vsi)
 	return vsi->vsi_md->vsd_compat & VEA_COMPAT_FEATURE_BITMAP;
 }
 
+/* Check if the extent overlaps the region being compacted, which isn't for reserving */
+static inline bool
+compact_excluded(struct vea_space_info *vsi, uint64_t blk_off, uint32_t blk_cnt)
+{
+	struct vea_compact_info	*vci = &vsi->vsi_compact;
+
+	if (vci->vci_blk_cnt == 0 || vci->vci_no_excl)
+		return false;
+
+	return blk_off < vci->vci_blk_off + vci->vci_blk_cnt &&
+	       blk_off + blk_cnt > vci->vci_blk_off;
+}
+
 static inline int
 alloc_free_bitmap_size(uint16_t bitmap_sz)
 {
@@ -285,7 +383,7 @@ void inc_stats(struct vea_space_info *vsi, unsigned int type, uint64_t nr);
 int reserve_hint(struct vea_space_info *vsi, uint32_t blk_cnt,
 		 struct vea_resrvd_ext *resrvd);
 int reserve_single(struct vea_space_info *vsi, uint32_t blk_cnt,
-		   struct vea_resrvd_ext *resrvd);
+		   struct vea_resrvd_ext *resrvd, unsigned int flags);
 int persistent_alloc(struct vea_space_info *vsi, struct vea_free_entry *vfe);
 int
 bitmap_tx_add_ptr(struct umem_instance *vsi_umem, uint64_t *bitmap,
@@ -311,6 +409,19 @@ int free_type(struct vea_space_info *vsi, uint64_t blk_off, uint32_t blk_cnt,
 void
 free_commit_cb(void *data, bool noop);
 
+/* vea_mag.c */
+void magazine_init(struct vea_space_info *vsi);
+int reserve_magazine(struct vea_space_info *vsi, uint32_t blk_cnt,
+		     struct vea_resrvd_ext *resrvd);
+int magazine_drain(struct vea_space_info *vsi, bool force, uint64_t *nr_drained);
+uint64_t magazine_free_blocks(struct vea_space_info *vsi);
+bool magazine_cached(struct vea_space_info *vsi, uint64_t blk_off, uint32_t blk_cnt);
+
+/* vea_compact.c */
+void compact_init(struct vea_space_info *vsi);
+void compact_check(struct vea_space_info *vsi);
+uint32_t compact_frag_index(struct vea_space_info *vsi);
+
 /* vea_hint.c */
 void hint_get(struct vea_hint_context *hint, uint64_t *off);
 void hint_update(struct vea_hint_context *hint, uint64_t off, uint64_t *seq);
@@ -0,0 +1,224 @@
+/**
+ * (C) Copyright 2026 Hewlett Packard Enterprise Development LP
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+#define D_LOGFAC	DD_FAC(vos)
+
+#include <daos/common.h>
+#include "vea_internal.h"
+
+/*
+ * Magazines cache free extents of a few power of two size classes, each refill
+ * carves a batch of consecutive extents from the extent trees in one shot, so
+ * that the mixed sized I/O doesn't have to search and split the size tree on
+ * every reserve, and the extents reserved from the same magazine are adjacent.
+ */
+
+void
+magazine_init(struct vea_space_info *vsi)
+{
+	bool	enabled;
+
+	/* Enabled by default in server mode only */
+	enabled = vsi->vsi_unmap_ctxt.vnc_ext_flush;
+	d_getenv_bool("DAOS_VEA_MAGAZINE", &enabled);
+
+	memset(vsi->vsi_mags, 0, sizeof(vsi->vsi_mags));
+	vsi->vsi_mag_enabled = enabled;
+	if (enabled)
+		D_DEBUG(DB_IO, "VEA magazines are enabled.\n");
+}
+
+static inline struct vea_magazine *
+blk_cnt2magazine(struct vea_space_info *vsi, uint32_t blk_cnt)
+{
+	int	shift;
+
+	if (!vsi->vsi_mag_enabled || blk_cnt == 0 || (blk_cnt & (blk_cnt - 1)) != 0)
+		return NULL;
+
+	/* Small allocations are served by bitmap */
+	if (is_bitmap_feature_enabled(vsi) && blk_cnt <= VEA_MAX_BITMAP_CLASS)
+		return NULL;
+
+	shift = __builtin_ctz(blk_cnt);
+	if (shift < VEA_MAG_MIN_SHIFT || shift > VEA_MAG_MAX_SHIFT)
+		return NULL;
+
+	return &vsi->vsi_mags[shift - VEA_MAG_MIN_SHIFT];
+}
+
+static inline uint32_t
+magazine2blk_cnt(struct vea_space_info *vsi, struct vea_magazine *mag)
+{
+	return 1U << (mag - &vsi->vsi_mags[0] + VEA_MAG_MIN_SHIFT);
+}
+
+static int
+magazine_refill(struct vea_space_info *vsi, struct vea_magazine *mag, uint32_t blk_cnt)
+{
+	struct vea_resrvd_ext	rsrvd = { 0 };
+	uint32_t		nr;
+	int			i, rc;
+
+	D_ASSERT(mag->vmg_cnt == 0);
+	nr = min(VEA_MAG_REFILL_BLKS / blk_cnt, VEA_MAG_SLOTS);
+	D_ASSERT(nr > 1);
+
+	/* Carving the batch isn't a reserve by the caller, leave the reserve stats alone */
+	rc = reserve_single(vsi, nr * blk_cnt, &rsrvd, VEA_FL_NO_STATS);
+	if (rc)
+		return rc;
+
+	/* No contiguous free space for a batch, fallback to the normal reserve */
+	if (rsrvd.vre_blk_cnt == 0)
+		return 0;
+
+	D_ASSERT(rsrvd.vre_private == NULL);
+	D_ASSERT(rsrvd.vre_blk_cnt == nr * blk_cnt);
+
+	for (i = 0; i < nr; i++)
+		mag->vmg_offs[i] = rsrvd.vre_blk_off + (uint64_t)i * blk_cnt;
+	mag->vmg_cnt = nr;
+
+	return 0;
+}
+
+int
+reserve_magazine(struct vea_space_info *vsi, uint32_t blk_cnt,
+		 struct vea_resrvd_ext *resrvd)
+{
+	struct vea_magazine	*mag;
+	int			 i, idx = 0, rc;
+
+	mag = blk_cnt2magazine(vsi, blk_cnt);
+	if (mag == NULL)
+		return 0;
+
+	mag->vmg_age = get_current_age();
+	if (mag->vmg_cnt == 0) {
+		rc = magazine_refill(vsi, mag, blk_cnt);
+		if (rc || mag->vmg_cnt == 0)
+			return rc;
+	}
+
+	/* Keep the I/O stream sequential if the adjacent extent is cached */
+	if (resrvd->vre_hint_off != VEA_HINT_OFF_INVAL) {
+		for (i = 0; i < mag->vmg_cnt; i++) {
+			if (mag->vmg_offs[i] == resrvd->vre_hint_off) {
+				idx = i;
+				break;
+			}
+		}
+	}
+
+	resrvd->vre_blk_off = mag->vmg_offs[idx];
+	resrvd->vre_blk_cnt = blk_cnt;
+	resrvd->vre_private = NULL;
+
+	mag->vmg_cnt--;
+	if (idx < mag->vmg_cnt)
+		memmove(&mag->vmg_offs[idx], &mag->vmg_offs[idx + 1],
+			sizeof(mag->vmg_offs[0]) * (mag->vmg_cnt - idx));
+
+	inc_stats(vsi, STAT_RESRV_MAG, 1);
+
+	D_DEBUG(DB_IO, "["DF_U64", %u]\n", resrvd->vre_blk_off, resrvd->vre_blk_cnt);
+	return 0;
+}
+
+/*
+ * Return the cached extents to compound index, consecutive extents are returned as
+ * one free extent. Only idle magazines are drained when @force is false.
+ */
+int
+magazine_drain(struct vea_space_info *vsi, bool force, uint64_t *nr_drained)
+{
+	struct vea_magazine	*mag;
+	struct vea_free_extent	 vfe;
+	uint32_t		 blk_cnt, cur_age = get_current_age();
+	int			 i, j, start = 0, rc = 0;
+
+	if (nr_drained)
+		*nr_drained = 0;
+
+	for (i = 0; i < VEA_MAG_CLASS_NR; i++) {
+		mag = &vsi->vsi_mags[i];
+		if (mag->vmg_cnt == 0)
+			continue;
+		if (!force && cur_age < mag->vmg_age + VEA_MAG_IDLE_SECS)
+			continue;
+
+		blk_cnt = magazine2blk_cnt(vsi, mag);
+		vfe.vfe_blk_cnt = 0;
+		vfe.vfe_age = 0;	/* Not used */
+
+		for (j = 0; j <= mag->vmg_cnt; j++) {
+			if (j < mag->vmg_cnt && vfe.vfe_blk_cnt != 0 &&
+			    vfe.vfe_blk_off + vfe.vfe_blk_cnt == mag->vmg_offs[j]) {
+				vfe.vfe_blk_cnt += blk_cnt;
+				continue;
+			}
+
+			if (vfe.vfe_blk_cnt != 0) {
+				/* Cached extents are already accounted as free */
+				rc = compound_free_extent(vsi, &vfe, VEA_FL_NO_ACCOUNTING);
+				if (rc) {
+					DL_ERROR(rc, "Failed to drain magazine ["DF_U64", %u]",
+						 vfe.vfe_blk_off, vfe.vfe_blk_cnt);
+					/* Keep the extents not returned yet */
+					mag->vmg_cnt -= start;
+					memmove(&mag->vmg_offs[0], &mag->vmg_offs[start],
+						sizeof(mag->vmg_offs[0]) * mag->vmg_cnt);
+					return rc;
+				}
+				if (nr_drained)
+					*nr_drained += vfe.vfe_blk_cnt;
+			}
+
+			if (j < mag->vmg_cnt) {
+				vfe.vfe_blk_off = mag->vmg_offs[j];
+				vfe.vfe_blk_cnt = blk_cnt;
+				start = j;
+			}
+		}
+		mag->vmg_cnt = 0;
+	}
+
+	return rc;
+}
+
+uint64_t
+magazine_free_blocks(struct vea_space_info *vsi)
+{
+	uint64_t	free_blks = 0;
+	int		i;
+
+	for (i = 0; i < VEA_MAG_CLASS_NR; i++)
+		free_blks += (uint64_t)vsi->vsi_mags[i].vmg_cnt << (i + VEA_MAG_MIN_SHIFT);
+
+	return free_blks;
+}
+
+/* Whether any block of the extent is cached by magazines, i.e. still free */
+bool
+magazine_cached(struct vea_space_info *vsi, uint64_t blk_off, uint32_t blk_cnt)
+{
+	struct vea_magazine	*mag;
+	uint32_t		 mag_blks;
+	int			 i, j;
+
+	for (i = 0; i < VEA_MAG_CLASS_NR; i++) {
+		mag = &vsi->vsi_mags[i];
+		mag_blks = magazine2blk_cnt(vsi, mag);
+
+		for (j = 0; j < mag->vmg_cnt; j++) {
+			if (mag->vmg_offs[j] < blk_off + blk_cnt &&
+			    mag->vmg_offs[j] + mag_blks > blk_off)
+				return true;
+		}
+	}
+
+	return false;
+}
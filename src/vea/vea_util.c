@@ -1,5 +1,6 @@
 /**
  * (C) Copyright 2018-2023 Intel Corporation.
+ * (C) Copyright 2026 Hewlett Packard Enterprise Development LP
  *
  * SPDX-License-Identifier: BSD-2-Clause-Patent
  */
@@ -385,7 +386,8 @@ repeat:
 }
 
 /**
- * Verify if an extent is allocated in persistent or transient metadata.
+ * Verify if an extent is allocated in persistent or transient metadata. Extents cached
+ * in magazines are removed from the transient index but still free.
  *
  * \param vsi       [IN]	In-memory compound index
  * \param transient [IN]	Persistent or transient
@@ -401,8 +403,11 @@ int
 vea_verify_alloc(struct vea_space_info *vsi, bool transient,
 		 uint64_t off, uint32_t cnt, bool is_bitmap)
 {
-	if (!is_bitmap)
+	if (!is_bitmap) {
+		if (transient && magazine_cached(vsi, off, cnt))
+			return 1;	/* Not allocated */
 		return verify_alloc_extent(vsi, transient, off, cnt);
+	}
 
 	return verify_alloc_bitmap(vsi, transient, off, cnt);
 }
@@ -425,6 +430,8 @@ rsrv_type2str(int rsrv_type)
 		return "small";
 	case STAT_RESRV_BITMAP:
 		return "bitmap";
+	case STAT_RESRV_MAG:
+		return "magazine";
 	default:
 		return "unknown";
 	}
@@ -491,6 +498,18 @@ vea_metrics_alloc(const char *path, int tgt_id)
 	if (rc)
 		D_WARN("Failed to create free blks telemetry: "DF_RC"\n", DP_RC(rc));
 
+	rc = d_tm_add_metric(&metrics->vm_frag_index, D_TM_GAUGE,
+			     "free space fragmentation index", "per mille",
+			     "%s/%s/frag_index/tgt_%u", path, VEA_TELEMETRY_DIR, tgt_id);
+	if (rc)
+		D_WARN("Failed to create frag index telemetry: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&metrics->vm_compact_blks, D_TM_COUNTER,
+			     "number of blocks relocated by compaction", "blks",
+			     "%s/%s/compact_blks/tgt_%u", path, VEA_TELEMETRY_DIR, tgt_id);
+	if (rc)
+		D_WARN("Failed to create compact blks telemetry: "DF_RC"\n", DP_RC(rc));
+
 	return metrics;
 }
 
@@ -511,6 +530,7 @@ update_stats(struct vea_space_info *vsi, unsigned int type, uint64_t nr, bool de
 	case STAT_RESRV_LARGE:
 	case STAT_RESRV_SMALL:
 	case STAT_RESRV_BITMAP:
+	case STAT_RESRV_MAG:
 		D_ASSERT(!dec && nr == 1);
 		vsi->vsi_stat[type] += nr;
 		if (metrics && metrics->vm_rsrv[type])
@@ -973,7 +973,7 @@ io_oi_test(void **state)
 }
 
 static void
-io_obj_cache_test(void **state)
+obj_cache_test(void **state, bool clock)
 {
 	struct io_test_args	*arg = *state;
 	struct vos_test_ctx	*ctx = &arg->ctx;
@@ -991,7 +991,7 @@ io_obj_cache_test(void **state)
 	int			 i, rc;
 	struct vos_tls          *tls;
 
-	rc = vos_obj_cache_create(10, &occ);
+	rc = vos_obj_cache_create(10, clock, &occ);
 	assert_rc_equal(rc, 0);
 
 	tls             = vos_tls_get(true);
@@ -1123,6 +1123,18 @@ io_obj_cache_test(void **state)
 	free(po_name);
 }
 
+static void
+io_obj_cache_test(void **state)
+{
+	obj_cache_test(state, false);
+}
+
+static void
+io_obj_cache_clock_test(void **state)
+{
+	obj_cache_test(state, true);
+}
+
 static void
 io_multiple_dkey_test(void **state, unsigned int flags)
 {
@@ -3574,6 +3586,7 @@ static const struct CMUnitTest io_tests[] = {
 static const struct CMUnitTest int_tests[] = {
     {"VOS201: VOS object IO index", io_oi_test, NULL, NULL},
     {"VOS202: VOS object cache test", io_obj_cache_test, NULL, NULL},
+    {"VOS202.1: VOS object cache test (CLOCK)", io_obj_cache_clock_test, NULL, NULL},
     {"VOS300.1: Test key query punch with subsequent update", io_query_key_punch_update, NULL,
      NULL},
     {"VOS300.2: Key query test", io_query_key, NULL, NULL},
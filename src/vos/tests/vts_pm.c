@@ -3011,6 +3011,140 @@ test_multiple_key_conditionals_tx(void **state)
 	test_multiple_key_conditionals_common(state, true);
 }
 
+static void
+summ_update(struct io_test_args *arg, daos_unit_oid_t oid, daos_epoch_t epoch, uint64_t dkey_val,
+	    const char *akey, daos_iod_type_t type, void *val, daos_size_t size)
+{
+	daos_key_t	dkey;
+	daos_recx_t	recx = {.rx_idx = 0, .rx_nr = 1};
+	daos_iod_t	iod  = {0};
+	d_sg_list_t	sgl;
+	int		rc;
+
+	d_iov_set(&dkey, &dkey_val, sizeof(dkey_val));
+	d_iov_set(&iod.iod_name, (void *)akey, strlen(akey));
+	iod.iod_type = type;
+	iod.iod_size = size;
+	iod.iod_nr   = 1;
+	if (type == DAOS_IOD_ARRAY)
+		iod.iod_recxs = &recx;
+
+	rc = d_sgl_init(&sgl, 1);
+	assert_rc_equal(rc, 0);
+	d_iov_set(&sgl.sg_iovs[0], val, size);
+	rc = vos_obj_update(arg->ctx.tc_co_hdl, oid, epoch, 0, 0, &dkey, 1, &iod, NULL, &sgl);
+	assert_rc_equal(rc, 0);
+	d_sgl_fini(&sgl, false);
+}
+
+struct summ_yield_arg {
+	struct io_test_args	*sya_arg;
+	daos_unit_oid_t		 sya_oid;
+	int			 sya_yields;
+};
+
+/** Updates a new dkey on the first yield of the summary build */
+static int
+summ_yield(void *arg)
+{
+	struct summ_yield_arg	*sya = arg;
+	struct vos_obj_summ	 summ;
+	uint32_t		 val = 5000;
+	int			 rc;
+
+	rc = vos_obj_summ_get(sya->sya_arg->ctx.tc_co_hdl, sya->sya_oid, &summ);
+	assert_rc_equal(rc, -DER_INPROGRESS);
+
+	if (sya->sya_yields++ == 0)
+		summ_update(sya->sya_arg, sya->sya_oid, 40, 200, "a", DAOS_IOD_SINGLE, &val,
+			    sizeof(val));
+	return 0;
+}
+
+static void
+obj_summary(void **state)
+{
+	struct io_test_args		*arg = *state;
+	struct vos_obj_summ		 summ;
+	const struct vos_summ_range	*range;
+	struct summ_yield_arg		 sya = { 0 };
+	daos_unit_oid_t			 oid;
+	daos_key_t			 key;
+	char				 str[16] = "summary";
+	uint64_t			 dkey_val;
+	uint32_t			 val;
+	int				 rc;
+
+	oid = gen_oid(0);
+	rc  = vos_obj_summ_get(arg->ctx.tc_co_hdl, oid, &summ);
+	assert_rc_equal(rc, -DER_NONEXIST);
+
+	for (dkey_val = 0; dkey_val < 10; dkey_val++) {
+		val = dkey_val * 10;
+		summ_update(arg, oid, dkey_val + 1, dkey_val, "a", DAOS_IOD_SINGLE, &val,
+			    sizeof(val));
+		summ_update(arg, oid, dkey_val + 1, dkey_val, "s", DAOS_IOD_SINGLE, str,
+			    sizeof(str));
+	}
+	summ_update(arg, oid, 20, 0, "arr", DAOS_IOD_ARRAY, str, 1);
+
+	/** not built until requested */
+	rc = vos_obj_summ_get(arg->ctx.tc_co_hdl, oid, &summ);
+	assert_rc_equal(rc, -DER_AGAIN);
+
+	/** built by scanning the object 3 dkeys at a time, with an update while it yields */
+	sya.sya_arg = arg;
+	sya.sya_oid = oid;
+	rc = vos_obj_summ_build(arg->ctx.tc_co_hdl, oid, 3, summ_yield, &sya);
+	assert_rc_equal(rc, 0);
+	assert_true(sya.sya_yields >= 3);
+
+	rc = vos_obj_summ_get(arg->ctx.tc_co_hdl, oid, &summ);
+	assert_rc_equal(rc, 0);
+	assert_true(summ.os_dkeys.sr_nr >= 11);
+	assert_int_equal(summ.os_dkeys.sr_min_len, sizeof(dkey_val));
+	assert_int_equal(summ.os_dkeys.sr_max_u, 200);
+	dkey_val = 5;
+	d_iov_set(&key, &dkey_val, sizeof(dkey_val));
+	assert_true(vos_obj_summ_dkey_maybe(&summ, &key));
+	dkey_val = 200;
+	assert_true(vos_obj_summ_dkey_maybe(&summ, &key));
+
+	d_iov_set(&key, "a", 1);
+	range = vos_obj_summ_akey(&summ, &key);
+	assert_non_null(range);
+	assert_true(range->sr_nr >= 11);
+	assert_int_equal(range->sr_min_u, 0);
+	assert_int_equal(range->sr_max_u, 5000);
+	d_iov_set(&key, "s", 1);
+	range = vos_obj_summ_akey(&summ, &key);
+	assert_non_null(range);
+	assert_int_equal(range->sr_min_len, sizeof(str));
+	assert_int_equal(range->sr_max_len, sizeof(str));
+	d_iov_set(&key, "arr", 3);
+	assert_null(vos_obj_summ_akey(&summ, &key));
+	d_iov_set(&key, "none", 4);
+	range = vos_obj_summ_akey(&summ, &key);
+	assert_non_null(range);
+	assert_int_equal(range->sr_nr, 0);
+
+	/** maintained by updates, and not rebuilt */
+	val = 10000;
+	summ_update(arg, oid, 50, 300, "a", DAOS_IOD_SINGLE, &val, sizeof(val));
+	rc = vos_obj_summ_build(arg->ctx.tc_co_hdl, oid, 3, summ_yield, &sya);
+	assert_rc_equal(rc, 0);
+	rc = vos_obj_summ_get(arg->ctx.tc_co_hdl, oid, &summ);
+	assert_rc_equal(rc, 0);
+	assert_int_equal(summ.os_dkeys.sr_max_u, 300);
+	dkey_val = 300;
+	d_iov_set(&key, &dkey_val, sizeof(dkey_val));
+	assert_true(vos_obj_summ_dkey_maybe(&summ, &key));
+	d_iov_set(&key, "a", 1);
+	range = vos_obj_summ_akey(&summ, &key);
+	assert_non_null(range);
+	assert_int_equal(range->sr_max_u, 10000);
+}
+
 static const struct CMUnitTest punch_model_tests_pmdk[] = {
     {"VOS860: Conditionals test", cond_test, NULL, NULL},
     {"VOS861: Multiple oid cond test", multiple_oid_cond_test, NULL, NULL},
@@ -3050,6 +3184,7 @@ static const struct CMUnitTest punch_model_tests_all[] = {
 		NULL },
 	{ "VOS815: Many keys in one tree", many_keys, NULL, NULL },
 	{ "VOS816: Simulate EC array size", ec_size, NULL, NULL },
+	{ "VOS817: Object summary", obj_summary, NULL, NULL },
 };
 
 int
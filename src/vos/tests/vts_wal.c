@@ -1,7 +1,7 @@
 /**
  * (C) Copyright 2022-2024 Intel Corporation.
  * (C) Copyright 2026 Google LLC
- * (C) Copyright 2025 Hewlett Packard Enterprise Development LP
+ * (C) Copyright 2025-2026 Hewlett Packard Enterprise Development LP
  *
  * SPDX-License-Identifier: BSD-2-Clause-Patent
  */
@@ -317,7 +317,7 @@ wal_tst_pool_cont(void **state)
 		struct umem_store	*store;
 		uint64_t		 committed_id;
 
-		vos_pool_checkpoint_init(poh, update_cb, wait_cb, &committed_id, &store);
+		vos_pool_checkpoint_init(poh, update_cb, wait_cb, NULL, &committed_id, &store);
 		rc = vos_pool_checkpoint(poh);
 		assert_rc_equal(rc, 0);
 		vos_pool_checkpoint_fini(poh);
@@ -392,7 +392,7 @@ wal_pool_refill(struct io_test_args *arg)
 		struct umem_store	*store;
 		uint64_t		 committed_id;
 
-		vos_pool_checkpoint_init(poh, update_cb, wait_cb, &committed_id, &store);
+		vos_pool_checkpoint_init(poh, update_cb, wait_cb, NULL, &committed_id, &store);
 		if (arg->fail_checkpoint) {
 			daos_fail_loc_set(DAOS_MEM_FAIL_CHECKPOINT | DAOS_FAIL_ALWAYS);
 			rc = vos_pool_checkpoint(poh);
@@ -1379,7 +1379,7 @@ checkpoint_fn(void *arg)
 	daos_handle_t      phdl = *(daos_handle_t *)arg;
 	int                rc;
 
-	vos_pool_checkpoint_init(phdl, update_cb, wait_cb, &committed_id, &store);
+	vos_pool_checkpoint_init(phdl, update_cb, wait_cb, NULL, &committed_id, &store);
 	rc = vos_pool_checkpoint(phdl);
 	assert_rc_equal(rc, 0);
 	vos_pool_checkpoint_fini(phdl);
@@ -444,6 +444,71 @@ wal_ut_large_payload(void **state)
 	ut_mc_fini(args);
 }
 
+static void
+wal_ut_compress(void **state)
+{
+	struct bio_ut_args	*args = *state;
+	uint64_t		 meta_sz = (128ULL << 20);	/* 128 MB */
+	uint32_t		 buf_sz = (256UL << 10);
+	struct bio_wal_stats	 stats = { 0 };
+	struct wal_header	*hdr;
+	struct umem_wal_tx	*tx;
+	struct ut_fake_tx	*fake_tx;
+	int			 i, rc;
+
+	/* WAL header is marked at open when compression is enabled */
+	bio_wal_compress = true;
+	rc = ut_mc_init(args, meta_sz, meta_sz, meta_sz);
+	assert_rc_equal(rc, 0);
+	hdr = &args->bua_mc->mc_wal_info.si_header;
+	assert_true(hdr->wh_compat & WAL_COMPAT_ZIP);
+	assert_int_equal(hdr->wh_version, BIO_WAL_VERSION_ZIP);
+
+	tx = ut_tx_alloc(6, buf_sz);
+	assert_non_null(tx);
+
+	/* Highly redundant payload, like btree node copies */
+	fake_tx = (struct ut_fake_tx *)&tx->utx_private;
+	for (i = 0; i < buf_sz; i++)
+		fake_tx->ft_buffer[i] = (i % 512) < 64 ? 'a' + (i % 26) : 0;
+	fake_tx->ft_copy_ptr_sz = buf_sz;
+
+	ut_tx_add_action(tx, UMEM_ACT_COPY);
+	ut_tx_add_action(tx, UMEM_ACT_COPY_PTR);
+	ut_tx_add_action(tx, UMEM_ACT_ASSIGN);
+	ut_tx_add_action(tx, UMEM_ACT_MOVE);
+	ut_tx_add_action(tx, UMEM_ACT_COPY_PTR);
+	ut_tx_add_action(tx, UMEM_ACT_SET);
+
+	rc = bio_wal_reserve(args->bua_mc, &tx->utx_id, NULL);
+	assert_rc_equal(rc, 0);
+
+	rc = bio_wal_commit(args->bua_mc, tx, NULL, &stats);
+	bio_wal_compress = false;
+	assert_rc_equal(rc, 0);
+	assert_true(stats.ws_size < fake_tx->ft_payload_sz / 4);
+
+	rc = bio_mc_close(args->bua_mc);
+	assert_rc_equal(rc, 0);
+
+	/* The mark is kept after compression is disabled */
+	rc = bio_mc_open(args->bua_xs_ctxt, args->bua_pool_id, 0, &args->bua_mc);
+	assert_rc_equal(rc, 0);
+	hdr = &args->bua_mc->mc_wal_info.si_header;
+	assert_true(hdr->wh_compat & WAL_COMPAT_ZIP);
+
+	/* Reset act index before replay */
+	fake_tx->ft_act_idx = 0;
+
+	rc = bio_wal_replay(args->bua_mc, NULL, ut_replay_one, tx);
+	assert_rc_equal(rc, 0);
+	assert_int_equal(fake_tx->ft_act_nr, fake_tx->ft_act_idx);
+
+	ut_tx_free(tx);
+
+	ut_mc_fini(args);
+}
+
 struct ut_tx_array {
 	struct umem_wal_tx	**ta_tx_ptrs;
 	uint64_t		  ta_replay_tx;	/* Current replay tx */
@@ -876,6 +941,7 @@ static const struct CMUnitTest wal_uts[] = {
 	{ "single tx commit/replay", wal_ut_single, NULL, NULL},
 	{ "single tx with many acts", wal_ut_many_acts, NULL, NULL},
 	{ "single tx with large payload", wal_ut_large_payload, NULL, NULL},
+	{ "single tx with compressed payload", wal_ut_compress, NULL, NULL},
 	{ "multiple tx commit/replay", wal_ut_multi, NULL, NULL},
 	{ "replay after checkpoint", wal_ut_checkpoint, NULL, NULL},
 	{ "wal log wraps once", wal_ut_wrap, NULL, NULL},
@@ -145,6 +145,8 @@ struct agg_merge_window {
 	/* I/O context for transferring data on flush */
 	struct agg_io_context		 mw_io_ctxt;
 	uint16_t			 mw_csum_type;
+	/* Flushed for relocating data out of the region being compacted by VEA */
+	bool				 mw_compact;
 	/* Recxs trace for debugging */
 	vos_iter_entry_t		 mw_evt_trace[EV_TRACE_MAX];
 	unsigned int			 mw_trace_start;
@@ -1707,6 +1709,52 @@ need_merge(daos_handle_t ih, uint16_t src_media, int lgc_cnt, daos_size_t seg_si
 	return (lgc_cnt >= VOS_EVT_ORDER) || (seg_blks == (nvme_blks * vos_agg_nvme_thresh));
 }
 
+/* Relocate the NVMe record if it's located in the region being compacted by VEA */
+static inline bool
+need_compact(daos_handle_t ih, struct agg_merge_window *mw, struct agg_phy_ent *phy_ent)
+{
+	struct vos_obj_iter	*oiter = vos_hdl2oiter(ih);
+	struct vea_space_info	*vsi = vos_obj2pool(oiter->it_obj)->vp_vea_info;
+	uint64_t		 blk_off;
+	uint32_t		 blk_cnt;
+
+	if (vsi == NULL || phy_ent->pe_addr.ba_type != DAOS_MEDIA_NVME ||
+	    bio_addr_is_hole(&phy_ent->pe_addr) || BIO_ADDR_IS_DEDUP(&phy_ent->pe_addr))
+		return false;
+
+	/* The whole merge window will be rewritten */
+	blk_off = phy_ent->pe_addr.ba_off >> VOS_BLK_SHIFT;
+	blk_cnt = vos_byte2blkcnt(merge_window_size(mw));
+
+	return vea_compact_needed(vsi, blk_off, blk_cnt);
+}
+
+/* Charge the data rewritten by a committed window flush to the VEA compaction budget */
+static void
+compact_charge(daos_handle_t ih, struct agg_merge_window *mw)
+{
+	struct vos_obj_iter	*oiter = vos_hdl2oiter(ih);
+	struct vea_space_info	*vsi = vos_obj2pool(oiter->it_obj)->vp_vea_info;
+	struct agg_io_context	*io = &mw->mw_io_ctxt;
+	struct evt_entry_in	*ent_in;
+	uint64_t		 blk_cnt = 0;
+	unsigned int		 i;
+
+	if (vsi == NULL)
+		return;
+
+	for (i = 0; i < io->ic_seg_cnt; i++) {
+		ent_in = &io->ic_segs[i].ls_ent_in;
+		if (bio_addr_is_hole(&ent_in->ei_addr))
+			continue;
+		blk_cnt += vos_byte2blkcnt(evt_extent_width(&ent_in->ei_rect.rc_ex) *
+					   ent_in->ei_inob);
+	}
+
+	if (blk_cnt != 0)
+		vea_compact_done(vsi, min(blk_cnt, UINT32_MAX));
+}
+
 /*
  * General rules for deciding if a merge window needs be flushed or skipped:
  *
@@ -1715,7 +1763,9 @@ need_merge(daos_handle_t ih, uint16_t src_media, int lgc_cnt, daos_size_t seg_si
  *    SCM space pressure.
  * 3. If any removal records, punch records could be removed or merged, flush merge
  *    window to condense VOS tree.
- * 4. If only records coalescing within same media (eg. merging small SCM records to a
+ * 4. If any NVMe record is located in the region being compacted by VEA, flush merge
+ *    window to relocate the live data, so that the region could become contiguous free.
+ * 5. If only records coalescing within same media (eg. merging small SCM records to a
  *    larger SCM record, or merging small NVMe records to a larger NVMe record), make
  *    a trade-off between VOS tree condensing and data relocating (which consumes CPU
  *    & storage bandwidth, yet likely to generate more fragmentations).
@@ -1756,6 +1806,11 @@ need_flush(daos_handle_t ih, struct vos_agg_param *agg_param, bool last)
 		    lgc_ext.ex_hi != phy_ext.ex_hi)
 			return true;
 
+		if (need_compact(ih, mw, phy_ent)) {
+			mw->mw_compact = true;
+			return true;
+		}
+
 		if (i == 0 || (hole != bio_addr_is_hole(&phy_ent->pe_addr))) {
 			if (i && need_merge(ih, src_media, lgc_cnt, seg_width * mw->mw_rsize))
 				return true;
@@ -1826,7 +1881,10 @@ flush_merge_window(daos_handle_t ih, struct vos_agg_param *agg_param,
 		goto out;
 	}
 	credits_consume(&agg_param->ap_credits, AGG_OP_MERGE);
+	if (mw->mw_compact)
+		compact_charge(ih, mw);
 out:
+	mw->mw_compact = false;
 	cleanup_segments(ih, mw, rc);
 
 	return rc;
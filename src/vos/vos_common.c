@@ -513,6 +513,7 @@ static void *
 vos_tls_init(int tags, int xs_id, int tgt_id)
 {
 	struct vos_tls *tls;
+	bool		clock = false;
 	int		rc;
 
 	D_ASSERT((tags & DAOS_SERVER_TAG) & (DAOS_TGT_TAG | DAOS_RDB_TAG));
@@ -522,7 +523,9 @@ vos_tls_init(int tags, int xs_id, int tgt_id)
 		return NULL;
 
 	D_INIT_LIST_HEAD(&tls->vtl_gc_pools);
-	rc = vos_obj_cache_create(LRU_CACHE_BITS, &tls->vtl_ocache);
+	/* CLOCK eviction avoids LRU list updates on every object cache hit */
+	d_getenv_bool("DAOS_VOS_OBJ_CACHE_CLOCK", &clock);
+	rc = vos_obj_cache_create(LRU_CACHE_BITS, clock, &tls->vtl_ocache);
 	if (rc) {
 		D_ERROR("Error in creating object cache\n");
 		goto failed;
@@ -644,6 +647,9 @@ daos_epoch_t	vos_start_epoch = DAOS_EPOCH_MAX;
  */
 uint32_t	vos_agg_gap;
 
+/** Maximum checkpoint flush bandwidth of each pool target in MiB/s, 0 means unlimited */
+unsigned int	vos_chkpt_max_bw;
+
 uint32_t
 vos_get_agg_gap(void)
 {
@@ -733,6 +739,11 @@ vos_mod_init(void)
 	}
 	D_INFO("Set DAOS VOS aggregation gap as %u (second)\n", vos_agg_gap);
 
+	d_getenv_uint("DAOS_MD_CHKPT_MAX_BW", &vos_chkpt_max_bw);
+	if (vos_chkpt_max_bw != 0)
+		D_INFO("Set checkpoint bandwidth limit to %u MiB/s per pool target\n",
+		       vos_chkpt_max_bw);
+
 	return rc;
 }
 
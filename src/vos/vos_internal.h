@@ -151,6 +151,7 @@ extern uint32_t vos_agg_gap;
 #define VOS_AGG_GAP_MAX		180
 
 extern unsigned int vos_agg_nvme_thresh;
+extern unsigned int vos_chkpt_max_bw;
 extern bool vos_dkey_punch_propagate;
 extern bool vos_skip_old_partial_dtx;
 
@@ -223,6 +224,8 @@ struct vos_chkpt_metrics {
 	struct d_tm_node_t	*vcm_dirty_chunks;
 	struct d_tm_node_t	*vcm_iovs_copied;
 	struct d_tm_node_t	*vcm_wal_purged;
+	struct d_tm_node_t	*vcm_bandwidth;
+	struct d_tm_node_t	*vcm_wal_fill;
 };
 
 void vos_chkpt_metrics_init(struct vos_chkpt_metrics *vc_metrics, const char *path, int tgt_id);
@@ -242,12 +245,16 @@ struct vos_wal_metrics {
 	struct d_tm_node_t *vwm_wal_sz;       /* WAL size for single tx */
 	struct d_tm_node_t *vwm_wal_qd;       /* WAL transaction queue depth */
 	struct d_tm_node_t *vwm_wal_waiters;  /* Waiters for WAL reclaiming */
+	struct d_tm_node_t *vwm_wal_batch;    /* Transactions per WAL write */
 	struct d_tm_node_t *vwm_wal_dur;      /* WAL commit duration */
 	struct d_tm_node_t *vwm_replay_size;  /* WAL replay size in bytes */
 	struct d_tm_node_t *vwm_replay_time;  /* WAL replay time in us */
 	struct d_tm_node_t *vwm_replay_count; /* Total replay count */
 	struct d_tm_node_t *vwm_replay_tx;    /* Total replayed TX count */
 	struct d_tm_node_t *vwm_replay_ent;   /* Total replayed entry count */
+	struct d_tm_node_t *vwm_replay_load;  /* WAL replay load time in us */
+	struct d_tm_node_t *vwm_replay_verify;/* WAL replay verify time in us */
+	struct d_tm_node_t *vwm_replay_apply; /* WAL replay apply time in us */
 };
 
 void vos_wal_metrics_init(struct vos_wal_metrics *vw_metrics, const char *path, int tgt_id);
@@ -351,6 +358,7 @@ struct vos_pool {
 	struct vos_pool_metrics	*vp_metrics;
 	vos_chkpt_update_cb_t    vp_update_cb;
 	vos_chkpt_wait_cb_t      vp_wait_cb;
+	vos_chkpt_sleep_cb_t     vp_sleep_cb;
 	void                    *vp_chkpt_arg;
 	/* The count of committed DTXs for the whole pool. */
 	uint32_t		 vp_dtx_committed_count;
@@ -1389,6 +1397,12 @@ vos_tree_mark_corruption(struct vos_container *cont, struct vos_object *obj, dao
 			 enum vos_tree_class tclass, daos_epoch_t epoch, uint32_t pm_ver,
 			 bool is_dkey, daos_key_t *key, daos_handle_t *sub_toh);
 
+/* vos_summ.c */
+void
+vos_summ_dkey_add(struct vos_object *obj, daos_key_t *dkey);
+void
+vos_summ_akey_add(struct vos_object *obj, daos_key_t *akey, struct bio_iov *biov);
+
 /* vos_io.c */
 int
 vos_dedup_init(struct vos_pool *pool);
@@ -1807,11 +1821,11 @@ vos_anchor_is_zero(daos_anchor_t *anchor)
 
 static inline int
 vos_media_read(struct bio_io_context *ioc, struct umem_instance *umem,
-	       bio_addr_t addr, d_iov_t *iov_out)
+	       bio_addr_t addr, d_iov_t *iov_out, enum bio_io_class io_class)
 {
 	if (addr.ba_type == DAOS_MEDIA_NVME) {
 		D_ASSERT(ioc != NULL);
-		return bio_read(ioc, addr, iov_out);
+		return bio_read_class(ioc, addr, iov_out, io_class);
 	}
 
 	D_ASSERT(umem != NULL);
@@ -1837,6 +1837,8 @@ akey_update_single(daos_handle_t toh, uint32_t pm_ver, daos_size_t rsize,
 	rc = dbtree_update(toh, &kiov, &riov);
 	if (rc != 0)
 		D_ERROR("Failed to update subtree: "DF_RC"\n", DP_RC(rc));
+	else
+		vos_summ_akey_add(ioc->ic_obj, &ioc->ic_iods[ioc->ic_sgl_at].iod_name, &biov);
 
 	ioc->ic_io_size += rsize;
 
@@ -2080,6 +2082,8 @@ akey_update(struct vos_io_context *ioc, uint32_t pm_ver, daos_handle_t ak_toh,
 	}
 
 	rc = update_value(ioc, iod, iod_csums, pm_ver, toh, minor_epc);
+	if (rc == 0 && is_array)
+		vos_summ_akey_add(obj, &iod->iod_name, NULL);
 out:
 	if (daos_handle_is_valid(toh))
 		key_tree_release(toh, is_array);
@@ -2144,9 +2148,12 @@ dkey_update(struct vos_io_context *ioc, uint32_t pm_ver, daos_key_t *dkey,
 		goto out;
 	}
 
+	vos_summ_dkey_add(obj, dkey);
+
 	ioc->ic_sv_addr_at = 0;
 	if (krec->kr_bmap & KREC_BF_NO_AKEY) {
 		struct dcs_csum_info *iod_csums = vos_csum_at(ioc->ic_iod_csums, 0);
+		vos_summ_akey_add(obj, NULL, NULL);
 		iod_set_cursor(ioc, 0);
 		rc = update_value(ioc, &ioc->ic_iods[0], iod_csums, pm_ver, ak_toh, minor_epc);
 	} else {
@@ -1811,7 +1811,7 @@ recx_iter_copy(struct vos_obj_iter *oiter, vos_iter_entry_t *it_entry,
 	bioc = vos_data_ioctxt(oiter->it_obj->obj_cont->vc_pool);
 	umem = &oiter->it_obj->obj_cont->vc_pool->vp_umm;
 
-	return vos_media_read(bioc, umem, biov->bi_addr, iov_out);
+	return vos_media_read(bioc, umem, biov->bi_addr, iov_out, BIO_IOC_FG);
 }
 
 static int
@@ -52,6 +52,8 @@ struct vos_object {
 	struct umem_pin_handle		*obj_pin_hdl;
 	/** Bucket IDs for the object */
 	uint32_t			obj_bkt_ids[VOS_OBJ_BKTS_MAX];
+	/** Summary of the dkeys and single values, NULL until it's built */
+	struct vos_obj_summ		*obj_summ;
 	ABT_mutex			obj_mutex;
 	ABT_cond			obj_wait_alloting;
 	ABT_cond			obj_wait_loading;
@@ -66,7 +68,9 @@ struct vos_object {
 	    /** Allocating evict-able bucket in in-progress */
 	    obj_bkt_alloting			     : 1,
 	    /** Loading object is in-progress */
-	    obj_bkt_loading			     : 1;
+	    obj_bkt_loading			     : 1,
+	    /** Summary is being built, see vos_obj_summ_build() */
+	    obj_summ_building			     : 1;
 };
 
 enum {
@@ -134,10 +138,11 @@ vos_obj_is_evicted(struct vos_object *obj)
  * Create an object cache.
  *
  * \param cache_size	[IN]	Cache size
+ * \param clock		[IN]	Use CLOCK eviction instead of LRU list
  * \param occ_p		[OUT]	Newly created cache.
  */
 int
-vos_obj_cache_create(int32_t cache_size, struct daos_lru_cache **occ_p);
+vos_obj_cache_create(int32_t cache_size, bool clock, struct daos_lru_cache **occ_p);
 
 /**
  * Destroy an object cache, and release all cached object references.
@@ -16,6 +16,10 @@
  * entries. The size of both hashtable and linked list are
  * fixed length.
  *
+ * The cache is per xstream and never locked. With DAOS_VOS_OBJ_CACHE_CLOCK
+ * it is an open-addressing table with CLOCK eviction instead, a cache hit
+ * only sets the referenced bit of the object.
+ *
  * Author: Vishwanath Venkatesan <vishwanath.venkatesan@intel.com>
  */
 #define D_LOGFAC	DD_FAC(vos)
@@ -143,6 +147,7 @@ clean_object(struct vos_object *obj)
 	if (obj->obj_cont != NULL)
 		vos_cont_decref(obj->obj_cont);
 
+	D_FREE(obj->obj_summ);
 	obj_tree_fini(obj);
 }
 
@@ -184,12 +189,13 @@ static struct daos_llink_ops obj_lru_ops = {
 };
 
 int
-vos_obj_cache_create(int32_t cache_size, struct daos_lru_cache **occ)
+vos_obj_cache_create(int32_t cache_size, bool clock, struct daos_lru_cache **occ)
 {
 	int	rc;
 
-	D_DEBUG(DB_TRACE, "Creating an object cache %d\n", (1 << cache_size));
-	rc = daos_lru_cache_create(cache_size, D_HASH_FT_NOLOCK,
+	D_DEBUG(DB_TRACE, "Creating an object cache %d%s\n", (1 << cache_size),
+		clock ? " (CLOCK)" : "");
+	rc = daos_lru_cache_create(cache_size, D_HASH_FT_NOLOCK | (clock ? DAOS_LRU_FT_CLOCK : 0),
 				   &obj_lru_ops, occ);
 	if (rc)
 		D_ERROR("Error in creating lru cache: "DF_RC"\n", DP_RC(rc));
@@ -203,6 +209,35 @@ vos_obj_cache_destroy(struct daos_lru_cache *occ)
 	daos_lru_cache_destroy(occ);
 }
 
+void
+vos_obj_cache_stat(daos_handle_t coh, uint64_t *hits, uint64_t *misses)
+{
+	struct vos_container	*cont = vos_hdl2cont(coh);
+	struct daos_lru_cache	*occ;
+
+	D_ASSERT(cont != NULL);
+	occ = vos_obj_cache_get(cont->vc_pool->vp_sysdb);
+	*hits	= occ->dlc_hits;
+	*misses	= occ->dlc_misses;
+}
+
+int
+vos_obj_cache_probe(daos_handle_t coh, daos_unit_oid_t oid)
+{
+	struct vos_container	*cont = vos_hdl2cont(coh);
+	struct vos_object	*obj;
+	daos_epoch_range_t	 epr = {0, DAOS_EPOCH_MAX};
+	int			 rc;
+
+	if (cont == NULL)
+		return -DER_INVAL;
+
+	rc = vos_obj_hold(cont, oid, &epr, DAOS_EPOCH_MAX, 0, DAOS_INTENT_DEFAULT, &obj, NULL);
+	if (rc == 0)
+		vos_obj_release(obj, 0, false);
+	return rc;
+}
+
 static bool
 obj_cache_evict_cond(struct daos_llink *llink, void *args)
 {
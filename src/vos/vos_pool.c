@@ -391,6 +391,11 @@ vos_wal_metrics_init(struct vos_wal_metrics *vw_metrics, const char *path, int t
 	if (rc)
 		D_WARN("Failed to create WAL waiters telemetry: "DF_RC"\n", DP_RC(rc));
 
+	rc = d_tm_add_metric(&vw_metrics->vwm_wal_batch, D_TM_STATS_GAUGE, "WAL tx batch size",
+			     "transactions", "%s/%s/wal_batch/tgt_%d", path, VOS_WAL_DIR, tgt_id);
+	if (rc)
+		D_WARN("Failed to create WAL batch telemetry: "DF_RC"\n", DP_RC(rc));
+
 	rc = d_tm_add_metric(&vw_metrics->vwm_wal_dur, D_TM_DURATION, "WAL commit duration", NULL,
 			     "%s/%s/wal_dur/tgt_%d", path, VOS_WAL_DIR, tgt_id);
 	if (rc)
@@ -424,6 +429,21 @@ vos_wal_metrics_init(struct vos_wal_metrics *vw_metrics, const char *path, int t
 			     "%s/%s/replay_entries/tgt_%u", path, VOS_WAL_DIR, tgt_id);
 	if (rc)
 		D_WARN("Failed to create 'replay_entries' telemetry: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&vw_metrics->vwm_replay_load, D_TM_GAUGE, "WAL replay load time",
+			     "us", "%s/%s/replay_load_time/tgt_%u", path, VOS_WAL_DIR, tgt_id);
+	if (rc)
+		D_WARN("Failed to create 'replay_load_time' telemetry: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&vw_metrics->vwm_replay_verify, D_TM_GAUGE, "WAL replay verify time",
+			     "us", "%s/%s/replay_verify_time/tgt_%u", path, VOS_WAL_DIR, tgt_id);
+	if (rc)
+		D_WARN("Failed to create 'replay_verify_time' telemetry: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&vw_metrics->vwm_replay_apply, D_TM_GAUGE, "WAL replay apply time",
+			     "us", "%s/%s/replay_apply_time/tgt_%u", path, VOS_WAL_DIR, tgt_id);
+	if (rc)
+		D_WARN("Failed to create 'replay_apply_time' telemetry: "DF_RC"\n", DP_RC(rc));
 }
 
 #define VOS_CACHE_DIR	"vos_cache"
@@ -584,6 +604,7 @@ vos_wal_commit(struct umem_store *store, struct umem_wal_tx *wal_tx, void *data_
 	} else if (vwm != NULL) {
 		d_tm_set_gauge(vwm->vwm_wal_sz, ws.ws_size);
 		d_tm_set_gauge(vwm->vwm_wal_qd, ws.ws_qd);
+		d_tm_set_gauge(vwm->vwm_wal_batch, ws.ws_batch_txs);
 	}
 
 	bio_wal_query(store->stor_priv, &wal_info);
@@ -621,6 +642,9 @@ vos_wal_replay(struct umem_store *store,
 		d_tm_set_gauge(vwm->vwm_replay_time, wrs.wrs_tm);
 		d_tm_inc_counter(vwm->vwm_replay_tx, wrs.wrs_tx_cnt);
 		d_tm_inc_counter(vwm->vwm_replay_ent, wrs.wrs_entries);
+		d_tm_set_gauge(vwm->vwm_replay_load, wrs.wrs_load_tm);
+		d_tm_set_gauge(vwm->vwm_replay_verify, wrs.wrs_verify_tm);
+		d_tm_set_gauge(vwm->vwm_replay_apply, wrs.wrs_apply_tm);
 	}
 	return rc;
 }
@@ -685,6 +709,17 @@ vos_chkpt_metrics_init(struct vos_chkpt_metrics *vc_metrics, const char *path, i
 	if (rc)
 		D_WARN("failed to create checkpoint_wal_purged metric: "DF_RC"\n", DP_RC(rc));
 
+	rc = d_tm_add_metric(&vc_metrics->vcm_bandwidth, D_TM_STATS_GAUGE,
+			     "Bandwidth of flushing dirty pages to MD-blob", "MiB/s",
+			     "%s/%s/bandwidth/tgt_%d", path, CHKPT_TELEMETRY_DIR, tgt_id);
+	if (rc)
+		D_WARN("failed to create checkpoint_bandwidth metric: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&vc_metrics->vcm_wal_fill, D_TM_GAUGE,
+			     "WAL space in use", "%",
+			     "%s/%s/wal_fill/tgt_%d", path, CHKPT_TELEMETRY_DIR, tgt_id);
+	if (rc)
+		D_WARN("failed to create checkpoint_wal_fill metric: "DF_RC"\n", DP_RC(rc));
 }
 
 static void
@@ -707,7 +742,8 @@ chkpt_update_cb(void *arg, uint64_t id, uint32_t used_blocks, uint32_t total_blo
 
 void
 vos_pool_checkpoint_init(daos_handle_t poh, vos_chkpt_update_cb_t update_cb,
-			 vos_chkpt_wait_cb_t wait_cb, void *arg, struct umem_store **storep)
+			 vos_chkpt_wait_cb_t wait_cb, vos_chkpt_sleep_cb_t sleep_cb, void *arg,
+			 struct umem_store **storep)
 {
 	struct vos_pool      *pool;
 	struct umem_instance *umm;
@@ -723,6 +759,7 @@ vos_pool_checkpoint_init(daos_handle_t poh, vos_chkpt_update_cb_t update_cb,
 	D_ASSERT(store->vos_priv == NULL);
 	pool->vp_update_cb = update_cb;
 	pool->vp_wait_cb   = wait_cb;
+	pool->vp_sleep_cb  = sleep_cb;
 	pool->vp_chkpt_arg = arg;
 	store->vos_priv    = pool;
 
@@ -750,6 +787,7 @@ vos_pool_checkpoint_fini(daos_handle_t poh)
 
 	pool->vp_update_cb = NULL;
 	pool->vp_wait_cb   = NULL;
+	pool->vp_sleep_cb  = NULL;
 	pool->vp_chkpt_arg = NULL;
 	store->vos_priv    = NULL;
 }
@@ -769,16 +807,101 @@ vos_pool_needs_checkpoint(daos_handle_t poh)
 	return bio_nvme_configured(SMD_DEV_TYPE_META);
 }
 
+struct vos_chkpt_arg {
+	struct vos_pool		*vca_pool;
+	struct umem_store	*vca_store;
+	/** Start time of the checkpoint in usecs */
+	uint64_t		 vca_start;
+	/** Bytes flushed to MD-blob so far */
+	uint64_t		 vca_bytes;
+	/** WAL blocks purged so far */
+	uint64_t		 vca_purged;
+};
+
+/* Update the used block info and the WAL fill level */
+static void
+chkpt_wal_update(struct vos_chkpt_arg *vca)
+{
+	struct vos_pool		*pool = vca->vca_pool;
+	struct bio_wal_info	 wal_info;
+
+	bio_wal_query(vca->vca_store->stor_priv, &wal_info);
+	pool->vp_update_cb(pool->vp_chkpt_arg, wal_info.wi_commit_id, wal_info.wi_used_blks,
+			   wal_info.wi_tot_blks);
+
+	if (pool->vp_metrics != NULL && wal_info.wi_tot_blks != 0)
+		d_tm_set_gauge(pool->vp_metrics->vp_chkpt_metrics.vcm_wal_fill,
+			       (uint64_t)wal_info.wi_used_blks * 100 / wal_info.wi_tot_blks);
+}
+
+/* Reclaim the WAL space up to @tx_id, unless it's already reclaimed */
+static int
+chkpt_wal_reclaim(struct vos_chkpt_arg *vca, uint64_t tx_id)
+{
+	struct bio_meta_context	*mc = vca->vca_store->stor_priv;
+	struct bio_wal_info	 wal_info;
+	uint64_t		 purged = 0;
+	int			 rc;
+
+	bio_wal_query(mc, &wal_info);
+	if (bio_wal_id_cmp(mc, tx_id, wal_info.wi_ckp_id) <= 0)
+		return 0;
+
+	rc = bio_wal_checkpoint(mc, tx_id, &purged);
+	if (rc == 0)
+		vca->vca_purged += purged;
+	return rc;
+}
+
+static void
+vos_chkpt_wait_cb(void *arg, uint64_t chkpt_tx, uint64_t *committed_tx)
+{
+	struct vos_pool *pool = ((struct vos_chkpt_arg *)arg)->vca_pool;
+
+	pool->vp_wait_cb(pool->vp_chkpt_arg, chkpt_tx, committed_tx);
+}
+
+static void
+vos_chkpt_batch_cb(void *arg, uint64_t durable_tx, uint64_t flushed_bytes)
+{
+	struct vos_chkpt_arg	*vca = arg;
+	struct vos_pool		*pool = vca->vca_pool;
+	uint64_t		 expected;
+	uint64_t		 elapsed;
+	int			 rc;
+
+	/* Release the WAL space as soon as a batch is durable, instead of at the end */
+	if (durable_tx != 0) {
+		rc = chkpt_wal_reclaim(vca, durable_tx);
+		if (rc == 0)
+			chkpt_wal_update(vca);
+		else
+			DL_WARN(rc, DF_UUID": failed to reclaim WAL up to "DF_X64,
+				DP_UUID(pool->vp_id), durable_tx);
+	}
+
+	vca->vca_bytes += flushed_bytes;
+	if (vos_chkpt_max_bw == 0 || pool->vp_sleep_cb == NULL)
+		return;
+
+	/* Sleep until the flushed bytes fit in the bandwidth limit of this pool target */
+	expected = vca->vca_bytes * 1000000 / ((uint64_t)vos_chkpt_max_bw << 20);
+	elapsed  = daos_getutime() - vca->vca_start;
+	if (elapsed < expected)
+		pool->vp_sleep_cb(pool->vp_chkpt_arg, (expected - elapsed + 999) / 1000);
+}
+
 int
 vos_pool_checkpoint(daos_handle_t poh)
 {
 	struct vos_pool               *pool;
 	uint64_t                       tx_id;
+	uint64_t                       duration;
 	struct umem_instance          *umm;
 	struct umem_store             *store;
 	struct bio_wal_info            wal_info;
 	int                            rc;
-	uint64_t                       purge_size = 0;
+	struct vos_chkpt_arg           vca = { 0 };
 	struct umem_cache_chkpt_stats  stats = { 0 };
 	struct vos_chkpt_metrics      *chkpt_metrics = NULL;
 
@@ -808,16 +931,18 @@ vos_pool_checkpoint(daos_handle_t poh)
 	if (rc)
 		return rc;
 
-	rc = umem_cache_checkpoint(store, pool->vp_wait_cb, pool->vp_chkpt_arg, &tx_id, &stats);
+	vca.vca_pool  = pool;
+	vca.vca_store = store;
+	vca.vca_start = daos_getutime();
 
-	if (rc == 0)
-		rc = bio_wal_checkpoint(store->stor_priv, tx_id, &purge_size);
+	rc = umem_cache_checkpoint(store, vos_chkpt_wait_cb, vos_chkpt_batch_cb, &vca, &tx_id,
+				   &stats);
 
-	bio_wal_query(store->stor_priv, &wal_info);
+	if (rc == 0)
+		rc = chkpt_wal_reclaim(&vca, tx_id);
 
 	/* Update the used block info post checkpoint */
-	pool->vp_update_cb(pool->vp_chkpt_arg, wal_info.wi_commit_id, wal_info.wi_used_blks,
-			   wal_info.wi_tot_blks);
+	chkpt_wal_update(&vca);
 
 	D_DEBUG(DB_MD,
 		"Checkpoint finished pool=" DF_UUID ", committed_id=" DF_X64 ", rc=" DF_RC "\n",
@@ -829,7 +954,12 @@ vos_pool_checkpoint(daos_handle_t poh)
 			d_tm_set_gauge(chkpt_metrics->vcm_dirty_pages, stats.uccs_nr_pages);
 			d_tm_set_gauge(chkpt_metrics->vcm_dirty_chunks, stats.uccs_nr_dchunks);
 			d_tm_set_gauge(chkpt_metrics->vcm_iovs_copied, stats.uccs_nr_iovs);
-			d_tm_set_gauge(chkpt_metrics->vcm_wal_purged, purge_size);
+			d_tm_set_gauge(chkpt_metrics->vcm_wal_purged, vca.vca_purged);
+
+			duration = daos_getutime() - vca.vca_start;
+			if (vca.vca_bytes != 0 && duration != 0)
+				d_tm_set_gauge(chkpt_metrics->vcm_bandwidth,
+					       (vca.vca_bytes * 1000000 / duration) >> 20);
 		}
 	}
 	return rc;
@@ -1747,8 +1877,8 @@ pool_open_post(struct umem_pool **p_ph, struct vos_pool_df *pool_df, unsigned in
 
 	poh = vos_pool2hdl(pool);
 	if (!pool->vp_ext_chkpt && vos_pool_needs_checkpoint(poh))
-		vos_pool_checkpoint_init(poh, chkpt_update_cb, chkpt_wait_cb, &pool->vp_chkpt_ctxt,
-					 NULL);
+		vos_pool_checkpoint_init(poh, chkpt_update_cb, chkpt_wait_cb, NULL,
+					 &pool->vp_chkpt_ctxt, NULL);
 
 	pool->vp_opened = 1;
 	vos_space_sys_init(pool);
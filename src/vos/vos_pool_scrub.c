@@ -544,7 +544,7 @@ sc_verify_obj_value(struct scrub_ctx *ctx, struct bio_iov *biov, daos_handle_t i
 	oiter = vos_iter2oiter(iter);
 	bio_ctx = vos_data_ioctxt(oiter->it_obj->obj_cont->vc_pool);
 	umem = &oiter->it_obj->obj_cont->vc_pool->vp_umm;
-	rc = vos_media_read(bio_ctx, umem, biov->bi_addr, &data);
+	rc = vos_media_read(bio_ctx, umem, biov->bi_addr, &data, BIO_IOC_SCRUB);
 
 	if (BIO_ADDR_IS_CORRUPTED(&biov->bi_addr)) {
 		/* Already know this is corrupt so just return */
@@ -0,0 +1,469 @@
+/**
+ * (C) Copyright 2026 Hewlett Packard Enterprise Development LP
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+/**
+ * This file is part of daos
+ *
+ * vos/vos_summ.c
+ *
+ * Object summaries: min/max of the dkeys and of the single values of each akey, and a Bloom
+ * filter of the dkeys. They let readers (e.g., pipelines) skip objects that certainly have no
+ * matching record, without scanning them.
+ *
+ * A summary lives in the object cache. It is built in the background by scanning all the versions
+ * of the keys and values of the object, see vos_obj_summ_build(). The scan yields, and the updates
+ * made meanwhile, as well as all the later ones, add their dkey and values to the summary. Until
+ * the build completes, readers have to assume that any record may match. Punches, aggregation and
+ * aborted transactions do not shrink the summary, so it can only be a superset of the object
+ * content.
+ */
+#define D_LOGFAC	DD_FAC(vos)
+
+#include <math.h>
+#include <daos/common.h>
+#include <daos/btree.h>
+#include <daos_srv/vos.h>
+#include "vos_internal.h"
+
+#define SUMM_SEED		0x9e3779b9
+#define SUMM_BLOOM_HASHES	3
+/** Default number of dkeys scanned between yields by the summary build */
+#define SUMM_BUILD_CREDITS	64
+
+static const struct vos_summ_range summ_range_empty;
+
+static uint64_t
+summ_hash(daos_key_t *key)
+{
+	return d_hash_murmur64(key->iov_buf, key->iov_len, SUMM_SEED);
+}
+
+static void
+summ_range_add(struct vos_summ_range *range, const void *buf, uint32_t len)
+{
+	uint64_t u = 0;
+	int64_t  i;
+	double   d;
+	float    f;
+	int      shift;
+	bool     has_d = true;
+
+	if (range->sr_nr == 0 || len < range->sr_min_len)
+		range->sr_min_len = len;
+	if (range->sr_nr == 0 || len > range->sr_max_len)
+		range->sr_max_len = len;
+	if (len == 0 || len > sizeof(u)) {
+		range->sr_nr++;
+		return;
+	}
+
+	memcpy(&u, buf, len);
+	shift = 64 - len * 8;
+	i     = shift == 0 ? (int64_t)u : (int64_t)(u << shift) >> shift;
+	if (len == sizeof(f)) {
+		memcpy(&f, buf, sizeof(f));
+		d = f;
+	} else if (len == sizeof(d)) {
+		memcpy(&d, buf, sizeof(d));
+	} else {
+		d     = 0;
+		has_d = false;
+	}
+
+	if (range->sr_nr == 0) {
+		range->sr_min_u = range->sr_max_u = u;
+		range->sr_min_i = range->sr_max_i = i;
+		range->sr_min_d = INFINITY;
+		range->sr_max_d = -INFINITY;
+	} else {
+		range->sr_min_u = min(range->sr_min_u, u);
+		range->sr_max_u = max(range->sr_max_u, u);
+		range->sr_min_i = min(range->sr_min_i, i);
+		range->sr_max_i = max(range->sr_max_i, i);
+	}
+	if (has_d && !isnan(d)) {
+		range->sr_min_d = min(range->sr_min_d, d);
+		range->sr_max_d = max(range->sr_max_d, d);
+	}
+	range->sr_nr++;
+}
+
+static void
+summ_bloom_add(struct vos_obj_summ *summ, uint64_t hash)
+{
+	uint32_t h1 = (uint32_t)hash;
+	uint32_t h2 = (uint32_t)(hash >> 32);
+	uint32_t bit;
+	int      i;
+
+	for (i = 0; i < SUMM_BLOOM_HASHES; i++) {
+		bit = (h1 + i * h2) % VOS_SUMM_BLOOM_BITS;
+		summ->os_bloom[bit / 64] |= 1ULL << (bit % 64);
+	}
+}
+
+static bool
+summ_bloom_test(struct vos_obj_summ *summ, uint64_t hash)
+{
+	uint32_t h1 = (uint32_t)hash;
+	uint32_t h2 = (uint32_t)(hash >> 32);
+	uint32_t bit;
+	int      i;
+
+	for (i = 0; i < SUMM_BLOOM_HASHES; i++) {
+		bit = (h1 + i * h2) % VOS_SUMM_BLOOM_BITS;
+		if (!(summ->os_bloom[bit / 64] & (1ULL << (bit % 64))))
+			return false;
+	}
+	return true;
+}
+
+static void
+summ_dkey_add(struct vos_obj_summ *summ, daos_key_t *dkey)
+{
+	summ_range_add(&summ->os_dkeys, dkey->iov_buf, dkey->iov_len);
+	summ_bloom_add(summ, summ_hash(dkey));
+}
+
+/** Returns the range of \a akey, adding it if possible */
+static struct vos_summ_range *
+summ_akey_find(struct vos_obj_summ *summ, daos_key_t *akey, bool add)
+{
+	struct vos_summ_range *range;
+	uint64_t               hash = summ_hash(akey);
+	uint32_t               i;
+
+	for (i = 0; i < summ->os_nr_akeys; i++) {
+		if (summ->os_akeys[i].sr_hash == hash)
+			return &summ->os_akeys[i];
+	}
+	if (!add || summ->os_akeys_full)
+		return NULL;
+	if (summ->os_nr_akeys == VOS_SUMM_AKEY_MAX) {
+		summ->os_akeys_full = true;
+		return NULL;
+	}
+	range          = &summ->os_akeys[summ->os_nr_akeys++];
+	range->sr_hash = hash;
+	return range;
+}
+
+/**
+ * Adds a value of \a akey. \a biov is NULL for array values, whose akey is then not summarized.
+ */
+static void
+summ_akey_add(struct vos_obj_summ *summ, struct umem_instance *umm, daos_key_t *akey,
+	      struct bio_iov *biov)
+{
+	struct vos_summ_range *range;
+
+	range = summ_akey_find(summ, akey, true);
+	if (range == NULL || range->sr_unknown)
+		return;
+	if (biov == NULL) {
+		range->sr_unknown = true;
+		return;
+	}
+	if (bio_addr_is_hole(&biov->bi_addr))
+		return; /** punched */
+	if (bio_iov2media(biov) != DAOS_MEDIA_SCM || BIO_ADDR_IS_GANG(&biov->bi_addr)) {
+		/** only values in SCM are read */
+		range->sr_unknown = true;
+		return;
+	}
+	summ_range_add(range, umem_off2ptr(umm, biov->bi_addr.ba_off), bio_iov2len(biov));
+}
+
+void
+vos_summ_dkey_add(struct vos_object *obj, daos_key_t *dkey)
+{
+	if (obj->obj_summ != NULL)
+		summ_dkey_add(obj->obj_summ, dkey);
+}
+
+/**
+ * Adds a value of \a akey to the summary of \a obj, if it has one. \a biov is the address of a
+ * single value, or NULL for an array. A NULL \a akey means the dkey has no akey.
+ */
+void
+vos_summ_akey_add(struct vos_object *obj, daos_key_t *akey, struct bio_iov *biov)
+{
+	if (obj->obj_summ == NULL)
+		return;
+	if (akey == NULL)
+		obj->obj_summ->os_akeys_full = true;
+	else
+		summ_akey_add(obj->obj_summ, vos_obj2umm(obj), akey, biov);
+}
+
+const struct vos_summ_range *
+vos_obj_summ_akey(struct vos_obj_summ *summ, daos_key_t *akey)
+{
+	const struct vos_summ_range *range;
+
+	range = summ_akey_find(summ, akey, false);
+	if (range == NULL)
+		return summ->os_akeys_full ? NULL : &summ_range_empty;
+	return range->sr_unknown ? NULL : range;
+}
+
+bool
+vos_obj_summ_dkey_maybe(struct vos_obj_summ *summ, daos_key_t *dkey)
+{
+	return summ_bloom_test(summ, summ_hash(dkey));
+}
+
+/**
+ * Calls \a cb for every record of tree \a toh, including uncommitted ones. With an \a anchor, the
+ * scan starts after it unless it is zero, and stops after \a credits records with \a anchor set
+ * to the last one, 1 is then returned.
+ */
+static int
+summ_tree_scan(daos_handle_t toh, daos_anchor_t *anchor, uint32_t credits,
+	       int (*cb)(struct vos_rec_bundle *rbund, d_iov_t *key, void *arg), void *arg)
+{
+	struct vos_rec_bundle rbund = {0};
+	struct dcs_csum_info  csum;
+	struct bio_iov        biov;
+	struct vos_svt_key    sv_key;
+	daos_handle_t         ih;
+	d_iov_t               key;
+	d_iov_t               kiov;
+	d_iov_t               riov;
+	int                   rc;
+
+	rc = dbtree_iter_prepare(toh, BTR_ITER_EMBEDDED, &ih);
+	if (rc != 0)
+		return rc;
+
+	if (anchor == NULL || daos_anchor_is_zero(anchor))
+		rc = dbtree_iter_probe(ih, BTR_PROBE_FIRST, DAOS_INTENT_PURGE, NULL, NULL);
+	else
+		rc = dbtree_iter_probe(ih, BTR_PROBE_GT, DAOS_INTENT_PURGE, NULL, anchor);
+	while (rc == 0) {
+		if (anchor != NULL && credits-- == 0) {
+			rc = 1;
+			break;
+		}
+
+		tree_rec_bundle2iov(&rbund, &riov);
+		rbund.rb_iov  = &key;
+		rbund.rb_csum = &csum;
+		rbund.rb_biov = &biov;
+		d_iov_set(&key, NULL, 0);
+		d_iov_set(&kiov, &sv_key, sizeof(sv_key));
+		ci_set_null(&csum);
+		memset(&biov, 0, sizeof(biov));
+
+		rc = dbtree_iter_fetch(ih, &kiov, &riov, anchor);
+		if (rc != 0)
+			break;
+		rc = cb(&rbund, &key, arg);
+		if (rc != 0)
+			break;
+		rc = dbtree_iter_next(ih);
+	}
+	if (rc == -DER_NONEXIST)
+		rc = 0;
+
+	dbtree_iter_finish(ih);
+	return rc;
+}
+
+struct summ_scan_args {
+	struct vos_object	*ssa_obj;
+	struct vos_obj_summ	*ssa_summ;
+	/** akey tree of the current dkey, and akey of the single value tree */
+	daos_handle_t		 ssa_toh;
+	daos_key_t		 ssa_akey;
+	int			(*ssa_yield_func)(void *arg);
+	void			*ssa_yield_arg;
+};
+
+static int
+summ_sv_cb(struct vos_rec_bundle *rbund, d_iov_t *key, void *arg)
+{
+	struct summ_scan_args *args = arg;
+
+	summ_akey_add(args->ssa_summ, vos_obj2umm(args->ssa_obj), &args->ssa_akey, rbund->rb_biov);
+	return 0;
+}
+
+static int
+summ_akey_cb(struct vos_rec_bundle *rbund, d_iov_t *key, void *arg)
+{
+	struct summ_scan_args *args = arg;
+	struct vos_krec_df    *krec = rbund->rb_krec;
+	daos_handle_t          sv_toh;
+	int                    rc;
+
+	if (krec->kr_bmap & KREC_BF_EVT) {
+		summ_akey_add(args->ssa_summ, NULL, key, NULL);
+		return 0;
+	}
+	if (!(krec->kr_bmap & KREC_BF_BTR))
+		return 0;
+
+	rc = key_tree_prepare(args->ssa_obj, args->ssa_toh, VOS_BTR_AKEY, key, 0,
+			      DAOS_INTENT_PURGE, NULL, &sv_toh, NULL);
+	if (rc != 0)
+		return rc;
+
+	args->ssa_akey = *key;
+	rc             = summ_tree_scan(sv_toh, NULL, 0, summ_sv_cb, args);
+	key_tree_release(sv_toh, false);
+	return rc;
+}
+
+static int
+summ_dkey_cb(struct vos_rec_bundle *rbund, d_iov_t *key, void *arg)
+{
+	struct summ_scan_args *args = arg;
+	struct vos_krec_df    *krec = rbund->rb_krec;
+	daos_handle_t          ak_toh;
+	int                    rc;
+
+	summ_dkey_add(args->ssa_summ, key);
+	if (krec->kr_bmap & KREC_BF_NO_AKEY) {
+		args->ssa_summ->os_akeys_full = true;
+		return 0;
+	}
+	if (!(krec->kr_bmap & KREC_BF_BTR))
+		return 0;
+
+	rc = key_tree_prepare(args->ssa_obj, args->ssa_obj->obj_toh, VOS_BTR_DKEY, key, 0,
+			      DAOS_INTENT_PURGE, NULL, &ak_toh, NULL);
+	if (rc != 0)
+		return rc;
+
+	args->ssa_toh = ak_toh;
+	rc            = summ_tree_scan(ak_toh, NULL, 0, summ_akey_cb, args);
+	key_tree_release(ak_toh, false);
+	return rc;
+}
+
+static int
+summ_yield(struct summ_scan_args *args)
+{
+	int	rc;
+
+	if (args->ssa_yield_func == NULL) {
+		bio_yield(vos_obj2umm(args->ssa_obj));
+		return 0;
+	}
+
+	rc = args->ssa_yield_func(args->ssa_yield_arg);
+	return rc < 0 ? -DER_CANCELED : 0;
+}
+
+/**
+ * Scans the dkeys of the object, yielding every \a credits dkeys. The scan resumes after the
+ * anchor of the last dkey, a dkey is never scanned across a yield.
+ */
+static int
+summ_obj_scan(struct summ_scan_args *args, uint32_t credits)
+{
+	struct vos_object	*obj = args->ssa_obj;
+	daos_anchor_t		 anchor;
+	int			 rc;
+
+	daos_anchor_set_zero(&anchor);
+	while (1) {
+		rc = summ_tree_scan(obj->obj_toh, &anchor, credits, summ_dkey_cb, args);
+		if (rc <= 0)
+			return rc;
+
+		rc = summ_yield(args);
+		if (rc != 0)
+			return rc;
+
+		/** updates now go to a new cache entry, which is not summarized */
+		if (vos_obj_is_evicted(obj))
+			return -DER_AGAIN;
+	}
+}
+
+int
+vos_obj_summ_build(daos_handle_t coh, daos_unit_oid_t oid, uint32_t credits,
+		   int (*yield_func)(void *arg), void *yield_arg)
+{
+	struct vos_container  *cont;
+	struct vos_object     *obj;
+	struct summ_scan_args  args = {0};
+	daos_epoch_range_t     epr  = {0, DAOS_EPOCH_MAX};
+	int                    rc;
+
+	cont = vos_hdl2cont(coh);
+	if (cont == NULL) {
+		D_ERROR("Container is not open\n");
+		return -DER_INVAL;
+	}
+
+	rc = vos_obj_hold(cont, oid, &epr, DAOS_EPOCH_MAX, 0, DAOS_INTENT_DEFAULT, &obj, NULL);
+	if (rc != 0)
+		return rc;
+
+	/** built, or being built by someone else */
+	if (obj->obj_summ != NULL)
+		goto out;
+
+	rc = obj_tree_init(obj);
+	if (rc != 0)
+		goto out;
+
+	D_ALLOC_PTR(args.ssa_summ);
+	if (args.ssa_summ == NULL)
+		D_GOTO(out, rc = -DER_NOMEM);
+	args.ssa_obj        = obj;
+	args.ssa_yield_func = yield_func;
+	args.ssa_yield_arg  = yield_arg;
+
+	/** the updates made while the scan yields are added to the summary by the update path */
+	obj->obj_summ          = args.ssa_summ;
+	obj->obj_summ_building = 1;
+	rc = summ_obj_scan(&args, credits == 0 ? SUMM_BUILD_CREDITS : credits);
+	obj->obj_summ_building = 0;
+	if (rc != 0) {
+		DL_CDEBUG(rc == -DER_AGAIN || rc == -DER_CANCELED, DB_IO, DLOG_ERR, rc,
+			  "Failed to build the summary of " DF_UOID, DP_UOID(oid));
+		obj->obj_summ = NULL;
+		D_FREE(args.ssa_summ);
+		goto out;
+	}
+	D_DEBUG(DB_IO, "Built summary of " DF_UOID ": " DF_U64 " dkeys, %u akeys\n", DP_UOID(oid),
+		obj->obj_summ->os_dkeys.sr_nr, obj->obj_summ->os_nr_akeys);
+out:
+	vos_obj_release(obj, 0, false);
+	return rc;
+}
+
+int
+vos_obj_summ_get(daos_handle_t coh, daos_unit_oid_t oid, struct vos_obj_summ *summ)
+{
+	struct vos_container  *cont;
+	struct vos_object     *obj;
+	daos_epoch_range_t     epr  = {0, DAOS_EPOCH_MAX};
+	int                    rc;
+
+	cont = vos_hdl2cont(coh);
+	if (cont == NULL) {
+		D_ERROR("Container is not open\n");
+		return -DER_INVAL;
+	}
+
+	rc = vos_obj_hold(cont, oid, &epr, DAOS_EPOCH_MAX, 0, DAOS_INTENT_DEFAULT, &obj, NULL);
+	if (rc != 0)
+		return rc;
+
+	if (obj->obj_summ == NULL)
+		rc = -DER_AGAIN;
+	else if (obj->obj_summ_building)
+		rc = -DER_INPROGRESS;
+	else
+		*summ = *obj->obj_summ;
+
+	vos_obj_release(obj, 0, false);
+	return rc;
+}
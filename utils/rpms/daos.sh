@@ -99,6 +99,7 @@ if [ -f "${SL_PREFIX}/bin/daos_server" ]; then
   TARGET_PATH="${bindir}"
   list_files files "${SL_PREFIX}/bin/daos_engine" \
                    "${SL_PREFIX}/bin/daos_metrics" \
+                   "${SL_PREFIX}/bin/daos_trace" \
                    "${SL_PREFIX}/bin/ddb" \
                    "${SL_PREFIX}/bin/dlck" \
                    "${SL_PREFIX}/bin/daos_server_helper" \
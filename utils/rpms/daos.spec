@@ -478,6 +478,7 @@ fi
 %attr(2755,root,daos_server) %{_bindir}/daos_server
 %{_bindir}/daos_engine
 %{_bindir}/daos_metrics
+%{_bindir}/daos_trace
 %{_bindir}/ddb
 %{_bindir}/dlck
 %{_sysconfdir}/ld.so.conf.d/daos.conf